@@ -1998,6 +1998,7 @@ func_all_modules ()
   func_module linked-list
   func_module avltree-list
   func_module rbtree-list
+  func_module btree-list
   func_module linkedhash-list
   func_module avltreehash-list
   func_module rbtreehash-list
@@ -2008,6 +2009,7 @@ func_all_modules ()
   func_module array-oset
   func_module avltree-oset
   func_module rbtree-oset
+  func_module btree-oset
   func_module stack
   func_end_table
 
@@ -2021,6 +2023,7 @@ func_all_modules ()
   func_module crypto/arcfour
   func_module crypto/arctwo
   func_module crypto/des
+  func_module crypto/digest-readahead
   func_module crypto/hmac-md5
   func_module crypto/hmac-sha1
   func_module crypto/md2
@@ -2029,11 +2032,15 @@ func_all_modules ()
   func_module crypto/md4-buffer
   func_module crypto/md5
   func_module crypto/md5-buffer
+  func_module crypto/md5-buffers
   func_module crypto/rijndael
+  func_module crypto/rijndael-x86_64
   func_module crypto/sha1
   func_module crypto/sha1-buffer
   func_module crypto/sha256
   func_module crypto/sha256-buffer
+  func_module crypto/sha256-buffers
+  func_module crypto/sha256-x86_64
   func_module crypto/sha512
   func_module crypto/sha512-buffer
   func_module crypto/sm3
@@ -2083,9 +2090,12 @@ func_all_modules ()
   func_begin_table
   func_module base32
   func_module base64
+  func_module base64-x86_64
   func_module check-version
   func_module cpu-supports
   func_module crc
+  func_module crc-parallel
+  func_module crc32c
   func_module diffseq
   func_module execinfo
   func_module getline
@@ -2099,8 +2109,11 @@ func_all_modules ()
   func_module obstack-printf-posix
   func_module hashcode-string2
   func_module hashcode-mem
+  func_module hashcode-seeded
   func_module hash
+  func_module concurrent-hash
   func_module hamt
+  func_module hamt-parallel
   func_module readline
   func_module readtokens
   func_module readtokens0
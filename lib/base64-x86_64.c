@@ -0,0 +1,315 @@
+/* base64-x86_64.c -- Base64 encoding and decoding for x86_64 using
+   SSSE3 and AVX2
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* The algorithms are those of Wojciech Muła and Daniel Lemire, "Faster
+   Base64 Encoding and Decoding Using AVX2 Instructions", ACM Transactions
+   on the Web 12(3), 2018 <https://arxiv.org/abs/1704.00605>.  They assume
+   an ASCII compatible character set, which all x86 platforms have.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "base64-x86_64.h"
+
+#include <x86intrin.h>
+
+/* Encoding.
+
+   Each group of three input bytes is spread over a 32-bit lane and split
+   into four 6-bit indices, one per byte.  The indices are then turned
+   into characters by adding an offset that depends on the range of the
+   index: 'A' for 0..25, 'a' - 26 for 26..51, '0' - 52 for 52..61, and
+   special offsets for 62 and 63.  */
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("ssse3")))
+#endif
+static inline __m128i
+encode_16 (__m128i in)
+{
+  /* Bytes b2 b1 b0 become the lane b1 b2 b0 b1 (from high to low).  */
+  in = _mm_shuffle_epi8 (in, _mm_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7,
+                                           4, 5, 3, 4, 1, 2, 0, 1));
+  __m128i t0 = _mm_and_si128 (in, _mm_set1_epi32 (0x0FC0FC00));
+  __m128i t1 = _mm_mulhi_epu16 (t0, _mm_set1_epi32 (0x04000040));
+  __m128i t2 = _mm_and_si128 (in, _mm_set1_epi32 (0x003F03F0));
+  __m128i t3 = _mm_mullo_epi16 (t2, _mm_set1_epi32 (0x01000010));
+  __m128i indices = _mm_or_si128 (t1, t3);
+
+  /* Map 0..25 to 13, 26..51 to 0, and 52..63 to 1..12.  */
+  __m128i range = _mm_subs_epu8 (indices, _mm_set1_epi8 (51));
+  __m128i less = _mm_cmpgt_epi8 (_mm_set1_epi8 (26), indices);
+  range = _mm_or_si128 (range, _mm_and_si128 (less, _mm_set1_epi8 (13)));
+  __m128i offsets =
+    _mm_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                   '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                   '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm_add_epi8 (indices, _mm_shuffle_epi8 (offsets, range));
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2")))
+#endif
+static inline __m256i
+encode_32 (__m256i in)
+{
+  in = _mm256_shuffle_epi8 (in, _mm256_set_epi8 (10, 11, 9, 10, 7, 8, 6, 7,
+                                                 4, 5, 3, 4, 1, 2, 0, 1,
+                                                 10, 11, 9, 10, 7, 8, 6, 7,
+                                                 4, 5, 3, 4, 1, 2, 0, 1));
+  __m256i t0 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x0FC0FC00));
+  __m256i t1 = _mm256_mulhi_epu16 (t0, _mm256_set1_epi32 (0x04000040));
+  __m256i t2 = _mm256_and_si256 (in, _mm256_set1_epi32 (0x003F03F0));
+  __m256i t3 = _mm256_mullo_epi16 (t2, _mm256_set1_epi32 (0x01000010));
+  __m256i indices = _mm256_or_si256 (t1, t3);
+
+  __m256i range = _mm256_subs_epu8 (indices, _mm256_set1_epi8 (51));
+  __m256i less = _mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), indices);
+  range = _mm256_or_si256 (range,
+                           _mm256_and_si256 (less, _mm256_set1_epi8 (13)));
+  __m256i offsets =
+    _mm256_setr_epi8 ('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+                      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                      '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+  return _mm256_add_epi8 (indices, _mm256_shuffle_epi8 (offsets, range));
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("ssse3")))
+#endif
+idx_t
+base64_encode_ssse3 (char const *restrict in, idx_t inlen,
+                     char *restrict out)
+{
+  idx_t i = 0;
+
+  /* Each iteration reads 16 bytes and consumes 12 of them.  */
+  for (; 16 <= inlen - i; i += 12, out += 16)
+    _mm_storeu_si128 ((__m128i_u *) out,
+                      encode_16 (_mm_loadu_si128 ((__m128i_u const *)
+                                                  (in + i))));
+
+  return i;
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2")))
+#endif
+idx_t
+base64_encode_avx2 (char const *restrict in, idx_t inlen,
+                    char *restrict out)
+{
+  idx_t i = 0;
+
+  /* Each iteration reads 28 bytes and consumes 24 of them, 12 per
+     128-bit lane.  */
+  for (; 32 <= inlen - i; i += 24, out += 32)
+    {
+      __m128i lo = _mm_loadu_si128 ((__m128i_u const *) (in + i));
+      __m128i hi = _mm_loadu_si128 ((__m128i_u const *) (in + i + 12));
+      __m256i v = _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo),
+                                           hi, 1);
+      _mm256_storeu_si256 ((__m256i_u *) out, encode_32 (v));
+    }
+
+  for (; 16 <= inlen - i; i += 12, out += 16)
+    _mm_storeu_si128 ((__m128i_u *) out,
+                      encode_16 (_mm_loadu_si128 ((__m128i_u const *)
+                                                  (in + i))));
+
+  return i;
+}
+
+/* Decoding.
+
+   The high and low nibbles of each character index two tables, whose
+   entries have a common bit set if and only if the character is not in
+   the base64 alphabet.  The high nibble, adjusted for '/', also selects
+   the offset that turns a character into its 6-bit value.  The values
+   are then packed four into three bytes.
+
+   The decoding functions below store the bytes decoded from a block of
+   characters in *RESULT, and return the number of leading characters of
+   the block that are in the alphabet, rounded down to a multiple of 4.
+   This way, a block that contains a newline or padding is decoded up to
+   the group of four in which it occurs.  */
+
+/* Return the number of leading bits set in the N-bit mask GOOD, rounded
+   down to a multiple of 4.  */
+static inline int
+valid_prefix (unsigned int good, int n)
+{
+  unsigned int all = n == 32 ? 0xFFFFFFFF : (1U << n) - 1;
+  return good == all ? n : _bit_scan_forward (~good) & ~3;
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("ssse3")))
+#endif
+static inline int
+decode_16 (__m128i in, __m128i *result)
+{
+  __m128i lut_lo =
+    _mm_setr_epi8 (0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                   0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  __m128i lut_hi =
+    _mm_setr_epi8 (0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                   0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  __m128i lut_roll =
+    _mm_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71,
+                   0, 0, 0, 0, 0, 0, 0, 0);
+  __m128i nibble = _mm_set1_epi8 (0x0F);
+
+  __m128i hi_nibbles = _mm_and_si128 (_mm_srli_epi32 (in, 4), nibble);
+  __m128i lo_nibbles = _mm_and_si128 (in, nibble);
+  __m128i lo = _mm_shuffle_epi8 (lut_lo, lo_nibbles);
+  __m128i hi = _mm_shuffle_epi8 (lut_hi, hi_nibbles);
+  __m128i bad = _mm_and_si128 (lo, hi);
+  unsigned int good =
+    _mm_movemask_epi8 (_mm_cmpeq_epi8 (bad, _mm_setzero_si128 ()));
+
+  __m128i eq_slash = _mm_cmpeq_epi8 (in, _mm_set1_epi8 ('/'));
+  __m128i roll = _mm_shuffle_epi8 (lut_roll,
+                                   _mm_add_epi8 (eq_slash, hi_nibbles));
+  __m128i values = _mm_add_epi8 (in, roll);
+
+  /* Pack 00aaaaaa 00bbbbbb 00cccccc 00dddddd into aaaaaabb bbbbcccc
+     ccdddddd, and the 4 groups of 3 bytes into the low 12 bytes.  */
+  __m128i ab_cd = _mm_maddubs_epi16 (values, _mm_set1_epi32 (0x01400140));
+  __m128i abcd = _mm_madd_epi16 (ab_cd, _mm_set1_epi32 (0x00011000));
+  *result = _mm_shuffle_epi8 (abcd,
+                              _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9,
+                                             8, 14, 13, 12, -1, -1, -1, -1));
+  return valid_prefix (good, 16);
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2")))
+#endif
+static inline int
+decode_32 (__m256i in, __m256i *result)
+{
+  __m256i lut_lo =
+    _mm256_setr_epi8 (0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                      0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+  __m256i lut_hi =
+    _mm256_setr_epi8 (0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  __m256i lut_roll =
+    _mm256_setr_epi8 (0, 16, 19, 4, -65, -65, -71, -71,
+                      0, 0, 0, 0, 0, 0, 0, 0,
+                      0, 16, 19, 4, -65, -65, -71, -71,
+                      0, 0, 0, 0, 0, 0, 0, 0);
+  __m256i nibble = _mm256_set1_epi8 (0x0F);
+
+  __m256i hi_nibbles = _mm256_and_si256 (_mm256_srli_epi32 (in, 4), nibble);
+  __m256i lo_nibbles = _mm256_and_si256 (in, nibble);
+  __m256i lo = _mm256_shuffle_epi8 (lut_lo, lo_nibbles);
+  __m256i hi = _mm256_shuffle_epi8 (lut_hi, hi_nibbles);
+  __m256i bad = _mm256_and_si256 (lo, hi);
+  unsigned int good =
+    _mm256_movemask_epi8 (_mm256_cmpeq_epi8 (bad, _mm256_setzero_si256 ()));
+
+  __m256i eq_slash = _mm256_cmpeq_epi8 (in, _mm256_set1_epi8 ('/'));
+  __m256i roll = _mm256_shuffle_epi8 (lut_roll,
+                                      _mm256_add_epi8 (eq_slash, hi_nibbles));
+  __m256i values = _mm256_add_epi8 (in, roll);
+
+  __m256i ab_cd = _mm256_maddubs_epi16 (values,
+                                        _mm256_set1_epi32 (0x01400140));
+  __m256i abcd = _mm256_madd_epi16 (ab_cd, _mm256_set1_epi32 (0x00011000));
+  abcd = _mm256_shuffle_epi8 (abcd,
+                              _mm256_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9,
+                                                8, 14, 13, 12, -1, -1, -1, -1,
+                                                2, 1, 0, 6, 5, 4, 10, 9,
+                                                8, 14, 13, 12, -1, -1, -1, -1));
+  /* Move the 12 bytes of the high lane next to those of the low lane.  */
+  *result = _mm256_permutevar8x32_epi32 (abcd,
+                                         _mm256_setr_epi32 (0, 1, 2, 4,
+                                                            5, 6, 7, 7));
+  return valid_prefix (good, 32);
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("ssse3")))
+#endif
+idx_t
+base64_decode_ssse3 (char const *restrict in, idx_t inlen,
+                     char *restrict out, idx_t outleft)
+{
+  idx_t i = 0;
+
+  /* Each iteration reads 16 characters and writes 16 bytes, of which the
+     first 12 are output if all the characters are valid.  */
+  while (16 <= inlen - i && 16 <= outleft)
+    {
+      __m128i v;
+      int n = decode_16 (_mm_loadu_si128 ((__m128i_u const *) (in + i)), &v);
+      _mm_storeu_si128 ((__m128i_u *) out, v);
+      i += n;
+      out += n / 4 * 3;
+      outleft -= n / 4 * 3;
+      if (n < 16)
+        break;
+    }
+
+  return i;
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2")))
+#endif
+idx_t
+base64_decode_avx2 (char const *restrict in, idx_t inlen,
+                    char *restrict out, idx_t outleft)
+{
+  idx_t i = 0;
+
+  while (32 <= inlen - i && 32 <= outleft)
+    {
+      __m256i v;
+      int n = decode_32 (_mm256_loadu_si256 ((__m256i_u const *) (in + i)),
+                         &v);
+      _mm256_storeu_si256 ((__m256i_u *) out, v);
+      i += n;
+      out += n / 4 * 3;
+      outleft -= n / 4 * 3;
+      if (n < 32)
+        return i;
+    }
+
+  while (16 <= inlen - i && 16 <= outleft)
+    {
+      __m128i v;
+      int n = decode_16 (_mm_loadu_si128 ((__m128i_u const *) (in + i)), &v);
+      _mm_storeu_si128 ((__m128i_u *) out, v);
+      i += n;
+      out += n / 4 * 3;
+      outleft -= n / 4 * 3;
+      if (n < 16)
+        break;
+    }
+
+  return i;
+}
@@ -0,0 +1,53 @@
+/* base64-x86_64.h -- Base64 encoding and decoding for x86_64
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#ifndef BASE64_X86_64_H
+#define BASE64_X86_64_H 1
+
+/* Get idx_t.  */
+#include <idx.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Encode a prefix of the INLEN bytes at IN, whose length is a multiple of
+   3, into OUT, which has room for BASE64_LENGTH (INLEN) bytes.  Return the
+   length of the prefix.  The rest, which is shorter than 16 bytes, is
+   left to the caller.  These functions require the SSSE3 and AVX2
+   extensions, respectively.  */
+extern idx_t base64_encode_ssse3 (char const *restrict in, idx_t inlen,
+                                  char *restrict out);
+extern idx_t base64_encode_avx2 (char const *restrict in, idx_t inlen,
+                                 char *restrict out);
+
+/* Decode a prefix of the INLEN bytes at IN into OUT, which has room for
+   OUTLEFT bytes.  The prefix consists of whole groups of four characters
+   of the base64 alphabet, without padding and without newlines.  Return
+   the length of the prefix; 3/4 of it is the length of the output.  The
+   group of four that contains another character, as well as the last
+   few groups, is left to the caller.  Bytes of OUT after the output may
+   be clobbered.  */
+extern idx_t base64_decode_ssse3 (char const *restrict in, idx_t inlen,
+                                  char *restrict out, idx_t outleft);
+extern idx_t base64_decode_avx2 (char const *restrict in, idx_t inlen,
+                                 char *restrict out, idx_t outleft);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BASE64_X86_64_H */
@@ -52,6 +52,25 @@
 
 #include <string.h>
 
+#ifdef GL_BASE64_X86_64
+# include "cpu-supports.h"
+# include "base64-x86_64.h"
+static bool ssse3_enabled = false;
+static bool avx2_enabled = false;
+static bool simd_checked = false;
+
+static void
+check_simd (void)
+{
+  if (!simd_checked)
+    {
+      ssse3_enabled = cpu_supports ("ssse3");
+      avx2_enabled = ssse3_enabled && cpu_supports ("avx2");
+      simd_checked = true;
+    }
+}
+#endif
+
 /* Convert 'char' to 'unsigned char' without casting.  */
 static unsigned char
 to_uchar (char ch)
@@ -68,6 +87,19 @@ static const char b64c[64] _GL_ATTRIBUTE_NONSTRING =
 static void
 base64_encode_fast (const char *restrict in, idx_t inlen, char *restrict out)
 {
+#ifdef GL_BASE64_X86_64
+  if (16 <= inlen)
+    {
+      check_simd ();
+      idx_t n = (avx2_enabled ? base64_encode_avx2 (in, inlen, out)
+                 : ssse3_enabled ? base64_encode_ssse3 (in, inlen, out)
+                 : 0);
+      in += n;
+      inlen -= n;
+      out += n / 3 * 4;
+    }
+#endif
+
   while (inlen)
     {
       *out++ = b64c[(to_uchar (in[0]) >> 2) & 0x3f];
@@ -101,6 +133,21 @@ base64_encode (const char *restrict in, idx_t inlen,
       return;
     }
 
+  /* Otherwise, encode the whole groups that fit in OUT with the fast
+     function, and the rest below.  This is the case for
+     base64_encode_alloc, which also wants a terminating zero.  */
+  {
+    idx_t groups = inlen / 3 < outlen / 4 ? inlen / 3 : outlen / 4;
+    if (groups > 0)
+      {
+        base64_encode_fast (in, groups * 3, out);
+        in += groups * 3;
+        inlen -= groups * 3;
+        out += groups * 4;
+        outlen -= groups * 4;
+      }
+  }
+
   while (inlen && outlen)
     {
       *out++ = b64c[(to_uchar (in[0]) >> 2) & 0x3f];
@@ -164,6 +211,59 @@ base64_encode_alloc (const char *in, idx_t inlen, char **out)
   return outlen - 1;
 }
 
+/* Base64 encode IN array of size INLEN into OUT, continuing the
+   encoding described by CTX.  Bytes that do not make up a whole group of
+   three are kept in CTX, for the next call.  If INLEN is zero, encode
+   whatever is stored in CTX, with padding, and end the encoding.  OUT
+   needs to be of length >= BASE64_LENGTH (INLEN + 2).  Return the number
+   of bytes stored in OUT, which is not zero terminated.
+
+   Initially, CTX must have been initialized via base64_encode_ctx_init.
+   The outputs of successive calls, up to and including the final one
+   with INLEN zero, concatenate to the encoding of the whole input.  This
+   allows to encode input of any size through fixed size buffers.  */
+idx_t
+base64_encode_ctx (struct base64_encode_context *ctx,
+                   const char *restrict in, idx_t inlen,
+                   char *restrict out)
+{
+  char *p = out;
+
+  if (inlen == 0)
+    {
+      if (ctx->i)
+        {
+          base64_encode (ctx->buf, ctx->i, p, 4);
+          p += 4;
+          ctx->i = 0;
+        }
+      return p - out;
+    }
+
+  if (ctx->i)
+    {
+      while (ctx->i < 3 && inlen)
+        {
+          ctx->buf[ctx->i++] = *in++;
+          inlen--;
+        }
+      if (ctx->i < 3)
+        return 0;
+      base64_encode_fast (ctx->buf, 3, p);
+      p += 4;
+      ctx->i = 0;
+    }
+
+  idx_t n = inlen - inlen % 3;
+  base64_encode_fast (in, n, p);
+  p += n / 3 * 4;
+
+  ctx->i = inlen - n;
+  memcpy (ctx->buf, in + n, ctx->i);
+
+  return p - out;
+}
+
 /* With this approach this file works independent of the charset used
    (think EBCDIC).  However, it does assume that the characters in the
    Base64 alphabet (A-Za-z0-9+/) are encoded in 0..255.  POSIX
@@ -486,6 +586,25 @@ base64_decode_ctx (struct base64_decode_context *ctx,
         {
           while (true)
             {
+#ifdef GL_BASE64_X86_64
+              /* Decode the longest prefix of whole groups of four
+                 characters that contains no padding and no newlines.  */
+              if (16 <= inlen && 16 <= outleft)
+                {
+                  check_simd ();
+                  idx_t n =
+                    (avx2_enabled
+                     ? base64_decode_avx2 (in, inlen, out, outleft)
+                     : ssse3_enabled
+                     ? base64_decode_ssse3 (in, inlen, out, outleft)
+                     : 0);
+                  in += n;
+                  inlen -= n;
+                  out += n / 4 * 3;
+                  outleft -= n / 4 * 3;
+                }
+#endif
+
               /* Save a copy of outleft, in case we need to re-parse this
                  block of four bytes.  */
               outleft_save = outleft;
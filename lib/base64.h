@@ -44,6 +44,12 @@ extern "C" {
    integer >= n/k, i.e., the ceiling of n/k.  */
 #define BASE64_LENGTH(inlen) ((((inlen) + 2) / 3) * 4)
 
+struct base64_encode_context
+{
+  int i;
+  char buf[3];
+};
+
 struct base64_decode_context
 {
   int i;
@@ -69,6 +75,17 @@ extern void base64_encode (const char *restrict in, idx_t inlen,
 
 extern idx_t base64_encode_alloc (const char *in, idx_t inlen, char **out);
 
+/* Initialize encode-context buffer, CTX.  */
+BASE64_INLINE void
+base64_encode_ctx_init (struct base64_encode_context *ctx)
+{
+  ctx->i = 0;
+}
+
+extern idx_t base64_encode_ctx (struct base64_encode_context *ctx,
+                                const char *restrict in, idx_t inlen,
+                                char *restrict out);
+
 /* Initialize decode-context buffer, CTX.  */
 BASE64_INLINE void
 base64_decode_ctx_init (struct base64_decode_context *ctx)
@@ -0,0 +1,492 @@
+/* A hash table that can be shared between threads.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "concurrent-hash.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "alignalloc.h"
+#include "flexmember.h"
+#include "glthread/lock.h"
+#include "glthread/thread.h"
+#include "simple-atomic.h"
+
+/* Memory ordering.
+   A writer initializes a node or a bucket array, calls memory_barrier, and
+   only then stores a pointer to it where lookups can see it.  Lookups read
+   the pointers through 'volatile' lvalues and follow them without
+   barriers, relying on the ordering of dependent loads, which all the
+   supported CPUs provide.
+   Lookups announce themselves with atomic_compare_and_swap, which is a full
+   memory barrier.  A writer that has unlinked some memory calls
+   memory_barrier before it looks at the announcements.  So either the
+   writer sees the announcement of a lookup, or the lookup does not see
+   the unlinked memory.  */
+
+/* The number of stripes of the buckets, each with its own lock.
+   A power of 2.  */
+enum { N_STRIPES = 64 };
+
+/* The number of counters of read-side critical sections.  Threads are
+   spread over them according to their identity.  A power of 2.  */
+enum { N_READER_SLOTS = 64 };
+
+/* The size of a cache line, at least on the common CPUs.  The data that
+   different threads modify is kept in different cache lines.  */
+enum { CACHE_LINE_SIZE = 64 };
+
+#define PADDED_SIZE(n) \
+  (((n) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE * CACHE_LINE_SIZE)
+
+/* The number of removed nodes from which on the table tries to free the
+   memory that no lookup can see any more.  */
+enum { RECLAIM_THRESHOLD = 64 };
+
+struct chash_node
+{
+  struct chash_node *volatile next;
+  size_t hash;                          /* mixed hash code of ENTRY */
+  void *entry;
+  struct chash_node *retired_next;      /* link in the lists of removed nodes */
+};
+
+struct chash_buckets
+{
+  struct chash_buckets *retired_next;   /* link in the lists of old arrays */
+  size_t n_buckets;                     /* a power of 2, >= N_STRIPES */
+  struct chash_node *volatile bucket[FLEXIBLE_ARRAY_MEMBER];
+};
+
+struct reader_slot
+{
+  /* The number of read-side critical sections in progress that started in
+     an even epoch and in an odd epoch, respectively.  */
+  unsigned int volatile count[2];
+  char pad[CACHE_LINE_SIZE - 2 * sizeof (unsigned int)];
+};
+
+struct stripe
+{
+  /* Protects the buckets whose index is congruent to the index of this
+     stripe modulo N_STRIPES.  */
+  gl_lock_t lock;
+  /* The number of entries in these buckets.  */
+  size_t volatile n_entries;
+};
+
+union padded_stripe
+{
+  struct stripe s;
+  char pad[PADDED_SIZE (sizeof (struct stripe))];
+};
+
+struct chash_table
+{
+  /* The fields that every lookup reads, and that rarely change.  */
+  struct chash_buckets *volatile buckets;
+  unsigned int volatile epoch;
+  Hash_hasher hasher;
+  Hash_comparator comparator;
+  Hash_data_freer data_freer;
+  char pad[CACHE_LINE_SIZE - 5 * sizeof (void *)];
+
+  struct reader_slot readers[N_READER_SLOTS];
+  union padded_stripe stripes[N_STRIPES];
+
+  /* The memory that may still be seen by lookups, protected by
+     RECLAIM_LOCK.  The "pending" lists hold the memory retired in the
+     current epoch, the "waiting" lists the memory retired in the previous
+     epoch.  */
+  gl_lock_t reclaim_lock;
+  struct chash_node *pending_nodes;
+  struct chash_node *waiting_nodes;
+  struct chash_buckets *pending_buckets;
+  struct chash_buckets *waiting_buckets;
+  size_t n_pending;
+};
+
+/* Return H with its bits mixed, so that both its low bits, which select
+   the stripe and the bucket, and its high bits depend on all bits of H.  */
+static size_t
+mix (size_t h)
+{
+#if SIZE_MAX >> 31 >> 1 != 0
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccd;
+  h ^= h >> 33;
+#else
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+#endif
+  return h;
+}
+
+/* Return the index of the reader slot of the current thread.  */
+static unsigned int
+reader_slot (void)
+{
+  /* Thread identifiers are often the addresses of thread control blocks,
+     which are far apart: mix their bits.  */
+  return mix ((uintptr_t) gl_thread_self_pointer ()) & (N_READER_SLOTS - 1);
+}
+
+static struct stripe *
+stripe_of (Chash_table *table, size_t hash)
+{
+  return &table->stripes[hash & (N_STRIPES - 1)].s;
+}
+
+/* Allocate a bucket array with N_BUCKETS empty buckets.  Return NULL if
+   memory is exhausted.  */
+static struct chash_buckets *
+allocate_buckets (size_t n_buckets)
+{
+  if ((SIZE_MAX - sizeof (struct chash_buckets)) / sizeof (struct chash_node *)
+      < n_buckets)
+    return NULL;
+  struct chash_buckets *b =
+    calloc (1, FLEXSIZEOF (struct chash_buckets, bucket,
+                           n_buckets * sizeof (struct chash_node *)));
+  if (b)
+    b->n_buckets = n_buckets;
+  return b;
+}
+
+/* Free the bucket array B and its nodes, and call DATA_FREER, if not NULL,
+   on its entries.  */
+static void
+free_buckets (struct chash_buckets *b, Hash_data_freer data_freer)
+{
+  for (size_t i = 0; i < b->n_buckets; i++)
+    {
+      struct chash_node *next;
+      for (struct chash_node *node = b->bucket[i]; node; node = next)
+        {
+          next = node->next;
+          if (data_freer)
+            data_freer (node->entry);
+          free (node);
+        }
+    }
+  free (b);
+}
+
+/* Free the bucket arrays in the list B, and their nodes, but not their
+   entries: the current bucket array has copies of the nodes.  */
+static void
+free_retired_buckets (struct chash_buckets *b)
+{
+  struct chash_buckets *next;
+  for (; b; b = next)
+    {
+      next = b->retired_next;
+      free_buckets (b, NULL);
+    }
+}
+
+/* Free the removed nodes in the list NODE, and call DATA_FREER, if not
+   NULL, on their entries.  */
+static void
+free_retired_nodes (struct chash_node *node, Hash_data_freer data_freer)
+{
+  struct chash_node *next;
+  for (; node; node = next)
+    {
+      next = node->retired_next;
+      if (data_freer)
+        data_freer (node->entry);
+      free (node);
+    }
+}
+
+/* Free the memory retired in the previous epoch, if the read-side critical
+   sections that started before the current epoch are all done, and start
+   a new epoch.  Otherwise, do nothing: a later call will do it.
+   TABLE->reclaim_lock must be held.  */
+static void
+try_reclaim (Chash_table *table)
+{
+  unsigned int previous = (table->epoch & 1) ^ 1;
+
+  memory_barrier ();
+  for (int i = 0; i < N_READER_SLOTS; i++)
+    if (table->readers[i].count[previous] != 0)
+      return;
+  memory_barrier ();
+
+  free_retired_nodes (table->waiting_nodes, table->data_freer);
+  free_retired_buckets (table->waiting_buckets);
+  table->waiting_nodes = table->pending_nodes;
+  table->waiting_buckets = table->pending_buckets;
+  table->pending_nodes = NULL;
+  table->pending_buckets = NULL;
+  table->n_pending = 0;
+  table->epoch++;
+}
+
+/* Free NODE, which has been unlinked from the table, once no lookup can
+   see it any more.  */
+static void
+retire_node (Chash_table *table, struct chash_node *node)
+{
+  gl_lock_lock (table->reclaim_lock);
+  node->retired_next = table->pending_nodes;
+  table->pending_nodes = node;
+  if (++table->n_pending >= RECLAIM_THRESHOLD)
+    try_reclaim (table);
+  gl_lock_unlock (table->reclaim_lock);
+}
+
+/* Free the bucket array B, which has been replaced, once no lookup can see
+   it any more.  */
+static void
+retire_buckets (Chash_table *table, struct chash_buckets *b)
+{
+  gl_lock_lock (table->reclaim_lock);
+  b->retired_next = table->pending_buckets;
+  table->pending_buckets = b;
+  table->n_pending++;
+  try_reclaim (table);
+  gl_lock_unlock (table->reclaim_lock);
+}
+
+/* Replace the bucket array OLD of TABLE with one twice as large, unless
+   another thread has already done so.  If memory is exhausted, keep OLD:
+   this only makes the chains longer.  */
+static void
+grow (Chash_table *table, struct chash_buckets *old)
+{
+  for (int i = 0; i < N_STRIPES; i++)
+    gl_lock_lock (table->stripes[i].s.lock);
+
+  if (table->buckets == old && old->n_buckets <= SIZE_MAX / 2)
+    {
+      size_t n_buckets = 2 * old->n_buckets;
+      struct chash_buckets *new = allocate_buckets (n_buckets);
+
+      /* Copy the nodes, since lookups may be walking the old chains.  */
+      for (size_t i = 0; new && i < old->n_buckets; i++)
+        for (struct chash_node *node = old->bucket[i]; node; node = node->next)
+          {
+            struct chash_node *copy = malloc (sizeof *copy);
+            if (!copy)
+              {
+                free_buckets (new, NULL);
+                new = NULL;
+                break;
+              }
+            struct chash_node *volatile *head =
+              &new->bucket[node->hash & (n_buckets - 1)];
+            copy->next = *head;
+            copy->hash = node->hash;
+            copy->entry = node->entry;
+            *head = copy;
+          }
+
+      if (new)
+        {
+          memory_barrier ();
+          table->buckets = new;
+          retire_buckets (table, old);
+        }
+    }
+
+  for (int i = N_STRIPES - 1; i >= 0; i--)
+    gl_lock_unlock (table->stripes[i].s.lock);
+}
+
+Chash_table *
+chash_initialize (size_t candidate, Hash_hasher hasher,
+                  Hash_comparator comparator, Hash_data_freer data_freer)
+{
+  size_t n_buckets = N_STRIPES;
+  while (n_buckets < candidate && n_buckets <= SIZE_MAX / 4)
+    n_buckets *= 2;
+
+  Chash_table *table = alignalloc (CACHE_LINE_SIZE, sizeof *table);
+  if (!table)
+    return NULL;
+  memset (table, 0, sizeof *table);
+  table->hasher = hasher;
+  table->comparator = comparator;
+  table->data_freer = data_freer;
+  table->buckets = allocate_buckets (n_buckets);
+  if (!table->buckets)
+    goto fail;
+
+  int i;
+  for (i = 0; i < N_STRIPES; i++)
+    if (glthread_lock_init (&table->stripes[i].s.lock) != 0)
+      goto fail_locks;
+  if (glthread_lock_init (&table->reclaim_lock) != 0)
+    goto fail_locks;
+
+  return table;
+
+ fail_locks:
+  while (--i >= 0)
+    glthread_lock_destroy (&table->stripes[i].s.lock);
+  free (table->buckets);
+ fail:
+  alignfree (table);
+  return NULL;
+}
+
+void
+chash_free (Chash_table *table)
+{
+  free_buckets (table->buckets, table->data_freer);
+  free_retired_nodes (table->pending_nodes, table->data_freer);
+  free_retired_nodes (table->waiting_nodes, table->data_freer);
+  free_retired_buckets (table->pending_buckets);
+  free_retired_buckets (table->waiting_buckets);
+  for (int i = 0; i < N_STRIPES; i++)
+    gl_lock_destroy (table->stripes[i].s.lock);
+  gl_lock_destroy (table->reclaim_lock);
+  alignfree (table);
+}
+
+size_t
+chash_get_n_entries (const Chash_table *table)
+{
+  size_t n = 0;
+  for (int i = 0; i < N_STRIPES; i++)
+    n += table->stripes[i].s.n_entries;
+  return n;
+}
+
+unsigned int
+chash_read_lock (Chash_table *table)
+{
+  unsigned int slot = reader_slot ();
+  unsigned int parity = table->epoch & 1;
+  unsigned int volatile *count = &table->readers[slot].count[parity];
+  unsigned int old;
+  do
+    old = *count;
+  while (atomic_compare_and_swap (count, old, old + 1) != old);
+  return 2 * slot + parity;
+}
+
+void
+chash_read_unlock (Chash_table *table, unsigned int cookie)
+{
+  unsigned int volatile *count = &table->readers[cookie >> 1].count[cookie & 1];
+  unsigned int old;
+  do
+    old = *count;
+  while (atomic_compare_and_swap (count, old, old - 1) != old);
+}
+
+void *
+chash_lookup (Chash_table *table, const void *entry)
+{
+  size_t hash = mix (table->hasher (entry, SIZE_MAX));
+  void *result = NULL;
+  unsigned int cookie = chash_read_lock (table);
+
+  struct chash_buckets *b = table->buckets;
+  for (struct chash_node *node = b->bucket[hash & (b->n_buckets - 1)];
+       node;
+       node = node->next)
+    if (node->hash == hash && table->comparator (entry, node->entry))
+      {
+        result = node->entry;
+        break;
+      }
+
+  chash_read_unlock (table, cookie);
+  return result;
+}
+
+int
+chash_insert_if_absent (Chash_table *table, const void *entry,
+                        const void **matched_ent)
+{
+  /* The caller cannot look for the NULL entry, since chash_lookup would
+     be ambiguous.  */
+  if (! entry)
+    abort ();
+
+  size_t hash = mix (table->hasher (entry, SIZE_MAX));
+  struct stripe *stripe = stripe_of (table, hash);
+  gl_lock_lock (stripe->lock);
+
+  /* While the stripe is locked, the table cannot grow.  */
+  struct chash_buckets *b = table->buckets;
+  struct chash_node *volatile *head = &b->bucket[hash & (b->n_buckets - 1)];
+  for (struct chash_node *node = *head; node; node = node->next)
+    if (node->hash == hash && table->comparator (entry, node->entry))
+      {
+        gl_lock_unlock (stripe->lock);
+        if (matched_ent)
+          *matched_ent = node->entry;
+        return 0;
+      }
+
+  struct chash_node *node = malloc (sizeof *node);
+  if (!node)
+    {
+      gl_lock_unlock (stripe->lock);
+      return -1;
+    }
+  node->next = *head;
+  node->hash = hash;
+  node->entry = (void *) entry;
+  memory_barrier ();
+  *head = node;
+
+  /* Grow when the average chain length exceeds 1.  */
+  bool full = ++stripe->n_entries > b->n_buckets / N_STRIPES;
+  gl_lock_unlock (stripe->lock);
+
+  if (full)
+    grow (table, b);
+  return 1;
+}
+
+bool
+chash_remove (Chash_table *table, const void *entry)
+{
+  size_t hash = mix (table->hasher (entry, SIZE_MAX));
+  struct stripe *stripe = stripe_of (table, hash);
+  gl_lock_lock (stripe->lock);
+
+  struct chash_buckets *b = table->buckets;
+  struct chash_node *node;
+  for (struct chash_node *volatile *prev =
+         &b->bucket[hash & (b->n_buckets - 1)];
+       (node = *prev) != NULL;
+       prev = &node->next)
+    if (node->hash == hash && table->comparator (entry, node->entry))
+      {
+        /* Lookups that are at NODE continue with its successor.  */
+        *prev = node->next;
+        stripe->n_entries--;
+        gl_lock_unlock (stripe->lock);
+        retire_node (table, node);
+        return true;
+      }
+
+  gl_lock_unlock (stripe->lock);
+  return false;
+}
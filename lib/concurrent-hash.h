@@ -0,0 +1,119 @@
+/* A hash table that can be shared between threads.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* This table holds entries, like the tables of "hash.h", but any number of
+   threads may look up, insert and remove entries at the same time, without
+   an external lock.
+
+   It is designed for tables that are read much more often than they are
+   modified:
+     - Lookups take no lock and never wait: they only announce themselves
+       in a counter that is private to a group of threads, so that lookups
+       in different threads do not write to the same cache lines.
+     - Insertions and removals lock one of a fixed number of stripes of the
+       buckets, so that modifications of different stripes proceed in
+       parallel.
+     - The table grows by copying the chains to a new bucket array while
+       all the stripes are locked.  Lookups continue meanwhile, in the old
+       bucket array.
+     - Removed entries and the old bucket arrays are freed only once no
+       lookup can still see them.  This is detected by an epoch counter,
+       in the style of read-copy-update: a writer flips the epoch and waits
+       -- without blocking, by checking again at later modifications --
+       until the lookups that started in the previous epoch are done.
+   The table never shrinks.  */
+
+#ifndef _CONCURRENT_HASH_H
+#define _CONCURRENT_HASH_H
+
+/* This file uses _GL_ATTRIBUTE_DEALLOC, _GL_ATTRIBUTE_NODISCARD.  */
+#if !_GL_CONFIG_H_INCLUDED
+ #error "Please include config.h first."
+#endif
+
+#include <stddef.h>
+
+#include "hash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct chash_table;
+
+typedef struct chash_table Chash_table;
+
+/* Free all the entries of TABLE, by calling its data freer if not NULL,
+   and free TABLE.  No other thread may use TABLE at this point.  */
+extern void chash_free (Chash_table *table);
+
+/* Allocate and return a new table, or NULL if memory is exhausted.
+   CANDIDATE is a hint for the number of entries that the table will hold.
+   HASHER and COMPARATOR are as for hash_initialize, except that they must
+   not be NULL, and that HASHER is always called with a TABLE_SIZE of
+   SIZE_MAX: the table mixes its result, so that all its bits matter.
+   Both may be called from any thread, concurrently.
+   DATA_FREER, when not NULL, is called on the entries that are removed
+   from the table, once no thread can still be looking at them, and on
+   the entries that remain when the table is freed.  It must not use
+   the table.  */
+extern Chash_table *chash_initialize (size_t candidate,
+                                      Hash_hasher hasher,
+                                      Hash_comparator comparator,
+                                      Hash_data_freer data_freer)
+  _GL_ATTRIBUTE_NODISCARD _GL_ATTRIBUTE_DEALLOC (chash_free, 1);
+
+/* Return the number of entries in TABLE.  While other threads modify the
+   table, this is only an approximation.  */
+extern size_t chash_get_n_entries (const Chash_table *table);
+
+/* If ENTRY matches an entry already in TABLE, return the entry from the
+   table.  Otherwise, return NULL.
+   If other threads may remove this entry from the table and the table has
+   a data freer, the returned entry may be freed at any time, unless the
+   call is within a chash_read_lock / chash_read_unlock pair.  */
+extern void *chash_lookup (Chash_table *table, const void *entry);
+
+/* Insert ENTRY into TABLE if there is no matching entry in it yet.
+   Return -1 upon memory allocation failure.
+   Return 1 if insertion succeeded.
+   Return 0 if there is already a matching entry in the table, and in that
+   case, if MATCHED_ENT is non-NULL, set *MATCHED_ENT to that entry.  */
+extern int chash_insert_if_absent (Chash_table *table, const void *entry,
+                                   const void **matched_ent);
+
+/* If ENTRY matches an entry in TABLE, remove that entry from the table,
+   and return true.  Otherwise, return false.  The data freer of the table,
+   if any, is called on the removed entry later, once no thread can still
+   be looking at it.  */
+extern bool chash_remove (Chash_table *table, const void *entry);
+
+/* Read-side critical sections.
+   The entries returned by chash_lookup between a call to chash_read_lock
+   and the matching call to chash_read_unlock, which takes the value
+   returned by chash_read_lock, remain valid until chash_read_unlock, even
+   if other threads remove them from TABLE meanwhile.
+   Read-side critical sections may be nested.  They should be short: no
+   memory is reclaimed while a critical section that started before the
+   last epoch flip is in progress.  */
+extern unsigned int chash_read_lock (Chash_table *table);
+extern void chash_read_unlock (Chash_table *table, unsigned int cookie);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _CONCURRENT_HASH_H */
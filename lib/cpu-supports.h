@@ -65,11 +65,17 @@ gcc_feature_to_glibc_hwcap (char const *feature)
 
   if (0) {}
   /* x86_64 */
+  else if (streq (feature, "aes"))          hwcap = "-AES";
   else if (streq (feature, "avx"))          hwcap = "-AVX";
   else if (streq (feature, "avx2"))         hwcap = "-AVX2";
   else if (streq (feature, "avx512bw"))     hwcap = "-AVX512BW";
   else if (streq (feature, "avx512f"))      hwcap = "-AVX512F";
+  else if (streq (feature, "bmi2"))         hwcap = "-BMI2";
   else if (streq (feature, "pclmul"))       hwcap = "-PCLMULQDQ";
+  else if (streq (feature, "sha"))          hwcap = "-SHA";
+  else if (streq (feature, "sse4.1"))       hwcap = "-SSE4_1";
+  else if (streq (feature, "sse4.2"))       hwcap = "-SSE4_2";
+  else if (streq (feature, "ssse3"))        hwcap = "-SSSE3";
   else if (streq (feature, "vpclmulqdq"))   hwcap = "-VPCLMULQDQ";
   /* aarch64 */
   else if (streq (feature, "asimd"))        hwcap = "-ASIMD";
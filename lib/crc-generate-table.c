@@ -16,8 +16,11 @@
 
 /* Written by Sam Russell. */
 
+#include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /*
  * The following function was extracted from RFC 1952 by Sam
@@ -37,7 +40,14 @@
  * which uses a single lookup table of make_crc_table(8), and for
  * the slice-by-8 algorithm which uses 8 tables from in 8-bit
  * increments from make_crc_table(8) to make_crc_table(64)
+ *
+ * The polynomial is that of CRC32, or that of CRC32C (Castagnoli)
+ * as used by iSCSI, SCTP and ext4.
  */
+#define CRC32_POLY 0xedb88320L
+#define CRC32C_POLY 0x82f63b78L
+
+static unsigned long poly = CRC32_POLY;
 static unsigned long crc_table[256];
 
 static void
@@ -49,7 +59,7 @@ make_crc_table (int bits)
       for (int k = 0; k < bits; k++)
         {
           if (c & 1)
-            c = 0xedb88320L ^ (c >> 1);
+            c = poly ^ (c >> 1);
           else
             c = c >> 1;
         }
@@ -57,11 +67,36 @@ make_crc_table (int bits)
     }
 }
 
+/*
+ * make_shift_table() generates the lookup table for multiplying a
+ * CRC by x^(8 * len) modulo the polynomial, that is, for computing
+ * the CRC (without initial and final XOR) of the CRC followed by LEN
+ * zero bytes.  Byte SLICE of the CRC is looked up in the table for
+ * SLICE, and the results of the four slices are XORed together.
+ *
+ * This is used for combining the CRCs of interleaved streams.
+ */
 static void
-print_crc_table (FILE * stream, int bits)
+make_shift_table (size_t len, int slice)
 {
-  make_crc_table (bits);
+  unsigned long byte_table[256];
 
+  make_crc_table (8);
+  for (int n = 0; n < 256; n++)
+    byte_table[n] = crc_table[n];
+
+  for (int n = 0; n < 256; n++)
+    {
+      unsigned long c = (unsigned long) n << (8 * slice);
+      for (size_t i = 0; i < len; i++)
+        c = byte_table[c & 0xFF] ^ (c >> 8);
+      crc_table[n] = c;
+    }
+}
+
+static void
+print_table (FILE * stream)
+{
   fprintf (stream, "  {");
 
   for (int i = 0; i < 256; i++)
@@ -78,10 +113,18 @@ print_crc_table (FILE * stream, int bits)
 }
 
 static void
-print_header (FILE * stream)
+print_crc_table (FILE * stream, int bits)
+{
+  make_crc_table (bits);
+  print_table (stream);
+}
+
+static void
+print_header (FILE * stream, const char *prefix)
 {
   fprintf (stream, "/* Slice-by-8 lookup tables */\n");
-  fprintf (stream, "static const uint32_t crc32_sliceby8_table[][256] = {\n");
+  fprintf (stream, "static const uint32_t %s_sliceby8_table[][256] = {\n",
+           prefix);
   for (int i = 8; i <= 64; i += 8)
     {
       print_crc_table (stream, i);
@@ -93,12 +136,33 @@ print_header (FILE * stream)
 }
 
 static void
-print_copyright_notice (FILE * stream)
+print_shift_table (FILE * stream, const char *name, const char *macro,
+                   size_t len)
 {
-  fprintf (stream, "/* DO NOT EDIT! GENERATED AUTOMATICALLY! */\n");
-  fprintf (stream, "/* crc.c -- cyclic redundancy checks\n");
   fprintf (stream,
-           "Copyright (C) 2005-2006, 2009-2026 Free Software Foundation, Inc.\n");
+           "\n/* Lookup tables for shifting a CRC over %zu zero bytes */\n",
+           len);
+  fprintf (stream, "#define %s %zu\n", macro, len);
+  fprintf (stream, "static const uint32_t %s_shift_table[][256] = {\n",
+           name);
+  for (int slice = 0; slice < 4; slice++)
+    {
+      make_shift_table (len, slice);
+      print_table (stream);
+      if (slice < 3)
+        fprintf (stream, ",");
+      fprintf (stream, "\n");
+    }
+  fprintf (stream, "};\n");
+}
+
+static void
+print_copyright_notice (FILE * stream, const char *source, const char *years)
+{
+  fprintf (stream, "/* DO NOT EDIT! GENERATED AUTOMATICALLY! */\n");
+  fprintf (stream, "/* %s -- cyclic redundancy checks\n", source);
+  fprintf (stream, "Copyright (C) %s Free Software Foundation, Inc.\n",
+           years);
   fprintf (stream, "\n");
   fprintf (stream,
            "This file is free software: you can redistribute it and/or modify\n");
@@ -125,13 +189,15 @@ print_copyright_notice (FILE * stream)
 int
 main (int argc, char *argv[])
 {
-  if (argc != 2)
+  bool crc32c = argc == 3 && strcmp (argv[1], "crc32c") == 0;
+  if (!(argc == 2 || crc32c))
     {
       fprintf (stderr, " Usage: %s crc-sliceby8.h\n", argv[0]);
+      fprintf (stderr, "        %s crc32c crc32c-sliceby8.h\n", argv[0]);
       exit (1);
     }
 
-  const char *filename = argv[1];
+  const char *filename = argv[argc - 1];
   FILE *stream = fopen (filename, "w");
   if (stream == NULL)
     {
@@ -139,8 +205,23 @@ main (int argc, char *argv[])
       exit (1);
     }
 
-  print_copyright_notice (stream);
-  print_header (stream);
+  if (crc32c)
+    {
+      poly = CRC32C_POLY;
+      print_copyright_notice (stream, "crc32c.c", "2024-2026");
+      print_header (stream, "crc32c");
+      /* The block sizes of the interleaved streams in crc32c.c.  */
+      fprintf (stream, "\n#ifdef GL_CRC32C_X86_64\n");
+      print_shift_table (stream, "crc32c_long", "CRC32C_LONG", 8192);
+      print_shift_table (stream, "crc32c_short", "CRC32C_SHORT", 256);
+      fprintf (stream, "#endif\n");
+    }
+  else
+    {
+      print_copyright_notice (stream, "crc.c",
+                              "2005-2006, 2009-2026");
+      print_header (stream, "crc32");
+    }
 
   if (ferror (stream) || fclose (stream))
     {
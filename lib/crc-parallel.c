@@ -0,0 +1,84 @@
+/* crc-parallel.c -- cyclic redundancy checks using several threads
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "crc.h"
+
+#include "glthread/thread.h"
+
+/* The maximum number of threads.  */
+#define MAX_THREADS 64
+
+/* Chunks shorter than this are not worth a thread of their own.  */
+#define MIN_CHUNK (1024 * 1024)
+
+struct chunk
+{
+  const char *buf;
+  size_t len;
+  uint32_t crc;
+};
+
+static void *
+chunk_crc (void *arg)
+{
+  struct chunk *c = arg;
+  c->crc = crc32 (c->buf, c->len);
+  return NULL;
+}
+
+uint32_t
+crc32_parallel (const char *buf, size_t len, int nthreads)
+{
+  if (nthreads < 2 || len < 2 * MIN_CHUNK)
+    return crc32 (buf, len);
+  if (nthreads > MAX_THREADS)
+    nthreads = MAX_THREADS;
+  if (nthreads > len / MIN_CHUNK)
+    nthreads = len / MIN_CHUNK;
+
+  /* Split BUF into NTHREADS chunks of nearly equal size, and let the
+     calling thread handle the first chunk.  */
+  struct chunk chunks[MAX_THREADS];
+  gl_thread_t threads[MAX_THREADS];
+  bool started[MAX_THREADS];
+  size_t chunk_len = len / nthreads;
+  for (int i = 0; i < nthreads; i++)
+    {
+      chunks[i].buf = buf + i * chunk_len;
+      chunks[i].len = i < nthreads - 1 ? chunk_len : len - i * chunk_len;
+    }
+
+  for (int i = 1; i < nthreads; i++)
+    started[i] = glthread_create (&threads[i], chunk_crc, &chunks[i]) == 0;
+  chunk_crc (&chunks[0]);
+
+  /* Fold the CRCs of the chunks, in order.  If a thread could not be
+     started, do its work here.  */
+  uint32_t crc = chunks[0].crc;
+  for (int i = 1; i < nthreads; i++)
+    {
+      if (started[i])
+        gl_thread_join (threads[i], NULL);
+      else
+        chunk_crc (&chunks[i]);
+      crc = crc32_combine (crc, chunks[i].crc, chunks[i].len);
+    }
+
+  return crc;
+}
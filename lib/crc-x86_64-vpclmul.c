@@ -0,0 +1,120 @@
+/* crc-x86_64-vpclmul.c -- CRC32 implementation using VPCLMULQDQ
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "crc-x86_64.h"
+
+#include <string.h>
+#include <x86intrin.h>
+
+#include "crc.h"
+
+/* This is the method of crc-x86_64-pclmul.c, widened to 512-bit vectors:
+   each 512-bit vector holds four 128-bit lanes that are folded
+   independently, with the same constants as there, but broadcast to all
+   lanes.  The main loop folds 4x 512 bits forward by 2048 bits.  */
+
+/* Fold X forward, with the constants K, and add DATA.  */
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("vpclmulqdq,avx512f")))
+#endif
+static inline __m512i
+fold512 (__m512i x, __m512i k, __m512i data)
+{
+  __m512i fold_high = _mm512_clmulepi64_epi128 (x, k, 0x11);
+  __m512i fold_low = _mm512_clmulepi64_epi128 (x, k, 0x00);
+  /* data ^ fold_high ^ fold_low */
+  return _mm512_ternarylogic_epi64 (data, fold_high, fold_low, 0x96);
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("pclmul,avx")))
+#endif
+static inline __m128i
+fold128 (__m128i x, __m128i k, __m128i data)
+{
+  __m128i fold_high = _mm_clmulepi64_si128 (x, k, 0x11);
+  __m128i fold_low = _mm_clmulepi64_si128 (x, k, 0x00);
+  return _mm_xor_si128 (_mm_xor_si128 (data, fold_high), fold_low);
+}
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("vpclmulqdq,avx512f,pclmul,avx")))
+#endif
+uint32_t
+crc32_update_no_xor_vpclmul (uint32_t crc, const void *buf, size_t len)
+{
+  /* These constants are T-1 mod P, see crc-x86_64-pclmul.c.  */
+  __m512i shift2080_shift2016 =
+    _mm512_broadcast_i32x4 (_mm_set_epi64x (0xE95C1271, 0xCE3371CB));
+  __m512i shift544_shift480 =
+    _mm512_broadcast_i32x4 (_mm_set_epi64x (0x1D9513D7, 0x8F352D95));
+  __m128i shift416_shift352 = _mm_set_epi64x (0xAF449247, 0x3DB1ECDC);
+  __m128i shift288_shift224 = _mm_set_epi64x (0x81256527, 0xF1DA05AA);
+  __m128i shift160_shift96 = _mm_set_epi64x (0xCCAA009E, 0xAE689191);
+
+  const char *data = buf;
+
+  if (len < 256)
+    return crc32_update_no_xor_pclmul (crc, buf, len);
+
+  /* Load the first 2048 bits and initialise with the incoming CRC.  */
+  __m512i in1 = _mm512_loadu_si512 (data);
+  __m512i in2 = _mm512_loadu_si512 (data + 64);
+  __m512i in3 = _mm512_loadu_si512 (data + 128);
+  __m512i in4 = _mm512_loadu_si512 (data + 192);
+  in1 = _mm512_xor_si512 (in1, _mm512_castsi128_si512 (_mm_cvtsi32_si128 (crc)));
+  data += 256;
+  len -= 256;
+
+  /* Fold 4x 512 bits forward by 2048 bits.  */
+  for (; len >= 256; len -= 256)
+    {
+      in1 = fold512 (in1, shift2080_shift2016, _mm512_loadu_si512 (data));
+      in2 = fold512 (in2, shift2080_shift2016, _mm512_loadu_si512 (data + 64));
+      in3 = fold512 (in3, shift2080_shift2016,
+                     _mm512_loadu_si512 (data + 128));
+      in4 = fold512 (in4, shift2080_shift2016,
+                     _mm512_loadu_si512 (data + 192));
+      data += 256;
+    }
+
+  /* Fold into a single 512-bit vector, and consume the remaining full
+     512-bit blocks.  */
+  in2 = fold512 (in1, shift544_shift480, in2);
+  in3 = fold512 (in2, shift544_shift480, in3);
+  in4 = fold512 (in3, shift544_shift480, in4);
+  for (; len >= 64; len -= 64)
+    {
+      in4 = fold512 (in4, shift544_shift480, _mm512_loadu_si512 (data));
+      data += 64;
+    }
+
+  /* Fold the four 128-bit lanes onto the last one.  */
+  __m128i lane = _mm512_extracti32x4_epi32 (in4, 3);
+  lane = fold128 (_mm512_extracti32x4_epi32 (in4, 0), shift416_shift352, lane);
+  lane = fold128 (_mm512_extracti32x4_epi32 (in4, 1), shift288_shift224, lane);
+  lane = fold128 (_mm512_extracti32x4_epi32 (in4, 2), shift160_shift96, lane);
+
+  /* The CRC of the whole input is the CRC, starting from zero, of the
+     remaining 128 bits followed by the remaining bytes.  */
+  char final_buf[16 + 64];
+  _mm_storeu_si128 ((__m128i_u *) final_buf, lane);
+  memcpy (final_buf + 16, data, len);
+  return crc32_update_no_xor_pclmul (0, final_buf, 16 + len);
+}
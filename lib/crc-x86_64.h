@@ -35,6 +35,13 @@ extern uint32_t
 crc32_update_no_xor_pclmul (uint32_t crc, const void *buf, size_t len)
   _GL_ATTRIBUTE_PURE;
 
+/* Like crc32_update_no_xor_pclmul, but folding 512-bit vectors.  Requires
+   the VPCLMULQDQ and AVX-512F extensions, as well as those of
+   crc32_update_no_xor_pclmul.  */
+extern uint32_t
+crc32_update_no_xor_vpclmul (uint32_t crc, const void *buf, size_t len)
+  _GL_ATTRIBUTE_PURE;
+
 #ifdef __cplusplus
 }
 #endif
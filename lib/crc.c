@@ -26,6 +26,9 @@
 #include "crc-x86_64.h"
 static bool pclmul_enabled = false;
 static bool pclmul_checked = false;
+# ifdef GL_CRC_X86_64_VPCLMUL
+static bool vpclmul_enabled = false;
+# endif
 #endif
 
 #include <string.h>
@@ -119,9 +122,18 @@ crc32_update_no_xor (uint32_t crc, const char *buf, size_t len)
     {
       pclmul_enabled = (cpu_supports ("pclmul")
                         && cpu_supports ("avx"));
+#  ifdef GL_CRC_X86_64_VPCLMUL
+      vpclmul_enabled = (pclmul_enabled
+                         && cpu_supports ("vpclmulqdq")
+                         && cpu_supports ("avx512f"));
+#  endif
       pclmul_checked = true;
     }
 
+#  ifdef GL_CRC_X86_64_VPCLMUL
+  if (vpclmul_enabled && len >= 1024)
+    return crc32_update_no_xor_vpclmul (crc, buf, len);
+#  endif
   if (pclmul_enabled && len >= 16)
     return crc32_update_no_xor_pclmul (crc, buf, len);
 # endif
@@ -201,9 +213,18 @@ crc32_update_no_xor (uint32_t crc, const char *buf, size_t len)
     {
       pclmul_enabled = (cpu_supports ("pclmul")
                         && cpu_supports ("avx"));
+#  ifdef GL_CRC_X86_64_VPCLMUL
+      vpclmul_enabled = (pclmul_enabled
+                         && cpu_supports ("vpclmulqdq")
+                         && cpu_supports ("avx512f"));
+#  endif
       pclmul_checked = true;
     }
 
+#  ifdef GL_CRC_X86_64_VPCLMUL
+  if (vpclmul_enabled && len >= 1024)
+    return crc32_update_no_xor_vpclmul (crc, buf, len);
+#  endif
   if (pclmul_enabled && len >= 16)
     return crc32_update_no_xor_pclmul (crc, buf, len);
 # endif
@@ -233,3 +254,77 @@ crc32 (const char *buf, size_t len)
 {
   return crc32_update (0L, buf, len);
 }
+
+/* The CRC-32 polynomial, in reflected bit order.  */
+#define CRC32_POLY 0xedb88320
+
+/* Return A * B modulo the CRC-32 polynomial, where A and B are
+   polynomials over GF(2) in reflected bit order, that is, the
+   coefficient of x^0 is in the most significant bit.  */
+static uint32_t
+multmodp (uint32_t a, uint32_t b)
+{
+  uint32_t m = (uint32_t) 1 << 31;
+  uint32_t p = 0;
+
+  for (;;)
+    {
+      if (a & m)
+        {
+          p ^= b;
+          if ((a & (m - 1)) == 0)
+            break;
+        }
+      m >>= 1;
+      b = b & 1 ? (b >> 1) ^ CRC32_POLY : b >> 1;
+    }
+
+  return p;
+}
+
+/* x2n_table[K] is x^(2^K) modulo the CRC-32 polynomial, in reflected bit
+   order.  x2n_table[0] is x, and each entry is the square of the previous
+   one.  */
+static const uint32_t x2n_table[32] = {
+  0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0xedb88320,
+  0xb1e6b092, 0xa06a2517, 0xed627dae, 0x88d14467, 0xd7bbfe6a, 0xec447f11,
+  0x8e7ea170, 0x6427800e, 0x4d47bae0, 0x09fe548f, 0x83852d0f, 0x30362f1a,
+  0x7b5a9cc3, 0x31fec169, 0x9fec022a, 0x6c8dedc4, 0x15d6874d, 0x5fde7a4e,
+  0xbad90e37, 0x2e4e5eef, 0x4eaba214, 0xa8a472c0, 0x429a969e, 0x148d302a,
+  0xc40ba6d0, 0xc4e22c3c
+};
+
+/* Return x^(8 * LEN) modulo the CRC-32 polynomial.  Since the powers of x
+   repeat with a period that divides 2^32 - 1, the index into x2n_table
+   may wrap around.  */
+static uint32_t
+x8nmodp (size_t len)
+{
+  uint32_t p = (uint32_t) 1 << 31;      /* x^0 == 1 */
+  unsigned int k = 3;
+
+  while (len)
+    {
+      if (len & 1)
+        p = multmodp (x2n_table[k & 31], p);
+      len >>= 1;
+      k++;
+    }
+
+  return p;
+}
+
+/*
+ * A CRC is the remainder of the message polynomial, multiplied by x^32,
+ * modulo the generator polynomial.  Appending LEN2 bytes to a message
+ * multiplies its polynomial by x^(8 * LEN2), so the CRC of the
+ * concatenation is CRC1 * x^(8 * LEN2) + CRC2 modulo the generator.
+ * The initial and final XOR operations of crc32 cancel out in this sum,
+ * which is why the same function works for crc32 and crc32_no_xor.
+ * This method is the one used by zlib's crc32_combine.
+ */
+uint32_t
+crc32_combine (uint32_t crc1, uint32_t crc2, size_t len2)
+{
+  return multmodp (x8nmodp (len2), crc1) ^ crc2;
+}
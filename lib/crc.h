@@ -19,7 +19,7 @@
 #ifndef CRC_H
 #define CRC_H 1
 
-/* This file uses _GL_ATTRIBUTE_PURE.  */
+/* This file uses _GL_ATTRIBUTE_CONST, _GL_ATTRIBUTE_PURE.  */
 #if !_GL_CONFIG_H_INCLUDED
  #error "Please include config.h first."
 #endif
@@ -57,6 +57,20 @@ extern uint32_t
 crc32_update_no_xor (uint32_t crc, const char *buf, size_t len)
   _GL_ATTRIBUTE_PURE;
 
+/* Given CRC1, the CRC-32 value of a block A, and CRC2, the CRC-32 value
+   of a block B that is LEN2 bytes long, return the CRC-32 value of the
+   concatenation of A and B.  This works for the modified-CRC-32 values
+   as well.  The time is proportional to the logarithm of LEN2.  */
+extern uint32_t crc32_combine (uint32_t crc1, uint32_t crc2, size_t len2)
+  _GL_ATTRIBUTE_CONST;
+
+/* Compute CRC-32 value of LEN bytes long BUF, using up to NTHREADS
+   threads, including the calling thread, and return it.  The result is
+   the same as that of crc32 (BUF, LEN).  Short buffers, and NTHREADS < 2,
+   are handled by the calling thread alone.  This function is provided by
+   the 'crc-parallel' module.  */
+extern uint32_t crc32_parallel (const char *buf, size_t len, int nthreads);
+
 
 #ifdef __cplusplus
 }
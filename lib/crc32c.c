@@ -0,0 +1,314 @@
+/* crc32c.c -- cyclic redundancy checks with the Castagnoli polynomial
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "crc32c.h"
+
+#include <string.h>
+
+#include "endian.h"
+
+#ifdef GL_CRC32C_X86_64
+# include <x86intrin.h>
+# include "cpu-supports.h"
+static bool sse42_enabled = false;
+static bool pclmul_enabled = false;
+static bool x86_64_checked = false;
+#endif
+
+#include "crc32c-sliceby8.h"
+
+/* Slice-by-8, as in crc.c.  */
+
+static uint32_t
+crc32c_update_no_xor_slice_by_8 (uint32_t crc, const char *buf)
+{
+  uint64_t local_buf;
+  memcpy (&local_buf, buf, 8);
+  local_buf = le64toh (local_buf) ^ crc;
+
+  uint32_t final_crc = crc32c_sliceby8_table[0][(local_buf >> 56) & 0xFF]
+                       ^ crc32c_sliceby8_table[1][(local_buf >> 48) & 0xFF]
+                       ^ crc32c_sliceby8_table[2][(local_buf >> 40) & 0xFF]
+                       ^ crc32c_sliceby8_table[3][(local_buf >> 32) & 0xFF]
+                       ^ crc32c_sliceby8_table[4][(local_buf >> 24) & 0xFF]
+                       ^ crc32c_sliceby8_table[5][(local_buf >> 16) & 0xFF]
+                       ^ crc32c_sliceby8_table[6][(local_buf >> 8) & 0xFF]
+                       ^ crc32c_sliceby8_table[7][local_buf & 0xFF];
+
+  return final_crc;
+}
+
+static uint32_t
+crc32c_update_no_xor_slice_by_n (uint32_t crc, const char *buf,
+                                 size_t num_bytes)
+{
+  uint64_t local_buf;
+  memcpy (&local_buf, buf, num_bytes);
+  local_buf = le64toh (local_buf) ^ crc;
+
+  if (num_bytes >= 4)
+    crc = 0;
+  else
+    crc = crc >> (num_bytes * 8);
+
+  for (size_t i = 0; i < num_bytes; i++)
+    {
+      size_t shift_amount = ((num_bytes - i - 1) * 8);
+      crc = crc ^ crc32c_sliceby8_table[i][(local_buf >> shift_amount) & 0xFF];
+    }
+
+  return crc;
+}
+
+#ifdef GL_CRC32C_X86_64
+
+/* Return the CRC (without initial and final XOR) of CRC followed by
+   CRC32C_LONG or CRC32C_SHORT zero bytes, depending on TABLE.  */
+static uint32_t
+crc32c_shift (const uint32_t table[][256], uint32_t crc)
+{
+  return (table[0][crc & 0xFF] ^ table[1][(crc >> 8) & 0xFF]
+          ^ table[2][(crc >> 16) & 0xFF] ^ table[3][crc >> 24]);
+}
+
+/* Process three interleaved streams of LEN bytes each, starting at BUF,
+   with the crc32 instruction, and return the CRC of the concatenation.
+   The crc32 instruction has a latency of 3 cycles but a throughput of 1
+   per cycle, so three independent streams keep it busy.  The CRCs of
+   the second and third stream are combined with the first through
+   TABLE, the lookup table for shifting over LEN zero bytes.  */
+#define CRC32C_STREAMS(len, table)                                      \
+  while (n >= 3 * (len))                                                \
+    {                                                                   \
+      uint64_t crc1 = 0;                                                \
+      uint64_t crc2 = 0;                                                \
+      const char *end = buf + (len);                                    \
+      do                                                                \
+        {                                                               \
+          uint64_t w0, w1, w2;                                          \
+          memcpy (&w0, buf, 8);                                         \
+          memcpy (&w1, buf + (len), 8);                                 \
+          memcpy (&w2, buf + 2 * (len), 8);                             \
+          crc0 = _mm_crc32_u64 (crc0, w0);                              \
+          crc1 = _mm_crc32_u64 (crc1, w1);                              \
+          crc2 = _mm_crc32_u64 (crc2, w2);                              \
+          buf += 8;                                                     \
+        }                                                               \
+      while (buf < end);                                                \
+      crc0 = crc32c_shift (table, crc0) ^ crc1;                         \
+      crc0 = crc32c_shift (table, crc0) ^ crc2;                         \
+      buf += 2 * (len);                                                 \
+      n -= 3 * (len);                                                   \
+    }
+
+# if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("sse4.2")))
+# endif
+static uint32_t
+crc32c_update_no_xor_sse42 (uint32_t crc, const char *buf, size_t len)
+{
+  uint64_t crc0 = crc;
+  size_t n = len;
+
+  /* Align BUF on an 8-byte boundary.  */
+  for (; n > 0 && (uintptr_t) buf % 8 != 0; n--)
+    crc0 = _mm_crc32_u8 (crc0, *buf++);
+
+  CRC32C_STREAMS (CRC32C_LONG, crc32c_long_shift_table);
+  CRC32C_STREAMS (CRC32C_SHORT, crc32c_short_shift_table);
+
+  for (; n >= 8; n -= 8)
+    {
+      uint64_t w;
+      memcpy (&w, buf, 8);
+      crc0 = _mm_crc32_u64 (crc0, w);
+      buf += 8;
+    }
+  for (; n > 0; n--)
+    crc0 = _mm_crc32_u8 (crc0, *buf++);
+
+  return crc0;
+}
+
+/* Fold X forward over 128 or 512 bits, depending on K, and add DATA.  */
+# if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("pclmul")))
+# endif
+static inline __m128i
+crc32c_fold (__m128i x, __m128i k, __m128i data)
+{
+  __m128i fold_high = _mm_clmulepi64_si128 (x, k, 0x11);
+  __m128i fold_low = _mm_clmulepi64_si128 (x, k, 0x00);
+  return _mm_xor_si128 (_mm_xor_si128 (data, fold_high), fold_low);
+}
+
+/* Process LEN ≥ 64 bytes at BUF by folding, like crc-x86_64-pclmul.c
+   does for CRC-32.  Instead of a Barrett reduction at the end, feed the
+   folded 128 bits and the remaining bytes to the crc32 instruction.  */
+# if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("pclmul,sse4.2")))
+# endif
+static uint32_t
+crc32c_update_no_xor_pclmul (uint32_t crc, const char *buf, size_t len)
+{
+  /* These constants are x^(T-1) mod P in reflected bit order, as in
+     crc-x86_64-pclmul.c, for T = 480, 544 and T = 96, 160.  */
+  __m128i shift480_shift544 = _mm_set_epi64x (0x9E4ADDF8, 0x740EEF02);
+  __m128i shift96_shift160 = _mm_set_epi64x (0x493C7D27, 0xF20C0DFE);
+
+  const __m128i_u *data = (const __m128i_u *) buf;
+  __m128i in1 = _mm_loadu_si128 (data);
+  __m128i in2 = _mm_loadu_si128 (data + 1);
+  __m128i in3 = _mm_loadu_si128 (data + 2);
+  __m128i in4 = _mm_loadu_si128 (data + 3);
+  in1 = _mm_xor_si128 (in1, _mm_cvtsi32_si128 (crc));
+  data += 4;
+  len -= 64;
+
+  for (; len >= 64; len -= 64)
+    {
+      in1 = crc32c_fold (in1, shift480_shift544, _mm_loadu_si128 (data));
+      in2 = crc32c_fold (in2, shift480_shift544, _mm_loadu_si128 (data + 1));
+      in3 = crc32c_fold (in3, shift480_shift544, _mm_loadu_si128 (data + 2));
+      in4 = crc32c_fold (in4, shift480_shift544, _mm_loadu_si128 (data + 3));
+      data += 4;
+    }
+
+  in2 = crc32c_fold (in1, shift96_shift160, in2);
+  in3 = crc32c_fold (in2, shift96_shift160, in3);
+  in4 = crc32c_fold (in3, shift96_shift160, in4);
+  for (; len >= 16; len -= 16)
+    in4 = crc32c_fold (in4, shift96_shift160, _mm_loadu_si128 (data++));
+
+  uint64_t crc0 = _mm_crc32_u64 (0, _mm_cvtsi128_si64 (in4));
+  crc0 = _mm_crc32_u64 (crc0, _mm_extract_epi64 (in4, 1));
+  return crc32c_update_no_xor_sse42 (crc0, (const char *) data, len);
+}
+
+#endif
+
+uint32_t
+crc32c_update_no_xor (uint32_t crc, const char *buf, size_t len)
+{
+#ifdef GL_CRC32C_X86_64
+  if (!x86_64_checked)
+    {
+      sse42_enabled = cpu_supports ("sse4.2");
+      pclmul_enabled = sse42_enabled && cpu_supports ("pclmul");
+      x86_64_checked = true;
+    }
+
+  if (pclmul_enabled && len >= 1024)
+    return crc32c_update_no_xor_pclmul (crc, buf, len);
+  if (sse42_enabled)
+    return crc32c_update_no_xor_sse42 (crc, buf, len);
+#endif
+
+  size_t slice_alignment = (len & (-8));
+
+  size_t n;
+  for (n = 0; n < slice_alignment; n += 8)
+    crc = crc32c_update_no_xor_slice_by_8 (crc, buf + n);
+
+  if (len > n)
+    crc = crc32c_update_no_xor_slice_by_n (crc, buf + n, len - n);
+
+  return crc;
+}
+
+uint32_t
+crc32c_no_xor (const char *buf, size_t len)
+{
+  return crc32c_update_no_xor (0L, buf, len);
+}
+
+uint32_t
+crc32c_update (uint32_t crc, const char *buf, size_t len)
+{
+  return crc32c_update_no_xor (crc ^ 0xffffffff, buf, len) ^ 0xffffffff;
+}
+
+uint32_t
+crc32c (const char *buf, size_t len)
+{
+  return crc32c_update (0L, buf, len);
+}
+
+/* The CRC-32C polynomial, in reflected bit order.  */
+#define CRC32C_POLY 0x82f63b78
+
+/* Return A * B modulo the CRC-32C polynomial, where A and B are
+   polynomials over GF(2) in reflected bit order.  See crc.c.  */
+static uint32_t
+multmodp (uint32_t a, uint32_t b)
+{
+  uint32_t m = (uint32_t) 1 << 31;
+  uint32_t p = 0;
+
+  for (;;)
+    {
+      if (a & m)
+        {
+          p ^= b;
+          if ((a & (m - 1)) == 0)
+            break;
+        }
+      m >>= 1;
+      b = b & 1 ? (b >> 1) ^ CRC32C_POLY : b >> 1;
+    }
+
+  return p;
+}
+
+/* x2n_table[K] is x^(2^K) modulo the CRC-32C polynomial, in reflected
+   bit order.  Unlike for CRC-32, x^(2^31) is already x again, so the
+   table has only 31 entries.  */
+static const uint32_t x2n_table[31] = {
+  0x40000000, 0x20000000, 0x08000000, 0x00800000, 0x00008000, 0x82f63b78,
+  0x6ea2d55c, 0x18b8ea18, 0x510ac59a, 0xb82be955, 0xb8fdb1e7, 0x88e56f72,
+  0x74c360a4, 0xe4172b16, 0x0d65762a, 0x35d73a62, 0x28461564, 0xbf455269,
+  0xe2ea32dc, 0xfe7740e6, 0xf946610b, 0x3c204f8f, 0x538586e3, 0x59726915,
+  0x734d5309, 0xbc1ac763, 0x7d0722cc, 0xd289cabe, 0xe94ca9bc, 0x05b74f3f,
+  0xa51e1f42
+};
+
+/* Return x^(8 * LEN) modulo the CRC-32C polynomial.  */
+static uint32_t
+x8nmodp (size_t len)
+{
+  uint32_t p = (uint32_t) 1 << 31;      /* x^0 == 1 */
+  unsigned int k = 3;
+
+  while (len)
+    {
+      if (len & 1)
+        p = multmodp (x2n_table[k % 31], p);
+      len >>= 1;
+      k++;
+    }
+
+  return p;
+}
+
+/* See crc32_combine in crc.c.  */
+uint32_t
+crc32c_combine (uint32_t crc1, uint32_t crc2, size_t len2)
+{
+  return multmodp (x8nmodp (len2), crc1) ^ crc2;
+}
@@ -0,0 +1,71 @@
+/* crc32c.h -- cyclic redundancy checks with the Castagnoli polynomial
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation, either version 3 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#ifndef CRC32C_H
+#define CRC32C_H 1
+
+/* This file uses _GL_ATTRIBUTE_CONST, _GL_ATTRIBUTE_PURE.  */
+#if !_GL_CONFIG_H_INCLUDED
+ #error "Please include config.h first."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* The functions in this file compute the CRC-32C, that is, the CRC with
+   the Castagnoli polynomial 0x1EDC6F41, as used by iSCSI (RFC 3720),
+   SCTP, ext4 and Btrfs.  They are analogous to the functions in "crc.h".  */
+
+/* Compute CRC-32C value of LEN bytes long BUF, and return it. */
+extern uint32_t crc32c (const char *buf, size_t len) _GL_ATTRIBUTE_PURE;
+
+/* Incrementally update CRC-32C value CRC using LEN bytes long BUF.  In
+   the first call, use 0 as the value for CRC.  Return the updated
+   CRC-32C value.  */
+extern uint32_t crc32c_update (uint32_t crc, const char *buf, size_t len)
+  _GL_ATTRIBUTE_PURE;
+
+/* Compute modified-CRC-32C value of LEN bytes long BUF, and return it.
+   The "modification" is to avoid the initial and final XOR operation.  */
+extern uint32_t crc32c_no_xor (const char *buf, size_t len)
+  _GL_ATTRIBUTE_PURE;
+
+/* Incrementally update modified-CRC-32C value CRC using LEN bytes long
+   BUF.  In the first call, use 0 as the value for CRC.  Return the
+   updated modified-CRC-32C value.  The "modification" is to avoid the
+   initial and final XOR operation.  */
+extern uint32_t
+crc32c_update_no_xor (uint32_t crc, const char *buf, size_t len)
+  _GL_ATTRIBUTE_PURE;
+
+/* Given CRC1, the CRC-32C value of a block A, and CRC2, the CRC-32C value
+   of a block B that is LEN2 bytes long, return the CRC-32C value of the
+   concatenation of A and B.  This works for the modified-CRC-32C values
+   as well.  The time is proportional to the logarithm of LEN2.  */
+extern uint32_t crc32c_combine (uint32_t crc1, uint32_t crc2, size_t len2)
+  _GL_ATTRIBUTE_CONST;
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CRC32C_H */
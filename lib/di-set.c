@@ -26,30 +26,69 @@
 #include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
-/* The hash package hashes "void *", but this package wants to hash
-   integers.  Use integers that are as large as possible, but no
-   larger than void *, so that they can be cast to void * and back
-   without losing information.  */
+/* Mapped inode numbers.  Use integers that are as large as possible,
+   but no larger than void *.  */
 typedef uintptr_t hashint;
 #define HASHINT_MAX ((hashint) -1)
 
 /* Integers represent inode numbers.  Integers in the range
-   1..(LARGE_INO_MIN-1) represent inode numbers directly.  (The hash
-   package does not work with null pointers, so inode 0 cannot be used
-   as a key.)  To find the representations of other inode numbers, map
-   them through INO_MAP.  */
+   1..(LARGE_INO_MIN-1) represent inode numbers directly.  (Inode 0
+   is not a valid inode number on most systems.)  To find the
+   representations of other inode numbers, map them through INO_MAP.  */
 #define LARGE_INO_MIN (HASHINT_MAX / 2)
 
 /* Set operations for device-inode pairs stored in a space-efficient
    manner.  Use a two-level hash table.  The top level hashes by
    device number, as there are typically a small number of devices.
-   The lower level hashes by mapped inode numbers.  In the typical
-   case where the inode number is positive and small, the inode number
-   maps to itself, masquerading as a void * value; otherwise, its
-   value is the result of hashing the inode value through INO_MAP.  */
+   The lower level holds the mapped inode numbers, in pages.  In the
+   typical case where the inode number is positive and small, the inode
+   number maps to itself; otherwise, its value is the result of hashing
+   the inode value through INO_MAP.
+
+   File systems tend to allocate inode numbers densely, so the lower
+   level is organized like a "Roaring bitmap": the mapped inode numbers
+   that have the same high-order bits share a page, which is a sorted
+   array of the low-order bits while it is sparse, and a bitmap with
+   one bit per inode number when it gets dense.  A dense range of
+   inode numbers thus costs little more than one bit per inode.  */
+
+/* The number of low-order bits of a mapped inode number that a page
+   holds.  */
+enum { INO_PAGE_BITS = 16 };
+#define INO_PAGE_SIZE ((hashint) 1 << INO_PAGE_BITS)
+
+/* A page with more members than this is a bitmap, which then takes
+   less memory than the array.  */
+enum { INO_PAGE_ARRAY_MAX = INO_PAGE_SIZE / 16 };
+
+/* The mapped inode numbers of a device that have the same high-order
+   bits.  */
+struct ino_page
+{
+  /* The mapped inode numbers shifted right by INO_PAGE_BITS.  */
+  hashint high;
+
+  /* The number of mapped inode numbers in this page.  */
+  unsigned int count;
+
+  /* While COUNT <= INO_PAGE_ARRAY_MAX, the number of elements that
+     ARRAY has room for.  */
+  unsigned int capacity;
+
+  union
+  {
+    /* While COUNT <= INO_PAGE_ARRAY_MAX, the low-order bits of the
+       mapped inode numbers, in increasing order.  */
+    uint16_t *array;
+    /* Otherwise, a bitmap of INO_PAGE_SIZE bits.  */
+    uint64_t *bitmap;
+  } u;
+};
 
-/* A pair that maps a device number to a set of inode numbers.  */
+/* A pair that maps a device number to a set of inode numbers, which
+   is a hash table of pages.  */
 struct di_ent
 {
   dev_t dev;
@@ -142,11 +181,118 @@ di_set_free (struct di_set *dis)
   free (dis);
 }
 
-/* Hash an encoded inode number I.  */
+/* Hash a page.  */
 static size_t
-di_ino_hash (void const *i, size_t table_size)
+ino_page_hash (void const *x, size_t table_size)
+{
+  struct ino_page const *p = x;
+  return p->high % table_size;
+}
+
+/* Return true if two pages are for the same high-order bits.  */
+static bool
+ino_page_compare (void const *x, void const *y)
+{
+  struct ino_page const *a = x;
+  struct ino_page const *b = y;
+  return a->high == b->high;
+}
+
+/* Free a page.  */
+static void
+ino_page_free (void *v)
+{
+  struct ino_page *page = v;
+  if (page->count <= INO_PAGE_ARRAY_MAX)
+    free (page->u.array);
+  else
+    free (page->u.bitmap);
+  free (page);
+}
+
+/* Return the position in the array of PAGE of the low-order bits LOW,
+   or of the first element greater than LOW.  */
+static unsigned int
+ino_page_search (struct ino_page const *page, uint16_t low)
+{
+  unsigned int lo = 0;
+  unsigned int hi = page->count;
+  while (lo < hi)
+    {
+      unsigned int mid = lo + (hi - lo) / 2;
+      if (page->u.array[mid] < low)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+  return lo;
+}
+
+/* Return true if PAGE contains the low-order bits LOW.  */
+static bool
+ino_page_lookup (struct ino_page const *page, uint16_t low)
 {
-  return (hashint) i % table_size;
+  if (page->count <= INO_PAGE_ARRAY_MAX)
+    {
+      unsigned int j = ino_page_search (page, low);
+      return j < page->count && page->u.array[j] == low;
+    }
+  else
+    return (page->u.bitmap[low / 64] >> (low % 64)) & 1;
+}
+
+/* Insert the low-order bits LOW into PAGE.  If they are already in PAGE,
+   return 0.  Otherwise, if insertion is successful, return 1.
+   Upon allocation failure return -1.  */
+static int
+ino_page_insert (struct ino_page *page, uint16_t low)
+{
+  if (page->count <= INO_PAGE_ARRAY_MAX)
+    {
+      unsigned int j = ino_page_search (page, low);
+      if (j < page->count && page->u.array[j] == low)
+        return 0;
+
+      if (page->count < INO_PAGE_ARRAY_MAX)
+        {
+          if (page->count == page->capacity)
+            {
+              unsigned int capacity = 2 * page->capacity;
+              if (capacity > INO_PAGE_ARRAY_MAX)
+                capacity = INO_PAGE_ARRAY_MAX;
+              uint16_t *array =
+                realloc (page->u.array, capacity * sizeof *array);
+              if (! array)
+                return -1;
+              page->u.array = array;
+              page->capacity = capacity;
+            }
+          memmove (page->u.array + j + 1, page->u.array + j,
+                   (page->count - j) * sizeof *page->u.array);
+          page->u.array[j] = low;
+          page->count++;
+          return 1;
+        }
+
+      /* The array is full.  Convert it to a bitmap.  */
+      uint64_t *bitmap = calloc (INO_PAGE_SIZE / 64, sizeof *bitmap);
+      if (! bitmap)
+        return -1;
+      for (unsigned int k = 0; k < page->count; k++)
+        {
+          uint16_t l = page->u.array[k];
+          bitmap[l / 64] |= (uint64_t) 1 << (l % 64);
+        }
+      free (page->u.array);
+      page->u.bitmap = bitmap;
+    }
+
+  uint64_t bit = (uint64_t) 1 << (low % 64);
+  if (page->u.bitmap[low / 64] & bit)
+    return 0;
+  page->u.bitmap[low / 64] |= bit;
+  page->count++;
+  return 1;
 }
 
 /* Using the DIS table, map a device to a hash table that represents
@@ -182,14 +328,15 @@ map_device (struct di_set *dis, dev_t dev)
     }
   else
     {
-      enum { INITIAL_INO_SET_SIZE = 1021 };
+      enum { INITIAL_INO_SET_SIZE = 11 };
 
       /* Prepare to allocate a new probe next time; this one is in use.  */
       dis->probe = NULL;
 
       /* DEV is new; allocate an inode set for it.  */
       probe->ino_set = hash_initialize (INITIAL_INO_SET_SIZE, NULL,
-                                        di_ino_hash, NULL, NULL);
+                                        ino_page_hash, ino_page_compare,
+                                        ino_page_free);
     }
 
   return probe->ino_set;
@@ -230,8 +377,30 @@ di_set_insert (struct di_set *dis, dev_t dev, ino_t ino)
   if (i == INO_MAP_INSERT_FAILURE)
     return -1;
 
-  /* Put I into the inode set.  */
-  return hash_insert_if_absent (ino_set, (void const *) i, NULL);
+  /* Find the page of I, creating it if needed.  */
+  struct ino_page probe;
+  probe.high = i >> INO_PAGE_BITS;
+  struct ino_page *page = hash_lookup (ino_set, &probe);
+  if (! page)
+    {
+      enum { INITIAL_INO_PAGE_CAPACITY = 4 };
+      page = malloc (sizeof *page);
+      if (! page)
+        return -1;
+      page->high = probe.high;
+      page->count = 0;
+      page->capacity = INITIAL_INO_PAGE_CAPACITY;
+      page->u.array = malloc (page->capacity * sizeof *page->u.array);
+      if (! page->u.array || hash_insert (ino_set, page) != page)
+        {
+          free (page->u.array);
+          free (page);
+          return -1;
+        }
+    }
+
+  /* Put I into the page.  */
+  return ino_page_insert (page, i % INO_PAGE_SIZE);
 }
 
 /* Look up the DEV,INO pair in the set DIS.
@@ -251,5 +420,8 @@ di_set_lookup (struct di_set *dis, dev_t dev, ino_t ino)
     return -1;
 
   /* Perform the look-up.  */
-  return !!hash_lookup (ino_set, (void const *) i);
+  struct ino_page probe;
+  probe.high = i >> INO_PAGE_BITS;
+  struct ino_page const *page = hash_lookup (ino_set, &probe);
+  return page && ino_page_lookup (page, i % INO_PAGE_SIZE);
 }
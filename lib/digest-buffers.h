@@ -0,0 +1,176 @@
+/* digest-buffers.h -- hash several independent messages in parallel
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* This file is included by sha256-buffers.c and md5-buffers.c.  It
+   distributes the messages over the lanes of a SIMD compression function
+   that processes one 64-byte block of each of LANES messages at a time.
+   Whenever a message is finished, the next pending message takes over its
+   lane, so that messages of different lengths keep all lanes busy.  */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* The maximum number of lanes.  */
+enum { DIGEST_LANES_MAX = 8 };
+
+/* The maximum number of 32-bit words in the chaining state.  */
+enum { DIGEST_STATE_WORDS_MAX = 8 };
+
+/* Description of a hash function with 64-byte blocks, 32-bit chaining
+   state words, and a 64-bit message length in the last block.  */
+struct digest_lanes
+{
+  /* Number of messages processed in parallel, ≤ DIGEST_LANES_MAX.  */
+  int lanes;
+  /* Number of words in the chaining state.  */
+  int state_words;
+  /* Number of state words that make up the digest.  */
+  int digest_words;
+  /* The initial chaining state.  */
+  uint32_t const *initial_state;
+  /* True if the message length and the digest are stored big-endian,
+     false if little-endian.  */
+  bool big_endian;
+  /* Process one 64-byte block of each lane.  STATE holds word I of the
+     chaining state of lane L at index I * LANES + L, and is aligned on
+     a 32-byte boundary.  */
+  void (*compress) (uint32_t *state, unsigned char const *const blocks[]);
+};
+
+struct digest_lane
+{
+  /* Index of the message in this lane, or SIZE_MAX if the lane is idle.  */
+  size_t msg;
+  /* The full blocks of the message that are still to be processed.  */
+  unsigned char const *data;
+  size_t full_blocks;
+  /* The padded last one or two blocks.  */
+  unsigned char const *tail;
+  int tail_blocks;
+  unsigned char tailbuf[128];
+};
+
+/* Put message MSG, consisting of the LEN bytes at BUFFER, into lane L.  */
+static void
+digest_lane_start (struct digest_lanes const *alg, struct digest_lane *lane,
+                   uint32_t *state, int l,
+                   size_t msg, char const *buffer, size_t len)
+{
+  size_t rest = len % 64;
+  int tail_len = rest < 56 ? 64 : 128;
+  uint64_t bits = (uint64_t) len << 3;
+
+  lane->msg = msg;
+  lane->data = (unsigned char const *) buffer;
+  lane->full_blocks = len / 64;
+
+  if (rest > 0)
+    memcpy (lane->tailbuf, buffer + (len - rest), rest);
+  lane->tailbuf[rest] = 0x80;
+  memset (lane->tailbuf + rest + 1, 0, tail_len - 8 - (rest + 1));
+  for (int i = 0; i < 8; i++)
+    lane->tailbuf[tail_len - 8 + i] =
+      alg->big_endian ? bits >> (56 - 8 * i) : bits >> (8 * i);
+  lane->tail = lane->tailbuf;
+  lane->tail_blocks = tail_len / 64;
+
+  for (int i = 0; i < alg->state_words; i++)
+    state[i * alg->lanes + l] = alg->initial_state[i];
+}
+
+/* Store the digest of the message in lane L at RESBLOCK.  */
+static void
+digest_lane_finish (struct digest_lanes const *alg, uint32_t const *state,
+                    int l, void *resblock)
+{
+  unsigned char *r = resblock;
+
+  for (int i = 0; i < alg->digest_words; i++)
+    {
+      uint32_t w = state[i * alg->lanes + l];
+      for (int j = 0; j < 4; j++)
+        r[4 * i + j] = alg->big_endian ? w >> (24 - 8 * j) : w >> (8 * j);
+    }
+}
+
+/* Compute the digests of the N messages BUFFERS[I] of LENS[I] bytes, and
+   store them at RESBLOCKS[I].  */
+static void
+digest_buffers (struct digest_lanes const *alg,
+                char const *const buffers[], size_t const lens[], size_t n,
+                void *const resblocks[])
+{
+  static unsigned char const zero_block[64];
+  alignas (32) uint32_t state[DIGEST_STATE_WORDS_MAX * DIGEST_LANES_MAX];
+  struct digest_lane lane[DIGEST_LANES_MAX];
+  unsigned char const *blocks[DIGEST_LANES_MAX];
+  int lanes = alg->lanes;
+  int active = 0;
+  size_t next = 0;
+
+  for (int l = 0; l < lanes; l++)
+    if (next < n)
+      {
+        digest_lane_start (alg, &lane[l], state, l,
+                           next, buffers[next], lens[next]);
+        next++;
+        active++;
+      }
+    else
+      lane[l].msg = SIZE_MAX;
+
+  while (active > 0)
+    {
+      for (int l = 0; l < lanes; l++)
+        blocks[l] = (lane[l].msg == SIZE_MAX ? zero_block
+                     : lane[l].full_blocks > 0 ? lane[l].data
+                     : lane[l].tail);
+
+      alg->compress (state, blocks);
+
+      for (int l = 0; l < lanes; l++)
+        {
+          struct digest_lane *ln = &lane[l];
+          if (ln->msg == SIZE_MAX)
+            continue;
+          if (ln->full_blocks > 0)
+            {
+              ln->data += 64;
+              ln->full_blocks--;
+            }
+          else
+            {
+              ln->tail += 64;
+              if (--ln->tail_blocks == 0)
+                {
+                  digest_lane_finish (alg, state, l, resblocks[ln->msg]);
+                  if (next < n)
+                    {
+                      digest_lane_start (alg, ln, state, l,
+                                         next, buffers[next], lens[next]);
+                      next++;
+                    }
+                  else
+                    {
+                      ln->msg = SIZE_MAX;
+                      active--;
+                    }
+                }
+            }
+        }
+    }
+}
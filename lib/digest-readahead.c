@@ -0,0 +1,225 @@
+/* Overlap reading a file with computing its message digest.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "digest-readahead.h"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include "alignalloc.h"
+#include "glthread/cond.h"
+#include "glthread/lock.h"
+#include "glthread/thread.h"
+
+#if USE_UNLOCKED_IO
+# include "unlocked-io.h"
+#endif
+
+/* Number of buffers in the ring.  */
+#define NBUFFERS 4
+
+/* Size of each buffer.  Large reads keep the number of system calls and
+   of thread hand-offs low.  */
+#define BUFSIZE (256 * 1024)
+
+/* Alignment of the buffers, suitable for direct I/O and page flipping.  */
+#define BUFALIGN 4096
+
+/* Regular files shorter than this are read by the caller, because the
+   cost of starting a thread outweighs the gain.  */
+#define MIN_FILE_SIZE (4 * BUFSIZE)
+
+struct readahead
+{
+  FILE *stream;
+  char *buffer[NBUFFERS];
+  size_t length[NBUFFERS];
+
+  /* The fields below are protected by LOCK.  */
+  gl_lock_t lock;
+  /* Signaled when a buffer has been filled, or a buffer has been drained,
+     or the reader is cancelled.  */
+  gl_cond_t cond;
+  /* Number of buffers filled by the reader so far.  */
+  size_t filled;
+  /* Number of buffers processed by the consumer so far.  */
+  size_t drained;
+  /* True once the reader has filled its last buffer.  */
+  bool done;
+  /* True if the reader encountered a read error.  */
+  bool error;
+  /* True if the consumer no longer wants data.  */
+  bool cancelled;
+};
+
+/* The reader thread.  */
+static void *
+reader (void *arg)
+{
+  struct readahead *ra = arg;
+  FILE *stream = ra->stream;
+
+  for (size_t i = 0; ; i++)
+    {
+      gl_lock_lock (ra->lock);
+      while (i - ra->drained >= NBUFFERS && !ra->cancelled)
+        gl_cond_wait (ra->cond, ra->lock);
+      bool cancelled = ra->cancelled;
+      gl_lock_unlock (ra->lock);
+      if (cancelled)
+        break;
+
+      char *buffer = ra->buffer[i % NBUFFERS];
+      size_t sum = 0;
+      bool done = false;
+      bool error = false;
+
+      /* Read block.  Take care for partial reads.  */
+      while (sum < BUFSIZE)
+        {
+          /* Avoid a subsequent fread() after EOF, as EOF may not be
+             sticky.  For details of such systems, see:
+             https://sourceware.org/PR1190  */
+          if (feof (stream))
+            {
+              done = true;
+              break;
+            }
+
+          size_t n = fread (buffer + sum, 1, BUFSIZE - sum, stream);
+          sum += n;
+
+          if (n == 0)
+            {
+              /* Check for the error flag IFF N == 0, so that we don't
+                 exit the loop after a partial read due to e.g., EAGAIN
+                 or EWOULDBLOCK.  */
+              error = ferror (stream);
+              done = true;
+              break;
+            }
+        }
+
+      gl_lock_lock (ra->lock);
+      ra->length[i % NBUFFERS] = sum;
+      ra->filled = i + 1;
+      ra->done = done;
+      ra->error = error;
+      gl_cond_broadcast (ra->cond);
+      gl_lock_unlock (ra->lock);
+
+      if (done)
+        break;
+    }
+
+  return NULL;
+}
+
+int
+digest_readahead (FILE *stream,
+                  bool (*process) (void const *buffer, size_t len, void *arg),
+                  void *arg)
+{
+  int fd = fileno (stream);
+  struct stat st;
+  if (0 <= fd && fstat (fd, &st) == 0 && S_ISREG (st.st_mode))
+    {
+      if (st.st_size < MIN_FILE_SIZE)
+        return -1;
+#if HAVE_POSIX_FADVISE
+      posix_fadvise (fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    }
+
+  struct readahead ra;
+  ra.stream = stream;
+  for (int i = 0; i < NBUFFERS; i++)
+    {
+      ra.buffer[i] = alignalloc (BUFALIGN, BUFSIZE);
+      if (!ra.buffer[i])
+        {
+          while (--i >= 0)
+            alignfree (ra.buffer[i]);
+          return -1;
+        }
+    }
+  ra.filled = 0;
+  ra.drained = 0;
+  ra.done = false;
+  ra.error = false;
+  ra.cancelled = false;
+
+  int result = -1;
+  if (glthread_lock_init (&ra.lock) == 0)
+    {
+      if (glthread_cond_init (&ra.cond) == 0)
+        {
+          gl_thread_t thread;
+          if (glthread_create (&thread, reader, &ra) == 0)
+            {
+              result = 0;
+
+              for (size_t i = 0; ; i++)
+                {
+                  gl_lock_lock (ra.lock);
+                  while (ra.filled <= i)
+                    gl_cond_wait (ra.cond, ra.lock);
+                  bool last = ra.done && ra.filled == i + 1;
+                  bool error = last && ra.error;
+                  gl_lock_unlock (ra.lock);
+
+                  if (error)
+                    {
+                      result = 1;
+                      break;
+                    }
+
+                  size_t len = ra.length[i % NBUFFERS];
+                  if (len > 0 && !process (ra.buffer[i % NBUFFERS], len, arg))
+                    {
+                      result = 1;
+                      break;
+                    }
+
+                  if (last)
+                    break;
+
+                  gl_lock_lock (ra.lock);
+                  ra.drained = i + 1;
+                  gl_cond_broadcast (ra.cond);
+                  gl_lock_unlock (ra.lock);
+                }
+
+              /* Stop the reader, in case we are returning early.  */
+              gl_lock_lock (ra.lock);
+              ra.cancelled = true;
+              gl_cond_broadcast (ra.cond);
+              gl_lock_unlock (ra.lock);
+              gl_thread_join (thread, NULL);
+            }
+          gl_cond_destroy (ra.cond);
+        }
+      gl_lock_destroy (ra.lock);
+    }
+
+  for (int i = 0; i < NBUFFERS; i++)
+    alignfree (ra.buffer[i]);
+  return result;
+}
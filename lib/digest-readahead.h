@@ -0,0 +1,53 @@
+/* Overlap reading a file with computing its message digest.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#ifndef DIGEST_READAHEAD_H
+# define DIGEST_READAHEAD_H 1
+
+# include <stddef.h>
+# include <stdio.h>
+
+# ifdef __cplusplus
+extern "C" {
+# endif
+
+/* Read STREAM from its current position to its end in a separate thread,
+   into a ring of large buffers, and pass the contents, in order, to
+   PROCESS (BUFFER, LEN, ARG) in the calling thread.  While PROCESS works
+   on one buffer, the next ones are being read.  On regular files, the
+   kernel is told that the access is sequential.
+
+   PROCESS returns true if successful, false upon failure.
+
+   Return 0 if the whole contents of STREAM was passed to PROCESS.
+   Return 1 upon read error or if PROCESS failed.
+   Return -1 if STREAM was not touched, and the caller should read it
+   itself.  This happens for short regular files, for which the thread is
+   not worth it, if the program is not linked with $(LIBMULTITHREAD), and
+   when resources are short.
+
+   The case that the last operation on STREAM was an 'ungetc' is not
+   supported.  */
+extern int digest_readahead (FILE *stream,
+                             bool (*process) (void const *buffer, size_t len,
+                                              void *arg),
+                             void *arg);
+
+# ifdef __cplusplus
+}
+# endif
+
+#endif /* DIGEST_READAHEAD_H */
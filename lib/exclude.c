@@ -37,7 +37,7 @@
 #include "filename.h"
 #include <fnmatch.h>
 #include "hash.h"
-#include "hashcode-string1.h"
+#include "hashcode-seeded.h"
 #if GNULIB_MCEL_PREFER
 # include "mcel.h"
 #else
@@ -201,7 +201,7 @@ new_exclude (void)
 static size_t
 string_hasher (void const *data, size_t n_buckets)
 {
-  return hash_string (data, n_buckets);
+  return hash_string_hasher (data, n_buckets);
 }
 
 /* Ditto, for case-insensitive hashes */
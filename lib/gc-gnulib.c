@@ -71,6 +71,14 @@
 #endif
 #if GNULIB_GC_RIJNDAEL
 # include "rijndael-api-fst.h"
+# include "rijndael-alg-fst.h"
+# ifdef GL_RIJNDAEL_X86_64
+#  include "cpu-supports.h"
+#  include "rijndael-x86_64.h"
+static bool aesni_enabled = false;
+static bool pclmul_enabled = false;
+static bool aesni_checked = false;
+# endif
 #endif
 
 Gc_rc
@@ -164,9 +172,241 @@ typedef struct _gc_cipher_ctx
   rijndaelKeyInstance aesEncKey;
   rijndaelKeyInstance aesDecKey;
   rijndaelCipherInstance aesContext;
+  /* The counter block, in GC_CTR and GC_GCM modes.  */
+  char aesCtr[16];
+  /* The key stream of the last counter block, of which the first
+     aesStreamPos bytes have been used.  */
+  char aesStream[16];
+  size_t aesStreamPos;
+  /* The hash key H of GHASH, and powers of it.  */
+  char gcmH[16];
+  char gcmHtable[8 * 16];
+  /* The encrypted first counter block, that masks the tag.  */
+  char gcmEJ0[16];
+  /* The GHASH value, and the partial block not yet hashed into it.  */
+  char gcmX[16];
+  char gcmBuf[16];
+  size_t gcmBufLen;
+  uint64_t gcmAadLen;
+  uint64_t gcmTextLen;
+  enum { GCM_AAD, GCM_TEXT, GCM_DONE } gcmState;
 #endif
 } _gc_cipher_ctx;
 
+#if GNULIB_GC_RIJNDAEL
+
+/* The CTR and GCM modes of AES are implemented here, on top of
+   rijndaelEncrypt, and of the AES-NI and PCLMUL functions of
+   rijndael-x86_64.h if available.  */
+
+static void
+aes_check_cpu (void)
+{
+# ifdef GL_RIJNDAEL_X86_64
+  if (!aesni_checked)
+    {
+      aesni_enabled = cpu_supports ("aes") && cpu_supports ("ssse3");
+      pclmul_enabled = cpu_supports ("pclmul") && cpu_supports ("ssse3");
+      aesni_checked = true;
+    }
+# endif
+}
+
+static void
+aes_encrypt_block (_gc_cipher_ctx *ctx, char const in[16], char out[16])
+{
+# ifdef GL_RIJNDAEL_X86_64
+  if (aesni_enabled)
+    {
+      rijndael_ecb_encrypt_aesni (ctx->aesEncKey.rk, ctx->aesEncKey.Nr,
+                                  in, out, 1);
+      return;
+    }
+# endif
+  rijndaelEncrypt (ctx->aesEncKey.rk, ctx->aesEncKey.Nr, in, out);
+}
+
+/* Increment the last N bytes of the counter block CTR, as a big-endian
+   number.  */
+static void
+aes_ctr_increment (char ctr[16], int n)
+{
+  for (int i = 15; 16 - n <= i; i--)
+    if (++ctr[i] != 0)
+      break;
+}
+
+/* Multiply X by H in GF(2^128), as in NIST SP 800-38D, Algorithm 1.  */
+static void
+gcm_gf_mul (char x[16], char const h[16])
+{
+  unsigned char z[16] = { 0 };
+  unsigned char v[16];
+  memcpy (v, h, 16);
+
+  for (int i = 0; i < 128; i++)
+    {
+      if ((x[i >> 3] >> (7 - (i & 7))) & 1)
+        for (int j = 0; j < 16; j++)
+          z[j] ^= v[j];
+
+      bool lsb = v[15] & 1;
+      for (int j = 15; 0 < j; j--)
+        v[j] = (v[j] >> 1) | (v[j - 1] << 7);
+      v[0] >>= 1;
+      if (lsb)
+        v[0] ^= 0xe1;
+    }
+
+  memcpy (x, z, 16);
+}
+
+/* Hash the NBLOCKS blocks of 16 bytes at DATA into the GHASH value.  */
+static void
+gcm_ghash (_gc_cipher_ctx *ctx, char const *data, size_t nblocks)
+{
+# ifdef GL_RIJNDAEL_X86_64
+  if (pclmul_enabled)
+    {
+      rijndael_ghash_pclmul (ctx->gcmHtable, ctx->gcmX, data, nblocks);
+      return;
+    }
+# endif
+  for (; nblocks > 0; nblocks--, data += 16)
+    {
+      for (int i = 0; i < 16; i++)
+        ctx->gcmX[i] ^= data[i];
+      gcm_gf_mul (ctx->gcmX, ctx->gcmH);
+    }
+}
+
+/* Hash the LEN bytes at DATA into the GHASH value, buffering a partial
+   last block.  */
+static void
+gcm_update (_gc_cipher_ctx *ctx, char const *data, size_t len)
+{
+  if (ctx->gcmBufLen > 0)
+    {
+      size_t n = 16 - ctx->gcmBufLen < len ? 16 - ctx->gcmBufLen : len;
+      memcpy (ctx->gcmBuf + ctx->gcmBufLen, data, n);
+      ctx->gcmBufLen += n;
+      data += n;
+      len -= n;
+      if (ctx->gcmBufLen < 16)
+        return;
+      gcm_ghash (ctx, ctx->gcmBuf, 1);
+      ctx->gcmBufLen = 0;
+    }
+
+  gcm_ghash (ctx, data, len / 16);
+  memcpy (ctx->gcmBuf, data + (len & ~(size_t) 15), len % 16);
+  ctx->gcmBufLen = len % 16;
+}
+
+/* Hash the partial block, padded with zeros.  */
+static void
+gcm_flush (_gc_cipher_ctx *ctx)
+{
+  if (ctx->gcmBufLen > 0)
+    {
+      memset (ctx->gcmBuf + ctx->gcmBufLen, 0, 16 - ctx->gcmBufLen);
+      gcm_ghash (ctx, ctx->gcmBuf, 1);
+      ctx->gcmBufLen = 0;
+    }
+}
+
+/* Encrypt or decrypt, in CTR or GCM mode, the NBLOCKS blocks of 16
+   bytes at DATA, when no key stream is left over.  */
+static void
+aes_ctr_blocks (_gc_cipher_ctx *ctx, bool decrypt, char *data,
+                size_t nblocks)
+{
+  uint32_t const *rk = ctx->aesEncKey.rk;
+  int Nr = ctx->aesEncKey.Nr;
+
+# ifdef GL_RIJNDAEL_X86_64
+  if (aesni_enabled && ctx->mode == GC_CTR)
+    {
+      rijndael_ctr_aesni (rk, Nr, ctx->aesCtr, data, data, nblocks);
+      return;
+    }
+  if (aesni_enabled && pclmul_enabled)
+    {
+      (decrypt ? rijndael_gcm_decrypt_aesni : rijndael_gcm_encrypt_aesni)
+        (rk, Nr, ctx->gcmHtable, ctx->aesCtr, ctx->gcmX,
+         data, data, nblocks);
+      return;
+    }
+# endif
+
+  int n = ctx->mode == GC_GCM ? 4 : 16;
+  for (; nblocks > 0; nblocks--, data += 16)
+    {
+      char block[16];
+      if (ctx->mode == GC_GCM && decrypt)
+        gcm_ghash (ctx, data, 1);
+      aes_encrypt_block (ctx, ctx->aesCtr, block);
+      aes_ctr_increment (ctx->aesCtr, n);
+      for (int i = 0; i < 16; i++)
+        data[i] ^= block[i];
+      if (ctx->mode == GC_GCM && !decrypt)
+        gcm_ghash (ctx, data, 1);
+    }
+}
+
+/* Encrypt or decrypt, in CTR or GCM mode, the LEN bytes at DATA.  */
+static Gc_rc
+aes_ctr_crypt (_gc_cipher_ctx *ctx, bool decrypt, char *data, size_t len)
+{
+  if (ctx->mode == GC_GCM)
+    {
+      if (ctx->gcmState == GCM_DONE)
+        return GC_INVALID_CIPHER;
+      if (ctx->gcmState == GCM_AAD)
+        {
+          gcm_flush (ctx);
+          ctx->gcmState = GCM_TEXT;
+        }
+      /* GCM limits the plaintext to 2^39 - 256 bits.  */
+      if ((((uint64_t) 1 << 36) - 32) - ctx->gcmTextLen < len)
+        return GC_INVALID_CIPHER;
+      ctx->gcmTextLen += len;
+    }
+
+  /* Use the rest of the key stream of the previous call.  In GC_GCM
+     mode, the partial block of ciphertext is buffered in gcmBuf.  */
+  size_t n = 16 - ctx->aesStreamPos < len ? 16 - ctx->aesStreamPos : len;
+  if (ctx->mode == GC_GCM && decrypt)
+    gcm_update (ctx, data, n);
+  for (size_t i = 0; i < n; i++)
+    data[i] ^= ctx->aesStream[ctx->aesStreamPos++];
+  if (ctx->mode == GC_GCM && !decrypt)
+    gcm_update (ctx, data, n);
+  data += n;
+  len -= n;
+
+  aes_ctr_blocks (ctx, decrypt, data, len / 16);
+  data += len & ~(size_t) 15;
+  len %= 16;
+
+  if (len > 0)
+    {
+      aes_encrypt_block (ctx, ctx->aesCtr, ctx->aesStream);
+      aes_ctr_increment (ctx->aesCtr, ctx->mode == GC_GCM ? 4 : 16);
+      if (ctx->mode == GC_GCM && decrypt)
+        gcm_update (ctx, data, len);
+      for (size_t i = 0; i < len; i++)
+        data[i] ^= ctx->aesStream[i];
+      if (ctx->mode == GC_GCM && !decrypt)
+        gcm_update (ctx, data, len);
+      ctx->aesStreamPos = len;
+    }
+
+  return GC_OK;
+}
+
+#endif
+
 Gc_rc
 gc_cipher_open (Gc_cipher alg, Gc_cipher_mode mode,
                 gc_cipher_handle * outhandle)
@@ -230,6 +470,9 @@ gc_cipher_open (Gc_cipher alg, Gc_cipher_mode mode,
         {
         case GC_ECB:
         case GC_CBC:
+        case GC_CTR:
+        case GC_GCM:
+          ctx->aesStreamPos = 16;
           break;
 
         default:
@@ -309,6 +552,17 @@ gc_cipher_setkey (gc_cipher_handle restrict handle, size_t keylen,
           if (rc < 0)
             return GC_INVALID_CIPHER;
         }
+
+        aes_check_cpu ();
+        if (ctx->mode == GC_GCM)
+          {
+            static char const zero[16];
+            aes_encrypt_block (ctx, zero, ctx->gcmH);
+# ifdef GL_RIJNDAEL_X86_64
+            if (pclmul_enabled)
+              rijndael_ghash_init_pclmul (ctx->gcmHtable, ctx->gcmH);
+# endif
+          }
       }
       break;
 #endif
@@ -360,6 +614,47 @@ gc_cipher_setiv (gc_cipher_handle restrict handle, size_t ivlen,
           }
           break;
 
+        case GC_CTR:
+          if (ivlen != 16)
+            return GC_INVALID_CIPHER;
+          memcpy (ctx->aesCtr, iv, 16);
+          ctx->aesStreamPos = 16;
+          break;
+
+        case GC_GCM:
+          {
+            if (ivlen == 0)
+              return GC_INVALID_CIPHER;
+
+            memset (ctx->gcmX, 0, 16);
+            ctx->gcmBufLen = 0;
+            if (ivlen == 12)
+              {
+                memcpy (ctx->aesCtr, iv, 12);
+                memcpy (ctx->aesCtr + 12, "\0\0\0\1", 4);
+              }
+            else
+              {
+                /* J0 = GHASH (IV || 0-padding || [len (IV)]_128).  */
+                char lenblock[16] = { 0 };
+                uint64_t bits = (uint64_t) ivlen * 8;
+                for (int i = 0; i < 8; i++)
+                  lenblock[15 - i] = bits >> (8 * i);
+                gcm_update (ctx, iv, ivlen);
+                gcm_flush (ctx);
+                gcm_ghash (ctx, lenblock, 1);
+                memcpy (ctx->aesCtr, ctx->gcmX, 16);
+                memset (ctx->gcmX, 0, 16);
+              }
+            aes_encrypt_block (ctx, ctx->aesCtr, ctx->gcmEJ0);
+            aes_ctr_increment (ctx->aesCtr, 4);
+            ctx->aesStreamPos = 16;
+            ctx->gcmAadLen = 0;
+            ctx->gcmTextLen = 0;
+            ctx->gcmState = GCM_AAD;
+          }
+          break;
+
         default:
           return GC_INVALID_CIPHER;
         }
@@ -425,13 +720,21 @@ gc_cipher_encrypt_inline (gc_cipher_handle restrict handle,
     case GC_AES128:
     case GC_AES192:
     case GC_AES256:
-      {
-        int nblocks =
-          rijndaelBlockEncrypt (&ctx->aesContext, &ctx->aesEncKey,
-                                data, 8 * len, data);
-        if (nblocks < 0)
-          return GC_INVALID_CIPHER;
-      }
+      switch (ctx->mode)
+        {
+        case GC_CTR:
+        case GC_GCM:
+          return aes_ctr_crypt (ctx, false, data, len);
+
+        default:
+          {
+            int nblocks =
+              rijndaelBlockEncrypt (&ctx->aesContext, &ctx->aesEncKey,
+                                    data, 8 * len, data);
+            if (nblocks < 0)
+              return GC_INVALID_CIPHER;
+          }
+        }
       break;
 #endif
 
@@ -496,13 +799,91 @@ gc_cipher_decrypt_inline (gc_cipher_handle restrict handle, size_t len,
     case GC_AES128:
     case GC_AES192:
     case GC_AES256:
-      {
-        int nblocks =
-          rijndaelBlockDecrypt (&ctx->aesContext, &ctx->aesDecKey,
-                                data, 8 * len, data);
-        if (nblocks < 0)
-          return GC_INVALID_CIPHER;
-      }
+      switch (ctx->mode)
+        {
+        case GC_CTR:
+        case GC_GCM:
+          return aes_ctr_crypt (ctx, true, data, len);
+
+        default:
+          {
+            int nblocks =
+              rijndaelBlockDecrypt (&ctx->aesContext, &ctx->aesDecKey,
+                                    data, 8 * len, data);
+            if (nblocks < 0)
+              return GC_INVALID_CIPHER;
+          }
+        }
+      break;
+#endif
+
+    default:
+      return GC_INVALID_CIPHER;
+    }
+
+  return GC_OK;
+}
+
+Gc_rc
+gc_cipher_authenticate (gc_cipher_handle restrict handle, size_t len,
+                        char const *restrict aad)
+{
+  _gc_cipher_ctx *ctx = handle;
+
+  switch (ctx->alg)
+    {
+#if GNULIB_GC_RIJNDAEL
+    case GC_AES128:
+    case GC_AES192:
+    case GC_AES256:
+      if (ctx->mode != GC_GCM || ctx->gcmState != GCM_AAD
+          || (((uint64_t) 1 << 61) - 1) - ctx->gcmAadLen < len)
+        return GC_INVALID_CIPHER;
+      gcm_update (ctx, aad, len);
+      ctx->gcmAadLen += len;
+      break;
+#endif
+
+    default:
+      return GC_INVALID_CIPHER;
+    }
+
+  return GC_OK;
+}
+
+Gc_rc
+gc_cipher_gettag (gc_cipher_handle restrict handle, size_t len,
+                  char *restrict tag)
+{
+  _gc_cipher_ctx *ctx = handle;
+
+  switch (ctx->alg)
+    {
+#if GNULIB_GC_RIJNDAEL
+    case GC_AES128:
+    case GC_AES192:
+    case GC_AES256:
+      if (ctx->mode != GC_GCM || 16 < len)
+        return GC_INVALID_CIPHER;
+      if (ctx->gcmState != GCM_DONE)
+        {
+          /* Hash [len (A)]_64 || [len (C)]_64, and store the tag
+             into gcmX.  */
+          char lenblock[16];
+          uint64_t aadbits = ctx->gcmAadLen * 8;
+          uint64_t textbits = ctx->gcmTextLen * 8;
+          for (int i = 0; i < 8; i++)
+            {
+              lenblock[7 - i] = aadbits >> (8 * i);
+              lenblock[15 - i] = textbits >> (8 * i);
+            }
+          gcm_flush (ctx);
+          gcm_ghash (ctx, lenblock, 1);
+          for (int i = 0; i < 16; i++)
+            ctx->gcmX[i] ^= ctx->gcmEJ0[i];
+          ctx->gcmState = GCM_DONE;
+        }
+      memcpy (tag, ctx->gcmX, len);
       break;
 #endif
 
@@ -176,6 +176,16 @@ gc_cipher_open (Gc_cipher alg, Gc_cipher_mode mode,
       gcrymode = GCRY_CIPHER_MODE_STREAM;
       break;
 
+    case GC_CTR:
+      gcrymode = GCRY_CIPHER_MODE_CTR;
+      break;
+
+#if GCRYPT_VERSION_NUMBER >= 0x010600
+    case GC_GCM:
+      gcrymode = GCRY_CIPHER_MODE_GCM;
+      break;
+#endif
+
     default:
       return GC_INVALID_CIPHER;
     }
@@ -203,6 +213,16 @@ Gc_rc
 gc_cipher_setiv (gc_cipher_handle restrict handle,
                  size_t ivlen, char const *restrict iv)
 {
+  /* In CTR mode, libgcrypt takes the initial counter block through
+     gcry_cipher_setctr.  Setting it in the other modes is harmless.  */
+  if (ivlen == 16)
+    {
+      gcry_error_t err = gcry_cipher_setctr ((gcry_cipher_hd_t) handle,
+                                             iv, ivlen);
+      if (gcry_err_code (err))
+        return GC_INVALID_CIPHER;
+    }
+
   gcry_error_t err = gcry_cipher_setiv ((gcry_cipher_hd_t) handle, iv, ivlen);
   if (gcry_err_code (err))
     return GC_INVALID_CIPHER;
@@ -232,6 +252,34 @@ gc_cipher_decrypt_inline (gc_cipher_handle restrict handle,
   return GC_OK;
 }
 
+Gc_rc
+gc_cipher_authenticate (gc_cipher_handle restrict handle,
+                        size_t len, char const *restrict aad)
+{
+#if GCRYPT_VERSION_NUMBER >= 0x010600
+  if (gcry_cipher_authenticate ((gcry_cipher_hd_t) handle, aad, len) != 0)
+    return GC_INVALID_CIPHER;
+
+  return GC_OK;
+#else
+  return GC_INVALID_CIPHER;
+#endif
+}
+
+Gc_rc
+gc_cipher_gettag (gc_cipher_handle restrict handle,
+                  size_t len, char *restrict tag)
+{
+#if GCRYPT_VERSION_NUMBER >= 0x010600
+  if (gcry_cipher_gettag ((gcry_cipher_hd_t) handle, tag, len) != 0)
+    return GC_INVALID_CIPHER;
+
+  return GC_OK;
+#else
+  return GC_INVALID_CIPHER;
+#endif
+}
+
 Gc_rc
 gc_cipher_close (gc_cipher_handle handle)
 {
@@ -23,44 +23,156 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "glthread/thread.h"
+#include "nproc.h"
+#if GNULIB_HMAC_SHA1 || GNULIB_HMAC_SHA256 || GNULIB_HMAC_SHA512
+# include "hmac.h"
+#endif
+
 typedef Gc_rc (*gc_prf_func) (void const *restrict key, size_t keylen,
                               void const *restrict in, size_t inlen,
                               char *restrict resbuf);
 
+/* The PRF, keyed with the password.  When the HMAC module of HASH is
+   present, the inner and outer hash states are computed once, by
+   prf_init; otherwise each call to FUNC hashes the password again.  */
+struct prf
+{
+  Gc_hash hash;
+  gc_prf_func func;
+  size_t hLen;
+  char const *P;
+  size_t Plen;
+  union
+  {
+#if GNULIB_HMAC_SHA1
+    struct hmac_sha1_ctx sha1;
+#endif
+#if GNULIB_HMAC_SHA256
+    struct hmac_sha256_ctx sha256;
+#endif
+#if GNULIB_HMAC_SHA512
+    struct hmac_sha512_ctx sha512;
+#endif
+    char dummy;
+  } keyed;
+};
+
+static void
+prf_init (struct prf *prf)
+{
+  switch (prf->hash)
+    {
+#if GNULIB_HMAC_SHA1
+    case GC_SHA1:
+      hmac_sha1_init_ctx (&prf->keyed.sha1, prf->P, prf->Plen);
+      break;
+#endif
+
+#if GNULIB_HMAC_SHA256
+    case GC_SHA256:
+      hmac_sha256_init_ctx (&prf->keyed.sha256, prf->P, prf->Plen);
+      break;
+#endif
+
+#if GNULIB_HMAC_SHA512
+    case GC_SHA512:
+      hmac_sha512_init_ctx (&prf->keyed.sha512, prf->P, prf->Plen);
+      break;
+#endif
+
+    default:
+      break;
+    }
+}
+
 static Gc_rc
-gc_pbkdf2_prf (gc_prf_func prf, size_t hLen,
-               char const *restrict P, size_t Plen,
-               char const *restrict S, size_t Slen,
-               unsigned int c,
-               char *restrict DK, size_t dkLen)
+prf_compute (struct prf const *prf, void const *in, size_t inlen,
+             char *resbuf)
 {
-  if (c == 0)
-    return GC_PKCS5_INVALID_ITERATION_COUNT;
+  switch (prf->hash)
+    {
+#if GNULIB_HMAC_SHA1
+    case GC_SHA1:
+      {
+        struct hmac_sha1_ctx ctx = prf->keyed.sha1;
+        hmac_sha1_process_bytes (in, inlen, &ctx);
+        hmac_sha1_finish_ctx (&ctx, resbuf);
+      }
+      return GC_OK;
+#endif
 
-  if (dkLen == 0)
-    return GC_PKCS5_INVALID_DERIVED_KEY_LENGTH;
+#if GNULIB_HMAC_SHA256
+    case GC_SHA256:
+      {
+        struct hmac_sha256_ctx ctx = prf->keyed.sha256;
+        hmac_sha256_process_bytes (in, inlen, &ctx);
+        hmac_sha256_finish_ctx (&ctx, resbuf);
+      }
+      return GC_OK;
+#endif
 
-  if (dkLen > 4294967295U)
-    return GC_PKCS5_DERIVED_KEY_TOO_LONG;
+#if GNULIB_HMAC_SHA512
+    case GC_SHA512:
+      {
+        struct hmac_sha512_ctx ctx = prf->keyed.sha512;
+        hmac_sha512_process_bytes (in, inlen, &ctx);
+        hmac_sha512_finish_ctx (&ctx, resbuf);
+      }
+      return GC_OK;
+#endif
 
-  unsigned int l = ((dkLen - 1) / hLen) + 1;
-  unsigned int r = dkLen - (l - 1) * hLen;
+    default:
+      return prf->func (prf->P, prf->Plen, in, inlen, resbuf);
+    }
+}
+
+/* The computation of the blocks FIRST, FIRST + STEP, ... of the derived
+   key, which are independent of each other.  */
+struct pbkdf2_job
+{
+  struct prf const *prf;
+  char const *S;
+  size_t Slen;
+  unsigned int c;
+  unsigned int l;
+  unsigned int r;
+  char *DK;
+  unsigned int first;
+  unsigned int step;
+  Gc_rc rc;
+};
+
+/* Use threads only when each block takes long enough to amortize the
+   creation of a thread.  */
+enum { PBKDF2_THREAD_MIN_ITERATIONS = 256 };
+
+static void *
+pbkdf2_blocks (void *arg)
+{
+  struct pbkdf2_job *job = arg;
+  struct prf const *prf = job->prf;
+  size_t hLen = prf->hLen;
+  size_t Slen = job->Slen;
 
   size_t tmplen = Slen + 4;
   char *tmp = malloc (tmplen);
   if (tmp == NULL)
-    return GC_MALLOC_ERROR;
+    {
+      job->rc = GC_MALLOC_ERROR;
+      return NULL;
+    }
 
-  memcpy (tmp, S, Slen);
+  memcpy (tmp, job->S, Slen);
 
   char U[GC_MAX_DIGEST_SIZE];
   char T[GC_MAX_DIGEST_SIZE];
-  int rc;
-  for (unsigned int i = 0; i++ < l; )
+  Gc_rc rc = GC_OK;
+  for (unsigned int i = job->first; i <= job->l; i += job->step)
     {
       memset (T, 0, hLen);
 
-      for (unsigned int u = 0; u++ < c; )
+      for (unsigned int u = 0; u++ < job->c; )
         {
           if (u == 1)
             {
@@ -69,27 +181,102 @@ gc_pbkdf2_prf (gc_prf_func prf, size_t hLen,
               tmp[Slen + 2] = (i & 0x0000ff00) >> 8;
               tmp[Slen + 3] = (i & 0x000000ff) >> 0;
 
-              rc = prf (P, Plen, tmp, tmplen, U);
+              rc = prf_compute (prf, tmp, tmplen, U);
             }
           else
-            rc = prf (P, Plen, U, hLen, U);
+            rc = prf_compute (prf, U, hLen, U);
 
           if (rc != GC_OK)
-            {
-              free (tmp);
-              return rc;
-            }
+            goto done;
 
           for (unsigned int k = 0; k < hLen; k++)
             T[k] ^= U[k];
         }
 
-      memcpy (DK + (i - 1) * hLen, T, i == l ? r : hLen);
+      memcpy (job->DK + (i - 1) * hLen, T, i == job->l ? job->r : hLen);
     }
 
+ done:
   free (tmp);
+  job->rc = rc;
+  return NULL;
+}
+
+static Gc_rc
+gc_pbkdf2_prf (gc_prf_func prf, Gc_hash hash, size_t hLen,
+               char const *restrict P, size_t Plen,
+               char const *restrict S, size_t Slen,
+               unsigned int c,
+               char *restrict DK, size_t dkLen)
+{
+  if (c == 0)
+    return GC_PKCS5_INVALID_ITERATION_COUNT;
+
+  if (dkLen == 0)
+    return GC_PKCS5_INVALID_DERIVED_KEY_LENGTH;
+
+  if (dkLen > 4294967295U)
+    return GC_PKCS5_DERIVED_KEY_TOO_LONG;
+
+  unsigned int l = ((dkLen - 1) / hLen) + 1;
+  unsigned int r = dkLen - (l - 1) * hLen;
+
+  struct prf keyed = { .hash = hash, .func = prf, .hLen = hLen,
+                       .P = P, .Plen = Plen };
+  prf_init (&keyed);
+
+  /* Compute the blocks of the derived key in parallel, each thread
+     taking every NTHREADS-th block.  */
+  unsigned long int nthreads = 1;
+  if (l > 1 && c >= PBKDF2_THREAD_MIN_ITERATIONS)
+    {
+      nthreads = num_processors (NPROC_CURRENT);
+      if (nthreads > l)
+        nthreads = l;
+    }
+
+  struct pbkdf2_job *jobs = malloc (nthreads * sizeof *jobs);
+  gl_thread_t *threads = malloc (nthreads * sizeof *threads);
+  bool *started = malloc (nthreads * sizeof *started);
+  if (jobs == NULL || threads == NULL || started == NULL)
+    {
+      free (jobs);
+      free (threads);
+      free (started);
+      return GC_MALLOC_ERROR;
+    }
+
+  for (unsigned long int t = 0; t < nthreads; t++)
+    {
+      jobs[t] = (struct pbkdf2_job) { .prf = &keyed, .S = S, .Slen = Slen,
+                                      .c = c, .l = l, .r = r, .DK = DK,
+                                      .first = t + 1, .step = nthreads };
+      started[t] = (0 < t
+                    && glthread_create (&threads[t], pbkdf2_blocks,
+                                        &jobs[t]) == 0);
+    }
+
+  /* Do the work of the first job, and of the jobs whose thread could
+     not be created, in this thread.  */
+  Gc_rc rc = GC_OK;
+  for (unsigned long int t = 0; t < nthreads; t++)
+    {
+      if (!started[t])
+        pbkdf2_blocks (&jobs[t]);
+    }
+  for (unsigned long int t = 0; t < nthreads; t++)
+    {
+      if (started[t])
+        glthread_join (threads[t], NULL);
+      if (rc == GC_OK)
+        rc = jobs[t].rc;
+    }
+
+  free (jobs);
+  free (threads);
+  free (started);
 
-  return GC_OK;
+  return rc;
 }
 
 Gc_rc
@@ -128,5 +315,5 @@ gc_pbkdf2_hmac (Gc_hash hash,
       return GC_INVALID_HASH;
     }
 
-  return gc_pbkdf2_prf (prf, hLen, P, Plen, S, Slen, c, DK, dkLen);
+  return gc_pbkdf2_prf (prf, hash, hLen, P, Plen, S, Slen, c, DK, dkLen);
 }
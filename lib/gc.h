@@ -104,7 +104,9 @@ enum Gc_cipher_mode
 {
   GC_ECB,
   GC_CBC,
-  GC_STREAM
+  GC_STREAM,
+  GC_CTR,
+  GC_GCM
 };
 typedef enum Gc_cipher_mode Gc_cipher_mode;
 
@@ -141,6 +143,15 @@ extern Gc_rc gc_cipher_encrypt_inline (gc_cipher_handle restrict handle,
                                        size_t len, char *restrict data);
 extern Gc_rc gc_cipher_decrypt_inline (gc_cipher_handle restrict handle,
                                        size_t len, char *restrict data);
+/* In GC_GCM mode, add the LEN bytes at AAD to the additional
+   authenticated data, before any data is encrypted or decrypted.  */
+extern Gc_rc gc_cipher_authenticate (gc_cipher_handle restrict handle,
+                                     size_t len, char const *restrict aad);
+/* In GC_GCM mode, store the first LEN bytes, at most 16, of the
+   authentication tag into TAG, after all the data has been encrypted or
+   decrypted.  */
+extern Gc_rc gc_cipher_gettag (gc_cipher_handle restrict handle,
+                               size_t len, char *restrict tag);
 extern Gc_rc gc_cipher_close (gc_cipher_handle handle);
 
 /* Hashes. */
@@ -191,8 +202,10 @@ extern Gc_rc gc_hmac_sha512 (void const *restrict key, size_t keylen,
    coded to be HMAC with HASH.  An iteration count is specified in C
    (> 0), where a larger value means this function take more time
    (typical iteration counts are 1000-20000).  This function
-   "stretches" the key to be exactly dkLen bytes long.  GC_OK is
-   returned on success, otherwise a Gc_rc error code is returned.  */
+   "stretches" the key to be exactly dkLen bytes long.  When DKLEN
+   exceeds the digest size of HASH, the independent blocks of the
+   derived key are computed by several threads.  GC_OK is returned on
+   success, otherwise a Gc_rc error code is returned.  */
 extern Gc_rc
 gc_pbkdf2_hmac (Gc_hash hash,
                 char const *restrict P, size_t Plen,
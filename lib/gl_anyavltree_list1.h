@@ -59,8 +59,16 @@ struct gl_list_impl
   size_t table_size;
   struct gl_hash_entry **table
     _GL_ATTRIBUTE_COUNTED_BY (table_size);
+  /* While the hash table grows: the previous table, whose buckets with
+     index >= migrated have not yet been moved to the table.  */
+  size_t old_table_size;
+  struct gl_hash_entry **old_table
+    _GL_ATTRIBUTE_COUNTED_BY (old_table_size);
+  size_t migrated;
 #endif
   struct gl_list_node_impl *root;   /* root node or NULL */
+  /* Where the nodes are allocated.  */
+  struct gl_nodepool nodepool;
 };
 
 /* An AVL tree of height h has at least F_(h+2) - 1 [Fibonacci number] and at
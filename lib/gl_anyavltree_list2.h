@@ -73,6 +73,53 @@ create_subtree_with_contents (size_t count, const void **contents)
   return NULL;
 }
 
+/* Links the count >= 1 existing nodes NODES[0..COUNT-1] into a subtree, in
+   this order, like create_subtree_with_contents does with new nodes.
+   Returns the root of the subtree.  */
+static gl_list_node_t
+link_subtree (gl_list_node_t *nodes, size_t count)
+{
+  size_t half1 = (count - 1) / 2;
+  size_t half2 = count / 2;
+  gl_list_node_t node = nodes[half1];
+
+  if (half1 > 0)
+    {
+      node->left = link_subtree (nodes, half1);
+      node->left->parent = node;
+    }
+  else
+    node->left = NULL;
+
+  if (half2 > 0)
+    {
+      node->right = link_subtree (nodes + half1 + 1, half2);
+      node->right->parent = node;
+    }
+  else
+    node->right = NULL;
+
+  node->balance = (count > 1 && (count & (count - 1)) == 0 ? 1 : 0);
+
+  node->branch_size = count;
+
+  return node;
+}
+
+/* Makes the COUNT existing nodes NODES[0..COUNT-1], in this order, the
+   tree of LIST.  */
+static void
+relink_tree (gl_list_t list, gl_list_node_t *nodes, size_t count)
+{
+  if (count > 0)
+    {
+      list->root = link_subtree (nodes, count);
+      list->root->parent = NULL;
+    }
+  else
+    list->root = NULL;
+}
+
 static gl_list_t
 gl_tree_nx_create (gl_list_implementation_t implementation,
                    gl_listelement_equals_fn equals_fn,
@@ -97,15 +144,20 @@ gl_tree_nx_create (gl_list_implementation_t implementation,
     size_t estimate = xsum (count, count / 2); /* 1.5 * count */
     if (estimate < 10)
       estimate = 10;
-    list->table_size = next_prime (estimate);
+    list->table_size = hash_table_size (estimate);
     if (size_overflow_p (xtimes (list->table_size, sizeof (gl_hash_entry_t))))
       goto fail1;
     list->table =
       (gl_hash_entry_t *) calloc (list->table_size, sizeof (gl_hash_entry_t));
     if (list->table == NULL)
       goto fail1;
+    list->old_table_size = 0;
+    list->old_table = NULL;
+    list->migrated = 0;
   }
 #endif
+  gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                    false);
   if (count > 0)
     {
       list->root = create_subtree_with_contents (count, contents);
@@ -521,7 +573,7 @@ gl_tree_nx_add_first (gl_list_t list, const void *elt)
 {
   /* Create new node.  */
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -570,7 +622,7 @@ gl_tree_nx_add_first (gl_list_t list, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -585,7 +637,7 @@ gl_tree_nx_add_last (gl_list_t list, const void *elt)
 {
   /* Create new node.  */
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -634,7 +686,7 @@ gl_tree_nx_add_last (gl_list_t list, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -651,7 +703,7 @@ gl_tree_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
   gl_list_node_t new_node;
 
   new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
   if (new_node == NULL)
     return NULL;
 
@@ -700,7 +752,7 @@ gl_tree_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -717,7 +769,7 @@ gl_tree_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
   gl_list_node_t new_node;
 
   new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
   if (new_node == NULL)
     return NULL;
 
@@ -766,7 +818,7 @@ gl_tree_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -29,3 +29,13 @@ struct gl_hash_entry
                                        - the value (for list, set data types) */
 };
 typedef struct gl_hash_entry * gl_hash_entry_t;
+
+/* The number of searches that a batched search has in flight.  */
+#define HASH_SEARCH_WINDOW 16
+
+/* Prefetches the memory at P, which is about to be read.  */
+#if _GL_GNUC_PREREQ (3, 1)
+# define hash_prefetch(p) __builtin_prefetch (p)
+#else
+# define hash_prefetch(p) ((void) (p))
+#endif
@@ -39,6 +39,12 @@ struct gl_list_impl
   size_t table_size;
   struct gl_hash_entry **table
     _GL_ATTRIBUTE_COUNTED_BY (table_size);
+  /* While the hash table grows: the previous table, whose buckets with
+     index >= migrated have not yet been moved to the table.  */
+  size_t old_table_size;
+  struct gl_hash_entry **old_table
+    _GL_ATTRIBUTE_COUNTED_BY (old_table_size);
+  size_t migrated;
 #endif
   /* A circular list anchored at root.
      The first node is = root.next, the last node is = root.prev.
@@ -46,4 +52,6 @@ struct gl_list_impl
   struct gl_list_node_impl root;
   /* Number of list nodes, excluding the root.  */
   size_t count;
+  /* Where the list nodes, excluding the root, are allocated.  */
+  struct gl_nodepool nodepool;
 };
@@ -55,15 +55,20 @@ gl_linked_nx_create_empty (gl_list_implementation_t implementation,
   list->base.dispose_fn = dispose_fn;
   list->base.allow_duplicates = allow_duplicates;
 #if WITH_HASHTABLE
-  list->table_size = 11;
+  list->table_size = HASH_INITIAL_SIZE;
   list->table =
     (gl_hash_entry_t *) calloc (list->table_size, sizeof (gl_hash_entry_t));
   if (list->table == NULL)
     goto fail;
+  list->old_table_size = 0;
+  list->old_table = NULL;
+  list->migrated = 0;
 #endif
   list->root.next = &list->root;
   list->root.prev = &list->root;
   list->count = 0;
+  gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                    false);
 
   return list;
 
@@ -74,6 +79,23 @@ gl_linked_nx_create_empty (gl_list_implementation_t implementation,
 #endif
 }
 
+static gl_list_t
+gl_linked_nx_create_empty_with_pool (gl_list_implementation_t implementation,
+                                     gl_listelement_equals_fn equals_fn,
+                                     gl_listelement_hashcode_fn hashcode_fn,
+                                     gl_listelement_dispose_fn dispose_fn,
+                                     bool allow_duplicates)
+{
+  gl_list_t list =
+    gl_linked_nx_create_empty (implementation, equals_fn, hashcode_fn,
+                               dispose_fn, allow_duplicates);
+
+  if (list != NULL)
+    gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                      true);
+  return list;
+}
+
 static gl_list_t
 gl_linked_nx_create (gl_list_implementation_t implementation,
                      gl_listelement_equals_fn equals_fn,
@@ -100,21 +122,26 @@ gl_linked_nx_create (gl_list_implementation_t implementation,
     size_t estimate = xsum (count, count / 2); /* 1.5 * count */
     if (estimate < 10)
       estimate = 10;
-    list->table_size = next_prime (estimate);
+    list->table_size = hash_table_size (estimate);
     if (size_overflow_p (xtimes (list->table_size, sizeof (gl_hash_entry_t))))
       goto fail1;
     list->table =
       (gl_hash_entry_t *) calloc (list->table_size, sizeof (gl_hash_entry_t));
     if (list->table == NULL)
       goto fail1;
+    list->old_table_size = 0;
+    list->old_table = NULL;
+    list->migrated = 0;
   }
 #endif
+  gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                    false);
   list->count = count;
   tail = &list->root;
   for (; count > 0; contents++, count--)
     {
       gl_list_node_t node =
-        (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+        (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
       if (node == NULL)
         goto fail2;
@@ -129,7 +156,7 @@ gl_linked_nx_create (gl_list_implementation_t implementation,
       /* Add node to the hash table.  */
       if (add_to_bucket (list, node) < 0)
         {
-          free (node);
+          gl_nodepool_free (&list->nodepool, node);
           goto fail2;
         }
 #endif
@@ -149,7 +176,7 @@ gl_linked_nx_create (gl_list_implementation_t implementation,
     {
       gl_list_node_t prev = node->prev;
 
-      free (node);
+      gl_nodepool_free (&list->nodepool, node);
       node = prev;
     }
 #if WITH_HASHTABLE
@@ -201,7 +228,7 @@ gl_linked_node_nx_set_value (_GL_ATTRIBUTE_MAYBE_UNUSED gl_list_t list,
               ASYNCSAFE(gl_list_node_t) before_removed->next = after_removed;
               after_removed->prev = before_removed;
               list->count--;
-              free (node);
+              gl_nodepool_free (&list->nodepool, node);
               return -1;
             }
         }
@@ -317,7 +344,7 @@ gl_linked_nx_set_at (gl_list_t list, size_t position, const void *elt)
               ASYNCSAFE(gl_list_node_t) before_removed->next = after_removed;
               after_removed->prev = before_removed;
               list->count--;
-              free (node);
+              gl_nodepool_free (&list->nodepool, node);
               return NULL;
             }
         }
@@ -346,7 +373,7 @@ gl_linked_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
       (list->base.hashcode_fn != NULL
        ? list->base.hashcode_fn (elt)
        : (size_t) {(uintptr_t) elt});
-    size_t bucket = hashcode % list->table_size;
+    gl_hash_entry_t *bucket = hash_bucket (list, hashcode);
     gl_listelement_equals_fn equals = list->base.equals_fn;
 
     if (!list->base.allow_duplicates)
@@ -354,7 +381,7 @@ gl_linked_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
         /* Look for the first match in the hash bucket.  */
         gl_list_node_t found = NULL;
 
-        for (gl_list_node_t node = (gl_list_node_t) list->table[bucket];
+        for (gl_list_node_t node = (gl_list_node_t) *bucket;
              node != NULL;
              node = (gl_list_node_t) node->h.hash_next)
           if (node->h.hashcode == hashcode
@@ -394,7 +421,7 @@ gl_linked_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
         bool multiple_matches = false;
         gl_list_node_t first_match = NULL;
 
-        for (gl_list_node_t node = (gl_list_node_t) list->table[bucket];
+        for (gl_list_node_t node = (gl_list_node_t) *bucket;
              node != NULL;
              node = (gl_list_node_t) node->h.hash_next)
           if (node->h.hashcode == hashcode
@@ -501,7 +528,7 @@ gl_linked_indexof_from_to (gl_list_t list, size_t start_index, size_t end_index,
       (list->base.hashcode_fn != NULL
        ? list->base.hashcode_fn (elt)
        : (size_t) {(uintptr_t) elt});
-    size_t bucket = hashcode % list->table_size;
+    gl_hash_entry_t *bucket = hash_bucket (list, hashcode);
     gl_listelement_equals_fn equals = list->base.equals_fn;
 
     /* First step: Look up the node.  */
@@ -509,7 +536,7 @@ gl_linked_indexof_from_to (gl_list_t list, size_t start_index, size_t end_index,
     if (!list->base.allow_duplicates)
       {
         /* Look for the first match in the hash bucket.  */
-        for (node = (gl_list_node_t) list->table[bucket];
+        for (node = (gl_list_node_t) *bucket;
              node != NULL;
              node = (gl_list_node_t) node->h.hash_next)
           if (node->h.hashcode == hashcode
@@ -524,7 +551,7 @@ gl_linked_indexof_from_to (gl_list_t list, size_t start_index, size_t end_index,
         bool multiple_matches = false;
         gl_list_node_t first_match = NULL;
 
-        for (node = (gl_list_node_t) list->table[bucket];
+        for (node = (gl_list_node_t) *bucket;
              node != NULL;
              node = (gl_list_node_t) node->h.hash_next)
           if (node->h.hashcode == hashcode
@@ -612,7 +639,7 @@ gl_linked_nx_add_first (gl_list_t list, const void *elt)
   _GL_LIST_INVOKES_FN_PTR
 {
   gl_list_node_t node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (node == NULL)
     return NULL;
@@ -627,7 +654,7 @@ gl_linked_nx_add_first (gl_list_t list, const void *elt)
   /* Add node to the hash table.  */
   if (add_to_bucket (list, node) < 0)
     {
-      free (node);
+      gl_nodepool_free (&list->nodepool, node);
       return NULL;
     }
 #endif
@@ -651,7 +678,7 @@ gl_linked_nx_add_last (gl_list_t list, const void *elt)
   _GL_LIST_INVOKES_FN_PTR
 {
   gl_list_node_t node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (node == NULL)
     return NULL;
@@ -666,7 +693,7 @@ gl_linked_nx_add_last (gl_list_t list, const void *elt)
   /* Add node to the hash table.  */
   if (add_to_bucket (list, node) < 0)
     {
-      free (node);
+      gl_nodepool_free (&list->nodepool, node);
       return NULL;
     }
 #endif
@@ -690,7 +717,7 @@ gl_linked_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
   _GL_LIST_INVOKES_FN_PTR
 {
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -705,7 +732,7 @@ gl_linked_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
   /* Add new_node to the hash table.  */
   if (add_to_bucket (list, new_node) < 0)
     {
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
 #endif
@@ -729,7 +756,7 @@ gl_linked_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
   _GL_LIST_INVOKES_FN_PTR
 {
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -744,7 +771,7 @@ gl_linked_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
   /* Add new_node to the hash table.  */
   if (add_to_bucket (list, new_node) < 0)
     {
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
 #endif
@@ -774,7 +801,7 @@ gl_linked_nx_add_at (gl_list_t list, size_t position, const void *elt)
     /* Invalid argument.  */
     abort ();
 
-  new_node = (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+  new_node = (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
   if (new_node == NULL)
     return NULL;
 
@@ -788,7 +815,7 @@ gl_linked_nx_add_at (gl_list_t list, size_t position, const void *elt)
   /* Add new_node to the hash table.  */
   if (add_to_bucket (list, new_node) < 0)
     {
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
 #endif
@@ -827,6 +854,115 @@ gl_linked_nx_add_at (gl_list_t list, size_t position, const void *elt)
   return new_node;
 }
 
+/* Creates COUNT >= 1 new nodes for the elements CONTENTS[0..COUNT-1],
+   chained through their next and prev fields and terminated by NULL, and
+   stores the first and the last of them in *FIRSTP and *LASTP.  Adds the
+   nodes to the hash table, if any, but not yet to the list.
+   Returns 0 upon success, -1 upon out-of-memory.  */
+static int
+create_nodes (gl_list_t list,
+              size_t count, const void **contents,
+              gl_list_node_t *firstp, gl_list_node_t *lastp)
+  _GL_LIST_INVOKES_FN_PTR
+{
+#if WITH_HASHTABLE
+  /* Resize the hash table once, for all the new nodes.  */
+  size_t new_count = xsum (list->count, count);
+  hash_resize (list, xsum (new_count, new_count / 2));
+  hash_migrate_all (list);
+#endif
+
+  gl_list_node_t first = NULL;
+  gl_list_node_t last = NULL;
+  for (size_t i = 0; i < count; i++)
+    {
+      gl_list_node_t new_node =
+        (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
+
+      if (new_node == NULL)
+        goto fail;
+
+      ASYNCSAFE(const void *) new_node->value = contents[i];
+#if WITH_HASHTABLE
+      new_node->h.hashcode =
+        (list->base.hashcode_fn != NULL
+         ? list->base.hashcode_fn (new_node->value)
+         : (size_t) {(uintptr_t) new_node->value});
+
+      /* Add new_node to the hash table.  */
+      if (add_to_bucket (list, new_node) < 0)
+        {
+          gl_nodepool_free (&list->nodepool, new_node);
+          goto fail;
+        }
+#endif
+
+      new_node->prev = last;
+      if (last != NULL)
+        ASYNCSAFE(gl_list_node_t) last->next = new_node;
+      else
+        first = new_node;
+      last = new_node;
+    }
+  last->next = NULL;
+  *firstp = first;
+  *lastp = last;
+  return 0;
+
+ fail:
+  for (gl_list_node_t node = last; node != NULL; )
+    {
+      gl_list_node_t prev = node->prev;
+#if WITH_HASHTABLE
+      remove_from_bucket (list, node);
+#endif
+      gl_nodepool_free (&list->nodepool, node);
+      node = prev;
+    }
+  return -1;
+}
+
+static int
+gl_linked_nx_add_all_at (gl_list_t list, size_t position,
+                         size_t count, const void **contents)
+{
+  size_t old_count = list->count;
+
+  if (!(position <= old_count))
+    /* Invalid argument.  */
+    abort ();
+  if (count > 0)
+    {
+      gl_list_node_t first;
+      gl_list_node_t last;
+      if (create_nodes (list, count, contents, &first, &last) < 0)
+        return -1;
+
+      /* Find the node before POSITION.  */
+      gl_list_node_t node = &list->root;
+      if (position <= (old_count / 2))
+        {
+          for (; position > 0; position--)
+            node = node->next;
+        }
+      else
+        {
+          for (position = old_count - position; position > 0; position--)
+            node = node->prev;
+          node = node->prev;
+        }
+
+      /* Add the chain first..last after node.  */
+      gl_list_node_t next = node->next;
+      first->prev = node;
+      ASYNCSAFE(gl_list_node_t) last->next = next;
+      next->prev = last;
+      ASYNCSAFE(gl_list_node_t) node->next = first;
+      list->count = old_count + count;
+    }
+  return 0;
+}
+
 static bool
 gl_linked_remove_node (gl_list_t list, gl_list_node_t node)
   _GL_LIST_INVOKES_FN_PTR
@@ -846,7 +982,7 @@ gl_linked_remove_node (gl_list_t list, gl_list_node_t node)
 
   if (list->base.dispose_fn != NULL)
     list->base.dispose_fn (node->value);
-  free (node);
+  gl_nodepool_free (&list->nodepool, node);
   return true;
 }
 
@@ -892,10 +1028,66 @@ gl_linked_remove_at (gl_list_t list, size_t position)
 
   if (list->base.dispose_fn != NULL)
     list->base.dispose_fn (removed_node->value);
-  free (removed_node);
+  gl_nodepool_free (&list->nodepool, removed_node);
   return true;
 }
 
+static void
+gl_linked_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t count = list->count;
+
+  if (!(start_index <= end_index && end_index <= count))
+    /* Invalid arguments.  */
+    abort ();
+  if (start_index < end_index)
+    {
+      /* Find the node before START_INDEX and the node at END_INDEX,
+         starting from the nearer end of the list.  */
+      size_t n = end_index - start_index;
+      gl_list_node_t before;
+      gl_list_node_t after;
+      if (start_index <= count - end_index)
+        {
+          before = &list->root;
+          for (size_t i = start_index; i > 0; i--)
+            before = before->next;
+          after = before->next;
+          for (size_t i = n; i > 0; i--)
+            after = after->next;
+        }
+      else
+        {
+          after = &list->root;
+          for (size_t i = count - end_index; i > 0; i--)
+            after = after->prev;
+          before = after->prev;
+          for (size_t i = n; i > 0; i--)
+            before = before->prev;
+        }
+
+      /* Remove the nodes between before and after from the list.  */
+      gl_list_node_t node = before->next;
+      ASYNCSAFE(gl_list_node_t) before->next = after;
+      after->prev = before;
+      list->count = count - n;
+
+      gl_listelement_dispose_fn dispose = list->base.dispose_fn;
+      while (node != after)
+        {
+          gl_list_node_t next = node->next;
+#if WITH_HASHTABLE
+          remove_from_bucket (list, node);
+#endif
+          if (dispose != NULL)
+            dispose (node->value);
+          gl_nodepool_free (&list->nodepool, node);
+          node = next;
+        }
+    }
+}
+
 static bool
 gl_linked_remove (gl_list_t list, const void *elt)
 {
@@ -913,15 +1105,26 @@ gl_linked_list_free (gl_list_t list)
 {
   gl_listelement_dispose_fn dispose = list->base.dispose_fn;
 
-  for (gl_list_node_t node = list->root.next; node != &list->root; )
+  if (list->nodepool.enabled)
     {
-      gl_list_node_t next = node->next;
       if (dispose != NULL)
-        dispose (node->value);
-      free (node);
-      node = next;
+        for (gl_list_node_t node = list->root.next;
+             node != &list->root;
+             node = node->next)
+          dispose (node->value);
+      gl_nodepool_release (&list->nodepool);
     }
+  else
+    for (gl_list_node_t node = list->root.next; node != &list->root; )
+      {
+        gl_list_node_t next = node->next;
+        if (dispose != NULL)
+          dispose (node->value);
+        free (node);
+        node = next;
+      }
 #if WITH_HASHTABLE
+  free (list->old_table);
   free (list->table);
 #endif
   free (list);
@@ -1185,6 +1388,40 @@ gl_linked_sortedlist_nx_add (gl_list_t list, gl_listelement_compar_fn compar,
   return gl_linked_nx_add_last (list, elt);
 }
 
+static int
+gl_linked_sortedlist_nx_merge_array (gl_list_t list,
+                                     gl_listelement_compar_fn compar,
+                                     size_t count, const void **contents)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  if (count > 0)
+    {
+      gl_list_node_t first;
+      gl_list_node_t last;
+      if (create_nodes (list, count, contents, &first, &last) < 0)
+        return -1;
+
+      /* Insert each new node before the first node of the list that is
+         greater than it.  Since the new nodes are sorted, this is a single
+         pass through the list.  */
+      gl_list_node_t node = list->root.next;
+      for (gl_list_node_t new_node = first; new_node != NULL; )
+        {
+          gl_list_node_t next_new_node = new_node->next;
+          while (node != &list->root
+                 && compar (node->value, new_node->value) <= 0)
+            node = node->next;
+          ASYNCSAFE(gl_list_node_t) new_node->next = node;
+          new_node->prev = node->prev;
+          ASYNCSAFE(gl_list_node_t) new_node->prev->next = new_node;
+          node->prev = new_node;
+          new_node = next_new_node;
+        }
+      list->count += count;
+    }
+  return 0;
+}
+
 static bool
 gl_linked_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
                              const void *elt)
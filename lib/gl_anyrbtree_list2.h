@@ -78,6 +78,63 @@ create_subtree_with_contents (unsigned int bh,
   return NULL;
 }
 
+/* Links the count >= 1 existing nodes NODES[0..COUNT-1] into a subtree, in
+   this order, like create_subtree_with_contents does with new nodes.
+   Returns the root of the subtree.  */
+static gl_list_node_t
+link_subtree (unsigned int bh, gl_list_node_t *nodes, size_t count)
+{
+  size_t half1 = (count - 1) / 2;
+  size_t half2 = count / 2;
+  gl_list_node_t node = nodes[half1];
+
+  if (half1 > 0)
+    {
+      node->left = link_subtree (bh - 1, nodes, half1);
+      node->left->parent = node;
+    }
+  else
+    node->left = NULL;
+
+  if (half2 > 0)
+    {
+      node->right = link_subtree (bh - 1, nodes + half1 + 1, half2);
+      node->right->parent = node;
+    }
+  else
+    node->right = NULL;
+
+  node->color = (bh == 0 ? RED : BLACK);
+
+  node->branch_size = count;
+
+  return node;
+}
+
+/* Makes the COUNT existing nodes NODES[0..COUNT-1], in this order, the
+   tree of LIST.  */
+static void
+relink_tree (gl_list_t list, gl_list_node_t *nodes, size_t count)
+{
+  if (count > 0)
+    {
+      /* Assuming 2^bh - 1 <= count <= 2^(bh+1) - 2, we link a tree whose
+         upper bh levels are black, and only the partially present lowest
+         level is red.  */
+      unsigned int bh;
+      {
+        size_t n;
+        for (n = count + 1, bh = 0; n > 1; n = n >> 1)
+          bh++;
+      }
+
+      list->root = link_subtree (bh, nodes, count);
+      list->root->parent = NULL;
+    }
+  else
+    list->root = NULL;
+}
+
 static gl_list_t
 gl_tree_nx_create (gl_list_implementation_t implementation,
                    gl_listelement_equals_fn equals_fn,
@@ -102,15 +159,20 @@ gl_tree_nx_create (gl_list_implementation_t implementation,
     size_t estimate = xsum (count, count / 2); /* 1.5 * count */
     if (estimate < 10)
       estimate = 10;
-    list->table_size = next_prime (estimate);
+    list->table_size = hash_table_size (estimate);
     if (size_overflow_p (xtimes (list->table_size, sizeof (gl_hash_entry_t))))
       goto fail1;
     list->table =
       (gl_hash_entry_t *) calloc (list->table_size, sizeof (gl_hash_entry_t));
     if (list->table == NULL)
       goto fail1;
+    list->old_table_size = 0;
+    list->old_table = NULL;
+    list->migrated = 0;
   }
 #endif
+  gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                    false);
   if (count > 0)
     {
       /* Assuming 2^bh - 1 <= count <= 2^(bh+1) - 2, we create a tree whose
@@ -767,7 +829,7 @@ gl_tree_nx_add_first (gl_list_t list, const void *elt)
 {
   /* Create new node.  */
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -814,7 +876,7 @@ gl_tree_nx_add_first (gl_list_t list, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -829,7 +891,7 @@ gl_tree_nx_add_last (gl_list_t list, const void *elt)
 {
   /* Create new node.  */
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -876,7 +938,7 @@ gl_tree_nx_add_last (gl_list_t list, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -891,7 +953,7 @@ gl_tree_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
 {
   /* Create new node.  */
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -932,7 +994,7 @@ gl_tree_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
@@ -947,7 +1009,7 @@ gl_tree_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
 {
   /* Create new node.  */
   gl_list_node_t new_node =
-    (struct gl_list_node_impl *) malloc (sizeof (struct gl_list_node_impl));
+    (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -988,7 +1050,7 @@ gl_tree_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
   if (add_to_bucket (list, new_node) < 0)
     {
       gl_tree_remove_node_from_tree (list, new_node);
-      free (new_node);
+      gl_nodepool_free (&list->nodepool, new_node);
       return NULL;
     }
   hash_resize_after_add (list);
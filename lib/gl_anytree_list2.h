@@ -36,13 +36,18 @@ gl_tree_nx_create_empty (gl_list_implementation_t implementation,
   list->base.dispose_fn = dispose_fn;
   list->base.allow_duplicates = allow_duplicates;
 #if WITH_HASHTABLE
-  list->table_size = 11;
+  list->table_size = HASH_INITIAL_SIZE;
   list->table =
     (gl_hash_entry_t *) calloc (list->table_size, sizeof (gl_hash_entry_t));
   if (list->table == NULL)
     goto fail;
+  list->old_table_size = 0;
+  list->old_table = NULL;
+  list->migrated = 0;
 #endif
   list->root = NULL;
+  gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                    false);
 
   return list;
 
@@ -53,6 +58,23 @@ gl_tree_nx_create_empty (gl_list_implementation_t implementation,
 #endif
 }
 
+static gl_list_t
+gl_tree_nx_create_empty_with_pool (gl_list_implementation_t implementation,
+                                   gl_listelement_equals_fn equals_fn,
+                                   gl_listelement_hashcode_fn hashcode_fn,
+                                   gl_listelement_dispose_fn dispose_fn,
+                                   bool allow_duplicates)
+{
+  gl_list_t list =
+    gl_tree_nx_create_empty (implementation, equals_fn, hashcode_fn,
+                             dispose_fn, allow_duplicates);
+
+  if (list != NULL)
+    gl_nodepool_init (&list->nodepool, sizeof (struct gl_list_node_impl),
+                      true);
+  return list;
+}
+
 static size_t _GL_ATTRIBUTE_PURE
 gl_tree_size (gl_list_t list)
 {
@@ -89,7 +111,7 @@ gl_tree_node_nx_set_value (_GL_ATTRIBUTE_MAYBE_UNUSED gl_list_t list,
                  it to another bucket.  In order to avoid inconsistencies, we
                  must remove node entirely from the list.  */
               gl_tree_remove_node_from_tree (list, node);
-              free (node);
+              gl_nodepool_free (&list->nodepool, node);
               return -1;
             }
         }
@@ -231,7 +253,7 @@ gl_tree_nx_set_at (gl_list_t list, size_t position, const void *elt)
                  it to another bucket.  In order to avoid inconsistencies, we
                  must remove node entirely from the list.  */
               gl_tree_remove_node_from_tree (list, node);
-              free (node);
+              gl_nodepool_free (&list->nodepool, node);
               return NULL;
             }
         }
@@ -501,7 +523,7 @@ gl_tree_remove_node (gl_list_t list, gl_list_node_t node)
 
   if (list->base.dispose_fn != NULL)
     list->base.dispose_fn (node->value);
-  free (node);
+  gl_nodepool_free (&list->nodepool, node);
   return true;
 }
 
@@ -517,6 +539,212 @@ gl_tree_remove_at (gl_list_t list, size_t position)
   return gl_tree_remove_node (list, node);
 }
 
+/* The bulk operations on k elements of a list of n elements process the
+   elements one by one, in O(k log n) time, when k < n / BULK_REBUILD_RATIO,
+   and otherwise rebuild the entire tree in a single O(n + k) pass.  */
+#define BULK_REBUILD_RATIO 16
+
+/* Removes NODE from LIST and frees it, without disposing its value.  */
+static void
+remove_node_keep_value (gl_list_t list, gl_list_node_t node)
+{
+#if WITH_HASHTABLE
+  remove_from_bucket (list, node);
+#endif
+  gl_tree_remove_node_from_tree (list, node);
+  gl_nodepool_free (&list->nodepool, node);
+}
+
+/* Creates COUNT new nodes for the elements CONTENTS[0..COUNT-1], and stores
+   them in NODES[0..COUNT-1].  The nodes are not linked.
+   Returns 0 upon success, -1 upon out-of-memory.  */
+static int
+create_nodes (gl_list_t list,
+              size_t count, const void **contents, gl_list_node_t *nodes)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  for (size_t i = 0; i < count; i++)
+    {
+      gl_list_node_t new_node =
+        (struct gl_list_node_impl *) gl_nodepool_alloc (&list->nodepool);
+      if (new_node == NULL)
+        {
+          for (size_t i2 = 0; i2 < i; i2++)
+            gl_nodepool_free (&list->nodepool, nodes[i2]);
+          return -1;
+        }
+      new_node->value = contents[i];
+#if WITH_HASHTABLE
+      new_node->h.hashcode =
+        (list->base.hashcode_fn != NULL
+         ? list->base.hashcode_fn (new_node->value)
+         : (size_t) {(uintptr_t) new_node->value});
+#endif
+      nodes[i] = new_node;
+    }
+  return 0;
+}
+
+#if WITH_HASHTABLE
+
+/* Adds the COUNT new nodes NEW_NODES[0..COUNT-1], which are already in the
+   tree, to the hash table.  Upon out-of-memory, removes them from the tree
+   again and frees them.
+   Returns 0 upon success, -1 upon out-of-memory.  */
+static int
+add_new_nodes_to_buckets (gl_list_t list,
+                          size_t count, gl_list_node_t *new_nodes)
+{
+  /* Resize the hash table once, for all the new nodes.  */
+  size_t new_count = list->root->branch_size;
+  hash_resize (list, xsum (new_count, new_count / 2));
+  hash_migrate_all (list);
+
+  for (size_t i = 0; i < count; i++)
+    if (add_to_bucket (list, new_nodes[i]) < 0)
+      {
+        for (size_t i2 = 0; i2 < i; i2++)
+          remove_from_bucket (list, new_nodes[i2]);
+        for (size_t i2 = 0; i2 < count; i2++)
+          {
+            gl_tree_remove_node_from_tree (list, new_nodes[i2]);
+            gl_nodepool_free (&list->nodepool, new_nodes[i2]);
+          }
+        return -1;
+      }
+  return 0;
+}
+
+#endif
+
+static int
+gl_tree_nx_add_all_at (gl_list_t list, size_t position,
+                       size_t count, const void **contents)
+{
+  size_t old_count = (list->root != NULL ? list->root->branch_size : 0);
+
+  if (!(position <= old_count))
+    /* Invalid argument.  */
+    abort ();
+  if (count == 0)
+    return 0;
+
+  if (count < old_count / BULK_REBUILD_RATIO)
+    {
+      /* Add the elements one by one.  */
+      for (size_t i = 0; i < count; i++)
+        if (gl_tree_nx_add_at (list, position + i, contents[i]) == NULL)
+          {
+            /* Remove the elements that were already added.  */
+            for (; i > 0; i--)
+              remove_node_keep_value (list, node_at (list->root, position));
+            return -1;
+          }
+      return 0;
+    }
+
+  /* Build an array of all nodes, in their new order.  */
+  size_t new_count = xsum (old_count, count);
+  if (size_overflow_p (xtimes (new_count, sizeof (gl_list_node_t))))
+    return -1;
+  gl_list_node_t *nodes =
+    (gl_list_node_t *) malloc (new_count * sizeof (gl_list_node_t));
+  if (nodes == NULL)
+    return -1;
+  if (create_nodes (list, count, contents, nodes + position) < 0)
+    {
+      free (nodes);
+      return -1;
+    }
+  {
+    size_t i = 0;
+    for (gl_list_node_t node = gl_tree_first_node (list);
+         node != NULL;
+         node = gl_tree_next_node (list, node))
+      {
+        if (i == position)
+          i += count;
+        nodes[i++] = node;
+      }
+  }
+
+  /* Link them into a new balanced tree.  */
+  relink_tree (list, nodes, new_count);
+
+#if WITH_HASHTABLE
+  if (add_new_nodes_to_buckets (list, count, nodes + position) < 0)
+    {
+      free (nodes);
+      return -1;
+    }
+#endif
+
+  free (nodes);
+  return 0;
+}
+
+static void
+gl_tree_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t count = (list->root != NULL ? list->root->branch_size : 0);
+
+  if (!(start_index <= end_index && end_index <= count))
+    /* Invalid arguments.  */
+    abort ();
+  size_t n = end_index - start_index;
+  if (n == 0)
+    return;
+
+  gl_list_node_t *nodes = NULL;
+  if (n >= count / BULK_REBUILD_RATIO)
+    /* Upon out-of-memory, fall back to removing the elements one by one.  */
+    nodes = (gl_list_node_t *) malloc (count * sizeof (gl_list_node_t));
+
+  if (nodes != NULL)
+    {
+      /* Build an array of all nodes.  */
+      {
+        size_t i = 0;
+        for (gl_list_node_t node = gl_tree_first_node (list);
+             node != NULL;
+             node = gl_tree_next_node (list, node))
+          nodes[i++] = node;
+      }
+
+#if WITH_HASHTABLE
+      /* Remove the nodes from the hash table while the tree is intact,
+         because remove_from_bucket() uses node_position().  */
+      for (size_t i = start_index; i < end_index; i++)
+        remove_from_bucket (list, nodes[i]);
+#endif
+
+      gl_listelement_dispose_fn dispose = list->base.dispose_fn;
+      for (size_t i = start_index; i < end_index; i++)
+        {
+          if (dispose != NULL)
+            dispose (nodes[i]->value);
+          gl_nodepool_free (&list->nodepool, nodes[i]);
+        }
+
+      /* Link the remaining nodes into a new balanced tree.  */
+      memmove (nodes + start_index, nodes + end_index,
+               (count - end_index) * sizeof (gl_list_node_t));
+      relink_tree (list, nodes, count - n);
+      free (nodes);
+    }
+  else
+    {
+      gl_list_node_t node = node_at (list->root, start_index);
+      for (; n > 0; n--)
+        {
+          gl_list_node_t next = gl_tree_next_node (list, node);
+          gl_tree_remove_node (list, node);
+          node = next;
+        }
+    }
+}
+
 static bool
 gl_tree_remove (gl_list_t list, const void *elt)
 {
@@ -537,8 +765,12 @@ static void
 gl_tree_list_free (gl_list_t list)
   _GL_LIST_INVOKES_FN_PTR
 {
-  /* Iterate across all elements in post-order.  */
-  gl_list_node_t node = list->root;
+  /* Iterate across all elements in post-order.  When the nodes come from a
+     pool and need no disposal, there is no need to visit them.  */
+  gl_list_node_t node =
+    (list->nodepool.enabled && list->base.dispose_fn == NULL
+     ? NULL
+     : list->root);
   iterstack_t stack;
   iterstack_item_t *stack_ptr = &stack[0];
 
@@ -566,7 +798,7 @@ gl_tree_list_free (gl_list_t list)
           /* Free the current node.  */
           if (list->base.dispose_fn != NULL)
             list->base.dispose_fn (node->value);
-          free (node);
+          gl_nodepool_free (&list->nodepool, node);
         }
       /* Descend on right branch.  */
       stack_ptr->rightp = true;
@@ -574,6 +806,7 @@ gl_tree_list_free (gl_list_t list)
       stack_ptr++;
     }
  done_iterate:
+  gl_nodepool_release (&list->nodepool);
   free (list);
 }
 
@@ -963,6 +1196,91 @@ gl_tree_sortedlist_nx_add (gl_list_t list, gl_listelement_compar_fn compar,
     }
 }
 
+static int
+gl_tree_sortedlist_nx_merge_array (gl_list_t list,
+                                   gl_listelement_compar_fn compar,
+                                   size_t count, const void **contents)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t old_count = (list->root != NULL ? list->root->branch_size : 0);
+
+  if (count == 0)
+    return 0;
+
+  if (size_overflow_p (xtimes (count, sizeof (gl_list_node_t))))
+    return -1;
+  gl_list_node_t *new_nodes =
+    (gl_list_node_t *) malloc (count * sizeof (gl_list_node_t));
+  if (new_nodes == NULL)
+    return -1;
+
+  if (count < old_count / BULK_REBUILD_RATIO)
+    {
+      /* Add the elements one by one.  */
+      for (size_t i = 0; i < count; i++)
+        {
+          new_nodes[i] = gl_tree_sortedlist_nx_add (list, compar, contents[i]);
+          if (new_nodes[i] == NULL)
+            {
+              /* Remove the elements that were already added.  */
+              for (size_t i2 = 0; i2 < i; i2++)
+                remove_node_keep_value (list, new_nodes[i2]);
+              free (new_nodes);
+              return -1;
+            }
+        }
+      free (new_nodes);
+      return 0;
+    }
+
+  /* Build an array of all nodes, in their new order.  */
+  size_t new_count = xsum (old_count, count);
+  gl_list_node_t *nodes;
+  if (size_overflow_p (xtimes (new_count, sizeof (gl_list_node_t))))
+    goto fail1;
+  nodes = (gl_list_node_t *) malloc (new_count * sizeof (gl_list_node_t));
+  if (nodes == NULL)
+    goto fail1;
+  if (create_nodes (list, count, contents, new_nodes) < 0)
+    goto fail2;
+  {
+    size_t i = 0;
+    size_t j = 0;
+    gl_list_node_t node = gl_tree_first_node (list);
+    while (j < count)
+      if (node != NULL && compar (node->value, contents[j]) <= 0)
+        {
+          nodes[i++] = node;
+          node = gl_tree_next_node (list, node);
+        }
+      else
+        nodes[i++] = new_nodes[j++];
+    for (; node != NULL; node = gl_tree_next_node (list, node))
+      nodes[i++] = node;
+  }
+
+  /* Link them into a new balanced tree.  */
+  relink_tree (list, nodes, new_count);
+  free (nodes);
+
+#if WITH_HASHTABLE
+  if (add_new_nodes_to_buckets (list, count, new_nodes) < 0)
+    {
+      free (new_nodes);
+      return -1;
+    }
+#endif
+
+  free (new_nodes);
+  return 0;
+
+ fail2:
+  free (nodes);
+ fail1:
+  free (new_nodes);
+  return -1;
+}
+
 static bool
 gl_tree_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
                            const void *elt)
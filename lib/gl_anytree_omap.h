@@ -45,10 +45,27 @@ gl_tree_nx_create_empty (gl_omap_implementation_t implementation,
   map->base.vdispose_fn = vdispose_fn;
   map->root = NULL;
   map->count = 0;
+  gl_nodepool_init (&map->nodepool, sizeof (struct gl_omap_node_impl), false);
 
   return map;
 }
 
+static gl_omap_t
+gl_tree_nx_create_empty_with_pool (gl_omap_implementation_t implementation,
+                                   gl_mapkey_compar_fn compar_fn,
+                                   gl_mapkey_dispose_fn kdispose_fn,
+                                   gl_mapvalue_dispose_fn vdispose_fn)
+{
+  gl_omap_t map =
+    gl_tree_nx_create_empty (implementation, compar_fn,
+                             kdispose_fn, vdispose_fn);
+
+  if (map != NULL)
+    gl_nodepool_init (&map->nodepool, sizeof (struct gl_omap_node_impl),
+                      true);
+  return map;
+}
+
 static size_t _GL_ATTRIBUTE_PURE
 gl_tree_size (gl_omap_t map)
 {
@@ -201,8 +218,13 @@ static void
 gl_tree_omap_free (gl_omap_t map)
   _GL_OMAP_INVOKES_FN_PTR
 {
-  /* Iterate across all elements in post-order.  */
-  gl_omap_node_t node = map->root;
+  /* Iterate across all elements in post-order.  When the nodes come from a
+     pool and need no disposal, there is no need to visit them.  */
+  gl_omap_node_t node =
+    (map->nodepool.enabled
+     && map->base.kdispose_fn == NULL && map->base.vdispose_fn == NULL
+     ? NULL
+     : map->root);
   iterstack_t stack;
   iterstack_item_t *stack_ptr = &stack[0];
 
@@ -232,7 +254,7 @@ gl_tree_omap_free (gl_omap_t map)
             map->base.vdispose_fn (node->value);
           if (map->base.kdispose_fn != NULL)
             map->base.kdispose_fn (node->key);
-          free (node);
+          gl_nodepool_free (&map->nodepool, node);
         }
       /* Descend on right branch.  */
       stack_ptr->rightp = true;
@@ -240,9 +262,46 @@ gl_tree_omap_free (gl_omap_t map)
       stack_ptr++;
     }
  done_iterate:
+  gl_nodepool_release (&map->nodepool);
   free (map);
 }
 
+static gl_omap_t
+gl_tree_nx_create (gl_omap_implementation_t implementation,
+                   gl_mapkey_compar_fn compar_fn,
+                   gl_mapkey_dispose_fn kdispose_fn,
+                   gl_mapvalue_dispose_fn vdispose_fn,
+                   size_t count, const void **keys, const void **values)
+{
+  gl_omap_t map =
+    gl_tree_nx_create_empty (implementation, compar_fn,
+                             kdispose_fn, vdispose_fn);
+
+  if (map == NULL)
+    return NULL;
+
+  /* Since KEYS is sorted, each pair is appended after the previous one.
+     No comparisons are needed, and the rebalancing after an append takes
+     amortized O(1) time.  */
+  gl_omap_node_t node = NULL;
+  for (size_t i = 0; i < count; i++)
+    {
+      node = (node == NULL
+              ? gl_tree_nx_add_first (map, keys[i], values[i])
+              : gl_tree_nx_add_after (map, node, keys[i], values[i]));
+      if (node == NULL)
+        {
+          /* The keys and values still belong to the caller.  */
+          map->base.kdispose_fn = NULL;
+          map->base.vdispose_fn = NULL;
+          gl_tree_omap_free (map);
+          return NULL;
+        }
+    }
+
+  return map;
+}
+
 /* --------------------- gl_omap_iterator_t Data Type --------------------- */
 
 static gl_omap_iterator_t _GL_ATTRIBUTE_PURE
@@ -43,10 +43,25 @@ gl_tree_nx_create_empty (gl_oset_implementation_t implementation,
   set->base.dispose_fn = dispose_fn;
   set->root = NULL;
   set->count = 0;
+  gl_nodepool_init (&set->nodepool, sizeof (struct gl_oset_node_impl), false);
 
   return set;
 }
 
+static gl_oset_t
+gl_tree_nx_create_empty_with_pool (gl_oset_implementation_t implementation,
+                                   gl_setelement_compar_fn compar_fn,
+                                   gl_setelement_dispose_fn dispose_fn)
+{
+  gl_oset_t set =
+    gl_tree_nx_create_empty (implementation, compar_fn, dispose_fn);
+
+  if (set != NULL)
+    gl_nodepool_init (&set->nodepool, sizeof (struct gl_oset_node_impl),
+                      true);
+  return set;
+}
+
 static size_t _GL_ATTRIBUTE_PURE
 gl_tree_size (gl_oset_t set)
 {
@@ -220,6 +235,139 @@ gl_tree_nx_add (gl_oset_t set, const void *elt)
     }
 }
 
+/* The bulk addition of k elements to a set of n elements descends from the
+   root for each element, in O(k log n) time, when k < n / BULK_MERGE_RATIO,
+   and otherwise merges the elements in a single O(n + k) walk through the
+   tree.  */
+#define BULK_MERGE_RATIO 16
+
+static int
+gl_tree_nx_add_sorted_array (gl_oset_t set,
+                             size_t count, const void **contents)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  gl_setelement_compar_fn compar = set->base.compar_fn;
+  size_t i = 0;
+  size_t used = 0;
+
+  if (count == 0)
+    return 0;
+
+  /* Allocate all nodes upfront, so that the set remains unchanged upon
+     out-of-memory.  In an empty set, the first element is added through
+     gl_tree_nx_add_first, as the last allocation.  */
+  if (set->root == NULL)
+    i = 1;
+  size_t n_nodes = count - i;
+  gl_oset_node_t *nodes =
+    (gl_oset_node_t *) malloc (n_nodes * sizeof (gl_oset_node_t));
+  if (nodes == NULL && n_nodes > 0)
+    return -1;
+  size_t n_allocated;
+  for (n_allocated = 0; n_allocated < n_nodes; n_allocated++)
+    {
+      nodes[n_allocated] =
+        (struct gl_oset_node_impl *) gl_nodepool_alloc (&set->nodepool);
+      if (nodes[n_allocated] == NULL)
+        goto fail;
+    }
+  if (i > 0 && gl_tree_nx_add_first (set, contents[0]) == NULL)
+    goto fail;
+
+  if (count - i < set->count / BULK_MERGE_RATIO)
+    {
+      /* Descend from the root for each element.  */
+      for (; i < count; i++)
+        {
+          const void *elt = contents[i];
+          gl_oset_node_t node = set->root;
+
+          for (;;)
+            {
+              int cmp = (compar != NULL
+                         ? compar (node->value, elt)
+                         : (node->value > elt ? 1 :
+                            node->value < elt ? -1 : 0));
+
+              if (cmp < 0)
+                {
+                  if (node->right == NULL)
+                    {
+                      gl_oset_node_t new_node = nodes[used++];
+                      new_node->value = elt;
+                      gl_tree_add_node_after (set, node, new_node);
+                      break;
+                    }
+                  node = node->right;
+                }
+              else if (cmp > 0)
+                {
+                  if (node->left == NULL)
+                    {
+                      gl_oset_node_t new_node = nodes[used++];
+                      new_node->value = elt;
+                      gl_tree_add_node_before (set, node, new_node);
+                      break;
+                    }
+                  node = node->left;
+                }
+              else /* cmp == 0 */
+                break;
+            }
+        }
+    }
+  else
+    {
+      /* Walk through the tree in order.  NODE is the first node whose value
+         is >= the previous element, or NULL if there is none.  */
+      gl_oset_node_t node;
+      gl_oset_node_t last;
+      for (node = set->root; node->left != NULL; )
+        node = node->left;
+      for (last = set->root; last->right != NULL; )
+        last = last->right;
+      for (; i < count; i++)
+        {
+          const void *elt = contents[i];
+          int cmp = 1;
+
+          while (node != NULL
+                 && (cmp = (compar != NULL
+                            ? compar (node->value, elt)
+                            : (node->value > elt ? 1 :
+                               node->value < elt ? -1 : 0)))
+                    < 0)
+            node = gl_tree_next_node (node);
+          if (node != NULL && cmp == 0)
+            /* ELT is already in the set.  */
+            continue;
+
+          gl_oset_node_t new_node = nodes[used++];
+          new_node->value = elt;
+          if (node != NULL)
+            gl_tree_add_node_before (set, node, new_node);
+          else
+            {
+              gl_tree_add_node_after (set, last, new_node);
+              last = new_node;
+            }
+          node = new_node;
+        }
+    }
+
+  /* Free the nodes that were not needed.  */
+  for (; used < n_nodes; used++)
+    gl_nodepool_free (&set->nodepool, nodes[used]);
+  free (nodes);
+  return 0;
+
+ fail:
+  for (size_t k = 0; k < n_allocated; k++)
+    gl_nodepool_free (&set->nodepool, nodes[k]);
+  free (nodes);
+  return -1;
+}
+
 static bool
 gl_tree_remove (gl_oset_t set, const void *elt)
 {
@@ -294,7 +442,7 @@ gl_tree_update (gl_oset_t set, const void *elt,
                     {
                       /* Two elements are the same.  */
                       NODE_PAYLOAD_DISPOSE (set, old_node)
-                      free (old_node);
+                      gl_nodepool_free (&set->nodepool, old_node);
                       return -1;
                     }
                 }
@@ -308,8 +456,10 @@ static void
 gl_tree_oset_free (gl_oset_t set)
   _GL_OSET_INVOKES_FN_PTR
 {
-  /* Iterate across all elements in post-order.  */
-  gl_oset_node_t node = set->root;
+  /* Iterate across all elements in post-order.  When the nodes come from a
+     pool and need no disposal, there is no need to visit them.  */
+  gl_oset_node_t node =
+    (set->nodepool.enabled && set->base.dispose_fn == NULL ? NULL : set->root);
   iterstack_t stack;
   iterstack_item_t *stack_ptr = &stack[0];
 
@@ -337,7 +487,7 @@ gl_tree_oset_free (gl_oset_t set)
           /* Free the current node.  */
           if (set->base.dispose_fn != NULL)
             set->base.dispose_fn (node->value);
-          free (node);
+          gl_nodepool_free (&set->nodepool, node);
         }
       /* Descend on right branch.  */
       stack_ptr->rightp = true;
@@ -345,9 +495,43 @@ gl_tree_oset_free (gl_oset_t set)
       stack_ptr++;
     }
  done_iterate:
+  gl_nodepool_release (&set->nodepool);
   free (set);
 }
 
+static gl_oset_t
+gl_tree_nx_create (gl_oset_implementation_t implementation,
+                   gl_setelement_compar_fn compar_fn,
+                   gl_setelement_dispose_fn dispose_fn,
+                   size_t count, const void **contents)
+{
+  gl_oset_t set =
+    gl_tree_nx_create_empty (implementation, compar_fn, dispose_fn);
+
+  if (set == NULL)
+    return NULL;
+
+  /* Since CONTENTS is sorted, each element is appended after the previous
+     one.  No comparisons are needed, and the rebalancing after an append
+     takes amortized O(1) time.  */
+  gl_oset_node_t node = NULL;
+  for (size_t i = 0; i < count; i++)
+    {
+      node = (node == NULL
+              ? gl_tree_nx_add_first (set, contents[i])
+              : gl_tree_nx_add_after (set, node, contents[i]));
+      if (node == NULL)
+        {
+          /* The elements still belong to the caller.  */
+          set->base.dispose_fn = NULL;
+          gl_tree_oset_free (set);
+          return NULL;
+        }
+    }
+
+  return set;
+}
+
 /* --------------------- gl_oset_iterator_t Data Type --------------------- */
 
 static gl_oset_iterator_t _GL_ATTRIBUTE_PURE
@@ -100,7 +100,7 @@ static int
 add_to_bucket (gl_list_t list, gl_list_node_t new_node)
   _GL_LIST_INVOKES_FN_PTR
 {
-  size_t bucket = new_node->h.hashcode % list->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (list, new_node->h.hashcode);
 
   /* If no duplicates are allowed, multiple nodes are not needed.  */
   if (list->base.allow_duplicates)
@@ -109,7 +109,7 @@ add_to_bucket (gl_list_t list, gl_list_node_t new_node)
       const void *value = new_node->value;
       gl_listelement_equals_fn equals = list->base.equals_fn;
 
-      for (gl_hash_entry_t *entryp = &list->table[bucket];
+      for (gl_hash_entry_t *entryp = bucket;
            *entryp != NULL;
            entryp = &(*entryp)->hash_next)
         {
@@ -169,8 +169,8 @@ add_to_bucket (gl_list_t list, gl_list_node_t new_node)
         }
     }
   /* If no duplicates are allowed, multiple nodes are not needed.  */
-  new_node->h.hash_next = list->table[bucket];
-  list->table[bucket] = &new_node->h;
+  new_node->h.hash_next = *bucket;
+  *bucket = &new_node->h;
   return 0;
 }
 /* Tell GCC that the likely return value is 0.  */
@@ -187,7 +187,7 @@ static void
 remove_from_bucket (gl_list_t list, gl_list_node_t old_node)
   _GL_LIST_INVOKES_FN_PTR
 {
-  size_t bucket = old_node->h.hashcode % list->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (list, old_node->h.hashcode);
 
   if (list->base.allow_duplicates)
     {
@@ -195,7 +195,7 @@ remove_from_bucket (gl_list_t list, gl_list_node_t old_node)
       const void *value = old_node->value;
       gl_listelement_equals_fn equals = list->base.equals_fn;
 
-      for (gl_hash_entry_t *entryp = &list->table[bucket]; ; entryp = &(*entryp)->hash_next)
+      for (gl_hash_entry_t *entryp = bucket; ; entryp = &(*entryp)->hash_next)
         {
           gl_hash_entry_t entry = *entryp;
 
@@ -239,7 +239,7 @@ remove_from_bucket (gl_list_t list, gl_list_node_t old_node)
   else
     {
       /* If no duplicates are allowed, multiple nodes are not needed.  */
-      for (gl_hash_entry_t *entryp = &list->table[bucket]; ; entryp = &(*entryp)->hash_next)
+      for (gl_hash_entry_t *entryp = bucket; ; entryp = &(*entryp)->hash_next)
         {
           if (*entryp == &old_node->h)
             {
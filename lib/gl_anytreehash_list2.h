@@ -31,12 +31,12 @@ gl_tree_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
       (list->base.hashcode_fn != NULL
        ? list->base.hashcode_fn (elt)
        : (size_t) {(uintptr_t) elt});
-    size_t bucket = hashcode % list->table_size;
+    gl_hash_entry_t *bucket = hash_bucket (list, hashcode);
     gl_listelement_equals_fn equals = list->base.equals_fn;
 
     if (list->base.allow_duplicates)
       {
-        for (gl_hash_entry_t entry = list->table[bucket]; entry != NULL; entry = entry->hash_next)
+        for (gl_hash_entry_t entry = *bucket; entry != NULL; entry = entry->hash_next)
           if (entry->hashcode == hashcode)
             {
               if (((struct gl_multiple_nodes *) entry)->magic == MULTIPLE_NODES_MAGIC)
@@ -101,7 +101,7 @@ gl_tree_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
     else
       {
         /* If no duplicates are allowed, multiple nodes are not needed.  */
-        for (gl_hash_entry_t entry = list->table[bucket]; entry != NULL; entry = entry->hash_next)
+        for (gl_hash_entry_t entry = *bucket; entry != NULL; entry = entry->hash_next)
           if (entry->hashcode == hashcode)
             {
               gl_list_node_t node = (struct gl_list_node_impl *) entry;
@@ -144,6 +144,8 @@ static void
 gl_tree_list_free (gl_list_t list)
   _GL_LIST_INVOKES_FN_PTR
 {
+  hash_migrate_all (list);
+
   if (list->base.allow_duplicates)
     {
       /* Free the ordered sets in the hash buckets.  */
@@ -168,9 +170,13 @@ gl_tree_list_free (gl_list_t list)
         }
     }
 
-  /* Iterate across all elements in post-order.  */
+  /* Iterate across all elements in post-order.  When the nodes come from a
+     pool and need no disposal, there is no need to visit them.  */
   {
-    gl_list_node_t node = list->root;
+    gl_list_node_t node =
+      (list->nodepool.enabled && list->base.dispose_fn == NULL
+       ? NULL
+       : list->root);
     iterstack_t stack;
     iterstack_item_t *stack_ptr = &stack[0];
 
@@ -198,7 +204,7 @@ gl_tree_list_free (gl_list_t list)
             /* Free the current node.  */
             if (list->base.dispose_fn != NULL)
               list->base.dispose_fn (node->value);
-            free (node);
+            gl_nodepool_free (&list->nodepool, node);
           }
         /* Descend on right branch.  */
         stack_ptr->rightp = true;
@@ -207,6 +213,7 @@ gl_tree_list_free (gl_list_t list)
       }
   }
  done_iterate:
+  gl_nodepool_release (&list->nodepool);
   free (list->table);
   free (list);
 }
@@ -22,7 +22,7 @@
 
 #include <stdint.h>
 #include <stdlib.h>
-/* Get memcpy.  */
+/* Get memcpy, memmove.  */
 #include <string.h>
 
 /* Checked size_t computations.  */
@@ -276,6 +276,32 @@ grow (gl_list_t list)
   return 0;
 }
 
+/* Ensure that list->allocated >= NEEDED.
+   Return 0 upon success, -1 upon out-of-memory.  */
+static int
+reserve (gl_list_t list, size_t needed)
+{
+  if (needed > list->allocated)
+    {
+      size_t new_allocated = xtimes (list->allocated, 2);
+      new_allocated = xsum (new_allocated, 1);
+      if (new_allocated < needed)
+        new_allocated = needed;
+      size_t memory_size = xtimes (new_allocated, sizeof (const void *));
+      if (size_overflow_p (memory_size))
+        /* Overflow, would lead to out of memory.  */
+        return -1;
+      const void **memory =
+        (const void **) realloc (list->elements, memory_size);
+      if (memory == NULL)
+        /* Out of memory.  */
+        return -1;
+      list->elements = memory;
+      list->allocated = new_allocated;
+    }
+  return 0;
+}
+
 static gl_list_node_t
 gl_array_nx_add_first (gl_list_t list, const void *elt)
 {
@@ -366,6 +392,28 @@ gl_array_nx_add_at (gl_list_t list, size_t position, const void *elt)
   return INDEX_TO_NODE (position);
 }
 
+static int
+gl_array_nx_add_all_at (gl_list_t list, size_t position,
+                        size_t count, const void **contents)
+{
+  size_t old_count = list->count;
+
+  if (!(position <= old_count))
+    /* Invalid argument.  */
+    abort ();
+  if (count > 0)
+    {
+      if (reserve (list, xsum (old_count, count)) < 0)
+        return -1;
+      const void **elements = list->elements;
+      memmove (elements + position + count, elements + position,
+               (old_count - position) * sizeof (const void *));
+      memcpy (elements + position, contents, count * sizeof (const void *));
+      list->count = old_count + count;
+    }
+  return 0;
+}
+
 static bool
 gl_array_remove_node (gl_list_t list, gl_list_node_t node)
   _GL_LIST_INVOKES_FN_PTR
@@ -404,6 +452,30 @@ gl_array_remove_at (gl_list_t list, size_t position)
   return true;
 }
 
+static void
+gl_array_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t count = list->count;
+
+  if (!(start_index <= end_index && end_index <= count))
+    /* Invalid arguments.  */
+    abort ();
+  if (start_index < end_index)
+    {
+      const void **elements = list->elements;
+      if (list->base.dispose_fn != NULL)
+        {
+          gl_listelement_dispose_fn dispose = list->base.dispose_fn;
+          for (size_t i = start_index; i < end_index; i++)
+            dispose (elements[i]);
+        }
+      memmove (elements + start_index, elements + end_index,
+               (count - end_index) * sizeof (const void *));
+      list->count = count - (end_index - start_index);
+    }
+}
+
 static bool
 gl_array_remove (gl_list_t list, const void *elt)
 {
@@ -560,11 +632,7 @@ gl_array_sortedlist_indexof_from_to (gl_list_t list,
                     /* The list was not sorted.  */
                     abort ();
                   else /* cmp2 == 0 */
-                    {
-                      if (mid2 == low)
-                        break;
-                      high = mid2 - 1;
-                    }
+                    high = mid2;
                 }
               return low;
             }
@@ -632,6 +700,38 @@ gl_array_sortedlist_nx_add (gl_list_t list, gl_listelement_compar_fn compar,
   return gl_array_nx_add_at (list, low, elt);
 }
 
+static int
+gl_array_sortedlist_nx_merge_array (gl_list_t list,
+                                    gl_listelement_compar_fn compar,
+                                    size_t count, const void **contents)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  if (count > 0)
+    {
+      size_t old_count = list->count;
+
+      if (reserve (list, xsum (old_count, count)) < 0)
+        return -1;
+      /* Merge from the end, so that every element of the list moves at most
+         once.  At each loop iteration, the elements at indices >= k are in
+         their final place, the elements at indices < i and CONTENTS[0..j-1]
+         remain to be merged, and i + j = k.  */
+      const void **elements = list->elements;
+      size_t i = old_count;
+      size_t j = count;
+      size_t k = old_count + count;
+      while (j > 0)
+        {
+          if (i > 0 && compar (elements[i - 1], contents[j - 1]) > 0)
+            elements[--k] = elements[--i];
+          else
+            elements[--k] = contents[--j];
+        }
+      list->count = old_count + count;
+    }
+  return 0;
+}
+
 static bool
 gl_array_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
                             const void *elt)
@@ -646,6 +746,7 @@ gl_array_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
 
 const struct gl_list_implementation gl_array_list_implementation =
   {
+    gl_array_nx_create_empty,
     gl_array_nx_create_empty,
     gl_array_nx_create,
     gl_array_size,
@@ -664,8 +765,10 @@ const struct gl_list_implementation gl_array_list_implementation =
     gl_array_nx_add_before,
     gl_array_nx_add_after,
     gl_array_nx_add_at,
+    gl_array_nx_add_all_at,
     gl_array_remove_node,
     gl_array_remove_at,
+    gl_array_remove_range,
     gl_array_remove,
     gl_array_list_free,
     gl_array_iterator,
@@ -677,5 +780,6 @@ const struct gl_list_implementation gl_array_list_implementation =
     gl_array_sortedlist_indexof,
     gl_array_sortedlist_indexof_from_to,
     gl_array_sortedlist_nx_add,
+    gl_array_sortedlist_nx_merge_array,
     gl_array_sortedlist_remove
   };
@@ -114,6 +114,23 @@ gl_array_search (gl_map_t map, const void *key, const void **valuep)
     return false;
 }
 
+static size_t
+gl_array_search_many (gl_map_t map, const void *const *keys, size_t n,
+                      const void **values, bool *found)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < n; i++)
+    {
+      bool match;
+      values[i] = NULL;
+      match = gl_array_search (map, keys[i], &values[i]);
+      if (found != NULL)
+        found[i] = match;
+      count += match;
+    }
+  return count;
+}
+
 /* Ensure that map->allocated > map->count.
    Return 0 upon success, -1 upon out-of-memory.  */
 static int
@@ -278,6 +295,7 @@ const struct gl_map_implementation gl_array_map_implementation =
     gl_array_nx_create_empty,
     gl_array_size,
     gl_array_search,
+    gl_array_search_many,
     gl_array_nx_getput,
     gl_array_getremove,
     gl_array_free,
@@ -68,6 +68,48 @@ gl_array_nx_create_empty (gl_omap_implementation_t implementation,
   return map;
 }
 
+static gl_omap_t
+gl_array_nx_create (gl_omap_implementation_t implementation,
+                    gl_mapkey_compar_fn compar_fn,
+                    gl_mapkey_dispose_fn kdispose_fn,
+                    gl_mapvalue_dispose_fn vdispose_fn,
+                    size_t count, const void **keys, const void **values)
+{
+  struct gl_omap_impl *map =
+    (struct gl_omap_impl *) malloc (sizeof (struct gl_omap_impl));
+
+  if (map == NULL)
+    return NULL;
+
+  map->base.vtable = implementation;
+  map->base.compar_fn = compar_fn;
+  map->base.kdispose_fn = kdispose_fn;
+  map->base.vdispose_fn = vdispose_fn;
+  if (count > 0)
+    {
+      if (size_overflow_p (xtimes (count, sizeof (struct pair))))
+        goto fail;
+      map->pairs = (struct pair *) malloc (count * sizeof (struct pair));
+      if (map->pairs == NULL)
+        goto fail;
+      for (size_t i = 0; i < count; i++)
+        {
+          map->pairs[i].key = keys[i];
+          map->pairs[i].value = values[i];
+        }
+    }
+  else
+    map->pairs = NULL;
+  map->count = count;
+  map->allocated = count;
+
+  return map;
+
+ fail:
+  free (map);
+  return NULL;
+}
+
 static size_t _GL_ATTRIBUTE_PURE
 gl_array_size (gl_omap_t map)
 {
@@ -374,6 +416,8 @@ gl_array_iterator_free (gl_omap_iterator_t *_GL_UNNAMED (iterator))
 const struct gl_omap_implementation gl_array_omap_implementation =
   {
     gl_array_nx_create_empty,
+    gl_array_nx_create_empty,
+    gl_array_nx_create,
     gl_array_size,
     gl_array_search,
     gl_array_search_atleast,
@@ -21,6 +21,8 @@
 #include "gl_array_oset.h"
 
 #include <stdlib.h>
+/* Get memcpy, memmove.  */
+#include <string.h>
 
 /* Checked size_t computations.  */
 #include "xsize.h"
@@ -60,6 +62,42 @@ gl_array_nx_create_empty (gl_oset_implementation_t implementation,
   return set;
 }
 
+static gl_oset_t
+gl_array_nx_create (gl_oset_implementation_t implementation,
+                    gl_setelement_compar_fn compar_fn,
+                    gl_setelement_dispose_fn dispose_fn,
+                    size_t count, const void **contents)
+{
+  struct gl_oset_impl *set =
+    (struct gl_oset_impl *) malloc (sizeof (struct gl_oset_impl));
+
+  if (set == NULL)
+    return NULL;
+
+  set->base.vtable = implementation;
+  set->base.compar_fn = compar_fn;
+  set->base.dispose_fn = dispose_fn;
+  if (count > 0)
+    {
+      if (size_overflow_p (xtimes (count, sizeof (const void *))))
+        goto fail;
+      set->elements = (const void **) malloc (count * sizeof (const void *));
+      if (set->elements == NULL)
+        goto fail;
+      memcpy (set->elements, contents, count * sizeof (const void *));
+    }
+  else
+    set->elements = NULL;
+  set->count = count;
+  set->allocated = count;
+
+  return set;
+
+ fail:
+  free (set);
+  return NULL;
+}
+
 static size_t _GL_ATTRIBUTE_PURE
 gl_array_size (gl_oset_t set)
 {
@@ -270,6 +308,71 @@ gl_array_nx_add (gl_oset_t set, const void *elt)
   return gl_array_nx_add_at (set, low, elt);
 }
 
+static int
+gl_array_nx_add_sorted_array (gl_oset_t set,
+                              size_t count, const void **contents)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  if (count == 0)
+    return 0;
+
+  size_t old_count = set->count;
+  size_t needed = xsum (old_count, count);
+  if (needed > set->allocated)
+    {
+      size_t new_allocated = xsum (xtimes (set->allocated, 2), 1);
+      if (new_allocated < needed)
+        new_allocated = needed;
+      size_t memory_size = xtimes (new_allocated, sizeof (const void *));
+      if (size_overflow_p (memory_size))
+        /* Overflow, would lead to out of memory.  */
+        return -1;
+      const void **memory =
+        (const void **) realloc (set->elements, memory_size);
+      if (memory == NULL)
+        /* Out of memory.  */
+        return -1;
+      set->elements = memory;
+      set->allocated = new_allocated;
+    }
+
+  /* Merge from the end, so that each element is moved only once.  The
+     merged elements end up at indices >= i, with a gap of the skipped
+     elements before them.  */
+  gl_setelement_compar_fn compar = set->base.compar_fn;
+  const void **elements = set->elements;
+  size_t i = old_count;
+  size_t j = count;
+  size_t dst = needed;
+  while (j > 0)
+    {
+      const void *elt = contents[j - 1];
+      int cmp = (i == 0 ? -1 :
+                 compar != NULL
+                 ? compar (elements[i - 1], elt)
+                 : (elements[i - 1] > elt ? 1 :
+                    elements[i - 1] < elt ? -1 : 0));
+      if (cmp > 0)
+        elements[--dst] = elements[--i];
+      else
+        {
+          j--;
+          /* Skip ELT if it is already in the set or was just added.  */
+          if (cmp < 0
+              && !(dst < needed
+                   && (compar != NULL
+                       ? compar (elements[dst], elt) == 0
+                       : elements[dst] == elt)))
+            elements[--dst] = elt;
+        }
+    }
+  if (dst > i)
+    memmove (elements + i, elements + dst,
+             (needed - dst) * sizeof (const void *));
+  set->count = needed - (dst - i);
+  return 0;
+}
+
 static bool
 gl_array_remove (gl_oset_t set, const void *elt)
 {
@@ -492,10 +595,13 @@ gl_array_iterator_free (gl_oset_iterator_t *_GL_UNNAMED (iterator))
 const struct gl_oset_implementation gl_array_oset_implementation =
   {
     gl_array_nx_create_empty,
+    gl_array_nx_create_empty,
+    gl_array_nx_create,
     gl_array_size,
     gl_array_search,
     gl_array_search_atleast,
     gl_array_nx_add,
+    gl_array_nx_add_sorted_array,
     gl_array_remove,
     gl_array_update,
     gl_array_free,
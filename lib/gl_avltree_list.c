@@ -21,6 +21,12 @@
 #include "gl_avltree_list.h"
 
 #include <stdlib.h>
+/* Get memmove.  */
+#include <string.h>
+
+#include "gl_nodepool.h"
+/* Checked size_t computations.  */
+#include "xsize.h"
 
 /* -------------------------- gl_list_t Data Type -------------------------- */
 
@@ -70,6 +76,7 @@ gl_avltree_list_check_invariants (gl_list_t list)
 const struct gl_list_implementation gl_avltree_list_implementation =
   {
     gl_tree_nx_create_empty,
+    gl_tree_nx_create_empty_with_pool,
     gl_tree_nx_create,
     gl_tree_size,
     gl_tree_node_value,
@@ -87,8 +94,10 @@ const struct gl_list_implementation gl_avltree_list_implementation =
     gl_tree_nx_add_before,
     gl_tree_nx_add_after,
     gl_tree_nx_add_at,
+    gl_tree_nx_add_all_at,
     gl_tree_remove_node,
     gl_tree_remove_at,
+    gl_tree_remove_range,
     gl_tree_remove,
     gl_tree_list_free,
     gl_tree_iterator,
@@ -100,5 +109,6 @@ const struct gl_list_implementation gl_avltree_list_implementation =
     gl_tree_sortedlist_indexof,
     gl_tree_sortedlist_indexof_from_to,
     gl_tree_sortedlist_nx_add,
+    gl_tree_sortedlist_nx_merge_array,
     gl_tree_sortedlist_remove
   };
@@ -22,6 +22,8 @@
 
 #include <stdlib.h>
 
+#include "gl_nodepool.h"
+
 /* -------------------------- gl_omap_t Data Type -------------------------- */
 
 /* Parameterization of gl_avltree_ordered.h.  */
@@ -62,6 +64,8 @@ gl_avltree_omap_check_invariants (gl_omap_t map)
 const struct gl_omap_implementation gl_avltree_omap_implementation =
   {
     gl_tree_nx_create_empty,
+    gl_tree_nx_create_empty_with_pool,
+    gl_tree_nx_create,
     gl_tree_size,
     gl_tree_search,
     gl_tree_search_atleast,
@@ -0,0 +1,1433 @@
+/* Sequential list data type implemented by a B+ tree.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "gl_btree_list.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+/* Get memcpy, memmove.  */
+#include <string.h>
+
+/* Checked size_t computations.  */
+#include "xsize.h"
+
+/* A B+ tree is a tree where
+   1. The elements are stored in the leaves, in order, as contiguous arrays
+      of up to LEAF_CAPACITY elements.  The leaves are chained from left to
+      right.
+   2. A branch has up to BRANCH_CAPACITY children, and records the number of
+      elements in each of them.
+   3. All leaves are at the same depth, list->height.
+   4. Every branch, except the root, has at least BRANCH_MIN children.  The
+      root, if it is a branch, has at least 2 children.
+   5. Every leaf, except the root and the last leaf, has at least LEAF_MIN
+      elements.  The last leaf is left sparse when elements are appended,
+      so that a list built by gl_list_add_last has full leaves.
+
+   Compared to a binary tree, which has one node of 5 words per element, a
+   B+ tree needs a little more than one word per element, and walking
+   through the elements in order mostly means incrementing a pointer.  */
+
+/* The capacities are chosen so that a leaf and a branch fill a malloc block
+   of 512 bytes on 64-bit platforms.  */
+#define LEAF_CAPACITY 60
+#define LEAF_MIN (LEAF_CAPACITY / 2)
+#define BRANCH_CAPACITY 30
+#define BRANCH_MIN (BRANCH_CAPACITY / 2)
+
+/* A B+ tree of height h >= 1 has at least
+   (2 * BRANCH_MIN^(h-1) - 1) * LEAF_MIN elements.  So, h <= 15 (because a
+   tree of height h >= 16 would have more than 2 * 15^15 * 30 - 30 > 2^64
+   elements, which would exceed the address space of the machine).  */
+#define MAXHEIGHT 16
+
+/* -------------------------- gl_list_t Data Type -------------------------- */
+
+struct btree_leaf
+{
+  struct btree_leaf *next;          /* next leaf, or NULL */
+  unsigned int count;               /* number of used elements */
+  const void *elements[LEAF_CAPACITY];
+};
+
+struct btree_branch
+{
+  unsigned int count;               /* number of children */
+  size_t sizes[BRANCH_CAPACITY];    /* number of elements in each child */
+  void *children[BRANCH_CAPACITY];  /* a struct btree_branch * or
+                                       struct btree_leaf * each */
+};
+
+/* Concrete gl_list_impl type, valid for this file only.  */
+struct gl_list_impl
+{
+  struct gl_list_impl_base base;
+  void *root;                       /* root leaf or branch, or NULL */
+  unsigned int height;              /* number of branch levels */
+  size_t count;                     /* number of elements */
+};
+
+/* struct gl_list_node_impl doesn't exist here.  The pointers are actually
+   indices + 1.  */
+#define INDEX_TO_NODE(index) (gl_list_node_t)(uintptr_t) {(index) + 1}
+#define NODE_TO_INDEX(node) ((uintptr_t)(node) - 1)
+
+/* A step in the descent from the root to a leaf.  */
+struct btree_path
+{
+  struct btree_branch *branch;
+  unsigned int index;               /* index of the child in the branch */
+};
+
+/* Returns the leaf that contains the element at POSITION, or - if
+   POSITION = list->count > 0 - the last leaf.  Stores the index of POSITION
+   in the leaf in *OFFSETP.  If PATH is not NULL, stores the branches on the
+   way from the root in PATH[0..list->height-1].  */
+static struct btree_leaf *
+locate (gl_list_t list, size_t position, struct btree_path *path,
+        size_t *offsetp)
+{
+  void *node = list->root;
+  size_t total = list->count;
+
+  for (unsigned int level = 0; level < list->height; level++)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      unsigned int k;
+
+      /* Scan the children from the nearer end.  */
+      if (position < total / 2)
+        {
+          unsigned int last = branch->count - 1;
+          for (k = 0; k < last && position >= branch->sizes[k]; k++)
+            position -= branch->sizes[k];
+        }
+      else
+        {
+          /* The number of elements at POSITION and after it.  */
+          size_t rest = total - position;
+          for (k = branch->count - 1; k > 0 && rest > branch->sizes[k]; k--)
+            rest -= branch->sizes[k];
+          position = branch->sizes[k] - rest;
+        }
+      total = branch->sizes[k];
+      if (path != NULL)
+        {
+          path[level].branch = branch;
+          path[level].index = k;
+        }
+      node = branch->children[k];
+    }
+  *offsetp = position;
+  return (struct btree_leaf *) node;
+}
+
+/* Frees the subtree rooted at NODE, of the given HEIGHT.  */
+static void
+free_subtree (void *node, unsigned int height)
+{
+  if (height > 0)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      for (unsigned int k = 0; k < branch->count; k++)
+        free_subtree (branch->children[k], height - 1);
+    }
+  free (node);
+}
+
+/* Fills LIST with the COUNT elements of CONTENTS, with leaves and branches
+   evenly filled.  Return 0 upon success, -1 upon out-of-memory.  */
+static int
+build (gl_list_t list, size_t count, const void **contents)
+{
+  list->root = NULL;
+  list->height = 0;
+  list->count = 0;
+  if (count == 0)
+    return 0;
+
+  size_t n = (count - 1) / LEAF_CAPACITY + 1;
+  if (size_overflow_p (xtimes (n, sizeof (void *) + sizeof (size_t))))
+    return -1;
+  void **nodes = (void **) malloc (n * sizeof (void *));
+  size_t *sizes = (size_t *) malloc (n * sizeof (size_t));
+  if (nodes == NULL || sizes == NULL)
+    goto fail1;
+
+  /* Create the leaves.  */
+  {
+    struct btree_leaf *previous = NULL;
+    for (size_t i = 0; i < n; i++)
+      {
+        struct btree_leaf *leaf =
+          (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+        if (leaf == NULL)
+          {
+            for (size_t i2 = 0; i2 < i; i2++)
+              free (nodes[i2]);
+            goto fail1;
+          }
+        unsigned int leaf_count = count / n + (i < count % n);
+        memcpy (leaf->elements, contents, leaf_count * sizeof (const void *));
+        contents += leaf_count;
+        leaf->count = leaf_count;
+        leaf->next = NULL;
+        if (previous != NULL)
+          previous->next = leaf;
+        previous = leaf;
+        nodes[i] = leaf;
+        sizes[i] = leaf_count;
+      }
+  }
+
+  /* Create the branches, one level at a time.  */
+  unsigned int height = 0;
+  while (n > 1)
+    {
+      size_t n_branches = (n - 1) / BRANCH_CAPACITY + 1;
+      size_t i = 0;
+      for (size_t j = 0; j < n_branches; j++)
+        {
+          struct btree_branch *branch =
+            (struct btree_branch *) malloc (sizeof (struct btree_branch));
+          if (branch == NULL)
+            {
+              for (size_t j2 = 0; j2 < j; j2++)
+                free_subtree (nodes[j2], height + 1);
+              for (; i < n; i++)
+                free_subtree (nodes[i], height);
+              goto fail1;
+            }
+          unsigned int branch_count = n / n_branches + (j < n % n_branches);
+          size_t branch_size = 0;
+          for (unsigned int k = 0; k < branch_count; k++, i++)
+            {
+              branch->children[k] = nodes[i];
+              branch->sizes[k] = sizes[i];
+              branch_size += sizes[i];
+            }
+          branch->count = branch_count;
+          /* Here j < i, therefore this doesn't overwrite unread entries.  */
+          nodes[j] = branch;
+          sizes[j] = branch_size;
+        }
+      height++;
+      n = n_branches;
+    }
+
+  list->root = nodes[0];
+  list->height = height;
+  list->count = sizes[0];
+  free (sizes);
+  free (nodes);
+  return 0;
+
+ fail1:
+  free (sizes);
+  free (nodes);
+  return -1;
+}
+
+static gl_list_t
+gl_btree_nx_create_empty (gl_list_implementation_t implementation,
+                          gl_listelement_equals_fn equals_fn,
+                          gl_listelement_hashcode_fn hashcode_fn,
+                          gl_listelement_dispose_fn dispose_fn,
+                          bool allow_duplicates)
+{
+  struct gl_list_impl *list =
+    (struct gl_list_impl *) malloc (sizeof (struct gl_list_impl));
+
+  if (list == NULL)
+    return NULL;
+
+  list->base.vtable = implementation;
+  list->base.equals_fn = equals_fn;
+  list->base.hashcode_fn = hashcode_fn;
+  list->base.dispose_fn = dispose_fn;
+  list->base.allow_duplicates = allow_duplicates;
+  list->root = NULL;
+  list->height = 0;
+  list->count = 0;
+
+  return list;
+}
+
+static gl_list_t
+gl_btree_nx_create (gl_list_implementation_t implementation,
+                    gl_listelement_equals_fn equals_fn,
+                    gl_listelement_hashcode_fn hashcode_fn,
+                    gl_listelement_dispose_fn dispose_fn,
+                    bool allow_duplicates,
+                    size_t count, const void **contents)
+{
+  struct gl_list_impl *list =
+    (struct gl_list_impl *) malloc (sizeof (struct gl_list_impl));
+
+  if (list == NULL)
+    return NULL;
+
+  list->base.vtable = implementation;
+  list->base.equals_fn = equals_fn;
+  list->base.hashcode_fn = hashcode_fn;
+  list->base.dispose_fn = dispose_fn;
+  list->base.allow_duplicates = allow_duplicates;
+  if (build (list, count, contents) < 0)
+    goto fail;
+
+  return list;
+
+ fail:
+  free (list);
+  return NULL;
+}
+
+static size_t _GL_ATTRIBUTE_PURE
+gl_btree_size (gl_list_t list)
+{
+  return list->count;
+}
+
+static const void * _GL_ATTRIBUTE_PURE
+gl_btree_get_at (gl_list_t list, size_t position)
+{
+  if (!(position < list->count))
+    /* Invalid argument.  */
+    abort ();
+  size_t offset;
+  struct btree_leaf *leaf = locate (list, position, NULL, &offset);
+  return leaf->elements[offset];
+}
+
+static gl_list_node_t
+gl_btree_nx_set_at (gl_list_t list, size_t position, const void *elt)
+{
+  if (!(position < list->count))
+    /* Invalid argument.  */
+    abort ();
+  size_t offset;
+  struct btree_leaf *leaf = locate (list, position, NULL, &offset);
+  leaf->elements[offset] = elt;
+  return INDEX_TO_NODE (position);
+}
+
+static const void * _GL_ATTRIBUTE_PURE
+gl_btree_node_value (gl_list_t list, gl_list_node_t node)
+{
+  return gl_btree_get_at (list, NODE_TO_INDEX (node));
+}
+
+static int
+gl_btree_node_nx_set_value (gl_list_t list, gl_list_node_t node,
+                            const void *elt)
+{
+  gl_btree_nx_set_at (list, NODE_TO_INDEX (node), elt);
+  return 0;
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_next_node (gl_list_t list, gl_list_node_t node)
+{
+  uintptr_t index = NODE_TO_INDEX (node);
+  if (!(index < list->count))
+    /* Invalid argument.  */
+    abort ();
+  index++;
+  if (index < list->count)
+    return INDEX_TO_NODE (index);
+  else
+    return NULL;
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_previous_node (gl_list_t list, gl_list_node_t node)
+{
+  uintptr_t index = NODE_TO_INDEX (node);
+  if (!(index < list->count))
+    /* Invalid argument.  */
+    abort ();
+  if (index > 0)
+    return INDEX_TO_NODE (index - 1);
+  else
+    return NULL;
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_first_node (gl_list_t list)
+{
+  if (list->count > 0)
+    return INDEX_TO_NODE (0);
+  else
+    return NULL;
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_last_node (gl_list_t list)
+{
+  if (list->count > 0)
+    return INDEX_TO_NODE (list->count - 1);
+  else
+    return NULL;
+}
+
+static size_t _GL_ATTRIBUTE_PURE
+gl_btree_indexof_from_to (gl_list_t list, size_t start_index, size_t end_index,
+                          const void *elt)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  if (!(start_index <= end_index && end_index <= list->count))
+    /* Invalid arguments.  */
+    abort ();
+
+  if (start_index < end_index)
+    {
+      gl_listelement_equals_fn equals = list->base.equals_fn;
+      size_t offset;
+      struct btree_leaf *leaf = locate (list, start_index, NULL, &offset);
+      size_t index = start_index;
+
+      for (;;)
+        {
+          /* Search among the elements OFFSET..END-1 of LEAF.  */
+          size_t end = leaf->count;
+          if (end - offset > end_index - index)
+            end = offset + (end_index - index);
+          const void **elements = leaf->elements;
+
+          if (equals != NULL)
+            {
+              for (size_t i = offset; i < end; i++)
+                if (equals (elt, elements[i]))
+                  return index + (i - offset);
+            }
+          else
+            {
+              for (size_t i = offset; i < end; i++)
+                if (elt == elements[i])
+                  return index + (i - offset);
+            }
+          index += end - offset;
+          if (index == end_index)
+            break;
+          leaf = leaf->next;
+          offset = 0;
+        }
+    }
+  return (size_t)(-1);
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
+                         const void *elt)
+{
+  size_t index = gl_btree_indexof_from_to (list, start_index, end_index, elt);
+  return INDEX_TO_NODE (index);
+}
+
+/* Inserts ELT at position OFFSET in the full leaf LEAF, distributing the
+   LEAF_CAPACITY + 1 elements among LEAF and the fresh leaf NEW_LEAF, which
+   follows it.  If AT_END, LEAF is the last leaf and ELT is being appended:
+   leave LEAF full then.  */
+static void
+split_leaf (struct btree_leaf *leaf, struct btree_leaf *new_leaf,
+            size_t offset, const void *elt, bool at_end)
+{
+  const void *elements[LEAF_CAPACITY + 1];
+  memcpy (elements, leaf->elements, offset * sizeof (const void *));
+  elements[offset] = elt;
+  memcpy (elements + offset + 1, leaf->elements + offset,
+          (LEAF_CAPACITY - offset) * sizeof (const void *));
+
+  unsigned int left = (at_end ? LEAF_CAPACITY : (LEAF_CAPACITY + 1) / 2);
+  memcpy (leaf->elements, elements, left * sizeof (const void *));
+  memcpy (new_leaf->elements, elements + left,
+          (LEAF_CAPACITY + 1 - left) * sizeof (const void *));
+  leaf->count = left;
+  new_leaf->count = LEAF_CAPACITY + 1 - left;
+  new_leaf->next = leaf->next;
+  leaf->next = new_leaf;
+}
+
+/* Inserts the child CHILD, with SIZE elements, at position K in the full
+   branch BRANCH, distributing the BRANCH_CAPACITY + 1 children evenly among
+   BRANCH and the fresh branch NEW_BRANCH.  */
+static void
+split_branch (struct btree_branch *branch, struct btree_branch *new_branch,
+              unsigned int k, void *child, size_t size)
+{
+  void *children[BRANCH_CAPACITY + 1];
+  size_t sizes[BRANCH_CAPACITY + 1];
+  memcpy (children, branch->children, k * sizeof (void *));
+  memcpy (sizes, branch->sizes, k * sizeof (size_t));
+  children[k] = child;
+  sizes[k] = size;
+  memcpy (children + k + 1, branch->children + k,
+          (BRANCH_CAPACITY - k) * sizeof (void *));
+  memcpy (sizes + k + 1, branch->sizes + k,
+          (BRANCH_CAPACITY - k) * sizeof (size_t));
+
+  unsigned int left = (BRANCH_CAPACITY + 1) / 2;
+  memcpy (branch->children, children, left * sizeof (void *));
+  memcpy (branch->sizes, sizes, left * sizeof (size_t));
+  memcpy (new_branch->children, children + left,
+          (BRANCH_CAPACITY + 1 - left) * sizeof (void *));
+  memcpy (new_branch->sizes, sizes + left,
+          (BRANCH_CAPACITY + 1 - left) * sizeof (size_t));
+  branch->count = left;
+  new_branch->count = BRANCH_CAPACITY + 1 - left;
+}
+
+/* Returns the number of elements in BRANCH.  */
+static size_t _GL_ATTRIBUTE_PURE
+branch_size (struct btree_branch *branch)
+{
+  size_t size = 0;
+  for (unsigned int k = 0; k < branch->count; k++)
+    size += branch->sizes[k];
+  return size;
+}
+
+static gl_list_node_t
+gl_btree_nx_add_at (gl_list_t list, size_t position, const void *elt)
+{
+  size_t count = list->count;
+
+  if (!(position <= count))
+    /* Invalid argument.  */
+    abort ();
+
+  if (count == 0)
+    {
+      struct btree_leaf *leaf =
+        (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+      if (leaf == NULL)
+        return NULL;
+      leaf->next = NULL;
+      leaf->count = 1;
+      leaf->elements[0] = elt;
+      list->root = leaf;
+      list->height = 0;
+      list->count = 1;
+      return INDEX_TO_NODE (0);
+    }
+
+  unsigned int height = list->height;
+  struct btree_path path[MAXHEIGHT];
+  size_t offset;
+  struct btree_leaf *leaf = locate (list, position, path, &offset);
+
+  if (leaf->count < LEAF_CAPACITY)
+    {
+      /* Fast path: there is room in the leaf.  */
+      memmove (leaf->elements + offset + 1, leaf->elements + offset,
+               (leaf->count - offset) * sizeof (const void *));
+      leaf->elements[offset] = elt;
+      leaf->count++;
+      for (unsigned int level = 0; level < height; level++)
+        path[level].branch->sizes[path[level].index]++;
+    }
+  else
+    {
+      /* The leaf needs to be split, and so does every full branch above it.
+         Allocate all new nodes first, so that an allocation failure leaves
+         the list unmodified.  */
+      unsigned int full = 0;
+      while (full < height
+             && path[height - 1 - full].branch->count == BRANCH_CAPACITY)
+        full++;
+      /* If all branches are full, a new root is needed as well.  */
+      unsigned int n_branches = full + (full == height);
+      if (full == height && height + 1 > MAXHEIGHT)
+        return NULL;
+
+      struct btree_leaf *new_leaf =
+        (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+      if (new_leaf == NULL)
+        return NULL;
+      struct btree_branch *new_branches[MAXHEIGHT];
+      for (unsigned int i = 0; i < n_branches; i++)
+        {
+          new_branches[i] =
+            (struct btree_branch *) malloc (sizeof (struct btree_branch));
+          if (new_branches[i] == NULL)
+            {
+              while (i > 0)
+                free (new_branches[--i]);
+              free (new_leaf);
+              return NULL;
+            }
+        }
+
+      split_leaf (leaf, new_leaf, offset, elt, position == count);
+
+      /* Insert the new node into the parent, splitting as needed.  */
+      void *left_node = leaf;
+      size_t left_size = leaf->count;
+      void *new_node = new_leaf;
+      size_t new_size = new_leaf->count;
+      unsigned int level = height;
+      while (new_node != NULL && level > 0)
+        {
+          level--;
+          struct btree_branch *branch = path[level].branch;
+          unsigned int k = path[level].index;
+
+          branch->sizes[k] = left_size;
+          if (branch->count < BRANCH_CAPACITY)
+            {
+              memmove (branch->children + k + 2, branch->children + k + 1,
+                       (branch->count - k - 1) * sizeof (void *));
+              memmove (branch->sizes + k + 2, branch->sizes + k + 1,
+                       (branch->count - k - 1) * sizeof (size_t));
+              branch->children[k + 1] = new_node;
+              branch->sizes[k + 1] = new_size;
+              branch->count++;
+              new_node = NULL;
+            }
+          else
+            {
+              struct btree_branch *new_branch = new_branches[--n_branches];
+              split_branch (branch, new_branch, k + 1, new_node, new_size);
+              left_node = branch;
+              left_size = branch_size (branch);
+              new_node = new_branch;
+              new_size = branch_size (new_branch);
+            }
+        }
+      if (new_node != NULL)
+        {
+          /* The root was split.  */
+          struct btree_branch *root = new_branches[--n_branches];
+          root->count = 2;
+          root->children[0] = left_node;
+          root->sizes[0] = left_size;
+          root->children[1] = new_node;
+          root->sizes[1] = new_size;
+          list->root = root;
+          list->height = height + 1;
+        }
+      else
+        {
+          /* The branches above LEVEL just got one more element.  */
+          while (level > 0)
+            {
+              level--;
+              path[level].branch->sizes[path[level].index]++;
+            }
+        }
+    }
+  list->count = count + 1;
+  return INDEX_TO_NODE (position);
+}
+
+static gl_list_node_t
+gl_btree_nx_add_first (gl_list_t list, const void *elt)
+{
+  return gl_btree_nx_add_at (list, 0, elt);
+}
+
+static gl_list_node_t
+gl_btree_nx_add_last (gl_list_t list, const void *elt)
+{
+  return gl_btree_nx_add_at (list, list->count, elt);
+}
+
+static gl_list_node_t
+gl_btree_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
+{
+  uintptr_t index = NODE_TO_INDEX (node);
+  if (!(index < list->count))
+    /* Invalid argument.  */
+    abort ();
+  return gl_btree_nx_add_at (list, index, elt);
+}
+
+static gl_list_node_t
+gl_btree_nx_add_after (gl_list_t list, gl_list_node_t node, const void *elt)
+{
+  uintptr_t index = NODE_TO_INDEX (node);
+  if (!(index < list->count))
+    /* Invalid argument.  */
+    abort ();
+  return gl_btree_nx_add_at (list, index + 1, elt);
+}
+
+/* Merges or rebalances the leaves at positions K and K + 1 of PARENT.  */
+static void
+rebalance_leaves (struct btree_branch *parent, unsigned int k)
+{
+  struct btree_leaf *left = (struct btree_leaf *) parent->children[k];
+  struct btree_leaf *right = (struct btree_leaf *) parent->children[k + 1];
+  unsigned int total = left->count + right->count;
+
+  if (total <= LEAF_CAPACITY)
+    {
+      /* Merge RIGHT into LEFT.  */
+      memcpy (left->elements + left->count, right->elements,
+              right->count * sizeof (const void *));
+      left->count = total;
+      left->next = right->next;
+      free (right);
+      parent->sizes[k] = total;
+      memmove (parent->children + k + 1, parent->children + k + 2,
+               (parent->count - k - 2) * sizeof (void *));
+      memmove (parent->sizes + k + 1, parent->sizes + k + 2,
+               (parent->count - k - 2) * sizeof (size_t));
+      parent->count--;
+    }
+  else
+    {
+      /* Move elements, so that both leaves have at least LEAF_MIN.  */
+      unsigned int new_left = total / 2;
+      if (left->count > new_left)
+        {
+          unsigned int n = left->count - new_left;
+          memmove (right->elements + n, right->elements,
+                   right->count * sizeof (const void *));
+          memcpy (right->elements, left->elements + new_left,
+                  n * sizeof (const void *));
+        }
+      else
+        {
+          unsigned int n = new_left - left->count;
+          memcpy (left->elements + left->count, right->elements,
+                  n * sizeof (const void *));
+          memmove (right->elements, right->elements + n,
+                   (right->count - n) * sizeof (const void *));
+        }
+      left->count = new_left;
+      right->count = total - new_left;
+      parent->sizes[k] = left->count;
+      parent->sizes[k + 1] = right->count;
+    }
+}
+
+/* Merges or rebalances the branches at positions K and K + 1 of PARENT.  */
+static void
+rebalance_branches (struct btree_branch *parent, unsigned int k)
+{
+  struct btree_branch *left = (struct btree_branch *) parent->children[k];
+  struct btree_branch *right = (struct btree_branch *) parent->children[k + 1];
+  unsigned int total = left->count + right->count;
+
+  if (total <= BRANCH_CAPACITY)
+    {
+      /* Merge RIGHT into LEFT.  */
+      memcpy (left->children + left->count, right->children,
+              right->count * sizeof (void *));
+      memcpy (left->sizes + left->count, right->sizes,
+              right->count * sizeof (size_t));
+      left->count = total;
+      free (right);
+      parent->sizes[k] += parent->sizes[k + 1];
+      memmove (parent->children + k + 1, parent->children + k + 2,
+               (parent->count - k - 2) * sizeof (void *));
+      memmove (parent->sizes + k + 1, parent->sizes + k + 2,
+               (parent->count - k - 2) * sizeof (size_t));
+      parent->count--;
+    }
+  else
+    {
+      /* Move children, so that both branches have at least BRANCH_MIN.  */
+      unsigned int new_left = total / 2;
+      size_t moved = 0;
+      if (left->count > new_left)
+        {
+          unsigned int n = left->count - new_left;
+          memmove (right->children + n, right->children,
+                   right->count * sizeof (void *));
+          memmove (right->sizes + n, right->sizes,
+                   right->count * sizeof (size_t));
+          memcpy (right->children, left->children + new_left,
+                  n * sizeof (void *));
+          memcpy (right->sizes, left->sizes + new_left, n * sizeof (size_t));
+          for (unsigned int i = 0; i < n; i++)
+            moved += right->sizes[i];
+          parent->sizes[k] -= moved;
+          parent->sizes[k + 1] += moved;
+        }
+      else
+        {
+          unsigned int n = new_left - left->count;
+          memcpy (left->children + left->count, right->children,
+                  n * sizeof (void *));
+          memcpy (left->sizes + left->count, right->sizes,
+                  n * sizeof (size_t));
+          for (unsigned int i = 0; i < n; i++)
+            moved += right->sizes[i];
+          memmove (right->children, right->children + n,
+                   (right->count - n) * sizeof (void *));
+          memmove (right->sizes, right->sizes + n,
+                   (right->count - n) * sizeof (size_t));
+          parent->sizes[k] += moved;
+          parent->sizes[k + 1] -= moved;
+        }
+      left->count = new_left;
+      right->count = total - new_left;
+    }
+}
+
+/* Removes the element at POSITION < list->count from LIST, without
+   disposing it.  Returns the element.  */
+static const void *
+remove_element (gl_list_t list, size_t position)
+{
+  size_t count = list->count;
+  unsigned int height = list->height;
+  struct btree_path path[MAXHEIGHT];
+  size_t offset;
+  struct btree_leaf *leaf = locate (list, position, path, &offset);
+  const void *elt = leaf->elements[offset];
+
+  memmove (leaf->elements + offset, leaf->elements + offset + 1,
+           (leaf->count - offset - 1) * sizeof (const void *));
+  leaf->count--;
+  for (unsigned int level = 0; level < height; level++)
+    path[level].branch->sizes[path[level].index]--;
+
+  /* Fix underflows, from the leaf upwards.  */
+  {
+    unsigned int level = height;
+    unsigned int node_count = leaf->count;
+    unsigned int node_min = LEAF_MIN;
+    while (level > 0 && node_count < node_min)
+      {
+        level--;
+        struct btree_branch *parent = path[level].branch;
+        unsigned int k = path[level].index;
+        /* Combine the child with its right sibling, or - for the last
+           child - with its left sibling.  */
+        if (k == parent->count - 1)
+          k--;
+        if (level == height - 1)
+          rebalance_leaves (parent, k);
+        else
+          rebalance_branches (parent, k);
+        node_count = parent->count;
+        node_min = BRANCH_MIN;
+      }
+  }
+
+  if (height > 0)
+    {
+      struct btree_branch *root = (struct btree_branch *) list->root;
+      if (root->count == 1)
+        {
+          list->root = root->children[0];
+          list->height = height - 1;
+          free (root);
+        }
+    }
+  else if (leaf->count == 0)
+    {
+      free (leaf);
+      list->root = NULL;
+    }
+  list->count = count - 1;
+
+  return elt;
+}
+
+static bool
+gl_btree_remove_at (gl_list_t list, size_t position)
+{
+  size_t count = list->count;
+
+  if (!(position < count))
+    /* Invalid argument.  */
+    abort ();
+
+  const void *elt = remove_element (list, position);
+  if (list->base.dispose_fn != NULL)
+    list->base.dispose_fn (elt);
+  return true;
+}
+
+/* The bulk operations on k elements of a list of n elements process the
+   elements one by one, in O(k log n) time, when k < n / BULK_REBUILD_RATIO,
+   and otherwise rebuild the entire tree in a single O(n + k) pass.  */
+#define BULK_REBUILD_RATIO 16
+
+/* Copies the elements at the indices >= START and < END of LIST to
+   ELEMENTS.  */
+static void
+copy_elements (gl_list_t list, size_t start, size_t end,
+               const void **elements)
+{
+  if (start < end)
+    {
+      size_t n = end - start;
+      size_t offset;
+      struct btree_leaf *leaf = locate (list, start, NULL, &offset);
+      for (;;)
+        {
+          size_t chunk = leaf->count - offset;
+          if (chunk > n)
+            chunk = n;
+          memcpy (elements, leaf->elements + offset,
+                  chunk * sizeof (const void *));
+          elements += chunk;
+          n -= chunk;
+          if (n == 0)
+            break;
+          leaf = leaf->next;
+          offset = 0;
+        }
+    }
+}
+
+/* Replaces the tree of LIST with an evenly filled tree that holds the COUNT
+   elements of CONTENTS.  Return 0 upon success, -1 upon out-of-memory, in
+   which case LIST is unchanged.  */
+static int
+rebuild (gl_list_t list, size_t count, const void **contents)
+{
+  struct gl_list_impl new_tree;
+
+  if (build (&new_tree, count, contents) < 0)
+    return -1;
+  if (list->root != NULL)
+    free_subtree (list->root, list->height);
+  list->root = new_tree.root;
+  list->height = new_tree.height;
+  list->count = new_tree.count;
+  return 0;
+}
+
+static int
+gl_btree_nx_add_all_at (gl_list_t list, size_t position,
+                        size_t count, const void **contents)
+{
+  size_t old_count = list->count;
+
+  if (!(position <= old_count))
+    /* Invalid argument.  */
+    abort ();
+  if (count == 0)
+    return 0;
+
+  if (count < old_count / BULK_REBUILD_RATIO)
+    {
+      /* Add the elements one by one.  */
+      for (size_t i = 0; i < count; i++)
+        if (gl_btree_nx_add_at (list, position + i, contents[i]) == NULL)
+          {
+            /* Remove the elements that were already added.  */
+            for (; i > 0; i--)
+              remove_element (list, position);
+            return -1;
+          }
+      return 0;
+    }
+
+  size_t new_count = xsum (old_count, count);
+  if (size_overflow_p (xtimes (new_count, sizeof (const void *))))
+    return -1;
+  const void **elements =
+    (const void **) malloc (new_count * sizeof (const void *));
+  if (elements == NULL)
+    return -1;
+  copy_elements (list, 0, position, elements);
+  memcpy (elements + position, contents, count * sizeof (const void *));
+  copy_elements (list, position, old_count, elements + position + count);
+  int ret = rebuild (list, new_count, elements);
+  free (elements);
+  return ret;
+}
+
+static void
+gl_btree_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t count = list->count;
+
+  if (!(start_index <= end_index && end_index <= count))
+    /* Invalid arguments.  */
+    abort ();
+  size_t n = end_index - start_index;
+  if (n == 0)
+    return;
+
+  if (list->base.dispose_fn != NULL)
+    {
+      gl_listelement_dispose_fn dispose = list->base.dispose_fn;
+      size_t offset;
+      struct btree_leaf *leaf = locate (list, start_index, NULL, &offset);
+      for (size_t i = n; i > 0; i--)
+        {
+          if (offset == leaf->count)
+            {
+              leaf = leaf->next;
+              offset = 0;
+            }
+          dispose (leaf->elements[offset++]);
+        }
+    }
+
+  if (n == count)
+    {
+      free_subtree (list->root, list->height);
+      list->root = NULL;
+      list->height = 0;
+      list->count = 0;
+      return;
+    }
+
+  if (n >= count / BULK_REBUILD_RATIO)
+    {
+      const void **elements =
+        (const void **) malloc ((count - n) * sizeof (const void *));
+      if (elements != NULL)
+        {
+          copy_elements (list, 0, start_index, elements);
+          copy_elements (list, end_index, count, elements + start_index);
+          int ret = rebuild (list, count - n, elements);
+          free (elements);
+          if (ret == 0)
+            return;
+        }
+      /* Upon out-of-memory, fall back to removing the elements one by
+         one.  */
+    }
+
+  for (; n > 0; n--)
+    remove_element (list, start_index);
+}
+
+static bool
+gl_btree_remove_node (gl_list_t list, gl_list_node_t node)
+{
+  uintptr_t index = NODE_TO_INDEX (node);
+  if (!(index < list->count))
+    /* Invalid argument.  */
+    abort ();
+  return gl_btree_remove_at (list, index);
+}
+
+static bool
+gl_btree_remove (gl_list_t list, const void *elt)
+{
+  size_t position = gl_btree_indexof_from_to (list, 0, list->count, elt);
+  if (position == (size_t)(-1))
+    return false;
+  else
+    return gl_btree_remove_at (list, position);
+}
+
+static void
+gl_btree_list_free (gl_list_t list)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  if (list->root != NULL)
+    {
+      if (list->base.dispose_fn != NULL)
+        {
+          gl_listelement_dispose_fn dispose = list->base.dispose_fn;
+          size_t offset;
+          for (struct btree_leaf *leaf = locate (list, 0, NULL, &offset);
+               leaf != NULL;
+               leaf = leaf->next)
+            for (unsigned int i = 0; i < leaf->count; i++)
+              dispose (leaf->elements[i]);
+        }
+      free_subtree (list->root, list->height);
+    }
+  free (list);
+}
+
+/* --------------------- gl_list_iterator_t Data Type --------------------- */
+
+/* The iterator fields are:
+     i     the index of the next element,
+     j     the end index,
+     p     the leaf that contains the next element, if i < j,
+     q     a pointer into the elements of p, the next element or - if it is
+           in the next leaf - the end of p->elements.  */
+
+static gl_list_iterator_t _GL_ATTRIBUTE_PURE
+gl_btree_iterator_from_to (gl_list_t list, size_t start_index, size_t end_index)
+{
+  if (!(start_index <= end_index && end_index <= list->count))
+    /* Invalid arguments.  */
+    abort ();
+
+  gl_list_iterator_t result;
+  result.vtable = list->base.vtable;
+  result.list = list;
+  result.count = list->count;
+  result.i = start_index;
+  result.j = end_index;
+  if (start_index < end_index)
+    {
+      size_t offset;
+      struct btree_leaf *leaf = locate (list, start_index, NULL, &offset);
+      result.p = leaf;
+      result.q = &leaf->elements[offset];
+    }
+  else
+    {
+      result.p = NULL;
+      result.q = NULL;
+    }
+
+  return result;
+}
+
+static gl_list_iterator_t _GL_ATTRIBUTE_PURE
+gl_btree_iterator (gl_list_t list)
+{
+  return gl_btree_iterator_from_to (list, 0, list->count);
+}
+
+static bool
+gl_btree_iterator_next (gl_list_iterator_t *iterator,
+                        const void **eltp, gl_list_node_t *nodep)
+{
+  gl_list_t list = iterator->list;
+  if (iterator->count != list->count)
+    {
+      if (iterator->count != list->count + 1)
+        /* Concurrent modifications were done on the list.  */
+        abort ();
+      /* The last returned element was removed.  The leaves may have been
+         merged, therefore locate the next element again.  */
+      iterator->count--;
+      iterator->i--;
+      iterator->j--;
+      if (iterator->i < iterator->j)
+        {
+          size_t offset;
+          struct btree_leaf *leaf = locate (list, iterator->i, NULL, &offset);
+          iterator->p = leaf;
+          iterator->q = &leaf->elements[offset];
+        }
+    }
+  if (iterator->i < iterator->j)
+    {
+      struct btree_leaf *leaf = (struct btree_leaf *) iterator->p;
+      const void **q = (const void **) iterator->q;
+      if (q == leaf->elements + leaf->count)
+        {
+          leaf = leaf->next;
+          iterator->p = leaf;
+          q = leaf->elements;
+        }
+      *eltp = *q;
+      if (nodep != NULL)
+        *nodep = INDEX_TO_NODE (iterator->i);
+      iterator->q = q + 1;
+      iterator->i++;
+      return true;
+    }
+  else
+    return false;
+}
+
+static void
+gl_btree_iterator_free (gl_list_iterator_t *_GL_UNNAMED (iterator))
+{
+}
+
+/* ---------------------- Sorted gl_list_t Data Type ---------------------- */
+
+/* Returns the smallest index in [low, high) of an element that is >= ELT,
+   or HIGH if there is none.  */
+static size_t _GL_ATTRIBUTE_PURE
+sortedlist_lower_bound (gl_list_t list, gl_listelement_compar_fn compar,
+                        size_t low, size_t high, const void *elt)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  /* At each loop iteration, low < high; for indices < low the values
+     are smaller than ELT; the value at index high, if high is less than
+     the original high, is >= ELT.  Each iteration looks at an entire leaf.  */
+  while (low < high)
+    {
+      size_t mid = low + (high - low) / 2; /* low <= mid < high */
+
+      size_t offset;
+      struct btree_leaf *leaf = locate (list, mid, NULL, &offset);
+      /* The leaf holds the indices leaf_start..leaf_start+leaf->count-1.
+         Restrict this to [low, high).  */
+      size_t leaf_start = mid - offset;
+      size_t a = (low > leaf_start ? low - leaf_start : 0);
+      size_t b = (high - leaf_start < leaf->count
+                  ? high - leaf_start
+                  : leaf->count);
+
+      if (compar (leaf->elements[b - 1], elt) < 0)
+        low = leaf_start + b;
+      else if (compar (leaf->elements[a], elt) >= 0)
+        high = leaf_start + a;
+      else
+        {
+          /* The value at a is < ELT, the value at b - 1 is >= ELT.  */
+          a++;
+          b--;
+          while (a < b)
+            {
+              size_t mid2 = a + (b - a) / 2; /* a <= mid2 < b */
+              if (compar (leaf->elements[mid2], elt) < 0)
+                a = mid2 + 1;
+              else
+                b = mid2;
+            }
+          return leaf_start + a;
+        }
+    }
+  return low;
+}
+
+static size_t _GL_ATTRIBUTE_PURE
+gl_btree_sortedlist_indexof_from_to (gl_list_t list,
+                                     gl_listelement_compar_fn compar,
+                                     size_t low, size_t high,
+                                     const void *elt)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  if (!(low <= high && high <= list->count))
+    /* Invalid arguments.  */
+    abort ();
+  size_t index = sortedlist_lower_bound (list, compar, low, high, elt);
+  if (index < high && compar (gl_btree_get_at (list, index), elt) == 0)
+    return index;
+  return (size_t)(-1);
+}
+
+static size_t _GL_ATTRIBUTE_PURE
+gl_btree_sortedlist_indexof (gl_list_t list, gl_listelement_compar_fn compar,
+                             const void *elt)
+{
+  return gl_btree_sortedlist_indexof_from_to (list, compar, 0, list->count,
+                                              elt);
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_sortedlist_search_from_to (gl_list_t list,
+                                    gl_listelement_compar_fn compar,
+                                    size_t low, size_t high,
+                                    const void *elt)
+{
+  size_t index =
+    gl_btree_sortedlist_indexof_from_to (list, compar, low, high, elt);
+  return INDEX_TO_NODE (index);
+}
+
+static gl_list_node_t _GL_ATTRIBUTE_PURE
+gl_btree_sortedlist_search (gl_list_t list, gl_listelement_compar_fn compar,
+                            const void *elt)
+{
+  size_t index =
+    gl_btree_sortedlist_indexof_from_to (list, compar, 0, list->count, elt);
+  return INDEX_TO_NODE (index);
+}
+
+static gl_list_node_t
+gl_btree_sortedlist_nx_add (gl_list_t list, gl_listelement_compar_fn compar,
+                            const void *elt)
+{
+  size_t index = sortedlist_lower_bound (list, compar, 0, list->count, elt);
+  return gl_btree_nx_add_at (list, index, elt);
+}
+
+static int
+gl_btree_sortedlist_nx_merge_array (gl_list_t list,
+                                    gl_listelement_compar_fn compar,
+                                    size_t count, const void **contents)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t old_count = list->count;
+
+  if (count == 0)
+    return 0;
+
+  if (count < old_count / BULK_REBUILD_RATIO)
+    {
+      /* Add the elements one by one.  Each one is added after the previous
+         one, so that the positions of the elements added so far remain
+         valid.  */
+      size_t *positions = (size_t *) malloc (count * sizeof (size_t));
+      if (positions == NULL)
+        return -1;
+      size_t low = 0;
+      for (size_t i = 0; i < count; i++)
+        {
+          size_t index =
+            sortedlist_lower_bound (list, compar, low, list->count,
+                                    contents[i]);
+          if (gl_btree_nx_add_at (list, index, contents[i]) == NULL)
+            {
+              /* Remove the elements that were already added.  */
+              for (; i > 0; i--)
+                remove_element (list, positions[i - 1]);
+              free (positions);
+              return -1;
+            }
+          positions[i] = index;
+          low = index + 1;
+        }
+      free (positions);
+      return 0;
+    }
+
+  size_t new_count = xsum (old_count, count);
+  if (size_overflow_p (xtimes (new_count, sizeof (const void *))))
+    return -1;
+  const void **elements =
+    (const void **) malloc (new_count * sizeof (const void *));
+  if (elements == NULL)
+    return -1;
+  {
+    /* Merge the leaves with CONTENTS.  */
+    size_t i = 0;
+    size_t j = 0;
+    size_t offset;
+    struct btree_leaf *leaf =
+      (old_count > 0 ? locate (list, 0, NULL, &offset) : NULL);
+    offset = 0;
+    while (j < count)
+      {
+        if (leaf != NULL && offset == leaf->count)
+          {
+            leaf = leaf->next;
+            offset = 0;
+          }
+        if (leaf != NULL && compar (leaf->elements[offset], contents[j]) <= 0)
+          elements[i++] = leaf->elements[offset++];
+        else
+          elements[i++] = contents[j++];
+      }
+    for (; leaf != NULL; leaf = leaf->next, offset = 0)
+      {
+        memcpy (elements + i, leaf->elements + offset,
+                (leaf->count - offset) * sizeof (const void *));
+        i += leaf->count - offset;
+      }
+  }
+  int ret = rebuild (list, new_count, elements);
+  free (elements);
+  return ret;
+}
+
+static bool
+gl_btree_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
+                            const void *elt)
+{
+  size_t index = gl_btree_sortedlist_indexof (list, compar, elt);
+  if (index == (size_t)(-1))
+    return false;
+  else
+    return gl_btree_remove_at (list, index);
+}
+
+/* For debugging.  */
+static size_t
+check_invariants (void *node, unsigned int height, bool is_root,
+                  struct btree_leaf **next_leafp)
+{
+  if (height == 0)
+    {
+      struct btree_leaf *leaf = (struct btree_leaf *) node;
+      if (!(leaf == *next_leafp))
+        abort ();
+      if (!(leaf->count >= 1 && leaf->count <= LEAF_CAPACITY))
+        abort ();
+      if (!(is_root || leaf->next == NULL || leaf->count >= LEAF_MIN))
+        abort ();
+      *next_leafp = leaf->next;
+      return leaf->count;
+    }
+  else
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      if (!(branch->count >= (is_root ? 2 : BRANCH_MIN)
+            && branch->count <= BRANCH_CAPACITY))
+        abort ();
+      size_t size = 0;
+      for (unsigned int k = 0; k < branch->count; k++)
+        {
+          if (!(check_invariants (branch->children[k], height - 1, false,
+                                  next_leafp)
+                == branch->sizes[k]))
+            abort ();
+          size += branch->sizes[k];
+        }
+      return size;
+    }
+}
+extern void gl_btree_list_check_invariants (gl_list_t list);
+void
+gl_btree_list_check_invariants (gl_list_t list)
+{
+  if (list->root != NULL)
+    {
+      size_t offset;
+      struct btree_leaf *next_leaf = locate (list, 0, NULL, &offset);
+      if (!(check_invariants (list->root, list->height, true, &next_leaf)
+            == list->count))
+        abort ();
+      if (!(next_leaf == NULL))
+        abort ();
+    }
+  else
+    {
+      if (!(list->count == 0 && list->height == 0))
+        abort ();
+    }
+}
+
+
+const struct gl_list_implementation gl_btree_list_implementation =
+  {
+    gl_btree_nx_create_empty,
+    gl_btree_nx_create_empty,
+    gl_btree_nx_create,
+    gl_btree_size,
+    gl_btree_node_value,
+    gl_btree_node_nx_set_value,
+    gl_btree_next_node,
+    gl_btree_previous_node,
+    gl_btree_first_node,
+    gl_btree_last_node,
+    gl_btree_get_at,
+    gl_btree_nx_set_at,
+    gl_btree_search_from_to,
+    gl_btree_indexof_from_to,
+    gl_btree_nx_add_first,
+    gl_btree_nx_add_last,
+    gl_btree_nx_add_before,
+    gl_btree_nx_add_after,
+    gl_btree_nx_add_at,
+    gl_btree_nx_add_all_at,
+    gl_btree_remove_node,
+    gl_btree_remove_at,
+    gl_btree_remove_range,
+    gl_btree_remove,
+    gl_btree_list_free,
+    gl_btree_iterator,
+    gl_btree_iterator_from_to,
+    gl_btree_iterator_next,
+    gl_btree_iterator_free,
+    gl_btree_sortedlist_search,
+    gl_btree_sortedlist_search_from_to,
+    gl_btree_sortedlist_indexof,
+    gl_btree_sortedlist_indexof_from_to,
+    gl_btree_sortedlist_nx_add,
+    gl_btree_sortedlist_nx_merge_array,
+    gl_btree_sortedlist_remove
+  };
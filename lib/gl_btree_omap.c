@@ -0,0 +1,316 @@
+/* Ordered map data type implemented by a B+ tree.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "gl_btree_omap.h"
+
+#include <stdlib.h>
+/* Get memcpy, memmove.  */
+#include <string.h>
+
+/* Checked size_t computations.  */
+#include "xsize.h"
+
+/* -------------------------- gl_omap_t Data Type -------------------------- */
+
+struct pair
+{
+  const void *key;
+  const void *value;
+};
+
+/* Parameterization of gl_btree_ordered.h.  */
+#define CONTAINER_T gl_omap_t
+#define CONTAINER_IMPL gl_omap_impl
+#define CONTAINER_IMPL_BASE gl_omap_impl_base
+#define ENTRY_T struct pair
+#define ENTRY_KEY(entry) (entry).key
+#define ENTRY_FROM(keys, values, i) (struct pair) { (keys)[i], (values)[i] }
+/* A leaf fills a malloc block of 512 bytes on 64-bit platforms.  */
+#define LEAF_CAPACITY 30
+#define CONTAINER_INVOKES_FN_PTR _GL_OMAP_INVOKES_FN_PTR
+
+#include "gl_btree_ordered.h"
+
+static gl_omap_t
+gl_btree_nx_create_empty (gl_omap_implementation_t implementation,
+                          gl_mapkey_compar_fn compar_fn,
+                          gl_mapkey_dispose_fn kdispose_fn,
+                          gl_mapvalue_dispose_fn vdispose_fn)
+{
+  struct gl_omap_impl *map =
+    (struct gl_omap_impl *) malloc (sizeof (struct gl_omap_impl));
+
+  if (map == NULL)
+    return NULL;
+
+  map->base.vtable = implementation;
+  map->base.compar_fn = compar_fn;
+  map->base.kdispose_fn = kdispose_fn;
+  map->base.vdispose_fn = vdispose_fn;
+  map->root = NULL;
+  map->height = 0;
+  map->count = 0;
+
+  return map;
+}
+
+static gl_omap_t
+gl_btree_nx_create (gl_omap_implementation_t implementation,
+                    gl_mapkey_compar_fn compar_fn,
+                    gl_mapkey_dispose_fn kdispose_fn,
+                    gl_mapvalue_dispose_fn vdispose_fn,
+                    size_t count, const void **keys, const void **values)
+{
+  struct gl_omap_impl *map =
+    (struct gl_omap_impl *) malloc (sizeof (struct gl_omap_impl));
+
+  if (map == NULL)
+    return NULL;
+
+  map->base.vtable = implementation;
+  map->base.compar_fn = compar_fn;
+  map->base.kdispose_fn = kdispose_fn;
+  map->base.vdispose_fn = vdispose_fn;
+  if (build (map, count, keys, values) < 0)
+    goto fail;
+
+  return map;
+
+ fail:
+  free (map);
+  return NULL;
+}
+
+static size_t _GL_ATTRIBUTE_PURE
+gl_btree_size (gl_omap_t map)
+{
+  return map->count;
+}
+
+static bool
+gl_btree_search (gl_omap_t map, const void *key, const void **valuep)
+{
+  if (map->root != NULL)
+    {
+      unsigned int offset;
+      bool found;
+      struct btree_leaf *leaf = locate (map, key, NULL, &offset, &found);
+      if (found)
+        {
+          *valuep = leaf->entries[offset].value;
+          return true;
+        }
+    }
+  return false;
+}
+
+static bool
+gl_btree_search_atleast (gl_omap_t map,
+                         gl_mapkey_threshold_fn threshold_fn,
+                         const void *threshold,
+                         const void **keyp, const void **valuep)
+{
+  unsigned int offset;
+  struct btree_leaf *leaf =
+    locate_atleast (map, threshold_fn, threshold, &offset);
+
+  if (leaf != NULL)
+    {
+      *keyp = leaf->entries[offset].key;
+      *valuep = leaf->entries[offset].value;
+      return true;
+    }
+  return false;
+}
+
+static int
+gl_btree_nx_getput (gl_omap_t map, const void *key, const void *value,
+                    const void **oldvaluep)
+{
+  struct pair entry = { key, value };
+
+  if (map->root == NULL)
+    return (insert_first (map, entry) < 0 ? -1 : 1);
+
+  struct btree_path path[MAXHEIGHT];
+  unsigned int offset;
+  bool found;
+  struct btree_leaf *leaf = locate (map, key, path, &offset, &found);
+  if (found)
+    {
+      *oldvaluep = leaf->entries[offset].value;
+      leaf->entries[offset].value = value;
+      return 0;
+    }
+  if (insert_at (map, path, leaf, offset, entry, NULL) < 0)
+    return -1;
+  return 1;
+}
+
+static bool
+gl_btree_getremove (gl_omap_t map, const void *key, const void **oldvaluep)
+  _GL_OMAP_INVOKES_FN_PTR
+{
+  if (map->root != NULL)
+    {
+      struct btree_path path[MAXHEIGHT];
+      unsigned int offset;
+      bool found;
+      struct btree_leaf *leaf = locate (map, key, path, &offset, &found);
+      if (found)
+        {
+          struct pair old_entry = leaf->entries[offset];
+          remove_at (map, path, leaf, offset);
+          *oldvaluep = old_entry.value;
+          if (map->base.kdispose_fn != NULL)
+            map->base.kdispose_fn (old_entry.key);
+          return true;
+        }
+    }
+  return false;
+}
+
+static void
+gl_btree_omap_free (gl_omap_t map)
+  _GL_OMAP_INVOKES_FN_PTR
+{
+  if (map->root != NULL)
+    {
+      if (map->base.kdispose_fn != NULL || map->base.vdispose_fn != NULL)
+        for (struct btree_leaf *leaf = first_leaf (map);
+             leaf != NULL;
+             leaf = leaf->next)
+          for (unsigned int i = 0; i < leaf->count; i++)
+            {
+              if (map->base.vdispose_fn != NULL)
+                map->base.vdispose_fn (leaf->entries[i].value);
+              if (map->base.kdispose_fn != NULL)
+                map->base.kdispose_fn (leaf->entries[i].key);
+            }
+      free_subtree (map->root, map->height);
+    }
+  free (map);
+}
+
+/* --------------------- gl_omap_iterator_t Data Type --------------------- */
+
+/* The iterator fields are:
+     p     the leaf that contains the next pair, or NULL at the end,
+     i     the index of the next pair in p,
+     q     the key of the next pair, so that it can be located again after
+           the last returned pair was removed.  */
+
+static gl_omap_iterator_t _GL_ATTRIBUTE_PURE
+gl_btree_iterator (gl_omap_t map)
+{
+  gl_omap_iterator_t result;
+
+  result.vtable = map->base.vtable;
+  result.map = map;
+  result.count = map->count;
+  if (map->root != NULL)
+    {
+      struct btree_leaf *leaf = first_leaf (map);
+      result.p = leaf;
+      result.q = (void *) leaf->entries[0].key;
+    }
+  else
+    {
+      result.p = NULL;
+      result.q = NULL;
+    }
+  result.i = 0;
+#if defined GCC_LINT || defined lint
+  result.j = 0;
+#endif
+
+  return result;
+}
+
+static bool
+gl_btree_iterator_next (gl_omap_iterator_t *iterator,
+                        const void **keyp, const void **valuep)
+{
+  gl_omap_t map = iterator->map;
+  if (iterator->count != map->count)
+    {
+      if (iterator->count != map->count + 1)
+        /* Concurrent modifications were done on the map.  */
+        abort ();
+      /* The last returned pair was removed.  The leaves may have been
+         merged, therefore locate the next pair again.  */
+      iterator->count--;
+      if (iterator->p != NULL)
+        {
+          unsigned int offset;
+          bool found;
+          iterator->p = locate (map, iterator->q, NULL, &offset, &found);
+          iterator->i = offset;
+        }
+    }
+  struct btree_leaf *leaf = (struct btree_leaf *) iterator->p;
+  if (leaf != NULL)
+    {
+      size_t i = iterator->i;
+      *keyp = leaf->entries[i].key;
+      *valuep = leaf->entries[i].value;
+      i++;
+      if (i == leaf->count)
+        {
+          leaf = leaf->next;
+          iterator->p = leaf;
+          i = 0;
+        }
+      iterator->i = i;
+      if (leaf != NULL)
+        iterator->q = (void *) leaf->entries[i].key;
+      return true;
+    }
+  else
+    return false;
+}
+
+static void
+gl_btree_iterator_free (gl_omap_iterator_t *_GL_UNNAMED (iterator))
+{
+}
+
+/* For debugging.  */
+extern void gl_btree_omap_check_invariants (gl_omap_t);
+void
+gl_btree_omap_check_invariants (gl_omap_t map)
+{
+  check_all_invariants (map);
+}
+
+const struct gl_omap_implementation gl_btree_omap_implementation =
+  {
+    gl_btree_nx_create_empty,
+    gl_btree_nx_create_empty,
+    gl_btree_nx_create,
+    gl_btree_size,
+    gl_btree_search,
+    gl_btree_search_atleast,
+    gl_btree_nx_getput,
+    gl_btree_getremove,
+    gl_btree_omap_free,
+    gl_btree_iterator,
+    gl_btree_iterator_next,
+    gl_btree_iterator_free
+  };
@@ -0,0 +1,804 @@
+/* Ordered {set,map} data type implemented by a B+ tree.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Common code of gl_btree_oset.c and gl_btree_omap.c.  */
+
+/* A B+ tree is a tree where
+   1. The entries are stored in the leaves, in increasing order of their
+      keys, as contiguous arrays of up to LEAF_CAPACITY entries.  The leaves
+      are chained from left to right.
+   2. A branch has up to BRANCH_CAPACITY children.  For k >= 1, mins[k] is
+      the key of the first entry in the subtree children[k].  mins[0] is
+      not maintained; it is used as scratch space during splits and merges.
+   3. All leaves are at the same depth, container->height.
+   4. Every branch, except the root, has at least BRANCH_MIN children.  The
+      root, if it is a branch, has at least 2 children.
+   5. Every leaf, except the root and the last leaf, has at least LEAF_MIN
+      entries.  The last leaf is left sparse when entries are appended, so
+      that a container filled in increasing order has full leaves.
+
+   A search does a binary search in the mins of each branch on the way
+   down, and then a binary search in the leaf.  Since the mins are keys of
+   entries that are in the container, they never refer to a disposed key.
+
+   Compared to a binary tree, which has one node of 4 or 5 words per entry,
+   a B+ tree needs little more than the entries themselves, and walking
+   through the entries in order mostly means incrementing an index.  */
+
+/* Parameterization: The includer defines
+     CONTAINER_T, CONTAINER_IMPL, CONTAINER_IMPL_BASE  as for
+                                     gl_avltree_ordered.h,
+     ENTRY_T                         the type of an entry in a leaf,
+     ENTRY_KEY(entry)                the key of an entry,
+     ENTRY_FROM(keys, values, i)     the entry made of KEYS[I], VALUES[I],
+     LEAF_CAPACITY                   the number of entries in a leaf,
+     CONTAINER_INVOKES_FN_PTR        _GL_OSET_INVOKES_FN_PTR or
+                                     _GL_OMAP_INVOKES_FN_PTR.  */
+
+#define LEAF_MIN (LEAF_CAPACITY / 2)
+/* The capacity is chosen so that a branch fills a malloc block of 512 bytes
+   on 64-bit platforms.  */
+#define BRANCH_CAPACITY 30
+#define BRANCH_MIN (BRANCH_CAPACITY / 2)
+
+/* A B+ tree of height h >= 1 has at least
+   (2 * BRANCH_MIN^(h-1) - 1) * LEAF_MIN entries, with LEAF_MIN >= 15.  So,
+   h <= 15 (because a tree of height h >= 16 would have more than
+   2 * 15^15 * 15 - 15 > 2^63 entries, which would exceed the address space
+   of the machine).  */
+#define MAXHEIGHT 16
+
+struct btree_leaf
+{
+  struct btree_leaf *next;          /* next leaf, or NULL */
+  unsigned int count;               /* number of used entries */
+  ENTRY_T entries[LEAF_CAPACITY];
+};
+
+struct btree_branch
+{
+  unsigned int count;               /* number of children */
+  const void *mins[BRANCH_CAPACITY];  /* the key of the first entry in each
+                                       child, except the first one */
+  void *children[BRANCH_CAPACITY];  /* a struct btree_branch * or
+                                       struct btree_leaf * each */
+};
+
+/* Concrete CONTAINER_IMPL type, valid for this file only.  */
+struct CONTAINER_IMPL
+{
+  struct CONTAINER_IMPL_BASE base;
+  void *root;                       /* root leaf or branch, or NULL */
+  unsigned int height;              /* number of branch levels */
+  size_t count;                     /* number of entries */
+};
+
+/* A step in the descent from the root to a leaf.  */
+struct btree_path
+{
+  struct btree_branch *branch;
+  unsigned int index;               /* index of the child in the branch */
+};
+
+/* Compares two keys, with COMPAR or - if it is NULL - as pointers.  */
+static inline int
+compare_keys (int (*compar) (const void *, const void *),
+              const void *key1, const void *key2)
+  CONTAINER_INVOKES_FN_PTR
+{
+  return (compar != NULL
+          ? compar (key1, key2)
+          : (key1 > key2 ? 1 : key1 < key2 ? -1 : 0));
+}
+
+/* Returns the leaf that contains KEY or in which KEY would be inserted.
+   Stores in *OFFSETP the index in this leaf of the first entry whose key is
+   >= KEY, or the leaf's count if there is none.  Returns in *FOUNDP whether
+   this entry's key is equal to KEY.  If PATH is not NULL, stores the
+   branches on the way from the root in PATH[0..container->height-1].
+   The container must not be empty.  */
+static struct btree_leaf *
+locate (CONTAINER_T container, const void *key, struct btree_path *path,
+        unsigned int *offsetp, bool *foundp)
+  CONTAINER_INVOKES_FN_PTR
+{
+  int (*compar) (const void *, const void *) = container->base.compar_fn;
+  void *node = container->root;
+
+  for (unsigned int level = 0; level < container->height; level++)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      /* Find the last child k with k == 0 or mins[k] <= KEY.
+         At each loop iteration, low < high; the child is at
+         low <= k < high.  */
+      unsigned int low = 0;
+      unsigned int high = branch->count;
+      while (high - low > 1)
+        {
+          unsigned int mid = low + (high - low) / 2; /* low < mid < high */
+          if (compare_keys (compar, branch->mins[mid], key) <= 0)
+            low = mid;
+          else
+            high = mid;
+        }
+      if (path != NULL)
+        {
+          path[level].branch = branch;
+          path[level].index = low;
+        }
+      node = branch->children[low];
+    }
+
+  struct btree_leaf *leaf = (struct btree_leaf *) node;
+  /* At each loop iteration, low <= high; the keys at indices < low are
+     smaller than KEY; the keys at indices >= high are >= KEY.  */
+  unsigned int low = 0;
+  unsigned int high = leaf->count;
+  bool found = false;
+  while (low < high)
+    {
+      unsigned int mid = low + (high - low) / 2; /* low <= mid < high */
+      int cmp = compare_keys (compar, ENTRY_KEY (leaf->entries[mid]), key);
+      if (cmp < 0)
+        low = mid + 1;
+      else
+        {
+          high = mid;
+          if (cmp == 0)
+            {
+              found = true;
+              break;
+            }
+        }
+    }
+  *offsetp = high;
+  *foundp = found;
+  return leaf;
+}
+
+/* Returns the leaf that contains the least entry whose key is >= THRESHOLD,
+   according to THRESHOLD_FN, and stores its index in *OFFSETP.  Returns NULL
+   if there is no such entry.  */
+static struct btree_leaf *
+locate_atleast (CONTAINER_T container,
+                bool (*threshold_fn) (const void *, const void *),
+                const void *threshold, unsigned int *offsetp)
+  CONTAINER_INVOKES_FN_PTR
+{
+  void *node = container->root;
+
+  if (node == NULL)
+    return NULL;
+
+  for (unsigned int level = 0; level < container->height; level++)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      /* Find the last child k with k == 0 or mins[k] < THRESHOLD.  */
+      unsigned int low = 0;
+      unsigned int high = branch->count;
+      while (high - low > 1)
+        {
+          unsigned int mid = low + (high - low) / 2; /* low < mid < high */
+          if (! threshold_fn (branch->mins[mid], threshold))
+            low = mid;
+          else
+            high = mid;
+        }
+      node = branch->children[low];
+    }
+
+  struct btree_leaf *leaf = (struct btree_leaf *) node;
+  unsigned int low = 0;
+  unsigned int high = leaf->count;
+  while (low < high)
+    {
+      unsigned int mid = low + (high - low) / 2; /* low <= mid < high */
+      if (! threshold_fn (ENTRY_KEY (leaf->entries[mid]), threshold))
+        low = mid + 1;
+      else
+        high = mid;
+    }
+  if (low == leaf->count)
+    {
+      /* The entry, if any, is the first one of the next leaf.  */
+      leaf = leaf->next;
+      low = 0;
+    }
+  *offsetp = low;
+  return leaf;
+}
+
+/* Returns the first leaf of a non-empty container.  */
+static struct btree_leaf * _GL_ATTRIBUTE_PURE
+first_leaf (CONTAINER_T container)
+{
+  void *node = container->root;
+  for (unsigned int level = 0; level < container->height; level++)
+    node = ((struct btree_branch *) node)->children[0];
+  return (struct btree_leaf *) node;
+}
+
+/* Frees the subtree rooted at NODE, of the given HEIGHT.  */
+static void
+free_subtree (void *node, unsigned int height)
+{
+  if (height > 0)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      for (unsigned int k = 0; k < branch->count; k++)
+        free_subtree (branch->children[k], height - 1);
+    }
+  free (node);
+}
+
+/* Fills CONTAINER with the COUNT entries made of KEYS and VALUES, with
+   leaves and branches evenly filled.  VALUES is unused for sets.
+   Return 0 upon success, -1 upon out-of-memory.  */
+static int
+build (CONTAINER_T container, size_t count,
+       const void **keys, _GL_ATTRIBUTE_MAYBE_UNUSED const void **values)
+{
+  container->root = NULL;
+  container->height = 0;
+  container->count = 0;
+  if (count == 0)
+    return 0;
+
+  size_t n = (count - 1) / LEAF_CAPACITY + 1;
+  if (size_overflow_p (xtimes (n, 2 * sizeof (void *))))
+    return -1;
+  void **nodes = (void **) malloc (n * sizeof (void *));
+  const void **mins = (const void **) malloc (n * sizeof (const void *));
+  if (nodes == NULL || mins == NULL)
+    goto fail1;
+
+  /* Create the leaves.  */
+  {
+    struct btree_leaf *previous = NULL;
+    size_t i0 = 0;
+    for (size_t i = 0; i < n; i++)
+      {
+        struct btree_leaf *leaf =
+          (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+        if (leaf == NULL)
+          {
+            for (size_t i2 = 0; i2 < i; i2++)
+              free (nodes[i2]);
+            goto fail1;
+          }
+        unsigned int leaf_count = count / n + (i < count % n);
+        for (unsigned int k = 0; k < leaf_count; k++)
+          leaf->entries[k] = ENTRY_FROM (keys, values, i0 + k);
+        i0 += leaf_count;
+        leaf->count = leaf_count;
+        leaf->next = NULL;
+        if (previous != NULL)
+          previous->next = leaf;
+        previous = leaf;
+        nodes[i] = leaf;
+        mins[i] = ENTRY_KEY (leaf->entries[0]);
+      }
+  }
+
+  /* Create the branches, one level at a time.  */
+  unsigned int height = 0;
+  while (n > 1)
+    {
+      size_t n_branches = (n - 1) / BRANCH_CAPACITY + 1;
+      size_t i = 0;
+      for (size_t j = 0; j < n_branches; j++)
+        {
+          struct btree_branch *branch =
+            (struct btree_branch *) malloc (sizeof (struct btree_branch));
+          if (branch == NULL)
+            {
+              for (size_t j2 = 0; j2 < j; j2++)
+                free_subtree (nodes[j2], height + 1);
+              for (; i < n; i++)
+                free_subtree (nodes[i], height);
+              goto fail1;
+            }
+          unsigned int branch_count = n / n_branches + (j < n % n_branches);
+          const void *branch_min = mins[i];
+          for (unsigned int k = 0; k < branch_count; k++, i++)
+            {
+              branch->children[k] = nodes[i];
+              branch->mins[k] = mins[i];
+            }
+          branch->count = branch_count;
+          /* Here j < i, therefore this doesn't overwrite unread entries.  */
+          nodes[j] = branch;
+          mins[j] = branch_min;
+        }
+      height++;
+      n = n_branches;
+    }
+
+  container->root = nodes[0];
+  container->height = height;
+  container->count = count;
+  free (mins);
+  free (nodes);
+  return 0;
+
+ fail1:
+  free (mins);
+  free (nodes);
+  return -1;
+}
+
+/* Inserts ENTRY at position OFFSET in the full leaf LEAF, distributing the
+   LEAF_CAPACITY + 1 entries among LEAF and the fresh leaf NEW_LEAF, which
+   follows it.  If AT_END, LEAF is the last leaf and ENTRY is being
+   appended: leave LEAF full then.  */
+static void
+split_leaf (struct btree_leaf *leaf, struct btree_leaf *new_leaf,
+            unsigned int offset, ENTRY_T entry, bool at_end)
+{
+  ENTRY_T entries[LEAF_CAPACITY + 1];
+  memcpy (entries, leaf->entries, offset * sizeof (ENTRY_T));
+  entries[offset] = entry;
+  memcpy (entries + offset + 1, leaf->entries + offset,
+          (LEAF_CAPACITY - offset) * sizeof (ENTRY_T));
+
+  unsigned int left = (at_end ? LEAF_CAPACITY : (LEAF_CAPACITY + 1) / 2);
+  memcpy (leaf->entries, entries, left * sizeof (ENTRY_T));
+  memcpy (new_leaf->entries, entries + left,
+          (LEAF_CAPACITY + 1 - left) * sizeof (ENTRY_T));
+  leaf->count = left;
+  new_leaf->count = LEAF_CAPACITY + 1 - left;
+  new_leaf->next = leaf->next;
+  leaf->next = new_leaf;
+}
+
+/* Inserts the child CHILD, whose first key is MIN, at position K in the
+   full branch BRANCH, distributing the BRANCH_CAPACITY + 1 children evenly
+   among BRANCH and the fresh branch NEW_BRANCH.  Afterwards,
+   NEW_BRANCH->mins[0] is the first key of NEW_BRANCH.  */
+static void
+split_branch (struct btree_branch *branch, struct btree_branch *new_branch,
+              unsigned int k, void *child, const void *min)
+{
+  void *children[BRANCH_CAPACITY + 1];
+  const void *mins[BRANCH_CAPACITY + 1];
+  memcpy (children, branch->children, k * sizeof (void *));
+  memcpy (mins, branch->mins, k * sizeof (const void *));
+  children[k] = child;
+  mins[k] = min;
+  memcpy (children + k + 1, branch->children + k,
+          (BRANCH_CAPACITY - k) * sizeof (void *));
+  memcpy (mins + k + 1, branch->mins + k,
+          (BRANCH_CAPACITY - k) * sizeof (const void *));
+
+  unsigned int left = (BRANCH_CAPACITY + 1) / 2;
+  memcpy (branch->children, children, left * sizeof (void *));
+  memcpy (branch->mins, mins, left * sizeof (const void *));
+  memcpy (new_branch->children, children + left,
+          (BRANCH_CAPACITY + 1 - left) * sizeof (void *));
+  memcpy (new_branch->mins, mins + left,
+          (BRANCH_CAPACITY + 1 - left) * sizeof (const void *));
+  branch->count = left;
+  new_branch->count = BRANCH_CAPACITY + 1 - left;
+}
+
+/* Inserts ENTRY into the empty CONTAINER.
+   Returns 0 upon success, -1 upon out-of-memory.  */
+static int
+insert_first (CONTAINER_T container, ENTRY_T entry)
+{
+  struct btree_leaf *leaf =
+    (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+  if (leaf == NULL)
+    return -1;
+  leaf->next = NULL;
+  leaf->count = 1;
+  leaf->entries[0] = entry;
+  container->root = leaf;
+  container->height = 0;
+  container->count = 1;
+  return 0;
+}
+
+/* Nodes allocated in advance, so that an insertion cannot fail.  */
+struct btree_spare
+{
+  struct btree_leaf *leaf;
+  unsigned int n_branches;
+  struct btree_branch *branches[MAXHEIGHT];
+};
+
+/* Inserts ENTRY at position OFFSET in LEAF, that was found by
+   locate (container, ENTRY_KEY (entry), PATH, ...).
+   If SPARE is not NULL, the new nodes are taken from SPARE, which was filled
+   by alloc_spare while the container had at least as many entries as now.
+   Returns 0 upon success, -1 upon out-of-memory.  In the latter case, the
+   container is unmodified.  */
+static int
+insert_at (CONTAINER_T container, struct btree_path *path,
+           struct btree_leaf *leaf, unsigned int offset, ENTRY_T entry,
+           struct btree_spare *spare)
+{
+  unsigned int height = container->height;
+
+  /* If OFFSET is 0, LEAF is the first leaf, and all indices in PATH are 0.
+     Therefore no mins need to be updated.  */
+  if (leaf->count < LEAF_CAPACITY)
+    {
+      /* Fast path: there is room in the leaf.  */
+      memmove (leaf->entries + offset + 1, leaf->entries + offset,
+               (leaf->count - offset) * sizeof (ENTRY_T));
+      leaf->entries[offset] = entry;
+      leaf->count++;
+    }
+  else
+    {
+      /* The leaf needs to be split, and so does every full branch above it.
+         Allocate all new nodes first, so that an allocation failure leaves
+         the container unmodified.  */
+      unsigned int full = 0;
+      while (full < height
+             && path[height - 1 - full].branch->count == BRANCH_CAPACITY)
+        full++;
+      /* If all branches are full, a new root is needed as well.  */
+      unsigned int n_branches = full + (full == height);
+      if (full == height && height + 1 > MAXHEIGHT)
+        return -1;
+
+      struct btree_leaf *new_leaf;
+      struct btree_branch *new_branches[MAXHEIGHT];
+      if (spare != NULL)
+        {
+          new_leaf = spare->leaf;
+          spare->leaf = NULL;
+          for (unsigned int i = 0; i < n_branches; i++)
+            new_branches[i] = spare->branches[--spare->n_branches];
+        }
+      else
+        {
+          new_leaf = (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+          if (new_leaf == NULL)
+            return -1;
+          for (unsigned int i = 0; i < n_branches; i++)
+            {
+              new_branches[i] =
+                (struct btree_branch *) malloc (sizeof (struct btree_branch));
+              if (new_branches[i] == NULL)
+                {
+                  while (i > 0)
+                    free (new_branches[--i]);
+                  free (new_leaf);
+                  return -1;
+                }
+            }
+        }
+
+      split_leaf (leaf, new_leaf, offset, entry,
+                  offset == LEAF_CAPACITY && leaf->next == NULL);
+
+      /* Insert the new node into the parent, splitting as needed.  */
+      void *left_node = leaf;
+      void *new_node = new_leaf;
+      const void *new_min = ENTRY_KEY (new_leaf->entries[0]);
+      unsigned int level = height;
+      while (new_node != NULL && level > 0)
+        {
+          level--;
+          struct btree_branch *branch = path[level].branch;
+          unsigned int k = path[level].index;
+
+          if (branch->count < BRANCH_CAPACITY)
+            {
+              memmove (branch->children + k + 2, branch->children + k + 1,
+                       (branch->count - k - 1) * sizeof (void *));
+              memmove (branch->mins + k + 2, branch->mins + k + 1,
+                       (branch->count - k - 1) * sizeof (const void *));
+              branch->children[k + 1] = new_node;
+              branch->mins[k + 1] = new_min;
+              branch->count++;
+              new_node = NULL;
+            }
+          else
+            {
+              struct btree_branch *new_branch = new_branches[--n_branches];
+              split_branch (branch, new_branch, k + 1, new_node, new_min);
+              left_node = branch;
+              new_node = new_branch;
+              new_min = new_branch->mins[0];
+            }
+        }
+      if (new_node != NULL)
+        {
+          /* The root was split.  */
+          struct btree_branch *root = new_branches[--n_branches];
+          root->count = 2;
+          root->children[0] = left_node;
+          root->children[1] = new_node;
+          root->mins[1] = new_min;
+          container->root = root;
+          container->height = height + 1;
+        }
+    }
+  container->count++;
+  return 0;
+}
+
+/* Merges or rebalances the leaves at positions K and K + 1 of PARENT.
+   The leaf at position K is not empty.  */
+static void
+rebalance_leaves (struct btree_branch *parent, unsigned int k)
+{
+  struct btree_leaf *left = (struct btree_leaf *) parent->children[k];
+  struct btree_leaf *right = (struct btree_leaf *) parent->children[k + 1];
+  unsigned int total = left->count + right->count;
+
+  if (total <= LEAF_CAPACITY)
+    {
+      /* Merge RIGHT into LEFT.  */
+      memcpy (left->entries + left->count, right->entries,
+              right->count * sizeof (ENTRY_T));
+      left->count = total;
+      left->next = right->next;
+      free (right);
+      memmove (parent->children + k + 1, parent->children + k + 2,
+               (parent->count - k - 2) * sizeof (void *));
+      memmove (parent->mins + k + 1, parent->mins + k + 2,
+               (parent->count - k - 2) * sizeof (const void *));
+      parent->count--;
+    }
+  else
+    {
+      /* Move entries, so that both leaves have at least LEAF_MIN.  */
+      unsigned int new_left = total / 2;
+      if (left->count > new_left)
+        {
+          unsigned int n = left->count - new_left;
+          memmove (right->entries + n, right->entries,
+                   right->count * sizeof (ENTRY_T));
+          memcpy (right->entries, left->entries + new_left,
+                  n * sizeof (ENTRY_T));
+        }
+      else
+        {
+          unsigned int n = new_left - left->count;
+          memcpy (left->entries + left->count, right->entries,
+                  n * sizeof (ENTRY_T));
+          memmove (right->entries, right->entries + n,
+                   (right->count - n) * sizeof (ENTRY_T));
+        }
+      left->count = new_left;
+      right->count = total - new_left;
+      parent->mins[k + 1] = ENTRY_KEY (right->entries[0]);
+    }
+}
+
+/* Merges or rebalances the branches at positions K and K + 1 of PARENT.  */
+static void
+rebalance_branches (struct btree_branch *parent, unsigned int k)
+{
+  struct btree_branch *left = (struct btree_branch *) parent->children[k];
+  struct btree_branch *right = (struct btree_branch *) parent->children[k + 1];
+  unsigned int total = left->count + right->count;
+
+  /* Make RIGHT->mins complete, so that it can be moved along with the
+     children.  */
+  right->mins[0] = parent->mins[k + 1];
+
+  if (total <= BRANCH_CAPACITY)
+    {
+      /* Merge RIGHT into LEFT.  */
+      memcpy (left->children + left->count, right->children,
+              right->count * sizeof (void *));
+      memcpy (left->mins + left->count, right->mins,
+              right->count * sizeof (const void *));
+      left->count = total;
+      free (right);
+      memmove (parent->children + k + 1, parent->children + k + 2,
+               (parent->count - k - 2) * sizeof (void *));
+      memmove (parent->mins + k + 1, parent->mins + k + 2,
+               (parent->count - k - 2) * sizeof (const void *));
+      parent->count--;
+    }
+  else
+    {
+      /* Move children, so that both branches have at least BRANCH_MIN.  */
+      unsigned int new_left = total / 2;
+      if (left->count > new_left)
+        {
+          unsigned int n = left->count - new_left;
+          memmove (right->children + n, right->children,
+                   right->count * sizeof (void *));
+          memmove (right->mins + n, right->mins,
+                   right->count * sizeof (const void *));
+          memcpy (right->children, left->children + new_left,
+                  n * sizeof (void *));
+          memcpy (right->mins, left->mins + new_left,
+                  n * sizeof (const void *));
+        }
+      else
+        {
+          unsigned int n = new_left - left->count;
+          memcpy (left->children + left->count, right->children,
+                  n * sizeof (void *));
+          memcpy (left->mins + left->count, right->mins,
+                  n * sizeof (const void *));
+          memmove (right->children, right->children + n,
+                   (right->count - n) * sizeof (void *));
+          memmove (right->mins, right->mins + n,
+                   (right->count - n) * sizeof (const void *));
+        }
+      left->count = new_left;
+      right->count = total - new_left;
+      parent->mins[k + 1] = right->mins[0];
+    }
+}
+
+/* Removes the entry at position OFFSET in LEAF, that was found by
+   locate (container, ..., PATH, ...).  Does not dispose it.  */
+static void
+remove_at (CONTAINER_T container, struct btree_path *path,
+           struct btree_leaf *leaf, unsigned int offset)
+{
+  unsigned int height = container->height;
+
+  memmove (leaf->entries + offset, leaf->entries + offset + 1,
+           (leaf->count - offset - 1) * sizeof (ENTRY_T));
+  leaf->count--;
+
+  if (offset == 0 && leaf->count > 0)
+    {
+      /* The first key of the leaf has changed.  It is recorded in the
+         nearest branch in which the path doesn't go through child 0.  */
+      unsigned int level = height;
+      while (level > 0)
+        {
+          level--;
+          if (path[level].index > 0)
+            {
+              path[level].branch->mins[path[level].index] =
+                ENTRY_KEY (leaf->entries[0]);
+              break;
+            }
+        }
+    }
+  /* If the leaf is empty now, it is the root or the last leaf.  In the
+     latter case, it is merged into its left sibling below, and its key in
+     the parent disappears.  */
+
+  /* Fix underflows, from the leaf upwards.  */
+  {
+    unsigned int level = height;
+    unsigned int node_count = leaf->count;
+    unsigned int node_min = LEAF_MIN;
+    while (level > 0 && node_count < node_min)
+      {
+        level--;
+        struct btree_branch *parent = path[level].branch;
+        unsigned int k = path[level].index;
+        /* Combine the child with its right sibling, or - for the last
+           child - with its left sibling.  */
+        if (k == parent->count - 1)
+          k--;
+        if (level == height - 1)
+          rebalance_leaves (parent, k);
+        else
+          rebalance_branches (parent, k);
+        node_count = parent->count;
+        node_min = BRANCH_MIN;
+      }
+  }
+
+  if (height > 0)
+    {
+      struct btree_branch *root = (struct btree_branch *) container->root;
+      if (root->count == 1)
+        {
+          container->root = root->children[0];
+          container->height = height - 1;
+          free (root);
+        }
+    }
+  else if (leaf->count == 0)
+    {
+      free (leaf);
+      container->root = NULL;
+    }
+  container->count--;
+}
+
+/* For debugging.  */
+
+/* State of the check_invariants traversal.  */
+struct btree_check_state
+{
+  CONTAINER_T container;
+  struct btree_leaf *previous;      /* the previously visited leaf, or NULL */
+};
+
+/* Checks the subtree rooted at NODE, of the given HEIGHT, and returns the
+   number of entries in it.  Stores its first key in *MINP.  */
+static size_t
+check_invariants (struct btree_check_state *state, void *node,
+                  unsigned int height, bool is_root, const void **minp)
+{
+  if (height > 0)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      if (!(branch->count <= BRANCH_CAPACITY))
+        abort ();
+      if (!(branch->count >= (is_root ? 2 : BRANCH_MIN)))
+        abort ();
+      size_t size = 0;
+      for (unsigned int k = 0; k < branch->count; k++)
+        {
+          const void *min;
+          size += check_invariants (state, branch->children[k], height - 1,
+                                    false, &min);
+          if (k == 0)
+            *minp = min;
+          else if (!(branch->mins[k] == min))
+            abort ();
+        }
+      return size;
+    }
+  else
+    {
+      struct btree_leaf *leaf = (struct btree_leaf *) node;
+      int (*compar) (const void *, const void *) =
+        state->container->base.compar_fn;
+      if (!(leaf->count > 0 && leaf->count <= LEAF_CAPACITY))
+        abort ();
+      if (!(is_root || leaf->count >= LEAF_MIN || leaf->next == NULL))
+        abort ();
+      if (state->previous != NULL)
+        {
+          struct btree_leaf *previous = state->previous;
+          if (!(previous->next == leaf))
+            abort ();
+          if (!(compare_keys (compar,
+                              ENTRY_KEY (previous->entries[previous->count - 1]),
+                              ENTRY_KEY (leaf->entries[0]))
+                < 0))
+            abort ();
+        }
+      for (unsigned int i = 1; i < leaf->count; i++)
+        if (!(compare_keys (compar,
+                            ENTRY_KEY (leaf->entries[i - 1]),
+                            ENTRY_KEY (leaf->entries[i]))
+              < 0))
+          abort ();
+      state->previous = leaf;
+      *minp = ENTRY_KEY (leaf->entries[0]);
+      return leaf->count;
+    }
+}
+
+/* Checks the invariants of CONTAINER.  */
+static void
+check_all_invariants (CONTAINER_T container)
+{
+  size_t count = 0;
+  if (container->root != NULL)
+    {
+      struct btree_check_state state = { container, NULL };
+      const void *min;
+      count = check_invariants (&state, container->root, container->height,
+                                true, &min);
+      if (!(state.previous->next == NULL))
+        abort ();
+    }
+  if (!(container->count == count))
+    abort ();
+}
@@ -0,0 +1,692 @@
+/* Ordered set data type implemented by a B+ tree.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "gl_btree_oset.h"
+
+#include <stdlib.h>
+/* Get memcpy, memmove.  */
+#include <string.h>
+
+/* Checked size_t computations.  */
+#include "xsize.h"
+
+/* -------------------------- gl_oset_t Data Type -------------------------- */
+
+/* Parameterization of gl_btree_ordered.h.  */
+#define CONTAINER_T gl_oset_t
+#define CONTAINER_IMPL gl_oset_impl
+#define CONTAINER_IMPL_BASE gl_oset_impl_base
+#define ENTRY_T const void *
+#define ENTRY_KEY(entry) (entry)
+#define ENTRY_FROM(keys, values, i) (keys)[i]
+/* A leaf fills a malloc block of 512 bytes on 64-bit platforms.  */
+#define LEAF_CAPACITY 60
+#define CONTAINER_INVOKES_FN_PTR _GL_OSET_INVOKES_FN_PTR
+
+#include "gl_btree_ordered.h"
+
+static gl_oset_t
+gl_btree_nx_create_empty (gl_oset_implementation_t implementation,
+                          gl_setelement_compar_fn compar_fn,
+                          gl_setelement_dispose_fn dispose_fn)
+{
+  struct gl_oset_impl *set =
+    (struct gl_oset_impl *) malloc (sizeof (struct gl_oset_impl));
+
+  if (set == NULL)
+    return NULL;
+
+  set->base.vtable = implementation;
+  set->base.compar_fn = compar_fn;
+  set->base.dispose_fn = dispose_fn;
+  set->root = NULL;
+  set->height = 0;
+  set->count = 0;
+
+  return set;
+}
+
+static gl_oset_t
+gl_btree_nx_create (gl_oset_implementation_t implementation,
+                    gl_setelement_compar_fn compar_fn,
+                    gl_setelement_dispose_fn dispose_fn,
+                    size_t count, const void **contents)
+{
+  struct gl_oset_impl *set =
+    (struct gl_oset_impl *) malloc (sizeof (struct gl_oset_impl));
+
+  if (set == NULL)
+    return NULL;
+
+  set->base.vtable = implementation;
+  set->base.compar_fn = compar_fn;
+  set->base.dispose_fn = dispose_fn;
+  if (build (set, count, contents, NULL) < 0)
+    goto fail;
+
+  return set;
+
+ fail:
+  free (set);
+  return NULL;
+}
+
+static size_t _GL_ATTRIBUTE_PURE
+gl_btree_size (gl_oset_t set)
+{
+  return set->count;
+}
+
+static bool
+gl_btree_search (gl_oset_t set, const void *elt)
+{
+  if (set->root != NULL)
+    {
+      unsigned int offset;
+      bool found;
+      locate (set, elt, NULL, &offset, &found);
+      return found;
+    }
+  return false;
+}
+
+static bool
+gl_btree_search_atleast (gl_oset_t set,
+                         gl_setelement_threshold_fn threshold_fn,
+                         const void *threshold,
+                         const void **eltp)
+{
+  unsigned int offset;
+  struct btree_leaf *leaf =
+    locate_atleast (set, threshold_fn, threshold, &offset);
+
+  if (leaf != NULL)
+    {
+      *eltp = leaf->entries[offset];
+      return true;
+    }
+  return false;
+}
+
+static int
+gl_btree_nx_add (gl_oset_t set, const void *elt)
+{
+  if (set->root == NULL)
+    return (insert_first (set, elt) < 0 ? -1 : 1);
+
+  struct btree_path path[MAXHEIGHT];
+  unsigned int offset;
+  bool found;
+  struct btree_leaf *leaf = locate (set, elt, path, &offset, &found);
+  if (found)
+    return 0;
+  if (insert_at (set, path, leaf, offset, elt, NULL) < 0)
+    return -1;
+  return 1;
+}
+
+/* The bulk addition of k elements to a set of n elements adds the elements
+   one by one, in O(k log n) time, when k < n / BULK_REBUILD_RATIO, and
+   otherwise rebuilds the entire tree in a single O(n + k) pass.  */
+#define BULK_REBUILD_RATIO 16
+
+static int
+gl_btree_nx_add_sorted_array (gl_oset_t set,
+                              size_t count, const void **contents)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  gl_setelement_compar_fn compar = set->base.compar_fn;
+  size_t old_count = set->count;
+
+  if (count == 0)
+    return 0;
+
+  if (count < old_count / BULK_REBUILD_RATIO)
+    {
+      /* Add the elements one by one, and remember which ones were added,
+         so that they can be removed again upon out-of-memory.  */
+      const void **added =
+        (const void **) malloc (count * sizeof (const void *));
+      if (added == NULL)
+        return -1;
+      size_t n_added = 0;
+      for (size_t i = 0; i < count; i++)
+        {
+          int ret = gl_btree_nx_add (set, contents[i]);
+          if (ret < 0)
+            {
+              for (; n_added > 0; n_added--)
+                {
+                  struct btree_path path[MAXHEIGHT];
+                  unsigned int offset;
+                  bool found;
+                  struct btree_leaf *leaf =
+                    locate (set, added[n_added - 1], path, &offset, &found);
+                  remove_at (set, path, leaf, offset);
+                }
+              free (added);
+              return -1;
+            }
+          if (ret > 0)
+            added[n_added++] = contents[i];
+        }
+      free (added);
+      return 0;
+    }
+
+  /* Merge the leaves with CONTENTS into a new array, and build a new tree
+     from it.  */
+  size_t new_count = xsum (old_count, count);
+  if (size_overflow_p (xtimes (new_count, sizeof (const void *))))
+    return -1;
+  const void **elements =
+    (const void **) malloc (new_count * sizeof (const void *));
+  if (elements == NULL)
+    return -1;
+  size_t n = 0;
+  {
+    struct btree_leaf *leaf = (set->root != NULL ? first_leaf (set) : NULL);
+    unsigned int offset = 0;
+    for (size_t j = 0; j < count; j++)
+      {
+        const void *elt = contents[j];
+        int cmp = 1;
+        for (;;)
+          {
+            if (leaf != NULL && offset == leaf->count)
+              {
+                leaf = leaf->next;
+                offset = 0;
+              }
+            if (leaf == NULL
+                || (cmp = compare_keys (compar, leaf->entries[offset], elt))
+                   >= 0)
+              break;
+            elements[n++] = leaf->entries[offset++];
+          }
+        /* Skip ELT if it is already in the set or was just added.  */
+        if (cmp != 0
+            && !(n > 0 && compare_keys (compar, elements[n - 1], elt) == 0))
+          elements[n++] = elt;
+      }
+    for (; leaf != NULL; leaf = leaf->next, offset = 0)
+      {
+        memcpy (elements + n, leaf->entries + offset,
+                (leaf->count - offset) * sizeof (const void *));
+        n += leaf->count - offset;
+      }
+  }
+  struct gl_oset_impl new_tree;
+  if (build (&new_tree, n, elements, NULL) < 0)
+    {
+      free (elements);
+      return -1;
+    }
+  free (elements);
+  if (set->root != NULL)
+    free_subtree (set->root, set->height);
+  set->root = new_tree.root;
+  set->height = new_tree.height;
+  set->count = new_tree.count;
+  return 0;
+}
+
+static bool
+gl_btree_remove (gl_oset_t set, const void *elt)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  if (set->root != NULL)
+    {
+      struct btree_path path[MAXHEIGHT];
+      unsigned int offset;
+      bool found;
+      struct btree_leaf *leaf = locate (set, elt, path, &offset, &found);
+      if (found)
+        {
+          const void *old_elt = leaf->entries[offset];
+          remove_at (set, path, leaf, offset);
+          if (set->base.dispose_fn != NULL)
+            set->base.dispose_fn (old_elt);
+          return true;
+        }
+    }
+  return false;
+}
+
+/* Returns the leaf before LEAF, found along PATH, or NULL if LEAF is the
+   first leaf.  */
+static struct btree_leaf * _GL_ATTRIBUTE_PURE
+previous_leaf (gl_oset_t set, struct btree_path *path)
+{
+  unsigned int height = set->height;
+  unsigned int level = height;
+  while (level > 0 && path[level - 1].index == 0)
+    level--;
+  if (level == 0)
+    return NULL;
+  level--;
+  void *node = path[level].branch->children[path[level].index - 1];
+  for (level++; level < height; level++)
+    {
+      struct btree_branch *branch = (struct btree_branch *) node;
+      node = branch->children[branch->count - 1];
+    }
+  return (struct btree_leaf *) node;
+}
+
+/* Frees the nodes in SPARE that have not been used.  */
+static void
+free_spare (struct btree_spare *spare)
+{
+  free (spare->leaf);
+  while (spare->n_branches > 0)
+    free (spare->branches[--spare->n_branches]);
+}
+
+/* Allocates in SPARE the nodes that an insertion into CONTAINER may need,
+   also after the removal of an entry.
+   Returns 0 upon success, -1 upon out-of-memory.  */
+static int
+alloc_spare (CONTAINER_T container, struct btree_spare *spare)
+{
+  unsigned int n_branches =
+    (container->height < MAXHEIGHT ? container->height + 1 : MAXHEIGHT);
+
+  spare->n_branches = 0;
+  spare->leaf = (struct btree_leaf *) malloc (sizeof (struct btree_leaf));
+  if (spare->leaf == NULL)
+    return -1;
+  while (spare->n_branches < n_branches)
+    {
+      struct btree_branch *branch =
+        (struct btree_branch *) malloc (sizeof (struct btree_branch));
+      if (branch == NULL)
+        {
+          free_spare (spare);
+          return -1;
+        }
+      spare->branches[spare->n_branches++] = branch;
+    }
+  return 0;
+}
+
+/* Stores in the branches of the subtree NODE, of the given HEIGHT, the
+   first key of each child, and returns the first key of NODE.  */
+static const void *
+recompute_mins (void *node, unsigned int height)
+{
+  if (height == 0)
+    return ((struct btree_leaf *) node)->entries[0];
+  struct btree_branch *branch = (struct btree_branch *) node;
+  const void *min = recompute_mins (branch->children[0], height - 1);
+  for (unsigned int i = 1; i < branch->count; i++)
+    branch->mins[i] = recompute_mins (branch->children[i], height - 1);
+  return min;
+}
+
+/* Moves the element at OFFSET in LEAF, whose key has become greater than
+   the key of the next element (if FORWARD) or less than the key of the
+   previous element (otherwise), to its new position, by shifting the
+   elements in between by one.  Unlike remove_at and insert_at, this does not
+   allocate memory, but it takes O(n) time.
+   Returns false, without modifying the set, if the element collided with
+   another element.  */
+static bool
+move_by_shifting (gl_oset_t set, struct btree_leaf *leaf, unsigned int offset,
+                  bool forward)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  gl_setelement_compar_fn compar = set->base.compar_fn;
+  const void *elt = leaf->entries[offset];
+
+  if (forward)
+    {
+      /* Count the elements after ELT that are less than ELT.  */
+      size_t n = 0;
+      struct btree_leaf *l = leaf;
+      unsigned int o = offset + 1;
+      for (;;)
+        {
+          if (o == l->count)
+            {
+              l = l->next;
+              o = 0;
+              if (l == NULL)
+                break;
+            }
+          int cmp = compare_keys (compar, l->entries[o], elt);
+          if (cmp == 0)
+            return false;
+          if (cmp > 0)
+            break;
+          n++;
+          o++;
+        }
+      /* Shift them backward, and put ELT after them.  */
+      struct btree_leaf *dest_leaf = leaf;
+      unsigned int dest = offset;
+      struct btree_leaf *src_leaf = leaf;
+      unsigned int src = offset + 1;
+      for (; n > 0; n--)
+        {
+          if (src == src_leaf->count)
+            {
+              src_leaf = src_leaf->next;
+              src = 0;
+            }
+          if (dest == dest_leaf->count)
+            {
+              dest_leaf = dest_leaf->next;
+              dest = 0;
+            }
+          dest_leaf->entries[dest++] = src_leaf->entries[src++];
+        }
+      if (dest == dest_leaf->count)
+        {
+          dest_leaf = dest_leaf->next;
+          dest = 0;
+        }
+      dest_leaf->entries[dest] = elt;
+    }
+  else
+    {
+      /* Find the first element that is greater than ELT.  It comes before
+         ELT's position, since the previous element is greater than ELT.  */
+      struct btree_leaf *l = first_leaf (set);
+      unsigned int o = 0;
+      for (;;)
+        {
+          if (o == l->count)
+            {
+              l = l->next;
+              o = 0;
+            }
+          int cmp = compare_keys (compar, l->entries[o], elt);
+          if (cmp == 0)
+            return false;
+          if (cmp > 0)
+            break;
+          o++;
+        }
+      /* Shift it and the elements up to ELT's position forward, and put ELT
+         before them.  */
+      const void *carry = elt;
+      for (;;)
+        {
+          if (o == l->count)
+            {
+              l = l->next;
+              o = 0;
+            }
+          const void *old = l->entries[o];
+          l->entries[o] = carry;
+          carry = old;
+          if (l == leaf && o == offset)
+            break;
+          o++;
+        }
+    }
+
+  /* The first elements of the leaves in between have changed.  */
+  recompute_mins (set->root, set->height);
+  return true;
+}
+
+static int
+gl_btree_update (gl_oset_t set, const void *elt,
+                 void (*action) (const void * /*elt*/, void * /*action_data*/),
+                 void *action_data)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  /* Like gl_btree_remove, action (...), gl_btree_nx_add, except that we
+     don't actually remove ELT if it stays at the same position.  */
+  /* Remember the old position.  */
+  struct btree_path path[MAXHEIGHT];
+  unsigned int offset;
+  bool found = false;
+  struct btree_leaf *leaf =
+    (set->root != NULL ? locate (set, elt, path, &offset, &found) : NULL);
+  /* Invoke ACTION.  */
+  action (elt, action_data);
+  /* Determine where to put the element now.  */
+  if (found && set->count > 1)
+    {
+      gl_setelement_compar_fn compar = set->base.compar_fn;
+
+      /* Find the neighbours.  */
+      const void *prev_elt = NULL;
+      bool have_prev = true;
+      if (offset > 0)
+        prev_elt = leaf->entries[offset - 1];
+      else
+        {
+          struct btree_leaf *prev_leaf = previous_leaf (set, path);
+          if (prev_leaf != NULL)
+            prev_elt = prev_leaf->entries[prev_leaf->count - 1];
+          else
+            have_prev = false;
+        }
+      const void *next_elt = NULL;
+      bool have_next = true;
+      if (offset + 1 < leaf->count)
+        next_elt = leaf->entries[offset + 1];
+      else if (leaf->next != NULL)
+        next_elt = leaf->next->entries[0];
+      else
+        have_next = false;
+
+      if (!((!have_prev || compare_keys (compar, prev_elt, elt) < 0)
+            && (!have_next || compare_keys (compar, next_elt, elt) > 0)))
+        {
+          /* The element needs to move in the tree.  Since its key has
+             changed, no comparisons must be done with it until it is
+             removed.  Since this function cannot fail, allocate the nodes
+             that putting it back may need before removing it.  */
+          const void *old_elt = leaf->entries[offset];
+          struct btree_spare spare;
+          if (alloc_spare (set, &spare) < 0)
+            {
+              /* Not enough memory.  Move the element in a way that needs
+                 no memory.  */
+              bool forward =
+                have_next && compare_keys (compar, next_elt, elt) <= 0;
+              if (move_by_shifting (set, leaf, offset, forward))
+                return 1;
+              /* Two elements are the same.  */
+              remove_at (set, path, leaf, offset);
+              if (set->base.dispose_fn != NULL)
+                set->base.dispose_fn (old_elt);
+              return -1;
+            }
+
+          remove_at (set, path, leaf, offset);
+
+          int result;
+          leaf = locate (set, elt, path, &offset, &found);
+          if (found)
+            {
+              /* Two elements are the same.  */
+              if (set->base.dispose_fn != NULL)
+                set->base.dispose_fn (old_elt);
+              result = -1;
+            }
+          else
+            {
+              if (insert_at (set, path, leaf, offset, old_elt, &spare) < 0)
+                /* Cannot happen, since the nodes are taken from SPARE.  */
+                abort ();
+              result = 1;
+            }
+          free_spare (&spare);
+          return result;
+        }
+    }
+  return 0;
+}
+
+static void
+gl_btree_oset_free (gl_oset_t set)
+  _GL_OSET_INVOKES_FN_PTR
+{
+  if (set->root != NULL)
+    {
+      if (set->base.dispose_fn != NULL)
+        {
+          gl_setelement_dispose_fn dispose = set->base.dispose_fn;
+          for (struct btree_leaf *leaf = first_leaf (set);
+               leaf != NULL;
+               leaf = leaf->next)
+            for (unsigned int i = 0; i < leaf->count; i++)
+              dispose (leaf->entries[i]);
+        }
+      free_subtree (set->root, set->height);
+    }
+  free (set);
+}
+
+/* --------------------- gl_oset_iterator_t Data Type --------------------- */
+
+/* The iterator fields are:
+     p     the leaf that contains the next element, or NULL at the end,
+     i     the index of the next element in p,
+     q     the next element, so that it can be located again after the last
+           returned element was removed.  */
+
+static gl_oset_iterator_t _GL_ATTRIBUTE_PURE
+gl_btree_iterator (gl_oset_t set)
+{
+  gl_oset_iterator_t result;
+
+  result.vtable = set->base.vtable;
+  result.set = set;
+  result.count = set->count;
+  if (set->root != NULL)
+    {
+      struct btree_leaf *leaf = first_leaf (set);
+      result.p = leaf;
+      result.q = (void *) leaf->entries[0];
+    }
+  else
+    {
+      result.p = NULL;
+      result.q = NULL;
+    }
+  result.i = 0;
+#if defined GCC_LINT || defined lint
+  result.j = 0;
+#endif
+
+  return result;
+}
+
+static gl_oset_iterator_t
+gl_btree_iterator_atleast (gl_oset_t set,
+                           gl_setelement_threshold_fn threshold_fn,
+                           const void *threshold)
+{
+  gl_oset_iterator_t result;
+  unsigned int offset;
+  struct btree_leaf *leaf =
+    locate_atleast (set, threshold_fn, threshold, &offset);
+
+  result.vtable = set->base.vtable;
+  result.set = set;
+  result.count = set->count;
+  result.p = leaf;
+  result.q = (leaf != NULL ? (void *) leaf->entries[offset] : NULL);
+  result.i = offset;
+#if defined GCC_LINT || defined lint
+  result.j = 0;
+#endif
+
+  return result;
+}
+
+static bool
+gl_btree_iterator_next (gl_oset_iterator_t *iterator, const void **eltp)
+{
+  gl_oset_t set = iterator->set;
+  if (iterator->count != set->count)
+    {
+      if (iterator->count != set->count + 1)
+        /* Concurrent modifications were done on the set.  */
+        abort ();
+      /* The last returned element was removed.  The leaves may have been
+         merged, therefore locate the next element again.  */
+      iterator->count--;
+      if (iterator->p != NULL)
+        {
+          unsigned int offset;
+          bool found;
+          iterator->p = locate (set, iterator->q, NULL, &offset, &found);
+          iterator->i = offset;
+        }
+    }
+  struct btree_leaf *leaf = (struct btree_leaf *) iterator->p;
+  if (leaf != NULL)
+    {
+      size_t i = iterator->i;
+      *eltp = leaf->entries[i];
+      i++;
+      if (i == leaf->count)
+        {
+          leaf = leaf->next;
+          iterator->p = leaf;
+          i = 0;
+        }
+      iterator->i = i;
+      if (leaf != NULL)
+        iterator->q = (void *) leaf->entries[i];
+      return true;
+    }
+  else
+    return false;
+}
+
+static void
+gl_btree_iterator_free (gl_oset_iterator_t *_GL_UNNAMED (iterator))
+{
+}
+
+/* For debugging.  */
+extern void gl_btree_oset_check_invariants (gl_oset_t);
+void
+gl_btree_oset_check_invariants (gl_oset_t set)
+{
+  check_all_invariants (set);
+}
+
+const struct gl_oset_implementation gl_btree_oset_implementation =
+  {
+    gl_btree_nx_create_empty,
+    gl_btree_nx_create_empty,
+    gl_btree_nx_create,
+    gl_btree_size,
+    gl_btree_search,
+    gl_btree_search_atleast,
+    gl_btree_nx_add,
+    gl_btree_nx_add_sorted_array,
+    gl_btree_remove,
+    gl_btree_update,
+    gl_btree_oset_free,
+    gl_btree_iterator,
+    gl_btree_iterator_atleast,
+    gl_btree_iterator_next,
+    gl_btree_iterator_free
+  };
@@ -22,7 +22,7 @@
 
 #include <stdint.h>
 #include <stdlib.h>
-/* Get memcpy.  */
+/* Get memcpy, memmove.  */
 #include <string.h>
 
 /* Checked size_t computations.  */
@@ -297,13 +297,17 @@ gl_carray_search_from_to (gl_list_t list, size_t start_index, size_t end_index,
   return INDEX_TO_NODE (index);
 }
 
-/* Ensure that list->allocated > list->count.
+/* Ensure that list->allocated >= NEEDED.
    Return 0 upon success, -1 upon out-of-memory.  */
 static int
-grow (gl_list_t list)
+reserve (gl_list_t list, size_t needed)
 {
+  if (needed <= list->allocated)
+    return 0;
   size_t new_allocated = xtimes (list->allocated, 2);
   new_allocated = xsum (new_allocated, 1);
+  if (new_allocated < needed)
+    new_allocated = needed;
   size_t memory_size = xtimes (new_allocated, sizeof (const void *));
   if (size_overflow_p (memory_size))
     /* Overflow, would lead to out of memory.  */
@@ -343,6 +347,83 @@ grow (gl_list_t list)
   return 0;
 }
 
+/* Ensure that list->allocated > list->count.
+   Return 0 upon success, -1 upon out-of-memory.  */
+static int
+grow (gl_list_t list)
+{
+  return reserve (list, xsum (list->count, 1));
+}
+
+/* Returns the index in list->elements of the element at POSITION,
+   where 0 <= POSITION < list->allocated.  */
+static size_t _GL_ATTRIBUTE_PURE
+physical_index (gl_list_t list, size_t position)
+{
+  size_t i = list->offset + position;
+  if (i >= list->allocated)
+    i -= list->allocated;
+  return i;
+}
+
+/* Moves the N elements that start at index SRC of list->elements to the N
+   slots that start at index DST, wrapping around at the end of the array.
+   BACKWARDS must be true if the slots follow the elements and overlap
+   them, and false if they precede the elements and overlap them.  */
+static void
+move_elements (gl_list_t list, size_t dst, size_t src, size_t n,
+               bool backwards)
+{
+  const void **elements = list->elements;
+  size_t allocated = list->allocated;
+
+  if (!backwards)
+    while (n > 0)
+      {
+        size_t chunk = n;
+        if (chunk > allocated - src)
+          chunk = allocated - src;
+        if (chunk > allocated - dst)
+          chunk = allocated - dst;
+        memmove (&elements[dst], &elements[src],
+                 chunk * sizeof (const void *));
+        n -= chunk;
+        src += chunk;
+        if (src == allocated)
+          src = 0;
+        dst += chunk;
+        if (dst == allocated)
+          dst = 0;
+      }
+  else
+    {
+      /* Here n <= allocated.  */
+      size_t src_end = src + n;
+      if (src_end > allocated)
+        src_end -= allocated;
+      size_t dst_end = dst + n;
+      if (dst_end > allocated)
+        dst_end -= allocated;
+      while (n > 0)
+        {
+          if (src_end == 0)
+            src_end = allocated;
+          if (dst_end == 0)
+            dst_end = allocated;
+          size_t chunk = n;
+          if (chunk > src_end)
+            chunk = src_end;
+          if (chunk > dst_end)
+            chunk = dst_end;
+          src_end -= chunk;
+          dst_end -= chunk;
+          memmove (&elements[dst_end], &elements[src_end],
+                   chunk * sizeof (const void *));
+          n -= chunk;
+        }
+    }
+}
+
 static gl_list_node_t
 gl_carray_nx_add_first (gl_list_t list, const void *elt)
 {
@@ -443,6 +524,50 @@ gl_carray_nx_add_at (gl_list_t list, size_t position, const void *elt)
   return INDEX_TO_NODE (position);
 }
 
+static int
+gl_carray_nx_add_all_at (gl_list_t list, size_t position,
+                         size_t count, const void **contents)
+{
+  size_t old_count = list->count;
+
+  if (!(position <= old_count))
+    /* Invalid argument.  */
+    abort ();
+  if (count > 0)
+    {
+      if (reserve (list, xsum (old_count, count)) < 0)
+        return -1;
+      size_t allocated = list->allocated;
+      if (position <= old_count - position)
+        {
+          /* Shift the elements before POSITION to the left.  */
+          size_t new_offset = list->offset + (allocated - count);
+          if (new_offset >= allocated)
+            new_offset -= allocated;
+          move_elements (list, new_offset, list->offset, position, false);
+          list->offset = new_offset;
+        }
+      else
+        {
+          /* Shift the elements at and after POSITION to the right.  */
+          size_t src = physical_index (list, position);
+          size_t dst = src + count;
+          if (dst >= allocated)
+            dst -= allocated;
+          move_elements (list, dst, src, old_count - position, true);
+        }
+      /* Copy CONTENTS into the gap.  */
+      const void **elements = list->elements;
+      size_t i = physical_index (list, position);
+      size_t chunk = (count <= allocated - i ? count : allocated - i);
+      memcpy (&elements[i], contents, chunk * sizeof (const void *));
+      memcpy (&elements[0], contents + chunk,
+              (count - chunk) * sizeof (const void *));
+      list->count = old_count + count;
+    }
+  return 0;
+}
+
 static gl_list_node_t
 gl_carray_nx_add_before (gl_list_t list, gl_list_node_t node, const void *elt)
 {
@@ -558,6 +683,40 @@ gl_carray_remove_node (gl_list_t list, gl_list_node_t node)
   return gl_carray_remove_at (list, index);
 }
 
+static void
+gl_carray_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  size_t count = list->count;
+
+  if (!(start_index <= end_index && end_index <= count))
+    /* Invalid arguments.  */
+    abort ();
+  if (start_index < end_index)
+    {
+      if (list->base.dispose_fn != NULL)
+        {
+          gl_listelement_dispose_fn dispose = list->base.dispose_fn;
+          for (size_t position = start_index; position < end_index; position++)
+            dispose (list->elements[physical_index (list, position)]);
+        }
+      size_t n = end_index - start_index;
+      if (start_index <= count - end_index)
+        {
+          /* Shift the elements before START_INDEX to the right.  */
+          size_t new_offset = physical_index (list, n);
+          move_elements (list, new_offset, list->offset, start_index, true);
+          list->offset = new_offset;
+        }
+      else
+        /* Shift the elements at and after END_INDEX to the left.  */
+        move_elements (list, physical_index (list, start_index),
+                       physical_index (list, end_index), count - end_index,
+                       false);
+      list->count = count - n;
+    }
+}
+
 static bool
 gl_carray_remove (gl_list_t list, const void *elt)
 {
@@ -742,11 +901,7 @@ gl_carray_sortedlist_indexof_from_to (gl_list_t list,
                     /* The list was not sorted.  */
                     abort ();
                   else /* cmp2 == 0 */
-                    {
-                      if (mid2 == low)
-                        break;
-                      high = mid2 - 1;
-                    }
+                    high = mid2;
                 }
               return low;
             }
@@ -819,6 +974,49 @@ gl_carray_sortedlist_nx_add (gl_list_t list, gl_listelement_compar_fn compar,
   return gl_carray_nx_add_at (list, low, elt);
 }
 
+static int
+gl_carray_sortedlist_nx_merge_array (gl_list_t list,
+                                     gl_listelement_compar_fn compar,
+                                     size_t count, const void **contents)
+  _GL_LIST_INVOKES_FN_PTR
+{
+  if (count > 0)
+    {
+      size_t old_count = list->count;
+
+      if (reserve (list, xsum (old_count, count)) < 0)
+        return -1;
+      /* Merge from the end, so that every element of the list moves at most
+         once.  At each loop iteration, the elements at positions >= k are in
+         their final place, the elements at positions < i and
+         CONTENTS[0..j-1] remain to be merged, and i + j = k.  */
+      const void **elements = list->elements;
+      size_t i = old_count;
+      size_t j = count;
+      size_t k = old_count + count;
+      while (j > 0)
+        {
+          const void *elt;
+          if (i > 0)
+            {
+              size_t i_prev = physical_index (list, i - 1);
+              if (compar (elements[i_prev], contents[j - 1]) > 0)
+                {
+                  elt = elements[i_prev];
+                  i--;
+                }
+              else
+                elt = contents[--j];
+            }
+          else
+            elt = contents[--j];
+          elements[physical_index (list, --k)] = elt;
+        }
+      list->count = old_count + count;
+    }
+  return 0;
+}
+
 static bool
 gl_carray_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
                              const void *elt)
@@ -833,6 +1031,7 @@ gl_carray_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar,
 
 const struct gl_list_implementation gl_carray_list_implementation =
   {
+    gl_carray_nx_create_empty,
     gl_carray_nx_create_empty,
     gl_carray_nx_create,
     gl_carray_size,
@@ -851,8 +1050,10 @@ const struct gl_list_implementation gl_carray_list_implementation =
     gl_carray_nx_add_before,
     gl_carray_nx_add_after,
     gl_carray_nx_add_at,
+    gl_carray_nx_add_all_at,
     gl_carray_remove_node,
     gl_carray_remove_at,
+    gl_carray_remove_range,
     gl_carray_remove,
     gl_carray_list_free,
     gl_carray_iterator,
@@ -864,5 +1065,6 @@ const struct gl_list_implementation gl_carray_list_implementation =
     gl_carray_sortedlist_indexof,
     gl_carray_sortedlist_indexof_from_to,
     gl_carray_sortedlist_nx_add,
+    gl_carray_sortedlist_nx_merge_array,
     gl_carray_sortedlist_remove
   };
@@ -47,6 +47,12 @@ struct gl_map_impl
   size_t table_size;
   struct gl_hash_entry **table
     _GL_ATTRIBUTE_COUNTED_BY (table_size);
+  /* While the hash table grows: the previous table, whose buckets with
+     index >= migrated have not yet been moved to the table.  */
+  size_t old_table_size;
+  struct gl_hash_entry **old_table
+    _GL_ATTRIBUTE_COUNTED_BY (old_table_size);
+  size_t migrated;
   /* Number of hash table entries.  */
   size_t count;
 };
@@ -75,11 +81,14 @@ gl_hash_nx_create_empty (gl_map_implementation_t implementation,
   map->base.kdispose_fn = kdispose_fn;
   map->base.vdispose_fn = vdispose_fn;
   map->hashcode_fn = hashcode_fn;
-  map->table_size = 11;
+  map->table_size = HASH_INITIAL_SIZE;
   map->table =
     (gl_hash_entry_t *) calloc (map->table_size, sizeof (gl_hash_entry_t));
   if (map->table == NULL)
     goto fail;
+  map->old_table_size = 0;
+  map->old_table = NULL;
+  map->migrated = 0;
   map->count = 0;
 
   return map;
@@ -103,11 +112,11 @@ gl_hash_search (gl_map_t map, const void *key, const void **valuep)
     (map->hashcode_fn != NULL
      ? map->hashcode_fn (key)
      : (size_t) {(uintptr_t) key});
-  size_t bucket = hashcode % map->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (map, hashcode);
   gl_mapkey_equals_fn equals = map->base.equals_fn;
 
   /* Look for a match in the hash bucket.  */
-  for (gl_list_node_t node = (gl_list_node_t) map->table[bucket];
+  for (gl_list_node_t node = (gl_list_node_t) *bucket;
        node != NULL;
        node = (gl_list_node_t) node->h.hash_next)
     if (node->h.hashcode == hashcode
@@ -121,6 +130,66 @@ gl_hash_search (gl_map_t map, const void *key, const void **valuep)
   return false;
 }
 
+static size_t
+gl_hash_search_many (gl_map_t map, const void *const *keys, size_t n,
+                     const void **values, bool *found)
+  _GL_MAP_INVOKES_FN_PTR
+{
+  gl_mapkey_equals_fn equals = map->base.equals_fn;
+  size_t count = 0;
+
+  /* A search in a large map typically misses the cache twice: on the hash
+     bucket, then on the first node of the bucket.  So, for a window of
+     keys, compute all the hash codes and prefetch all the buckets, then
+     prefetch all the nodes, and only then search.  */
+  for (size_t i = 0; i < n; i += HASH_SEARCH_WINDOW)
+    {
+      size_t window =
+        (n - i < HASH_SEARCH_WINDOW ? n - i : HASH_SEARCH_WINDOW);
+      size_t hashcodes[HASH_SEARCH_WINDOW];
+      gl_hash_entry_t *buckets[HASH_SEARCH_WINDOW];
+
+      for (size_t k = 0; k < window; k++)
+        {
+          const void *key = keys[i + k];
+          size_t hashcode =
+            (map->hashcode_fn != NULL
+             ? map->hashcode_fn (key)
+             : (size_t) {(uintptr_t) key});
+          hashcodes[k] = hashcode;
+          buckets[k] = hash_bucket (map, hashcode);
+          hash_prefetch (buckets[k]);
+        }
+
+      for (size_t k = 0; k < window; k++)
+        hash_prefetch (*buckets[k]);
+
+      for (size_t k = 0; k < window; k++)
+        {
+          const void *key = keys[i + k];
+          bool match = false;
+
+          values[i + k] = NULL;
+          for (gl_list_node_t node = (gl_list_node_t) *buckets[k];
+               node != NULL;
+               node = (gl_list_node_t) node->h.hash_next)
+            if (node->h.hashcode == hashcodes[k]
+                && (equals != NULL
+                    ? equals (key, node->key)
+                    : key == node->key))
+              {
+                values[i + k] = node->value;
+                match = true;
+                break;
+              }
+          if (found != NULL)
+            found[i + k] = match;
+          count += match;
+        }
+    }
+  return count;
+}
+
 static int
 gl_hash_nx_getput (gl_map_t map, const void *key, const void *value,
                    const void **oldvaluep)
@@ -130,11 +199,11 @@ gl_hash_nx_getput (gl_map_t map, const void *key, const void *value,
     (map->hashcode_fn != NULL
      ? map->hashcode_fn (key)
      : (size_t) {(uintptr_t) key});
-  size_t bucket = hashcode % map->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (map, hashcode);
   gl_mapkey_equals_fn equals = map->base.equals_fn;
 
   /* Look for a match in the hash bucket.  */
-  for (gl_list_node_t node = (gl_list_node_t) map->table[bucket];
+  for (gl_list_node_t node = (gl_list_node_t) *bucket;
        node != NULL;
        node = (gl_list_node_t) node->h.hash_next)
     if (node->h.hashcode == hashcode
@@ -159,8 +228,8 @@ gl_hash_nx_getput (gl_map_t map, const void *key, const void *value,
   node->h.hashcode = hashcode;
 
   /* Add node to the hash table.  */
-  node->h.hash_next = map->table[bucket];
-  map->table[bucket] = &node->h;
+  node->h.hash_next = *bucket;
+  *bucket = &node->h;
 
   /* Add node to the map.  */
   map->count++;
@@ -178,11 +247,11 @@ gl_hash_getremove (gl_map_t map, const void *key, const void **oldvaluep)
     (map->hashcode_fn != NULL
      ? map->hashcode_fn (key)
      : (size_t) {(uintptr_t) key});
-  size_t bucket = hashcode % map->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (map, hashcode);
   gl_mapkey_equals_fn equals = map->base.equals_fn;
 
   /* Look for the first match in the hash bucket.  */
-  for (gl_list_node_t *nodep = (gl_list_node_t *) &map->table[bucket];
+  for (gl_list_node_t *nodep = (gl_list_node_t *) bucket;
        *nodep != NULL;
        nodep = (gl_list_node_t *) &(*nodep)->h.hash_next)
     {
@@ -214,6 +283,8 @@ static void
 gl_hash_free (gl_map_t map)
   _GL_MAP_INVOKES_FN_PTR
 {
+  hash_migrate_all (map);
+
   if (map->count > 0)
     {
       gl_mapkey_dispose_fn kdispose = map->base.kdispose_fn;
@@ -254,6 +325,9 @@ gl_hash_iterator (gl_map_t map)
 {
   gl_map_iterator_t result;
 
+  /* Walk a single table.  */
+  hash_migrate_all (map);
+
   result.vtable = map->base.vtable;
   result.map = map;
   result.p = NULL;         /* runs through the nodes of a bucket */
@@ -320,6 +394,7 @@ const struct gl_map_implementation gl_hash_map_implementation =
     gl_hash_nx_create_empty,
     gl_hash_size,
     gl_hash_search,
+    gl_hash_search_many,
     gl_hash_nx_getput,
     gl_hash_getremove,
     gl_hash_free,
@@ -46,6 +46,12 @@ struct gl_set_impl
   size_t table_size;
   struct gl_hash_entry **table
     _GL_ATTRIBUTE_COUNTED_BY (table_size);
+  /* While the hash table grows: the previous table, whose buckets with
+     index >= migrated have not yet been moved to the table.  */
+  size_t old_table_size;
+  struct gl_hash_entry **old_table
+    _GL_ATTRIBUTE_COUNTED_BY (old_table_size);
+  size_t migrated;
   /* Number of hash table entries.  */
   size_t count;
 };
@@ -72,11 +78,14 @@ gl_hash_nx_create_empty (gl_set_implementation_t implementation,
   set->base.equals_fn = equals_fn;
   set->base.dispose_fn = dispose_fn;
   set->hashcode_fn = hashcode_fn;
-  set->table_size = 11;
+  set->table_size = HASH_INITIAL_SIZE;
   set->table =
     (gl_hash_entry_t *) calloc (set->table_size, sizeof (gl_hash_entry_t));
   if (set->table == NULL)
     goto fail;
+  set->old_table_size = 0;
+  set->old_table = NULL;
+  set->migrated = 0;
   set->count = 0;
 
   return set;
@@ -100,11 +109,11 @@ gl_hash_search (gl_set_t set, const void *elt)
     (set->hashcode_fn != NULL
      ? set->hashcode_fn (elt)
      : (size_t) {(uintptr_t) elt});
-  size_t bucket = hashcode % set->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (set, hashcode);
   gl_setelement_equals_fn equals = set->base.equals_fn;
 
   /* Look for a match in the hash bucket.  */
-  for (gl_list_node_t node = (gl_list_node_t) set->table[bucket];
+  for (gl_list_node_t node = (gl_list_node_t) *bucket;
        node != NULL;
        node = (gl_list_node_t) node->h.hash_next)
     if (node->h.hashcode == hashcode
@@ -123,11 +132,11 @@ gl_hash_nx_add (gl_set_t set, const void *elt)
     (set->hashcode_fn != NULL
      ? set->hashcode_fn (elt)
      : (size_t) {(uintptr_t) elt});
-  size_t bucket = hashcode % set->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (set, hashcode);
   gl_setelement_equals_fn equals = set->base.equals_fn;
 
   /* Look for a match in the hash bucket.  */
-  for (gl_list_node_t node = (gl_list_node_t) set->table[bucket];
+  for (gl_list_node_t node = (gl_list_node_t) *bucket;
        node != NULL;
        node = (gl_list_node_t) node->h.hash_next)
     if (node->h.hashcode == hashcode
@@ -147,8 +156,8 @@ gl_hash_nx_add (gl_set_t set, const void *elt)
   node->h.hashcode = hashcode;
 
   /* Add node to the hash table.  */
-  node->h.hash_next = set->table[bucket];
-  set->table[bucket] = &node->h;
+  node->h.hash_next = *bucket;
+  *bucket = &node->h;
 
   /* Add node to the set.  */
   set->count++;
@@ -166,11 +175,11 @@ gl_hash_remove (gl_set_t set, const void *elt)
     (set->hashcode_fn != NULL
      ? set->hashcode_fn (elt)
      : (size_t) {(uintptr_t) elt});
-  size_t bucket = hashcode % set->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (set, hashcode);
   gl_setelement_equals_fn equals = set->base.equals_fn;
 
   /* Look for the first match in the hash bucket.  */
-  for (gl_list_node_t *nodep = (gl_list_node_t *) &set->table[bucket];
+  for (gl_list_node_t *nodep = (gl_list_node_t *) bucket;
        *nodep != NULL;
        nodep = (gl_list_node_t *) &(*nodep)->h.hash_next)
     {
@@ -200,6 +209,8 @@ static void
 gl_hash_free (gl_set_t set)
   _GL_SET_INVOKES_FN_PTR
 {
+  hash_migrate_all (set);
+
   if (set->count > 0)
     {
       gl_setelement_dispose_fn dispose = set->base.dispose_fn;
@@ -237,6 +248,9 @@ gl_hash_iterator (gl_set_t set)
 {
   gl_set_iterator_t result;
 
+  /* Walk a single table.  */
+  hash_migrate_all (set);
+
   result.vtable = set->base.vtable;
   result.set = set;
   result.p = NULL;         /* runs through the nodes of a bucket */
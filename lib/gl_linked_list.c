@@ -22,6 +22,8 @@
 
 #include <stdlib.h>
 
+#include "gl_nodepool.h"
+
 /* -------------------------- gl_list_t Data Type -------------------------- */
 
 /* Generic linked list code.  */
@@ -32,6 +34,7 @@
 const struct gl_list_implementation gl_linked_list_implementation =
   {
     gl_linked_nx_create_empty,
+    gl_linked_nx_create_empty_with_pool,
     gl_linked_nx_create,
     gl_linked_size,
     gl_linked_node_value,
@@ -49,8 +52,10 @@ const struct gl_list_implementation gl_linked_list_implementation =
     gl_linked_nx_add_before,
     gl_linked_nx_add_after,
     gl_linked_nx_add_at,
+    gl_linked_nx_add_all_at,
     gl_linked_remove_node,
     gl_linked_remove_at,
+    gl_linked_remove_range,
     gl_linked_remove,
     gl_linked_list_free,
     gl_linked_iterator,
@@ -62,5 +67,6 @@ const struct gl_list_implementation gl_linked_list_implementation =
     gl_linked_sortedlist_indexof,
     gl_linked_sortedlist_indexof_from_to,
     gl_linked_sortedlist_nx_add,
+    gl_linked_sortedlist_nx_merge_array,
     gl_linked_sortedlist_remove
   };
@@ -23,6 +23,7 @@
 #include <stdint.h> /* for uintptr_t, SIZE_MAX */
 #include <stdlib.h>
 
+#include "gl_nodepool.h"
 #include "xsize.h"
 
 #define WITH_HASHTABLE 1
@@ -44,10 +45,10 @@
 static void
 add_to_bucket (gl_list_t list, gl_list_node_t node)
 {
-  size_t bucket = node->h.hashcode % list->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (list, node->h.hashcode);
 
-  node->h.hash_next = list->table[bucket];
-  list->table[bucket] = &node->h;
+  node->h.hash_next = *bucket;
+  *bucket = &node->h;
 }
 /* Tell all compilers that the return value is 0.  */
 #define add_to_bucket(list,node)  ((add_to_bucket) (list, node), 0)
@@ -56,9 +57,9 @@ add_to_bucket (gl_list_t list, gl_list_node_t node)
 static void
 remove_from_bucket (gl_list_t list, gl_list_node_t node)
 {
-  size_t bucket = node->h.hashcode % list->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (list, node->h.hashcode);
 
-  for (gl_hash_entry_t *p = &list->table[bucket]; ; p = &(*p)->hash_next)
+  for (gl_hash_entry_t *p = bucket; ; p = &(*p)->hash_next)
     {
       if (*p == &node->h)
         {
@@ -79,6 +80,7 @@ remove_from_bucket (gl_list_t list, gl_list_node_t node)
 const struct gl_list_implementation gl_linkedhash_list_implementation =
   {
     gl_linked_nx_create_empty,
+    gl_linked_nx_create_empty_with_pool,
     gl_linked_nx_create,
     gl_linked_size,
     gl_linked_node_value,
@@ -96,8 +98,10 @@ const struct gl_list_implementation gl_linkedhash_list_implementation =
     gl_linked_nx_add_before,
     gl_linked_nx_add_after,
     gl_linked_nx_add_at,
+    gl_linked_nx_add_all_at,
     gl_linked_remove_node,
     gl_linked_remove_at,
+    gl_linked_remove_range,
     gl_linked_remove,
     gl_linked_list_free,
     gl_linked_iterator,
@@ -109,5 +113,6 @@ const struct gl_list_implementation gl_linkedhash_list_implementation =
     gl_linked_sortedlist_indexof,
     gl_linked_sortedlist_indexof_from_to,
     gl_linked_sortedlist_nx_add,
+    gl_linked_sortedlist_nx_merge_array,
     gl_linked_sortedlist_remove
   };
@@ -48,6 +48,12 @@ struct gl_set_impl
   size_t table_size;
   struct gl_hash_entry **table
     _GL_ATTRIBUTE_COUNTED_BY (table_size);
+  /* While the hash table grows: the previous table, whose buckets with
+     index >= migrated have not yet been moved to the table.  */
+  size_t old_table_size;
+  struct gl_hash_entry **old_table
+    _GL_ATTRIBUTE_COUNTED_BY (old_table_size);
+  size_t migrated;
   /* A circular list anchored at root.
      The first node is = root.next, the last node is = root.prev.
      The root's value is unused.  */
@@ -95,11 +101,14 @@ gl_linkedhash_nx_create_empty (gl_set_implementation_t implementation,
   set->base.equals_fn = equals_fn;
   set->base.dispose_fn = dispose_fn;
   set->hashcode_fn = hashcode_fn;
-  set->table_size = 11;
+  set->table_size = HASH_INITIAL_SIZE;
   set->table =
     (gl_hash_entry_t *) calloc (set->table_size, sizeof (gl_hash_entry_t));
   if (set->table == NULL)
     goto fail;
+  set->old_table_size = 0;
+  set->old_table = NULL;
+  set->migrated = 0;
   set->root.next = &set->root;
   set->root.prev = &set->root;
   set->count = 0;
@@ -124,11 +133,11 @@ gl_linkedhash_search (gl_set_t set, const void *elt)
     (set->hashcode_fn != NULL
      ? set->hashcode_fn (elt)
      : (size_t) {(uintptr_t) elt});
-  size_t bucket = hashcode % set->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (set, hashcode);
   gl_setelement_equals_fn equals = set->base.equals_fn;
 
   /* Look for a match in the hash bucket.  */
-  for (gl_list_node_t node = (gl_list_node_t) set->table[bucket];
+  for (gl_list_node_t node = (gl_list_node_t) *bucket;
        node != NULL;
        node = (gl_list_node_t) node->h.hash_next)
     if (node->h.hashcode == hashcode
@@ -146,11 +155,11 @@ gl_linkedhash_nx_add (gl_set_t set, const void *elt)
     (set->hashcode_fn != NULL
      ? set->hashcode_fn (elt)
      : (size_t) {(uintptr_t) elt});
-  size_t bucket = hashcode % set->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (set, hashcode);
   gl_setelement_equals_fn equals = set->base.equals_fn;
 
   /* Look for a match in the hash bucket.  */
-  for (gl_list_node_t node = (gl_list_node_t) set->table[bucket];
+  for (gl_list_node_t node = (gl_list_node_t) *bucket;
        node != NULL;
        node = (gl_list_node_t) node->h.hash_next)
     if (node->h.hashcode == hashcode
@@ -170,8 +179,8 @@ gl_linkedhash_nx_add (gl_set_t set, const void *elt)
   node->h.hashcode = hashcode;
 
   /* Add node to the hash table.  */
-  node->h.hash_next = set->table[bucket];
-  set->table[bucket] = &node->h;
+  node->h.hash_next = *bucket;
+  *bucket = &node->h;
 
   /* Add node to the set.  */
   ASYNCSAFE(gl_list_node_t) node->next = &set->root;
@@ -192,11 +201,11 @@ gl_linkedhash_remove (gl_set_t set, const void *elt)
     (set->hashcode_fn != NULL
      ? set->hashcode_fn (elt)
      : (size_t) {(uintptr_t) elt});
-  size_t bucket = hashcode % set->table_size;
+  gl_hash_entry_t *bucket = hash_bucket (set, hashcode);
   gl_setelement_equals_fn equals = set->base.equals_fn;
 
   /* Look for the first match in the hash bucket.  */
-  for (gl_list_node_t *nodep = (gl_list_node_t *) &set->table[bucket];
+  for (gl_list_node_t *nodep = (gl_list_node_t *) bucket;
        *nodep != NULL;
        nodep = (gl_list_node_t *) &(*nodep)->h.hash_next)
     {
@@ -242,6 +251,7 @@ gl_linkedhash_free (gl_set_t set)
       free (node);
       node = next;
     }
+  free (set->old_table);
   free (set->table);
   free (set);
 }
@@ -54,6 +54,7 @@ extern "C" {
      GL_LINKED_LIST       a linked list
      GL_AVLTREE_LIST      a binary tree (AVL tree)
      GL_RBTREE_LIST       a binary tree (red-black tree)
+     GL_BTREE_LIST        a B+ tree
      GL_LINKEDHASH_LIST   a hash table with a linked list
      GL_AVLTREEHASH_LIST  a hash table with a binary tree (AVL tree)
      GL_RBTREEHASH_LIST   a hash table with a binary tree (red-black tree)
@@ -61,7 +62,8 @@ extern "C" {
    The memory consumption is asymptotically the same: O(1) for every object
    in the list.  When looking more closely at the average memory consumed
    for an object, GL_ARRAY_LIST is the most compact representation, and
-   GL_LINKEDHASH_LIST and GL_TREEHASH_LIST need more memory.
+   GL_LINKEDHASH_LIST and GL_TREEHASH_LIST need more memory.  GL_BTREE_LIST
+   needs about as little memory as GL_ARRAY_LIST.
 
    The guaranteed average performance of the operations is, for a list of
    n elements:
@@ -108,6 +110,22 @@ extern "C" {
    gl_sortedlist_indexof_fro O(log n)   O(n)   O(log n)    O(n)       O(log n)
    gl_sortedlist_add           O(n)     O(n)   O(log n)    O(n)    O((log n)²)/O(log n)
    gl_sortedlist_remove        O(n)     O(n)   O(log n)    O(n)    O((log n)²)/O(log n)
+
+   GL_BTREE_LIST has the performance of the TREE column, except that
+   gl_list_node_value and gl_list_node_set_value are O(log n), that
+   gl_list_next_node, gl_list_previous_node, gl_list_first_node,
+   gl_list_last_node are O(1), that gl_list_iterator_next is O(1), and that
+   the gl_sortedlist_* operations are O((log n)²).  It keeps the elements in
+   contiguous arrays of a few dozen elements, which makes gl_list_get_at,
+   gl_list_add_at, and iterations several times faster than with
+   GL_AVLTREE_LIST or GL_RBTREE_LIST on large lists.
+
+   The bulk operations gl_list_add_all_at, gl_list_remove_range, and
+   gl_sortedlist_merge_array on k elements take O(n + k) time with the
+   ARRAY, CARRAY, LINKED, and LINKEDHASH implementations.  With the TREE and
+   TREEHASH implementations and GL_BTREE_LIST, they take O(k log n) time
+   when k is small compared to n, and otherwise rebuild the tree in a
+   single O(n + k) pass.
  */
 
 /* -------------------------- gl_list_t Data Type -------------------------- */
@@ -142,8 +160,8 @@ typedef const struct gl_list_implementation * gl_list_implementation_t;
 
 /* Creates an empty list.
    IMPLEMENTATION is one of GL_ARRAY_LIST, GL_CARRAY_LIST, GL_LINKED_LIST,
-   GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_LINKEDHASH_LIST, GL_AVLTREEHASH_LIST,
-   GL_RBTREEHASH_LIST.
+   GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_BTREE_LIST, GL_LINKEDHASH_LIST,
+   GL_AVLTREEHASH_LIST, GL_RBTREEHASH_LIST.
    EQUALS_FN is an element comparison function or NULL.
    HASHCODE_FN is an element hash code function or NULL.
    DISPOSE_FN is an element disposal function or NULL.
@@ -165,10 +183,36 @@ extern gl_list_t gl_list_nx_create_empty (gl_list_implementation_t implementatio
                                           bool allow_duplicates)
   /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/;
 
+/* Creates an empty list whose nodes are allocated from a pool that belongs
+   to the list.  The pool takes memory from malloc in large slabs, reuses the
+   nodes of removed elements, and gives all its memory back at once in
+   gl_list_free.  This saves most of the calls to malloc and free that the
+   node based implementations GL_LINKED_LIST, GL_AVLTREE_LIST, GL_RBTREE_LIST,
+   GL_LINKEDHASH_LIST, GL_AVLTREEHASH_LIST, GL_RBTREEHASH_LIST otherwise make
+   for every element, at the price of not returning the memory of removed
+   elements to malloc before the list is freed.  For the other
+   implementations, this function is the same as gl_list_create_empty.
+   The parameters are the same as for gl_list_create_empty.  */
+/* declared in gl_xlist.h */
+extern gl_list_t gl_list_create_empty_with_pool (gl_list_implementation_t implementation,
+                                                 gl_listelement_equals_fn equals_fn,
+                                                 gl_listelement_hashcode_fn hashcode_fn,
+                                                 gl_listelement_dispose_fn dispose_fn,
+                                                 bool allow_duplicates)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+/* Likewise.  Returns NULL upon out-of-memory.  */
+extern gl_list_t gl_list_nx_create_empty_with_pool (gl_list_implementation_t implementation,
+                                                    gl_listelement_equals_fn equals_fn,
+                                                    gl_listelement_hashcode_fn hashcode_fn,
+                                                    gl_listelement_dispose_fn dispose_fn,
+                                                    bool allow_duplicates)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/;
+
 /* Creates a list with given contents.
    IMPLEMENTATION is one of GL_ARRAY_LIST, GL_CARRAY_LIST, GL_LINKED_LIST,
-   GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_LINKEDHASH_LIST, GL_AVLTREEHASH_LIST,
-   GL_RBTREEHASH_LIST.
+   GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_BTREE_LIST, GL_LINKEDHASH_LIST,
+   GL_AVLTREEHASH_LIST, GL_RBTREEHASH_LIST.
    EQUALS_FN is an element comparison function or NULL.
    HASHCODE_FN is an element hash code function or NULL.
    DISPOSE_FN is an element disposal function or NULL.
@@ -357,6 +401,19 @@ _GL_ATTRIBUTE_NODISCARD
 extern gl_list_node_t gl_list_nx_add_at (gl_list_t list, size_t position,
                                          const void *elt);
 
+/* Adds COUNT elements at a given position in the list.
+   POSITION must be >= 0 and <= gl_list_size (list).
+   CONTENTS[0..COUNT-1] are the elements to add; afterwards, CONTENTS[i] is
+   at position POSITION + i.  */
+/* declared in gl_xlist.h */
+extern void gl_list_add_all_at (gl_list_t list, size_t position,
+                                size_t count, const void **contents);
+/* Likewise.  Returns 0 upon success, -1 upon out-of-memory.  Upon
+   out-of-memory, the list is left unchanged.  */
+_GL_ATTRIBUTE_NODISCARD
+extern int gl_list_nx_add_all_at (gl_list_t list, size_t position,
+                                  size_t count, const void **contents);
+
 /* Removes an element from the list.
    Returns true.  */
 extern bool gl_list_remove_node (gl_list_t list, gl_list_node_t node);
@@ -366,6 +423,13 @@ extern bool gl_list_remove_node (gl_list_t list, gl_list_node_t node);
    Returns true.  */
 extern bool gl_list_remove_at (gl_list_t list, size_t position);
 
+/* Removes the elements at the positions >= START_INDEX and < END_INDEX from
+   the list.
+   START_INDEX and END_INDEX must satisfy
+   0 <= START_INDEX <= END_INDEX <= gl_list_size (list).  */
+extern void gl_list_remove_range (gl_list_t list,
+                                  size_t start_index, size_t end_index);
+
 /* Removes the element at the first position from the list.
    Returns true if it was found and removed, or false if the list was empty.  */
 extern bool gl_list_remove_first (gl_list_t list);
@@ -501,6 +565,21 @@ extern gl_list_node_t gl_sortedlist_nx_add (gl_list_t list,
                                             gl_listelement_compar_fn compar,
                                             const void *elt);
 
+/* Adds COUNT elements at the appropriate positions in the list.
+   The list is assumed to be sorted with COMPAR, and CONTENTS[0..COUNT-1]
+   must be sorted with COMPAR as well.
+   The relative order of elements that compare equal is unspecified.  */
+/* declared in gl_xlist.h */
+extern void gl_sortedlist_merge_array (gl_list_t list,
+                                       gl_listelement_compar_fn compar,
+                                       size_t count, const void **contents);
+/* Likewise.  Returns 0 upon success, -1 upon out-of-memory.  Upon
+   out-of-memory, the list is left unchanged.  */
+_GL_ATTRIBUTE_NODISCARD
+extern int gl_sortedlist_nx_merge_array (gl_list_t list,
+                                         gl_listelement_compar_fn compar,
+                                         size_t count, const void **contents);
+
 /* Searches and removes an element from the list.
    The list is assumed to be sorted with COMPAR.
    Returns true if it was found and removed.
@@ -522,6 +601,11 @@ struct gl_list_implementation
                                 gl_listelement_hashcode_fn hashcode_fn,
                                 gl_listelement_dispose_fn dispose_fn,
                                 bool allow_duplicates);
+  gl_list_t (*nx_create_empty_with_pool) (gl_list_implementation_t implementation,
+                                          gl_listelement_equals_fn equals_fn,
+                                          gl_listelement_hashcode_fn hashcode_fn,
+                                          gl_listelement_dispose_fn dispose_fn,
+                                          bool allow_duplicates);
   gl_list_t (*nx_create) (gl_list_implementation_t implementation,
                           gl_listelement_equals_fn equals_fn,
                           gl_listelement_hashcode_fn hashcode_fn,
@@ -551,8 +635,11 @@ struct gl_list_implementation
                                   const void *elt);
   gl_list_node_t (*nx_add_at) (gl_list_t list, size_t position,
                                const void *elt);
+  int (*nx_add_all_at) (gl_list_t list, size_t position,
+                        size_t count, const void **contents);
   bool (*remove_node) (gl_list_t list, gl_list_node_t node);
   bool (*remove_at) (gl_list_t list, size_t position);
+  void (*remove_range) (gl_list_t list, size_t start_index, size_t end_index);
   bool (*remove_elt) (gl_list_t list, const void *elt);
   void (*list_free) (gl_list_t list);
   /* gl_list_iterator_t functions.  */
@@ -582,6 +669,9 @@ struct gl_list_implementation
   gl_list_node_t (*sortedlist_nx_add) (gl_list_t list,
                                        gl_listelement_compar_fn compar,
                                     const void *elt);
+  int (*sortedlist_nx_merge_array) (gl_list_t list,
+                                    gl_listelement_compar_fn compar,
+                                    size_t count, const void **contents);
   bool (*sortedlist_remove) (gl_list_t list,
                              gl_listelement_compar_fn compar,
                              const void *elt);
@@ -613,6 +703,20 @@ gl_list_nx_create_empty (gl_list_implementation_t implementation,
                                           allow_duplicates);
 }
 
+GL_LIST_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
+gl_list_t
+gl_list_nx_create_empty_with_pool (gl_list_implementation_t implementation,
+                                   gl_listelement_equals_fn equals_fn,
+                                   gl_listelement_hashcode_fn hashcode_fn,
+                                   gl_listelement_dispose_fn dispose_fn,
+                                   bool allow_duplicates)
+{
+  return implementation->nx_create_empty_with_pool (implementation, equals_fn,
+                                                    hashcode_fn, dispose_fn,
+                                                    allow_duplicates);
+}
+
 GL_LIST_INLINE
 /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
 gl_list_t
@@ -799,6 +903,14 @@ gl_list_nx_add_at (gl_list_t list, size_t position, const void *elt)
          ->nx_add_at (list, position, elt);
 }
 
+_GL_ATTRIBUTE_NODISCARD GL_LIST_INLINE int
+gl_list_nx_add_all_at (gl_list_t list, size_t position,
+                       size_t count, const void **contents)
+{
+  return ((const struct gl_list_impl_base *) list)->vtable
+         ->nx_add_all_at (list, position, count, contents);
+}
+
 GL_LIST_INLINE bool
 gl_list_remove_node (gl_list_t list, gl_list_node_t node)
 {
@@ -813,6 +925,13 @@ gl_list_remove_at (gl_list_t list, size_t position)
          ->remove_at (list, position);
 }
 
+GL_LIST_INLINE void
+gl_list_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+{
+  ((const struct gl_list_impl_base *) list)->vtable
+    ->remove_range (list, start_index, end_index);
+}
+
 GL_LIST_INLINE bool
 gl_list_remove_first (gl_list_t list)
 {
@@ -910,6 +1029,14 @@ gl_sortedlist_nx_add (gl_list_t list, gl_listelement_compar_fn compar, const voi
          ->sortedlist_nx_add (list, compar, elt);
 }
 
+_GL_ATTRIBUTE_NODISCARD GL_LIST_INLINE int
+gl_sortedlist_nx_merge_array (gl_list_t list, gl_listelement_compar_fn compar,
+                              size_t count, const void **contents)
+{
+  return ((const struct gl_list_impl_base *) list)->vtable
+         ->sortedlist_nx_merge_array (list, compar, count, contents);
+}
+
 GL_LIST_INLINE bool
 gl_sortedlist_remove (gl_list_t list, gl_listelement_compar_fn compar, const void *elt)
 {
@@ -45,8 +45,8 @@ public:
 
   /* Creates an empty list.
      IMPLEMENTATION is one of GL_ARRAY_LIST, GL_CARRAY_LIST, GL_LINKED_LIST,
-     GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_LINKEDHASH_LIST, GL_AVLTREEHASH_LIST,
-     GL_RBTREEHASH_LIST.
+     GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_BTREE_LIST, GL_LINKEDHASH_LIST,
+     GL_AVLTREEHASH_LIST, GL_RBTREEHASH_LIST.
      EQUALS_FN is an element comparison function or NULL.
      HASHCODE_FN is an element hash code function or NULL.
      DISPOSE_FN is an element disposal function or NULL.
@@ -66,8 +66,8 @@ public:
 
   /* Creates a list with given contents.
      IMPLEMENTATION is one of GL_ARRAY_LIST, GL_CARRAY_LIST, GL_LINKED_LIST,
-     GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_LINKEDHASH_LIST, GL_AVLTREEHASH_LIST,
-     GL_RBTREEHASH_LIST.
+     GL_AVLTREE_LIST, GL_RBTREE_LIST, GL_BTREE_LIST, GL_LINKEDHASH_LIST,
+     GL_AVLTREEHASH_LIST, GL_RBTREEHASH_LIST.
      EQUALS_FN is an element comparison function or NULL.
      HASHCODE_FN is an element hash code function or NULL.
      DISPOSE_FN is an element disposal function or NULL.
@@ -95,7 +95,8 @@ public:
        - Modifications to the sublist affect the whole list.
        - Modifications to the whole list are immediately visible in the sublist.
        - The sublist is only valid as long as the whole list is valid.
-       - The sublist must not be passed to the gl_list_sortedlist_add() function.
+       - The sublist must not be passed to the gl_list_sortedlist_add() and
+         gl_sortedlist_merge_array() functions.
    */
   gl_List (const gl_List& whole_list, size_t start_index, size_t end_index)
     : _ptr (gl_sublist_create (whole_list._ptr, start_index, end_index))
@@ -240,6 +241,11 @@ public:
   gl_list_node_t add_at (size_t position, ELTYPE * elt)
     { return gl_list_add_at (_ptr, position, elt); }
 
+  /* Adds the elements CONTENTS[0..COUNT-1] at a given position in the list.
+     POSITION must be >= 0 and <= gl_list_size (list).  */
+  void add_all_at (size_t position, size_t count, ELTYPE **contents)
+    { gl_list_add_all_at (_ptr, position, count, reinterpret_cast<const void **>(contents)); }
+
   /* Removes an element from the list.
      Returns true.  */
   bool remove_node (gl_list_node_t node)
@@ -251,6 +257,11 @@ public:
   bool remove_at (size_t position)
     { return gl_list_remove_at (_ptr, position); }
 
+  /* Removes the elements at positions >= START_INDEX and < END_INDEX from the
+     list.  */
+  void remove_range (size_t start_index, size_t end_index)
+    { gl_list_remove_range (_ptr, start_index, end_index); }
+
   /* Removes the element at the first position from the list.
      Returns true if it was found and removed,
      or false if the list was empty.  */
@@ -333,6 +344,13 @@ public:
                                  ELTYPE * elt)
     { return gl_sortedlist_add (_ptr, reinterpret_cast<gl_listelement_compar_fn>(compar), elt); }
 
+  /* Adds the elements CONTENTS[0..COUNT-1], which are sorted with COMPAR, at
+     the appropriate positions in the list.
+     The list is assumed to be sorted with COMPAR.  */
+  void sortedlist_merge_array (int (*compar) (ELTYPE * /*elt1*/, ELTYPE * /*elt2*/),
+                               size_t count, ELTYPE **contents)
+    { gl_sortedlist_merge_array (_ptr, reinterpret_cast<gl_listelement_compar_fn>(compar), count, reinterpret_cast<const void **>(contents)); }
+
   /* Searches and removes an element from the list.
      The list is assumed to be sorted with COMPAR.
      Returns true if it was found and removed.
@@ -418,4 +436,543 @@ public:
     { return iterator (_ptr, start_index, end_index); }
 };
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* gl_ValueList is a sequential list that stores its elements of type ELTYPE
+   by value.
+
+   Unlike gl_List, it does not go through the gl_list vtable: all operations
+   are inline member functions, and the element equality EQUAL is a template
+   parameter, so that the compiler can inline it.
+   It is implemented as a circular array, like GL_CARRAY_LIST: access by
+   position is O(1), adding or removing an element is O(1) at either end and
+   O(n) elsewhere, where only the shorter part of the list is moved.
+
+   Unlike gl_List, it owns its elements: copying a gl_ValueList copies the
+   elements, and the destructor destroys them.
+   Upon out-of-memory, the member functions throw std::bad_alloc.
+   The move constructor, move assignment and destructor of ELTYPE must not
+   throw.
+
+   This class requires C++11 or newer.  */
+
+template <class ELTYPE, class EQUAL = std::equal_to<ELTYPE> >
+class gl_ValueList
+{
+public:
+  // ------------------------------ Constructors ------------------------------
+
+  /* Creates an empty list.
+     EQUAL is the element comparison function object.  */
+  explicit gl_ValueList (const EQUAL& equal = EQUAL ())
+    : _equal (equal), _elements (NULL), _offset (0), _count (0), _allocated (0)
+    {}
+
+  /* Copy constructor.  Copies the elements.  */
+  gl_ValueList (const gl_ValueList& x)
+    : _equal (x._equal), _elements (NULL), _offset (0), _count (0), _allocated (0)
+    {
+      if (x._count > 0)
+        {
+          _elements = allocate (x._count);
+          _allocated = x._count;
+          try
+            {
+              for (; _count < x._count; _count++)
+                ::new (static_cast<void *>(_elements + _count)) ELTYPE (x[_count]);
+            }
+          catch (...)
+            {
+              destroy ();
+              throw;
+            }
+        }
+    }
+
+  /* Move constructor.  Leaves X empty.  */
+  gl_ValueList (gl_ValueList&& x) noexcept
+    : _equal (std::move (x._equal)),
+      _elements (x._elements), _offset (x._offset), _count (x._count),
+      _allocated (x._allocated)
+    {
+      x._elements = NULL;
+      x._offset = 0;
+      x._count = 0;
+      x._allocated = 0;
+    }
+
+  /* Assignment operator.  Copies or moves the elements of X.  */
+  gl_ValueList& operator= (gl_ValueList x)
+    { swap (x); return *this; }
+
+  // ------------------------------- Destructor -------------------------------
+
+  ~gl_ValueList ()
+    { destroy (); }
+
+  // ----------------------- Read-only member functions -----------------------
+
+  /* Returns the current number of elements in the list.  */
+  size_t size () const
+    { return _count; }
+
+  /* Returns true if the list is empty.  */
+  bool empty () const
+    { return _count == 0; }
+
+  /* Returns the element at a given position in the list.
+     POSITION must be >= 0 and < size().  */
+  const ELTYPE& operator[] (size_t position) const
+    { return *slot (position); }
+  ELTYPE& operator[] (size_t position)
+    { return *slot (position); }
+
+  /* Returns the element at a given position in the list.
+     Aborts if POSITION is not >= 0 and < size().  */
+  const ELTYPE& get_at (size_t position) const
+    {
+      if (!(position < _count))
+        /* Invalid argument.  */
+        abort ();
+      return *slot (position);
+    }
+
+  /* Returns the first element of the list.
+     Aborts if the list is empty.  */
+  const ELTYPE& get_first () const
+    { return get_at (0); }
+
+  /* Returns the last element of the list.
+     Aborts if the list is empty.  */
+  const ELTYPE& get_last () const
+    { return get_at (_count - 1); }
+
+  /* Searches whether an element is already in the list.
+     Returns its position if found, or (size_t)(-1) if not present in the list.
+     If the list contains several copies of ELT, the position of the leftmost
+     one is returned.  */
+  size_t indexof (const ELTYPE& elt) const
+    {
+      for (size_t i = 0; i < _count; i++)
+        if (_equal (*slot (i), elt))
+          return i;
+      return (size_t)(-1);
+    }
+
+  // ----------------------- Modifying member functions -----------------------
+
+  /* Replaces the element at a given position in the list.
+     Aborts if POSITION is not >= 0 and < size().  */
+  void set_at (size_t position, const ELTYPE& elt)
+    {
+      if (!(position < _count))
+        /* Invalid argument.  */
+        abort ();
+      *slot (position) = elt;
+    }
+  void set_at (size_t position, ELTYPE&& elt)
+    {
+      if (!(position < _count))
+        /* Invalid argument.  */
+        abort ();
+      *slot (position) = std::move (elt);
+    }
+
+  /* Adds an element as the first element of the list.  */
+  void add_first (const ELTYPE& elt)
+    { emplace_first (elt); }
+  void add_first (ELTYPE&& elt)
+    { emplace_first (std::move (elt)); }
+
+  /* Adds an element as the last element of the list.  */
+  void add_last (const ELTYPE& elt)
+    { emplace_last (elt); }
+  void add_last (ELTYPE&& elt)
+    { emplace_last (std::move (elt)); }
+
+  /* Adds an element at a given position in the list.
+     Aborts if POSITION is not >= 0 and <= size().  */
+  void add_at (size_t position, const ELTYPE& elt)
+    { emplace_at (position, elt); }
+  void add_at (size_t position, ELTYPE&& elt)
+    { emplace_at (position, std::move (elt)); }
+
+  /* Constructs an element from ARGS as the first element of the list.
+     Returns a reference to it.  */
+  template <class... ARGS>
+  ELTYPE& emplace_first (ARGS&&... args)
+    {
+      if (_count < _allocated)
+        {
+          size_t new_offset = (_offset == 0 ? _allocated : _offset) - 1;
+          ::new (static_cast<void *>(_elements + new_offset))
+            ELTYPE (std::forward<ARGS>(args)...);
+          _offset = new_offset;
+        }
+      else
+        grow_with (0, std::forward<ARGS>(args)...);
+      _count++;
+      return *slot (0);
+    }
+
+  /* Constructs an element from ARGS as the last element of the list.
+     Returns a reference to it.  */
+  template <class... ARGS>
+  ELTYPE& emplace_last (ARGS&&... args)
+    {
+      if (_count < _allocated)
+        ::new (static_cast<void *>(slot (_count)))
+          ELTYPE (std::forward<ARGS>(args)...);
+      else
+        grow_with (_count, std::forward<ARGS>(args)...);
+      _count++;
+      return *slot (_count - 1);
+    }
+
+  /* Constructs an element from ARGS at a given position in the list.
+     Returns a reference to it.
+     Aborts if POSITION is not >= 0 and <= size().  */
+  template <class... ARGS>
+  ELTYPE& emplace_at (size_t position, ARGS&&... args)
+    {
+      if (!(position <= _count))
+        /* Invalid argument.  */
+        abort ();
+      if (position == 0)
+        return emplace_first (std::forward<ARGS>(args)...);
+      if (position == _count)
+        return emplace_last (std::forward<ARGS>(args)...);
+      if (_count == _allocated)
+        grow_with (position, std::forward<ARGS>(args)...);
+      else
+        {
+          /* Construct the element before moving others, since ARGS may refer
+             to elements of the list.  */
+          ELTYPE elt (std::forward<ARGS>(args)...);
+          if (position < _count - position)
+            {
+              /* Move the elements before POSITION one slot to the left.  */
+              _offset = (_offset == 0 ? _allocated : _offset) - 1;
+              ::new (static_cast<void *>(slot (0))) ELTYPE (std::move (*slot (1)));
+              for (size_t i = 1; i < position; i++)
+                *slot (i) = std::move (*slot (i + 1));
+            }
+          else
+            {
+              /* Move the elements at and after POSITION one slot to the
+                 right.  */
+              ::new (static_cast<void *>(slot (_count)))
+                ELTYPE (std::move (*slot (_count - 1)));
+              for (size_t i = _count - 1; i > position; i--)
+                *slot (i) = std::move (*slot (i - 1));
+            }
+          *slot (position) = std::move (elt);
+        }
+      _count++;
+      return *slot (position);
+    }
+
+  /* Removes the element at a given position from the list.
+     Aborts if POSITION is not >= 0 and < size().  */
+  void remove_at (size_t position)
+    {
+      if (!(position < _count))
+        /* Invalid argument.  */
+        abort ();
+      if (position < _count - 1 - position)
+        {
+          for (size_t i = position; i > 0; i--)
+            *slot (i) = std::move (*slot (i - 1));
+          slot (0)->~ELTYPE ();
+          _offset = (_offset + 1 == _allocated ? 0 : _offset + 1);
+        }
+      else
+        {
+          for (size_t i = position; i + 1 < _count; i++)
+            *slot (i) = std::move (*slot (i + 1));
+          slot (_count - 1)->~ELTYPE ();
+        }
+      _count--;
+    }
+
+  /* Removes the element at the first position from the list.
+     Returns true if it was found and removed, or false if the list was
+     empty.  */
+  bool remove_first ()
+    {
+      if (_count == 0)
+        return false;
+      remove_at (0);
+      return true;
+    }
+
+  /* Removes the element at the last position from the list.
+     Returns true if it was found and removed, or false if the list was
+     empty.  */
+  bool remove_last ()
+    {
+      if (_count == 0)
+        return false;
+      remove_at (_count - 1);
+      return true;
+    }
+
+  /* Removes the elements with indices i, start_index <= i < end_index, from
+     the list.
+     Aborts if not 0 <= START_INDEX <= END_INDEX <= size().  */
+  void remove_range (size_t start_index, size_t end_index)
+    {
+      if (!(start_index <= end_index && end_index <= _count))
+        /* Invalid arguments.  */
+        abort ();
+      size_t n = end_index - start_index;
+      if (n == 0)
+        return;
+      if (start_index < _count - end_index)
+        {
+          for (size_t i = start_index; i > 0; i--)
+            *slot (i - 1 + n) = std::move (*slot (i - 1));
+          for (size_t i = 0; i < n; i++)
+            slot (i)->~ELTYPE ();
+          _offset += n;
+          if (_offset >= _allocated)
+            _offset -= _allocated;
+        }
+      else
+        {
+          for (size_t i = end_index; i < _count; i++)
+            *slot (i - n) = std::move (*slot (i));
+          for (size_t i = _count - n; i < _count; i++)
+            slot (i)->~ELTYPE ();
+        }
+      _count -= n;
+    }
+
+  /* Searches and removes an element from the list.
+     Returns true if it was found and removed.
+     If the list contains several copies of ELT, only the leftmost one is
+     removed.  */
+  bool remove (const ELTYPE& elt)
+    {
+      size_t position = indexof (elt);
+      if (position == (size_t)(-1))
+        return false;
+      remove_at (position);
+      return true;
+    }
+
+  /* Removes all elements from the list.  The storage is kept.  */
+  void clear ()
+    {
+      for (size_t i = 0; i < _count; i++)
+        slot (i)->~ELTYPE ();
+      _offset = 0;
+      _count = 0;
+    }
+
+  /* Ensures that the list can hold COUNT elements without allocating
+     memory.  */
+  void reserve (size_t count)
+    {
+      if (count > _allocated)
+        {
+          ELTYPE *new_elements = allocate (count);
+          relocate (new_elements, count, _count);
+        }
+    }
+
+  /* Exchanges the contents of this list and X.  */
+  void swap (gl_ValueList& x) noexcept
+    {
+      std::swap (_equal, x._equal);
+      std::swap (_elements, x._elements);
+      std::swap (_offset, x._offset);
+      std::swap (_count, x._count);
+      std::swap (_allocated, x._allocated);
+    }
+
+  // ------------------------------ Private stuff ------------------------------
+
+private:
+  EQUAL _equal;
+  /* The circular array of _allocated slots.  The elements are at the slots
+     _offset, _offset + 1, ..., wrapping around at _allocated.  */
+  ELTYPE *_elements;
+  size_t _offset;
+  size_t _count;
+  size_t _allocated;
+
+  /* Returns the slot of the element at POSITION.  */
+  ELTYPE *slot (size_t position) const
+    {
+      size_t i = _offset + position;
+      if (i >= _allocated)
+        i -= _allocated;
+      return _elements + i;
+    }
+
+  static ELTYPE *allocate (size_t n)
+    { return std::allocator<ELTYPE> ().allocate (n); }
+
+  static void deallocate (ELTYPE *elements, size_t n)
+    {
+      if (elements != NULL)
+        std::allocator<ELTYPE> ().deallocate (elements, n);
+    }
+
+  /* Moves the elements into NEW_ELEMENTS, an array of NEW_ALLOCATED slots,
+     leaving the slot GAP free, and frees the old array.  */
+  void relocate (ELTYPE *new_elements, size_t new_allocated, size_t gap)
+    {
+      for (size_t i = 0; i < _count; i++)
+        {
+          ELTYPE *old_slot = slot (i);
+          ::new (static_cast<void *>(new_elements + i + (i >= gap)))
+            ELTYPE (std::move (*old_slot));
+          old_slot->~ELTYPE ();
+        }
+      deallocate (_elements, _allocated);
+      _elements = new_elements;
+      _offset = 0;
+      _allocated = new_allocated;
+    }
+
+  /* Enlarges the array and constructs an element from ARGS at POSITION.
+     Does not update _count.  */
+  template <class... ARGS>
+  void grow_with (size_t position, ARGS&&... args)
+    {
+      size_t new_allocated = (_allocated < 8 ? 8 : 2 * _allocated);
+      ELTYPE *new_elements = allocate (new_allocated);
+      /* Construct the element before moving others, since ARGS may refer
+         to elements of the list.  */
+      try
+        {
+          ::new (static_cast<void *>(new_elements + position))
+            ELTYPE (std::forward<ARGS>(args)...);
+        }
+      catch (...)
+        {
+          deallocate (new_elements, new_allocated);
+          throw;
+        }
+      relocate (new_elements, new_allocated, position);
+    }
+
+  /* Destroys the elements and frees the array.  */
+  void destroy ()
+    {
+      clear ();
+      deallocate (_elements, _allocated);
+      _elements = NULL;
+      _allocated = 0;
+    }
+
+public:
+  // -------------------------------- Iterators --------------------------------
+  // Random access iterators, like those of std::vector.
+  // Adding or removing elements invalidates them.
+
+  template <bool CONST>
+  class basic_iterator
+  {
+    typedef typename std::conditional<CONST, const gl_ValueList, gl_ValueList>::type list_type;
+
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef ELTYPE value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<CONST, const ELTYPE *, ELTYPE *>::type pointer;
+    typedef typename std::conditional<CONST, const ELTYPE &, ELTYPE &>::type reference;
+
+    basic_iterator ()
+      : _list (NULL), _position (0)
+      {}
+
+    /* Converts an iterator to a const_iterator.  */
+    template <bool C, class = typename std::enable_if<CONST && !C>::type>
+    basic_iterator (const basic_iterator<C>& x)
+      : _list (x._list), _position (x._position)
+      {}
+
+    reference operator* () const
+      { return *_list->slot (_position); }
+    pointer operator-> () const
+      { return _list->slot (_position); }
+    reference operator[] (difference_type n) const
+      { return *_list->slot (_position + n); }
+
+    basic_iterator& operator++ ()
+      { _position++; return *this; }
+    basic_iterator operator++ (int)
+      { basic_iterator result = *this; _position++; return result; }
+    basic_iterator& operator-- ()
+      { _position--; return *this; }
+    basic_iterator operator-- (int)
+      { basic_iterator result = *this; _position--; return result; }
+    basic_iterator& operator+= (difference_type n)
+      { _position += n; return *this; }
+    basic_iterator& operator-= (difference_type n)
+      { _position -= n; return *this; }
+
+    friend basic_iterator operator+ (basic_iterator it, difference_type n)
+      { return it += n; }
+    friend basic_iterator operator+ (difference_type n, basic_iterator it)
+      { return it += n; }
+    friend basic_iterator operator- (basic_iterator it, difference_type n)
+      { return it -= n; }
+    friend difference_type operator- (const basic_iterator& a, const basic_iterator& b)
+      { return static_cast<difference_type>(a._position - b._position); }
+
+    friend bool operator== (const basic_iterator& a, const basic_iterator& b)
+      { return a._position == b._position; }
+    friend bool operator!= (const basic_iterator& a, const basic_iterator& b)
+      { return a._position != b._position; }
+    friend bool operator< (const basic_iterator& a, const basic_iterator& b)
+      { return a._position < b._position; }
+    friend bool operator> (const basic_iterator& a, const basic_iterator& b)
+      { return a._position > b._position; }
+    friend bool operator<= (const basic_iterator& a, const basic_iterator& b)
+      { return a._position <= b._position; }
+    friend bool operator>= (const basic_iterator& a, const basic_iterator& b)
+      { return a._position >= b._position; }
+
+  private:
+    friend class gl_ValueList;
+    template <bool> friend class basic_iterator;
+
+    basic_iterator (list_type *list, size_t position)
+      : _list (list), _position (position)
+      {}
+
+    list_type *_list;
+    size_t _position;
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  /* Returns an iterator to the first element.  */
+  iterator begin ()
+    { return iterator (this, 0); }
+  const_iterator begin () const
+    { return const_iterator (this, 0); }
+
+  /* Returns an iterator past the last element.  */
+  iterator end ()
+    { return iterator (this, _count); }
+  const_iterator end () const
+    { return const_iterator (this, _count); }
+};
+
+#endif
+
 #endif /* _GL_LIST_HH */
@@ -142,6 +142,17 @@ extern const void * gl_map_get (gl_map_t map, const void *key);
    Returns false if not present in the map.  */
 extern bool gl_map_search (gl_map_t map, const void *key, const void **valuep);
 
+/* Searches whether pairs with the given N keys KEYS[0..N-1] are in the map.
+   Sets VALUES[i] to the value of KEYS[i] if found, or to NULL if not present
+   in the map, and, if FOUND is not NULL, sets FOUND[i] accordingly.
+   Returns the number of keys found.
+   With GL_HASH_MAP and GL_LINKEDHASH_MAP, this is faster than N calls to
+   gl_map_search on large maps, because the memory accesses of the searches
+   overlap.  */
+extern size_t gl_map_search_many (gl_map_t map,
+                                  const void *const *keys, size_t n,
+                                  const void **values, bool *found);
+
 /* Adds a pair to a map.
    Returns true if a pair with the given key was not already in the map and so
    this pair was added.
@@ -238,6 +249,8 @@ struct gl_map_implementation
                                gl_mapvalue_dispose_fn vdispose_fn);
   size_t (*size) (gl_map_t map);
   bool (*search) (gl_map_t map, const void *key, const void **valuep);
+  size_t (*search_many) (gl_map_t map, const void *const *keys, size_t n,
+                         const void **values, bool *found);
   int (*nx_getput) (gl_map_t map, const void *key, const void *value,
                     const void **oldvaluep);
   bool (*getremove) (gl_map_t map, const void *key, const void **oldvaluep);
@@ -287,6 +300,14 @@ gl_map_search (gl_map_t map, const void *key, const void **valuep)
          ->search (map, key, valuep);
 }
 
+GL_MAP_INLINE size_t
+gl_map_search_many (gl_map_t map, const void *const *keys, size_t n,
+                    const void **values, bool *found)
+{
+  return ((const struct gl_map_impl_base *) map)->vtable
+         ->search_many (map, keys, n, values, found);
+}
+
 _GL_ATTRIBUTE_NODISCARD GL_MAP_INLINE int
 gl_map_nx_getput (gl_map_t map, const void *key, const void *value,
                    const void **oldvaluep)
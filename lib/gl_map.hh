@@ -89,6 +89,21 @@ public:
   bool search (KEYTYPE * key, VALUETYPE *& value) const
     { return gl_map_search (_ptr, key, &value); }
 
+  /* Searches whether pairs with the given N keys KEYS[0..N-1] are in the map.
+     Sets VALUES[i] to the value of KEYS[i] if found, or to NULL if not
+     present in the map, and, if FOUND is not NULL, sets FOUND[i]
+     accordingly.
+     Returns the number of keys found.  */
+  size_t search_many (KEYTYPE * const *keys, size_t n, VALUETYPE ** values,
+                      bool *found = NULL) const
+    {
+      return gl_map_search_many (_ptr,
+                                 reinterpret_cast<const void * const *>(keys),
+                                 n,
+                                 const_cast<const void **>(reinterpret_cast<void **>(values)),
+                                 found);
+    }
+
   // ----------------------- Modifying member functions -----------------------
 
   /* Adds a pair to the map.
@@ -184,4 +199,451 @@ public:
     { return iterator (_ptr); }
 };
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+/* gl_ValueMap is a map that stores its keys of type KEYTYPE and its values of
+   type VALUETYPE by value.
+
+   Unlike gl_Map, it does not go through the gl_map vtable: all operations are
+   inline member functions, and the key hash function HASH and the key
+   equality EQUAL are template parameters, so that the compiler can inline
+   them.
+   It is implemented as a hash table with separate chaining, like
+   GL_HASH_MAP.  The hash codes are cached in the nodes, so that growing the
+   table does not call HASH again.  The table size is a power of 2, and the
+   hash codes are mixed by a multiplication, so that hash functions with poor
+   low-order bits, such as the identity on integers, are fine.
+
+   Unlike gl_Map, it owns its keys and values: copying a gl_ValueMap copies
+   them, and the destructor destroys them.
+   Upon out-of-memory, the member functions throw std::bad_alloc.
+   The destructors of KEYTYPE and VALUETYPE must not throw.
+
+   This class requires C++11 or newer.  */
+
+template <class KEYTYPE, class VALUETYPE,
+          class HASH = std::hash<KEYTYPE>,
+          class EQUAL = std::equal_to<KEYTYPE> >
+class gl_ValueMap
+{
+public:
+  typedef std::pair<const KEYTYPE, VALUETYPE> value_type;
+
+  // ------------------------------ Constructors ------------------------------
+
+  /* Creates an empty map.
+     HASH is the key hash function object, EQUAL the key comparison function
+     object.  */
+  explicit gl_ValueMap (const HASH& hash = HASH (), const EQUAL& equal = EQUAL ())
+    : _hash (hash), _equal (equal), _table (NULL), _table_size (0), _shift (0),
+      _count (0)
+    {}
+
+  /* Copy constructor.  Copies the keys and values.  */
+  gl_ValueMap (const gl_ValueMap& x)
+    : _hash (x._hash), _equal (x._equal), _table (NULL), _table_size (0),
+      _shift (0), _count (0)
+    {
+      if (x._table != NULL)
+        {
+          _table = new node *[x._table_size] ();
+          _table_size = x._table_size;
+          _shift = x._shift;
+          try
+            {
+              for (size_t i = 0; i < x._table_size; i++)
+                for (node *n = x._table[i]; n != NULL; n = n->next)
+                  {
+                    node *copy = new node (n->hashcode, n->entry.first,
+                                           n->entry.second);
+                    copy->next = _table[i];
+                    _table[i] = copy;
+                    _count++;
+                  }
+            }
+          catch (...)
+            {
+              destroy ();
+              throw;
+            }
+        }
+    }
+
+  /* Move constructor.  Leaves X empty.  */
+  gl_ValueMap (gl_ValueMap&& x) noexcept
+    : _hash (std::move (x._hash)), _equal (std::move (x._equal)),
+      _table (x._table), _table_size (x._table_size), _shift (x._shift),
+      _count (x._count)
+    {
+      x._table = NULL;
+      x._table_size = 0;
+      x._shift = 0;
+      x._count = 0;
+    }
+
+  /* Assignment operator.  Copies or moves the keys and values of X.  */
+  gl_ValueMap& operator= (gl_ValueMap x)
+    { swap (x); return *this; }
+
+  // ------------------------------- Destructor -------------------------------
+
+  ~gl_ValueMap ()
+    { destroy (); }
+
+  // ----------------------- Read-only member functions -----------------------
+
+  /* Returns the current number of pairs in the map.  */
+  size_t size () const
+    { return _count; }
+
+  /* Returns true if the map is empty.  */
+  bool empty () const
+    { return _count == 0; }
+
+  /* Searches whether a pair with the given key is already in the map.
+     Returns a pointer to its value if found, or NULL if not present in the
+     map.  */
+  const VALUETYPE *get (const KEYTYPE& key) const
+    {
+      node *n = find_node (key, hash_of (key));
+      return (n != NULL ? &n->entry.second : NULL);
+    }
+  VALUETYPE *get (const KEYTYPE& key)
+    {
+      node *n = find_node (key, hash_of (key));
+      return (n != NULL ? &n->entry.second : NULL);
+    }
+
+  /* Searches whether a pair with the given key is already in the map.
+     Returns true if found, or false if not present in the map.  */
+  bool search (const KEYTYPE& key) const
+    { return find_node (key, hash_of (key)) != NULL; }
+
+  // ----------------------- Modifying member functions -----------------------
+
+  /* Adds a pair to the map, or replaces the value of the pair with the given
+     key.
+     Returns true if a pair with the given key was not already in the map and
+     so this pair was added.
+     Returns false if a pair with the given key was already in the map and
+     only its value was replaced.  */
+  template <class V>
+  bool put (const KEYTYPE& key, V&& value)
+    { return put_impl (key, std::forward<V>(value)); }
+  template <class V>
+  bool put (KEYTYPE&& key, V&& value)
+    { return put_impl (std::move (key), std::forward<V>(value)); }
+
+  /* Adds a pair to the map whose value is constructed from ARGS, unless a pair
+     with the given key is already in the map.
+     Returns true if the pair was added, false if the map is unchanged.  */
+  template <class... ARGS>
+  bool emplace (const KEYTYPE& key, ARGS&&... args)
+    { return emplace_impl (key, std::forward<ARGS>(args)...); }
+  template <class... ARGS>
+  bool emplace (KEYTYPE&& key, ARGS&&... args)
+    { return emplace_impl (std::move (key), std::forward<ARGS>(args)...); }
+
+  /* Removes a pair from the map.
+     Returns true if the key was found and its pair removed.
+     Returns false otherwise.  */
+  bool remove (const KEYTYPE& key)
+    {
+      if (_table == NULL)
+        return false;
+      size_t hashcode = hash_of (key);
+      for (node **np = &_table[bucket (hashcode)]; *np != NULL; np = &(*np)->next)
+        {
+          node *n = *np;
+          if (n->hashcode == hashcode && _equal (n->entry.first, key))
+            {
+              *np = n->next;
+              delete n;
+              _count--;
+              return true;
+            }
+        }
+      return false;
+    }
+
+  /* Removes all pairs from the map.  The table is kept.  */
+  void clear ()
+    {
+      for (size_t i = 0; i < _table_size; i++)
+        {
+          for (node *n = _table[i]; n != NULL; )
+            {
+              node *next = n->next;
+              delete n;
+              n = next;
+            }
+          _table[i] = NULL;
+        }
+      _count = 0;
+    }
+
+  /* Exchanges the contents of this map and X.  */
+  void swap (gl_ValueMap& x) noexcept
+    {
+      std::swap (_hash, x._hash);
+      std::swap (_equal, x._equal);
+      std::swap (_table, x._table);
+      std::swap (_table_size, x._table_size);
+      std::swap (_shift, x._shift);
+      std::swap (_count, x._count);
+    }
+
+  // ------------------------------ Private stuff ------------------------------
+
+private:
+  struct node
+  {
+    node *next;
+    size_t hashcode;
+    value_type entry;
+
+    template <class K, class... ARGS>
+    node (size_t h, K&& key, ARGS&&... args)
+      : next (NULL), hashcode (h),
+        entry (std::piecewise_construct,
+               std::forward_as_tuple (std::forward<K>(key)),
+               std::forward_as_tuple (std::forward<ARGS>(args)...))
+      {}
+  };
+
+  HASH _hash;
+  EQUAL _equal;
+  /* The buckets, or NULL while the map has never contained a pair.  */
+  node **_table;
+  size_t _table_size;           /* a power of 2, or 0 */
+  unsigned int _shift;          /* word size - log2(_table_size) */
+  size_t _count;
+
+  size_t hash_of (const KEYTYPE& key) const
+    { return static_cast<size_t>(_hash (key)); }
+
+  /* Returns the bucket index of HASHCODE: the topmost log2(_table_size) bits
+     of HASHCODE * 2^w/phi (Fibonacci hashing).  */
+  size_t bucket (size_t hashcode) const
+    {
+      const size_t multiplier =
+        (sizeof (size_t) > 4
+         ? static_cast<size_t>(0x9E3779B97F4A7C15ULL)
+         : static_cast<size_t>(0x9E3779B9UL));
+      return (hashcode * multiplier) >> _shift;
+    }
+
+  node *find_node (const KEYTYPE& key, size_t hashcode) const
+    {
+      if (_table != NULL)
+        for (node *n = _table[bucket (hashcode)]; n != NULL; n = n->next)
+          if (n->hashcode == hashcode && _equal (n->entry.first, key))
+            return n;
+      return NULL;
+    }
+
+  /* Ensures that the table has room for one more pair.  */
+  void reserve_one ()
+    {
+      if (_count < _table_size)
+        return;
+      size_t new_table_size = (_table_size == 0 ? 8 : 2 * _table_size);
+      unsigned int new_shift =
+        (_table_size == 0 ? sizeof (size_t) * 8 - 3 : _shift - 1);
+      node **new_table = new node *[new_table_size] ();
+      node **old_table = _table;
+      size_t old_table_size = _table_size;
+      _table = new_table;
+      _table_size = new_table_size;
+      _shift = new_shift;
+      for (size_t i = 0; i < old_table_size; i++)
+        for (node *n = old_table[i]; n != NULL; )
+          {
+            node *next = n->next;
+            size_t b = bucket (n->hashcode);
+            n->next = _table[b];
+            _table[b] = n;
+            n = next;
+          }
+      delete[] old_table;
+    }
+
+  /* Adds N, whose key is not yet in the map.  */
+  void add_node (node *n)
+    {
+      size_t b = bucket (n->hashcode);
+      n->next = _table[b];
+      _table[b] = n;
+      _count++;
+    }
+
+  template <class K, class V>
+  bool put_impl (K&& key, V&& value)
+    {
+      size_t hashcode = hash_of (key);
+      node *n = find_node (key, hashcode);
+      if (n != NULL)
+        {
+          n->entry.second = std::forward<V>(value);
+          return false;
+        }
+      reserve_one ();
+      add_node (new node (hashcode, std::forward<K>(key), std::forward<V>(value)));
+      return true;
+    }
+
+  template <class K, class... ARGS>
+  bool emplace_impl (K&& key, ARGS&&... args)
+    {
+      size_t hashcode = hash_of (key);
+      if (find_node (key, hashcode) != NULL)
+        return false;
+      reserve_one ();
+      add_node (new node (hashcode, std::forward<K>(key),
+                          std::forward<ARGS>(args)...));
+      return true;
+    }
+
+  /* Destroys the pairs and frees the table.  */
+  void destroy ()
+    {
+      clear ();
+      delete[] _table;
+      _table = NULL;
+      _table_size = 0;
+      _shift = 0;
+    }
+
+public:
+  // -------------------------------- Iterators --------------------------------
+  // Forward iterators, like those of std::unordered_map.  They visit the pairs
+  // in no particular order.
+  // Adding a pair invalidates them.  Removing a pair invalidates only the
+  // iterators that point to it.
+
+  template <bool CONST>
+  class basic_iterator
+  {
+    typedef typename std::conditional<CONST, const gl_ValueMap, gl_ValueMap>::type map_type;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef gl_ValueMap::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::conditional<CONST, const value_type *, value_type *>::type pointer;
+    typedef typename std::conditional<CONST, const value_type &, value_type &>::type reference;
+
+    basic_iterator ()
+      : _map (NULL), _bucket (0), _node (NULL)
+      {}
+
+    /* Converts an iterator to a const_iterator.  */
+    template <bool C, class = typename std::enable_if<CONST && !C>::type>
+    basic_iterator (const basic_iterator<C>& x)
+      : _map (x._map), _bucket (x._bucket), _node (x._node)
+      {}
+
+    reference operator* () const
+      { return _node->entry; }
+    pointer operator-> () const
+      { return &_node->entry; }
+
+    basic_iterator& operator++ ()
+      {
+        _node = _node->next;
+        if (_node == NULL)
+          skip_empty_buckets (_bucket + 1);
+        return *this;
+      }
+    basic_iterator operator++ (int)
+      { basic_iterator result = *this; ++*this; return result; }
+
+    friend bool operator== (const basic_iterator& a, const basic_iterator& b)
+      { return a._node == b._node; }
+    friend bool operator!= (const basic_iterator& a, const basic_iterator& b)
+      { return a._node != b._node; }
+
+  private:
+    friend class gl_ValueMap;
+    template <bool> friend class basic_iterator;
+
+    basic_iterator (map_type *map, size_t bucket, node *n)
+      : _map (map), _bucket (bucket), _node (n)
+      {}
+
+    /* Makes this iterator point to the first pair in the buckets I, I + 1,
+       ..., or to the end.  */
+    void skip_empty_buckets (size_t i)
+      {
+        for (; i < _map->_table_size; i++)
+          if (_map->_table[i] != NULL)
+            {
+              _bucket = i;
+              _node = _map->_table[i];
+              return;
+            }
+        _bucket = _map->_table_size;
+        _node = NULL;
+      }
+
+    map_type *_map;
+    size_t _bucket;
+    node *_node;            /* NULL for the end */
+  };
+
+  typedef basic_iterator<false> iterator;
+  typedef basic_iterator<true> const_iterator;
+
+  /* Returns an iterator to the first pair.  */
+  iterator begin ()
+    { iterator it (this, 0, NULL); it.skip_empty_buckets (0); return it; }
+  const_iterator begin () const
+    { const_iterator it (this, 0, NULL); it.skip_empty_buckets (0); return it; }
+
+  /* Returns an iterator past the last pair.  */
+  iterator end ()
+    { return iterator (this, _table_size, NULL); }
+  const_iterator end () const
+    { return const_iterator (this, _table_size, NULL); }
+
+  /* Returns an iterator to the pair with the given key, or end().  */
+  iterator find (const KEYTYPE& key)
+    {
+      size_t hashcode = hash_of (key);
+      node *n = find_node (key, hashcode);
+      return (n != NULL ? iterator (this, bucket (hashcode), n) : end ());
+    }
+  const_iterator find (const KEYTYPE& key) const
+    {
+      size_t hashcode = hash_of (key);
+      node *n = find_node (key, hashcode);
+      return (n != NULL ? const_iterator (this, bucket (hashcode), n) : end ());
+    }
+
+  /* Removes the pair at POS, which must not be end().
+     Returns an iterator to the pair after it.  */
+  iterator erase (const_iterator pos)
+    {
+      node *n = pos._node;
+      iterator next (this, pos._bucket, n);
+      ++next;
+      node **np = &_table[pos._bucket];
+      while (*np != n)
+        np = &(*np)->next;
+      *np = n->next;
+      delete n;
+      _count--;
+      return next;
+    }
+};
+
+#endif
+
 #endif /* _GL_MAP_HH */
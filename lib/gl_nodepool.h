@@ -0,0 +1,151 @@
+/* Node pools for the linked and tree based container implementations.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* A node pool hands out the nodes of a single container.  When enabled, it
+   carves them from slabs of geometrically increasing size, keeps the nodes
+   that are freed on a free list for reuse, and gives all slabs back to
+   malloc at once when the container is freed.  This avoids one malloc/free
+   pair per node and keeps the nodes of a container close together.
+   When disabled, it simply forwards to malloc and free.  */
+
+#include <stdlib.h>
+
+/* The number of nodes in the first slab of a pool.  Each further slab is
+   twice as large as the previous one, until a slab occupies at least
+   NODEPOOL_MAX_SLAB_SIZE bytes.  */
+#define NODEPOOL_MIN_SLAB_NODES 32
+#define NODEPOOL_MAX_SLAB_SIZE ((size_t) 1 << 20)
+
+/* The header of a slab.  The nodes follow it.  The union ensures that the
+   nodes, which consist of pointers and integers, are suitably aligned.  */
+union nodepool_slab
+{
+  union nodepool_slab *next;
+  void *align_pointer;
+  size_t align_size;
+  double align_double;
+};
+
+struct gl_nodepool
+{
+  /* Whether the nodes come from slabs (true) or from malloc (false).  */
+  bool enabled;
+  /* The size of a node, rounded up so that consecutive nodes in a slab are
+     aligned.  */
+  size_t node_size;
+  /* Freed nodes, chained through their first word.  */
+  void *free_nodes;
+  /* The not yet used part of the current slab.  */
+  char *slab_next;
+  char *slab_end;
+  /* All slabs, most recently allocated first.  */
+  union nodepool_slab *slabs;
+  /* The number of nodes that the next slab will hold.  */
+  size_t next_slab_nodes;
+};
+
+/* Initializes POOL for nodes of size NODE_SIZE.  */
+static inline void
+gl_nodepool_init (struct gl_nodepool *pool, size_t node_size, bool enabled)
+{
+  size_t align = sizeof (union nodepool_slab);
+
+  pool->enabled = enabled;
+  pool->node_size = (node_size + align - 1) / align * align;
+  pool->free_nodes = NULL;
+  pool->slab_next = NULL;
+  pool->slab_end = NULL;
+  pool->slabs = NULL;
+  pool->next_slab_nodes = NODEPOOL_MIN_SLAB_NODES;
+}
+
+/* Allocates a new slab and returns its first node.
+   Returns NULL upon out-of-memory.  */
+static void *
+gl_nodepool_alloc_slab (struct gl_nodepool *pool)
+{
+  size_t nodes = pool->next_slab_nodes;
+  union nodepool_slab *slab =
+    (union nodepool_slab *)
+    malloc (sizeof (union nodepool_slab) + nodes * pool->node_size);
+
+  if (slab == NULL)
+    return NULL;
+
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  char *node = (char *) (slab + 1);
+  pool->slab_next = node + pool->node_size;
+  pool->slab_end = node + nodes * pool->node_size;
+  if (nodes * pool->node_size < NODEPOOL_MAX_SLAB_SIZE)
+    pool->next_slab_nodes = 2 * nodes;
+  return node;
+}
+
+/* Returns a new, uninitialized node.
+   Returns NULL upon out-of-memory.  */
+static inline void *
+gl_nodepool_alloc (struct gl_nodepool *pool)
+{
+  if (!pool->enabled)
+    return malloc (pool->node_size);
+
+  void *node = pool->free_nodes;
+  if (node != NULL)
+    {
+      pool->free_nodes = *(void **) node;
+      return node;
+    }
+  if (pool->slab_next < pool->slab_end)
+    {
+      node = pool->slab_next;
+      pool->slab_next += pool->node_size;
+      return node;
+    }
+  return gl_nodepool_alloc_slab (pool);
+}
+
+/* Frees a node that was returned by gl_nodepool_alloc.  */
+static inline void
+gl_nodepool_free (struct gl_nodepool *pool, void *node)
+{
+  if (!pool->enabled)
+    free (node);
+  else
+    {
+      *(void **) node = pool->free_nodes;
+      pool->free_nodes = node;
+    }
+}
+
+/* Frees all nodes of POOL at once, without visiting them.
+   This is a no-op for a disabled pool, whose nodes must be freed one by one
+   through gl_nodepool_free.  */
+static inline void
+gl_nodepool_release (struct gl_nodepool *pool)
+{
+  for (union nodepool_slab *slab = pool->slabs; slab != NULL; )
+    {
+      union nodepool_slab *next = slab->next;
+      free (slab);
+      slab = next;
+    }
+  pool->free_nodes = NULL;
+  pool->slab_next = NULL;
+  pool->slab_end = NULL;
+  pool->slabs = NULL;
+  pool->next_slab_nodes = NODEPOOL_MIN_SLAB_NODES;
+}
@@ -56,25 +56,28 @@ extern "C" {
      GL_ARRAY_OMAP        a growable array
      GL_AVLTREE_OMAP      a binary tree (AVL tree)
      GL_RBTREE_OMAP       a binary tree (red-black tree)
+     GL_BTREE_OMAP        a B+ tree
 
    The memory consumption is asymptotically the same: O(1) for every pair
    in the map.  When looking more closely at the average memory consumed
-   for an pair, GL_ARRAY_OMAP is the most compact representation, and
-   GL_AVLTREE_OMAP, GL_RBTREE_OMAP need more memory.
+   for an pair, GL_ARRAY_OMAP is the most compact representation,
+   GL_BTREE_OMAP needs a little more memory, and GL_AVLTREE_OMAP,
+   GL_RBTREE_OMAP need more memory.
 
    The guaranteed average performance of the operations is, for a map of
    n pairs:
 
-   Operation                  ARRAY     TREE
-
-   gl_omap_size                O(1)     O(1)
-   gl_omap_get               O(log n) O(log n)
-   gl_omap_put                 O(n)   O(log n)
-   gl_omap_remove              O(n)   O(log n)
-   gl_omap_search            O(log n) O(log n)
-   gl_omap_search_atleast    O(log n) O(log n)
-   gl_omap_iterator            O(1)   O(log n)
-   gl_omap_iterator_next       O(1)   O(log n)
+   Operation                  ARRAY     TREE     BTREE
+
+   gl_omap_create              O(n)     O(n)     O(n)
+   gl_omap_size                O(1)     O(1)     O(1)
+   gl_omap_get               O(log n) O(log n) O(log n)
+   gl_omap_put                 O(n)   O(log n) O(log n)
+   gl_omap_remove              O(n)   O(log n) O(log n)
+   gl_omap_search            O(log n) O(log n) O(log n)
+   gl_omap_search_atleast    O(log n) O(log n) O(log n)
+   gl_omap_iterator            O(1)   O(log n) O(log n)
+   gl_omap_iterator_next       O(1)   O(log n)   O(1)
  */
 
 /* -------------------------- gl_omap_t Data Type -------------------------- */
@@ -111,7 +114,8 @@ typedef const struct gl_omap_implementation * gl_omap_implementation_t;
 #if 0 /* Unless otherwise specified, these are defined inline below.  */
 
 /* Creates an empty map.
-   IMPLEMENTATION is one of GL_ARRAY_OMAP, GL_AVLTREE_OMAP, GL_RBTREE_OMAP.
+   IMPLEMENTATION is one of GL_ARRAY_OMAP, GL_AVLTREE_OMAP, GL_RBTREE_OMAP,
+   GL_BTREE_OMAP.
    COMPAR_FN is a key comparison function or NULL.
    KDISPOSE_FN is a key disposal function or NULL.
    VDISPOSE_FN is a value disposal function or NULL.  */
@@ -129,6 +133,57 @@ extern gl_omap_t gl_omap_nx_create_empty (gl_omap_implementation_t implementatio
                                           gl_mapvalue_dispose_fn vdispose_fn)
   /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/;
 
+/* Creates an empty map whose nodes are allocated from a pool that belongs
+   to the map.  The pool takes memory from malloc in large slabs, reuses the
+   nodes of removed pairs, and gives all its memory back at once in
+   gl_omap_free.  This saves most of the calls to malloc and free that
+   GL_AVLTREE_OMAP and GL_RBTREE_OMAP otherwise make for every pair, at the
+   price of not returning the memory of removed pairs to malloc before the
+   map is freed.  For the other implementations, this function is the same
+   as gl_omap_create_empty.
+   The parameters are the same as for gl_omap_create_empty.  */
+/* declared in gl_xomap.h */
+extern gl_omap_t gl_omap_create_empty_with_pool (gl_omap_implementation_t implementation,
+                                                 gl_mapkey_compar_fn compar_fn,
+                                                 gl_mapkey_dispose_fn kdispose_fn,
+                                                 gl_mapvalue_dispose_fn vdispose_fn)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+/* Likewise.  Returns NULL upon out-of-memory.  */
+extern gl_omap_t gl_omap_nx_create_empty_with_pool (gl_omap_implementation_t implementation,
+                                                    gl_mapkey_compar_fn compar_fn,
+                                                    gl_mapkey_dispose_fn kdispose_fn,
+                                                    gl_mapvalue_dispose_fn vdispose_fn)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/;
+
+/* Creates a map with given contents.
+   IMPLEMENTATION is one of GL_ARRAY_OMAP, GL_AVLTREE_OMAP, GL_RBTREE_OMAP,
+   GL_BTREE_OMAP.
+   COMPAR_FN is a key comparison function or NULL.
+   KDISPOSE_FN is a key disposal function or NULL.
+   VDISPOSE_FN is a value disposal function or NULL.
+   COUNT is the number of initial pairs.
+   KEYS[0..COUNT-1] and VALUES[0..COUNT-1] are the initial pairs.  KEYS must
+   be sorted in strictly increasing order, according to COMPAR_FN.
+   This takes O(n) time; it is faster than adding the pairs one by one.  */
+/* declared in gl_xomap.h */
+extern gl_omap_t gl_omap_create (gl_omap_implementation_t implementation,
+                                 gl_mapkey_compar_fn compar_fn,
+                                 gl_mapkey_dispose_fn kdispose_fn,
+                                 gl_mapvalue_dispose_fn vdispose_fn,
+                                 size_t count,
+                                 const void **keys, const void **values)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+/* Likewise.  Returns NULL upon out-of-memory.  */
+extern gl_omap_t gl_omap_nx_create (gl_omap_implementation_t implementation,
+                                    gl_mapkey_compar_fn compar_fn,
+                                    gl_mapkey_dispose_fn kdispose_fn,
+                                    gl_mapvalue_dispose_fn vdispose_fn,
+                                    size_t count,
+                                    const void **keys, const void **values)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/;
+
 /* Returns the current number of pairs in an ordered map.  */
 extern size_t gl_omap_size (gl_omap_t map);
 
@@ -242,6 +297,16 @@ struct gl_omap_implementation
                                 gl_mapkey_compar_fn compar_fn,
                                 gl_mapkey_dispose_fn kdispose_fn,
                                 gl_mapvalue_dispose_fn vdispose_fn);
+  gl_omap_t (*nx_create_empty_with_pool) (gl_omap_implementation_t implementation,
+                                          gl_mapkey_compar_fn compar_fn,
+                                          gl_mapkey_dispose_fn kdispose_fn,
+                                          gl_mapvalue_dispose_fn vdispose_fn);
+  gl_omap_t (*nx_create) (gl_omap_implementation_t implementation,
+                          gl_mapkey_compar_fn compar_fn,
+                          gl_mapkey_dispose_fn kdispose_fn,
+                          gl_mapvalue_dispose_fn vdispose_fn,
+                          size_t count,
+                          const void **keys, const void **values);
   size_t (*size) (gl_omap_t map);
   bool (*search) (gl_omap_t map, const void *key, const void **valuep);
   bool (*search_atleast) (gl_omap_t map,
@@ -282,6 +347,32 @@ gl_omap_nx_create_empty (gl_omap_implementation_t implementation,
                                           kdispose_fn, vdispose_fn);
 }
 
+GL_OMAP_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+gl_omap_t
+gl_omap_nx_create_empty_with_pool (gl_omap_implementation_t implementation,
+                                   gl_mapkey_compar_fn compar_fn,
+                                   gl_mapkey_dispose_fn kdispose_fn,
+                                   gl_mapvalue_dispose_fn vdispose_fn)
+{
+  return implementation->nx_create_empty_with_pool (implementation, compar_fn,
+                                                    kdispose_fn, vdispose_fn);
+}
+
+GL_OMAP_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+gl_omap_t
+gl_omap_nx_create (gl_omap_implementation_t implementation,
+                   gl_mapkey_compar_fn compar_fn,
+                   gl_mapkey_dispose_fn kdispose_fn,
+                   gl_mapvalue_dispose_fn vdispose_fn,
+                   size_t count, const void **keys, const void **values)
+{
+  return implementation->nx_create (implementation, compar_fn,
+                                    kdispose_fn, vdispose_fn,
+                                    count, keys, values);
+}
+
 GL_OMAP_INLINE size_t
 gl_omap_size (gl_omap_t map)
 {
@@ -42,7 +42,8 @@ public:
     {}
 
   /* Creates an empty map.
-     IMPLEMENTATION is one of GL_ARRAY_OMAP, GL_AVLTREE_OMAP, GL_RBTREE_OMAP.
+     IMPLEMENTATION is one of GL_ARRAY_OMAP, GL_AVLTREE_OMAP, GL_RBTREE_OMAP,
+     GL_BTREE_OMAP.
      COMPAR_FN is a key comparison function or NULL.
      KDISPOSE_FN is a key disposal function or NULL.
      VDISPOSE_FN is a value disposal function or NULL.  */
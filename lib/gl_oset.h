@@ -53,26 +53,38 @@ extern "C" {
      GL_ARRAY_OSET        a growable array
      GL_AVLTREE_OSET      a binary tree (AVL tree)
      GL_RBTREE_OSET       a binary tree (red-black tree)
+     GL_BTREE_OSET        a B+ tree
 
    The memory consumption is asymptotically the same: O(1) for every object
    in the set.  When looking more closely at the average memory consumed
-   for an object, GL_ARRAY_OSET is the most compact representation, and
-   GL_AVLTREE_OSET, GL_RBTREE_OSET need more memory.
+   for an object, GL_ARRAY_OSET is the most compact representation,
+   GL_BTREE_OSET needs a little more memory, and GL_AVLTREE_OSET,
+   GL_RBTREE_OSET need several times as much.
 
    The guaranteed average performance of the operations is, for a set of
    n elements:
 
-   Operation                  ARRAY     TREE
-
-   gl_oset_size                O(1)     O(1)
-   gl_oset_add                 O(n)   O(log n)
-   gl_oset_remove              O(n)   O(log n)
-   gl_oset_update              O(n)   O(log n)
-   gl_oset_search            O(log n) O(log n)
-   gl_oset_search_atleast    O(log n) O(log n)
-   gl_oset_iterator            O(1)   O(log n)
-   gl_oset_iterator_atleast  O(log n) O(log n)
-   gl_oset_iterator_next       O(1)   O(log n)
+   Operation                  ARRAY     TREE     BTREE
+
+   gl_oset_create              O(n)     O(n)     O(n)
+   gl_oset_size                O(1)     O(1)     O(1)
+   gl_oset_add                 O(n)   O(log n) O(log n)
+   gl_oset_add_sorted_array  O(n + k)   (*)      (*)
+   gl_oset_remove              O(n)   O(log n) O(log n)
+   gl_oset_update              O(n)   O(log n) O(log n)
+   gl_oset_search            O(log n) O(log n) O(log n)
+   gl_oset_search_atleast    O(log n) O(log n) O(log n)
+   gl_oset_iterator            O(1)   O(log n) O(log n)
+   gl_oset_iterator_atleast  O(log n) O(log n) O(log n)
+   gl_oset_iterator_next       O(1)   O(log n)   O(1)
+
+   (*) For an array of k elements, O(k log n) when k is small compared to n,
+       and O(n + k) otherwise.
+
+   GL_BTREE_OSET stores the elements in arrays of consecutive elements.
+   Therefore its searches touch fewer cache lines than those of
+   GL_AVLTREE_OSET and GL_RBTREE_OSET, and traversing a range of elements
+   with gl_oset_iterator_atleast and gl_oset_iterator_next is much faster.
  */
 
 /* -------------------------- gl_oset_t Data Type -------------------------- */
@@ -103,7 +115,8 @@ typedef const struct gl_oset_implementation * gl_oset_implementation_t;
 #if 0 /* Unless otherwise specified, these are defined inline below.  */
 
 /* Creates an empty set.
-   IMPLEMENTATION is one of GL_ARRAY_OSET, GL_AVLTREE_OSET, GL_RBTREE_OSET.
+   IMPLEMENTATION is one of GL_ARRAY_OSET, GL_AVLTREE_OSET, GL_RBTREE_OSET,
+   GL_BTREE_OSET.
    COMPAR_FN is an element comparison function or NULL.
    DISPOSE_FN is an element disposal function or NULL.  */
 /* declared in gl_xoset.h */
@@ -118,6 +131,50 @@ extern gl_oset_t gl_oset_nx_create_empty (gl_oset_implementation_t implementatio
                                           gl_setelement_dispose_fn dispose_fn)
   /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/;
 
+/* Creates an empty set whose nodes are allocated from a pool that belongs
+   to the set.  The pool takes memory from malloc in large slabs, reuses the
+   nodes of removed elements, and gives all its memory back at once in
+   gl_oset_free.  This saves most of the calls to malloc and free that
+   GL_AVLTREE_OSET and GL_RBTREE_OSET otherwise make for every element, at
+   the price of not returning the memory of removed elements to malloc before
+   the set is freed.  For the other implementations, this function is the
+   same as gl_oset_create_empty.
+   The parameters are the same as for gl_oset_create_empty.  */
+/* declared in gl_xoset.h */
+extern gl_oset_t gl_oset_create_empty_with_pool (gl_oset_implementation_t implementation,
+                                                 gl_setelement_compar_fn compar_fn,
+                                                 gl_setelement_dispose_fn dispose_fn)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+/* Likewise.  Returns NULL upon out-of-memory.  */
+extern gl_oset_t gl_oset_nx_create_empty_with_pool (gl_oset_implementation_t implementation,
+                                                    gl_setelement_compar_fn compar_fn,
+                                                    gl_setelement_dispose_fn dispose_fn)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/;
+
+/* Creates a set with given contents.
+   IMPLEMENTATION is one of GL_ARRAY_OSET, GL_AVLTREE_OSET, GL_RBTREE_OSET,
+   GL_BTREE_OSET.
+   COMPAR_FN is an element comparison function or NULL.
+   DISPOSE_FN is an element disposal function or NULL.
+   COUNT is the number of initial elements.
+   CONTENTS[0..COUNT-1] is the initial contents.  It must be sorted in
+   strictly increasing order, according to COMPAR_FN.
+   This takes O(n) time; it is faster than adding the elements one by one.  */
+/* declared in gl_xoset.h */
+extern gl_oset_t gl_oset_create (gl_oset_implementation_t implementation,
+                                 gl_setelement_compar_fn compar_fn,
+                                 gl_setelement_dispose_fn dispose_fn,
+                                 size_t count, const void **contents)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+/* Likewise.  Returns NULL upon out-of-memory.  */
+extern gl_oset_t gl_oset_nx_create (gl_oset_implementation_t implementation,
+                                    gl_setelement_compar_fn compar_fn,
+                                    gl_setelement_dispose_fn dispose_fn,
+                                    size_t count, const void **contents)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/;
+
 /* Returns the current number of elements in an ordered set.  */
 extern size_t gl_oset_size (gl_oset_t set);
 
@@ -144,6 +201,20 @@ extern bool gl_oset_add (gl_oset_t set, const void *elt);
 _GL_ATTRIBUTE_NODISCARD
 extern int gl_oset_nx_add (gl_oset_t set, const void *elt);
 
+/* Adds the COUNT elements of CONTENTS, which must be sorted according to the
+   set's comparison function, to an ordered set.  Elements that are already
+   in the set, and repeated elements of CONTENTS, are not added; they still
+   belong to the caller.  */
+/* declared in gl_xoset.h */
+extern void gl_oset_add_sorted_array (gl_oset_t set,
+                                      size_t count, const void **contents);
+
+/* Likewise.  Returns 0 upon success, or -1 upon out-of-memory, in which case
+   the set is unchanged.  */
+_GL_ATTRIBUTE_NODISCARD
+extern int gl_oset_nx_add_sorted_array (gl_oset_t set,
+                                        size_t count, const void **contents);
+
 /* Removes an element from an ordered set.
    Returns true if it was found and removed.  */
 extern bool gl_oset_remove (gl_oset_t set, const void *elt);
@@ -218,12 +289,21 @@ struct gl_oset_implementation
   gl_oset_t (*nx_create_empty) (gl_oset_implementation_t implementation,
                                 gl_setelement_compar_fn compar_fn,
                                 gl_setelement_dispose_fn dispose_fn);
+  gl_oset_t (*nx_create_empty_with_pool) (gl_oset_implementation_t implementation,
+                                          gl_setelement_compar_fn compar_fn,
+                                          gl_setelement_dispose_fn dispose_fn);
+  gl_oset_t (*nx_create) (gl_oset_implementation_t implementation,
+                          gl_setelement_compar_fn compar_fn,
+                          gl_setelement_dispose_fn dispose_fn,
+                          size_t count, const void **contents);
   size_t (*size) (gl_oset_t set);
   bool (*search) (gl_oset_t set, const void *elt);
   bool (*search_atleast) (gl_oset_t set,
                           gl_setelement_threshold_fn threshold_fn,
                           const void *threshold, const void **eltp);
   int (*nx_add) (gl_oset_t set, const void *elt);
+  int (*nx_add_sorted_array) (gl_oset_t set,
+                              size_t count, const void **contents);
   bool (*remove_elt) (gl_oset_t set, const void *elt);
   int (*update) (gl_oset_t set, const void *elt,
                  void (*action) (const void * /*elt*/, void * /*action_data*/),
@@ -259,6 +339,29 @@ gl_oset_nx_create_empty (gl_oset_implementation_t implementation,
                                           dispose_fn);
 }
 
+GL_OSET_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+gl_oset_t
+gl_oset_nx_create_empty_with_pool (gl_oset_implementation_t implementation,
+                                   gl_setelement_compar_fn compar_fn,
+                                   gl_setelement_dispose_fn dispose_fn)
+{
+  return implementation->nx_create_empty_with_pool (implementation, compar_fn,
+                                                    dispose_fn);
+}
+
+GL_OSET_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+gl_oset_t
+gl_oset_nx_create (gl_oset_implementation_t implementation,
+                   gl_setelement_compar_fn compar_fn,
+                   gl_setelement_dispose_fn dispose_fn,
+                   size_t count, const void **contents)
+{
+  return implementation->nx_create (implementation, compar_fn, dispose_fn,
+                                    count, contents);
+}
+
 GL_OSET_INLINE size_t
 gl_oset_size (gl_oset_t set)
 {
@@ -286,6 +389,14 @@ gl_oset_nx_add (gl_oset_t set, const void *elt)
   return ((const struct gl_oset_impl_base *) set)->vtable->nx_add (set, elt);
 }
 
+_GL_ATTRIBUTE_NODISCARD GL_OSET_INLINE int
+gl_oset_nx_add_sorted_array (gl_oset_t set,
+                             size_t count, const void **contents)
+{
+  return ((const struct gl_oset_impl_base *) set)->vtable
+         ->nx_add_sorted_array (set, count, contents);
+}
+
 GL_OSET_INLINE bool
 gl_oset_remove (gl_oset_t set, const void *elt)
 {
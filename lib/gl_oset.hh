@@ -42,7 +42,8 @@ public:
     {}
 
   /* Creates an empty set.
-     IMPLEMENTATION is one of GL_ARRAY_OSET, GL_AVLTREE_OSET, GL_RBTREE_OSET.
+     IMPLEMENTATION is one of GL_ARRAY_OSET, GL_AVLTREE_OSET, GL_RBTREE_OSET,
+     GL_BTREE_OSET.
      COMPAR_FN is an element comparison function or NULL.
      DISPOSE_FN is an element disposal function or NULL.  */
   gl_OSet (gl_oset_implementation_t implementation,
@@ -95,6 +96,11 @@ public:
   bool add (ELTYPE * elt)
     { return gl_oset_add (_ptr, elt); }
 
+  /* Adds the elements CONTENTS[0..COUNT-1], which must be sorted according to
+     the set's comparison function, to the ordered set.  */
+  void add_sorted_array (size_t count, ELTYPE **contents)
+    { gl_oset_add_sorted_array (_ptr, count, reinterpret_cast<const void **>(contents)); }
+
   /* Removes an element from the ordered set.
      Returns true if it was found and removed.  */
   bool remove (ELTYPE * elt)
@@ -195,4 +201,661 @@ public:
     { return iterator (_ptr, threshold_fn, threshold); }
 };
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+
+/* The part of gl_ValueOSet that does not depend on the element type:
+   an AVL tree of nodes, balanced like in gl_avltree_ordered.h.  */
+
+class gl_ValueOSet_base
+{
+protected:
+  struct node
+  {
+    node *left;                 /* left branch, or NULL */
+    node *right;                /* right branch, or NULL */
+    node *parent;               /* parent, or NULL for the root */
+    int balance;                /* heightof(right) - heightof(left),
+                                   always = -1 or 0 or 1 */
+  };
+
+  node *_root;
+  size_t _count;
+
+  gl_ValueOSet_base ()
+    : _root (NULL), _count (0)
+    {}
+
+  /* Returns the leftmost node of the subtree NODE, or NULL.  */
+  static node *leftmost (node *n)
+    {
+      if (n != NULL)
+        while (n->left != NULL)
+          n = n->left;
+      return n;
+    }
+
+  /* Returns the rightmost node of the subtree NODE, or NULL.  */
+  static node *rightmost (node *n)
+    {
+      if (n != NULL)
+        while (n->right != NULL)
+          n = n->right;
+      return n;
+    }
+
+  /* Returns the node after N in the tree, or NULL.  */
+  static node *next_node (node *n)
+    {
+      if (n->right != NULL)
+        return leftmost (n->right);
+      while (n->parent != NULL && n->parent->right == n)
+        n = n->parent;
+      return n->parent;
+    }
+
+  /* Returns the node before N in the tree, or NULL.  */
+  static node *prev_node (node *n)
+    {
+      if (n->left != NULL)
+        return rightmost (n->left);
+      while (n->parent != NULL && n->parent->left == n)
+        n = n->parent;
+      return n->parent;
+    }
+
+  /* Ensures the tree is balanced, after an insertion or deletion operation.
+     The height of NODE is incremented by HEIGHT_DIFF (1 or -1).
+     PARENT = NODE->parent.  (NODE can also be NULL.  But PARENT is non-NULL.)
+     Rotation operations are performed starting at PARENT (not NODE itself!).  */
+  void rebalance (node *n, int height_diff, node *parent)
+    {
+      for (;;)
+        {
+          node *child = n;
+          n = parent;
+
+          int previous_balance = n->balance;
+
+          /* The balance of N is incremented by BALANCE_DIFF: +1 if the right
+             branch's height has increased by 1 or the left branch's height
+             has decreased by 1, -1 if the right branch's height has decreased
+             by 1 or the left branch's height has increased by 1, 0 if no
+             height change.  */
+          int balance_diff;
+          if (n->left != NULL || n->right != NULL)
+            balance_diff = (child == n->right ? height_diff : -height_diff);
+          else
+            /* Special case where above formula doesn't work, because the
+               caller didn't tell whether N's left or right branch shrunk from
+               height 1 to NULL.  */
+            balance_diff = - previous_balance;
+
+          n->balance += balance_diff;
+          if (balance_diff == previous_balance)
+            {
+              /* n->balance is outside the range [-1,1].  Must rotate.  */
+              node **np;
+
+              if (n->parent == NULL)
+                np = &_root;
+              else if (n->parent->left == n)
+                np = &n->parent->left;
+              else
+                np = &n->parent->right;
+
+              node *nleft = n->left;
+              node *nright = n->right;
+
+              if (balance_diff < 0)
+                {
+                  /* n->balance = -2.  Rotate from left to right.  */
+                  node *nleftright = nleft->right;
+                  if (nleft->balance <= 0)
+                    {
+                      n->left = nleftright;
+                      nleft->right = n;
+
+                      nleft->parent = n->parent;
+                      n->parent = nleft;
+                      if (nleftright != NULL)
+                        nleftright->parent = n;
+
+                      nleft->balance += 1;
+                      n->balance = - nleft->balance;
+
+                      *np = nleft;
+                      height_diff = (height_diff < 0
+                                     ? nleft->balance - 1
+                                     : nleft->balance);
+                    }
+                  else
+                    {
+                      node *L = nleft->right = nleftright->left;
+                      node *R = n->left = nleftright->right;
+                      nleftright->left = nleft;
+                      nleftright->right = n;
+
+                      nleftright->parent = n->parent;
+                      if (L != NULL)
+                        L->parent = nleft;
+                      if (R != NULL)
+                        R->parent = n;
+                      nleft->parent = nleftright;
+                      n->parent = nleftright;
+
+                      nleft->balance = (nleftright->balance > 0 ? -1 : 0);
+                      n->balance = (nleftright->balance < 0 ? 1 : 0);
+                      nleftright->balance = 0;
+
+                      *np = nleftright;
+                      height_diff = (height_diff < 0 ? -1 : 0);
+                    }
+                }
+              else
+                {
+                  /* n->balance = 2.  Rotate from right to left.  */
+                  node *nrightleft = nright->left;
+                  if (nright->balance >= 0)
+                    {
+                      n->right = nrightleft;
+                      nright->left = n;
+
+                      nright->parent = n->parent;
+                      n->parent = nright;
+                      if (nrightleft != NULL)
+                        nrightleft->parent = n;
+
+                      nright->balance -= 1;
+                      n->balance = - nright->balance;
+
+                      *np = nright;
+                      height_diff = (height_diff < 0
+                                     ? - nright->balance - 1
+                                     : - nright->balance);
+                    }
+                  else
+                    {
+                      node *L = n->right = nrightleft->left;
+                      node *R = nright->left = nrightleft->right;
+                      nrightleft->left = n;
+                      nrightleft->right = nright;
+
+                      nrightleft->parent = n->parent;
+                      if (L != NULL)
+                        L->parent = n;
+                      if (R != NULL)
+                        R->parent = nright;
+                      n->parent = nrightleft;
+                      nright->parent = nrightleft;
+
+                      n->balance = (nrightleft->balance > 0 ? -1 : 0);
+                      nright->balance = (nrightleft->balance < 0 ? 1 : 0);
+                      nrightleft->balance = 0;
+
+                      *np = nrightleft;
+                      height_diff = (height_diff < 0 ? -1 : 0);
+                    }
+                }
+              n = *np;
+            }
+          else
+            {
+              /* No rotation needed.  Only propagation of the height change to
+                 the next higher level.  */
+              if (height_diff < 0)
+                height_diff = (previous_balance == 0 ? 0 : -1);
+              else
+                height_diff = (n->balance == 0 ? 0 : 1);
+            }
+
+          if (height_diff == 0)
+            break;
+
+          parent = n->parent;
+          if (parent == NULL)
+            break;
+        }
+    }
+
+  /* Adds NEW_NODE as a leaf: as the left child of PARENT if AS_LEFT, as its
+     right child otherwise, or as the root if PARENT is NULL.  */
+  void add_leaf (node *parent, bool as_left, node *new_node)
+    {
+      new_node->left = NULL;
+      new_node->right = NULL;
+      new_node->parent = parent;
+      new_node->balance = 0;
+
+      if (parent == NULL)
+        _root = new_node;
+      else
+        {
+          bool height_inc;
+          if (as_left)
+            {
+              parent->left = new_node;
+              parent->balance--;
+              height_inc = (parent->right == NULL);
+            }
+          else
+            {
+              parent->right = new_node;
+              parent->balance++;
+              height_inc = (parent->left == NULL);
+            }
+          if (height_inc && parent->parent != NULL)
+            rebalance (parent, 1, parent->parent);
+        }
+
+      _count++;
+    }
+
+  /* Removes N from the tree, without freeing it.  */
+  void remove_node (node *n)
+    {
+      node *parent = n->parent;
+
+      if (n->left == NULL || n->right == NULL)
+        {
+          /* Replace n with its only child, or with NULL.  */
+          node *child = (n->left != NULL ? n->left : n->right);
+
+          if (child != NULL)
+            child->parent = parent;
+          if (parent == NULL)
+            _root = child;
+          else
+            {
+              if (parent->left == n)
+                parent->left = child;
+              else
+                parent->right = child;
+
+              rebalance (child, -1, parent);
+            }
+        }
+      else
+        {
+          /* Replace n with the rightmost element of the n->left subtree.  */
+          node *subst = rightmost (n->left);
+          node *subst_parent = subst->parent;
+          node *child = subst->left;
+
+          /* When subst_parent == n, subst is n->left and keeps its left
+             subtree; see gl_avltree_ordered.h.  */
+          if (subst_parent != n)
+            {
+              if (child != NULL)
+                child->parent = subst_parent;
+              subst_parent->right = child;
+
+              subst->left = n->left;
+              subst->left->parent = subst;
+            }
+          subst->right = n->right;
+          subst->right->parent = subst;
+          subst->balance = n->balance;
+          subst->parent = parent;
+          if (parent == NULL)
+            _root = subst;
+          else if (parent->left == n)
+            parent->left = subst;
+          else
+            parent->right = subst;
+
+          rebalance (child, -1, subst_parent != n ? subst_parent : subst);
+        }
+
+      _count--;
+    }
+};
+
+/* gl_ValueOSet is an ordered set that stores its elements of type ELTYPE by
+   value.
+
+   Unlike gl_OSet, it does not go through the gl_oset vtable: all operations
+   are inline member functions, and the element ordering COMPARE is a template
+   parameter, so that the compiler can inline it.  Like std::less, COMPARE
+   returns true if its first argument is less than its second argument; two
+   elements are considered equal if neither is less than the other.
+   It is implemented as an AVL tree, like GL_AVLTREE_OSET.
+
+   Unlike gl_OSet, it owns its elements: copying a gl_ValueOSet copies the
+   elements, and the destructor destroys them.
+   Upon out-of-memory, the member functions throw std::bad_alloc.
+   The destructor of ELTYPE must not throw.
+
+   This class requires C++11 or newer.  */
+
+template <class ELTYPE, class COMPARE = std::less<ELTYPE> >
+class gl_ValueOSet : private gl_ValueOSet_base
+{
+public:
+  // ------------------------------ Constructors ------------------------------
+
+  /* Creates an empty set.
+     COMPARE is the element comparison function object.  */
+  explicit gl_ValueOSet (const COMPARE& compare = COMPARE ())
+    : _compare (compare)
+    {}
+
+  /* Copy constructor.  Copies the elements.  */
+  gl_ValueOSet (const gl_ValueOSet& x)
+    : _compare (x._compare)
+    {
+      _root = copy_subtree (x._root, NULL);
+      _count = x._count;
+    }
+
+  /* Move constructor.  Leaves X empty.  */
+  gl_ValueOSet (gl_ValueOSet&& x) noexcept
+    : _compare (std::move (x._compare))
+    {
+      _root = x._root;
+      _count = x._count;
+      x._root = NULL;
+      x._count = 0;
+    }
+
+  /* Assignment operator.  Copies or moves the elements of X.  */
+  gl_ValueOSet& operator= (gl_ValueOSet x)
+    { swap (x); return *this; }
+
+  // ------------------------------- Destructor -------------------------------
+
+  ~gl_ValueOSet ()
+    { free_subtree (_root); }
+
+  // ----------------------- Read-only member functions -----------------------
+
+  /* Returns the current number of elements in the ordered set.  */
+  size_t size () const
+    { return _count; }
+
+  /* Returns true if the ordered set is empty.  */
+  bool empty () const
+    { return _count == 0; }
+
+  /* Searches whether an element is already in the ordered set.
+     Returns true if found, or false if not present in the set.  */
+  bool search (const ELTYPE& elt) const
+    { return find_node (elt) != NULL; }
+
+  // ----------------------- Modifying member functions -----------------------
+
+  /* Adds an element to the ordered set.
+     Returns true if it was not already in the set and added, false
+     otherwise.  */
+  bool add (const ELTYPE& elt)
+    { return add_copy (elt); }
+  bool add (ELTYPE&& elt)
+    { return add_copy (std::move (elt)); }
+
+  /* Constructs an element from ARGS and adds it to the ordered set.
+     Returns true if it was not already in the set and added, false
+     otherwise.  */
+  template <class... ARGS>
+  bool emplace (ARGS&&... args)
+    {
+      vnode *new_node = new vnode (std::forward<ARGS>(args)...);
+      node *parent;
+      bool as_left;
+      if (!find_position (new_node->value, parent, as_left))
+        {
+          delete new_node;
+          return false;
+        }
+      add_leaf (parent, as_left, new_node);
+      return true;
+    }
+
+  /* Removes an element from the ordered set.
+     Returns true if it was found and removed.  */
+  bool remove (const ELTYPE& elt)
+    {
+      node *n = find_node (elt);
+      if (n == NULL)
+        return false;
+      remove_node (n);
+      delete static_cast<vnode *>(n);
+      return true;
+    }
+
+  /* Removes all elements from the ordered set.  */
+  void clear ()
+    {
+      free_subtree (_root);
+      _root = NULL;
+      _count = 0;
+    }
+
+  /* Exchanges the contents of this set and X.  */
+  void swap (gl_ValueOSet& x) noexcept
+    {
+      std::swap (_compare, x._compare);
+      std::swap (_root, x._root);
+      std::swap (_count, x._count);
+    }
+
+  // ------------------------------ Private stuff ------------------------------
+
+private:
+  struct vnode : node
+  {
+    ELTYPE value;
+
+    template <class... ARGS>
+    explicit vnode (ARGS&&... args)
+      : value (std::forward<ARGS>(args)...)
+      {}
+  };
+
+  COMPARE _compare;
+
+  static const ELTYPE& value_of (const node *n)
+    { return static_cast<const vnode *>(n)->value; }
+
+  /* Returns the first node whose element is not less than ELT, or NULL.  */
+  node *lower_bound_node (const ELTYPE& elt) const
+    {
+      node *result = NULL;
+      for (node *n = _root; n != NULL; )
+        if (_compare (value_of (n), elt))
+          n = n->right;
+        else
+          {
+            result = n;
+            n = n->left;
+          }
+      return result;
+    }
+
+  /* Returns the first node whose element is greater than ELT, or NULL.  */
+  node *upper_bound_node (const ELTYPE& elt) const
+    {
+      node *result = NULL;
+      for (node *n = _root; n != NULL; )
+        if (_compare (elt, value_of (n)))
+          {
+            result = n;
+            n = n->left;
+          }
+        else
+          n = n->right;
+      return result;
+    }
+
+  /* Returns the node whose element is equal to ELT, or NULL.  */
+  node *find_node (const ELTYPE& elt) const
+    {
+      node *n = lower_bound_node (elt);
+      return (n != NULL && !_compare (elt, value_of (n)) ? n : NULL);
+    }
+
+  /* Determines where ELT would be added as a leaf.
+     Returns false if an equal element is already in the set.  */
+  bool find_position (const ELTYPE& elt, node *&parent, bool &as_left) const
+    {
+      node *candidate = NULL;
+      parent = NULL;
+      as_left = false;
+      for (node *n = _root; n != NULL; )
+        {
+          parent = n;
+          if (_compare (value_of (n), elt))
+            {
+              as_left = false;
+              n = n->right;
+            }
+          else
+            {
+              candidate = n;
+              as_left = true;
+              n = n->left;
+            }
+        }
+      return !(candidate != NULL && !_compare (elt, value_of (candidate)));
+    }
+
+  template <class U>
+  bool add_copy (U&& elt)
+    {
+      node *parent;
+      bool as_left;
+      if (!find_position (elt, parent, as_left))
+        return false;
+      add_leaf (parent, as_left, new vnode (std::forward<U>(elt)));
+      return true;
+    }
+
+  /* Returns a copy of the subtree N, with the given PARENT.  */
+  static node *copy_subtree (const node *n, node *parent)
+    {
+      if (n == NULL)
+        return NULL;
+      vnode *copy = new vnode (value_of (n));
+      copy->left = NULL;
+      copy->right = NULL;
+      copy->parent = parent;
+      copy->balance = n->balance;
+      try
+        {
+          copy->left = copy_subtree (n->left, copy);
+          copy->right = copy_subtree (n->right, copy);
+        }
+      catch (...)
+        {
+          free_subtree (copy);
+          throw;
+        }
+      return copy;
+    }
+
+  /* Destroys and frees the subtree N.  */
+  static void free_subtree (node *n)
+    {
+      /* Recursion depth is at most 1.44 log2(_count + 2).  */
+      if (n != NULL)
+        {
+          free_subtree (n->left);
+          free_subtree (n->right);
+          delete static_cast<vnode *>(n);
+        }
+    }
+
+public:
+  // -------------------------------- Iterators --------------------------------
+  // Bidirectional iterators, like those of std::set.  The elements cannot be
+  // modified through them, since this would break the order.
+  // Removing an element invalidates only the iterators that point to it.
+
+  class iterator
+  {
+  public:
+    typedef std::bidirectional_iterator_tag iterator_category;
+    typedef ELTYPE value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const ELTYPE * pointer;
+    typedef const ELTYPE & reference;
+
+    iterator ()
+      : _set (NULL), _node (NULL)
+      {}
+
+    reference operator* () const
+      { return value_of (_node); }
+    pointer operator-> () const
+      { return &value_of (_node); }
+
+    iterator& operator++ ()
+      { _node = next_node (_node); return *this; }
+    iterator operator++ (int)
+      { iterator result = *this; ++*this; return result; }
+    iterator& operator-- ()
+      {
+        _node = (_node != NULL ? prev_node (_node) : rightmost (_set->_root));
+        return *this;
+      }
+    iterator operator-- (int)
+      { iterator result = *this; --*this; return result; }
+
+    friend bool operator== (const iterator& a, const iterator& b)
+      { return a._node == b._node; }
+    friend bool operator!= (const iterator& a, const iterator& b)
+      { return a._node != b._node; }
+
+  private:
+    friend class gl_ValueOSet;
+
+    iterator (const gl_ValueOSet *set, node *n)
+      : _set (set), _node (n)
+      {}
+
+    const gl_ValueOSet *_set;
+    node *_node;            /* NULL for the end */
+  };
+
+  typedef iterator const_iterator;
+
+  /* Returns an iterator to the smallest element.  */
+  iterator begin () const
+    { return iterator (this, leftmost (_root)); }
+
+  /* Returns an iterator past the largest element.  */
+  iterator end () const
+    { return iterator (this, NULL); }
+
+  /* Returns an iterator to the element equal to ELT, or end().  */
+  iterator find (const ELTYPE& elt) const
+    { return iterator (this, find_node (elt)); }
+
+  /* Returns an iterator to the first element that is not less than ELT, or
+     end().  */
+  iterator lower_bound (const ELTYPE& elt) const
+    { return iterator (this, lower_bound_node (elt)); }
+
+  /* Returns an iterator to the first element that is greater than ELT, or
+     end().  */
+  iterator upper_bound (const ELTYPE& elt) const
+    { return iterator (this, upper_bound_node (elt)); }
+
+  /* Removes the element at POS, which must not be end().
+     Returns an iterator to the element after it.  */
+  iterator erase (iterator pos)
+    {
+      node *n = pos._node;
+      iterator next (this, next_node (n));
+      remove_node (n);
+      delete static_cast<vnode *>(n);
+      return next;
+    }
+};
+
+#endif
+
 #endif /* _GL_OSET_HH */
@@ -53,6 +53,8 @@ struct CONTAINER_IMPL
   struct CONTAINER_IMPL_BASE base;
   struct NODE_IMPL *root;           /* root node or NULL */
   size_t count;                     /* number of nodes */
+  /* Where the nodes are allocated.  */
+  struct gl_nodepool nodepool;
 };
 
 /* A red-black tree of height h has a black-height bh >= ceil(h/2) and
@@ -530,7 +532,7 @@ gl_tree_nx_add_first (CONTAINER_T container, NODE_PAYLOAD_PARAMS)
 {
   /* Create new node.  */
   NODE_T new_node =
-    (struct NODE_IMPL *) malloc (sizeof (struct NODE_IMPL));
+    (struct NODE_IMPL *) gl_nodepool_alloc (&container->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -593,7 +595,7 @@ gl_tree_nx_add_before (CONTAINER_T container, NODE_T node, NODE_PAYLOAD_PARAMS)
 {
   /* Create new node.  */
   NODE_T new_node =
-    (struct NODE_IMPL *) malloc (sizeof (struct NODE_IMPL));
+    (struct NODE_IMPL *) gl_nodepool_alloc (&container->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -633,7 +635,7 @@ gl_tree_nx_add_after (CONTAINER_T container, NODE_T node, NODE_PAYLOAD_PARAMS)
 {
   /* Create new node.  */
   NODE_T new_node =
-    (struct NODE_IMPL *) malloc (sizeof (struct NODE_IMPL));
+    (struct NODE_IMPL *) gl_nodepool_alloc (&container->nodepool);
 
   if (new_node == NULL)
     return NULL;
@@ -768,7 +770,7 @@ gl_tree_remove_node (CONTAINER_T container, NODE_T node)
 {
   gl_tree_remove_node_no_free (container, node);
   NODE_PAYLOAD_DISPOSE (container, node)
-  free (node);
+  gl_nodepool_free (&container->nodepool, node);
   return true;
 }
 
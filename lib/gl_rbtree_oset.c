@@ -22,6 +22,8 @@
 
 #include <stdlib.h>
 
+#include "gl_nodepool.h"
+
 /* -------------------------- gl_oset_t Data Type -------------------------- */
 
 /* Parameterization of gl_rbtree_ordered.h.  */
@@ -60,10 +62,13 @@ gl_rbtree_oset_check_invariants (gl_oset_t set)
 const struct gl_oset_implementation gl_rbtree_oset_implementation =
   {
     gl_tree_nx_create_empty,
+    gl_tree_nx_create_empty_with_pool,
+    gl_tree_nx_create,
     gl_tree_size,
     gl_tree_search,
     gl_tree_search_atleast,
     gl_tree_nx_add,
+    gl_tree_nx_add_sorted_array,
     gl_tree_remove,
     gl_tree_update,
     gl_tree_oset_free,
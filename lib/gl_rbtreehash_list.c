@@ -22,8 +22,11 @@
 
 #include <stdint.h> /* for uintptr_t, SIZE_MAX */
 #include <stdlib.h>
+/* Get memmove.  */
+#include <string.h>
 
 #include "gl_rbtree_oset.h"
+#include "gl_nodepool.h"
 #include "xsize.h"
 
 #define WITH_HASHTABLE 1
@@ -96,6 +99,7 @@ gl_rbtreehash_list_check_invariants (gl_list_t list)
 const struct gl_list_implementation gl_rbtreehash_list_implementation =
   {
     gl_tree_nx_create_empty,
+    gl_tree_nx_create_empty_with_pool,
     gl_tree_nx_create,
     gl_tree_size,
     gl_tree_node_value,
@@ -113,8 +117,10 @@ const struct gl_list_implementation gl_rbtreehash_list_implementation =
     gl_tree_nx_add_before,
     gl_tree_nx_add_after,
     gl_tree_nx_add_at,
+    gl_tree_nx_add_all_at,
     gl_tree_remove_node,
     gl_tree_remove_at,
+    gl_tree_remove_range,
     gl_tree_remove,
     gl_tree_list_free,
     gl_tree_iterator,
@@ -126,5 +132,6 @@ const struct gl_list_implementation gl_rbtreehash_list_implementation =
     gl_tree_sortedlist_indexof,
     gl_tree_sortedlist_indexof_from_to,
     gl_tree_sortedlist_nx_add,
+    gl_tree_sortedlist_nx_merge_array,
     gl_tree_sortedlist_remove
   };
@@ -258,6 +258,21 @@ gl_sublist_nx_add_at (gl_list_t list, size_t position, const void *elt)
   return INDEX_TO_NODE (position);
 }
 
+static int
+gl_sublist_nx_add_all_at (gl_list_t list, size_t position,
+                          size_t count, const void **contents)
+{
+  if (!(position <= list->end - list->start))
+    /* Invalid argument.  */
+    abort ();
+  if (gl_list_nx_add_all_at (list->whole, list->start + position,
+                             count, contents)
+      < 0)
+    return -1;
+  list->end += count;
+  return 0;
+}
+
 static bool
 gl_sublist_remove_node (gl_list_t list, gl_list_node_t node)
 {
@@ -277,6 +292,17 @@ gl_sublist_remove_at (gl_list_t list, size_t position)
   return gl_list_remove_at (list->whole, list->start + position);
 }
 
+static void
+gl_sublist_remove_range (gl_list_t list, size_t start_index, size_t end_index)
+{
+  if (!(start_index <= end_index && end_index <= list->end - list->start))
+    /* Invalid arguments.  */
+    abort ();
+  gl_list_remove_range (list->whole,
+                        list->start + start_index, list->start + end_index);
+  list->end -= end_index - start_index;
+}
+
 static bool
 gl_sublist_remove (gl_list_t list, const void *elt)
 {
@@ -406,6 +432,16 @@ gl_sublist_sortedlist_nx_add (gl_list_t list,
   abort ();
 }
 
+static int
+gl_sublist_sortedlist_nx_merge_array (gl_list_t list,
+                                      gl_listelement_compar_fn compar,
+                                      size_t count, const void **contents)
+{
+  /* It's impossible to implement this method without risking to put the
+     whole list into unsorted order.  */
+  abort ();
+}
+
 static bool
 gl_sublist_sortedlist_remove (gl_list_t list,
                               gl_listelement_compar_fn compar,
@@ -421,6 +457,7 @@ gl_sublist_sortedlist_remove (gl_list_t list,
 
 static const struct gl_list_implementation gl_sublist_list_implementation =
   {
+    gl_sublist_nx_create_empty,
     gl_sublist_nx_create_empty,
     gl_sublist_nx_create_fill,
     gl_sublist_size,
@@ -439,8 +476,10 @@ static const struct gl_list_implementation gl_sublist_list_implementation =
     gl_sublist_nx_add_before,
     gl_sublist_nx_add_after,
     gl_sublist_nx_add_at,
+    gl_sublist_nx_add_all_at,
     gl_sublist_remove_node,
     gl_sublist_remove_at,
+    gl_sublist_remove_range,
     gl_sublist_remove,
     gl_sublist_list_free,
     gl_sublist_iterator,
@@ -452,6 +491,7 @@ static const struct gl_list_implementation gl_sublist_list_implementation =
     gl_sublist_sortedlist_indexof,
     gl_sublist_sortedlist_indexof_from_to,
     gl_sublist_sortedlist_nx_add,
+    gl_sublist_sortedlist_nx_merge_array,
     gl_sublist_sortedlist_remove
   };
 
@@ -36,7 +36,8 @@ extern "C" {
      - Modifications to the sublist affect the whole list.
      - Modifications to the whole list are immediately visible in the sublist.
      - The sublist is only valid as long as the whole list is valid.
-     - The sublist must not be passed to the gl_list_sortedlist_add() function.
+     - The sublist must not be passed to the gl_list_sortedlist_add() and
+       gl_sortedlist_merge_array() functions.
  */
 #if 0 /* declared in gl_xsublist.h */
 extern gl_list_t gl_sublist_create (gl_list_t whole_list,
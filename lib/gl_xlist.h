@@ -47,6 +47,13 @@ extern gl_list_t gl_list_create_empty (gl_list_implementation_t implementation,
                                        bool allow_duplicates)
   /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
   _GL_ATTRIBUTE_RETURNS_NONNULL;
+extern gl_list_t gl_list_create_empty_with_pool (gl_list_implementation_t implementation,
+                                                 gl_listelement_equals_fn equals_fn,
+                                                 gl_listelement_hashcode_fn hashcode_fn,
+                                                 gl_listelement_dispose_fn dispose_fn,
+                                                 bool allow_duplicates)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
 extern gl_list_t gl_list_create (gl_list_implementation_t implementation,
                                  gl_listelement_equals_fn equals_fn,
                                  gl_listelement_hashcode_fn hashcode_fn,
@@ -69,9 +76,14 @@ extern gl_list_node_t gl_list_add_after (gl_list_t list, gl_list_node_t node,
                                          const void *elt);
 extern gl_list_node_t gl_list_add_at (gl_list_t list, size_t position,
                                       const void *elt);
+extern void gl_list_add_all_at (gl_list_t list, size_t position,
+                                size_t count, const void **contents);
 extern gl_list_node_t gl_sortedlist_add (gl_list_t list,
                                          gl_listelement_compar_fn compar,
                                          const void *elt);
+extern void gl_sortedlist_merge_array (gl_list_t list,
+                                       gl_listelement_compar_fn compar,
+                                       size_t count, const void **contents);
 #endif
 
 GL_XLIST_INLINE
@@ -92,6 +104,24 @@ gl_list_create_empty (gl_list_implementation_t implementation,
   return result;
 }
 
+GL_XLIST_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
+_GL_ATTRIBUTE_RETURNS_NONNULL
+gl_list_t
+gl_list_create_empty_with_pool (gl_list_implementation_t implementation,
+                                gl_listelement_equals_fn equals_fn,
+                                gl_listelement_hashcode_fn hashcode_fn,
+                                gl_listelement_dispose_fn dispose_fn,
+                                bool allow_duplicates)
+{
+  gl_list_t result =
+    gl_list_nx_create_empty_with_pool (implementation, equals_fn, hashcode_fn,
+                                       dispose_fn, allow_duplicates);
+  if (result == NULL)
+    xalloc_die ();
+  return result;
+}
+
 GL_XLIST_INLINE
 /*_GL_ATTRIBUTE_DEALLOC (gl_list_free, 1)*/
 _GL_ATTRIBUTE_RETURNS_NONNULL
@@ -191,6 +221,15 @@ gl_list_add_at (gl_list_t list, size_t position, const void *elt)
   return result;
 }
 
+GL_XLIST_INLINE void
+gl_list_add_all_at (gl_list_t list, size_t position,
+                    size_t count, const void **contents)
+{
+  int result = gl_list_nx_add_all_at (list, position, count, contents);
+  if (result < 0)
+    xalloc_die ();
+}
+
 GL_XLIST_INLINE gl_list_node_t
 gl_sortedlist_add (gl_list_t list, gl_listelement_compar_fn compar,
                    const void *elt)
@@ -201,6 +240,15 @@ gl_sortedlist_add (gl_list_t list, gl_listelement_compar_fn compar,
   return result;
 }
 
+GL_XLIST_INLINE void
+gl_sortedlist_merge_array (gl_list_t list, gl_listelement_compar_fn compar,
+                           size_t count, const void **contents)
+{
+  int result = gl_sortedlist_nx_merge_array (list, compar, count, contents);
+  if (result < 0)
+    xalloc_die ();
+}
+
 #ifdef __cplusplus
 }
 #endif
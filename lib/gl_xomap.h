@@ -47,6 +47,20 @@ extern gl_omap_t gl_omap_create_empty (gl_omap_implementation_t implementation,
                                        gl_mapvalue_dispose_fn vdispose_fn)
   /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
   _GL_ATTRIBUTE_RETURNS_NONNULL;
+extern gl_omap_t gl_omap_create_empty_with_pool (gl_omap_implementation_t implementation,
+                                                 gl_mapkey_compar_fn compar_fn,
+                                                 gl_mapkey_dispose_fn kdispose_fn,
+                                                 gl_mapvalue_dispose_fn vdispose_fn)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+extern gl_omap_t gl_omap_create (gl_omap_implementation_t implementation,
+                                 gl_mapkey_compar_fn compar_fn,
+                                 gl_mapkey_dispose_fn kdispose_fn,
+                                 gl_mapvalue_dispose_fn vdispose_fn,
+                                 size_t count,
+                                 const void **keys, const void **values)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
 extern bool gl_omap_put (gl_omap_t map, const void *key, const void *value);
 extern bool gl_omap_getput (gl_omap_t map, const void *key, const void *value,
                             const void **oldvaluep);
@@ -68,6 +82,41 @@ gl_omap_create_empty (gl_omap_implementation_t implementation,
   return result;
 }
 
+GL_XOMAP_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+_GL_ATTRIBUTE_RETURNS_NONNULL
+gl_omap_t
+gl_omap_create_empty_with_pool (gl_omap_implementation_t implementation,
+                                gl_mapkey_compar_fn compar_fn,
+                                gl_mapkey_dispose_fn kdispose_fn,
+                                gl_mapvalue_dispose_fn vdispose_fn)
+{
+  gl_omap_t result =
+    gl_omap_nx_create_empty_with_pool (implementation, compar_fn,
+                                       kdispose_fn, vdispose_fn);
+  if (result == NULL)
+    xalloc_die ();
+  return result;
+}
+
+GL_XOMAP_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_omap_free, 1)*/
+_GL_ATTRIBUTE_RETURNS_NONNULL
+gl_omap_t
+gl_omap_create (gl_omap_implementation_t implementation,
+                gl_mapkey_compar_fn compar_fn,
+                gl_mapkey_dispose_fn kdispose_fn,
+                gl_mapvalue_dispose_fn vdispose_fn,
+                size_t count, const void **keys, const void **values)
+{
+  gl_omap_t result =
+    gl_omap_nx_create (implementation, compar_fn, kdispose_fn, vdispose_fn,
+                       count, keys, values);
+  if (result == NULL)
+    xalloc_die ();
+  return result;
+}
+
 GL_XOMAP_INLINE bool
 gl_omap_put (gl_omap_t map, const void *key, const void *value)
 {
@@ -46,7 +46,20 @@ extern gl_oset_t gl_oset_create_empty (gl_oset_implementation_t implementation,
                                        gl_setelement_dispose_fn dispose_fn)
   /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
   _GL_ATTRIBUTE_RETURNS_NONNULL;
+extern gl_oset_t gl_oset_create_empty_with_pool (gl_oset_implementation_t implementation,
+                                                 gl_setelement_compar_fn compar_fn,
+                                                 gl_setelement_dispose_fn dispose_fn)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
+extern gl_oset_t gl_oset_create (gl_oset_implementation_t implementation,
+                                 gl_setelement_compar_fn compar_fn,
+                                 gl_setelement_dispose_fn dispose_fn,
+                                 size_t count, const void **contents)
+  /*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+  _GL_ATTRIBUTE_RETURNS_NONNULL;
 extern bool gl_oset_add (gl_oset_t set, const void *elt);
+extern void gl_oset_add_sorted_array (gl_oset_t set,
+                                      size_t count, const void **contents);
 #endif
 
 GL_XOSET_INLINE
@@ -64,6 +77,37 @@ gl_oset_create_empty (gl_oset_implementation_t implementation,
   return result;
 }
 
+GL_XOSET_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+_GL_ATTRIBUTE_RETURNS_NONNULL
+gl_oset_t
+gl_oset_create_empty_with_pool (gl_oset_implementation_t implementation,
+                                gl_setelement_compar_fn compar_fn,
+                                gl_setelement_dispose_fn dispose_fn)
+{
+  gl_oset_t result =
+    gl_oset_nx_create_empty_with_pool (implementation, compar_fn, dispose_fn);
+  if (result == NULL)
+    xalloc_die ();
+  return result;
+}
+
+GL_XOSET_INLINE
+/*_GL_ATTRIBUTE_DEALLOC (gl_oset_free, 1)*/
+_GL_ATTRIBUTE_RETURNS_NONNULL
+gl_oset_t
+gl_oset_create (gl_oset_implementation_t implementation,
+                gl_setelement_compar_fn compar_fn,
+                gl_setelement_dispose_fn dispose_fn,
+                size_t count, const void **contents)
+{
+  gl_oset_t result =
+    gl_oset_nx_create (implementation, compar_fn, dispose_fn, count, contents);
+  if (result == NULL)
+    xalloc_die ();
+  return result;
+}
+
 GL_XOSET_INLINE bool
 gl_oset_add (gl_oset_t set, const void *elt)
 {
@@ -73,6 +117,14 @@ gl_oset_add (gl_oset_t set, const void *elt)
   return result;
 }
 
+GL_XOSET_INLINE void
+gl_oset_add_sorted_array (gl_oset_t set, size_t count, const void **contents)
+{
+  int result = gl_oset_nx_add_sorted_array (set, count, contents);
+  if (result < 0)
+    xalloc_die ();
+}
+
 #ifdef __cplusplus
 }
 #endif
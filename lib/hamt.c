@@ -24,6 +24,11 @@
 #include <inttypes.h>
 #include <stdbit.h>
 #include <stdlib.h>
+#include <string.h>
+#if GNULIB_HAMT_PARALLEL
+# include "glthread/lock.h"
+# include "glthread/thread.h"
+#endif
 #include "verify.h"
 #include "xalloc.h"
 
@@ -107,6 +112,10 @@ struct subtrie
   /* Nodes carry labels from 0 to 31.  The i-th bit in MAP is set if
      the node labelled i is present.  */
   uint32_t map;
+  /* The number of nodes the NODES array has room for.  It is larger
+     than the population count of MAP only in subtries that grew in a
+     transient hamt.  */
+  int capacity;
   /* The length of the NODES array is the population count of MAP.
      The order of the nodes corresponds to the order of the 1-bits in
      MAP.  */
@@ -130,6 +139,12 @@ struct hamt
   Hamt_entry *root;
 };
 
+/* A transient hamt is a hamt that is only updated destructively.  */
+struct hamt_transient
+{
+  struct hamt hamt;
+};
+
 /*******************/
 /* Function Tables */
 /*******************/
@@ -240,13 +255,15 @@ trienode_count (const struct subtrie *subtrie)
   return stdc_count_ones (subtrie->map);
 }
 
-/* Allocate a partially initialized subtrie with a given number of nodes.  */
+/* Allocate a partially initialized subtrie with room for a given
+   number of nodes.  */
 static struct subtrie *
-alloc_subtrie (int node_count)
+alloc_subtrie (int capacity)
 {
   struct subtrie *subtrie
-    = xmalloc (FLEXNSIZEOF (struct subtrie, nodes, node_count));
+    = xmalloc (FLEXNSIZEOF (struct subtrie, nodes, capacity));
   init_ref_counter (&subtrie->ref_count, subtrie_entry);
+  subtrie->capacity = capacity;
   return subtrie;
 }
 
@@ -313,12 +330,10 @@ static Hamt_entry *
 remove_subtrie_entry (struct subtrie *subtrie, int i, int j)
 {
   int n = trienode_count (subtrie) - 1;
-  if (n == 1)
-    {
-      if (j == 0)
-        return copy_entry (subtrie->nodes[1]);
-      return copy_entry (subtrie->nodes[0]);
-    }
+  /* A remaining subtrie cannot take the place of its parent, as it
+     is indexed by the hash bits of the next level.  */
+  if (n == 1 && entry_type (subtrie->nodes[1 - j]) != subtrie_entry)
+    return copy_entry (subtrie->nodes[1 - j]);
   struct subtrie *new_subtrie = alloc_subtrie (n);
   new_subtrie->map = subtrie->map & ~(1 << i);
   for (int k = 0; k < n; ++k)
@@ -331,6 +346,37 @@ remove_subtrie_entry (struct subtrie *subtrie, int i, int j)
   return (Hamt_entry *) new_subtrie;
 }
 
+/* Insert an entry labelled i at the j-th position of an unshared
+   subtrie, in place if there is room.  Otherwise, return a new subtrie
+   that takes over the nodes; the old subtrie is left empty so that
+   freeing it doesn't free the nodes.  If TRANSIENT, the new subtrie
+   gets room for further insertions.  */
+static struct subtrie *
+insert_entry_x (struct subtrie *subtrie, int i, int j, Hamt_entry *entry,
+                bool transient)
+{
+  int n = trienode_count (subtrie);
+  struct subtrie *new_subtrie = subtrie;
+  if (n < subtrie->capacity)
+    memmove (subtrie->nodes + j + 1, subtrie->nodes + j,
+             (n - j) * sizeof *subtrie->nodes);
+  else
+    {
+      new_subtrie
+        = alloc_subtrie (transient ? stdc_bit_ceil ((unsigned int) n + 1)
+                         : n + 1);
+      new_subtrie->map = subtrie->map;
+      memcpy (new_subtrie->nodes, subtrie->nodes,
+              j * sizeof *subtrie->nodes);
+      memcpy (new_subtrie->nodes + j + 1, subtrie->nodes + j,
+              (n - j) * sizeof *subtrie->nodes);
+      subtrie->map = 0;
+    }
+  new_subtrie->map |= (uint32_t) 1 << i;
+  new_subtrie->nodes[j] = entry;
+  return new_subtrie;
+}
+
 /* Return a new entry that has the entry at position j removed.  */
 static Hamt_entry *
 remove_bucket_entry (struct bucket *bucket, int j)
@@ -454,7 +500,7 @@ bucket_lookup (const struct function_table *functions,
   for (size_t i = 0; i < elt_count; ++i)
     {
       if (compare_elements (functions, elt, elts[i]))
-        return *elts;
+        return elts[i];
     }
   return NULL;
 }
@@ -608,13 +654,13 @@ bucket_insert (const struct function_table *functions, struct bucket *bucket,
 static Hamt_entry *entry_insert (const struct function_table *functions,
                                  Hamt_entry *subtrie, Hamt_entry **elt_ptr,
                                  size_t hash, int depth, bool replace,
-                                 bool shared);
+                                 bool shared, bool transient);
 
 /* Insert or replace an element in a subtrie.  */
 static struct subtrie *
 subtrie_insert (const struct function_table *functions, struct subtrie *subtrie,
                 Hamt_entry **elt_ptr, size_t hash, int depth, bool replace,
-                bool shared)
+                bool shared, bool transient)
 {
   uint32_t map = subtrie->map;
   int i = hash & 31;
@@ -624,7 +670,7 @@ subtrie_insert (const struct function_table *functions, struct subtrie *subtrie,
       Hamt_entry *entry = subtrie->nodes[j];
       Hamt_entry *new_entry
         = entry_insert (functions, entry, elt_ptr, hash >> 5, depth + 1,
-                        replace, shared);
+                        replace, shared, transient);
       if (new_entry != entry)
         {
           if (shared)
@@ -637,20 +683,23 @@ subtrie_insert (const struct function_table *functions, struct subtrie *subtrie,
   Hamt_entry *entry = copy_entry (*elt_ptr);
   if (replace)
     *elt_ptr = NULL;
-  return insert_entry (subtrie, i, j, entry);
+  if (shared)
+    return insert_entry (subtrie, i, j, entry);
+  return insert_entry_x (subtrie, i, j, entry, transient);
 }
 
 /* Insert or replace an element in an entry.
 
    REPLACE is true if we want replace instead of insert semantics.
    SHARED is false if a destructive update has been requested and none
-   of the parent nodes are shared.  If an entry cannot be inserted
+   of the parent nodes are shared.  TRANSIENT is true if the update is
+   done through a transient hamt.  If an entry cannot be inserted
    because the same entry with respect to pointer equality is already
    present, *ELT_PTR is set to NULL to mark this special case.  */
 static Hamt_entry *
 entry_insert (const struct function_table *functions, Hamt_entry *entry,
               Hamt_entry **elt_ptr, size_t hash, int depth, bool replace,
-              bool shared)
+              bool shared, bool transient)
 {
   shared |= is_shared (entry);
   switch (entry_type (entry))
@@ -685,7 +734,7 @@ entry_insert (const struct function_table *functions, Hamt_entry *entry,
     case subtrie_entry:
       return (Hamt_entry *)
         subtrie_insert (functions, (struct subtrie *) entry, elt_ptr, hash,
-                        depth, replace, shared);
+                        depth, replace, shared, transient);
     case bucket_entry:
       return (Hamt_entry *)
         bucket_insert (functions, (struct bucket *) entry, elt_ptr, replace,
@@ -698,13 +747,14 @@ entry_insert (const struct function_table *functions, Hamt_entry *entry,
 /* Insert or replace an element in the root.  */
 static Hamt_entry *
 root_insert (const struct function_table *functions, Hamt_entry *root,
-             Hamt_entry **elt_ptr, bool replace, bool shared)
+             Hamt_entry **elt_ptr, bool replace, bool shared, bool transient)
 {
   if (root == NULL)
     return copy_entry (*elt_ptr);
 
  return entry_insert (functions, root, elt_ptr,
-                      hash_element (functions, *elt_ptr), 0, replace, shared);
+                      hash_element (functions, *elt_ptr), 0, replace, shared,
+                      transient);
 }
 
 /* If *ELT_PTR matches an element already in HAMT, set *ELT_PTR to the
@@ -715,7 +765,7 @@ hamt_insert (Hamt *hamt, Hamt_entry **elt_ptr)
 {
   Hamt_entry *elt = *elt_ptr;
   Hamt_entry *new_entry = root_insert (hamt->functions, hamt->root,
-                                       elt_ptr, false, true);
+                                       elt_ptr, false, true, false);
   if (*elt_ptr == NULL)
     *elt_ptr = elt;
 
@@ -737,7 +787,7 @@ hamt_replace (Hamt *hamt, Hamt_entry **elt_ptr)
   Hamt *new_hamt = XMALLOC (Hamt);
   new_hamt->functions = copy_function_table (hamt->functions);
   new_hamt->root = root_insert (hamt->functions, hamt->root, elt_ptr, true,
-                                true);
+                                true, false);
   return new_hamt;
 }
 
@@ -765,6 +815,27 @@ static Hamt_entry *entry_remove (const struct function_table *functions,
                                  Hamt_entry *entry, Hamt_entry **elt_ptr,
                                  size_t hash, int depth, bool shared);
 
+/* Remove the entry labelled i from position j of an unshared subtrie
+   in place and return the resulting entry.  If the subtrie is
+   replaced by its remaining node, it is left empty so that freeing it
+   doesn't free the node.  */
+static Hamt_entry *
+remove_subtrie_entry_x (const struct function_table *functions,
+                        struct subtrie *subtrie, int i, int j)
+{
+  int n = trienode_count (subtrie) - 1;
+  free_entry (functions, subtrie->nodes[j]);
+  memmove (subtrie->nodes + j, subtrie->nodes + j + 1,
+           (n - j) * sizeof *subtrie->nodes);
+  subtrie->map &= ~((uint32_t) 1 << i);
+  if (n == 1 && entry_type (subtrie->nodes[0]) != subtrie_entry)
+    {
+      subtrie->map = 0;
+      return subtrie->nodes[0];
+    }
+  return (Hamt_entry *) subtrie;
+}
+
 /* Remove an element in a subtrie if found.  */
 static Hamt_entry *
 subtrie_remove (const struct function_table *functions, struct subtrie *subtrie,
@@ -780,7 +851,11 @@ subtrie_remove (const struct function_table *functions, struct subtrie *subtrie,
         = entry_remove (functions, entry, elt_ptr, hash >> 5, depth + 1,
                         shared);
       if (new_entry == NULL)
-        return remove_subtrie_entry (subtrie, i, j);
+        {
+          if (shared)
+            return remove_subtrie_entry (subtrie, i, j);
+          return remove_subtrie_entry_x (functions, subtrie, i, j);
+        }
       if (new_entry != entry)
         {
           if (shared)
@@ -893,7 +968,7 @@ static size_t subtrie_do_while (const struct subtrie *subtrie,
   for (int j = 0; j < n; ++j)
     {
       cnt += entry_do_while (*node_ptr++, proc, data, success);
-      if (!success)
+      if (!*success)
         return cnt;
     }
   return cnt;
@@ -932,6 +1007,105 @@ hamt_do_while (const Hamt *hamt, Hamt_processor *proc, void *data)
   return entry_do_while (hamt->root, proc, data, &success);
 }
 
+#if GNULIB_HAMT_PARALLEL
+
+/* The context of a parallel walk.  */
+struct parallel_context
+{
+  const struct subtrie *root;
+  Hamt_processor *proc;
+  void *data;
+  /* Set when a call of PROC has returned false.  */
+  GL_HAMT_ATOMIC (bool) stop;
+  /* LOCK protects NEXT, the position of the next node of ROOT to walk,
+     and COUNT.  */
+  gl_lock_t lock;
+  int next;
+  size_t count;
+};
+
+/* The processor that the threads of a parallel walk pass to
+   entry_do_while.  */
+static bool
+parallel_processor (Hamt_entry *elt, void *data)
+{
+  struct parallel_context *ctx = data;
+  if (ctx->stop)
+    return false;
+  if (ctx->proc (elt, ctx->data))
+    return true;
+  ctx->stop = true;
+  return false;
+}
+
+/* Walk the nodes of the root that no other thread walks.  */
+static void *
+parallel_worker (void *arg)
+{
+  struct parallel_context *ctx = arg;
+  int n = trienode_count (ctx->root);
+  size_t cnt = 0;
+  for (;;)
+    {
+      gl_lock_lock (ctx->lock);
+      int j = ctx->next++;
+      gl_lock_unlock (ctx->lock);
+      if (j >= n || ctx->stop)
+        break;
+      bool success = true;
+      cnt += entry_do_while (ctx->root->nodes[j], parallel_processor, ctx,
+                             &success);
+    }
+  gl_lock_lock (ctx->lock);
+  ctx->count += cnt;
+  gl_lock_unlock (ctx->lock);
+  return NULL;
+}
+
+/* Call PROC for every entry of the hamt, in up to THREAD_COUNT threads,
+   until it returns false.  Return the number of calls that returned
+   true.  */
+size_t
+hamt_do_while_parallel (const Hamt *hamt, Hamt_processor *proc, void *data,
+                        unsigned int thread_count)
+{
+  /* Without atomics, the threads could not tell each other to stop
+     without a data race.  */
+  if (hamt->root == NULL || entry_type (hamt->root) != subtrie_entry
+      || thread_count <= 1 || !HAVE_C11__ATOMIC)
+    return hamt_do_while (hamt, proc, data);
+
+  struct parallel_context ctx;
+  ctx.root = (const struct subtrie *) hamt->root;
+  ctx.proc = proc;
+  ctx.data = data;
+  ctx.stop = false;
+  gl_lock_init (ctx.lock);
+  ctx.next = 0;
+  ctx.count = 0;
+
+  /* Each thread walks at least one node of the root.  */
+  int n = trienode_count (ctx.root);
+  if (thread_count > n)
+    thread_count = n;
+
+  /* The current thread is one of the threads.  If a thread cannot be
+     created, the other threads do its work.  */
+  gl_thread_t threads[32];
+  unsigned int created = 0;
+  while (created < thread_count - 1
+         && glthread_create (&threads[created], parallel_worker, &ctx) == 0)
+    created++;
+  parallel_worker (&ctx);
+  for (unsigned int k = 0; k < created; k++)
+    gl_thread_join (threads[k], NULL);
+
+  gl_lock_destroy (ctx.lock);
+  return ctx.count;
+}
+
+#endif /* GNULIB_HAMT_PARALLEL */
+
 /* Create an iterator with a copy of the hamt.
 
    For a valid iterator state the following is true: If DEPTH is
@@ -1033,19 +1207,166 @@ hamt_iterator_next (Hamt_iterator *iter, Hamt_entry **elt_ptr)
   return true;
 }
 
+/***************/
+/* Differences */
+/***************/
+
+/* The context of hamt_diff.  */
+struct diff_context
+{
+  const struct function_table *functions;
+  Hamt_diff_processor *proc;
+  void *data;
+  /* The number of calls of PROC that returned true.  */
+  size_t count;
+  /* Set when a call of PROC has returned false.  */
+  bool stop;
+};
+
+/* Call PROC for ELTS, unless a previous call has returned false.  */
+static void
+report_difference (struct diff_context *ctx, Hamt_entry *old_elt,
+                   Hamt_entry *new_elt)
+{
+  if (ctx->stop)
+    return;
+  if (ctx->proc (old_elt, new_elt, ctx->data))
+    ctx->count++;
+  else
+    ctx->stop = true;
+}
+
+/* Compare the element ELT, which is in one hamt, with the entry OTHER
+   at DEPTH, which is at the same position in the other hamt.  If
+   IS_OLD, ELT is in the old hamt.  */
+static void
+element_diff (struct diff_context *ctx, Hamt_entry *elt, Hamt_entry *other,
+              int depth, bool is_old)
+{
+  Hamt_entry *match = NULL;
+  if (other != NULL)
+    {
+      /* Below _GL_HAMT_MAX_DEPTH, OTHER is a bucket, which doesn't need
+         the hash.  */
+      size_t hash = (depth < _GL_HAMT_MAX_DEPTH
+                     ? hash_element (ctx->functions, elt) >> (5 * depth)
+                     : 0);
+      match = entry_lookup (ctx->functions, other, elt, hash);
+    }
+  if (is_old)
+    {
+      if (match != elt)
+        report_difference (ctx, elt, match);
+    }
+  else
+    {
+      /* The elements that match were reported when the old hamt was
+         compared with the new one.  */
+      if (match == NULL)
+        report_difference (ctx, NULL, elt);
+    }
+}
+
+/* Compare all the elements in ENTRY, which is in one hamt, with the
+   entry OTHER at DEPTH, which is at the same position in the other
+   hamt.  If IS_OLD, ENTRY is in the old hamt.  */
+static void
+entry_diff_elements (struct diff_context *ctx, Hamt_entry *entry,
+                     Hamt_entry *other, int depth, bool is_old)
+{
+  switch (entry_type (entry))
+    {
+    case element_entry:
+      element_diff (ctx, entry, other, depth, is_old);
+      break;
+    case subtrie_entry:
+      {
+        const struct subtrie *subtrie = (const struct subtrie *) entry;
+        int n = trienode_count (subtrie);
+        for (int j = 0; j < n && !ctx->stop; ++j)
+          entry_diff_elements (ctx, subtrie->nodes[j], other, depth, is_old);
+      }
+      break;
+    case bucket_entry:
+      {
+        const struct bucket *bucket = (const struct bucket *) entry;
+        size_t elt_count = bucket->elt_count;
+        for (size_t i = 0; i < elt_count && !ctx->stop; ++i)
+          element_diff (ctx, bucket->elts[i], other, depth, is_old);
+      }
+      break;
+    default:
+      assume (0);
+    }
+}
+
+/* Compare the entries OLD_ENTRY and NEW_ENTRY, which are at the same
+   position and DEPTH in the old and the new hamt.  Either may be
+   NULL.  */
+static void
+entry_diff (struct diff_context *ctx, Hamt_entry *old_entry,
+            Hamt_entry *new_entry, int depth)
+{
+  /* Shared entries have the same elements.  */
+  if (old_entry == new_entry || ctx->stop)
+    return;
+
+  if (old_entry != NULL && new_entry != NULL
+      && entry_type (old_entry) == subtrie_entry
+      && entry_type (new_entry) == subtrie_entry)
+    {
+      /* Compare the nodes with the same label.  */
+      const struct subtrie *old_subtrie = (const struct subtrie *) old_entry;
+      const struct subtrie *new_subtrie = (const struct subtrie *) new_entry;
+      int old_j = 0;
+      int new_j = 0;
+      for (int i = 0; i < 32; ++i)
+        {
+          Hamt_entry *old_node = NULL;
+          Hamt_entry *new_node = NULL;
+          if (old_subtrie->map & ((uint32_t) 1 << i))
+            old_node = old_subtrie->nodes[old_j++];
+          if (new_subtrie->map & ((uint32_t) 1 << i))
+            new_node = new_subtrie->nodes[new_j++];
+          entry_diff (ctx, old_node, new_node, depth + 1);
+        }
+      return;
+    }
+
+  if (old_entry != NULL)
+    entry_diff_elements (ctx, old_entry, new_entry, depth, true);
+  if (new_entry != NULL)
+    entry_diff_elements (ctx, new_entry, old_entry, depth, false);
+}
+
+/* Call PROC for every difference between OLD_HAMT and NEW_HAMT until it
+   returns false.  Return the number of calls that returned true.  */
+size_t
+hamt_diff (const Hamt *old_hamt, const Hamt *new_hamt,
+           Hamt_diff_processor *proc, void *data)
+{
+  struct diff_context ctx;
+  ctx.functions = new_hamt->functions;
+  ctx.proc = proc;
+  ctx.data = data;
+  ctx.count = 0;
+  ctx.stop = false;
+  entry_diff (&ctx, old_hamt->root, new_hamt->root, 0);
+  return ctx.count;
+}
+
 /***********************/
 /* Destructive Updates */
 /***********************/
 
-/* If *ELT_PTR matches an element already in HAMT, set *ELT_PTR to the
-   element from the table and return false.  Otherwise, insert *ELT_PTR
-   destructively into the hamt and return true.  */
-bool
-hamt_insert_x (Hamt *hamt, Hamt_entry **elt_ptr)
+/* Insert *ELT_PTR destructively into HAMT, as hamt_insert_x does.  */
+static bool
+insert_x (Hamt *hamt, Hamt_entry **elt_ptr, bool transient)
 {
   Hamt_entry *elt = *elt_ptr;
   Hamt_entry *old_root = hamt->root;
-  hamt->root = root_insert (hamt->functions, old_root, elt_ptr, false, false);
+  hamt->root = root_insert (hamt->functions, old_root, elt_ptr, false, false,
+                            transient);
   if (old_root != hamt->root && old_root != NULL)
     free_entry (hamt->functions, old_root);
   if (*elt_ptr == NULL)
@@ -1056,18 +1377,35 @@ hamt_insert_x (Hamt *hamt, Hamt_entry **elt_ptr)
   return *elt_ptr == elt;
 }
 
-/* Insert ELT destructively into HAMT.  If an existing element was
-   replaced, return true.  Otherwise, return false.  */
-bool
-hamt_replace_x (Hamt *hamt, Hamt_entry *elt)
+/* Insert ELT destructively into HAMT, as hamt_replace_x does.  */
+static bool
+replace_x (Hamt *hamt, Hamt_entry *elt, bool transient)
 {
   Hamt_entry *old_root = hamt->root;
-  hamt->root = root_insert (hamt->functions, old_root, &elt, true, false);
+  hamt->root = root_insert (hamt->functions, old_root, &elt, true, false,
+                            transient);
   if (old_root != hamt->root && old_root != NULL)
     free_entry (hamt->functions, old_root);
   return elt != NULL;
 }
 
+/* If *ELT_PTR matches an element already in HAMT, set *ELT_PTR to the
+   element from the table and return false.  Otherwise, insert *ELT_PTR
+   destructively into the hamt and return true.  */
+bool
+hamt_insert_x (Hamt *hamt, Hamt_entry **elt_ptr)
+{
+  return insert_x (hamt, elt_ptr, false);
+}
+
+/* Insert ELT destructively into HAMT.  If an existing element was
+   replaced, return true.  Otherwise, return false.  */
+bool
+hamt_replace_x (Hamt *hamt, Hamt_entry *elt)
+{
+  return replace_x (hamt, elt, false);
+}
+
 /* If ELT matches an element already in HAMT, remove the element
    destructively from the hamt and return true.  Otherwise, return
    false.  */
@@ -1080,3 +1418,59 @@ hamt_remove_x (Hamt *hamt, Hamt_entry *elt)
     free_entry (hamt->functions, old_root);
   return elt != NULL;
 }
+
+/**************/
+/* Transients */
+/**************/
+
+/* Return a transient hamt with the same elements as HAMT.  */
+Hamt_transient *
+hamt_transient (Hamt *hamt)
+{
+  Hamt_transient *transient = XMALLOC (Hamt_transient);
+  transient->hamt.functions = copy_function_table (hamt->functions);
+  transient->hamt.root
+    = hamt->root == NULL ? NULL : copy_entry (hamt->root);
+  return transient;
+}
+
+/* Turn TRANSIENT into a hamt and return it.  */
+Hamt *
+hamt_persistent (Hamt_transient *transient)
+{
+  /* A transient hamt has the representation of a hamt.  */
+  return &transient->hamt;
+}
+
+/* If ELT matches an entry in TRANSIENT, return this entry.  Otherwise,
+   return NULL.  */
+Hamt_entry *
+hamt_transient_lookup (const Hamt_transient *transient, const void *elt)
+{
+  return hamt_lookup (&transient->hamt, elt);
+}
+
+/* If *ELT_PTR matches an element already in TRANSIENT, set *ELT_PTR to
+   the element from the table and return false.  Otherwise, insert
+   *ELT_PTR into TRANSIENT and return true.  */
+bool
+hamt_transient_insert (Hamt_transient *transient, Hamt_entry **elt_ptr)
+{
+  return insert_x (&transient->hamt, elt_ptr, true);
+}
+
+/* Insert ELT into TRANSIENT.  If an existing element was replaced,
+   return true.  Otherwise, return false.  */
+bool
+hamt_transient_replace (Hamt_transient *transient, Hamt_entry *elt)
+{
+  return replace_x (&transient->hamt, elt, true);
+}
+
+/* If ELT matches an element already in TRANSIENT, remove the element
+   from TRANSIENT and return true.  Otherwise, return false.  */
+bool
+hamt_transient_remove (Hamt_transient *transient, Hamt_entry *elt)
+{
+  return hamt_remove_x (&transient->hamt, elt);
+}
@@ -229,6 +229,18 @@ typedef bool (Hamt_processor) (Hamt_entry *elt, void *data);
 extern size_t hamt_do_while (const Hamt *hamt, Hamt_processor *proc,
                              void *data);
 
+/* Call PROC for every entry of the hamt until it returns false, like
+   hamt_do_while, but in up to THREAD_COUNT threads, which split the
+   nodes of the root of the hamt among themselves.  PROC may be called
+   from several threads at the same time.  When a call returns false,
+   the threads don't start any further calls, but calls in other
+   threads may already be in progress.  Return the number of calls that
+   returned true.  During processing, the hamt mustn't be modified.
+   Without C11 atomics, the entries are processed in the calling thread
+   only.  This function requires the module 'hamt-parallel'.  */
+extern size_t hamt_do_while_parallel (const Hamt *hamt, Hamt_processor *proc,
+                                      void *data, unsigned int thread_count);
+
 /* An alternative interface to iterating through the entry of a hamt
    that does not make use of a higher-order function like
    hamt_do_while uses the Hamt_iterator type, which can be allocated
@@ -264,6 +276,31 @@ extern Hamt_iterator hamt_iterator_copy (Hamt_iterator *iter);
 extern bool hamt_iterator_next (Hamt_iterator *iter,
                                 Hamt_entry **elt_ptr);
 
+/***************/
+/* Differences */
+/***************/
+
+/* A diff processor is called for each difference between two hamts.
+   If OLD_ELT and NEW_ELT are both non-NULL, the element OLD_ELT of the
+   old hamt has been replaced by the element NEW_ELT, which compares
+   equal to it.  If NEW_ELT is NULL, OLD_ELT is only in the old hamt.
+   If OLD_ELT is NULL, NEW_ELT is only in the new hamt.  It returns
+   true to continue.  */
+typedef bool (Hamt_diff_processor) (Hamt_entry *old_elt, Hamt_entry *new_elt,
+                                    void *data);
+
+/* Call PROC for every difference between OLD_HAMT and NEW_HAMT until it
+   returns false.  The third argument to the processor is the value of
+   DATA as received.  Return the number of calls that returned true.
+   The two hamts must have the same hash function and comparison
+   function.  The subtries that the hamts share, for example because
+   one was made from a copy of the other, are skipped, so that the time
+   taken is proportional to the number of differences rather than to
+   the number of elements.  During processing, the hamts mustn't be
+   modified.  */
+extern size_t hamt_diff (const Hamt *old_hamt, const Hamt *new_hamt,
+                         Hamt_diff_processor *proc, void *data);
+
 /***********************/
 /* Destructive Updates */
 /***********************/
@@ -282,6 +319,52 @@ extern bool hamt_replace_x (Hamt *hamt, Hamt_entry *elt);
    false.  */
 extern bool hamt_remove_x (Hamt *hamt, Hamt_entry *elt);
 
+/**************/
+/* Transients */
+/**************/
+
+/* A transient hamt is used to build or update a hamt through many
+   destructive updates.  It is created from a hamt, which it does not
+   affect, is updated in place by its owner, and is finally turned
+   into a hamt again.  Unlike a hamt updated through the destructive
+   updates above, it leaves room for further entries in the nodes it
+   allocates, so that it doesn't have to allocate new nodes for most
+   insertions.  A transient hamt must not be used by more than one
+   thread at the same time.  */
+typedef struct hamt_transient Hamt_transient;
+
+/* Return a transient hamt with the same elements as HAMT.  HAMT is not
+   affected by the updates of the transient hamt.  */
+_GL_ATTRIBUTE_NODISCARD
+extern Hamt_transient *hamt_transient (Hamt *hamt);
+
+/* Turn TRANSIENT into a hamt and return it.  TRANSIENT must not be
+   used afterwards.  */
+_GL_ATTRIBUTE_NODISCARD
+extern Hamt *hamt_persistent (Hamt_transient *transient)
+  _GL_ATTRIBUTE_DEALLOC (hamt_free, 1);
+
+/* If ELT matches an entry in TRANSIENT, return this entry.  Otherwise,
+   return NULL.  */
+extern Hamt_entry *hamt_transient_lookup (const Hamt_transient *transient,
+                                          const void *elt);
+
+/* If *ELT_PTR matches an element already in TRANSIENT, set *ELT_PTR to
+   the element from the table and return false.  Otherwise, insert
+   *ELT_PTR into TRANSIENT and return true.  */
+extern bool hamt_transient_insert (Hamt_transient *transient,
+                                   Hamt_entry **elt_ptr);
+
+/* Insert ELT into TRANSIENT.  If an existing element was replaced,
+   return true.  Otherwise, return false.  */
+extern bool hamt_transient_replace (Hamt_transient *transient,
+                                    Hamt_entry *elt);
+
+/* If ELT matches an element already in TRANSIENT, remove the element
+   from TRANSIENT and return true.  Otherwise, return false.  */
+extern bool hamt_transient_remove (Hamt_transient *transient,
+                                   Hamt_entry *elt);
+
 
 #ifdef __cplusplus
 }
@@ -26,6 +26,7 @@
 
 #include "hash.h"
 
+#include "alignalloc.h"
 #include "next-prime.h"
 #include "xalloc-oversized.h"
 
@@ -34,6 +35,13 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#if defined __SSE2__
+# include <emmintrin.h>
+#elif defined __ARM_NEON && defined __aarch64__
+# include <arm_neon.h>
+#endif
 
 #if USE_OBSTACK
 # include "obstack.h"
@@ -53,6 +61,26 @@ struct hash_entry
        and therefore NEXT is NULL as well.  */
   };
 
+/* When hash codes are cached, each overflow entry is allocated with room
+   for the hash code of its data.  */
+struct hash_entry_with_code
+  {
+    struct hash_entry entry;
+    size_t hash_code;
+  };
+
+/* With open addressing, the buckets come in groups of GROUP_SIZE, each
+   with a control byte.  On 64-bit platforms, a group fills a cache line of
+   64 bytes, so that a lookup usually reads a single cache line of the
+   table.  The last control byte is unused.  */
+enum { GROUP_SIZE = 7, GROUP_ALIGNMENT = 64 };
+
+struct hash_group
+  {
+    signed char ctrl[GROUP_SIZE + 1];
+    void *slot[GROUP_SIZE];
+  };
+
 struct hash_table
   {
     size_t n_buckets;
@@ -80,6 +108,17 @@ struct hash_table
     /* A linked list of freed struct hash_entry structs.  */
     struct hash_entry *free_entry_list;
 
+    /* With open addressing, the N_BUCKETS buckets are in the array of
+       groups GROUP, and BUCKET is NULL.  N_DELETED buckets hold a
+       tombstone.  With separate chaining, GROUP is NULL.  */
+    struct hash_group *group;
+    size_t n_deleted;
+
+    /* If hash codes are cached, HASH_CODE points to N_BUCKETS hash codes,
+       one for each bucket head or bucket, and overflow entries are struct
+       hash_entry_with_code.  Otherwise, HASH_CODE is NULL.  */
+    size_t *hash_code;
+
 #if USE_OBSTACK
     /* Whenever obstacks are used, it is possible to allocate all overflowed
        entries into a single stack, so they all can be freed in a single
@@ -138,9 +177,358 @@ static const Hash_tuning default_tuning =
     DEFAULT_SHRINK_FACTOR,
     DEFAULT_GROWTH_THRESHOLD,
     DEFAULT_GROWTH_FACTOR,
+    false,
+    false,
     false
   };
 
+/* Open addressing.
+
+   The control byte of a bucket is CTRL_EMPTY, CTRL_DELETED, or, if the
+   bucket holds an entry, the low 7 bits of the (mixed) hash code of the
+   entry.  The other bits of the hash code select the group where the
+   search for an entry starts; the search then visits the groups in
+   triangular order, which visits each group once since the number of
+   groups is a power of 2.  In each group, all the control bytes are
+   compared at once.
+
+   A search stops at the first group with an empty bucket.  This is valid
+   because an entry is placed beyond a group only when that group has no
+   empty bucket, and a bucket of a group without empty buckets becomes a
+   tombstone, not empty, when its entry is removed.  */
+
+#define CTRL_EMPTY ((signed char) -128)
+#define CTRL_DELETED ((signed char) -2)
+
+/* The control byte and the bucket of index I.  */
+#define OA_CTRL(table, i) \
+  ((table)->group[(i) / GROUP_SIZE].ctrl[(i) % GROUP_SIZE])
+#define OA_SLOT(table, i) \
+  ((table)->group[(i) / GROUP_SIZE].slot[(i) % GROUP_SIZE])
+
+/* Return a mask of the buckets of the group whose control bytes are at G
+   whose control byte equals C, or, for group_match_free, whose control
+   byte is CTRL_EMPTY or CTRL_DELETED.  Each bucket takes
+   1 << GROUP_MASK_SHIFT bits of the mask, of which only one may be set.  */
+#if defined __SSE2__
+
+# define GROUP_MASK_SHIFT 0
+
+static unsigned int
+group_match (signed char const *g, signed char c)
+{
+  __m128i v = _mm_loadl_epi64 ((__m128i const *) g);
+  return (_mm_movemask_epi8 (_mm_cmpeq_epi8 (v, _mm_set1_epi8 (c)))
+          & ((1u << GROUP_SIZE) - 1));
+}
+
+static unsigned int
+group_match_free (signed char const *g)
+{
+  __m128i v = _mm_loadl_epi64 ((__m128i const *) g);
+  return _mm_movemask_epi8 (v) & ((1u << GROUP_SIZE) - 1);
+}
+
+#elif defined __ARM_NEON && defined __aarch64__
+
+# define GROUP_MASK_SHIFT 3
+
+/* Reduce the 8 bytes of V, each 0 or 0xFF, to a mask.  */
+static uint64_t
+group_mask (uint8x8_t v)
+{
+  return vget_lane_u64 (vreinterpret_u64_u8 (v), 0) & 0x0080808080808080u;
+}
+
+static uint64_t
+group_match (signed char const *g, signed char c)
+{
+  return group_mask (vceq_s8 (vld1_s8 (g), vdup_n_s8 (c)));
+}
+
+static uint64_t
+group_match_free (signed char const *g)
+{
+  return group_mask (vcltz_s8 (vld1_s8 (g)));
+}
+
+#else
+
+# define GROUP_MASK_SHIFT 0
+
+static unsigned int
+group_match (signed char const *g, signed char c)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < GROUP_SIZE; i++)
+    mask |= (unsigned int) (g[i] == c) << i;
+  return mask;
+}
+
+static unsigned int
+group_match_free (signed char const *g)
+{
+  unsigned int mask = 0;
+  for (int i = 0; i < GROUP_SIZE; i++)
+    mask |= (unsigned int) (g[i] < 0) << i;
+  return mask;
+}
+
+#endif
+
+/* Return the index within its group of the first bucket of MASK.  */
+static int
+group_first (uint64_t mask)
+{
+  return stdc_trailing_zeros (mask) >> GROUP_MASK_SHIFT;
+}
+
+/* Return the full hash code of KEY, for open addressing or for caching.
+   If TABLE->hasher misbehaves, abort.  */
+static size_t
+full_hasher (const Hash_table *table, const void *key)
+{
+  size_t n = table->hasher (key, SIZE_MAX);
+  if (! (n < SIZE_MAX))
+    abort ();
+  return n;
+}
+
+/* Mix the bits of the full hash code N, as in the finalizer of MurmurHash3,
+   so that hashers whose results are only good modulo a prime still spread
+   the entries across groups and control bytes.  */
+static uint64_t
+oa_mix (size_t n)
+{
+  uint64_t h = n;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdu;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53u;
+  h ^= h >> 33;
+  return h;
+}
+
+/* Hash KEY for open addressing.  */
+static uint64_t
+oa_hash (const Hash_table *table, const void *key)
+{
+  return oa_mix (full_hasher (table, key));
+}
+
+/* Return the control byte of hash code H.  */
+static signed char
+oa_ctrl (uint64_t h)
+{
+  return h & 0x7f;
+}
+
+/* Return the number of groups of TABLE, a power of 2.  */
+static size_t
+oa_n_groups (const Hash_table *table)
+{
+  return table->n_buckets / GROUP_SIZE;
+}
+
+/* Return the first group of the probe sequence of hash code H.  */
+static size_t
+oa_first_group (const Hash_table *table, uint64_t h)
+{
+  return (h >> 7) & (oa_n_groups (table) - 1);
+}
+
+/* Return the group that follows group G, the STEP-th in its probe
+   sequence.  */
+static size_t
+oa_next_group (const Hash_table *table, size_t g, size_t step)
+{
+  return (g + step) & (oa_n_groups (table) - 1);
+}
+
+/* If ENTRY matches an entry in TABLE, whose hash code is H, return it and
+   set *SLOTP to its bucket.  Otherwise, return NULL.  */
+static void *
+oa_find (const Hash_table *table, const void *entry, uint64_t h,
+         size_t *slotp)
+{
+  signed char c = oa_ctrl (h);
+  size_t g = oa_first_group (table, h);
+
+  for (size_t step = 1; ; step++)
+    {
+      struct hash_group const *group = &table->group[g];
+      for (uint64_t m = group_match (group->ctrl, c); m; m &= m - 1)
+        {
+          int j = group_first (m);
+          void *data = group->slot[j];
+          if (entry == data || table->comparator (entry, data))
+            {
+              *slotp = g * GROUP_SIZE + j;
+              return data;
+            }
+        }
+      if (group_match (group->ctrl, CTRL_EMPTY))
+        return NULL;
+      g = oa_next_group (table, g, step);
+    }
+}
+
+/* Return the first free bucket in the probe sequence of hash code H.  */
+static size_t
+oa_find_free (const Hash_table *table, uint64_t h)
+{
+  size_t g = oa_first_group (table, h);
+
+  for (size_t step = 1; ; step++)
+    {
+      uint64_t m = group_match_free (table->group[g].ctrl);
+      if (m)
+        return g * GROUP_SIZE + group_first (m);
+      g = oa_next_group (table, g, step);
+    }
+}
+
+/* Return the bucket of ENTRY, which is in TABLE.  */
+static size_t
+oa_find_pointer (const Hash_table *table, const void *entry)
+{
+  uint64_t h = oa_hash (table, entry);
+  signed char c = oa_ctrl (h);
+  size_t g = oa_first_group (table, h);
+
+  for (size_t step = 1; ; step++)
+    {
+      struct hash_group const *group = &table->group[g];
+      for (uint64_t m = group_match (group->ctrl, c); m; m &= m - 1)
+        {
+          int j = group_first (m);
+          if (group->slot[j] == entry)
+            return g * GROUP_SIZE + j;
+        }
+      if (group_match (group->ctrl, CTRL_EMPTY))
+        abort ();
+      g = oa_next_group (table, g, step);
+    }
+}
+
+/* Compute the number of buckets of an open addressing table for the given
+   CANDIDATE and TUNING, such that N_ENTRIES entries stay below the growth
+   threshold, or return 0 if there is no possible way to allocate that
+   many buckets.  */
+static size_t _GL_ATTRIBUTE_PURE
+oa_compute_bucket_size (size_t candidate, size_t n_entries,
+                        const Hash_tuning *tuning)
+{
+  if (!tuning->is_n_buckets)
+    {
+      float new_candidate = candidate / tuning->growth_threshold;
+      if ((float) SIZE_MAX <= new_candidate)
+        goto nomem;
+      candidate = new_candidate;
+    }
+  size_t n_groups = candidate / GROUP_SIZE + (candidate % GROUP_SIZE != 0);
+  if (n_groups == 0)
+    n_groups = 1;
+  if (SIZE_MAX / 2 < n_groups)
+    goto nomem;
+  n_groups = stdc_bit_ceil (n_groups);
+  while (! (n_entries < tuning->growth_threshold * n_groups * GROUP_SIZE))
+    {
+      if (SIZE_MAX / 2 < n_groups)
+        goto nomem;
+      n_groups *= 2;
+    }
+  if (xalloc_oversized (n_groups, sizeof (struct hash_group))
+      || PTRDIFF_MAX < n_groups * sizeof (struct hash_group))
+    goto nomem;
+  return n_groups * GROUP_SIZE;
+
+ nomem:
+  errno = ENOMEM;
+  return 0;
+}
+
+/* Allocate the groups of an open addressing table of N_BUCKETS buckets,
+   and their hash codes if CACHE_HASH_CODES.  Return false (setting errno)
+   upon allocation failure, in which case TABLE is unchanged.  */
+static bool
+oa_allocate (Hash_table *table, size_t n_buckets, bool cache_hash_codes)
+{
+  size_t n_groups = n_buckets / GROUP_SIZE;
+  struct hash_group *group =
+    alignalloc (GROUP_ALIGNMENT, n_groups * sizeof *group);
+  if (group == NULL)
+    return false;
+  size_t *hash_code = NULL;
+  if (cache_hash_codes)
+    {
+      hash_code = malloc (n_buckets * sizeof *hash_code);
+      if (hash_code == NULL)
+        {
+          alignfree (group);
+          return false;
+        }
+    }
+  for (size_t g = 0; g < n_groups; g++)
+    memset (group[g].ctrl, CTRL_EMPTY, sizeof group[g].ctrl);
+  table->group = group;
+  table->hash_code = hash_code;
+  table->n_buckets = n_buckets;
+  table->n_deleted = 0;
+  return true;
+}
+
+/* Move the entries of TABLE into NEW_SIZE buckets, dropping the
+   tombstones.  Return false (setting errno) upon allocation failure, in
+   which case TABLE is unchanged.  */
+static bool
+oa_rehash (Hash_table *table, size_t new_size)
+{
+  struct hash_group *old_group = table->group;
+  size_t *old_hash_code = table->hash_code;
+  size_t old_n_groups = oa_n_groups (table);
+
+  if (!oa_allocate (table, new_size, old_hash_code != NULL))
+    return false;
+
+  for (size_t g = 0; g < old_n_groups; g++)
+    for (int j = 0; j < GROUP_SIZE; j++)
+      if (0 <= old_group[g].ctrl[j])
+        {
+          void *data = old_group[g].slot[j];
+          size_t n = (old_hash_code
+                      ? old_hash_code[g * GROUP_SIZE + j]
+                      : full_hasher (table, data));
+          uint64_t h = oa_mix (n);
+          size_t i = oa_find_free (table, h);
+          OA_CTRL (table, i) = oa_ctrl (h);
+          OA_SLOT (table, i) = data;
+          if (old_hash_code)
+            table->hash_code[i] = n;
+        }
+
+  alignfree (old_group);
+  free (old_hash_code);
+  return true;
+}
+
+/* Return the number of groups probed to find the entry in bucket I.  */
+static size_t
+oa_probe_length (const Hash_table *table, size_t i)
+{
+  uint64_t h = oa_hash (table, OA_SLOT (table, i));
+  size_t g = oa_first_group (table, h);
+  size_t length = 1;
+
+  for (size_t step = 1; g != i / GROUP_SIZE; step++)
+    {
+      g = oa_next_group (table, g, step);
+      length++;
+    }
+
+  return length;
+}
+
 /* Information and lookup.  */
 
 size_t
@@ -166,6 +554,18 @@ hash_get_max_bucket_length (const Hash_table *table)
 {
   size_t max_bucket_length = 0;
 
+  if (table->group)
+    {
+      for (size_t i = 0; i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i))
+          {
+            size_t bucket_length = oa_probe_length (table, i);
+            if (bucket_length > max_bucket_length)
+              max_bucket_length = bucket_length;
+          }
+      return max_bucket_length;
+    }
+
   for (struct hash_entry const *bucket = table->bucket;
        bucket < table->bucket_limit;
        bucket++)
@@ -192,6 +592,25 @@ hash_table_ok (const Hash_table *table)
   size_t n_buckets_used = 0;
   size_t n_entries = 0;
 
+  if (table->group)
+    {
+      size_t n_deleted = 0;
+      for (size_t i = 0; i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i))
+          {
+            n_entries++;
+            if (table->hash_code
+                && (table->hash_code[i]
+                    != full_hasher (table, OA_SLOT (table, i))))
+              return false;
+          }
+        else if (OA_CTRL (table, i) == CTRL_DELETED)
+          n_deleted++;
+      return (n_entries == table->n_entries
+              && n_entries == table->n_buckets_used
+              && n_deleted == table->n_deleted);
+    }
+
   for (struct hash_entry const *bucket = table->bucket;
        bucket < table->bucket_limit;
        bucket++)
@@ -203,10 +622,20 @@ hash_table_ok (const Hash_table *table)
           /* Count bucket head.  */
           n_buckets_used++;
           n_entries++;
+          if (table->hash_code
+              && (table->hash_code[bucket - table->bucket]
+                  != full_hasher (table, bucket->data)))
+            return false;
 
           /* Count bucket overflow.  */
           while (cursor = cursor->next, cursor)
-            n_entries++;
+            {
+              n_entries++;
+              if (table->hash_code
+                  && (((struct hash_entry_with_code const *) cursor)->hash_code
+                      != full_hasher (table, cursor->data)))
+                return false;
+            }
         }
     }
 
@@ -246,21 +675,163 @@ safe_hasher (const Hash_table *table, const void *key)
   return table->bucket + n;
 }
 
-void *
-hash_lookup (const Hash_table *table, const void *entry)
+/* Return the bucket of TABLE selected by the full hash code H.  */
+static struct hash_entry *
+cached_bucket (const Hash_table *table, size_t h)
 {
-  struct hash_entry const *bucket = safe_hasher (table, entry);
+  return table->bucket + h % table->n_buckets;
+}
 
+/* Return a pointer to the hash code of the data in ENTRY, which is BUCKET
+   itself or in the overflow of BUCKET, in a TABLE that caches hash
+   codes.  */
+static size_t *
+entry_hash_code (const Hash_table *table, struct hash_entry const *bucket,
+                 struct hash_entry *entry)
+{
+  return (entry == bucket
+          ? &table->hash_code[bucket - table->bucket]
+          : &((struct hash_entry_with_code *) entry)->hash_code);
+}
+
+/* Return the bucket of KEY in TABLE, and set *HASH_CODE to the full hash
+   code of KEY if TABLE caches hash codes.  */
+static struct hash_entry *
+find_bucket (const Hash_table *table, const void *key, size_t *hash_code)
+{
+  if (table->hash_code)
+    {
+      *hash_code = full_hasher (table, key);
+      return cached_bucket (table, *hash_code);
+    }
+  *hash_code = 0;
+  return safe_hasher (table, key);
+}
+
+/* Return true if ENTRY matches the data in CURSOR, which is BUCKET itself
+   or in the overflow of BUCKET, given the full hash code H of ENTRY if
+   TABLE caches hash codes.  */
+static bool
+entry_matches (const Hash_table *table, const void *entry, size_t h,
+               struct hash_entry const *bucket,
+               struct hash_entry const *cursor)
+{
+  return (entry == cursor->data
+          || ((!table->hash_code
+               || *entry_hash_code (table, bucket,
+                                    (struct hash_entry *) cursor) == h)
+              && table->comparator (entry, cursor->data)));
+}
+
+/* If ENTRY matches an entry in BUCKET, return it.  Otherwise, return
+   NULL.  H is the full hash code of ENTRY if TABLE caches hash codes.  */
+static void *
+bucket_lookup (const Hash_table *table, const void *entry, size_t h,
+               struct hash_entry const *bucket)
+{
   if (bucket->data == NULL)
     return NULL;
 
   for (struct hash_entry const *cursor = bucket; cursor; cursor = cursor->next)
-    if (entry == cursor->data || table->comparator (entry, cursor->data))
+    if (entry_matches (table, entry, h, bucket, cursor))
       return cursor->data;
 
   return NULL;
 }
 
+void *
+hash_lookup (const Hash_table *table, const void *entry)
+{
+  if (table->group)
+    {
+      size_t i;
+      return oa_find (table, entry, oa_hash (table, entry), &i);
+    }
+
+  size_t h;
+  struct hash_entry const *bucket = find_bucket (table, entry, &h);
+  return bucket_lookup (table, entry, h, bucket);
+}
+
+/* The number of lookups that hash_lookup_many has in flight.  */
+enum { LOOKUP_WINDOW = 16 };
+
+/* Prefetch the memory at P, which is about to be read.  */
+#if _GL_GNUC_PREREQ (3, 1)
+# define prefetch(p) __builtin_prefetch (p)
+#else
+# define prefetch(p) ((void) (p))
+#endif
+
+size_t
+hash_lookup_many (const Hash_table *table, void const *const *entries,
+                  size_t n, void **results)
+{
+  size_t n_found = 0;
+
+  /* Each lookup in a large table typically misses the cache twice: on the
+     bucket, then on the user entry that the comparator reads.  So, for a
+     window of entries, compute all the hash codes and prefetch all the
+     buckets, then prefetch all the user entries, and only then do the
+     lookups.  */
+  for (size_t i = 0; i < n; i += LOOKUP_WINDOW)
+    {
+      size_t window = n - i < LOOKUP_WINDOW ? n - i : LOOKUP_WINDOW;
+      void const *const *e = entries + i;
+
+      if (table->group)
+        {
+          uint64_t h[LOOKUP_WINDOW];
+
+          for (size_t k = 0; k < window; k++)
+            {
+              h[k] = oa_hash (table, e[k]);
+              prefetch (&table->group[oa_first_group (table, h[k])]);
+            }
+
+          for (size_t k = 0; k < window; k++)
+            {
+              struct hash_group const *group =
+                &table->group[oa_first_group (table, h[k])];
+              uint64_t m = group_match (group->ctrl, oa_ctrl (h[k]));
+              if (m)
+                prefetch (group->slot[group_first (m)]);
+            }
+
+          for (size_t k = 0; k < window; k++)
+            {
+              size_t slot;
+              results[i + k] = oa_find (table, e[k], h[k], &slot);
+            }
+        }
+      else
+        {
+          struct hash_entry const *bucket[LOOKUP_WINDOW];
+          size_t h[LOOKUP_WINDOW];
+
+          for (size_t k = 0; k < window; k++)
+            {
+              bucket[k] = find_bucket (table, e[k], &h[k]);
+              prefetch (bucket[k]);
+              if (table->hash_code)
+                prefetch (&table->hash_code[bucket[k] - table->bucket]);
+            }
+
+          for (size_t k = 0; k < window; k++)
+            if (bucket[k]->data)
+              prefetch (bucket[k]->data);
+
+          for (size_t k = 0; k < window; k++)
+            results[i + k] = bucket_lookup (table, e[k], h[k], bucket[k]);
+        }
+
+      for (size_t k = 0; k < window; k++)
+        n_found += results[i + k] != NULL;
+    }
+
+  return n_found;
+}
+
 /* Walking.  */
 
 void *
@@ -269,6 +840,15 @@ hash_get_first (const Hash_table *table)
   if (table->n_entries == 0)
     return NULL;
 
+  if (table->group)
+    {
+      for (size_t i = 0; ; i++)
+        if (! (i < table->n_buckets))
+          abort ();
+        else if (0 <= OA_CTRL (table, i))
+          return OA_SLOT (table, i);
+    }
+
   for (struct hash_entry const *bucket = table->bucket; ; bucket++)
     if (! (bucket < table->bucket_limit))
       abort ();
@@ -279,7 +859,17 @@ hash_get_first (const Hash_table *table)
 void *
 hash_get_next (const Hash_table *table, const void *entry)
 {
-  struct hash_entry const *bucket = safe_hasher (table, entry);
+  if (table->group)
+    {
+      for (size_t i = oa_find_pointer (table, entry) + 1;
+           i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i))
+          return OA_SLOT (table, i);
+      return NULL;
+    }
+
+  size_t h;
+  struct hash_entry const *bucket = find_bucket (table, entry, &h);
 
   /* Find next entry in the same bucket.  */
   {
@@ -308,6 +898,18 @@ hash_get_entries (const Hash_table *table, void **buffer,
 {
   size_t counter = 0;
 
+  if (table->group)
+    {
+      for (size_t i = 0; i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i))
+          {
+            if (counter >= buffer_size)
+              break;
+            buffer[counter++] = OA_SLOT (table, i);
+          }
+      return counter;
+    }
+
   for (struct hash_entry const *bucket = table->bucket;
        bucket < table->bucket_limit;
        bucket++)
@@ -332,6 +934,18 @@ hash_do_for_each (const Hash_table *table, Hash_processor processor,
 {
   size_t counter = 0;
 
+  if (table->group)
+    {
+      for (size_t i = 0; i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i))
+          {
+            if (! processor (OA_SLOT (table, i), processor_data))
+              break;
+            counter++;
+          }
+      return counter;
+    }
+
   for (struct hash_entry const *bucket = table->bucket;
        bucket < table->bucket_limit;
        bucket++)
@@ -465,14 +1079,39 @@ hash_initialize (size_t candidate, const Hash_tuning *tuning,
       goto fail;
     }
 
-  table->n_buckets = compute_bucket_size (candidate, tuning);
-  if (!table->n_buckets)
-    goto fail;
-
-  table->bucket = calloc (table->n_buckets, sizeof *table->bucket);
-  if (table->bucket == NULL)
-    goto fail;
-  table->bucket_limit = table->bucket + table->n_buckets;
+  if (tuning->is_open_addressing)
+    {
+      size_t n_buckets = oa_compute_bucket_size (candidate, 0, tuning);
+      if (!n_buckets
+          || !oa_allocate (table, n_buckets, tuning->is_hash_cached))
+        goto fail;
+      table->bucket = NULL;
+      table->bucket_limit = NULL;
+    }
+  else
+    {
+      table->n_buckets = compute_bucket_size (candidate, tuning);
+      if (!table->n_buckets)
+        goto fail;
+
+      table->bucket = calloc (table->n_buckets, sizeof *table->bucket);
+      if (table->bucket == NULL)
+        goto fail;
+      table->hash_code = NULL;
+      if (tuning->is_hash_cached)
+        {
+          table->hash_code = malloc (table->n_buckets
+                                     * sizeof *table->hash_code);
+          if (table->hash_code == NULL)
+            {
+              free (table->bucket);
+              goto fail;
+            }
+        }
+      table->bucket_limit = table->bucket + table->n_buckets;
+      table->group = NULL;
+      table->n_deleted = 0;
+    }
   table->n_buckets_used = 0;
   table->n_entries = 0;
 
@@ -494,6 +1133,17 @@ hash_initialize (size_t candidate, const Hash_tuning *tuning,
 void
 hash_clear (Hash_table *table)
 {
+  if (table->group)
+    {
+      for (size_t i = 0; i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i) && table->data_freer)
+          table->data_freer (OA_SLOT (table, i));
+      for (size_t g = 0; g < oa_n_groups (table); g++)
+        memset (table->group[g].ctrl, CTRL_EMPTY,
+                sizeof table->group[g].ctrl);
+      table->n_deleted = 0;
+    }
+
   for (struct hash_entry *bucket = table->bucket;
        bucket < table->bucket_limit;
        bucket++)
@@ -536,6 +1186,11 @@ hash_free (Hash_table *table)
   /* Call the user data_freer function.  */
   if (table->data_freer && table->n_entries)
     {
+      if (table->group)
+        for (size_t i = 0; i < table->n_buckets; i++)
+          if (0 <= OA_CTRL (table, i))
+            table->data_freer (OA_SLOT (table, i));
+
       for (struct hash_entry *bucket = table->bucket;
            bucket < table->bucket_limit;
            bucket++)
@@ -578,6 +1233,8 @@ hash_free (Hash_table *table)
 #endif
 
   /* Free the remainder of the hash table structure.  */
+  alignfree (table->group);
+  free (table->hash_code);
   free (table->bucket);
   free (table);
 
@@ -601,10 +1258,13 @@ allocate_entry (Hash_table *table)
     }
   else
     {
+      size_t size = (table->hash_code
+                     ? sizeof (struct hash_entry_with_code)
+                     : sizeof *new);
 #if USE_OBSTACK
-      new = obstack_alloc (&table->entry_stack, sizeof *new);
+      new = obstack_alloc (&table->entry_stack, size);
 #else
-      new = malloc (sizeof *new);
+      new = malloc (size);
 #endif
     }
 
@@ -625,23 +1285,26 @@ free_entry (Hash_table *table, struct hash_entry *entry)
 /* This private function is used to help with insertion and deletion.  When
    ENTRY matches an entry in the table, return a pointer to the corresponding
    user data and set *BUCKET_HEAD to the head of the selected bucket.
-   Otherwise, return NULL.  When DELETE is true and ENTRY matches an entry in
-   the table, unlink the matching entry.  */
+   Otherwise, return NULL.  In both cases, set *HASH_CODE to the full hash
+   code of ENTRY if TABLE caches hash codes.  When DELETE is true and ENTRY
+   matches an entry in the table, unlink the matching entry.  */
 
 static void *
 find_entry (Hash_table *table, const void *entry,
-            struct hash_entry **bucket_head, bool delete)
+            struct hash_entry **bucket_head, size_t *hash_code, bool delete)
 {
-  struct hash_entry *bucket = safe_hasher (table, entry);
+  size_t h;
+  struct hash_entry *bucket = find_bucket (table, entry, &h);
 
   *bucket_head = bucket;
+  *hash_code = h;
 
   /* Test for empty bucket.  */
   if (bucket->data == NULL)
     return NULL;
 
   /* See if the entry is the first in the bucket.  */
-  if (entry == bucket->data || table->comparator (entry, bucket->data))
+  if (entry_matches (table, entry, h, bucket, bucket))
     {
       void *data = bucket->data;
 
@@ -654,6 +1317,9 @@ find_entry (Hash_table *table, const void *entry,
               /* Bump the first overflow entry into the bucket head, then save
                  the previous first overflow entry for later recycling.  */
               *bucket = *next;
+              if (table->hash_code)
+                *entry_hash_code (table, bucket, bucket)
+                  = *entry_hash_code (table, bucket, next);
               free_entry (table, next);
             }
           else
@@ -668,8 +1334,7 @@ find_entry (Hash_table *table, const void *entry,
   /* Scan the bucket overflow.  */
   for (struct hash_entry *cursor = bucket; cursor->next; cursor = cursor->next)
     {
-      if (entry == cursor->next->data
-          || table->comparator (entry, cursor->next->data))
+      if (entry_matches (table, entry, h, bucket, cursor->next))
         {
           void *data = cursor->next->data;
 
@@ -705,6 +1370,7 @@ transfer_entries (Hash_table *dst, Hash_table *src, bool safe)
       {
         void *data;
         struct hash_entry *new_bucket;
+        size_t h = 0;
 
         /* Within each bucket, transfer overflow entries first and
            then the bucket head, to minimize memory pressure.  After
@@ -715,7 +1381,15 @@ transfer_entries (Hash_table *dst, Hash_table *src, bool safe)
         for (struct hash_entry *cursor = bucket->next; cursor; )
           {
             data = cursor->data;
-            new_bucket = safe_hasher (dst, data);
+            if (src->hash_code)
+              {
+                /* The hash code moves along with the entry, without
+                   calling the hasher.  */
+                h = *entry_hash_code (src, bucket, cursor);
+                new_bucket = cached_bucket (dst, h);
+              }
+            else
+              new_bucket = safe_hasher (dst, data);
 
             struct hash_entry *next = cursor->next;
 
@@ -731,6 +1405,8 @@ transfer_entries (Hash_table *dst, Hash_table *src, bool safe)
                 /* Free an existing entry, when moving from a bucket
                    overflow into a bucket header.  */
                 new_bucket->data = data;
+                if (dst->hash_code)
+                  *entry_hash_code (dst, new_bucket, new_bucket) = h;
                 dst->n_buckets_used++;
                 free_entry (dst, cursor);
               }
@@ -744,7 +1420,13 @@ transfer_entries (Hash_table *dst, Hash_table *src, bool safe)
         bucket->next = NULL;
         if (!safe)
           {
-            new_bucket = safe_hasher (dst, data);
+            if (src->hash_code)
+              {
+                h = *entry_hash_code (src, bucket, bucket);
+                new_bucket = cached_bucket (dst, h);
+              }
+            else
+              new_bucket = safe_hasher (dst, data);
 
             if (new_bucket->data)
               {
@@ -758,11 +1440,15 @@ transfer_entries (Hash_table *dst, Hash_table *src, bool safe)
                 new_entry->data = data;
                 new_entry->next = new_bucket->next;
                 new_bucket->next = new_entry;
+                if (dst->hash_code)
+                  *entry_hash_code (dst, new_bucket, new_entry) = h;
               }
             else
               {
                 /* Move from one bucket header to another.  */
                 new_bucket->data = data;
+                if (dst->hash_code)
+                  *entry_hash_code (dst, new_bucket, new_bucket) = h;
                 dst->n_buckets_used++;
               }
             bucket->data = NULL;
@@ -775,6 +1461,17 @@ transfer_entries (Hash_table *dst, Hash_table *src, bool safe)
 bool
 hash_rehash (Hash_table *table, size_t candidate)
 {
+  if (table->group)
+    {
+      size_t new_size = oa_compute_bucket_size (candidate, table->n_entries,
+                                                table->tuning);
+      if (!new_size)
+        return false;
+      if (new_size == table->n_buckets && table->n_deleted == 0)
+        return true;
+      return oa_rehash (table, new_size);
+    }
+
   size_t new_size = compute_bucket_size (candidate, table->tuning);
 
   if (!new_size)
@@ -787,6 +1484,17 @@ hash_rehash (Hash_table *table, size_t candidate)
   new_table->bucket = calloc (new_size, sizeof *new_table->bucket);
   if (new_table->bucket == NULL)
     return false;
+  new_table->hash_code = NULL;
+  if (table->hash_code)
+    {
+      new_table->hash_code = malloc (new_size * sizeof *new_table->hash_code);
+      if (new_table->hash_code == NULL)
+        {
+          free (new_table->bucket);
+          return false;
+        }
+    }
+  new_table->group = NULL;
   new_table->n_buckets = new_size;
   new_table->bucket_limit = new_table->bucket + new_size;
   new_table->n_buckets_used = 0;
@@ -820,7 +1528,9 @@ hash_rehash (Hash_table *table, size_t candidate)
     {
       /* Entries transferred successfully; tie up the loose ends.  */
       free (table->bucket);
+      free (table->hash_code);
       table->bucket = new_table->bucket;
+      table->hash_code = new_table->hash_code;
       table->bucket_limit = new_table->bucket_limit;
       table->n_buckets = new_table->n_buckets;
       table->n_buckets_used = new_table->n_buckets_used;
@@ -849,10 +1559,125 @@ hash_rehash (Hash_table *table, size_t candidate)
     abort ();
   /* table->n_entries already holds its value.  */
   free (new_table->bucket);
+  free (new_table->hash_code);
   errno = saved_errno;
   return false;
 }
 
+/* Open addressing variants of hash_insert_if_absent and hash_remove.  */
+
+static int
+oa_insert_if_absent (Hash_table *table, void const *entry,
+                     void const **matched_ent)
+{
+  size_t n = full_hasher (table, entry);
+  uint64_t h = oa_mix (n);
+  size_t i;
+  void *data = oa_find (table, entry, h, &i);
+  if (data != NULL)
+    {
+      if (matched_ent)
+        *matched_ent = data;
+      return 0;
+    }
+
+  /* Tombstones lengthen the searches just like entries do, so count both
+     against the growth threshold.  If the table is mostly tombstones,
+     rehash it to the same size to drop them; otherwise grow it.  */
+  if (table->n_entries + table->n_deleted + 1
+      > table->tuning->growth_threshold * table->n_buckets)
+    {
+      check_tuning (table);
+      const Hash_tuning *tuning = table->tuning;
+      if (table->n_entries + table->n_deleted + 1
+          > tuning->growth_threshold * table->n_buckets)
+        {
+          size_t new_size;
+          if (table->n_entries + 1
+              <= tuning->growth_threshold * table->n_buckets / 2)
+            new_size = table->n_buckets;
+          else
+            {
+              float candidate =
+                (tuning->is_n_buckets
+                 ? (table->n_buckets * tuning->growth_factor)
+                 : (table->n_buckets * tuning->growth_factor
+                    * tuning->growth_threshold));
+
+              if ((float) SIZE_MAX <= candidate)
+                {
+                  errno = ENOMEM;
+                  return -1;
+                }
+              new_size = oa_compute_bucket_size (candidate,
+                                                 table->n_entries + 1,
+                                                 tuning);
+              if (!new_size)
+                return -1;
+            }
+
+          if (!oa_rehash (table, new_size))
+            return -1;
+        }
+    }
+
+  i = oa_find_free (table, h);
+  if (OA_CTRL (table, i) == CTRL_DELETED)
+    table->n_deleted--;
+  OA_CTRL (table, i) = oa_ctrl (h);
+  OA_SLOT (table, i) = (void *) entry;
+  if (table->hash_code)
+    table->hash_code[i] = n;
+  table->n_entries++;
+  table->n_buckets_used++;
+  return 1;
+}
+
+static void *
+oa_remove (Hash_table *table, const void *entry)
+{
+  size_t i;
+  void *data = oa_find (table, entry, oa_hash (table, entry), &i);
+  if (!data)
+    return NULL;
+
+  /* A search stops at a group with an empty bucket; so, if the group of
+     bucket I has none, a search for another entry may have to continue
+     past it, and the bucket must become a tombstone.  */
+  if (group_match (table->group[i / GROUP_SIZE].ctrl, CTRL_EMPTY))
+    OA_CTRL (table, i) = CTRL_EMPTY;
+  else
+    {
+      OA_CTRL (table, i) = CTRL_DELETED;
+      table->n_deleted++;
+    }
+  table->n_entries--;
+  table->n_buckets_used--;
+
+  /* If the shrink threshold has been reached, rehash into a smaller
+     table.  Failure to do so is not fatal.  */
+  if (table->n_entries < table->tuning->shrink_threshold * table->n_buckets)
+    {
+      check_tuning (table);
+      const Hash_tuning *tuning = table->tuning;
+      if (table->n_entries < tuning->shrink_threshold * table->n_buckets)
+        {
+          size_t candidate =
+            (tuning->is_n_buckets
+             ? table->n_buckets * tuning->shrink_factor
+             : (table->n_buckets * tuning->shrink_factor
+                * tuning->growth_threshold));
+          if (!hash_rehash (table, candidate))
+            {
+              /* Failure to allocate memory in an attempt to shrink the
+                 table is not fatal.  */
+            }
+        }
+    }
+
+  return data;
+}
+
 int
 hash_insert_if_absent (Hash_table *table, void const *entry,
                        void const **matched_ent)
@@ -864,9 +1689,13 @@ hash_insert_if_absent (Hash_table *table, void const *entry,
   if (! entry)
     abort ();
 
+  if (table->group)
+    return oa_insert_if_absent (table, entry, matched_ent);
+
   /* If there's a matching entry already in the table, return that.  */
   struct hash_entry *bucket;
-  void *data = find_entry (table, entry, &bucket, false);
+  size_t h;
+  void *data = find_entry (table, entry, &bucket, &h, false);
   if (data != NULL)
     {
       if (matched_ent)
@@ -906,7 +1735,7 @@ hash_insert_if_absent (Hash_table *table, void const *entry,
             return -1;
 
           /* Update the bucket we are interested in.  */
-          if (find_entry (table, entry, &bucket, false) != NULL)
+          if (find_entry (table, entry, &bucket, &h, false) != NULL)
             abort ();
         }
     }
@@ -925,6 +1754,8 @@ hash_insert_if_absent (Hash_table *table, void const *entry,
       new_entry->data = (void *) entry;
       new_entry->next = bucket->next;
       bucket->next = new_entry;
+      if (table->hash_code)
+        *entry_hash_code (table, bucket, new_entry) = h;
       table->n_entries++;
       return 1;
     }
@@ -932,6 +1763,8 @@ hash_insert_if_absent (Hash_table *table, void const *entry,
   /* Add ENTRY right in the bucket head.  */
 
   bucket->data = (void *) entry;
+  if (table->hash_code)
+    *entry_hash_code (table, bucket, bucket) = h;
   table->n_entries++;
   table->n_buckets_used++;
 
@@ -951,8 +1784,12 @@ hash_insert (Hash_table *table, void const *entry)
 void *
 hash_remove (Hash_table *table, const void *entry)
 {
+  if (table->group)
+    return oa_remove (table, entry);
+
   struct hash_entry *bucket;
-  void *data = find_entry (table, entry, &bucket, true);
+  size_t h;
+  void *data = find_entry (table, entry, &bucket, &h, true);
   if (!data)
     return NULL;
 
@@ -1013,6 +1850,17 @@ hash_remove (Hash_table *table, const void *entry)
 void
 hash_print (const Hash_table *table)
 {
+  if (table->group)
+    {
+      for (size_t i = 0; i < table->n_buckets; i++)
+        if (0 <= OA_CTRL (table, i))
+          {
+            char const *s = OA_SLOT (table, i);
+            printf ("%lu:\n  %s\n", (unsigned long int) {i}, s);
+          }
+      return;
+    }
+
   for (struct hash_entry *bucket = (struct hash_entry *) table->bucket;
        bucket < table->bucket_limit;
        bucket++)
@@ -47,6 +47,8 @@ struct hash_tuning
     float growth_threshold;     /* ratio of used buckets to trigger a growth */
     float growth_factor;        /* ratio of new bigger size to original size */
     bool is_n_buckets;          /* if CANDIDATE really means table size */
+    bool is_open_addressing;    /* if the table uses open addressing */
+    bool is_hash_cached;        /* if the table keeps the hash codes */
   };
 
 typedef struct hash_tuning Hash_tuning;
@@ -92,6 +94,14 @@ extern void hash_print_statistics (const Hash_table *table, FILE *stream);
    entry from the table.  Otherwise, return NULL.  */
 extern void *hash_lookup (const Hash_table *table, const void *entry);
 
+/* For each of the N entries at ENTRIES, set RESULTS[I] to
+   hash_lookup (TABLE, ENTRIES[I]), and return the number of entries found.
+   This is faster than N calls to hash_lookup on large tables, as the
+   lookups are done in batches whose memory accesses overlap.  */
+extern size_t hash_lookup_many (const Hash_table *table,
+                                void const *const *entries, size_t n,
+                                void **results);
+
 /*
  * Walking.
  */
@@ -176,6 +186,24 @@ extern void hash_free (Hash_table *table);
    provided but the values requested are out of bounds or might cause
    rounding errors, return NULL.
 
+   If the IS_OPEN_ADDRESSING field of TUNING is true, the table stores the
+   user entries in the bucket array itself, in groups of 7 buckets with a
+   control byte per bucket that holds 7 bits of the hash code, instead of
+   chaining colliding entries in separately allocated nodes.  A group fills
+   a cache line, so that a lookup usually touches a single cache line of
+   the table.  The table size is 7 times a power of 2; the HASHER is
+   called with a TABLE_SIZE of SIZE_MAX, and its result is mixed, so that
+   all its bits matter.  The number of buckets used is the number of
+   entries, and the length of a bucket is the number of groups probed to
+   find an entry.
+
+   If the IS_HASH_CACHED field of TUNING is true, the table keeps the hash
+   code of each entry next to it, so that growing or shrinking the table
+   does not call the HASHER again, and so that a lookup calls the
+   COMPARATOR only on entries with the same hash code.  The HASHER is
+   then called with a TABLE_SIZE of SIZE_MAX, and the table reduces its
+   result modulo the table size.  This costs a word of memory per entry.
+
    The user-supplied HASHER function, when not NULL, accepts two
    arguments ENTRY and TABLE_SIZE.  It computes, by hashing ENTRY contents, a
    slot number for that entry which should be in the range 0..TABLE_SIZE-1.
@@ -0,0 +1,215 @@
+/* hashcode-seeded.c -- compute a seeded hash value from a buffer.
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "hashcode-seeded.h"
+
+#include <string.h>
+#include <sys/random.h>
+#include <time.h>
+
+#include "glthread/once.h"
+
+/* The hash function is wyhash by Wang Yi, version 4.2, which is in the
+   public domain.  See https://github.com/wangyi-fudan/wyhash.
+   Each step multiplies two 64-bit words that depend on 16 bytes of
+   input into a 128-bit product and folds the product to 64 bits.  */
+
+/* The default secret of wyhash.  */
+static const uint64_t secret[4] =
+  {
+    0x2d358dccaa6c78a5, 0x8bb84b93962eacc9,
+    0x4b33a62ed433d4a3, 0x4d5a2da51de1aa47
+  };
+
+/* Set *A and *B to the low and high halves of the product of *A and
+   *B.  */
+static inline void
+multiply (uint64_t *a, uint64_t *b)
+{
+#if defined __SIZEOF_INT128__
+  unsigned __int128 r = (unsigned __int128) *a * *b;
+  *a = r;
+  *b = r >> 64;
+#else
+  uint64_t ha = *a >> 32, hb = *b >> 32;
+  uint64_t la = (uint32_t) *a, lb = (uint32_t) *b;
+  uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  uint64_t t = rl + (rm0 << 32);
+  uint64_t carry = t < rl;
+  uint64_t lo = t + (rm1 << 32);
+  carry += lo < t;
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+/* Return the xor of the low and high halves of the product of A and B.  */
+static inline uint64_t
+mix (uint64_t a, uint64_t b)
+{
+  multiply (&a, &b);
+  return a ^ b;
+}
+
+/* Return the 8 bytes at P as a number.  */
+static inline uint64_t
+read64 (unsigned char const *p)
+{
+  uint64_t v;
+  memcpy (&v, p, sizeof v);
+  return v;
+}
+
+/* Return the 4 bytes at P as a number.  */
+static inline uint64_t
+read32 (unsigned char const *p)
+{
+  uint32_t v;
+  memcpy (&v, p, sizeof v);
+  return v;
+}
+
+/* Return the first, middle and last of the K bytes at P, 0 < K < 4, as a
+   number.  */
+static inline uint64_t
+read_small (unsigned char const *p, size_t k)
+{
+  return ((uint64_t) p[0] << 16) | ((uint64_t) p[k >> 1] << 8) | p[k - 1];
+}
+
+uint64_t
+hash_mem_seeded (void const *x, size_t n, uint64_t seed)
+{
+  unsigned char const *p = x;
+  uint64_t a;
+  uint64_t b;
+
+  seed ^= mix (seed ^ secret[0], secret[1]);
+  if (n <= 16)
+    {
+      if (n >= 4)
+        {
+          size_t d = (n >> 3) << 2;
+          a = (read32 (p) << 32) | read32 (p + d);
+          b = (read32 (p + n - 4) << 32) | read32 (p + n - 4 - d);
+        }
+      else if (n > 0)
+        {
+          a = read_small (p, n);
+          b = 0;
+        }
+      else
+        a = b = 0;
+    }
+  else
+    {
+      size_t i = n;
+      if (i > 48)
+        {
+          /* Three independent lanes, so that the multiplications can
+             overlap.  */
+          uint64_t seed1 = seed;
+          uint64_t seed2 = seed;
+          do
+            {
+              seed = mix (read64 (p) ^ secret[1], read64 (p + 8) ^ seed);
+              seed1 = mix (read64 (p + 16) ^ secret[2],
+                           read64 (p + 24) ^ seed1);
+              seed2 = mix (read64 (p + 32) ^ secret[3],
+                           read64 (p + 40) ^ seed2);
+              p += 48;
+              i -= 48;
+            }
+          while (i > 48);
+          seed ^= seed1 ^ seed2;
+        }
+      while (i > 16)
+        {
+          seed = mix (read64 (p) ^ secret[1], read64 (p + 8) ^ seed);
+          p += 16;
+          i -= 16;
+        }
+      /* The last 16 bytes, which may overlap the bytes already read.  */
+      a = read64 (p + i - 16);
+      b = read64 (p + i - 8);
+    }
+
+  a ^= secret[1];
+  b ^= seed;
+  multiply (&a, &b);
+  return mix (a ^ secret[0] ^ n, b ^ secret[1]);
+}
+
+/* The seed of the current process.  */
+static uint64_t process_seed;
+
+/* Initialize process_seed.  */
+static void
+init_process_seed (void)
+{
+  uint64_t seed;
+
+  /* Without GRND_NONBLOCK it can be blocked for minutes on some systems.  */
+  if (getrandom (&seed, sizeof seed, GRND_NONBLOCK) != sizeof seed)
+    {
+      /* Fall back to the clock and to the address of the stack.  Hash
+         tables don't need high-quality randomness; they only need an
+         attacker to not know the seed in advance.  */
+      seed = hash_mem_seeded (&(time_t) {time (NULL)}, sizeof (time_t),
+                              clock ());
+      seed = hash_mem_seeded (&(uintptr_t) {(uintptr_t) &seed},
+                              sizeof (uintptr_t), seed);
+    }
+  process_seed = seed;
+}
+
+/* Ensure that init_process_seed is called once only.  */
+gl_once_define(static, process_seed_once)
+
+uint64_t
+hash_seed (void)
+{
+  gl_once (process_seed_once, init_process_seed);
+  return process_seed;
+}
+
+uint64_t
+hash_mem64 (void const *x, size_t n)
+{
+  return hash_mem_seeded (x, n, hash_seed ());
+}
+
+uint64_t
+hash_string64 (char const *s)
+{
+  return hash_mem64 (s, strlen (s));
+}
+
+size_t
+hash_string_hasher (void const *x, size_t tablesize)
+{
+  return hash_string64 (x) % tablesize;
+}
+
+size_t
+hash_string_hashcode (void const *x)
+{
+  return hash_string64 (x);
+}
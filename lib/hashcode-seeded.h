@@ -0,0 +1,65 @@
+/* hashcode-seeded.h -- declarations for a fast, seeded hash function
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* This file uses _GL_ATTRIBUTE_PURE.  */
+#if !_GL_CONFIG_H_INCLUDED
+ #error "Please include config.h first."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* Compute a 64-bit hash code for a buffer starting at X and of size N,
+   with the seed SEED, and return the hash code.
+   The function reads 8 bytes at a time.  Unlike hash_pjw_bare(), it is
+   hard to find many buffers with the same hash code without knowing the
+   seed.
+   The result is platform dependent: it depends on the endianness.  */
+extern uint64_t hash_mem_seeded (void const *x, size_t n, uint64_t seed)
+  _GL_ATTRIBUTE_PURE;
+
+/* Return the seed of the current process.  It is chosen at random when
+   this function is first called, and doesn't change afterwards.  */
+extern uint64_t hash_seed (void);
+
+/* Compute a 64-bit hash code for a buffer starting at X and of size N,
+   with the seed of the current process, and return the hash code.  */
+extern uint64_t hash_mem64 (void const *x, size_t n);
+
+/* Compute a 64-bit hash code for a NUL-terminated string S, with the seed
+   of the current process, and return the hash code.  */
+extern uint64_t hash_string64 (char const *s);
+
+/* Compute a hash code for a NUL-terminated string starting at X, with the
+   seed of the current process, and return the hash code modulo TABLESIZE.
+   This function can be used as a Hash_hasher for the 'hash' module.  */
+extern size_t hash_string_hasher (void const *x, size_t tablesize);
+
+/* Compute a hash code for a NUL-terminated string starting at X, with the
+   seed of the current process, and return the hash code.
+   This function can be used as a gl_setelement_hashcode_fn or
+   gl_mapkey_hashcode_fn for the gl_set and gl_map containers.  */
+extern size_t hash_string_hashcode (void const *x);
+
+
+#ifdef __cplusplus
+}
+#endif
@@ -37,27 +37,27 @@
 #define GL_HMAC_FN_BLOC _GLHMAC_CONCAT (HMAC_ALG, _process_block)
 #define GL_HMAC_FN_PROC _GLHMAC_CONCAT (HMAC_ALG, _process_bytes)
 #define GL_HMAC_FN_FINI _GLHMAC_CONCAT (HMAC_ALG, _finish_ctx)
+#define GL_HMAC_KEYED_CTX _GLHMAC_CONCAT (GL_HMAC_FN, _ctx)
+#define GL_HMAC_KEYED_INIT _GLHMAC_CONCAT (GL_HMAC_FN, _init_ctx)
+#define GL_HMAC_KEYED_PROC _GLHMAC_CONCAT (GL_HMAC_FN, _process_bytes)
+#define GL_HMAC_KEYED_FINI _GLHMAC_CONCAT (GL_HMAC_FN, _finish_ctx)
 
 static void
-hmac_hash (const void *key, size_t keylen,
-           const void *in, size_t inlen,
-           int pad, void *resbuf)
+hmac_init (struct GL_HMAC_CTX *hmac_ctx, const void *key, size_t keylen,
+           int pad)
 {
   char block[GL_HMAC_BLOCKSIZE];
 
   memset (block, pad, sizeof block);
   memxor (block, key, keylen);
 
-  struct GL_HMAC_CTX hmac_ctx;
-  GL_HMAC_FN_INIT (&hmac_ctx);
-  GL_HMAC_FN_BLOC (block, sizeof block, &hmac_ctx);
-  GL_HMAC_FN_PROC (in, inlen, &hmac_ctx);
-  GL_HMAC_FN_FINI (&hmac_ctx, resbuf);
+  GL_HMAC_FN_INIT (hmac_ctx);
+  GL_HMAC_FN_BLOC (block, sizeof block, hmac_ctx);
 }
 
-int
-GL_HMAC_FN (const void *key, size_t keylen,
-            const void *in, size_t inlen, void *resbuf)
+void
+GL_HMAC_KEYED_INIT (struct GL_HMAC_KEYED_CTX *ctx,
+                    const void *key, size_t keylen)
 {
   char optkeybuf[GL_HMAC_HASHSIZE];
 
@@ -76,12 +76,36 @@ GL_HMAC_FN (const void *key, size_t keylen,
       keylen = sizeof optkeybuf;
     }
 
-  /* Compute INNERHASH from KEY and IN.  */
+  hmac_init (&ctx->inner, key, keylen, IPAD);
+  hmac_init (&ctx->outer, key, keylen, OPAD);
+}
+
+void
+GL_HMAC_KEYED_PROC (const void *buffer, size_t len,
+                    struct GL_HMAC_KEYED_CTX *ctx)
+{
+  GL_HMAC_FN_PROC (buffer, len, &ctx->inner);
+}
+
+void *
+GL_HMAC_KEYED_FINI (struct GL_HMAC_KEYED_CTX *ctx, void *resbuf)
+{
   char innerhash[GL_HMAC_HASHSIZE];
-  hmac_hash (key, keylen, in, inlen, IPAD, innerhash);
+  GL_HMAC_FN_FINI (&ctx->inner, innerhash);
+
+  GL_HMAC_FN_PROC (innerhash, sizeof innerhash, &ctx->outer);
+  return GL_HMAC_FN_FINI (&ctx->outer, resbuf);
+}
+
+int
+GL_HMAC_FN (const void *key, size_t keylen,
+            const void *in, size_t inlen, void *resbuf)
+{
+  struct GL_HMAC_KEYED_CTX ctx;
 
-  /* Compute result from KEY and INNERHASH.  */
-  hmac_hash (key, keylen, innerhash, sizeof innerhash, OPAD, resbuf);
+  GL_HMAC_KEYED_INIT (&ctx, key, keylen);
+  GL_HMAC_KEYED_PROC (in, inlen, &ctx);
+  GL_HMAC_KEYED_FINI (&ctx, resbuf);
 
   return 0;
 }
@@ -21,6 +21,19 @@
 
 #include <stddef.h>
 
+#if GNULIB_HMAC_MD5
+# include "md5.h"
+#endif
+#if GNULIB_HMAC_SHA1
+# include "sha1.h"
+#endif
+#if GNULIB_HMAC_SHA256
+# include "sha256.h"
+#endif
+#if GNULIB_HMAC_SHA512
+# include "sha512.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -59,6 +72,83 @@ hmac_sha512 (void const *restrict key, size_t keylen,
              void const *restrict in, size_t inlen, void *restrict resbuf);
 
 
+/* Precomputed HMAC contexts.
+
+   hmac_<ALG>_init_ctx hashes the padded KEY of KEYLEN bytes once, into
+   the states of the inner and outer hash.  A context initialized this
+   way may be copied, by structure assignment, to compute the HMAC of any
+   number of messages with the same key, without hashing the key again:
+
+     struct hmac_sha256_ctx keyed, ctx;
+     hmac_sha256_init_ctx (&keyed, key, keylen);
+     for (...)
+       {
+         ctx = keyed;
+         hmac_sha256_process_bytes (in, inlen, &ctx);
+         hmac_sha256_finish_ctx (&ctx, resbuf);
+       }
+
+   hmac_<ALG>_process_bytes adds LEN bytes of BUFFER to the message, and
+   hmac_<ALG>_finish_ctx writes the HMAC into RESBUF, whose size is that
+   of the digest, and returns RESBUF.  The context must not be used
+   after hmac_<ALG>_finish_ctx, except to be reinitialized or assigned
+   to.  */
+
+#if GNULIB_HMAC_MD5
+struct hmac_md5_ctx
+{
+  struct md5_ctx inner;
+  struct md5_ctx outer;
+};
+extern void hmac_md5_init_ctx (struct hmac_md5_ctx *ctx,
+                               void const *key, size_t keylen);
+extern void hmac_md5_process_bytes (void const *buffer, size_t len,
+                                    struct hmac_md5_ctx *ctx);
+extern void *hmac_md5_finish_ctx (struct hmac_md5_ctx *ctx, void *resbuf);
+#endif
+
+#if GNULIB_HMAC_SHA1
+struct hmac_sha1_ctx
+{
+  struct sha1_ctx inner;
+  struct sha1_ctx outer;
+};
+extern void hmac_sha1_init_ctx (struct hmac_sha1_ctx *ctx,
+                                void const *key, size_t keylen);
+extern void hmac_sha1_process_bytes (void const *buffer, size_t len,
+                                     struct hmac_sha1_ctx *ctx);
+extern void *hmac_sha1_finish_ctx (struct hmac_sha1_ctx *ctx, void *resbuf);
+#endif
+
+#if GNULIB_HMAC_SHA256
+struct hmac_sha256_ctx
+{
+  struct sha256_ctx inner;
+  struct sha256_ctx outer;
+};
+extern void hmac_sha256_init_ctx (struct hmac_sha256_ctx *ctx,
+                                  void const *key, size_t keylen);
+extern void hmac_sha256_process_bytes (void const *buffer, size_t len,
+                                       struct hmac_sha256_ctx *ctx);
+extern void *hmac_sha256_finish_ctx (struct hmac_sha256_ctx *ctx,
+                                     void *resbuf);
+#endif
+
+#if GNULIB_HMAC_SHA512
+struct hmac_sha512_ctx
+{
+  struct sha512_ctx inner;
+  struct sha512_ctx outer;
+};
+extern void hmac_sha512_init_ctx (struct hmac_sha512_ctx *ctx,
+                                  void const *key, size_t keylen);
+extern void hmac_sha512_process_bytes (void const *buffer, size_t len,
+                                       struct hmac_sha512_ctx *ctx);
+extern void *hmac_sha512_finish_ctx (struct hmac_sha512_ctx *ctx,
+                                     void *resbuf);
+#endif
+
+
 #ifdef __cplusplus
 }
 #endif
@@ -30,25 +30,49 @@
 # include "unlocked-io.h"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+# include "digest-readahead.h"
+#endif
+
 #define BLOCKSIZE 32768
 #if BLOCKSIZE % 64 != 0
 # error "invalid BLOCKSIZE"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+static bool
+process_bytes (void const *buffer, size_t len, void *ctx)
+{
+  md2_process_bytes (buffer, len, ctx);
+  return true;
+}
+#endif
+
 /* Compute MD2 message digest for bytes read from STREAM.  The
    resulting message digest number will be written into the 16 bytes
    beginning at RESBLOCK.  */
 int
 md2_stream (FILE *restrict stream, void *restrict resblock)
 {
-  char *buffer = malloc (BLOCKSIZE);
-  if (!buffer)
-    return 1;
-
   /* Initialize the computation context.  */
   struct md2_ctx ctx;
   md2_init_ctx (&ctx);
 
+#if GNULIB_DIGEST_READAHEAD
+  switch (digest_readahead (stream, process_bytes, &ctx))
+    {
+    case 0:
+      md2_finish_ctx (&ctx, resblock);
+      return 0;
+    case 1:
+      return 1;
+    }
+#endif
+
+  char *buffer = malloc (BLOCKSIZE);
+  if (!buffer)
+    return 1;
+
   /* Iterate over full file contents.  */
   size_t sum;
   while (1)
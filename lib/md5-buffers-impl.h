@@ -0,0 +1,127 @@
+/* MD5 compression function over several lanes.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* This file is included by md5-buffers.c with the following macros
+   defined:
+     FUNC    the name of the function to define,
+     TARGET  the instruction set extension, for __attribute__ ((__target__)),
+     VEC     a GCC vector type of LANES 32-bit unsigned integers,
+     LANES   the number of lanes.  */
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ (TARGET)))
+#endif
+static void
+FUNC (uint32_t *state, unsigned char const *const blocks[])
+{
+  alignas (32) uint32_t x[16 * LANES];
+  VEC correct_words[16];
+
+  /* Transpose the blocks, so that each vector holds the same message word
+     of all lanes.  */
+  for (int t = 0; t < 16; t++)
+    for (int l = 0; l < LANES; l++)
+      {
+        uint32_t v;
+        memcpy (&v, blocks[l] + 4 * t, sizeof v);
+        x[t * LANES + l] = SWAP (v);
+      }
+  for (int t = 0; t < 16; t++)
+    correct_words[t] = *(VEC const *) &x[t * LANES];
+
+  VEC A = *(VEC const *) &state[0 * LANES];
+  VEC B = *(VEC const *) &state[1 * LANES];
+  VEC C = *(VEC const *) &state[2 * LANES];
+  VEC D = *(VEC const *) &state[3 * LANES];
+
+  /* Round 1.  */
+  OP (FF, A, B, C, D, 0, 7, 0xd76aa478);
+  OP (FF, D, A, B, C, 1, 12, 0xe8c7b756);
+  OP (FF, C, D, A, B, 2, 17, 0x242070db);
+  OP (FF, B, C, D, A, 3, 22, 0xc1bdceee);
+  OP (FF, A, B, C, D, 4, 7, 0xf57c0faf);
+  OP (FF, D, A, B, C, 5, 12, 0x4787c62a);
+  OP (FF, C, D, A, B, 6, 17, 0xa8304613);
+  OP (FF, B, C, D, A, 7, 22, 0xfd469501);
+  OP (FF, A, B, C, D, 8, 7, 0x698098d8);
+  OP (FF, D, A, B, C, 9, 12, 0x8b44f7af);
+  OP (FF, C, D, A, B, 10, 17, 0xffff5bb1);
+  OP (FF, B, C, D, A, 11, 22, 0x895cd7be);
+  OP (FF, A, B, C, D, 12, 7, 0x6b901122);
+  OP (FF, D, A, B, C, 13, 12, 0xfd987193);
+  OP (FF, C, D, A, B, 14, 17, 0xa679438e);
+  OP (FF, B, C, D, A, 15, 22, 0x49b40821);
+
+  /* Round 2.  */
+  OP (FG, A, B, C, D, 1, 5, 0xf61e2562);
+  OP (FG, D, A, B, C, 6, 9, 0xc040b340);
+  OP (FG, C, D, A, B, 11, 14, 0x265e5a51);
+  OP (FG, B, C, D, A, 0, 20, 0xe9b6c7aa);
+  OP (FG, A, B, C, D, 5, 5, 0xd62f105d);
+  OP (FG, D, A, B, C, 10, 9, 0x02441453);
+  OP (FG, C, D, A, B, 15, 14, 0xd8a1e681);
+  OP (FG, B, C, D, A, 4, 20, 0xe7d3fbc8);
+  OP (FG, A, B, C, D, 9, 5, 0x21e1cde6);
+  OP (FG, D, A, B, C, 14, 9, 0xc33707d6);
+  OP (FG, C, D, A, B, 3, 14, 0xf4d50d87);
+  OP (FG, B, C, D, A, 8, 20, 0x455a14ed);
+  OP (FG, A, B, C, D, 13, 5, 0xa9e3e905);
+  OP (FG, D, A, B, C, 2, 9, 0xfcefa3f8);
+  OP (FG, C, D, A, B, 7, 14, 0x676f02d9);
+  OP (FG, B, C, D, A, 12, 20, 0x8d2a4c8a);
+
+  /* Round 3.  */
+  OP (FH, A, B, C, D, 5, 4, 0xfffa3942);
+  OP (FH, D, A, B, C, 8, 11, 0x8771f681);
+  OP (FH, C, D, A, B, 11, 16, 0x6d9d6122);
+  OP (FH, B, C, D, A, 14, 23, 0xfde5380c);
+  OP (FH, A, B, C, D, 1, 4, 0xa4beea44);
+  OP (FH, D, A, B, C, 4, 11, 0x4bdecfa9);
+  OP (FH, C, D, A, B, 7, 16, 0xf6bb4b60);
+  OP (FH, B, C, D, A, 10, 23, 0xbebfbc70);
+  OP (FH, A, B, C, D, 13, 4, 0x289b7ec6);
+  OP (FH, D, A, B, C, 0, 11, 0xeaa127fa);
+  OP (FH, C, D, A, B, 3, 16, 0xd4ef3085);
+  OP (FH, B, C, D, A, 6, 23, 0x04881d05);
+  OP (FH, A, B, C, D, 9, 4, 0xd9d4d039);
+  OP (FH, D, A, B, C, 12, 11, 0xe6db99e5);
+  OP (FH, C, D, A, B, 15, 16, 0x1fa27cf8);
+  OP (FH, B, C, D, A, 2, 23, 0xc4ac5665);
+
+  /* Round 4.  */
+  OP (FI, A, B, C, D, 0, 6, 0xf4292244);
+  OP (FI, D, A, B, C, 7, 10, 0x432aff97);
+  OP (FI, C, D, A, B, 14, 15, 0xab9423a7);
+  OP (FI, B, C, D, A, 5, 21, 0xfc93a039);
+  OP (FI, A, B, C, D, 12, 6, 0x655b59c3);
+  OP (FI, D, A, B, C, 3, 10, 0x8f0ccc92);
+  OP (FI, C, D, A, B, 10, 15, 0xffeff47d);
+  OP (FI, B, C, D, A, 1, 21, 0x85845dd1);
+  OP (FI, A, B, C, D, 8, 6, 0x6fa87e4f);
+  OP (FI, D, A, B, C, 15, 10, 0xfe2ce6e0);
+  OP (FI, C, D, A, B, 6, 15, 0xa3014314);
+  OP (FI, B, C, D, A, 13, 21, 0x4e0811a1);
+  OP (FI, A, B, C, D, 4, 6, 0xf7537e82);
+  OP (FI, D, A, B, C, 11, 10, 0xbd3af235);
+  OP (FI, C, D, A, B, 2, 15, 0x2ad7d2bb);
+  OP (FI, B, C, D, A, 9, 21, 0xeb86d391);
+
+  /* Add the starting values of the context.  */
+  *(VEC *) &state[0 * LANES] += A;
+  *(VEC *) &state[1 * LANES] += B;
+  *(VEC *) &state[2 * LANES] += C;
+  *(VEC *) &state[3 * LANES] += D;
+}
@@ -0,0 +1,117 @@
+/* md5-buffers.c - Compute MD5 message digests of several memory blocks
+   at once.
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "md5.h"
+
+#ifdef _LIBC
+# define md5_buffer __md5_buffer
+# define md5_buffers __md5_buffers
+#endif
+
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_MD5
+
+# include <byteswap.h>
+# include "cpu-supports.h"
+# include "digest-buffers.h"
+
+# ifdef WORDS_BIGENDIAN
+#  define SWAP(n) bswap_32 (n)
+# else
+#  define SWAP(n) (n)
+# endif
+
+static uint32_t const md5_initial_state[4] = {
+  0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476
+};
+
+/* These are the four functions used in the four steps of the MD5 algorithm
+   and defined in the RFC 1321.  They work on scalars and on vectors
+   alike.  */
+# define FF(b, c, d) (d ^ (b & (c ^ d)))
+# define FG(b, c, d) FF (d, b, c)
+# define FH(b, c, d) (b ^ c ^ d)
+# define FI(b, c, d) (c ^ (b | ~d))
+
+# define CYCLIC(w, s) (w = (w << s) | (w >> (32 - s)))
+
+# define OP(f, a, b, c, d, k, s, T)                                      \
+  do                                                                    \
+    {                                                                   \
+      a += f (b, c, d) + correct_words[k] + T;                          \
+      CYCLIC (a, s);                                                    \
+      a += b;                                                           \
+    }                                                                   \
+  while (0)
+
+typedef uint32_t v4u32 __attribute__ ((__vector_size__ (16)));
+typedef uint32_t v8u32 __attribute__ ((__vector_size__ (32)));
+
+# define FUNC md5_compress_sse2
+# define TARGET "sse2"
+# define VEC v4u32
+# define LANES 4
+# include "md5-buffers-impl.h"
+# undef FUNC
+# undef TARGET
+# undef VEC
+# undef LANES
+
+# define FUNC md5_compress_avx2
+# define TARGET "avx2"
+# define VEC v8u32
+# define LANES 8
+# include "md5-buffers-impl.h"
+# undef FUNC
+# undef TARGET
+# undef VEC
+# undef LANES
+
+static struct digest_lanes const md5_lanes[2] = {
+  { 4, 4, 4, md5_initial_state, false, md5_compress_sse2 },
+  { 8, 4, 4, md5_initial_state, false, md5_compress_avx2 }
+};
+
+static bool avx2_enabled = false;
+static bool avx2_checked = false;
+
+#endif
+
+void
+md5_buffers (char const *const buffers[], size_t const lens[], size_t n,
+             void *const resblocks[])
+{
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_MD5
+  if (n > 1)
+    {
+      if (!avx2_checked)
+        {
+          avx2_enabled = cpu_supports ("avx2");
+          avx2_checked = true;
+        }
+
+      digest_buffers (&md5_lanes[avx2_enabled], buffers, lens, n, resblocks);
+      return;
+    }
+#endif
+
+  for (size_t i = 0; i < n; i++)
+    md5_buffer (buffers[i], lens[i], resblocks[i]);
+}
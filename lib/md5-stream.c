@@ -30,6 +30,10 @@
 # include "unlocked-io.h"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+# include "digest-readahead.h"
+#endif
+
 #if GNULIB_AF_ALG
 # include "af_alg.h"
 #endif
@@ -53,6 +57,15 @@
 # error "invalid BLOCKSIZE"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+static bool
+process_bytes (void const *buffer, size_t len, void *ctx)
+{
+  md5_process_bytes (buffer, len, ctx);
+  return true;
+}
+#endif
+
 /* Compute MD5 message digest for bytes read from STREAM.  The
    resulting message digest number will be written into the 16 bytes
    beginning at RESBLOCK.  */
@@ -67,13 +80,24 @@ md5_stream (FILE *stream, void *resblock)
     }
 #endif
 
+  struct md5_ctx ctx;
+  md5_init_ctx (&ctx);
+
+#if GNULIB_DIGEST_READAHEAD
+  switch (digest_readahead (stream, process_bytes, &ctx))
+    {
+    case 0:
+      md5_finish_ctx (&ctx, resblock);
+      return 0;
+    case 1:
+      return 1;
+    }
+#endif
+
   char *buffer = malloc (BLOCKSIZE);
   if (!buffer)
     return 1;
 
-  struct md5_ctx ctx;
-  md5_init_ctx (&ctx);
-
   /* Iterate over full file contents.  */
   size_t sum;
   while (1)
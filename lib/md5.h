@@ -79,6 +79,7 @@
 
 #ifndef _LIBC
 # define __md5_buffer md5_buffer
+# define __md5_buffers md5_buffers
 # define __md5_finish_ctx md5_finish_ctx
 # define __md5_init_ctx md5_init_ctx
 # define __md5_process_block md5_process_block
@@ -166,6 +167,15 @@ extern void *__md5_buffer (char const *restrict buffer, size_t len,
 extern int __md5_stream (FILE *restrict stream, void *restrict resblock)
   __THROW;
 
+/* Compute MD5 message digests of N independent memory blocks.  For each
+   I < N, the digest of the LENS[I] bytes beginning at BUFFERS[I] is
+   written into the 16 bytes beginning at RESBLOCKS[I].  The results are
+   the same as those of md5_buffer, but the messages are hashed in parallel
+   where the CPU allows it, which is considerably faster for many short
+   messages.  */
+extern void __md5_buffers (char const *const buffers[], size_t const lens[],
+                           size_t n, void *const resblocks[]) __THROW;
+
 
 # ifdef __cplusplus
 }
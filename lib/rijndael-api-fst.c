@@ -69,6 +69,24 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef GL_RIJNDAEL_X86_64
+# include "cpu-supports.h"
+# include "rijndael-x86_64.h"
+static bool aesni_enabled = false;
+static bool aesni_checked = false;
+
+static bool
+use_aesni (void)
+{
+  if (!aesni_checked)
+    {
+      aesni_enabled = cpu_supports ("aes") && cpu_supports ("ssse3");
+      aesni_checked = true;
+    }
+  return aesni_enabled;
+}
+#endif
+
 rijndael_rc
 rijndaelMakeKey (rijndaelKeyInstance *restrict key,
                  rijndael_direction direction,
@@ -222,6 +240,14 @@ rijndaelBlockEncrypt (rijndaelCipherInstance *restrict cipher,
   switch (cipher->mode)
     {
     case RIJNDAEL_MODE_ECB:
+#ifdef GL_RIJNDAEL_X86_64
+      if (use_aesni ())
+        {
+          rijndael_ecb_encrypt_aesni (key->rk, key->Nr, input, outBuffer,
+                                      numBlocks);
+          break;
+        }
+#endif
       for (size_t i = numBlocks; i > 0; i--)
         {
           rijndaelEncrypt (key->rk, key->Nr, input, outBuffer);
@@ -232,6 +258,14 @@ rijndaelBlockEncrypt (rijndaelCipherInstance *restrict cipher,
 
     case RIJNDAEL_MODE_CBC:
       {
+#ifdef GL_RIJNDAEL_X86_64
+        if (use_aesni ())
+          {
+            rijndael_cbc_encrypt_aesni (key->rk, key->Nr, cipher->IV,
+                                        input, outBuffer, numBlocks);
+            break;
+          }
+#endif
         char *iv = cipher->IV;
         for (size_t i = numBlocks; i > 0; i--)
           {
@@ -377,6 +411,14 @@ rijndaelBlockDecrypt (rijndaelCipherInstance *restrict cipher,
   switch (cipher->mode)
     {
     case RIJNDAEL_MODE_ECB:
+#ifdef GL_RIJNDAEL_X86_64
+      if (use_aesni ())
+        {
+          rijndael_ecb_decrypt_aesni (key->rk, key->Nr, input, outBuffer,
+                                      numBlocks);
+          break;
+        }
+#endif
       for (size_t i = numBlocks; i > 0; i--)
         {
           rijndaelDecrypt (key->rk, key->Nr, input, outBuffer);
@@ -387,6 +429,14 @@ rijndaelBlockDecrypt (rijndaelCipherInstance *restrict cipher,
 
     case RIJNDAEL_MODE_CBC:
       {
+#ifdef GL_RIJNDAEL_X86_64
+        if (use_aesni ())
+          {
+            rijndael_cbc_decrypt_aesni (key->rk, key->Nr, cipher->IV,
+                                        input, outBuffer, numBlocks);
+            break;
+          }
+#endif
         char *iv = cipher->IV;
         for (size_t i = numBlocks; i > 0; i--)
           {
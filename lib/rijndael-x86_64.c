@@ -0,0 +1,508 @@
+/* rijndael-x86_64.c -- AES for x86_64 using AES-NI and PCLMUL
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* The AES-NI instructions and the GHASH computation follow Shay Gueron,
+   "Intel Advanced Encryption Standard (AES) New Instructions Set", and
+   Shay Gueron and Michael E. Kounavis, "Intel Carry-Less Multiplication
+   Instruction and its Usage for Computing the GCM Mode", Intel white
+   papers, 2010.  Where the blocks are independent, 8 of them are
+   processed per iteration, so that the latency of the instructions is
+   hidden.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "rijndael-x86_64.h"
+
+#include <string.h>
+#include <x86intrin.h>
+
+#include "byteswap.h"
+#include "rijndael-alg-fst.h"
+
+#if defined __GNUC__ || defined __clang__
+# define AESNI_TARGET __attribute__ ((__target__ ("aes,ssse3")))
+# define GCM_TARGET __attribute__ ((__target__ ("aes,pclmul,ssse3")))
+#else
+# define AESNI_TARGET
+# define GCM_TARGET
+#endif
+
+/* Load the round keys from the key schedule RK, whose words are in
+   big-endian order, into K.  The decryption key schedule of
+   rijndaelKeySetupDec is the one of the "equivalent inverse cipher",
+   which is what the aesdec instruction expects.  */
+AESNI_TARGET
+static inline void
+load_keys (__m128i k[RIJNDAEL_MAXNR + 1], uint32_t const *rk, int Nr)
+{
+  __m128i bswap32 = _mm_set_epi8 (12, 13, 14, 15, 8, 9, 10, 11,
+                                  4, 5, 6, 7, 0, 1, 2, 3);
+  for (int i = 0; i <= Nr; i++)
+    k[i] = _mm_shuffle_epi8 (_mm_loadu_si128 ((__m128i_u const *)
+                                              (rk + 4 * i)),
+                             bswap32);
+}
+
+AESNI_TARGET
+static inline __m128i
+encrypt1 (__m128i b, __m128i const *k, int Nr)
+{
+  b = _mm_xor_si128 (b, k[0]);
+  for (int i = 1; i < Nr; i++)
+    b = _mm_aesenc_si128 (b, k[i]);
+  return _mm_aesenclast_si128 (b, k[Nr]);
+}
+
+AESNI_TARGET
+static inline __m128i
+decrypt1 (__m128i b, __m128i const *k, int Nr)
+{
+  b = _mm_xor_si128 (b, k[0]);
+  for (int i = 1; i < Nr; i++)
+    b = _mm_aesdec_si128 (b, k[i]);
+  return _mm_aesdeclast_si128 (b, k[Nr]);
+}
+
+/* Apply OP with the round key KEY to each of the 8 blocks B[0..7].  */
+#define ROUND8(op, b, key) \
+  do { b[0] = op (b[0], key); b[1] = op (b[1], key); \
+       b[2] = op (b[2], key); b[3] = op (b[3], key); \
+       b[4] = op (b[4], key); b[5] = op (b[5], key); \
+       b[6] = op (b[6], key); b[7] = op (b[7], key); } while (0)
+
+AESNI_TARGET
+static inline void
+encrypt8 (__m128i b[8], __m128i const *k, int Nr)
+{
+  ROUND8 (_mm_xor_si128, b, k[0]);
+  for (int i = 1; i < Nr; i++)
+    ROUND8 (_mm_aesenc_si128, b, k[i]);
+  ROUND8 (_mm_aesenclast_si128, b, k[Nr]);
+}
+
+AESNI_TARGET
+static inline void
+decrypt8 (__m128i b[8], __m128i const *k, int Nr)
+{
+  ROUND8 (_mm_xor_si128, b, k[0]);
+  for (int i = 1; i < Nr; i++)
+    ROUND8 (_mm_aesdec_si128, b, k[i]);
+  ROUND8 (_mm_aesdeclast_si128, b, k[Nr]);
+}
+
+AESNI_TARGET
+static inline __m128i
+load (char const *p)
+{
+  return _mm_loadu_si128 ((__m128i_u const *) p);
+}
+
+AESNI_TARGET
+static inline void
+store (char *p, __m128i v)
+{
+  _mm_storeu_si128 ((__m128i_u *) p, v);
+}
+
+AESNI_TARGET
+void
+rijndael_ecb_encrypt_aesni (uint32_t const *rk, int Nr,
+                            char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+
+  for (; nblocks >= 8; nblocks -= 8, in += 8 * 16, out += 8 * 16)
+    {
+      __m128i b[8];
+      for (int j = 0; j < 8; j++)
+        b[j] = load (in + 16 * j);
+      encrypt8 (b, k, Nr);
+      for (int j = 0; j < 8; j++)
+        store (out + 16 * j, b[j]);
+    }
+
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    store (out, encrypt1 (load (in), k, Nr));
+}
+
+AESNI_TARGET
+void
+rijndael_ecb_decrypt_aesni (uint32_t const *rk, int Nr,
+                            char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+
+  for (; nblocks >= 8; nblocks -= 8, in += 8 * 16, out += 8 * 16)
+    {
+      __m128i b[8];
+      for (int j = 0; j < 8; j++)
+        b[j] = load (in + 16 * j);
+      decrypt8 (b, k, Nr);
+      for (int j = 0; j < 8; j++)
+        store (out + 16 * j, b[j]);
+    }
+
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    store (out, decrypt1 (load (in), k, Nr));
+}
+
+AESNI_TARGET
+void
+rijndael_cbc_encrypt_aesni (uint32_t const *rk, int Nr, char iv[16],
+                            char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+
+  /* Each block depends on the previous one.  */
+  __m128i v = load (iv);
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    {
+      v = encrypt1 (_mm_xor_si128 (load (in), v), k, Nr);
+      store (out, v);
+    }
+  store (iv, v);
+}
+
+AESNI_TARGET
+void
+rijndael_cbc_decrypt_aesni (uint32_t const *rk, int Nr, char iv[16],
+                            char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+
+  __m128i v = load (iv);
+  for (; nblocks >= 8; nblocks -= 8, in += 8 * 16, out += 8 * 16)
+    {
+      __m128i c[8];
+      __m128i b[8];
+      for (int j = 0; j < 8; j++)
+        b[j] = c[j] = load (in + 16 * j);
+      decrypt8 (b, k, Nr);
+      store (out, _mm_xor_si128 (b[0], v));
+      for (int j = 1; j < 8; j++)
+        store (out + 16 * j, _mm_xor_si128 (b[j], c[j - 1]));
+      v = c[7];
+    }
+
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    {
+      __m128i c = load (in);
+      store (out, _mm_xor_si128 (decrypt1 (c, k, Nr), v));
+      v = c;
+    }
+  store (iv, v);
+}
+
+/* The counter block for CTR mode, as two 64-bit halves.  */
+struct counter
+{
+  uint64_t hi;
+  uint64_t lo;
+};
+
+AESNI_TARGET
+static inline __m128i
+counter_block (struct counter *c)
+{
+  __m128i b = _mm_set_epi64x (bswap_64 (c->lo), bswap_64 (c->hi));
+  c->hi += ++c->lo == 0;
+  return b;
+}
+
+AESNI_TARGET
+void
+rijndael_ctr_aesni (uint32_t const *rk, int Nr, char ctr[16],
+                    char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+
+  struct counter c;
+  memcpy (&c.hi, ctr, 8);
+  memcpy (&c.lo, ctr + 8, 8);
+  c.hi = bswap_64 (c.hi);
+  c.lo = bswap_64 (c.lo);
+
+  for (; nblocks >= 8; nblocks -= 8, in += 8 * 16, out += 8 * 16)
+    {
+      __m128i b[8];
+      for (int j = 0; j < 8; j++)
+        b[j] = counter_block (&c);
+      encrypt8 (b, k, Nr);
+      for (int j = 0; j < 8; j++)
+        store (out + 16 * j, _mm_xor_si128 (b[j], load (in + 16 * j)));
+    }
+
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    store (out, _mm_xor_si128 (encrypt1 (counter_block (&c), k, Nr),
+                               load (in)));
+
+  c.hi = bswap_64 (c.hi);
+  c.lo = bswap_64 (c.lo);
+  memcpy (ctr, &c.hi, 8);
+  memcpy (ctr + 8, &c.lo, 8);
+}
+
+/* GHASH.
+
+   The blocks are byte-reversed, so that the bit order of GCM matches
+   that of pclmulqdq up to a shift by one bit.  gf_mul_acc adds the
+   256-bit carry-less product of A and B to LO and HI, and gf_reduce
+   reduces such a sum modulo the GCM polynomial.  Adding 8 products
+   before a single reduction, as in X = (X + C1) H^8 + C2 H^7 + ... + C8 H,
+   removes most of the reductions and the dependency between them.  */
+
+GCM_TARGET
+static inline __m128i
+bswap128 (__m128i v)
+{
+  return _mm_shuffle_epi8 (v, _mm_set_epi8 (0, 1, 2, 3, 4, 5, 6, 7,
+                                            8, 9, 10, 11, 12, 13, 14, 15));
+}
+
+GCM_TARGET
+static inline void
+gf_mul_acc (__m128i a, __m128i b, __m128i *lo, __m128i *hi)
+{
+  __m128i t0 = _mm_clmulepi64_si128 (a, b, 0x00);
+  __m128i t1 = _mm_clmulepi64_si128 (a, b, 0x10);
+  __m128i t2 = _mm_clmulepi64_si128 (a, b, 0x01);
+  __m128i t3 = _mm_clmulepi64_si128 (a, b, 0x11);
+  t1 = _mm_xor_si128 (t1, t2);
+  *lo = _mm_xor_si128 (*lo, _mm_xor_si128 (t0, _mm_slli_si128 (t1, 8)));
+  *hi = _mm_xor_si128 (*hi, _mm_xor_si128 (t3, _mm_srli_si128 (t1, 8)));
+}
+
+GCM_TARGET
+static inline __m128i
+gf_reduce (__m128i lo, __m128i hi)
+{
+  /* Shift the 256-bit value HI:LO left by one bit.  */
+  __m128i c_lo = _mm_srli_epi32 (lo, 31);
+  __m128i c_hi = _mm_srli_epi32 (hi, 31);
+  lo = _mm_slli_epi32 (lo, 1);
+  hi = _mm_slli_epi32 (hi, 1);
+  __m128i carry = _mm_srli_si128 (c_lo, 12);
+  c_hi = _mm_slli_si128 (c_hi, 4);
+  c_lo = _mm_slli_si128 (c_lo, 4);
+  lo = _mm_or_si128 (lo, c_lo);
+  hi = _mm_or_si128 (hi, _mm_or_si128 (c_hi, carry));
+
+  /* Reduce modulo x^128 + x^7 + x^2 + x + 1.  */
+  __m128i a = _mm_slli_epi32 (lo, 31);
+  __m128i b = _mm_slli_epi32 (lo, 30);
+  __m128i c = _mm_slli_epi32 (lo, 25);
+  a = _mm_xor_si128 (a, _mm_xor_si128 (b, c));
+  b = _mm_srli_si128 (a, 4);
+  a = _mm_slli_si128 (a, 12);
+  lo = _mm_xor_si128 (lo, a);
+  __m128i d = _mm_srli_epi32 (lo, 1);
+  __m128i e = _mm_srli_epi32 (lo, 2);
+  __m128i f = _mm_srli_epi32 (lo, 7);
+  d = _mm_xor_si128 (d, _mm_xor_si128 (e, f));
+  d = _mm_xor_si128 (d, b);
+  lo = _mm_xor_si128 (lo, d);
+  return _mm_xor_si128 (hi, lo);
+}
+
+GCM_TARGET
+static inline __m128i
+gf_mul (__m128i a, __m128i b)
+{
+  __m128i lo = _mm_setzero_si128 ();
+  __m128i hi = _mm_setzero_si128 ();
+  gf_mul_acc (a, b, &lo, &hi);
+  return gf_reduce (lo, hi);
+}
+
+/* Return X + C[0..7] hashed with H[I] = H^(I+1).  The blocks C are not
+   byte-reversed.  */
+GCM_TARGET
+static inline __m128i
+ghash8 (__m128i x, __m128i const c[8], __m128i const h[8])
+{
+  __m128i lo = _mm_setzero_si128 ();
+  __m128i hi = _mm_setzero_si128 ();
+  gf_mul_acc (_mm_xor_si128 (x, bswap128 (c[0])), h[7], &lo, &hi);
+  for (int j = 1; j < 8; j++)
+    gf_mul_acc (bswap128 (c[j]), h[7 - j], &lo, &hi);
+  return gf_reduce (lo, hi);
+}
+
+GCM_TARGET
+static inline void
+load_htable (__m128i h[8], char const *htable)
+{
+  for (int i = 0; i < 8; i++)
+    h[i] = load (htable + 16 * i);
+}
+
+GCM_TARGET
+void
+rijndael_ghash_init_pclmul (char htable[RIJNDAEL_GHASH_TABLE_SIZE],
+                            char const hkey[16])
+{
+  __m128i h = bswap128 (load (hkey));
+  __m128i p = h;
+  store (htable, p);
+  for (int i = 1; i < 8; i++)
+    {
+      p = gf_mul (p, h);
+      store (htable + 16 * i, p);
+    }
+}
+
+GCM_TARGET
+void
+rijndael_ghash_pclmul (char const *htable, char x[16],
+                       char const *data, size_t nblocks)
+{
+  __m128i h[8];
+  load_htable (h, htable);
+  __m128i v = bswap128 (load (x));
+
+  for (; nblocks >= 8; nblocks -= 8, data += 8 * 16)
+    {
+      __m128i c[8];
+      for (int j = 0; j < 8; j++)
+        c[j] = load (data + 16 * j);
+      v = ghash8 (v, c, h);
+    }
+
+  for (; nblocks > 0; nblocks--, data += 16)
+    v = gf_mul (_mm_xor_si128 (v, bswap128 (load (data))), h[0]);
+
+  store (x, bswap128 (v));
+}
+
+/* The counter block of GCM, whose last 32 bits are incremented.  */
+struct gcm_counter
+{
+  __m128i base;
+  uint32_t n;
+};
+
+GCM_TARGET
+static inline void
+gcm_counter_init (struct gcm_counter *c, char const ctr[16])
+{
+  uint32_t n;
+  memcpy (&n, ctr + 12, 4);
+  c->n = bswap_32 (n);
+  c->base = _mm_and_si128 (load (ctr), _mm_set_epi32 (0, -1, -1, -1));
+}
+
+GCM_TARGET
+static inline __m128i
+gcm_counter_block (struct gcm_counter *c)
+{
+  __m128i n = _mm_cvtsi32_si128 (bswap_32 (c->n++));
+  return _mm_or_si128 (c->base, _mm_slli_si128 (n, 12));
+}
+
+GCM_TARGET
+static inline void
+gcm_counter_store (struct gcm_counter const *c, char ctr[16])
+{
+  uint32_t n = bswap_32 (c->n);
+  memcpy (ctr + 12, &n, 4);
+}
+
+GCM_TARGET
+void
+rijndael_gcm_encrypt_aesni (uint32_t const *rk, int Nr, char const *htable,
+                            char ctr[16], char x[16],
+                            char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+  __m128i h[8];
+  load_htable (h, htable);
+  __m128i v = bswap128 (load (x));
+  struct gcm_counter c;
+  gcm_counter_init (&c, ctr);
+
+  for (; nblocks >= 8; nblocks -= 8, in += 8 * 16, out += 8 * 16)
+    {
+      __m128i b[8];
+      for (int j = 0; j < 8; j++)
+        b[j] = gcm_counter_block (&c);
+      encrypt8 (b, k, Nr);
+      for (int j = 0; j < 8; j++)
+        {
+          b[j] = _mm_xor_si128 (b[j], load (in + 16 * j));
+          store (out + 16 * j, b[j]);
+        }
+      v = ghash8 (v, b, h);
+    }
+
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    {
+      __m128i b = _mm_xor_si128 (encrypt1 (gcm_counter_block (&c), k, Nr),
+                                 load (in));
+      store (out, b);
+      v = gf_mul (_mm_xor_si128 (v, bswap128 (b)), h[0]);
+    }
+
+  gcm_counter_store (&c, ctr);
+  store (x, bswap128 (v));
+}
+
+GCM_TARGET
+void
+rijndael_gcm_decrypt_aesni (uint32_t const *rk, int Nr, char const *htable,
+                            char ctr[16], char x[16],
+                            char const *in, char *out, size_t nblocks)
+{
+  __m128i k[RIJNDAEL_MAXNR + 1];
+  load_keys (k, rk, Nr);
+  __m128i h[8];
+  load_htable (h, htable);
+  __m128i v = bswap128 (load (x));
+  struct gcm_counter c;
+  gcm_counter_init (&c, ctr);
+
+  for (; nblocks >= 8; nblocks -= 8, in += 8 * 16, out += 8 * 16)
+    {
+      __m128i d[8];
+      __m128i b[8];
+      for (int j = 0; j < 8; j++)
+        {
+          d[j] = load (in + 16 * j);
+          b[j] = gcm_counter_block (&c);
+        }
+      v = ghash8 (v, d, h);
+      encrypt8 (b, k, Nr);
+      for (int j = 0; j < 8; j++)
+        store (out + 16 * j, _mm_xor_si128 (b[j], d[j]));
+    }
+
+  for (; nblocks > 0; nblocks--, in += 16, out += 16)
+    {
+      __m128i d = load (in);
+      v = gf_mul (_mm_xor_si128 (v, bswap128 (d)), h[0]);
+      store (out, _mm_xor_si128 (encrypt1 (gcm_counter_block (&c), k, Nr),
+                                 d));
+    }
+
+  gcm_counter_store (&c, ctr);
+  store (x, bswap128 (v));
+}
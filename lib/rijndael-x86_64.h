@@ -0,0 +1,85 @@
+/* rijndael-x86_64.h -- AES for x86_64 using AES-NI and PCLMUL
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#ifndef RIJNDAEL_X86_64_H
+#define RIJNDAEL_X86_64_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* The functions below take the key schedules RK of rijndaelKeySetupEnc
+   and rijndaelKeySetupDec, for NR rounds, and process NBLOCKS blocks of
+   16 bytes from IN to OUT, which may be the same buffer but must not
+   overlap otherwise.  They require the AES-NI and SSSE3 extensions.  */
+
+extern void rijndael_ecb_encrypt_aesni (uint32_t const *rk, int Nr,
+                                        char const *in, char *out,
+                                        size_t nblocks);
+extern void rijndael_ecb_decrypt_aesni (uint32_t const *rk, int Nr,
+                                        char const *in, char *out,
+                                        size_t nblocks);
+
+/* Encrypt or decrypt in CBC mode, with the initialization vector IV,
+   which is updated for the next call.  */
+extern void rijndael_cbc_encrypt_aesni (uint32_t const *rk, int Nr,
+                                        char iv[16],
+                                        char const *in, char *out,
+                                        size_t nblocks);
+extern void rijndael_cbc_decrypt_aesni (uint32_t const *rk, int Nr,
+                                        char iv[16],
+                                        char const *in, char *out,
+                                        size_t nblocks);
+
+/* Encrypt or decrypt in CTR mode, with the counter block CTR, a 128-bit
+   big-endian number, which is updated for the next call.  */
+extern void rijndael_ctr_aesni (uint32_t const *rk, int Nr, char ctr[16],
+                                char const *in, char *out, size_t nblocks);
+
+/* GHASH, the universal hash function of GCM.  HTABLE holds powers of the
+   hash key H, computed by rijndael_ghash_init_pclmul.  The functions
+   below require the PCLMUL and SSSE3 extensions.  */
+enum { RIJNDAEL_GHASH_TABLE_SIZE = 8 * 16 };
+
+extern void rijndael_ghash_init_pclmul (char htable[RIJNDAEL_GHASH_TABLE_SIZE],
+                                        char const h[16]);
+
+/* Update the hash value X with the NBLOCKS blocks of 16 bytes at DATA.  */
+extern void rijndael_ghash_pclmul (char const *htable, char x[16],
+                                   char const *data, size_t nblocks);
+
+/* Encrypt or decrypt in GCM mode: like rijndael_ctr_aesni, except that
+   only the last 32 bits of CTR are incremented, and that the ciphertext
+   is hashed into X.  These functions require AES-NI, PCLMUL and SSSE3.  */
+extern void rijndael_gcm_encrypt_aesni (uint32_t const *rk, int Nr,
+                                        char const *htable,
+                                        char ctr[16], char x[16],
+                                        char const *in, char *out,
+                                        size_t nblocks);
+extern void rijndael_gcm_decrypt_aesni (uint32_t const *rk, int Nr,
+                                        char const *htable,
+                                        char ctr[16], char x[16],
+                                        char const *in, char *out,
+                                        size_t nblocks);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RIJNDAEL_X86_64_H */
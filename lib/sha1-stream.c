@@ -32,6 +32,10 @@
 # include "unlocked-io.h"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+# include "digest-readahead.h"
+#endif
+
 #if GNULIB_AF_ALG
 # include "af_alg.h"
 #endif
@@ -41,6 +45,15 @@
 # error "invalid BLOCKSIZE"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+static bool
+process_bytes (void const *buffer, size_t len, void *ctx)
+{
+  sha1_process_bytes (buffer, len, ctx);
+  return true;
+}
+#endif
+
 /* Compute SHA1 message digest for bytes read from STREAM.  The
    resulting message digest number will be written into the 20 bytes
    beginning at RESBLOCK.  */
@@ -55,12 +68,24 @@ sha1_stream (FILE *restrict stream, void *restrict resblock)
     }
 #endif
 
+  struct sha1_ctx ctx;
+  sha1_init_ctx (&ctx);
+
+#if GNULIB_DIGEST_READAHEAD
+  switch (digest_readahead (stream, process_bytes, &ctx))
+    {
+    case 0:
+      sha1_finish_ctx (&ctx, resblock);
+      return 0;
+    case 1:
+      return 1;
+    }
+#endif
+
   char *buffer = malloc (BLOCKSIZE);
   if (!buffer)
     return 1;
 
-  struct sha1_ctx ctx;
-  sha1_init_ctx (&ctx);
   size_t sum;
 
   /* Iterate over full file contents.  */
@@ -0,0 +1,80 @@
+/* SHA-256 compression function over several lanes.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* This file is included by sha256-buffers.c with the following macros
+   defined:
+     FUNC    the name of the function to define,
+     TARGET  the instruction set extension, for __attribute__ ((__target__)),
+     VEC     a GCC vector type of LANES 32-bit unsigned integers,
+     LANES   the number of lanes.  */
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ (TARGET)))
+#endif
+static void
+FUNC (uint32_t *state, unsigned char const *const blocks[])
+{
+  alignas (32) uint32_t x[16 * LANES];
+  VEC w[16];
+
+  /* Transpose the blocks, so that each vector holds the same message word
+     of all lanes.  */
+  for (int t = 0; t < 16; t++)
+    for (int l = 0; l < LANES; l++)
+      {
+        uint32_t v;
+        memcpy (&v, blocks[l] + 4 * t, sizeof v);
+        x[t * LANES + l] = SWAP (v);
+      }
+  for (int t = 0; t < 16; t++)
+    w[t] = *(VEC const *) &x[t * LANES];
+
+  VEC a = *(VEC const *) &state[0 * LANES];
+  VEC b = *(VEC const *) &state[1 * LANES];
+  VEC c = *(VEC const *) &state[2 * LANES];
+  VEC d = *(VEC const *) &state[3 * LANES];
+  VEC e = *(VEC const *) &state[4 * LANES];
+  VEC f = *(VEC const *) &state[5 * LANES];
+  VEC g = *(VEC const *) &state[6 * LANES];
+  VEC h = *(VEC const *) &state[7 * LANES];
+
+  for (int t = 0; t < 64; t++)
+    {
+      if (t >= 16)
+        w[t & 15] += (S1 (w[(t - 2) & 15]) + w[(t - 7) & 15]
+                      + S0 (w[(t - 15) & 15]));
+
+      VEC t1 = h + SS1 (e) + F1 (e, f, g) + K (t) + w[t & 15];
+      VEC t0 = SS0 (a) + F2 (a, b, c);
+      h = g;
+      g = f;
+      f = e;
+      e = d + t1;
+      d = c;
+      c = b;
+      b = a;
+      a = t0 + t1;
+    }
+
+  *(VEC *) &state[0 * LANES] += a;
+  *(VEC *) &state[1 * LANES] += b;
+  *(VEC *) &state[2 * LANES] += c;
+  *(VEC *) &state[3 * LANES] += d;
+  *(VEC *) &state[4 * LANES] += e;
+  *(VEC *) &state[5 * LANES] += f;
+  *(VEC *) &state[6 * LANES] += g;
+  *(VEC *) &state[7 * LANES] += h;
+}
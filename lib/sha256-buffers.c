@@ -0,0 +1,160 @@
+/* sha256-buffers.c - Compute SHA256 and SHA224 message digests of several
+   memory blocks at once.
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "sha256.h"
+
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_SHA256
+
+# include <byteswap.h>
+# include "cpu-supports.h"
+# include "digest-buffers.h"
+
+# define SWAP(n) bswap_32 (n)
+
+static uint32_t const sha256_initial_state[8] = {
+  0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+  0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL
+};
+
+static uint32_t const sha224_initial_state[8] = {
+  0xc1059ed8UL, 0x367cd507UL, 0x3070dd17UL, 0xf70e5939UL,
+  0xffc00b31UL, 0x68581511UL, 0x64f98fa7UL, 0xbefa4fa4UL
+};
+
+/* SHA256 round constants */
+# define K(I) sha256_round_constants[I]
+static uint32_t const sha256_round_constants[64] = {
+  0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL,
+  0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+  0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL,
+  0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+  0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL,
+  0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+  0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL,
+  0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+  0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL,
+  0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+  0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL,
+  0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+  0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL,
+  0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+  0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL,
+  0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL,
+};
+
+/* Round functions.  These work on scalars and on vectors alike.  */
+# define F2(A,B,C) ( ( A & B ) | ( C & ( A | B ) ) )
+# define F1(E,F,G) ( G ^ ( E & ( F ^ G ) ) )
+
+# define rol(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+# define S0(x) (rol(x,25)^rol(x,14)^(x>>3))
+# define S1(x) (rol(x,15)^rol(x,13)^(x>>10))
+# define SS0(x) (rol(x,30)^rol(x,19)^rol(x,10))
+# define SS1(x) (rol(x,26)^rol(x,21)^rol(x,7))
+
+typedef uint32_t v4u32 __attribute__ ((__vector_size__ (16)));
+typedef uint32_t v8u32 __attribute__ ((__vector_size__ (32)));
+
+# define FUNC sha256_compress_sse2
+# define TARGET "sse2"
+# define VEC v4u32
+# define LANES 4
+# include "sha256-buffers-impl.h"
+# undef FUNC
+# undef TARGET
+# undef VEC
+# undef LANES
+
+# define FUNC sha256_compress_avx2
+# define TARGET "avx2"
+# define VEC v8u32
+# define LANES 8
+# include "sha256-buffers-impl.h"
+# undef FUNC
+# undef TARGET
+# undef VEC
+# undef LANES
+
+static struct digest_lanes const sha256_lanes[2][2] = {
+  { { 4, 8, 8, sha256_initial_state, true, sha256_compress_sse2 },
+    { 8, 8, 8, sha256_initial_state, true, sha256_compress_avx2 } },
+  { { 4, 8, 7, sha224_initial_state, true, sha256_compress_sse2 },
+    { 8, 8, 7, sha224_initial_state, true, sha256_compress_avx2 } }
+};
+
+/* Which of sha256_lanes to use: -1 for none, 0 for SSE2, 1 for AVX2.  */
+static int lanes_index;
+static bool lanes_checked = false;
+
+/* Compute the digests through ALG[lanes_index], and return true, or
+   return false if the messages are better hashed one by one.  */
+static bool
+shaxxx_buffers (struct digest_lanes const alg[2],
+                char const *const buffers[], size_t const lens[], size_t n,
+                void *const resblocks[])
+{
+  if (!lanes_checked)
+    {
+      lanes_index = cpu_supports ("avx2");
+# ifdef GL_SHA256_X86_64
+      /* sha256_process_block with the SHA extensions is faster than
+         eight AVX2 lanes.  */
+      if (cpu_supports ("sha") && cpu_supports ("sse4.1"))
+        lanes_index = -1;
+# endif
+      lanes_checked = true;
+    }
+
+  if (lanes_index < 0)
+    return false;
+  digest_buffers (&alg[lanes_index], buffers, lens, n, resblocks);
+  return true;
+}
+
+#endif
+
+void
+sha256_buffers (char const *const buffers[], size_t const lens[], size_t n,
+                void *const resblocks[])
+{
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_SHA256
+  if (n > 1
+      && shaxxx_buffers (sha256_lanes[0], buffers, lens, n, resblocks))
+    return;
+#endif
+
+  for (size_t i = 0; i < n; i++)
+    sha256_buffer (buffers[i], lens[i], resblocks[i]);
+}
+
+void
+sha224_buffers (char const *const buffers[], size_t const lens[], size_t n,
+                void *const resblocks[])
+{
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_SHA256
+  if (n > 1
+      && shaxxx_buffers (sha256_lanes[1], buffers, lens, n, resblocks))
+    return;
+#endif
+
+  for (size_t i = 0; i < n; i++)
+    sha224_buffer (buffers[i], lens[i], resblocks[i]);
+}
@@ -0,0 +1,254 @@
+/* sha256-x86_64.c -- SHA-256 compression function for x86_64 using
+   the SHA extensions or AVX2
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "sha256-x86_64.h"
+
+#include <x86intrin.h>
+
+/* SHA256 round constants.  These are the same as in sha256.c, but aligned
+   so that four of them can be loaded into a vector register at once.  */
+alignas (16) static const uint32_t K[64] = {
+  0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL,
+  0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+  0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL,
+  0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+  0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL,
+  0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+  0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL,
+  0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+  0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL,
+  0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+  0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL,
+  0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+  0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL,
+  0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+  0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL,
+  0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL,
+};
+
+/* The SHA extensions.  The sha256rnds2 instruction performs two rounds
+   on the state held as ABEF and CDGH in two registers; sha256msg1 and
+   sha256msg2 compute the message schedule four words at a time.  */
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("sha,sse4.1")))
+#endif
+void
+sha256_process_block_shani (uint32_t state[8], void const *buffer,
+                            size_t len)
+{
+  const __m128i_u *data = buffer;
+  size_t nblocks = len / 64;
+  /* Converts four big-endian words to host byte order.  */
+  const __m128i bswap_mask =
+    _mm_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+  /* Rearrange the state from ABCD EFGH into ABEF CDGH.  */
+  __m128i tmp = _mm_loadu_si128 ((const __m128i_u *) &state[0]);
+  __m128i state1 = _mm_loadu_si128 ((const __m128i_u *) &state[4]);
+  tmp = _mm_shuffle_epi32 (tmp, 0xB1);
+  state1 = _mm_shuffle_epi32 (state1, 0x1B);
+  __m128i state0 = _mm_alignr_epi8 (tmp, state1, 8);
+  state1 = _mm_blend_epi16 (state1, tmp, 0xF0);
+
+  for (; nblocks > 0; nblocks--, data += 4)
+    {
+      __m128i abef_save = state0;
+      __m128i cdgh_save = state1;
+      __m128i msg[4];
+
+      for (int i = 0; i < 4; i++)
+        msg[i] = _mm_shuffle_epi8 (_mm_loadu_si128 (data + i), bswap_mask);
+
+      for (int t = 0; t < 64; t += 4)
+        {
+          __m128i cur = msg[(t / 4) % 4];
+          __m128i wk = _mm_add_epi32 (cur,
+                                      _mm_load_si128 ((const __m128i *) &K[t]));
+          state1 = _mm_sha256rnds2_epu32 (state1, state0, wk);
+          wk = _mm_shuffle_epi32 (wk, 0x0E);
+          state0 = _mm_sha256rnds2_epu32 (state0, state1, wk);
+
+          /* Compute the message words for rounds T+16 to T+19, from the
+             words for rounds T to T+15.  */
+          if (t < 48)
+            {
+              __m128i w4 = msg[(t / 4 + 1) % 4];
+              __m128i w8 = msg[(t / 4 + 2) % 4];
+              __m128i w12 = msg[(t / 4 + 3) % 4];
+              __m128i next = _mm_sha256msg1_epu32 (cur, w4);
+              next = _mm_add_epi32 (next, _mm_alignr_epi8 (w12, w8, 4));
+              msg[(t / 4) % 4] = _mm_sha256msg2_epu32 (next, w12);
+            }
+        }
+
+      state0 = _mm_add_epi32 (state0, abef_save);
+      state1 = _mm_add_epi32 (state1, cdgh_save);
+    }
+
+  /* Rearrange the state back into ABCD EFGH.  */
+  tmp = _mm_shuffle_epi32 (state0, 0x1B);
+  state1 = _mm_shuffle_epi32 (state1, 0xB1);
+  state0 = _mm_blend_epi16 (tmp, state1, 0xF0);
+  state1 = _mm_alignr_epi8 (state1, tmp, 8);
+  _mm_storeu_si128 ((__m128i_u *) &state[0], state0);
+  _mm_storeu_si128 ((__m128i_u *) &state[4], state1);
+}
+
+/* AVX2.  The rounds themselves cannot be vectorized, but the message
+   schedule can: each 128-bit lane of a 256-bit register computes four
+   message words of one block, so that the schedules of two consecutive
+   blocks are computed together.  The rounds then run on the precomputed
+   W[t] + K[t] values, using the BMI2 rotate instruction.  */
+
+#define rol(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define SS0(x) (rol (x, 30) ^ rol (x, 19) ^ rol (x, 10))
+#define SS1(x) (rol (x, 26) ^ rol (x, 21) ^ rol (x, 7))
+#define F2(A,B,C) ( ( A & B ) | ( C & ( A | B ) ) )
+#define F1(E,F,G) ( G ^ ( E & ( F ^ G ) ) )
+
+#define R(A,B,C,D,E,F,G,H,WK) \
+  do { uint32_t t0 = SS0 (A) + F2 (A, B, C);           \
+       uint32_t t1 = H + SS1 (E) + F1 (E, F, G) + WK;  \
+       D += t1;  H = t0 + t1;                          \
+  } while (0)
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2,bmi2")))
+#endif
+static void
+sha256_rounds_avx2 (uint32_t state[8], const uint32_t wk[64])
+{
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
+  uint32_t f = state[5];
+  uint32_t g = state[6];
+  uint32_t h = state[7];
+
+  for (int t = 0; t < 64; t += 8)
+    {
+      R (a, b, c, d, e, f, g, h, wk[t + 0]);
+      R (h, a, b, c, d, e, f, g, wk[t + 1]);
+      R (g, h, a, b, c, d, e, f, wk[t + 2]);
+      R (f, g, h, a, b, c, d, e, wk[t + 3]);
+      R (e, f, g, h, a, b, c, d, wk[t + 4]);
+      R (d, e, f, g, h, a, b, c, wk[t + 5]);
+      R (c, d, e, f, g, h, a, b, wk[t + 6]);
+      R (b, c, d, e, f, g, h, a, wk[t + 7]);
+    }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+/* Rotate each 32-bit element of X right by N bits.  */
+#define ROR_EPI32(x, n) \
+  _mm256_or_si256 (_mm256_srli_epi32 (x, n), _mm256_slli_epi32 (x, 32 - (n)))
+
+#if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2,bmi2")))
+#endif
+void
+sha256_process_block_avx2 (uint32_t state[8], void const *buffer,
+                           size_t len)
+{
+  const char *data = buffer;
+  size_t nblocks = len / 64;
+  const __m256i bswap_mask =
+    _mm256_set_epi64x (0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL,
+                       0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  alignas (32) uint32_t wk[2][64];
+
+  while (nblocks > 0)
+    {
+      /* With an odd number of blocks, the last block is loaded into both
+         lanes and the result of the upper lane is ignored.  */
+      const char *data2 = nblocks > 1 ? data + 64 : data;
+      __m256i w[4];
+
+      for (int i = 0; i < 4; i++)
+        {
+          __m128i lo = _mm_loadu_si128 ((const __m128i_u *) (data + 16 * i));
+          __m128i hi = _mm_loadu_si128 ((const __m128i_u *) (data2 + 16 * i));
+          w[i] = _mm256_shuffle_epi8 (_mm256_inserti128_si256
+                                      (_mm256_castsi128_si256 (lo), hi, 1),
+                                      bswap_mask);
+        }
+
+      for (int t = 0; t < 64; t += 4)
+        {
+          if (t >= 16)
+            {
+              /* W[t] = s1(W[t-2]) + W[t-7] + s0(W[t-15]) + W[t-16].  */
+              __m256i w16 = w[(t / 4) % 4];
+              __m256i w12 = w[(t / 4 + 1) % 4];
+              __m256i w8 = w[(t / 4 + 2) % 4];
+              __m256i w4 = w[(t / 4 + 3) % 4];
+              __m256i w15 = _mm256_alignr_epi8 (w12, w16, 4);
+              __m256i w7 = _mm256_alignr_epi8 (w4, w8, 4);
+              __m256i s0 = _mm256_xor_si256 (_mm256_xor_si256
+                                             (ROR_EPI32 (w15, 7),
+                                              ROR_EPI32 (w15, 18)),
+                                             _mm256_srli_epi32 (w15, 3));
+              __m256i x = _mm256_add_epi32 (_mm256_add_epi32 (w16, s0), w7);
+
+              /* The first two words depend on W[t-2] and W[t-1] only.  */
+              __m256i w2 = _mm256_srli_si256 (w4, 8);
+              __m256i s1 = _mm256_xor_si256 (_mm256_xor_si256
+                                             (ROR_EPI32 (w2, 17),
+                                              ROR_EPI32 (w2, 19)),
+                                             _mm256_srli_epi32 (w2, 10));
+              x = _mm256_add_epi32 (x, s1);
+
+              /* The last two words depend on the first two.  */
+              w2 = _mm256_slli_si256 (x, 8);
+              s1 = _mm256_xor_si256 (_mm256_xor_si256
+                                     (ROR_EPI32 (w2, 17),
+                                      ROR_EPI32 (w2, 19)),
+                                     _mm256_srli_epi32 (w2, 10));
+              w[(t / 4) % 4] = _mm256_add_epi32 (x, s1);
+            }
+
+          __m256i k =
+            _mm256_broadcastsi128_si256 (_mm_load_si128
+                                         ((const __m128i *) &K[t]));
+          __m256i v = _mm256_add_epi32 (w[(t / 4) % 4], k);
+          _mm_store_si128 ((__m128i *) &wk[0][t], _mm256_castsi256_si128 (v));
+          _mm_store_si128 ((__m128i *) &wk[1][t],
+                           _mm256_extracti128_si256 (v, 1));
+        }
+
+      sha256_rounds_avx2 (state, wk[0]);
+      if (nblocks == 1)
+        break;
+      sha256_rounds_avx2 (state, wk[1]);
+      data += 128;
+      nblocks -= 2;
+    }
+}
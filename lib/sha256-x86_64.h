@@ -0,0 +1,45 @@
+/* sha256-x86_64.h -- SHA-256 compression function for x86_64
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#ifndef SHA256_X86_64_H
+#define SHA256_X86_64_H 1
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Update the eight SHA-256 chaining values in STATE with the LEN bytes
+   starting at BUFFER.  LEN must be a multiple of 64.  Unlike
+   sha256_process_block, these functions do not maintain the byte count.
+
+   sha256_process_block_shani requires the SHA extensions and SSE4.1;
+   sha256_process_block_avx2 requires AVX2 and BMI2.  Callers must check
+   for these CPU features before calling.  */
+extern void
+sha256_process_block_shani (uint32_t state[8], void const *buffer,
+                            size_t len);
+extern void
+sha256_process_block_avx2 (uint32_t state[8], void const *buffer,
+                           size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHA256_X86_64_H */
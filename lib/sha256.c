@@ -40,6 +40,14 @@
 
 #if ! HAVE_OPENSSL_SHA256
 
+#ifdef GL_SHA256_X86_64
+# include "cpu-supports.h"
+# include "sha256-x86_64.h"
+static bool shani_enabled = false;
+static bool avx2_enabled = false;
+static bool x86_64_checked = false;
+#endif
+
 /* This array contains the bytes used to pad the buffer to the next
    64-byte boundary.  */
 static const unsigned char fillbuf[64] = { 0x80, 0 /* , 0, 0, ...  */ };
@@ -316,6 +324,28 @@ sha256_process_block (void const *restrict buffer, size_t len,
   ctx->total[0] += lolen;
   ctx->total[1] += (len >> 31 >> 1) + (ctx->total[0] < lolen);
 
+#ifdef GL_SHA256_X86_64
+  if (!x86_64_checked)
+    {
+      shani_enabled = (cpu_supports ("sha")
+                       && cpu_supports ("sse4.1"));
+      avx2_enabled = (cpu_supports ("avx2")
+                      && cpu_supports ("bmi2"));
+      x86_64_checked = true;
+    }
+
+  if (shani_enabled)
+    {
+      sha256_process_block_shani (ctx->state, buffer, len);
+      return;
+    }
+  if (avx2_enabled)
+    {
+      sha256_process_block_avx2 (ctx->state, buffer, len);
+      return;
+    }
+#endif
+
 #define rol(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
 #define S0(x) (rol(x,25)^rol(x,14)^(x>>3))
 #define S1(x) (rol(x,15)^rol(x,13)^(x>>10))
@@ -127,6 +127,17 @@ extern void *sha224_buffer (char const *restrict buffer, size_t len,
 extern int sha256_stream (FILE *restrict stream, void *restrict resblock);
 extern int sha224_stream (FILE *restrict stream, void *restrict resblock);
 
+/* Compute SHA256 (SHA224) message digests of N independent memory blocks.
+   For each I < N, the digest of the LENS[I] bytes beginning at BUFFERS[I]
+   is written into the 32 (28) bytes beginning at RESBLOCKS[I].  The results
+   are the same as those of sha256_buffer (sha224_buffer), but the messages
+   are hashed in parallel where the CPU allows it, which is considerably
+   faster for many short messages.  */
+extern void sha256_buffers (char const *const buffers[], size_t const lens[],
+                            size_t n, void *const resblocks[]);
+extern void sha224_buffers (char const *const buffers[], size_t const lens[],
+                            size_t n, void *const resblocks[]);
+
 
 # ifdef __cplusplus
 }
@@ -0,0 +1,301 @@
+/* sha3-buffers.c - Compute SHA-3 message digests of several memory blocks
+   at once.
+
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This file is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as
+   published by the Free Software Foundation; either version 2.1 of the
+   License, or (at your option) any later version.
+
+   This file is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "sha3.h"
+
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_SHA3
+
+# include <stdint.h>
+# include <string.h>
+
+# include "cpu-supports.h"
+
+/* The number of messages processed in parallel.  */
+enum { LANES = 4 };
+
+typedef uint64_t v4u64 __attribute__ ((__vector_size__ (32)));
+
+static uint64_t const rc[24] = {
+  0x0000000000000001, 0x0000000000008082, 0x800000000000808A,
+  0x8000000080008000, 0x000000000000808B, 0x0000000080000001,
+  0x8000000080008081, 0x8000000000008009, 0x000000000000008A,
+  0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+  0x000000008000808B, 0x800000000000008B, 0x8000000000008089,
+  0x8000000000008003, 0x8000000000008002, 0x8000000000000080,
+  0x000000000000800A, 0x800000008000000A, 0x8000000080008081,
+  0x8000000000008080, 0x0000000080000001, 0x8000000080008008
+};
+
+# define ROL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+/* The last part of Theta: add D[X] to column X.  */
+# define THETA(x) \
+  do { a[x] ^= d[x]; a[x + 5] ^= d[x]; a[x + 10] ^= d[x]; \
+       a[x + 15] ^= d[x]; a[x + 20] ^= d[x]; } while (0)
+
+/* Rho and Pi, as in sha3.c: move T1 to lane I, rotated by N bits, and
+   pick up the previous contents of lane I.  */
+# define RHO_PI(i, n) \
+  do { t2 = ROL (t1, n); t1 = a[i]; a[i] = t2; } while (0)
+
+/* Chi on the row starting at lane J.  */
+# define CHI(j) \
+  do { t1 = a[j]; t2 = a[j + 1]; \
+       a[j] ^= ~a[j + 1] & a[j + 2]; \
+       a[j + 1] ^= ~a[j + 2] & a[j + 3]; \
+       a[j + 2] ^= ~a[j + 3] & a[j + 4]; \
+       a[j + 3] ^= ~a[j + 4] & t1; \
+       a[j + 4] ^= ~t1 & t2; } while (0)
+
+/* Apply the Keccak-f[1600] permutation to four states at once.  STATE[I]
+   holds lane I of each of the four states.  */
+# if defined __GNUC__ || defined __clang__
+__attribute__ ((__target__ ("avx2")))
+# endif
+static void
+keccak_permute_x4 (v4u64 *state)
+{
+  /* Work on a local copy, which the compiler can keep in registers as far
+     as possible.  */
+  v4u64 a[25];
+  memcpy (a, state, sizeof a);
+
+  for (int i = 0; i < 24; ++i)
+    {
+      v4u64 c[5];
+      v4u64 d[5];
+      v4u64 t1;
+      v4u64 t2;
+
+      /* Theta.  */
+      c[0] = a[0] ^ a[5] ^ a[10] ^ a[15] ^ a[20];
+      c[1] = a[1] ^ a[6] ^ a[11] ^ a[16] ^ a[21];
+      c[2] = a[2] ^ a[7] ^ a[12] ^ a[17] ^ a[22];
+      c[3] = a[3] ^ a[8] ^ a[13] ^ a[18] ^ a[23];
+      c[4] = a[4] ^ a[9] ^ a[14] ^ a[19] ^ a[24];
+      d[0] = c[4] ^ ROL (c[1], 1);
+      d[1] = c[0] ^ ROL (c[2], 1);
+      d[2] = c[1] ^ ROL (c[3], 1);
+      d[3] = c[2] ^ ROL (c[4], 1);
+      d[4] = c[3] ^ ROL (c[0], 1);
+      THETA (0);
+      THETA (1);
+      THETA (2);
+      THETA (3);
+      THETA (4);
+
+      /* Rho and Pi.  */
+      t1 = a[1];
+      RHO_PI (10, 1);
+      RHO_PI (7, 3);
+      RHO_PI (11, 6);
+      RHO_PI (17, 10);
+      RHO_PI (18, 15);
+      RHO_PI (3, 21);
+      RHO_PI (5, 28);
+      RHO_PI (16, 36);
+      RHO_PI (8, 45);
+      RHO_PI (21, 55);
+      RHO_PI (24, 2);
+      RHO_PI (4, 14);
+      RHO_PI (15, 27);
+      RHO_PI (23, 41);
+      RHO_PI (19, 56);
+      RHO_PI (13, 8);
+      RHO_PI (12, 25);
+      RHO_PI (2, 43);
+      RHO_PI (20, 62);
+      RHO_PI (14, 18);
+      RHO_PI (22, 39);
+      RHO_PI (9, 61);
+      RHO_PI (6, 20);
+      RHO_PI (1, 44);
+
+      /* Chi.  */
+      CHI (0);
+      CHI (5);
+      CHI (10);
+      CHI (15);
+      CHI (20);
+
+      /* Iota.  */
+      a[0] ^= (v4u64) { rc[i], rc[i], rc[i], rc[i] };
+    }
+
+  memcpy (state, a, sizeof a);
+}
+
+struct sha3_lane
+{
+  /* Index of the message in this lane, or SIZE_MAX if the lane is idle.  */
+  size_t msg;
+  /* The full blocks of the message that are still to be processed.  */
+  unsigned char const *data;
+  size_t full_blocks;
+  /* The padded last block.  */
+  unsigned char tail[SHAKE128_BLOCK_SIZE];
+};
+
+/* Put message MSG, consisting of the LEN bytes at BUFFER, into lane L.  */
+static void
+sha3_lane_start (struct sha3_lane *lane, uint64_t *state, int l,
+                 size_t blocklen, size_t msg, char const *buffer, size_t len)
+{
+  size_t rest = len % blocklen;
+
+  lane->msg = msg;
+  lane->data = (unsigned char const *) buffer;
+  lane->full_blocks = len / blocklen;
+
+  if (rest > 0)
+    memcpy (lane->tail, buffer + (len - rest), rest);
+  lane->tail[rest] = 0x06;
+  memset (lane->tail + rest + 1, 0, blocklen - (rest + 1));
+  lane->tail[blocklen - 1] |= 0x80;
+
+  for (int i = 0; i < 25; i++)
+    state[i * LANES + l] = 0;
+}
+
+/* Compute the digests of DIGESTLEN bytes of the N messages BUFFERS[I] of
+   LENS[I] bytes with the rate BLOCKLEN, and store them at RESBLOCKS[I].  */
+static void
+sha3_buffers_x4 (size_t blocklen, size_t digestlen,
+                 char const *const buffers[], size_t const lens[], size_t n,
+                 void *const resblocks[])
+{
+  static unsigned char const zero_block[SHAKE128_BLOCK_SIZE];
+  alignas (32) uint64_t state[25 * LANES];
+  struct sha3_lane lane[LANES];
+  int active = 0;
+  size_t next = 0;
+
+  for (int l = 0; l < LANES; l++)
+    if (next < n)
+      {
+        sha3_lane_start (&lane[l], state, l, blocklen,
+                         next, buffers[next], lens[next]);
+        next++;
+        active++;
+      }
+    else
+      lane[l].msg = SIZE_MAX;
+
+  while (active > 0)
+    {
+      for (int l = 0; l < LANES; l++)
+        {
+          unsigned char const *block =
+            (lane[l].msg == SIZE_MAX ? zero_block
+             : lane[l].full_blocks > 0 ? lane[l].data
+             : lane[l].tail);
+          for (size_t i = 0; i < blocklen / 8; i++)
+            {
+              uint64_t w;
+              memcpy (&w, block + 8 * i, 8);
+              state[i * LANES + l] ^= w;
+            }
+        }
+
+      keccak_permute_x4 ((v4u64 *) state);
+
+      for (int l = 0; l < LANES; l++)
+        {
+          struct sha3_lane *ln = &lane[l];
+          if (ln->msg == SIZE_MAX)
+            continue;
+          if (ln->full_blocks > 0)
+            {
+              ln->data += blocklen;
+              ln->full_blocks--;
+            }
+          else
+            {
+              unsigned char *r = resblocks[ln->msg];
+              for (size_t i = 0; i < digestlen; i += 8)
+                {
+                  uint64_t w = state[i / 8 * LANES + l];
+                  memcpy (r + i, &w, digestlen - i < 8 ? digestlen - i : 8);
+                }
+              if (next < n)
+                {
+                  sha3_lane_start (ln, state, l, blocklen,
+                                   next, buffers[next], lens[next]);
+                  next++;
+                }
+              else
+                {
+                  ln->msg = SIZE_MAX;
+                  active--;
+                }
+            }
+        }
+    }
+}
+
+/* Whether the CPU supports AVX2.  */
+static bool avx2_enabled;
+static bool avx2_checked = false;
+
+static bool
+use_avx2 (void)
+{
+  if (!avx2_checked)
+    {
+      avx2_enabled = cpu_supports ("avx2");
+      avx2_checked = true;
+    }
+  return avx2_enabled;
+}
+
+#endif
+
+#if GL_DIGEST_BUFFERS_X86_64 && !HAVE_OPENSSL_SHA3
+# define DEFINE_SHA3_BUFFERS(SIZE)                                      \
+  void                                                                  \
+  sha3_##SIZE##_buffers (char const *const buffers[],                   \
+                         size_t const lens[], size_t n,                 \
+                         void *const resblocks[])                       \
+  {                                                                     \
+    if (n > 1 && use_avx2 ())                                           \
+      sha3_buffers_x4 (SHA3_##SIZE##_BLOCK_SIZE,                        \
+                       SHA3_##SIZE##_DIGEST_SIZE,                       \
+                       buffers, lens, n, resblocks);                    \
+    else                                                                \
+      for (size_t i = 0; i < n; i++)                                    \
+        sha3_##SIZE##_buffer (buffers[i], lens[i], resblocks[i]);       \
+  }
+#else
+# define DEFINE_SHA3_BUFFERS(SIZE)                                      \
+  void                                                                  \
+  sha3_##SIZE##_buffers (char const *const buffers[],                   \
+                         size_t const lens[], size_t n,                 \
+                         void *const resblocks[])                       \
+  {                                                                     \
+    for (size_t i = 0; i < n; i++)                                      \
+      sha3_##SIZE##_buffer (buffers[i], lens[i], resblocks[i]);         \
+  }
+#endif
+
+DEFINE_SHA3_BUFFERS (224)
+DEFINE_SHA3_BUFFERS (256)
+DEFINE_SHA3_BUFFERS (384)
+DEFINE_SHA3_BUFFERS (512)
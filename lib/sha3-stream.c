@@ -27,6 +27,10 @@
 # include "unlocked-io.h"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+# include "digest-readahead.h"
+#endif
+
 #if GNULIB_AF_ALG
 # include "af_alg.h"
 #endif
@@ -37,6 +41,14 @@
 # error "invalid BLOCKSIZE"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+static bool
+process_bytes (void const *buffer, size_t len, void *ctx)
+{
+  return sha3_process_bytes (buffer, len, ctx);
+}
+#endif
+
 /* Compute message digest for bytes read from STREAM using algorithm ALG.
    Write the message digest into RESBLOCK, which contains HASHLEN bytes.
    The initial operation is INIT_CTX.  Return zero if and only if
@@ -54,17 +66,35 @@ sha3_xxx_stream (FILE *restrict stream, char const *restrict alg,
     }
 #endif
 
-  char *buffer = malloc (BLOCKSIZE);
-  if (!buffer)
-    return 1;
-
   struct sha3_ctx ctx;
   if (! init_ctx (&ctx))
     {
-      free (buffer);
       sha3_free_ctx (&ctx);
       return 1;
     }
+
+#if GNULIB_DIGEST_READAHEAD
+  switch (digest_readahead (stream, process_bytes, &ctx))
+    {
+    case 0:
+      {
+        bool ok = sha3_finish_ctx (&ctx, resblock) != NULL;
+        sha3_free_ctx (&ctx);
+        return !ok;
+      }
+    case 1:
+      sha3_free_ctx (&ctx);
+      return 1;
+    }
+#endif
+
+  char *buffer = malloc (BLOCKSIZE);
+  if (!buffer)
+    {
+      sha3_free_ctx (&ctx);
+      return 1;
+    }
+
   size_t sum;
 
   /* Iterate over full file contents.  */
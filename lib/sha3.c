@@ -49,6 +49,8 @@ static const u64 rc[] = {
   u64init (0x00000000, 0x80000001), u64init (0x80000000, 0x80008008)
 };
 
+static void keccak_permute (u64 *a);
+
 #define DEFINE_SHA3_INIT_CTX(SIZE)                                      \
   bool                                                                  \
   sha3_##SIZE##_init_ctx (struct sha3_ctx *ctx)                         \
@@ -57,6 +59,7 @@ static const u64 rc[] = {
     ctx->buflen = 0;                                                    \
     ctx->digestlen = SHA3_##SIZE##_DIGEST_SIZE;                         \
     ctx->blocklen = SHA3_##SIZE##_BLOCK_SIZE;                           \
+    ctx->squeezing = false;                                             \
     return true;                                                        \
   }
 
@@ -65,6 +68,21 @@ DEFINE_SHA3_INIT_CTX (256)
 DEFINE_SHA3_INIT_CTX (384)
 DEFINE_SHA3_INIT_CTX (512)
 
+#define DEFINE_SHAKE_INIT_CTX(SIZE)                                     \
+  bool                                                                  \
+  shake##SIZE##_init_ctx (struct sha3_ctx *ctx)                         \
+  {                                                                     \
+    memset (&ctx->state, '\0', sizeof ctx->state);                      \
+    ctx->buflen = 0;                                                    \
+    ctx->digestlen = 0;                                                 \
+    ctx->blocklen = SHAKE##SIZE##_BLOCK_SIZE;                           \
+    ctx->squeezing = false;                                             \
+    return true;                                                        \
+  }
+
+DEFINE_SHAKE_INIT_CTX (128)
+DEFINE_SHAKE_INIT_CTX (256)
+
 void
 sha3_free_ctx (_GL_UNUSED struct sha3_ctx *ctx)
 {
@@ -119,6 +137,49 @@ sha3_finish_ctx (struct sha3_ctx *restrict ctx, void *restrict resbuf)
   return sha3_read_ctx (ctx, resbuf);
 }
 
+void *
+shake_squeeze (struct sha3_ctx *restrict ctx, void *restrict resbuf,
+               size_t len)
+{
+  if (!ctx->squeezing)
+    {
+      /* Pad with the SHAKE domain separation bits 1111 and pad10*1.  */
+      ctx->buffer[ctx->buflen++] = 0x1F;
+      memset (ctx->buffer + ctx->buflen, '\0', ctx->blocklen - ctx->buflen);
+      ctx->buffer[ctx->blocklen - 1] |= 0x80;
+      sha3_process_block (ctx->buffer, ctx->blocklen, ctx);
+      ctx->buflen = 0;
+      ctx->squeezing = true;
+    }
+
+  char *r = resbuf;
+  while (0 < len)
+    {
+      if (ctx->buflen == ctx->blocklen)
+        {
+          keccak_permute (ctx->state);
+          ctx->buflen = 0;
+        }
+
+      size_t i = ctx->buflen;
+      size_t end = i + (len < ctx->blocklen - i ? len : ctx->blocklen - i);
+      for (; i < end && i % sizeof *ctx->state != 0; i++)
+        *r++ = u64getlo (u64shr (ctx->state[i / 8], i % 8 * 8)) & 0xFF;
+      for (; i + sizeof *ctx->state <= end; i += sizeof *ctx->state)
+        {
+          set_uint64 (r, SWAP (ctx->state[i / 8]));
+          r += sizeof *ctx->state;
+        }
+      for (; i < end; i++)
+        *r++ = u64getlo (u64shr (ctx->state[i / 8], i % 8 * 8)) & 0xFF;
+
+      len -= end - ctx->buflen;
+      ctx->buflen = end;
+    }
+
+  return resbuf;
+}
+
 #define DEFINE_SHA3_BUFFER(SIZE)                                        \
   void *                                                                \
   sha3_##SIZE##_buffer (char const *restrict buffer, size_t len,        \
@@ -135,6 +196,20 @@ DEFINE_SHA3_BUFFER (256)
 DEFINE_SHA3_BUFFER (384)
 DEFINE_SHA3_BUFFER (512)
 
+#define DEFINE_SHAKE_BUFFER(SIZE)                                       \
+  void *                                                                \
+  shake##SIZE##_buffer (char const *restrict buffer, size_t len,        \
+                        void *restrict resblock, size_t outlen)         \
+  {                                                                     \
+    struct sha3_ctx ctx;                                                \
+    shake##SIZE##_init_ctx (&ctx);                                      \
+    sha3_process_bytes (buffer, len, &ctx);                             \
+    return shake_squeeze (&ctx, resblock, outlen);                      \
+  }
+
+DEFINE_SHAKE_BUFFER (128)
+DEFINE_SHAKE_BUFFER (256)
+
 bool
 sha3_process_bytes (void const *restrict buffer, size_t len,
                     struct sha3_ctx *restrict ctx)
@@ -182,153 +257,160 @@ sha3_process_block (void const *restrict buffer, size_t len,
     {
       for (size_t i = 0; i < ctx->blocklen / sizeof *ctx->state; ++i, ++words)
         ctx->state[i] = u64xor (ctx->state[i], SWAP (*words));
-      for (int i = 0; i < 24; ++i)
+      keccak_permute (a);
+    }
+  return true;
+}
+
+/* Apply the Keccak-f[1600] permutation to the state A.  */
+static void
+keccak_permute (u64 *a)
+{
+  for (int i = 0; i < 24; ++i)
+    {
+      u64 c[5];
+      u64 d[5];
+      u64 t1;
+      u64 t2;
+
+      /* Theta step 1.  */
+      c[0] = u64xor (u64xor (u64xor (u64xor (a[0], a[5]), a[10]),
+                             a[15]), a[20]);
+      c[1] = u64xor (u64xor (u64xor (u64xor (a[1], a[6]), a[11]),
+                             a[16]), a[21]);
+      c[2] = u64xor (u64xor (u64xor (u64xor (a[2], a[7]), a[12]),
+                             a[17]), a[22]);
+      c[3] = u64xor (u64xor (u64xor (u64xor (a[3], a[8]), a[13]),
+                             a[18]), a[23]);
+      c[4] = u64xor (u64xor (u64xor (u64xor (a[4], a[9]), a[14]),
+                             a[19]), a[24]);
+
+      /* Theta step 2.  */
+      d[0] = u64xor (c[4], u64rol (c[1], 1));
+      d[1] = u64xor (c[0], u64rol (c[2], 1));
+      d[2] = u64xor (c[1], u64rol (c[3], 1));
+      d[3] = u64xor (c[2], u64rol (c[4], 1));
+      d[4] = u64xor (c[3], u64rol (c[0], 1));
+
+      /* Theta step 3.  */
+      a[0] = u64xor (a[0], d[0]);
+      a[5] = u64xor (a[5], d[0]);
+      a[10] = u64xor (a[10], d[0]);
+      a[15] = u64xor (a[15], d[0]);
+      a[20] = u64xor (a[20], d[0]);
+      a[1] = u64xor (a[1], d[1]);
+      a[6] = u64xor (a[6], d[1]);
+      a[11] = u64xor (a[11], d[1]);
+      a[16] = u64xor (a[16], d[1]);
+      a[21] = u64xor (a[21], d[1]);
+      a[2] = u64xor (a[2], d[2]);
+      a[7] = u64xor (a[7], d[2]);
+      a[12] = u64xor (a[12], d[2]);
+      a[17] = u64xor (a[17], d[2]);
+      a[22] = u64xor (a[22], d[2]);
+      a[3] = u64xor (a[3], d[3]);
+      a[8] = u64xor (a[8], d[3]);
+      a[13] = u64xor (a[13], d[3]);
+      a[18] = u64xor (a[18], d[3]);
+      a[23] = u64xor (a[23], d[3]);
+      a[4] = u64xor (a[4], d[4]);
+      a[9] = u64xor (a[9], d[4]);
+      a[14] = u64xor (a[14], d[4]);
+      a[19] = u64xor (a[19], d[4]);
+      a[24] = u64xor (a[24], d[4]);
+
+      /* Rho and Pi.  */
+      t1 = a[1];
+      t2 = u64rol (t1, 1);
+      t1 = a[10];
+      a[10] = t2;
+      t2 = u64rol (t1, 3);
+      t1 = a[7];
+      a[7] = t2;
+      t2 = u64rol (t1, 6);
+      t1 = a[11];
+      a[11] = t2;
+      t2 = u64rol (t1, 10);
+      t1 = a[17];
+      a[17] = t2;
+      t2 = u64rol (t1, 15);
+      t1 = a[18];
+      a[18] = t2;
+      t2 = u64rol (t1, 21);
+      t1 = a[3];
+      a[3] = t2;
+      t2 = u64rol (t1, 28);
+      t1 = a[5];
+      a[5] = t2;
+      t2 = u64rol (t1, 36);
+      t1 = a[16];
+      a[16] = t2;
+      t2 = u64rol (t1, 45);
+      t1 = a[8];
+      a[8] = t2;
+      t2 = u64rol (t1, 55);
+      t1 = a[21];
+      a[21] = t2;
+      t2 = u64rol (t1, 2);
+      t1 = a[24];
+      a[24] = t2;
+      t2 = u64rol (t1, 14);
+      t1 = a[4];
+      a[4] = t2;
+      t2 = u64rol (t1, 27);
+      t1 = a[15];
+      a[15] = t2;
+      t2 = u64rol (t1, 41);
+      t1 = a[23];
+      a[23] = t2;
+      t2 = u64rol (t1, 56);
+      t1 = a[19];
+      a[19] = t2;
+      t2 = u64rol (t1, 8);
+      t1 = a[13];
+      a[13] = t2;
+      t2 = u64rol (t1, 25);
+      t1 = a[12];
+      a[12] = t2;
+      t2 = u64rol (t1, 43);
+      t1 = a[2];
+      a[2] = t2;
+      t2 = u64rol (t1, 62);
+      t1 = a[20];
+      a[20] = t2;
+      t2 = u64rol (t1, 18);
+      t1 = a[14];
+      a[14] = t2;
+      t2 = u64rol (t1, 39);
+      t1 = a[22];
+      a[22] = t2;
+      t2 = u64rol (t1, 61);
+      t1 = a[9];
+      a[9] = t2;
+      t2 = u64rol (t1, 20);
+      t1 = a[6];
+      a[6] = t2;
+      t2 = u64rol (t1, 44);
+      t1 = a[1];
+      a[1] = t2;
+
+      /* Chi.  */
+      for (int j = 0; j < 25; j += 5)
         {
-          u64 c[5];
-          u64 d[5];
-          u64 t1;
-          u64 t2;
-
-          /* Theta step 1.  */
-          c[0] = u64xor (u64xor (u64xor (u64xor (a[0], a[5]), a[10]),
-                                 a[15]), a[20]);
-          c[1] = u64xor (u64xor (u64xor (u64xor (a[1], a[6]), a[11]),
-                                 a[16]), a[21]);
-          c[2] = u64xor (u64xor (u64xor (u64xor (a[2], a[7]), a[12]),
-                                 a[17]), a[22]);
-          c[3] = u64xor (u64xor (u64xor (u64xor (a[3], a[8]), a[13]),
-                                 a[18]), a[23]);
-          c[4] = u64xor (u64xor (u64xor (u64xor (a[4], a[9]), a[14]),
-                                 a[19]), a[24]);
-
-          /* Theta step 2.  */
-          d[0] = u64xor (c[4], u64rol (c[1], 1));
-          d[1] = u64xor (c[0], u64rol (c[2], 1));
-          d[2] = u64xor (c[1], u64rol (c[3], 1));
-          d[3] = u64xor (c[2], u64rol (c[4], 1));
-          d[4] = u64xor (c[3], u64rol (c[0], 1));
-
-          /* Theta step 3.  */
-          a[0] = u64xor (a[0], d[0]);
-          a[5] = u64xor (a[5], d[0]);
-          a[10] = u64xor (a[10], d[0]);
-          a[15] = u64xor (a[15], d[0]);
-          a[20] = u64xor (a[20], d[0]);
-          a[1] = u64xor (a[1], d[1]);
-          a[6] = u64xor (a[6], d[1]);
-          a[11] = u64xor (a[11], d[1]);
-          a[16] = u64xor (a[16], d[1]);
-          a[21] = u64xor (a[21], d[1]);
-          a[2] = u64xor (a[2], d[2]);
-          a[7] = u64xor (a[7], d[2]);
-          a[12] = u64xor (a[12], d[2]);
-          a[17] = u64xor (a[17], d[2]);
-          a[22] = u64xor (a[22], d[2]);
-          a[3] = u64xor (a[3], d[3]);
-          a[8] = u64xor (a[8], d[3]);
-          a[13] = u64xor (a[13], d[3]);
-          a[18] = u64xor (a[18], d[3]);
-          a[23] = u64xor (a[23], d[3]);
-          a[4] = u64xor (a[4], d[4]);
-          a[9] = u64xor (a[9], d[4]);
-          a[14] = u64xor (a[14], d[4]);
-          a[19] = u64xor (a[19], d[4]);
-          a[24] = u64xor (a[24], d[4]);
-
-          /* Rho and Pi.  */
-          t1 = a[1];
-          t2 = u64rol (t1, 1);
-          t1 = a[10];
-          a[10] = t2;
-          t2 = u64rol (t1, 3);
-          t1 = a[7];
-          a[7] = t2;
-          t2 = u64rol (t1, 6);
-          t1 = a[11];
-          a[11] = t2;
-          t2 = u64rol (t1, 10);
-          t1 = a[17];
-          a[17] = t2;
-          t2 = u64rol (t1, 15);
-          t1 = a[18];
-          a[18] = t2;
-          t2 = u64rol (t1, 21);
-          t1 = a[3];
-          a[3] = t2;
-          t2 = u64rol (t1, 28);
-          t1 = a[5];
-          a[5] = t2;
-          t2 = u64rol (t1, 36);
-          t1 = a[16];
-          a[16] = t2;
-          t2 = u64rol (t1, 45);
-          t1 = a[8];
-          a[8] = t2;
-          t2 = u64rol (t1, 55);
-          t1 = a[21];
-          a[21] = t2;
-          t2 = u64rol (t1, 2);
-          t1 = a[24];
-          a[24] = t2;
-          t2 = u64rol (t1, 14);
-          t1 = a[4];
-          a[4] = t2;
-          t2 = u64rol (t1, 27);
-          t1 = a[15];
-          a[15] = t2;
-          t2 = u64rol (t1, 41);
-          t1 = a[23];
-          a[23] = t2;
-          t2 = u64rol (t1, 56);
-          t1 = a[19];
-          a[19] = t2;
-          t2 = u64rol (t1, 8);
-          t1 = a[13];
-          a[13] = t2;
-          t2 = u64rol (t1, 25);
-          t1 = a[12];
-          a[12] = t2;
-          t2 = u64rol (t1, 43);
-          t1 = a[2];
-          a[2] = t2;
-          t2 = u64rol (t1, 62);
-          t1 = a[20];
-          a[20] = t2;
-          t2 = u64rol (t1, 18);
-          t1 = a[14];
-          a[14] = t2;
-          t2 = u64rol (t1, 39);
-          t1 = a[22];
-          a[22] = t2;
-          t2 = u64rol (t1, 61);
-          t1 = a[9];
-          a[9] = t2;
-          t2 = u64rol (t1, 20);
-          t1 = a[6];
-          a[6] = t2;
-          t2 = u64rol (t1, 44);
-          t1 = a[1];
-          a[1] = t2;
-
-          /* Chi.  */
-          for (int j = 0; j < 25; j += 5)
-            {
-              t1 = a[j];
-              t2 = a[j + 1];
-              a[j] = u64xor (a[j], u64and (u64not (a[j + 1]), a[j + 2]));
-              a[j + 1] = u64xor (a[j + 1], u64and (u64not (a[j + 2]),
-                                                   a[j + 3]));
-              a[j + 2] = u64xor (a[j + 2], u64and (u64not (a[j + 3]),
-                                                   a[j + 4]));
-              a[j + 3] = u64xor (a[j + 3], u64and (u64not (a[j + 4]), t1));
-              a[j + 4] = u64xor (a[j + 4], u64and (u64not (t1), t2));
-            }
-
-          /* Iota.  */
-          a[0] = u64xor (a[0], rc[i]);
+          t1 = a[j];
+          t2 = a[j + 1];
+          a[j] = u64xor (a[j], u64and (u64not (a[j + 1]), a[j + 2]));
+          a[j + 1] = u64xor (a[j + 1], u64and (u64not (a[j + 2]),
+                                               a[j + 3]));
+          a[j + 2] = u64xor (a[j + 2], u64and (u64not (a[j + 3]),
+                                               a[j + 4]));
+          a[j + 3] = u64xor (a[j + 3], u64and (u64not (a[j + 4]), t1));
+          a[j + 4] = u64xor (a[j + 4], u64and (u64not (t1), t2));
         }
+
+      /* Iota.  */
+      a[0] = u64xor (a[0], rc[i]);
     }
-  return true;
 }
 
 #else /* OpenSSL implementation.  */
@@ -356,6 +438,24 @@ DEFINE_SHA3_INIT_CTX (256)
 DEFINE_SHA3_INIT_CTX (384)
 DEFINE_SHA3_INIT_CTX (512)
 
+#define DEFINE_SHAKE_INIT_CTX(SIZE)                                     \
+  bool                                                                  \
+  shake##SIZE##_init_ctx (struct sha3_ctx *ctx)                         \
+  {                                                                     \
+    EVP_MD_CTX *evp_ctx = EVP_MD_CTX_new ();                            \
+    if (evp_ctx && ! EVP_DigestInit_ex (evp_ctx, EVP_shake##SIZE (), NULL)) \
+      {                                                                 \
+        EVP_MD_CTX_free (evp_ctx);                                      \
+        evp_ctx = NULL;                                                 \
+      }                                                                 \
+    ctx->evp_ctx = evp_ctx;                                             \
+    errno = ENOMEM;  /* OK to set errno even if successful.  */         \
+    return !!evp_ctx;                                                   \
+  }
+
+DEFINE_SHAKE_INIT_CTX (128)
+DEFINE_SHAKE_INIT_CTX (256)
+
 void
 sha3_free_ctx (struct sha3_ctx *ctx)
 {
@@ -419,6 +519,40 @@ DEFINE_SHA3_BUFFER (256)
 DEFINE_SHA3_BUFFER (384)
 DEFINE_SHA3_BUFFER (512)
 
+void *
+shake_squeeze (struct sha3_ctx *restrict ctx, void *restrict resbuf,
+               size_t len)
+{
+#if HAVE_EVP_DIGESTSQUEEZE
+  int result = EVP_DigestSqueeze (ctx->evp_ctx, resbuf, len);
+#else
+  int result = EVP_DigestFinalXOF (ctx->evp_ctx, resbuf, len);
+#endif
+  if (result == 0)
+    {
+      errno = EINVAL;
+      return NULL;
+    }
+  return resbuf;
+}
+
+#define DEFINE_SHAKE_BUFFER(SIZE)                                       \
+  void *                                                                \
+  shake##SIZE##_buffer (char const *restrict buffer, size_t len,        \
+                        void *restrict resblock, size_t outlen)         \
+  {                                                                     \
+    struct sha3_ctx ctx;                                                \
+    void *result = ((shake##SIZE##_init_ctx (&ctx)                      \
+                     && sha3_process_bytes (buffer, len, &ctx))         \
+                    ? shake_squeeze (&ctx, resblock, outlen)            \
+                    : NULL);                                            \
+    sha3_free_ctx (&ctx);                                               \
+    return result;                                                      \
+  }
+
+DEFINE_SHAKE_BUFFER (128)
+DEFINE_SHAKE_BUFFER (256)
+
 bool
 sha3_process_bytes (void const *restrict buffer, size_t len,
                     struct sha3_ctx *restrict ctx)
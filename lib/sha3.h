@@ -46,6 +46,8 @@ enum { SHA3_224_BLOCK_SIZE = 1152 / 8 };
 enum { SHA3_256_BLOCK_SIZE = 1088 / 8 };
 enum { SHA3_384_BLOCK_SIZE = 832 / 8 };
 enum { SHA3_512_BLOCK_SIZE = 576 / 8 };
+enum { SHAKE128_BLOCK_SIZE = 1344 / 8 };
+enum { SHAKE256_BLOCK_SIZE = 1088 / 8 };
 
 /* Structure to save state of computation between the single steps.  */
 struct sha3_ctx
@@ -55,10 +57,15 @@ struct sha3_ctx
   EVP_MD_CTX *evp_ctx;
 # else
   u64 state[25];
-  uint8_t buffer[144]; /* Up to BLOCKLEN in use.  */
-  size_t buflen;       /* ≥ 0, ≤ BLOCKLEN  */
-  size_t digestlen;    /* One of SHA3_{224,256,384,512}_DIGEST_SIZE.  */
-  size_t blocklen;     /* One of SHA3_{224,256,384,512}_BLOCK_SIZE.  */
+  uint8_t buffer[168]; /* Up to BLOCKLEN in use.  */
+  size_t buflen;       /* ≥ 0, ≤ BLOCKLEN.  While squeezing, the number of
+                          bytes of the current output block already
+                          returned.  */
+  size_t digestlen;    /* One of SHA3_{224,256,384,512}_DIGEST_SIZE,
+                          or 0 for SHAKE.  */
+  size_t blocklen;     /* One of SHA3_{224,256,384,512}_BLOCK_SIZE or
+                          SHAKE{128,256}_BLOCK_SIZE.  */
+  bool squeezing;      /* True once SHAKE output has been requested.  */
 # endif
 };
 
@@ -68,6 +75,13 @@ extern bool sha3_256_init_ctx (struct sha3_ctx *ctx);
 extern bool sha3_384_init_ctx (struct sha3_ctx *ctx);
 extern bool sha3_512_init_ctx (struct sha3_ctx *ctx);
 
+/* Initialize structure containing state of computation of the SHAKE128 or
+   SHAKE256 extendable-output function.  Feed it with sha3_process_bytes or
+   sha3_process_block, and get output with shake_squeeze, not with
+   sha3_finish_ctx or sha3_read_ctx.  */
+extern bool shake128_init_ctx (struct sha3_ctx *ctx);
+extern bool shake256_init_ctx (struct sha3_ctx *ctx);
+
 /* Free memory allocated by the init_structure.  */
 extern void sha3_free_ctx (struct sha3_ctx *ctx);
 
@@ -101,6 +115,16 @@ extern void *sha3_finish_ctx (struct sha3_ctx *restrict ctx,
 extern void *sha3_read_ctx (struct sha3_ctx const *restrict ctx,
                             void *restrict resbuf);
 
+/* Finish the input of the SHAKE computation in CTX, if not yet done, and
+   put its next LEN output bytes in RESBUF.  This function can be called
+   repeatedly, to get as many output bytes as needed; the concatenation of
+   the results does not depend on how the output is split into calls.
+   After the first call, no more input can be added to CTX.
+   When OpenSSL before version 3.3 is used, only a single call is supported.
+   Return NULL if an OpenSSL function fails.  */
+extern void *shake_squeeze (struct sha3_ctx *restrict ctx,
+                            void *restrict resbuf, size_t len);
+
 /* Compute a SHA-3 message digest for LEN bytes beginning at BUFFER.
    The result is always in little endian byte order, so that a byte-wise
    output yields to the wanted ASCII representation of the message
@@ -115,6 +139,14 @@ extern void *sha3_384_buffer (char const *restrict buffer, size_t len,
 extern void *sha3_512_buffer (char const *restrict buffer, size_t len,
                               void *restrict resblock);
 
+/* Compute OUTLEN bytes of SHAKE128 or SHAKE256 output for LEN bytes
+   beginning at BUFFER, and put them in RESBLOCK.
+   Return NULL if an OpenSSL function fails.  */
+extern void *shake128_buffer (char const *restrict buffer, size_t len,
+                              void *restrict resblock, size_t outlen);
+extern void *shake256_buffer (char const *restrict buffer, size_t len,
+                              void *restrict resblock, size_t outlen);
+
 /* Compute SHA-3 message digest for bytes read from STREAM.  STREAM is an open
    file stream.  Regular files are handled more efficiently.  The contents of
    STREAM from its current position to its end will be read.  The case that the
@@ -125,6 +157,25 @@ extern int sha3_256_stream (FILE *restrict stream, void *restrict resblock);
 extern int sha3_384_stream (FILE *restrict stream, void *restrict resblock);
 extern int sha3_512_stream (FILE *restrict stream, void *restrict resblock);
 
+/* Compute SHA-3 message digests of N independent memory blocks.  For each
+   I < N, the digest of the LENS[I] bytes beginning at BUFFERS[I] is written
+   into the memory beginning at RESBLOCKS[I].  The results are the same as
+   those of the corresponding sha3_*_buffer function, but the messages are
+   hashed in parallel where the CPU allows it, which is considerably faster
+   for many messages.  */
+extern void sha3_224_buffers (char const *const buffers[],
+                              size_t const lens[], size_t n,
+                              void *const resblocks[]);
+extern void sha3_256_buffers (char const *const buffers[],
+                              size_t const lens[], size_t n,
+                              void *const resblocks[]);
+extern void sha3_384_buffers (char const *const buffers[],
+                              size_t const lens[], size_t n,
+                              void *const resblocks[]);
+extern void sha3_512_buffers (char const *const buffers[],
+                              size_t const lens[], size_t n,
+                              void *const resblocks[]);
+
 # ifdef __cplusplus
 }
 # endif
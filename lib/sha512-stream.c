@@ -31,6 +31,10 @@
 # include "unlocked-io.h"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+# include "digest-readahead.h"
+#endif
+
 #if GNULIB_AF_ALG
 # include "af_alg.h"
 #endif
@@ -40,6 +44,15 @@
 # error "invalid BLOCKSIZE"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+static bool
+process_bytes (void const *buffer, size_t len, void *ctx)
+{
+  sha512_process_bytes (buffer, len, ctx);
+  return true;
+}
+#endif
+
 /* Compute message digest for bytes read from STREAM using algorithm ALG.
    Write the message digest into RESBLOCK, which contains HASHLEN bytes.
    The initial and finishing operations are INIT_CTX and FINISH_CTX.
@@ -59,12 +72,24 @@ shaxxx_stream (FILE *restrict stream, char const *restrict alg,
     }
 #endif
 
+  struct sha512_ctx ctx;
+  init_ctx (&ctx);
+
+#if GNULIB_DIGEST_READAHEAD
+  switch (digest_readahead (stream, process_bytes, &ctx))
+    {
+    case 0:
+      finish_ctx (&ctx, resblock);
+      return 0;
+    case 1:
+      return 1;
+    }
+#endif
+
   char *buffer = malloc (BLOCKSIZE);
   if (!buffer)
     return 1;
 
-  struct sha512_ctx ctx;
-  init_ctx (&ctx);
   size_t sum;
 
   /* Iterate over full file contents.  */
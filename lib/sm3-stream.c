@@ -34,25 +34,49 @@
 # include "unlocked-io.h"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+# include "digest-readahead.h"
+#endif
+
 #define BLOCKSIZE 32768
 #if BLOCKSIZE % 64 != 0
 # error "invalid BLOCKSIZE"
 #endif
 
+#if GNULIB_DIGEST_READAHEAD
+static bool
+process_bytes (void const *buffer, size_t len, void *ctx)
+{
+  sm3_process_bytes (buffer, len, ctx);
+  return true;
+}
+#endif
+
 /* Compute SM3 message digest for bytes read from STREAM.  The
    resulting message digest number will be written into the 32 bytes
    beginning at RESBLOCK.  */
 int
 sm3_stream (FILE *restrict stream, void *restrict resblock)
 {
-  char *buffer = malloc (BLOCKSIZE);
-  if (!buffer)
-    return 1;
-
   /* Initialize the computation context.  */
   struct sm3_ctx ctx;
   sm3_init_ctx (&ctx);
 
+#if GNULIB_DIGEST_READAHEAD
+  switch (digest_readahead (stream, process_bytes, &ctx))
+    {
+    case 0:
+      sm3_finish_ctx (&ctx, resblock);
+      return 0;
+    case 1:
+      return 1;
+    }
+#endif
+
+  char *buffer = malloc (BLOCKSIZE);
+  if (!buffer)
+    return 1;
+
   size_t sum;
 
   /* Iterate over full file contents.  */
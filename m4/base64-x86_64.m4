@@ -0,0 +1,59 @@
+# base64-x86_64.m4
+# serial 1
+dnl Copyright (C) 2026 Free Software Foundation, Inc.
+dnl This file is free software; the Free Software Foundation
+dnl gives unlimited permission to copy and/or distribute it,
+dnl with or without modifications, as long as this notice is preserved.
+dnl This file is offered as-is, without any warranty.
+
+AC_DEFUN([gl_BASE64_X86_64],
+[
+  AC_CACHE_CHECK([if ssse3 and avx2 intrinsics exist], [gl_cv_base64_x86_64], [
+    AC_LINK_IFELSE(
+      [AC_LANG_SOURCE(
+        [[
+          #include <x86intrin.h>
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("ssse3")))
+          #endif
+          static int
+          f16 (char const *p)
+          {
+            __m128i a = _mm_loadu_si128 ((__m128i_u const *) p);
+            a = _mm_maddubs_epi16 (_mm_shuffle_epi8 (a, a), a);
+            return _mm_movemask_epi8 (a);
+          }
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("avx2")))
+          #endif
+          static int
+          f32 (char const *p)
+          {
+            __m256i a = _mm256_loadu_si256 ((__m256i_u const *) p);
+            a = _mm256_maddubs_epi16 (_mm256_shuffle_epi8 (a, a), a);
+            a = _mm256_permutevar8x32_epi32 (a, a);
+            return _mm256_testz_si256 (a, a);
+          }
+
+          int
+          main (void)
+          {
+            static char u[32];
+            return f16 (u) + f32 (u) + __builtin_cpu_supports ("avx2");
+          }
+        ]])
+      ], [
+        gl_cv_base64_x86_64=yes
+      ], [
+        gl_cv_base64_x86_64=no
+      ])
+  ])
+  if test $gl_cv_base64_x86_64 = yes; then
+    AC_DEFINE([GL_BASE64_X86_64], [1],
+              [Base64 encoding and decoding by ssse3 and avx2 instructions
+               enabled])
+  fi
+  AM_CONDITIONAL([GL_BASE64_X86_64], [test $gl_cv_base64_x86_64 = yes])
+])
@@ -1,5 +1,5 @@
 # crc-x86_64.m4
-# serial 3
+# serial 4
 dnl Copyright (C) 2024-2026 Free Software Foundation, Inc.
 dnl This file is free software; the Free Software Foundation
 dnl gives unlimited permission to copy and/or distribute it,
@@ -41,3 +41,41 @@ AC_DEFUN([gl_CRC_X86_64_PCLMUL],
   AM_CONDITIONAL([GL_CRC_X86_64_PCLMUL],
                  [test $gl_cv_crc_pclmul = yes])
 ])
+
+AC_DEFUN([gl_CRC_X86_64_VPCLMUL],
+[
+  AC_REQUIRE([gl_CRC_X86_64_PCLMUL])
+  AC_CACHE_CHECK([if vpclmulqdq intrinsic exists], [gl_cv_crc_vpclmul], [
+    AC_LINK_IFELSE(
+      [AC_LANG_SOURCE(
+        [[
+          #include <x86intrin.h>
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("vpclmulqdq,avx512f")))
+          #endif
+          int
+          main (void)
+          {
+            static char u[64];
+            __m512i a = _mm512_loadu_si512 (u);
+            __m512i b = _mm512_broadcast_i32x4 (_mm_set_epi64x (1, 2));
+            a = _mm512_clmulepi64_epi128 (a, b, 0x00);
+            a = _mm512_ternarylogic_epi64 (a, b, a, 0x96);
+            return (_mm_cvtsi128_si32 (_mm512_extracti32x4_epi32 (a, 1))
+                    + __builtin_cpu_supports ("vpclmulqdq"));
+          }
+        ]])
+      ], [
+        gl_cv_crc_vpclmul=yes
+      ], [
+        gl_cv_crc_vpclmul=no
+      ])
+  ])
+  if test $gl_cv_crc_pclmul,$gl_cv_crc_vpclmul = yes,yes; then
+    AC_DEFINE([GL_CRC_X86_64_VPCLMUL], [1],
+              [CRC32 calculation by vpclmulqdq hardware instruction enabled])
+  fi
+  AM_CONDITIONAL([GL_CRC_X86_64_VPCLMUL],
+                 [test $gl_cv_crc_pclmul,$gl_cv_crc_vpclmul = yes,yes])
+])
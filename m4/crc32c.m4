@@ -0,0 +1,42 @@
+# crc32c.m4
+# serial 1
+dnl Copyright (C) 2026 Free Software Foundation, Inc.
+dnl This file is free software; the Free Software Foundation
+dnl gives unlimited permission to copy and/or distribute it,
+dnl with or without modifications, as long as this notice is preserved.
+dnl This file is offered as-is, without any warranty.
+
+AC_DEFUN([gl_CRC32C_X86_64],
+[
+  AC_CACHE_CHECK([if crc32 and pclmul intrinsics exist], [gl_cv_crc32c_x86_64], [
+    AC_LINK_IFELSE(
+      [AC_LANG_SOURCE(
+        [[
+          #include <x86intrin.h>
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("pclmul,sse4.2")))
+          #endif
+          int
+          main (void)
+          {
+            __m128i a, b;
+            a = _mm_clmulepi64_si128 (a, b, 0x00);
+            unsigned long long c = _mm_crc32_u64 (0, _mm_extract_epi64 (a, 1));
+            c = _mm_crc32_u8 (c, 0);
+            static __m128i_u u;
+            b = _mm_loadu_si128 (&u);
+            return c + __builtin_cpu_supports ("sse4.2");
+          }
+        ]])
+      ], [
+        gl_cv_crc32c_x86_64=yes
+      ], [
+        gl_cv_crc32c_x86_64=no
+      ])
+  ])
+  if test $gl_cv_crc32c_x86_64 = yes; then
+    AC_DEFINE([GL_CRC32C_X86_64], [1],
+              [CRC32C calculation by crc32 and pclmul hardware instructions enabled])
+  fi
+])
@@ -0,0 +1,61 @@
+# digest-buffers.m4
+# serial 1
+dnl Copyright (C) 2026 Free Software Foundation, Inc.
+dnl This file is free software; the Free Software Foundation
+dnl gives unlimited permission to copy and/or distribute it,
+dnl with or without modifications, as long as this notice is preserved.
+dnl This file is offered as-is, without any warranty.
+
+dnl Check whether the multi-buffer message digest functions can use
+dnl SSE2 and AVX2 through GCC vector extensions.
+AC_DEFUN([gl_DIGEST_BUFFERS_X86_64],
+[
+  AC_CACHE_CHECK([if SSE2 and AVX2 vector extensions work],
+    [gl_cv_digest_buffers_x86_64], [
+    AC_LINK_IFELSE(
+      [AC_LANG_SOURCE(
+        [[
+          #if !(defined __x86_64__ || defined __i386__)
+          #error "not x86"
+          #endif
+          #include <stdint.h>
+          typedef uint32_t v4u32 __attribute__ ((__vector_size__ (16)));
+          typedef uint32_t v8u32 __attribute__ ((__vector_size__ (32)));
+
+          __attribute__ ((__target__ ("sse2")))
+          static void
+          f4 (uint32_t *p)
+          {
+            v4u32 v = *(v4u32 *) p;
+            *(v4u32 *) p = ((v << 7) | (v >> 25)) + p[0];
+          }
+
+          __attribute__ ((__target__ ("avx2")))
+          static void
+          f8 (uint32_t *p)
+          {
+            v8u32 v = *(v8u32 *) p;
+            *(v8u32 *) p = ((v << 7) | (v >> 25)) ^ ~v;
+          }
+
+          int
+          main (void)
+          {
+            static uint32_t a[8] __attribute__ ((__aligned__ (32)));
+            f4 (a);
+            f8 (a);
+            return __builtin_cpu_supports ("avx2");
+          }
+        ]])
+      ], [
+        gl_cv_digest_buffers_x86_64=yes
+      ], [
+        gl_cv_digest_buffers_x86_64=no
+      ])
+  ])
+  if test $gl_cv_digest_buffers_x86_64 = yes; then
+    AC_DEFINE([GL_DIGEST_BUFFERS_X86_64], [1],
+              [Define to 1 if multi-buffer message digests can use SSE2
+               and AVX2.])
+  fi
+])
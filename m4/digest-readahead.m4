@@ -0,0 +1,13 @@
+# digest-readahead.m4
+# serial 1
+dnl Copyright (C) 2026 Free Software Foundation, Inc.
+dnl This file is free software; the Free Software Foundation
+dnl gives unlimited permission to copy and/or distribute it,
+dnl with or without modifications, as long as this notice is preserved.
+dnl This file is offered as-is, without any warranty.
+
+AC_DEFUN([gl_DIGEST_READAHEAD],
+[
+  dnl Prerequisites of lib/digest-readahead.c.
+  AC_CHECK_FUNCS_ONCE([posix_fadvise])
+])
@@ -0,0 +1,48 @@
+# rijndael-x86_64.m4
+# serial 1
+dnl Copyright (C) 2026 Free Software Foundation, Inc.
+dnl This file is free software; the Free Software Foundation
+dnl gives unlimited permission to copy and/or distribute it,
+dnl with or without modifications, as long as this notice is preserved.
+dnl This file is offered as-is, without any warranty.
+
+AC_DEFUN([gl_RIJNDAEL_X86_64],
+[
+  AC_CACHE_CHECK([if aes and pclmul intrinsics exist],
+    [gl_cv_rijndael_x86_64], [
+    AC_LINK_IFELSE(
+      [AC_LANG_SOURCE(
+        [[
+          #include <x86intrin.h>
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("aes,pclmul,ssse3")))
+          #endif
+          static int
+          f (char const *p)
+          {
+            __m128i a = _mm_loadu_si128 ((__m128i_u const *) p);
+            a = _mm_aesenc_si128 (_mm_shuffle_epi8 (a, a), a);
+            a = _mm_aesdeclast_si128 (a, _mm_clmulepi64_si128 (a, a, 0x10));
+            return _mm_cvtsi128_si32 (a);
+          }
+
+          int
+          main (void)
+          {
+            static char u[16];
+            return f (u) + __builtin_cpu_supports ("aes");
+          }
+        ]])
+      ], [
+        gl_cv_rijndael_x86_64=yes
+      ], [
+        gl_cv_rijndael_x86_64=no
+      ])
+  ])
+  if test $gl_cv_rijndael_x86_64 = yes; then
+    AC_DEFINE([GL_RIJNDAEL_X86_64], [1],
+              [AES by aes and pclmul instructions enabled])
+  fi
+  AM_CONDITIONAL([GL_RIJNDAEL_X86_64], [test $gl_cv_rijndael_x86_64 = yes])
+])
@@ -0,0 +1,63 @@
+# sha256-x86_64.m4
+# serial 1
+dnl Copyright (C) 2026 Free Software Foundation, Inc.
+dnl This file is free software; the Free Software Foundation
+dnl gives unlimited permission to copy and/or distribute it,
+dnl with or without modifications, as long as this notice is preserved.
+dnl This file is offered as-is, without any warranty.
+
+AC_DEFUN([gl_SHA256_X86_64],
+[
+  AC_CACHE_CHECK([if SHA and AVX2 intrinsics exist], [gl_cv_sha256_x86_64], [
+    AC_LINK_IFELSE(
+      [AC_LANG_SOURCE(
+        [[
+          #include <x86intrin.h>
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("sha,sse4.1")))
+          #endif
+          static __m128i
+          shani (__m128i a, __m128i b, __m128i c)
+          {
+            a = _mm_sha256rnds2_epu32 (a, b, c);
+            a = _mm_sha256msg1_epu32 (a, b);
+            a = _mm_sha256msg2_epu32 (a, b);
+            return _mm_blend_epi16 (a, b, 0xF0);
+          }
+
+          #if defined __GNUC__ || defined __clang__
+          __attribute__ ((__target__ ("avx2,bmi2")))
+          #endif
+          static __m256i
+          avx2 (__m128i a, __m128i b)
+          {
+            __m256i c = _mm256_inserti128_si256 (_mm256_castsi128_si256 (a),
+                                                 b, 1);
+            return _mm256_alignr_epi8 (c, c, 4);
+          }
+
+          int
+          main (void)
+          {
+            static __m128i_u u;
+            __m128i a = _mm_loadu_si128 (&u);
+            a = shani (a, a, a);
+            avx2 (a, a);
+            return __builtin_cpu_supports ("sha")
+                   + __builtin_cpu_supports ("bmi2");
+          }
+        ]])
+      ], [
+        gl_cv_sha256_x86_64=yes
+      ], [
+        gl_cv_sha256_x86_64=no
+      ])
+  ])
+  if test $gl_cv_sha256_x86_64 = yes; then
+    AC_DEFINE([GL_SHA256_X86_64], [1],
+              [SHA-256 calculation by SHA and AVX2 instructions enabled])
+  fi
+  AM_CONDITIONAL([GL_SHA256_X86_64],
+                 [test $gl_cv_sha256_x86_64 = yes])
+])
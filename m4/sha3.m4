@@ -1,5 +1,5 @@
 # sha3.m4
-# serial 1
+# serial 2
 dnl Copyright (C) 2025-2026 Free Software Foundation, Inc.
 dnl This file is free software; the Free Software Foundation
 dnl gives unlimited permission to copy and/or distribute it,
@@ -13,4 +13,13 @@ AC_DEFUN([gl_SHA3],
 
   dnl Determine HAVE_OPENSSL_SHA3 and LIB_CRYPTO
   gl_CRYPTO_CHECK([SHA3])
+
+  dnl Determine whether libcrypto can squeeze SHAKE output repeatedly
+  dnl (OpenSSL 3.3 or newer).
+  if test "x$ac_cv_lib_crypto_EVP_sha3_224" = xyes; then
+    gl_saved_LIBS=$LIBS
+    LIBS="$LIB_CRYPTO $LIBS"
+    AC_CHECK_FUNCS([EVP_DigestSqueeze])
+    LIBS=$gl_saved_LIBS
+  fi
 ])
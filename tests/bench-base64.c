@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for base64_encode and base64_decode_ctx.
+
+   A buffer of SIZE bytes (by default, the 4 KiB of randomb) is encoded,
+   and then decoded, once as a single line and once wrapped in lines of
+   76 characters, as in MIME.  */
+
+#include <config.h>
+
+#include "base64.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "macros.h"
+
+int
+main (int argc, char *argv[])
+{
+  if (!(argc == 2 || argc == 3))
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS [SIZE]\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  idx_t size = argc == 3 ? atol (argv[2]) : sizeof randomb;
+  idx_t b64size = BASE64_LENGTH (size);
+  idx_t wrapped_size = b64size + b64size / 76;
+
+  char *buf = malloc (size);
+  char *b64 = malloc (b64size);
+  char *wrapped = malloc (wrapped_size);
+  char *dec = malloc (size);
+  if (!buf || !b64 || !wrapped || !dec)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+  for (idx_t i = 0; i < size; i += sizeof randomb)
+    memcpy (buf + i, randomb,
+            size - i < sizeof randomb ? size - i : sizeof randomb);
+
+  struct timings_state ts;
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    base64_encode (buf, size, b64, b64size);
+
+  timing_end (&ts);
+  printf ("base64_encode\n");
+  timing_output (&ts);
+
+  for (idx_t i = 0, j = 0; i < b64size; i += 76)
+    {
+      idx_t n = b64size - i < 76 ? b64size - i : 76;
+      memcpy (wrapped + j, b64 + i, n);
+      j += n;
+      if (n == 76)
+        wrapped[j++] = '\n';
+    }
+
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    {
+      idx_t declen = size;
+      bool ok = base64_decode (b64, b64size, dec, &declen);
+      ASSERT (ok && declen == size);
+    }
+
+  timing_end (&ts);
+  printf ("base64_decode\n");
+  timing_output (&ts);
+
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    {
+      struct base64_decode_context ctx;
+      idx_t declen = size;
+      base64_decode_ctx_init (&ctx);
+      bool ok = base64_decode_ctx (&ctx, wrapped, wrapped_size, dec, &declen);
+      ASSERT (ok && declen == size);
+    }
+
+  timing_end (&ts);
+  printf ("base64_decode_ctx, 76 character lines\n");
+  timing_output (&ts);
+
+  ASSERT (memeq (dec, buf, size));
+
+  free (dec);
+  free (wrapped);
+  free (b64);
+  free (buf);
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for the positional and bulk operations of
+   GL_BTREE_LIST, compared with GL_AVLTREE_LIST and GL_RBTREE_LIST, on a list
+   of N elements.  Since the state of the malloc heap left by one
+   implementation affects the timings of the next one, you can run a single
+   implementation by naming it (avltree, rbtree, or btree).  */
+
+#include <config.h>
+
+#include "gl_btree_list.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gl_avltree_list.h"
+#include "gl_rbtree_list.h"
+#include "bench.h"
+
+enum operation
+{
+  ADD_LAST, GET_AT, ITERATE, ADD_AT, REMOVE_AT,
+  ADD_ALL_AT, MERGE_ARRAY, REMOVE_RANGE
+};
+
+static const char *operation_names[] =
+  {
+    "gl_list_add_last", "gl_list_get_at", "gl_list_iterator_next",
+    "gl_list_add_at", "gl_list_remove_at",
+    "gl_list_add_all_at", "gl_sortedlist_merge_array", "gl_list_remove_range"
+  };
+
+/* A cheap pseudo-random number generator, so that the benchmark measures
+   the list and not rand().  */
+static size_t
+next_random (uint32_t *state)
+{
+  *state = *state * 1103515245 + 12345;
+  return *state >> 8;
+}
+
+static int
+compare_ints (const void *elt1, const void *elt2)
+{
+  uintptr_t v1 = (uintptr_t) elt1;
+  uintptr_t v2 = (uintptr_t) elt2;
+  return (v1 > v2) - (v1 < v2);
+}
+
+static void
+do_test (const char *name, gl_list_implementation_t implementation,
+         size_t n, int repeat)
+{
+  struct timings_state total[REMOVE_RANGE + 1];
+  const void **contents = (const void **) malloc (n * sizeof (const void *));
+
+  if (contents == NULL)
+    abort ();
+  memset (total, 0, sizeof total);
+  for (int count = 0; count < repeat; count++)
+    {
+      gl_list_t list =
+        gl_list_nx_create_empty (implementation, NULL, NULL, NULL, true);
+      if (list == NULL)
+        abort ();
+      uint32_t state = 1;
+      uintptr_t sum = 0;
+
+      for (enum operation op = ADD_LAST; op <= REMOVE_RANGE; op++)
+        {
+          struct timings_state ts;
+
+          timing_start (&ts);
+          switch (op)
+            {
+            case ADD_LAST:
+              for (size_t i = 0; i < n; i++)
+                if (gl_list_nx_add_last (list, (void *) (i + 1)) == NULL)
+                  abort ();
+              break;
+            case GET_AT:
+              for (size_t i = 0; i < n; i++)
+                sum += (uintptr_t) gl_list_get_at (list,
+                                                   next_random (&state) % n);
+              break;
+            case ITERATE:
+              {
+                gl_list_iterator_t iter = gl_list_iterator (list);
+                const void *elt;
+                while (gl_list_iterator_next (&iter, &elt, NULL))
+                  sum += (uintptr_t) elt;
+                gl_list_iterator_free (&iter);
+              }
+              break;
+            case ADD_AT:
+              for (size_t i = 0; i < n; i++)
+                if (gl_list_nx_add_at (list, next_random (&state) % (n + i),
+                                       (void *) i)
+                    == NULL)
+                  abort ();
+              break;
+            case REMOVE_AT:
+              for (size_t i = 2 * n; i > 0; i--)
+                gl_list_remove_at (list, next_random (&state) % i);
+              break;
+            case ADD_ALL_AT:
+              /* Fill the empty list with N sorted elements at once.  */
+              for (size_t i = 0; i < n; i++)
+                contents[i] = (void *) (2 * i + 2);
+              if (gl_list_nx_add_all_at (list, 0, n, contents) < 0)
+                abort ();
+              break;
+            case MERGE_ARRAY:
+              for (size_t i = 0; i < n; i++)
+                contents[i] = (void *) (2 * i + 1);
+              if (gl_sortedlist_nx_merge_array (list, compare_ints, n, contents)
+                  < 0)
+                abort ();
+              break;
+            case REMOVE_RANGE:
+              /* Trim the list in chunks of N / 10 elements.  */
+              for (size_t size = 2 * n; size > 0; )
+                {
+                  size_t start = next_random (&state) % size;
+                  size_t length = n / 10 + 1;
+                  if (length > size - start)
+                    length = size - start;
+                  gl_list_remove_range (list, start, start + length);
+                  size -= length;
+                }
+              break;
+            }
+          timing_end (&ts);
+
+          total[op].real_usec += ts.real_usec;
+          total[op].user_usec += ts.user_usec;
+          total[op].sys_usec += ts.sys_usec;
+        }
+      gl_list_free (list);
+      /* Use SUM, so that the compiler does not optimize the loops away.  */
+      if (sum == 1)
+        abort ();
+    }
+
+  free (contents);
+
+  for (enum operation op = ADD_LAST; op <= REMOVE_RANGE; op++)
+    {
+      printf ("%s %s\n", name, operation_names[op]);
+      timing_output (&total[op]);
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (!(argc == 3 || argc == 4))
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS N [IMPLEMENTATION]\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+  const char *which = (argc == 4 ? argv[3] : NULL);
+  if (n == 0)
+    {
+      fprintf (stderr, "%s: N must be positive\n", argv[0]);
+      exit (1);
+    }
+
+  if (which == NULL || strcmp (which, "avltree") == 0)
+    do_test ("GL_AVLTREE_LIST", GL_AVLTREE_LIST, n, repeat);
+  if (which == NULL || strcmp (which, "rbtree") == 0)
+    do_test ("GL_RBTREE_LIST", GL_RBTREE_LIST, n, repeat);
+  if (which == NULL || strcmp (which, "btree") == 0)
+    do_test ("GL_BTREE_LIST", GL_BTREE_LIST, n, repeat);
+
+  return 0;
+}
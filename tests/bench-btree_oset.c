@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for GL_BTREE_OSET, compared with GL_AVLTREE_OSET and
+   GL_RBTREE_OSET, on a set of N elements.  Since the state of the malloc
+   heap left by one implementation affects the timings of the next one, you
+   can run a single implementation by naming it (avltree, rbtree, or
+   btree).  */
+
+#include <config.h>
+
+#include "gl_btree_oset.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gl_avltree_oset.h"
+#include "gl_rbtree_oset.h"
+#include "bench.h"
+
+enum operation { CREATE, ADD, SEARCH, RANGE_SCAN, REMOVE };
+
+static const char *operation_names[] =
+  {
+    "gl_oset_create", "gl_oset_add", "gl_oset_search",
+    "gl_oset_iterator_atleast", "gl_oset_remove"
+  };
+
+/* Number of elements visited by each range scan.  */
+#define RANGE_LENGTH 100
+
+/* A cheap pseudo-random number generator, so that the benchmark measures
+   the set and not rand().  */
+static size_t
+next_random (uint32_t *state)
+{
+  *state = *state * 1103515245 + 12345;
+  return *state >> 8;
+}
+
+static int
+compare_ints (const void *elt1, const void *elt2)
+{
+  uintptr_t v1 = (uintptr_t) elt1;
+  uintptr_t v2 = (uintptr_t) elt2;
+  return (v1 > v2) - (v1 < v2);
+}
+
+static bool
+is_at_least (const void *elt, const void *threshold)
+{
+  return (uintptr_t) elt >= (uintptr_t) threshold;
+}
+
+static void
+do_test (const char *name, gl_oset_implementation_t implementation,
+         size_t n, int repeat)
+{
+  struct timings_state total[REMOVE + 1];
+  const void **contents = (const void **) malloc (n * sizeof (const void *));
+
+  if (contents == NULL)
+    abort ();
+  for (size_t i = 0; i < n; i++)
+    contents[i] = (void *) (2 * i + 1);
+
+  memset (total, 0, sizeof total);
+  for (int count = 0; count < repeat; count++)
+    {
+      gl_oset_t set = NULL;
+      uint32_t state = 1;
+      uintptr_t sum = 0;
+
+      for (enum operation op = CREATE; op <= REMOVE; op++)
+        {
+          struct timings_state ts;
+
+          timing_start (&ts);
+          switch (op)
+            {
+            case CREATE:
+              set = gl_oset_nx_create (implementation, compare_ints, NULL,
+                                       n, contents);
+              if (set == NULL)
+                abort ();
+              break;
+            case ADD:
+              /* Add N elements in random order between the existing ones.  */
+              for (size_t i = 0; i < n; i++)
+                if (gl_oset_nx_add (set,
+                                    (void *) (2 * (next_random (&state) % n)))
+                    < 0)
+                  abort ();
+              break;
+            case SEARCH:
+              for (size_t i = 0; i < n; i++)
+                sum += gl_oset_search (set,
+                                       (void *) (next_random (&state) % (2 * n)));
+              break;
+            case RANGE_SCAN:
+              for (size_t i = 0; i < n / RANGE_LENGTH; i++)
+                {
+                  gl_oset_iterator_t iter =
+                    gl_oset_iterator_atleast (set, is_at_least,
+                                              (void *) (next_random (&state)
+                                                        % (2 * n)));
+                  const void *elt;
+                  for (size_t j = 0;
+                       j < RANGE_LENGTH && gl_oset_iterator_next (&iter, &elt);
+                       j++)
+                    sum += (uintptr_t) elt;
+                  gl_oset_iterator_free (&iter);
+                }
+              break;
+            case REMOVE:
+              for (size_t i = 0; i < 2 * n; i++)
+                gl_oset_remove (set, (void *) (next_random (&state) % (2 * n)));
+              break;
+            }
+          timing_end (&ts);
+
+          total[op].real_usec += ts.real_usec;
+          total[op].user_usec += ts.user_usec;
+          total[op].sys_usec += ts.sys_usec;
+        }
+      gl_oset_free (set);
+      /* Use SUM, so that the compiler does not optimize the loops away.  */
+      if (sum == 1)
+        abort ();
+    }
+  free (contents);
+
+  for (enum operation op = CREATE; op <= REMOVE; op++)
+    {
+      printf ("%s %s\n", name, operation_names[op]);
+      timing_output (&total[op]);
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (!(argc == 3 || argc == 4))
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS N [IMPLEMENTATION]\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+  const char *which = (argc == 4 ? argv[3] : NULL);
+  if (n == 0)
+    {
+      fprintf (stderr, "%s: N must be positive\n", argv[0]);
+      exit (1);
+    }
+
+  if (which == NULL || strcmp (which, "avltree") == 0)
+    do_test ("GL_AVLTREE_OSET", GL_AVLTREE_OSET, n, repeat);
+  if (which == NULL || strcmp (which, "rbtree") == 0)
+    do_test ("GL_RBTREE_OSET", GL_RBTREE_OSET, n, repeat);
+  if (which == NULL || strcmp (which, "btree") == 0)
+    do_test ("GL_BTREE_OSET", GL_BTREE_OSET, n, repeat);
+
+  return 0;
+}
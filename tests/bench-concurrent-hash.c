@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for chash_lookup.
+
+   THREADS threads look up, REPETITIONS times, all the N entries of a table
+   in a random order, first in a table of "hash.h" protected by a lock,
+   then in a concurrent table.  With enough cores, the real time of the
+   latter should not depend much on THREADS.  */
+
+#include <config.h>
+
+#include "concurrent-hash.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "glthread/lock.h"
+#include "glthread/thread.h"
+
+#include "bench.h"
+
+static size_t
+key_hasher (const void *x, size_t table_size)
+{
+  return *(const uint64_t *) x % table_size;
+}
+
+static bool
+key_comparator (const void *x, const void *y)
+{
+  return *(const uint64_t *) x == *(const uint64_t *) y;
+}
+
+static uint64_t *keys;
+static uint64_t **order;
+static size_t n;
+static int repeat;
+
+static Hash_table *locked_table;
+gl_lock_define_initialized (static, locked_table_lock)
+static Chash_table *concurrent_table;
+
+static void *
+locked_lookup_thread (_GL_UNUSED void *arg)
+{
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i++)
+      {
+        gl_lock_lock (locked_table_lock);
+        void *found = hash_lookup (locked_table, order[i]);
+        gl_lock_unlock (locked_table_lock);
+        if (!found)
+          abort ();
+      }
+  return NULL;
+}
+
+static void *
+concurrent_lookup_thread (_GL_UNUSED void *arg)
+{
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i++)
+      if (!chash_lookup (concurrent_table, order[i]))
+        abort ();
+  return NULL;
+}
+
+static void
+do_test (const char *name, void * (*func) (void *), int n_threads)
+{
+  struct timings_state ts;
+  gl_thread_t *threads = malloc (n_threads * sizeof *threads);
+  if (!threads)
+    abort ();
+
+  timing_start (&ts);
+  for (int i = 0; i < n_threads; i++)
+    threads[i] = gl_thread_create (func, NULL);
+  for (int i = 0; i < n_threads; i++)
+    gl_thread_join (threads[i], NULL);
+  timing_end (&ts);
+  printf ("%s, %d threads\n", name, n_threads);
+  timing_output (&ts);
+
+  free (threads);
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 4)
+    {
+      fprintf (stderr, "Usage: %s THREADS REPETITIONS N\n", argv[0]);
+      exit (1);
+    }
+
+  int n_threads = atoi (argv[1]);
+  repeat = atoi (argv[2]);
+  n = atol (argv[3]);
+
+  keys = malloc (n * sizeof *keys);
+  order = malloc (n * sizeof *order);
+  if (!keys || !order)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+
+  srand (1);
+  for (size_t i = 0; i < n; i++)
+    {
+      keys[i] = ((uint64_t) rand () << 31 | rand ()) * 4096 + i;
+      order[i] = &keys[i];
+    }
+  for (size_t i = n; 1 < i; i--)
+    {
+      size_t j = ((size_t) rand () * RAND_MAX + rand ()) % i;
+      uint64_t *tmp = order[i - 1];
+      order[i - 1] = order[j];
+      order[j] = tmp;
+    }
+
+  locked_table = hash_initialize (n, NULL, key_hasher, key_comparator, NULL);
+  concurrent_table = chash_initialize (n, key_hasher, key_comparator, NULL);
+  if (!locked_table || !concurrent_table)
+    abort ();
+  for (size_t i = 0; i < n; i++)
+    if (!hash_insert (locked_table, &keys[i])
+        || chash_insert_if_absent (concurrent_table, &keys[i], NULL) != 1)
+      abort ();
+
+  for (int t = 1; t <= n_threads; t *= 2)
+    {
+      do_test ("hash_lookup with a lock", locked_lookup_thread, t);
+      do_test ("chash_lookup", concurrent_lookup_thread, t);
+    }
+
+  hash_free (locked_table);
+  chash_free (concurrent_table);
+  free (keys);
+  free (order);
+  return 0;
+}
@@ -14,12 +14,23 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
+/* Benchmark program for the crc32 function and, when the 'crc32c' module
+   is present, for the crc32c function.
+
+   By default, the 4 KiB of randomb are checksummed.  With a SIZE argument,
+   a buffer of SIZE bytes is checksummed instead, so that the code paths
+   for large buffers are measured.  */
+
 #include <config.h>
 
 #include "crc.h"
+#if GNULIB_CRC32C
+# include "crc32c.h"
+#endif
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "bench.h"
 #include "macros.h"
@@ -27,25 +38,53 @@
 int
 main (int argc, char *argv[])
 {
-  if (argc != 2)
+  if (!(argc == 2 || argc == 3))
     {
-      fprintf (stderr, "Usage: %s REPETITIONS\n", argv[0]);
+      fprintf (stderr, "Usage: %s REPETITIONS [SIZE]\n", argv[0]);
       exit (1);
     }
 
   int repeat = atoi (argv[1]);
+  size_t size = argc == 3 ? atol (argv[2]) : sizeof randomb;
+
+  char *buf = malloc (size);
+  if (!buf)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+  for (size_t i = 0; i < size; i += sizeof randomb)
+    memcpy (buf + i, randomb,
+            size - i < sizeof randomb ? size - i : sizeof randomb);
 
   struct timings_state ts;
   timing_start (&ts);
 
   for (int count = 0; count < repeat; count++)
     {
-      uint32_t volatile digest = crc32 (randomb, sizeof randomb);
-      ASSERT (digest == 0x5299f9d2U);
+      uint32_t volatile digest = crc32 (buf, size);
+      ASSERT (size != sizeof randomb || digest == 0x5299f9d2U);
     }
 
   timing_end (&ts);
+  printf ("crc32\n");
   timing_output (&ts);
 
+#if GNULIB_CRC32C
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    {
+      uint32_t volatile digest = crc32c (buf, size);
+      ASSERT (size != sizeof randomb || digest == 0x6ae7cef6U);
+    }
+
+  timing_end (&ts);
+  printf ("crc32c\n");
+  timing_output (&ts);
+#endif
+
+  free (buf);
+
   return 0;
 }
@@ -14,11 +14,19 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
+/* Besides FUNC, the including file may define
+     FUNC_BUFFERS  a function that hashes several messages at once, like
+                   sha256_buffers, and
+     FUNC_XOF      an extendable-output function, like shake256_buffer.  */
+
 #include <stdio.h>
 #include <stdlib.h>
 
 #include "bench.h"
 
+#define STRINGIFY(x) STRINGIFY1 (x)
+#define STRINGIFY1(x) #x
+
 int
 main (int argc, char *argv[])
 {
@@ -55,5 +63,55 @@ main (int argc, char *argv[])
   timing_end (&ts);
   timing_output (&ts);
 
+#ifdef FUNC_BUFFERS
+  /* Hash 8 messages of SIZE bytes per call.  */
+  {
+    enum { NBUFFERS = 8 };
+    char const *buffers[NBUFFERS];
+    size_t lens[NBUFFERS];
+    char digests[NBUFFERS][64];
+    void *resblocks[NBUFFERS];
+    for (int i = 0; i < NBUFFERS; i++)
+      {
+        buffers[i] = memblock;
+        lens[i] = size;
+        resblocks[i] = digests[i];
+      }
+
+    timing_start (&ts);
+
+    for (int count = 0; count < repeat; count++)
+      FUNC_BUFFERS (buffers, lens, NBUFFERS, resblocks);
+
+    timing_end (&ts);
+    printf ("%s, %d messages per call:\n", STRINGIFY (FUNC_BUFFERS),
+            (int) NBUFFERS);
+    timing_output (&ts);
+  }
+#endif
+
+#ifdef FUNC_XOF
+  /* Absorb SIZE bytes and squeeze SIZE bytes.  */
+  {
+    char *output = (char *) malloc (size);
+    if (!output)
+      {
+        fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+        return 1;
+      }
+
+    timing_start (&ts);
+
+    for (int count = 0; count < repeat; count++)
+      FUNC_XOF (memblock, size, output, size);
+
+    timing_end (&ts);
+    printf ("%s, %zu bytes of output:\n", STRINGIFY (FUNC_XOF), size);
+    timing_output (&ts);
+
+    free (output);
+  }
+#endif
+
   return 0;
 }
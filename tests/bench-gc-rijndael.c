@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for AES-128 through the gc interface.
+
+   A buffer of SIZE bytes (by default, the 4 KiB of randomb) is encrypted
+   in each of the modes ECB, CBC, CTR and GCM, and decrypted in CBC
+   mode.  */
+
+#include <config.h>
+
+#include "gc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "macros.h"
+
+static void
+bench (char const *name, Gc_cipher_mode mode, bool decrypt,
+       int repeat, char *buf, size_t size)
+{
+  static char const key[] = "0123456789abcdef";
+  static char const iv[] = "fedcba9876543210";
+  gc_cipher_handle ctx;
+  char tag[16];
+
+  ASSERT (gc_cipher_open (GC_AES128, mode, &ctx) == GC_OK);
+  ASSERT (gc_cipher_setkey (ctx, 16, key) == GC_OK);
+
+  struct timings_state ts;
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    {
+      ASSERT (gc_cipher_setiv (ctx, mode == GC_GCM ? 12 : 16, iv) == GC_OK);
+      ASSERT ((decrypt
+               ? gc_cipher_decrypt_inline (ctx, size, buf)
+               : gc_cipher_encrypt_inline (ctx, size, buf)) == GC_OK);
+      if (mode == GC_GCM)
+        ASSERT (gc_cipher_gettag (ctx, 16, tag) == GC_OK);
+    }
+
+  timing_end (&ts);
+  printf ("%s\n", name);
+  timing_output (&ts);
+
+  gc_cipher_close (ctx);
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (!(argc == 2 || argc == 3))
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS [SIZE]\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t size = argc == 3 ? atol (argv[2]) : sizeof randomb;
+  size &= ~(size_t) 15;
+
+  char *buf = malloc (size);
+  if (!buf)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+  for (size_t i = 0; i < size; i += sizeof randomb)
+    memcpy (buf + i, randomb,
+            size - i < sizeof randomb ? size - i : sizeof randomb);
+
+  ASSERT (gc_init () == GC_OK);
+
+  bench ("AES-128-ECB encrypt", GC_ECB, false, repeat, buf, size);
+  bench ("AES-128-CBC encrypt", GC_CBC, false, repeat, buf, size);
+  bench ("AES-128-CBC decrypt", GC_CBC, true, repeat, buf, size);
+  bench ("AES-128-CTR", GC_CTR, false, repeat, buf, size);
+  bench ("AES-128-GCM encrypt", GC_GCM, false, repeat, buf, size);
+
+  gc_done ();
+  free (buf);
+
+  return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for building a hamt with N elements through
+   hamt_insert, hamt_insert_x, and a transient hamt.  */
+
+#include <config.h>
+
+#include "hamt.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+typedef struct
+{
+  Hamt_entry entry;
+  size_t val;
+} Element;
+
+static size_t
+hash_element (const void *elt)
+{
+  size_t h = ((const Element *) elt)->val;
+  /* Spread the bits, so that all levels of the trie are used.  */
+  h ^= h >> 15;
+  h *= (size_t) 0x9E3779B97F4A7C15ULL;
+  h ^= h >> 13;
+  return h;
+}
+
+static bool
+compare_element (const void *elt1, const void *elt2)
+{
+  return ((const Element *) elt1)->val == ((const Element *) elt2)->val;
+}
+
+/* The elements are owned by the benchmark, not by the hamts.  */
+static void
+free_element (Hamt_entry *_GL_UNNAMED (elt))
+{
+}
+
+enum method { PERSISTENT, DESTRUCTIVE, TRANSIENT };
+
+static void
+do_test (const char *name, enum method method, Element *elts, size_t n,
+         int repeat)
+{
+  struct timings_state ts;
+  struct timings_state total;
+
+  memset (&total, 0, sizeof total);
+  for (int count = 0; count < repeat; count++)
+    {
+      for (size_t i = 0; i < n; i++)
+        hamt_element (&elts[i].entry);
+
+      timing_start (&ts);
+      Hamt *hamt = hamt_create (hash_element, compare_element, free_element);
+      switch (method)
+        {
+        case PERSISTENT:
+          for (size_t i = 0; i < n; i++)
+            {
+              Hamt_entry *p = &elts[i].entry;
+              Hamt *new_hamt = hamt_insert (hamt, &p);
+              hamt_free (hamt);
+              hamt = new_hamt;
+            }
+          break;
+        case DESTRUCTIVE:
+          for (size_t i = 0; i < n; i++)
+            {
+              Hamt_entry *p = &elts[i].entry;
+              if (!hamt_insert_x (hamt, &p))
+                abort ();
+            }
+          break;
+        case TRANSIENT:
+          {
+            Hamt_transient *transient = hamt_transient (hamt);
+            hamt_free (hamt);
+            for (size_t i = 0; i < n; i++)
+              {
+                Hamt_entry *p = &elts[i].entry;
+                if (!hamt_transient_insert (transient, &p))
+                  abort ();
+              }
+            hamt = hamt_persistent (transient);
+          }
+          break;
+        }
+      hamt_free (hamt);
+      timing_end (&ts);
+
+      total.real_usec += ts.real_usec;
+      total.user_usec += ts.user_usec;
+      total.sys_usec += ts.sys_usec;
+    }
+  printf ("%s\n", name);
+  timing_output (&total);
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS N\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+
+  Element *elts = malloc (n * sizeof *elts);
+  if (!elts)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+  for (size_t i = 0; i < n; i++)
+    elts[i].val = i;
+
+  do_test ("hamt_insert", PERSISTENT, elts, n, repeat);
+  do_test ("hamt_insert_x", DESTRUCTIVE, elts, n, repeat);
+  do_test ("hamt_transient_insert", TRANSIENT, elts, n, repeat);
+
+  free (elts);
+  return 0;
+}
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for hash_insert, hash_lookup, hash_lookup_many and
+   hash_remove.
+
+   N entries are inserted into a table, looked up in a different order,
+   one at a time and in batches, looked up again with keys that are not in
+   the table, and removed, with each representation of the table.  The
+   entries are first (device, inode) pairs, as programs such as 'du' keep
+   track of, then (name, device, inode) triples, as programs such as 'cp'
+   keep track of.  */
+
+#include <config.h>
+
+#include "hash.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hashcode-file.h"
+
+#include "bench.h"
+
+struct ino_dev
+{
+  uint64_t ino;
+  uint64_t dev;
+};
+
+static size_t
+ino_dev_hash (void const *x, size_t table_size)
+{
+  struct ino_dev const *p = x;
+  return (p->ino ^ p->dev) % table_size;
+}
+
+static bool
+ino_dev_compare (void const *x, void const *y)
+{
+  struct ino_dev const *a = x;
+  struct ino_dev const *b = y;
+  return a->ino == b->ino && a->dev == b->dev;
+}
+
+/* The number of keys passed to each hash_lookup_many call.  */
+enum { BATCH = 256 };
+
+static void
+do_test (char const *name, Hash_tuning const *tuning,
+         Hash_hasher hasher, Hash_comparator comparator,
+         void **entries, void **order, void **misses, size_t n, int repeat)
+{
+  struct timings_state ts;
+  size_t found = 0;
+  void *results[BATCH];
+
+  Hash_table *ht = hash_initialize (0, tuning, hasher, comparator, NULL);
+  if (!ht)
+    abort ();
+
+  timing_start (&ts);
+  for (size_t i = 0; i < n; i++)
+    if (!hash_insert (ht, entries[i]))
+      abort ();
+  timing_end (&ts);
+  printf ("%s: hash_insert\n", name);
+  timing_output (&ts);
+
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i++)
+      found += hash_lookup (ht, order[i]) != NULL;
+  timing_end (&ts);
+  printf ("%s: hash_lookup, successful\n", name);
+  timing_output (&ts);
+
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i++)
+      found += hash_lookup (ht, misses[i]) != NULL;
+  timing_end (&ts);
+  printf ("%s: hash_lookup, unsuccessful\n", name);
+  timing_output (&ts);
+
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i += BATCH)
+      found += hash_lookup_many (ht, (void const *const *) order + i,
+                                 n - i < BATCH ? n - i : BATCH, results);
+  timing_end (&ts);
+  printf ("%s: hash_lookup_many, successful\n", name);
+  timing_output (&ts);
+
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i += BATCH)
+      found += hash_lookup_many (ht, (void const *const *) misses + i,
+                                 n - i < BATCH ? n - i : BATCH, results);
+  timing_end (&ts);
+  printf ("%s: hash_lookup_many, unsuccessful\n", name);
+  timing_output (&ts);
+
+  timing_start (&ts);
+  for (size_t i = 0; i < n; i++)
+    if (!hash_remove (ht, entries[i]))
+      abort ();
+  timing_end (&ts);
+  printf ("%s: hash_remove\n", name);
+  timing_output (&ts);
+
+  if (found != 2 * repeat * n)
+    abort ();
+  hash_free (ht);
+}
+
+/* Run do_test with each representation of the table.  */
+static void
+do_tests (char const *name, Hash_hasher hasher, Hash_comparator comparator,
+          void **entries, void **order, void **misses, size_t n, int repeat)
+{
+  static struct
+  {
+    char const *name;
+    bool is_open_addressing;
+    bool is_hash_cached;
+  } const representations[] =
+    {
+      { "separate chaining", false, false },
+      { "separate chaining, cached hash codes", false, true },
+      { "open addressing", true, false },
+      { "open addressing, cached hash codes", true, true },
+    };
+
+  for (size_t r = 0;
+       r < sizeof representations / sizeof representations[0]; r++)
+    {
+      char full_name[100];
+      Hash_tuning tuning;
+      hash_reset_tuning (&tuning);
+      tuning.is_open_addressing = representations[r].is_open_addressing;
+      tuning.is_hash_cached = representations[r].is_hash_cached;
+      sprintf (full_name, "%s, %s", name, representations[r].name);
+      do_test (full_name, &tuning, hasher, comparator,
+               entries, order, misses, n, repeat);
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS N\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+
+  struct ino_dev *pairs = malloc (2 * n * sizeof *pairs);
+  struct F_triple *triples = malloc (2 * n * sizeof *triples);
+  void **entries = malloc (n * sizeof *entries);
+  void **order = malloc (n * sizeof *order);
+  void **misses = malloc (n * sizeof *misses);
+  size_t *permutation = malloc (n * sizeof *permutation);
+  if (!pairs || !triples || !entries || !order || !misses || !permutation)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+
+  srand (1);
+  for (size_t i = 0; i < n; i++)
+    permutation[i] = i;
+  for (size_t i = n; 1 < i; i--)
+    {
+      size_t j = ((size_t) rand () * RAND_MAX + rand ()) % i;
+      size_t tmp = permutation[i - 1];
+      permutation[i - 1] = permutation[j];
+      permutation[j] = tmp;
+    }
+
+  for (size_t i = 0; i < n; i++)
+    {
+      /* Inode numbers scattered over a large range, as on file systems
+         that encode the location of an inode in its number.  */
+      pairs[i].ino = (((uint64_t) rand () << 31 | rand ()) * 4096
+                      + rand () % 4096);
+      pairs[i].dev = 0x803;
+      pairs[n + i].ino = pairs[i].ino;
+      pairs[n + i].dev = 0x804;
+    }
+  for (size_t i = 0; i < n; i++)
+    {
+      entries[i] = &pairs[i];
+      order[i] = &pairs[permutation[i]];
+      misses[i] = &pairs[n + i];
+    }
+  do_tests ("inodes", ino_dev_hash, ino_dev_compare,
+            entries, order, misses, n, repeat);
+
+  for (size_t i = 0; i < 2 * n; i++)
+    {
+      char buf[100];
+      sprintf (buf, "/home/user/src/project/subdir%zu/file%zu.c",
+               i % 97, i);
+      triples[i].name = strdup (buf);
+      if (!triples[i].name)
+        {
+          fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+          return 1;
+        }
+      triples[i].st_ino = pairs[i].ino;
+      triples[i].st_dev = pairs[i].dev;
+    }
+  for (size_t i = 0; i < n; i++)
+    {
+      entries[i] = &triples[i];
+      order[i] = &triples[permutation[i]];
+      misses[i] = &triples[n + i];
+    }
+  do_tests ("file names", triple_hash, triple_compare_ino_str,
+            entries, order, misses, n, repeat);
+
+  for (size_t i = 0; i < 2 * n; i++)
+    free (triples[i].name);
+  free (pairs);
+  free (triples);
+  free (entries);
+  free (order);
+  free (misses);
+  free (permutation);
+  return 0;
+}
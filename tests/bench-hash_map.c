@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for gl_map_nx_put, gl_map_search and
+   gl_map_search_many.
+
+   A map with N string keys is built, and the time of the slowest insertion
+   is reported, which includes the time spent growing the hash table.
+   The map is then searched in random order, one key at a time and in
+   batches, first with keys that are in the map, then with keys that are
+   not.  */
+
+#include <config.h>
+
+#include "gl_hash_map.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "bench.h"
+
+/* The number of keys passed to each gl_map_search_many call.  */
+enum { BATCH = 256 };
+
+static bool
+string_equals (const void *x1, const void *x2)
+{
+  return streq (x1, x2);
+}
+
+static size_t
+string_hash (const void *x)
+{
+  const unsigned char *s = x;
+  size_t h = 0;
+
+  for (; *s; s++)
+    h = h * 31 + *s;
+
+  return h;
+}
+
+static void
+do_test (const char *name, gl_map_t map, const void **keys, size_t n,
+         int repeat, size_t expected)
+{
+  struct timings_state ts;
+  const void *values[BATCH];
+  size_t found;
+
+  found = 0;
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i++)
+      {
+        const void *value;
+        found += gl_map_search (map, keys[i], &value);
+      }
+  timing_end (&ts);
+  printf ("%s: gl_map_search\n", name);
+  timing_output (&ts);
+  if (found != repeat * expected)
+    abort ();
+
+  found = 0;
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i += BATCH)
+      found += gl_map_search_many (map, keys + i,
+                                   n - i < BATCH ? n - i : BATCH,
+                                   values, NULL);
+  timing_end (&ts);
+  printf ("%s: gl_map_search_many\n", name);
+  timing_output (&ts);
+  if (found != repeat * expected)
+    abort ();
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS N\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+
+  char **strings = malloc (2 * n * sizeof *strings);
+  const void **keys = malloc (n * sizeof *keys);
+  if (!strings || !keys)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+  for (size_t i = 0; i < 2 * n; i++)
+    {
+      char buf[100];
+      sprintf (buf, "/usr/share/locale/subdir%zu/file%zu", i % 97, i);
+      strings[i] = strdup (buf);
+      if (!strings[i])
+        {
+          fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+          return 1;
+        }
+    }
+
+  gl_map_t map =
+    gl_map_nx_create_empty (GL_HASH_MAP, string_equals, string_hash,
+                            NULL, NULL);
+  if (!map)
+    abort ();
+  long slowest = 0;
+  for (size_t i = 0; i < n; i++)
+    {
+      struct timeval start, end;
+      gettimeofday (&start, NULL);
+      if (gl_map_nx_put (map, strings[i], strings[i]) < 0)
+        abort ();
+      gettimeofday (&end, NULL);
+      long usec = ((end.tv_sec - start.tv_sec) * 1000000L
+                   + (end.tv_usec - start.tv_usec));
+      if (usec > slowest)
+        slowest = usec;
+    }
+  printf ("gl_map_nx_put: slowest insertion: %ld us\n", slowest);
+
+  /* Search the keys in a random order, so that consecutive searches don't
+     touch neighbouring memory.  */
+  srand (1);
+  for (size_t i = 0; i < n; i++)
+    keys[i] = strings[i];
+  for (size_t i = n; 1 < i; i--)
+    {
+      size_t j = ((size_t) rand () * RAND_MAX + rand ()) % i;
+      const void *tmp = keys[i - 1];
+      keys[i - 1] = keys[j];
+      keys[j] = tmp;
+    }
+  do_test ("successful", map, keys, n, repeat, n);
+
+  for (size_t i = 0; i < n; i++)
+    keys[i] = strings[n + i];
+  do_test ("unsuccessful", map, keys, n, repeat, 0);
+
+  gl_map_free (map);
+  for (size_t i = 0; i < 2 * n; i++)
+    free (strings[i]);
+  free (strings);
+  free (keys);
+  return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for gl_set_add and gl_set_search, comparing hash tables
+   with a prime size (the default) and hash tables with a power of 2 as size
+   (GL_ANYHASH_POWER_OF_2).
+
+   The keys are compared by identity, with the identity as hash code: first
+   small integers, then the addresses of heap-allocated objects, whose low
+   bits are always zero.  The keys are added and searched in random order,
+   so that consecutive operations don't touch neighbouring buckets merely
+   because the keys are consecutive.  */
+
+#include <config.h>
+
+/* Compile the hash set implementation a second time, with power of 2 table
+   sizes.  */
+#define GL_ANYHASH_POWER_OF_2 1
+#define gl_hash_set_implementation pow2_hash_set_implementation
+#include "gl_hash_set.c"
+#undef gl_hash_set_implementation
+#undef GL_ANYHASH_POWER_OF_2
+extern const struct gl_set_implementation gl_hash_set_implementation;
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+
+static void
+do_test (const char *name, gl_set_implementation_t implementation,
+         const void **keys, size_t n, int repeat)
+{
+  struct timings_state ts;
+  size_t found;
+
+  gl_set_t set = gl_set_nx_create_empty (implementation, NULL, NULL, NULL);
+  if (!set)
+    abort ();
+
+  timing_start (&ts);
+  for (size_t i = 0; i < n; i++)
+    if (gl_set_nx_add (set, keys[i]) < 0)
+      abort ();
+  timing_end (&ts);
+  printf ("%s: gl_set_add\n", name);
+  timing_output (&ts);
+
+  found = 0;
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t i = 0; i < n; i++)
+      found += gl_set_search (set, keys[i]);
+  timing_end (&ts);
+  printf ("%s: gl_set_search\n", name);
+  timing_output (&ts);
+  if (found != repeat * n)
+    abort ();
+
+  gl_set_free (set);
+}
+
+/* Shuffles the N elements of KEYS.  */
+static void
+shuffle (const void **keys, size_t n)
+{
+  for (size_t i = n; 1 < i; i--)
+    {
+      size_t j = ((size_t) rand () * RAND_MAX + rand ()) % i;
+      const void *tmp = keys[i - 1];
+      keys[i - 1] = keys[j];
+      keys[j] = tmp;
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS N\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+
+  const void **keys = malloc (n * sizeof *keys);
+  if (!keys)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+
+  srand (1);
+
+  /* Integer keys.  */
+  for (size_t i = 0; i < n; i++)
+    keys[i] = (const void *) (uintptr_t) (i + 1);
+  shuffle (keys, n);
+  do_test ("integers, prime size", &gl_hash_set_implementation,
+           keys, n, repeat);
+  do_test ("integers, power of 2 size", &pow2_hash_set_implementation,
+           keys, n, repeat);
+
+  /* Pointer keys.  */
+  for (size_t i = 0; i < n; i++)
+    {
+      keys[i] = malloc (24);
+      if (!keys[i])
+        {
+          fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+          return 1;
+        }
+    }
+  shuffle (keys, n);
+  do_test ("pointers, prime size", &gl_hash_set_implementation,
+           keys, n, repeat);
+  do_test ("pointers, power of 2 size", &pow2_hash_set_implementation,
+           keys, n, repeat);
+
+  for (size_t i = 0; i < n; i++)
+    free ((void *) keys[i]);
+  free (keys);
+  return 0;
+}
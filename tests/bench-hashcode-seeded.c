@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Free Software Foundation, Inc.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* Benchmark program for hash_mem64, compared with hash_pjw_bare, on keys
+   of a given length.  */
+
+#include <config.h>
+
+#include "hashcode-seeded.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "hashcode-mem.h"
+
+#include "bench.h"
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      fprintf (stderr, "Usage: %s REPETITIONS LENGTH\n", argv[0]);
+      exit (1);
+    }
+
+  int repeat = atoi (argv[1]);
+  size_t n = atol (argv[2]);
+
+  /* Several keys, so that the lengths vary around N.  */
+  enum { KEYS = 16 };
+  char *buf = malloc (n + KEYS);
+  if (!buf)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+  for (size_t i = 0; i < n + KEYS; i++)
+    buf[i] = "/usr/share/locale/"[i % 18];
+
+  struct timings_state ts;
+  /* Use the results, so that the calls are not optimized away.  */
+  size_t sum;
+
+  sum = 0;
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t k = 0; k < KEYS; k++)
+      sum += hash_pjw_bare (buf + k, n);
+  timing_end (&ts);
+  printf ("hash_pjw_bare (%zu): ", sum % 10);
+  timing_output (&ts);
+
+  sum = 0;
+  timing_start (&ts);
+  for (int count = 0; count < repeat; count++)
+    for (size_t k = 0; k < KEYS; k++)
+      sum += hash_mem64 (buf + k, n);
+  timing_end (&ts);
+  printf ("hash_mem64 (%zu): ", sum % 10);
+  timing_output (&ts);
+
+  free (buf);
+  return 0;
+}
@@ -14,11 +14,99 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
-/* Benchmark program for the sha256_buffer function.  */
+/* Benchmark program for the sha256_buffer function.
+
+   When the x86_64 backends are compiled in, their throughput is reported
+   as well.  sha256_buffer uses the fastest backend that the CPU supports;
+   to measure the portable code, run this program with
+   GLIBC_TUNABLES=glibc.cpu.hwcaps=-SHA,-AVX2 in the environment.  */
 
 #include <config.h>
 
 #include "sha256.h"
 
-#define FUNC sha256_buffer
-#include "bench-digest.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#if GL_SHA256_X86_64 && !HAVE_OPENSSL_SHA256
+# include "sha256-x86_64.h"
+#endif
+
+#include "bench.h"
+
+static void
+throughput_output (const char *name, const struct timings_state *ts,
+                   size_t size, int repeat)
+{
+  double bytes = (double) size * repeat;
+  printf ("%-14s %10.1f MB/s\n", name,
+          ts->real_usec > 0 ? bytes / ts->real_usec : 0.0);
+  timing_output (ts);
+}
+
+#if GL_SHA256_X86_64 && !HAVE_OPENSSL_SHA256
+static void
+bench_backend (const char *name,
+               void (*process_block) (uint32_t *, void const *, size_t),
+               const char *memblock, size_t size, int repeat)
+{
+  struct timings_state ts;
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    {
+      uint32_t volatile state[8] = { 0 };
+      process_block ((uint32_t *) state, memblock, size & ~(size_t) 63);
+    }
+
+  timing_end (&ts);
+  throughput_output (name, &ts, size & ~(size_t) 63, repeat);
+}
+#endif
+
+int
+main (int argc, char *argv[])
+{
+  if (argc != 3)
+    {
+      fprintf (stderr, "Usage: %s SIZE REPETITIONS\n", argv[0]);
+      exit (1);
+    }
+
+  size_t size = atol (argv[1]);
+  int repeat = atoi (argv[2]);
+
+  char *memblock = (char *) malloc (size);
+  if (!memblock)
+    {
+      fprintf (stderr, "%s: memory exhausted\n", argv[0]);
+      return 1;
+    }
+
+  /* Fill the memory block.  */
+  for (size_t i = 0; i < size; i++)
+    memblock[i] =
+      (unsigned char) (((i * (i-1) * (i-5)) >> 6) + (i % 499) + (i % 101));
+
+  struct timings_state ts;
+  timing_start (&ts);
+
+  for (int count = 0; count < repeat; count++)
+    {
+      char digest[64];
+      sha256_buffer (memblock, size, digest);
+    }
+
+  timing_end (&ts);
+  throughput_output ("sha256_buffer", &ts, size, repeat);
+
+#if GL_SHA256_X86_64 && !HAVE_OPENSSL_SHA256
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("bmi2"))
+    bench_backend ("avx2", sha256_process_block_avx2, memblock, size, repeat);
+  if (__builtin_cpu_supports ("sha") && __builtin_cpu_supports ("sse4.1"))
+    bench_backend ("shani", sha256_process_block_shani, memblock, size,
+                   repeat);
+#endif
+
+  return 0;
+}
@@ -14,11 +14,16 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
-/* Benchmark program for the sha3_256_buffer function.  */
+/* Benchmark program for the sha3_256_buffer function and, if present,
+   the sha3_256_buffers function, and for the shake256_buffer function.  */
 
 #include <config.h>
 
 #include "sha3.h"
 
 #define FUNC sha3_256_buffer
+#if GNULIB_CRYPTO_SHA3_BUFFERS
+# define FUNC_BUFFERS sha3_256_buffers
+#endif
+#define FUNC_XOF shake256_buffer
 #include "bench-digest.h"
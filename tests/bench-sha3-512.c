@@ -14,11 +14,15 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
-/* Benchmark program for the sha3_512_buffer function.  */
+/* Benchmark program for the sha3_512_buffer function and, if present,
+   the sha3_512_buffers function.  */
 
 #include <config.h>
 
 #include "sha3.h"
 
 #define FUNC sha3_512_buffer
+#if GNULIB_CRYPTO_SHA3_BUFFERS
+# define FUNC_BUFFERS sha3_512_buffers
+#endif
 #include "bench-digest.h"
@@ -21,6 +21,7 @@
 
 #include <stdcountof.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "macros.h"
 
@@ -32,6 +33,19 @@ static const char *objects[15] =
 #define RANDOM(n) (rand () % (n))
 #define RANDOM_OBJECT() objects[RANDOM (countof (objects))]
 
+static int
+compare_strings (const void *elt1, const void *elt2)
+{
+  return strcmp ((const char *) elt1, (const char *) elt2);
+}
+
+/* Compares two array elements that point to strings, for qsort.  */
+static int
+compare_string_pointers (const void *p1, const void *p2)
+{
+  return strcmp (*(const char * const *) p1, *(const char * const *) p2);
+}
+
 static void
 check_equals (gl_list_t list1, gl_list_t list2)
 {
@@ -115,7 +129,7 @@ main (int argc, char *argv[])
 
     for (unsigned int repeat = 0; repeat < 10000; repeat++)
       {
-        unsigned int operation = RANDOM (18);
+        unsigned int operation = RANDOM (20);
         switch (operation)
           {
           case 0:
@@ -367,8 +381,129 @@ main (int argc, char *argv[])
               gl_list_iterator_free (&iter2);
             }
             break;
+          case 18: /* add several elements */
+            {
+              size_t index = RANDOM (gl_list_size (list1) + 1);
+              size_t count = RANDOM (5);
+              const void *objs[4];
+              for (size_t i = 0; i < count; i++)
+                {
+                  objs[i] = RANDOM_OBJECT ();
+                  ASSERT (gl_list_nx_add_at (list1, index + i, objs[i]) != NULL);
+                }
+              ASSERT (gl_list_nx_add_all_at (list2, index, count, objs) == 0);
+            }
+            break;
+          case 19: /* remove several elements */
+            {
+              size_t n = gl_list_size (list1);
+              size_t start = RANDOM (n + 1);
+              size_t count = RANDOM (5);
+              if (count > n - start)
+                count = n - start;
+              for (size_t i = 0; i < count; i++)
+                ASSERT (gl_list_remove_at (list1, start));
+              gl_list_remove_range (list2, start, start + count);
+              ASSERT (gl_list_size (list1) == n - count);
+            }
+            break;
+          }
+        check_equals (list1, list2);
+      }
+
+    gl_list_free (list1);
+    gl_list_free (list2);
+    free (contents);
+  }
+
+  /* Test gl_sortedlist_indexof with a run of equal elements.  */
+  {
+    const void *contents[5] =
+      { objects[3], objects[4], objects[4], objects[4], objects[5] };
+    gl_list_t list =
+      gl_list_nx_create (GL_ARRAY_LIST, NULL, NULL, NULL, true,
+                         countof (contents), contents);
+    ASSERT (list != NULL);
+    ASSERT (gl_sortedlist_indexof (list, compare_strings, objects[3]) == 0);
+    ASSERT (gl_sortedlist_indexof (list, compare_strings, objects[4]) == 1);
+    ASSERT (gl_sortedlist_indexof (list, compare_strings, objects[5]) == 4);
+    ASSERT (gl_sortedlist_indexof_from_to (list, compare_strings, 2, 5,
+                                           objects[4])
+            == 2);
+    gl_list_free (list);
+  }
+
+  /* Test the bulk operations on larger sorted lists, where some
+     implementations process the elements one by one and others rebuild the
+     entire list.  The reference list1 is modified one element at a time.  */
+  {
+    size_t n = 1000;
+    const void **contents =
+      (const void **) malloc (n * sizeof (const void *));
+    for (size_t i = 0; i < n; i++)
+      contents[i] = objects[i * countof (objects) / n];
+
+    list1 = gl_list_nx_create (GL_ARRAY_LIST,
+                               NULL, NULL, NULL, true,
+                               n, contents);
+    ASSERT (list1 != NULL);
+    list2 = gl_list_nx_create (GL_ARRAY_LIST,
+                               NULL, NULL, NULL, true,
+                               n, contents);
+    ASSERT (list2 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 200; repeat++)
+      {
+        size_t size = gl_list_size (list1);
+        size_t count = (RANDOM (2) ? RANDOM (size / 32 + 1) : RANDOM (n + 1));
+        switch (RANDOM (3))
+          {
+          case 0: /* add copies of an element, keeping the list sorted */
+            {
+              size_t index = RANDOM (size + 1);
+              const void *obj =
+                (index < size
+                 ? gl_list_get_at (list1, index)
+                 : objects[countof (objects) - 1]);
+              for (size_t i = 0; i < count; i++)
+                {
+                  contents[i] = obj;
+                  ASSERT (gl_list_nx_add_at (list1, index, obj) != NULL);
+                }
+              ASSERT (gl_list_nx_add_all_at (list2, index, count, contents)
+                      == 0);
+            }
+            break;
+          case 1: /* remove a range of elements */
+            {
+              size_t start = RANDOM (size + 1);
+              if (count > size - start)
+                count = size - start;
+              for (size_t i = 0; i < count; i++)
+                ASSERT (gl_list_remove_at (list1, start));
+              gl_list_remove_range (list2, start, start + count);
+            }
+            break;
+          case 2: /* merge a sorted array */
+            for (size_t i = 0; i < count; i++)
+              contents[i] = RANDOM_OBJECT ();
+            qsort (contents, count, sizeof (const void *),
+                   compare_string_pointers);
+            for (size_t i = 0; i < count; i++)
+              ASSERT (gl_sortedlist_nx_add (list1, compare_strings,
+                                            contents[i])
+                      != NULL);
+            ASSERT (gl_sortedlist_nx_merge_array (list2, compare_strings,
+                                                  count, contents)
+                    == 0);
+            break;
           }
         check_equals (list1, list2);
+        {
+          const char *obj = RANDOM_OBJECT ();
+          ASSERT (gl_list_indexof (list2, obj)
+                  == gl_list_indexof (list1, obj));
+        }
       }
 
     gl_list_free (list1);
@@ -20,6 +20,7 @@
 #include "gl_array_oset.h"
 
 #include <stdcountof.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -94,6 +95,18 @@ gl_sortedlist_indexof_atleast (gl_list_t set,
   return (size_t)(-1);
 }
 
+/* For the large sets, the elements are small integers, compared as
+   pointers.  */
+#define INT_ELT(i) ((const void *) (uintptr_t) (i))
+
+static int
+int_compare (const void *elt1, const void *elt2)
+{
+  uintptr_t v1 = (uintptr_t) elt1;
+  uintptr_t v2 = (uintptr_t) elt2;
+  return (v1 > v2) - (v1 < v2);
+}
+
 #include "test-oset-update.h"
 
 int
@@ -191,6 +204,49 @@ main (int argc, char *argv[])
     gl_list_free (set2);
   }
 
+  /* Test gl_oset_nx_add_sorted_array on larger sets.  The reference set2
+     is modified one element at a time.  */
+  {
+    size_t n = 1000;
+    const void **contents =
+      (const void **) malloc (n * sizeof (const void *));
+    ASSERT (contents != NULL);
+
+    set1 = gl_oset_nx_create_empty (GL_ARRAY_OSET, NULL, NULL);
+    ASSERT (set1 != NULL);
+    set2 = gl_list_create_empty (GL_ARRAY_LIST, NULL, NULL, NULL, false);
+
+    for (unsigned int repeat = 0; repeat < 200; repeat++)
+      {
+        size_t size = gl_oset_size (set1);
+        size_t count = (RANDOM (2) ? RANDOM (size / 32 + 1) : RANDOM (n + 1));
+        /* Sorted elements, with repetitions, some of which are already in
+           the set.  */
+        uintptr_t value = 1 + RANDOM (4 * n);
+        for (size_t i = 0; i < count; i++)
+          {
+            contents[i] = INT_ELT (value);
+            value += RANDOM (4);
+          }
+        for (size_t i = 0; i < count; i++)
+          if (gl_sortedlist_search (set2, int_compare, contents[i]) == NULL)
+            gl_sortedlist_add (set2, int_compare, contents[i]);
+        ASSERT (gl_oset_nx_add_sorted_array (set1, count, contents) == 0);
+        /* Remove some elements, so that the size stays bounded.  */
+        for (size_t i = RANDOM (count + 1); i > 0; i--)
+          {
+            const void *obj = INT_ELT (1 + RANDOM (4 * n));
+            ASSERT (gl_oset_remove (set1, obj)
+                    == gl_sortedlist_remove (set2, int_compare, obj));
+          }
+        check_all (set1, set2);
+      }
+
+    gl_oset_free (set1);
+    gl_list_free (set2);
+    free (contents);
+  }
+
   test_update (GL_ARRAY_OSET);
 
   return test_exit_status;
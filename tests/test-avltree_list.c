@@ -21,6 +21,7 @@
 
 #include <stdcountof.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "gl_array_list.h"
 #include "macros.h"
@@ -35,6 +36,19 @@ static const char *objects[15] =
 #define RANDOM(n) (rand () % (n))
 #define RANDOM_OBJECT() objects[RANDOM (countof (objects))]
 
+static int
+compare_strings (const void *elt1, const void *elt2)
+{
+  return strcmp ((const char *) elt1, (const char *) elt2);
+}
+
+/* Compares two array elements that point to strings, for qsort.  */
+static int
+compare_string_pointers (const void *p1, const void *p2)
+{
+  return strcmp (*(const char * const *) p1, *(const char * const *) p2);
+}
+
 static void
 check_equals (gl_list_t list1, gl_list_t list2)
 {
@@ -126,7 +140,7 @@ main (int argc, char *argv[])
 
     for (unsigned int repeat = 0; repeat < 10000; repeat++)
       {
-        unsigned int operation = RANDOM (18);
+        unsigned int operation = RANDOM (20);
         switch (operation)
           {
           case 0:
@@ -448,6 +462,34 @@ main (int argc, char *argv[])
               gl_list_iterator_free (&iter3);
             }
             break;
+          case 18: /* add several elements */
+            {
+              size_t index = RANDOM (gl_list_size (list1) + 1);
+              size_t count = RANDOM (5);
+              const void *objs[4];
+              for (size_t i = 0; i < count; i++)
+                {
+                  objs[i] = RANDOM_OBJECT ();
+                  ASSERT (gl_list_nx_add_at (list1, index + i, objs[i]) != NULL);
+                }
+              ASSERT (gl_list_nx_add_all_at (list2, index, count, objs) == 0);
+              ASSERT (gl_list_nx_add_all_at (list3, index, count, objs) == 0);
+            }
+            break;
+          case 19: /* remove several elements */
+            {
+              size_t n = gl_list_size (list1);
+              size_t start = RANDOM (n + 1);
+              size_t count = RANDOM (5);
+              if (count > n - start)
+                count = n - start;
+              for (size_t i = 0; i < count; i++)
+                ASSERT (gl_list_remove_at (list1, start));
+              gl_list_remove_range (list2, start, start + count);
+              gl_list_remove_range (list3, start, start + count);
+              ASSERT (gl_list_size (list1) == n - count);
+            }
+            break;
           }
         check_all (list1, list2, list3);
       }
@@ -458,5 +500,98 @@ main (int argc, char *argv[])
     free (contents);
   }
 
+  /* Test the bulk operations on larger sorted lists, where some
+     implementations process the elements one by one and others rebuild the
+     entire list.  The reference list1 is modified one element at a time.
+     list3 is like list2, except that its nodes come from a node pool.  */
+  {
+    size_t n = 1000;
+    const void **contents =
+      (const void **) malloc (n * sizeof (const void *));
+    for (size_t i = 0; i < n; i++)
+      contents[i] = objects[i * countof (objects) / n];
+
+    list1 = gl_list_nx_create (GL_ARRAY_LIST,
+                               NULL, NULL, NULL, true,
+                               n, contents);
+    ASSERT (list1 != NULL);
+    list2 = gl_list_nx_create (GL_AVLTREE_LIST,
+                               NULL, NULL, NULL, true,
+                               n, contents);
+    ASSERT (list2 != NULL);
+    list3 = gl_list_nx_create_empty_with_pool (GL_AVLTREE_LIST,
+                                               NULL, NULL, NULL, true);
+    ASSERT (list3 != NULL);
+    ASSERT (gl_list_nx_add_all_at (list3, 0, n, contents) == 0);
+
+    for (unsigned int repeat = 0; repeat < 200; repeat++)
+      {
+        size_t size = gl_list_size (list1);
+        size_t count = (RANDOM (2) ? RANDOM (size / 32 + 1) : RANDOM (n + 1));
+        switch (RANDOM (3))
+          {
+          case 0: /* add copies of an element, keeping the list sorted */
+            {
+              size_t index = RANDOM (size + 1);
+              const void *obj =
+                (index < size
+                 ? gl_list_get_at (list1, index)
+                 : objects[countof (objects) - 1]);
+              for (size_t i = 0; i < count; i++)
+                {
+                  contents[i] = obj;
+                  ASSERT (gl_list_nx_add_at (list1, index, obj) != NULL);
+                }
+              ASSERT (gl_list_nx_add_all_at (list2, index, count, contents)
+                      == 0);
+              ASSERT (gl_list_nx_add_all_at (list3, index, count, contents)
+                      == 0);
+            }
+            break;
+          case 1: /* remove a range of elements */
+            {
+              size_t start = RANDOM (size + 1);
+              if (count > size - start)
+                count = size - start;
+              for (size_t i = 0; i < count; i++)
+                ASSERT (gl_list_remove_at (list1, start));
+              gl_list_remove_range (list2, start, start + count);
+              gl_list_remove_range (list3, start, start + count);
+            }
+            break;
+          case 2: /* merge a sorted array */
+            for (size_t i = 0; i < count; i++)
+              contents[i] = RANDOM_OBJECT ();
+            qsort (contents, count, sizeof (const void *),
+                   compare_string_pointers);
+            for (size_t i = 0; i < count; i++)
+              ASSERT (gl_sortedlist_nx_add (list1, compare_strings,
+                                            contents[i])
+                      != NULL);
+            ASSERT (gl_sortedlist_nx_merge_array (list2, compare_strings,
+                                                  count, contents)
+                    == 0);
+            ASSERT (gl_sortedlist_nx_merge_array (list3, compare_strings,
+                                                  count, contents)
+                    == 0);
+            break;
+          }
+        gl_avltree_list_check_invariants (list2);
+        gl_avltree_list_check_invariants (list3);
+        check_equals (list1, list2);
+        check_equals (list1, list3);
+        {
+          const char *obj = RANDOM_OBJECT ();
+          ASSERT (gl_list_indexof (list2, obj)
+                  == gl_list_indexof (list1, obj));
+        }
+      }
+
+    gl_list_free (list1);
+    gl_list_free (list2);
+    gl_list_free (list3);
+    free (contents);
+  }
+
   return test_exit_status;
 }
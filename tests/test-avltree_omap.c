@@ -77,6 +77,15 @@ string_compare (const void *key1, const void *key2)
   return strcmp (s1, s2);
 }
 
+/* Counts the values that a map disposes.  */
+static size_t disposed;
+
+static void
+count_disposal (_GL_UNUSED const void *value)
+{
+  disposed++;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -140,5 +149,37 @@ main (int argc, char *argv[])
     gl_omap_free (map2);
   }
 
+  /* Test a map whose nodes come from a node pool.  */
+  {
+    map1 = gl_omap_nx_create_empty (GL_ARRAY_OMAP, string_compare, NULL, NULL);
+    ASSERT (map1 != NULL);
+    map2 = gl_omap_nx_create_empty_with_pool (GL_AVLTREE_OMAP, string_compare,
+                                              NULL, count_disposal);
+    ASSERT (map2 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 10000; repeat++)
+      {
+        const char *key = RANDOM_OBJECT ();
+        if (RANDOM (2))
+          {
+            const char *value = RANDOM_OBJECT ();
+            ASSERT (gl_omap_nx_put (map1, key, value)
+                    == gl_omap_nx_put (map2, key, value));
+          }
+        else
+          ASSERT (gl_omap_remove (map1, key) == gl_omap_remove (map2, key));
+        check_all (map1, map2);
+      }
+
+    gl_omap_free (map1);
+    /* Freeing map2 disposes all its values.  */
+    {
+      size_t size = gl_omap_size (map2);
+      disposed = 0;
+      gl_omap_free (map2);
+      ASSERT (disposed == size);
+    }
+  }
+
   return test_exit_status;
 }
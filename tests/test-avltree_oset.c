@@ -20,6 +20,7 @@
 #include "gl_avltree_oset.h"
 
 #include <stdcountof.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -80,12 +81,25 @@ is_at_least (const void *elt, const void *threshold)
   return strcmp ((const char *) elt, (const char *) threshold) >= 0;
 }
 
+/* For the large sets, the elements are small integers, compared as
+   pointers.  */
+#define INT_ELT(i) ((const void *) (uintptr_t) (i))
+
+/* Counts the elements that a set disposes.  */
+static size_t disposed;
+
+static void
+count_disposal (_GL_UNUSED const void *elt)
+{
+  disposed++;
+}
+
 #include "test-oset-update.h"
 
 int
 main (int argc, char *argv[])
 {
-  gl_oset_t set1, set2;
+  gl_oset_t set1, set2, set3;
 
   /* Allow the user to provide a non-default random seed on the command line.  */
   if (argc > 1)
@@ -169,6 +183,64 @@ main (int argc, char *argv[])
     gl_oset_free (set2);
   }
 
+  /* Test gl_oset_nx_add_sorted_array on sets large enough that the
+     elements get merged in a single pass.  The reference set1 is modified
+     one element at a time.  set3 is like set2, except that its nodes come
+     from a node pool.  */
+  {
+    size_t n = 1000;
+    const void **contents =
+      (const void **) malloc (n * sizeof (const void *));
+    ASSERT (contents != NULL);
+
+    set1 = gl_oset_nx_create_empty (GL_ARRAY_OSET, NULL, NULL);
+    ASSERT (set1 != NULL);
+    set2 = gl_oset_nx_create_empty (GL_AVLTREE_OSET, NULL, NULL);
+    ASSERT (set2 != NULL);
+    set3 = gl_oset_nx_create_empty_with_pool (GL_AVLTREE_OSET, NULL,
+                                              count_disposal);
+    ASSERT (set3 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 200; repeat++)
+      {
+        size_t size = gl_oset_size (set1);
+        size_t count = (RANDOM (2) ? RANDOM (size / 32 + 1) : RANDOM (n + 1));
+        /* Sorted elements, with repetitions, some of which are already in
+           the set.  */
+        uintptr_t value = 1 + RANDOM (4 * n);
+        for (size_t i = 0; i < count; i++)
+          {
+            contents[i] = INT_ELT (value);
+            value += RANDOM (4);
+          }
+        for (size_t i = 0; i < count; i++)
+          ASSERT (gl_oset_nx_add (set1, contents[i]) >= 0);
+        ASSERT (gl_oset_nx_add_sorted_array (set2, count, contents) == 0);
+        ASSERT (gl_oset_nx_add_sorted_array (set3, count, contents) == 0);
+        /* Remove some elements, so that the size stays bounded.  */
+        for (size_t i = RANDOM (count + 1); i > 0; i--)
+          {
+            const void *obj = INT_ELT (1 + RANDOM (4 * n));
+            bool removed = gl_oset_remove (set1, obj);
+            ASSERT (gl_oset_remove (set2, obj) == removed);
+            ASSERT (gl_oset_remove (set3, obj) == removed);
+          }
+        check_all (set1, set2);
+        check_all (set1, set3);
+      }
+
+    gl_oset_free (set1);
+    gl_oset_free (set2);
+    /* Freeing set3 disposes all its elements.  */
+    {
+      size_t size = gl_oset_size (set3);
+      disposed = 0;
+      gl_oset_free (set3);
+      ASSERT (disposed == size);
+    }
+    free (contents);
+  }
+
   test_update (GL_AVLTREE_OSET);
 
   return test_exit_status;
@@ -26,6 +26,169 @@
 
 #include "macros.h"
 
+/* A straightforward encoder, against which the optimized code paths are
+   checked.  */
+static void
+ref_encode (const unsigned char *in, idx_t inlen, char *out)
+{
+  static const char alphabet[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  for (idx_t i = 0; i < inlen; i += 3)
+    {
+      unsigned int v = (in[i] << 16
+                        | (i + 1 < inlen ? in[i + 1] << 8 : 0)
+                        | (i + 2 < inlen ? in[i + 2] : 0));
+      *out++ = alphabet[v >> 18];
+      *out++ = alphabet[(v >> 12) & 0x3f];
+      *out++ = i + 1 < inlen ? alphabet[(v >> 6) & 0x3f] : '=';
+      *out++ = i + 2 < inlen ? alphabet[v & 0x3f] : '=';
+    }
+}
+
+/* Check long inputs, which are handled by vectorized code if the CPU
+   supports it, against ref_encode.  */
+static void
+test_long (void)
+{
+  enum { MAXLEN = 300 };
+  unsigned char data[MAXLEN];
+  char ref[BASE64_LENGTH (MAXLEN)];
+  char out[BASE64_LENGTH (MAXLEN) + 1];
+  char dec[MAXLEN + 32];
+  unsigned int seed = 12345;
+
+  for (idx_t i = 0; i < MAXLEN; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      data[i] = seed >> 16;
+    }
+
+  for (idx_t len = 0; len <= MAXLEN; len++)
+    {
+      idx_t b64len = BASE64_LENGTH (len);
+      idx_t declen;
+      bool ok;
+
+      ref_encode (data, len, ref);
+
+      memset (out, 0x42, sizeof out);
+      base64_encode ((char *) data, len, out, b64len);
+      ASSERT (memeq (out, ref, b64len));
+      ASSERT (out[b64len] == 0x42);
+
+      memset (out, 0x42, sizeof out);
+      base64_encode ((char *) data, len, out, b64len + 1);
+      ASSERT (memeq (out, ref, b64len));
+      ASSERT (out[b64len] == '\0');
+
+      /* Truncated output.  */
+      memset (out, 0x42, sizeof out);
+      base64_encode ((char *) data, len, out, b64len / 2);
+      ASSERT (memeq (out, ref, b64len / 2));
+      ASSERT (out[b64len / 2] == 0x42);
+
+      declen = sizeof dec;
+      ok = base64_decode (ref, b64len, dec, &declen);
+      ASSERT (ok);
+      ASSERT (declen == len);
+      ASSERT (memeq (dec, data, len));
+
+      /* Truncated output.  */
+      declen = len / 2;
+      memset (dec, 0x42, sizeof dec);
+      ok = base64_decode (ref, b64len, dec, &declen);
+      ASSERT (ok);
+      ASSERT (declen == len / 2);
+      ASSERT (memeq (dec, data, len / 2));
+      ASSERT ((unsigned char) dec[len / 2] == 0x42);
+    }
+
+  /* Check every byte value at various positions of a long input.  An
+     invalid byte must be rejected, and the input before its group of
+     four must be decoded.  With a context, newlines are skipped.  */
+  idx_t len = 3 * 60;
+  idx_t b64len = BASE64_LENGTH (len);
+  ref_encode (data, len, ref);
+  for (idx_t pos = 0; pos < b64len; pos += 7)
+    for (int c = 0; c < 256; c++)
+      {
+        char in[BASE64_LENGTH (3 * 60)];
+        idx_t declen = sizeof dec;
+        bool ok;
+
+        memcpy (in, ref, b64len);
+        in[pos] = c;
+        ok = base64_decode (in, b64len, dec, &declen);
+        if (isbase64 (c))
+          {
+            ASSERT (ok);
+            ASSERT (declen == len);
+          }
+        else
+          {
+            ASSERT (!ok);
+            ASSERT (pos / 4 * 3 <= declen);
+            ASSERT (memeq (dec, data, pos / 4 * 3));
+          }
+
+        if (c == '\n')
+          {
+            struct base64_decode_context ctx;
+            base64_decode_ctx_init (&ctx);
+            declen = sizeof dec;
+            memcpy (in, ref, pos);
+            in[pos] = '\n';
+            memcpy (in + pos + 1, ref + pos, b64len - pos);
+            ok = base64_decode_ctx (&ctx, in, b64len + 1, dec, &declen);
+            ASSERT (ok);
+            ASSERT (declen == len);
+            ASSERT (memeq (dec, data, len));
+          }
+      }
+}
+
+/* Check that base64_encode_ctx produces the same output as base64_encode,
+   regardless of how the input is split.  */
+static void
+test_encode_ctx (void)
+{
+  enum { LEN = 200 };
+  char data[LEN];
+  char ref[BASE64_LENGTH (LEN)];
+  char out[BASE64_LENGTH (LEN)];
+
+  for (int i = 0; i < LEN; i++)
+    data[i] = i * 7 + 3;
+  base64_encode (data, LEN, ref, sizeof ref);
+
+  for (idx_t chunk = 1; chunk <= LEN; chunk++)
+    {
+      struct base64_encode_context ctx;
+      idx_t outlen = 0;
+
+      base64_encode_ctx_init (&ctx);
+      for (idx_t i = 0; i < LEN; i += chunk)
+        {
+          idx_t n = LEN - i < chunk ? LEN - i : chunk;
+          char buf[BASE64_LENGTH (LEN + 2)];
+          idx_t k = base64_encode_ctx (&ctx, data + i, n, buf);
+          ASSERT (k <= BASE64_LENGTH (n + 2));
+          ASSERT (k % 4 == 0);
+          memcpy (out + outlen, buf, k);
+          outlen += k;
+        }
+      {
+        char buf[4];
+        idx_t k = base64_encode_ctx (&ctx, NULL, 0, buf);
+        memcpy (out + outlen, buf, k);
+        outlen += k;
+      }
+
+      ASSERT (outlen == sizeof ref);
+      ASSERT (memeq (out, ref, outlen));
+    }
+}
+
 int
 main (void)
 {
@@ -76,6 +239,31 @@ main (void)
   base64_encode (in, 4, out, 100);
   ASSERT (memeq (out, "YWJjZA==", 6));
 
+  /* Encode context function */
+  {
+    struct base64_encode_context ctx;
+    idx_t n;
+
+    base64_encode_ctx_init (&ctx);
+
+    memset (out, 0x42, sizeof (out));
+    n = base64_encode_ctx (&ctx, in, 2, out);
+    ASSERT (n == 0);
+    n = base64_encode_ctx (&ctx, in + 2, 2, out);
+    ASSERT (n == 4);
+    ASSERT (memeq (out, "YWJj", 4));
+    n = base64_encode_ctx (&ctx, in + 4, 1, out);
+    ASSERT (n == 0);
+    n = base64_encode_ctx (&ctx, NULL, 0, out);
+    ASSERT (n == 4);
+    ASSERT (memeq (out, "ZGU=", 4));
+    n = base64_encode_ctx (&ctx, NULL, 0, out);
+    ASSERT (n == 0);
+    ASSERT (out[4] == '\x42');
+  }
+
+  test_encode_ctx ();
+
   /* Decode. */
 
   memset (out, 0x42, sizeof (out));
@@ -242,5 +430,7 @@ main (void)
   ok = base64_decode_alloc_ctx (NULL, "TWF=TWE=", 8, &p, &len);
   ASSERT (!ok);
 
+  test_long ();
+
   return test_exit_status;
 }
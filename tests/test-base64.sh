@@ -0,0 +1,8 @@
+#!/bin/sh
+
+# Test each of the implementations that the CPU supports.
+${CHECKER} ./test-base64${EXEEXT} || exit 1
+GLIBC_TUNABLES=glibc.cpu.hwcaps=-AVX2 \
+  ${CHECKER} ./test-base64${EXEEXT} || exit 1
+GLIBC_TUNABLES=glibc.cpu.hwcaps=-AVX2,-SSSE3 \
+  ${CHECKER} ./test-base64${EXEEXT} || exit 1
@@ -0,0 +1,771 @@
+/* Test of sequential list data type implementation.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+#include "gl_btree_list.h"
+
+#include <stdcountof.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gl_array_list.h"
+#include "macros.h"
+
+extern void gl_btree_list_check_invariants (gl_list_t list);
+
+static const char *objects[15] =
+  {
+    "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o"
+  };
+
+#define RANDOM(n) (rand () % (n))
+#define RANDOM_OBJECT() objects[RANDOM (countof (objects))]
+
+/* Compares two array elements that point to strings, for qsort.  */
+static int
+compare_string_pointers (const void *p1, const void *p2)
+{
+  return strcmp (*(const char * const *) p1, *(const char * const *) p2);
+}
+
+static void
+check_equals (gl_list_t list1, gl_list_t list2)
+{
+  size_t n;
+
+  n = gl_list_size (list1);
+  ASSERT (n == gl_list_size (list2));
+  for (size_t i = 0; i < n; i++)
+    {
+      ASSERT (gl_list_get_at (list1, i) == gl_list_get_at (list2, i));
+    }
+}
+
+static void
+check_equals_by_forward_iteration (gl_list_t list1, gl_list_t list2)
+{
+  gl_list_node_t node1 = gl_list_first_node (list1);
+  gl_list_node_t node2 = gl_list_first_node (list2);
+  while (node1 != NULL && node2 != NULL)
+    {
+      ASSERT (gl_list_node_value (list1, node1)
+              == gl_list_node_value (list2, node2));
+      node1 = gl_list_next_node (list1, node1);
+      node2 = gl_list_next_node (list2, node2);
+    }
+  ASSERT ((node1 == NULL) == (node2 == NULL));
+}
+
+static void
+check_equals_by_backward_iteration (gl_list_t list1, gl_list_t list2)
+{
+  gl_list_node_t node1 = gl_list_last_node (list1);
+  gl_list_node_t node2 = gl_list_last_node (list2);
+  while (node1 != NULL && node2 != NULL)
+    {
+      ASSERT (gl_list_node_value (list1, node1)
+              == gl_list_node_value (list2, node2));
+      node1 = gl_list_previous_node (list1, node1);
+      node2 = gl_list_previous_node (list2, node2);
+    }
+  ASSERT ((node1 == NULL) == (node2 == NULL));
+}
+
+static void
+check_equals_by_iterator (gl_list_t list1, gl_list_t list2)
+{
+  size_t n = gl_list_size (list1);
+  gl_list_iterator_t iter = gl_list_iterator (list2);
+  const void *elt;
+  gl_list_node_t node;
+  for (size_t i = 0; i < n; i++)
+    {
+      ASSERT (gl_list_iterator_next (&iter, &elt, &node));
+      ASSERT (gl_list_get_at (list1, i) == elt);
+      ASSERT (gl_list_node_value (list2, node) == elt);
+    }
+  ASSERT (!gl_list_iterator_next (&iter, &elt, &node));
+  gl_list_iterator_free (&iter);
+}
+
+static int
+compare_strings (const void *elt1, const void *elt2)
+{
+  return strcmp ((const char *) elt1, (const char *) elt2);
+}
+
+static void
+check_all (gl_list_t list1, gl_list_t list2, gl_list_t list3)
+{
+  gl_btree_list_check_invariants (list2);
+  gl_btree_list_check_invariants (list3);
+  check_equals (list1, list2);
+  check_equals (list1, list3);
+}
+
+int
+main (int argc, char *argv[])
+{
+  gl_list_t list1, list2, list3;
+
+  /* Allow the user to provide a non-default random seed on the command line.  */
+  if (argc > 1)
+    srand (atoi (argv[1]));
+
+  {
+    size_t initial_size = RANDOM (50);
+    const void **contents =
+      (const void **) malloc (initial_size * sizeof (const void *));
+
+    for (size_t i = 0; i < initial_size; i++)
+      contents[i] = RANDOM_OBJECT ();
+
+    /* Create list1.  */
+    list1 = gl_list_nx_create (GL_ARRAY_LIST, NULL, NULL, NULL, true,
+                               initial_size, contents);
+    ASSERT (list1 != NULL);
+    /* Create list2.  */
+    list2 = gl_list_nx_create_empty (GL_BTREE_LIST, NULL, NULL, NULL, true);
+    ASSERT (list2 != NULL);
+    for (size_t i = 0; i < initial_size; i++)
+      ASSERT (gl_list_nx_add_last (list2, contents[i]) != NULL);
+
+    /* Create list3.  */
+    list3 = gl_list_nx_create (GL_BTREE_LIST, NULL, NULL, NULL, true,
+                               initial_size, contents);
+    ASSERT (list3 != NULL);
+
+    check_all (list1, list2, list3);
+
+    check_equals_by_forward_iteration (list1, list2);
+    check_equals_by_backward_iteration (list1, list2);
+    check_equals_by_iterator (list1, list2);
+
+    for (unsigned int repeat = 0; repeat < 10000; repeat++)
+      {
+        unsigned int operation = RANDOM (20);
+        switch (operation)
+          {
+          case 0:
+            if (gl_list_size (list1) > 0)
+              {
+                size_t index = RANDOM (gl_list_size (list1));
+                const char *obj = RANDOM_OBJECT ();
+                gl_list_node_t node1, node2, node3;
+
+                node1 = gl_list_nx_set_at (list1, index, obj);
+                ASSERT (node1 != NULL);
+                ASSERT (gl_list_get_at (list1, index) == obj);
+                ASSERT (gl_list_node_value (list1, node1) == obj);
+
+                node2 = gl_list_nx_set_at (list2, index, obj);
+                ASSERT (node2 != NULL);
+                ASSERT (gl_list_get_at (list2, index) == obj);
+                ASSERT (gl_list_node_value (list2, node2) == obj);
+
+                node3 = gl_list_nx_set_at (list3, index, obj);
+                ASSERT (node3 != NULL);
+                ASSERT (gl_list_get_at (list3, index) == obj);
+                ASSERT (gl_list_node_value (list3, node3) == obj);
+
+                if (index > 0)
+                  {
+                    ASSERT (gl_list_node_value (list1, gl_list_previous_node (list1, node1))
+                            == gl_list_get_at (list1, index - 1));
+                    ASSERT (gl_list_node_value (list2, gl_list_previous_node (list2, node2))
+                            == gl_list_get_at (list2, index - 1));
+                    ASSERT (gl_list_node_value (list3, gl_list_previous_node (list3, node3))
+                            == gl_list_get_at (list2, index - 1));
+                  }
+                if (index + 1 < gl_list_size (list1))
+                  {
+                    ASSERT (gl_list_node_value (list1, gl_list_next_node (list1, node1))
+                            == gl_list_get_at (list1, index + 1));
+                    ASSERT (gl_list_node_value (list2, gl_list_next_node (list2, node2))
+                            == gl_list_get_at (list2, index + 1));
+                    ASSERT (gl_list_node_value (list3, gl_list_next_node (list3, node3))
+                            == gl_list_get_at (list2, index + 1));
+                  }
+              }
+            break;
+          case 1:
+            {
+              const char *obj = RANDOM_OBJECT ();
+              gl_list_node_t node1, node2, node3;
+              node1 = gl_list_search (list1, obj);
+              node2 = gl_list_search (list2, obj);
+              node3 = gl_list_search (list3, obj);
+              if (node1 == NULL)
+                {
+                  ASSERT (node2 == NULL);
+                  ASSERT (node3 == NULL);
+                }
+              else
+                {
+                  ASSERT (node2 != NULL);
+                  ASSERT (node3 != NULL);
+                  ASSERT (gl_list_node_value (list1, node1) == obj);
+                  ASSERT (gl_list_node_value (list2, node2) == obj);
+                  ASSERT (gl_list_node_value (list3, node3) == obj);
+                }
+            }
+            break;
+          case 2:
+            {
+              const char *obj = RANDOM_OBJECT ();
+              size_t index1, index2, index3;
+              index1 = gl_list_indexof (list1, obj);
+              index2 = gl_list_indexof (list2, obj);
+              index3 = gl_list_indexof (list3, obj);
+              if (index1 == (size_t)(-1))
+                {
+                  ASSERT (index2 == (size_t)(-1));
+                  ASSERT (index3 == (size_t)(-1));
+                }
+              else
+                {
+                  ASSERT (index2 != (size_t)(-1));
+                  ASSERT (index3 != (size_t)(-1));
+                  ASSERT (gl_list_get_at (list1, index1) == obj);
+                  ASSERT (gl_list_get_at (list2, index2) == obj);
+                  ASSERT (gl_list_get_at (list3, index3) == obj);
+                  ASSERT (index2 == index1);
+                  ASSERT (index3 == index1);
+                }
+            }
+            break;
+          case 3: /* add 1 element */
+            {
+              const char *obj = RANDOM_OBJECT ();
+              gl_list_node_t node1, node2, node3;
+              node1 = gl_list_nx_add_first (list1, obj);
+              ASSERT (node1 != NULL);
+              node2 = gl_list_nx_add_first (list2, obj);
+              ASSERT (node2 != NULL);
+              node3 = gl_list_nx_add_first (list3, obj);
+              ASSERT (node3 != NULL);
+              ASSERT (gl_list_node_value (list1, node1) == obj);
+              ASSERT (gl_list_node_value (list2, node2) == obj);
+              ASSERT (gl_list_node_value (list3, node3) == obj);
+              ASSERT (gl_list_get_at (list1, 0) == obj);
+              ASSERT (gl_list_get_at (list2, 0) == obj);
+              ASSERT (gl_list_get_at (list3, 0) == obj);
+            }
+            break;
+          case 4: /* add 1 element */
+            {
+              const char *obj = RANDOM_OBJECT ();
+              gl_list_node_t node1, node2, node3;
+              node1 = gl_list_nx_add_last (list1, obj);
+              ASSERT (node1 != NULL);
+              node2 = gl_list_nx_add_last (list2, obj);
+              ASSERT (node2 != NULL);
+              node3 = gl_list_nx_add_last (list3, obj);
+              ASSERT (node3 != NULL);
+              ASSERT (gl_list_node_value (list1, node1) == obj);
+              ASSERT (gl_list_node_value (list2, node2) == obj);
+              ASSERT (gl_list_node_value (list3, node3) == obj);
+              ASSERT (gl_list_get_at (list1, gl_list_size (list1) - 1) == obj);
+              ASSERT (gl_list_get_at (list2, gl_list_size (list2) - 1) == obj);
+              ASSERT (gl_list_get_at (list3, gl_list_size (list3) - 1) == obj);
+            }
+            break;
+          case 5: /* add 3 elements */
+            {
+              const char *obj0 = RANDOM_OBJECT ();
+              const char *obj1 = RANDOM_OBJECT ();
+              const char *obj2 = RANDOM_OBJECT ();
+              gl_list_node_t node1, node2, node3;
+              node1 = gl_list_nx_add_first (list1, obj2);
+              ASSERT (node1 != NULL);
+              node1 = gl_list_nx_add_before (list1, node1, obj0);
+              ASSERT (node1 != NULL);
+              node1 = gl_list_nx_add_after (list1, node1, obj1);
+              ASSERT (node1 != NULL);
+              node2 = gl_list_nx_add_first (list2, obj2);
+              ASSERT (node2 != NULL);
+              node2 = gl_list_nx_add_before (list2, node2, obj0);
+              ASSERT (node2 != NULL);
+              node2 = gl_list_nx_add_after (list2, node2, obj1);
+              ASSERT (node2 != NULL);
+              node3 = gl_list_nx_add_first (list3, obj2);
+              ASSERT (node3 != NULL);
+              node3 = gl_list_nx_add_before (list3, node3, obj0);
+              ASSERT (node3 != NULL);
+              node3 = gl_list_nx_add_after (list3, node3, obj1);
+              ASSERT (node3 != NULL);
+              ASSERT (gl_list_node_value (list1, node1) == obj1);
+              ASSERT (gl_list_node_value (list2, node2) == obj1);
+              ASSERT (gl_list_node_value (list3, node3) == obj1);
+              ASSERT (gl_list_get_at (list1, 0) == obj0);
+              ASSERT (gl_list_get_at (list1, 1) == obj1);
+              ASSERT (gl_list_get_at (list1, 2) == obj2);
+              ASSERT (gl_list_get_at (list2, 0) == obj0);
+              ASSERT (gl_list_get_at (list2, 1) == obj1);
+              ASSERT (gl_list_get_at (list2, 2) == obj2);
+              ASSERT (gl_list_get_at (list3, 0) == obj0);
+              ASSERT (gl_list_get_at (list3, 1) == obj1);
+              ASSERT (gl_list_get_at (list3, 2) == obj2);
+            }
+            break;
+          case 6: /* add 1 element */
+            {
+              size_t index = RANDOM (gl_list_size (list1) + 1);
+              const char *obj = RANDOM_OBJECT ();
+              gl_list_node_t node1, node2, node3;
+              node1 = gl_list_nx_add_at (list1, index, obj);
+              ASSERT (node1 != NULL);
+              node2 = gl_list_nx_add_at (list2, index, obj);
+              ASSERT (node2 != NULL);
+              node3 = gl_list_nx_add_at (list3, index, obj);
+              ASSERT (node3 != NULL);
+              ASSERT (gl_list_get_at (list1, index) == obj);
+              ASSERT (gl_list_node_value (list1, node1) == obj);
+              ASSERT (gl_list_get_at (list2, index) == obj);
+              ASSERT (gl_list_node_value (list2, node2) == obj);
+              ASSERT (gl_list_get_at (list3, index) == obj);
+              ASSERT (gl_list_node_value (list3, node3) == obj);
+              if (index > 0)
+                {
+                  ASSERT (gl_list_node_value (list1, gl_list_previous_node (list1, node1))
+                          == gl_list_get_at (list1, index - 1));
+                  ASSERT (gl_list_node_value (list2, gl_list_previous_node (list2, node2))
+                          == gl_list_get_at (list2, index - 1));
+                  ASSERT (gl_list_node_value (list3, gl_list_previous_node (list3, node3))
+                          == gl_list_get_at (list2, index - 1));
+                }
+              if (index + 1 < gl_list_size (list1))
+                {
+                  ASSERT (gl_list_node_value (list1, gl_list_next_node (list1, node1))
+                          == gl_list_get_at (list1, index + 1));
+                  ASSERT (gl_list_node_value (list2, gl_list_next_node (list2, node2))
+                          == gl_list_get_at (list2, index + 1));
+                  ASSERT (gl_list_node_value (list3, gl_list_next_node (list3, node3))
+                          == gl_list_get_at (list2, index + 1));
+                }
+            }
+            break;
+          case 7: case 8: /* remove 1 element */
+            if (gl_list_size (list1) > 0)
+              {
+                size_t n = gl_list_size (list1);
+                const char *obj = gl_list_get_at (list1, RANDOM (n));
+                gl_list_node_t node1, node2, node3;
+                node1 = gl_list_search (list1, obj);
+                node2 = gl_list_search (list2, obj);
+                node3 = gl_list_search (list3, obj);
+                ASSERT (node1 != NULL);
+                ASSERT (node2 != NULL);
+                ASSERT (node3 != NULL);
+                ASSERT (gl_list_remove_node (list1, node1));
+                ASSERT (gl_list_remove_node (list2, node2));
+                ASSERT (gl_list_remove_node (list3, node3));
+                ASSERT (gl_list_size (list1) == n - 1);
+              }
+            break;
+          case 9: case 10: /* remove 1 element */
+            if (gl_list_size (list1) > 0)
+              {
+                size_t n = gl_list_size (list1);
+                size_t index = RANDOM (n);
+                ASSERT (gl_list_remove_at (list1, index));
+                ASSERT (gl_list_remove_at (list2, index));
+                ASSERT (gl_list_remove_at (list3, index));
+                ASSERT (gl_list_size (list1) == n - 1);
+              }
+            break;
+          case 11: /* remove first element */
+            {
+              size_t n = gl_list_size (list1);
+              bool removed1 = gl_list_remove_first (list1);
+              ASSERT (gl_list_remove_first (list2) == removed1);
+              ASSERT (gl_list_remove_first (list3) == removed1);
+              ASSERT (gl_list_size (list1) == n - (int) removed1);
+            }
+            break;
+          case 12: /* remove last element */
+            {
+              size_t n = gl_list_size (list1);
+              bool removed1 = gl_list_remove_last (list1);
+              ASSERT (gl_list_remove_last (list2) == removed1);
+              ASSERT (gl_list_remove_last (list3) == removed1);
+              ASSERT (gl_list_size (list1) == n - (int) removed1);
+            }
+            break;
+          case 13: case 14: /* remove 1 element */
+            if (gl_list_size (list1) > 0)
+              {
+                size_t n = gl_list_size (list1);
+                const char *obj = gl_list_get_at (list1, RANDOM (n));
+                ASSERT (gl_list_remove (list1, obj));
+                ASSERT (gl_list_remove (list2, obj));
+                ASSERT (gl_list_remove (list3, obj));
+                ASSERT (gl_list_size (list1) == n - 1);
+              }
+            break;
+          case 15:
+            if (gl_list_size (list1) > 0)
+              {
+                size_t n = gl_list_size (list1);
+                const char *obj = "xyzzy";
+                ASSERT (!gl_list_remove (list1, obj));
+                ASSERT (!gl_list_remove (list2, obj));
+                ASSERT (!gl_list_remove (list3, obj));
+                ASSERT (gl_list_size (list1) == n);
+              }
+            break;
+          case 16:
+            {
+              size_t n = gl_list_size (list1);
+              gl_list_iterator_t iter1, iter2, iter3;
+              const void *elt;
+              iter1 = gl_list_iterator (list1);
+              iter2 = gl_list_iterator (list2);
+              iter3 = gl_list_iterator (list3);
+              for (size_t i = 0; i < n; i++)
+                {
+                  ASSERT (gl_list_iterator_next (&iter1, &elt, NULL));
+                  ASSERT (gl_list_get_at (list1, i) == elt);
+                  ASSERT (gl_list_iterator_next (&iter2, &elt, NULL));
+                  ASSERT (gl_list_get_at (list2, i) == elt);
+                  ASSERT (gl_list_iterator_next (&iter3, &elt, NULL));
+                  ASSERT (gl_list_get_at (list3, i) == elt);
+                }
+              ASSERT (!gl_list_iterator_next (&iter1, &elt, NULL));
+              ASSERT (!gl_list_iterator_next (&iter2, &elt, NULL));
+              ASSERT (!gl_list_iterator_next (&iter3, &elt, NULL));
+              gl_list_iterator_free (&iter1);
+              gl_list_iterator_free (&iter2);
+              gl_list_iterator_free (&iter3);
+            }
+            break;
+          case 17:
+            {
+              size_t end = RANDOM (gl_list_size (list1) + 1);
+              size_t start = RANDOM (end + 1);
+              gl_list_iterator_t iter1, iter2, iter3;
+              const void *elt;
+              iter1 = gl_list_iterator_from_to (list1, start, end);
+              iter2 = gl_list_iterator_from_to (list2, start, end);
+              iter3 = gl_list_iterator_from_to (list3, start, end);
+              for (size_t i = start; i < end; i++)
+                {
+                  ASSERT (gl_list_iterator_next (&iter1, &elt, NULL));
+                  ASSERT (gl_list_get_at (list1, i) == elt);
+                  ASSERT (gl_list_iterator_next (&iter2, &elt, NULL));
+                  ASSERT (gl_list_get_at (list2, i) == elt);
+                  ASSERT (gl_list_iterator_next (&iter3, &elt, NULL));
+                  ASSERT (gl_list_get_at (list3, i) == elt);
+                }
+              ASSERT (!gl_list_iterator_next (&iter1, &elt, NULL));
+              ASSERT (!gl_list_iterator_next (&iter2, &elt, NULL));
+              ASSERT (!gl_list_iterator_next (&iter3, &elt, NULL));
+              gl_list_iterator_free (&iter1);
+              gl_list_iterator_free (&iter2);
+              gl_list_iterator_free (&iter3);
+            }
+            break;
+          case 18: /* add several elements */
+            {
+              size_t index = RANDOM (gl_list_size (list1) + 1);
+              size_t count = RANDOM (5);
+              const void *objs[4];
+              for (size_t i = 0; i < count; i++)
+                {
+                  objs[i] = RANDOM_OBJECT ();
+                  ASSERT (gl_list_nx_add_at (list1, index + i, objs[i]) != NULL);
+                }
+              ASSERT (gl_list_nx_add_all_at (list2, index, count, objs) == 0);
+              ASSERT (gl_list_nx_add_all_at (list3, index, count, objs) == 0);
+            }
+            break;
+          case 19: /* remove several elements */
+            {
+              size_t n = gl_list_size (list1);
+              size_t start = RANDOM (n + 1);
+              size_t count = RANDOM (5);
+              if (count > n - start)
+                count = n - start;
+              for (size_t i = 0; i < count; i++)
+                ASSERT (gl_list_remove_at (list1, start));
+              gl_list_remove_range (list2, start, start + count);
+              gl_list_remove_range (list3, start, start + count);
+              ASSERT (gl_list_size (list1) == n - count);
+            }
+            break;
+          }
+        check_all (list1, list2, list3);
+      }
+
+    gl_list_free (list1);
+    gl_list_free (list2);
+    gl_list_free (list3);
+    free (contents);
+  }
+
+  /* Test large lists, whose trees have several levels of branches.  */
+  {
+    size_t initial_size = 20000 + RANDOM (20000);
+    const void **contents =
+      (const void **) malloc (initial_size * sizeof (const void *));
+
+    for (size_t i = 0; i < initial_size; i++)
+      contents[i] = RANDOM_OBJECT ();
+
+    list1 = gl_list_nx_create (GL_ARRAY_LIST, NULL, NULL, NULL, true,
+                               initial_size, contents);
+    ASSERT (list1 != NULL);
+    list2 = gl_list_nx_create_empty (GL_BTREE_LIST, NULL, NULL, NULL, true);
+    ASSERT (list2 != NULL);
+    for (size_t i = 0; i < initial_size; i++)
+      ASSERT (gl_list_nx_add_last (list2, contents[i]) != NULL);
+    list3 = gl_list_nx_create (GL_BTREE_LIST, NULL, NULL, NULL, true,
+                               initial_size, contents);
+    ASSERT (list3 != NULL);
+
+    check_all (list1, list2, list3);
+    check_equals_by_iterator (list1, list2);
+    check_equals_by_iterator (list1, list3);
+
+    for (unsigned int repeat = 0; repeat < 40000; repeat++)
+      {
+        size_t n = gl_list_size (list1);
+        switch (RANDOM (5))
+          {
+          case 0: case 1: /* add 1 element */
+            {
+              size_t index = RANDOM (n + 1);
+              const char *obj = RANDOM_OBJECT ();
+              ASSERT (gl_list_nx_add_at (list1, index, obj) != NULL);
+              ASSERT (gl_list_nx_add_at (list2, index, obj) != NULL);
+              ASSERT (gl_list_nx_add_at (list3, index, obj) != NULL);
+            }
+            break;
+          case 2: case 3: /* remove 1 element */
+            if (n > 0)
+              {
+                size_t index = RANDOM (n);
+                ASSERT (gl_list_remove_at (list1, index));
+                ASSERT (gl_list_remove_at (list2, index));
+                ASSERT (gl_list_remove_at (list3, index));
+              }
+            break;
+          case 4:
+            if (n > 0)
+              {
+                size_t index = RANDOM (n);
+                const char *obj = RANDOM_OBJECT ();
+                ASSERT (gl_list_nx_set_at (list1, index, obj) != NULL);
+                ASSERT (gl_list_nx_set_at (list2, index, obj) != NULL);
+                ASSERT (gl_list_nx_set_at (list3, index, obj) != NULL);
+              }
+            break;
+          }
+        if ((repeat % 1000) == 0)
+          check_all (list1, list2, list3);
+      }
+    check_all (list1, list2, list3);
+    check_equals_by_iterator (list1, list2);
+
+    /* Search in ranges that span several leaves.  */
+    for (unsigned int repeat = 0; repeat < 100; repeat++)
+      {
+        size_t n = gl_list_size (list1);
+        size_t end = RANDOM (n + 1);
+        size_t start = RANDOM (end + 1);
+        const char *obj = RANDOM_OBJECT ();
+        ASSERT (gl_list_indexof_from_to (list2, start, end, obj)
+                == gl_list_indexof_from_to (list1, start, end, obj));
+      }
+
+    /* Remove all occurrences of an element while iterating.  */
+    {
+      const char *obj = RANDOM_OBJECT ();
+      gl_list_iterator_t iter;
+      const void *elt;
+      gl_list_node_t node;
+
+      iter = gl_list_iterator (list1);
+      while (gl_list_iterator_next (&iter, &elt, &node))
+        if (elt == obj)
+          ASSERT (gl_list_remove_node (list1, node));
+      gl_list_iterator_free (&iter);
+
+      iter = gl_list_iterator (list2);
+      while (gl_list_iterator_next (&iter, &elt, &node))
+        if (elt == obj)
+          ASSERT (gl_list_remove_node (list2, node));
+      gl_list_iterator_free (&iter);
+
+      iter = gl_list_iterator (list3);
+      while (gl_list_iterator_next (&iter, &elt, &node))
+        if (elt == obj)
+          ASSERT (gl_list_remove_node (list3, node));
+      gl_list_iterator_free (&iter);
+
+      check_all (list1, list2, list3);
+    }
+
+    /* Empty the lists, from the end and from random positions.  */
+    while (gl_list_size (list1) > 0)
+      {
+        size_t n = gl_list_size (list1);
+        size_t index = (RANDOM (2) ? n - 1 : RANDOM (n));
+        ASSERT (gl_list_remove_at (list1, index));
+        ASSERT (gl_list_remove_at (list2, index));
+        ASSERT (gl_list_remove_at (list3, index));
+        if ((n % 1000) == 0)
+          check_all (list1, list2, list3);
+      }
+    check_all (list1, list2, list3);
+    ASSERT (gl_list_first_node (list2) == NULL);
+
+    gl_list_free (list1);
+    gl_list_free (list2);
+    gl_list_free (list3);
+    free (contents);
+  }
+
+  /* Test sorted lists.  */
+  {
+    list1 = gl_list_nx_create_empty (GL_ARRAY_LIST, NULL, NULL, NULL, true);
+    ASSERT (list1 != NULL);
+    list2 = gl_list_nx_create_empty (GL_BTREE_LIST, NULL, NULL, NULL, true);
+    ASSERT (list2 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 5000; repeat++)
+      {
+        const char *obj = objects[RANDOM (countof (objects) - 1)];
+        ASSERT (gl_sortedlist_nx_add (list1, compare_strings, obj) != NULL);
+        ASSERT (gl_sortedlist_nx_add (list2, compare_strings, obj) != NULL);
+      }
+    check_equals (list1, list2);
+    gl_btree_list_check_invariants (list2);
+
+    for (unsigned int repeat = 0; repeat < 1000; repeat++)
+      {
+        size_t n = gl_list_size (list1);
+        size_t high = RANDOM (n + 1);
+        size_t low = RANDOM (high + 1);
+        const char *obj = RANDOM_OBJECT ();
+        size_t index1 =
+          gl_sortedlist_indexof_from_to (list1, compare_strings, low, high,
+                                         obj);
+        size_t index2 =
+          gl_sortedlist_indexof_from_to (list2, compare_strings, low, high,
+                                         obj);
+        ASSERT (index2 == index1);
+        switch (RANDOM (2))
+          {
+          case 0:
+            ASSERT (gl_sortedlist_remove (list2, compare_strings, obj)
+                    == gl_sortedlist_remove (list1, compare_strings, obj));
+            break;
+          case 1:
+            ASSERT (gl_sortedlist_nx_add (list1, compare_strings, obj) != NULL);
+            ASSERT (gl_sortedlist_nx_add (list2, compare_strings, obj) != NULL);
+            break;
+          }
+      }
+    check_equals (list1, list2);
+    gl_btree_list_check_invariants (list2);
+
+    gl_list_free (list1);
+    gl_list_free (list2);
+  }
+
+  /* Test the bulk operations on larger sorted lists, where some
+     implementations process the elements one by one and others rebuild the
+     entire list.  The reference list1 is modified one element at a time.  */
+  {
+    size_t n = 1000;
+    const void **contents =
+      (const void **) malloc (n * sizeof (const void *));
+    for (size_t i = 0; i < n; i++)
+      contents[i] = objects[i * countof (objects) / n];
+
+    list1 = gl_list_nx_create (GL_ARRAY_LIST,
+                               NULL, NULL, NULL, true,
+                               n, contents);
+    ASSERT (list1 != NULL);
+    list2 = gl_list_nx_create (GL_BTREE_LIST,
+                               NULL, NULL, NULL, true,
+                               n, contents);
+    ASSERT (list2 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 200; repeat++)
+      {
+        size_t size = gl_list_size (list1);
+        size_t count = (RANDOM (2) ? RANDOM (size / 32 + 1) : RANDOM (n + 1));
+        switch (RANDOM (3))
+          {
+          case 0: /* add copies of an element, keeping the list sorted */
+            {
+              size_t index = RANDOM (size + 1);
+              const void *obj =
+                (index < size
+                 ? gl_list_get_at (list1, index)
+                 : objects[countof (objects) - 1]);
+              for (size_t i = 0; i < count; i++)
+                {
+                  contents[i] = obj;
+                  ASSERT (gl_list_nx_add_at (list1, index, obj) != NULL);
+                }
+              ASSERT (gl_list_nx_add_all_at (list2, index, count, contents)
+                      == 0);
+            }
+            break;
+          case 1: /* remove a range of elements */
+            {
+              size_t start = RANDOM (size + 1);
+              if (count > size - start)
+                count = size - start;
+              for (size_t i = 0; i < count; i++)
+                ASSERT (gl_list_remove_at (list1, start));
+              gl_list_remove_range (list2, start, start + count);
+            }
+            break;
+          case 2: /* merge a sorted array */
+            for (size_t i = 0; i < count; i++)
+              contents[i] = RANDOM_OBJECT ();
+            qsort (contents, count, sizeof (const void *),
+                   compare_string_pointers);
+            for (size_t i = 0; i < count; i++)
+              ASSERT (gl_sortedlist_nx_add (list1, compare_strings,
+                                            contents[i])
+                      != NULL);
+            ASSERT (gl_sortedlist_nx_merge_array (list2, compare_strings,
+                                                  count, contents)
+                    == 0);
+            break;
+          }
+        gl_btree_list_check_invariants (list2);
+        check_equals (list1, list2);
+        {
+          const char *obj = RANDOM_OBJECT ();
+          ASSERT (gl_list_indexof (list2, obj)
+                  == gl_list_indexof (list1, obj));
+        }
+      }
+
+    gl_list_free (list1);
+    gl_list_free (list2);
+    free (contents);
+  }
+
+  return test_exit_status;
+}
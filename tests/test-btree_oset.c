@@ -0,0 +1,438 @@
+/* Test of ordered set data type implementation.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+#include "gl_btree_oset.h"
+
+#include <stdcountof.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "gl_array_oset.h"
+#include "gl_avltree_oset.h"
+#include "macros.h"
+
+extern void gl_btree_oset_check_invariants (gl_oset_t set);
+
+static const char *objects[30] =
+  {
+    "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o",
+    "p", "q", "r", "s", "t", "u", "v", "w", "x", "y", "z", "<", ">", "[", "]"
+  };
+
+#define RANDOM(n) (rand () % (n))
+#define RANDOM_OBJECT() objects[RANDOM (countof (objects))]
+
+static void
+check_equals (gl_oset_t set1, gl_oset_t set2)
+{
+  size_t n = gl_oset_size (set1);
+  gl_oset_iterator_t iter1, iter2;
+  const void *elt1;
+  const void *elt2;
+
+  ASSERT (gl_oset_size (set2) == n);
+  iter1 = gl_oset_iterator (set1);
+  iter2 = gl_oset_iterator (set2);
+  for (size_t i = 0; i < n; i++)
+    {
+      ASSERT (gl_oset_iterator_next (&iter1, &elt1));
+      ASSERT (gl_oset_iterator_next (&iter2, &elt2));
+      ASSERT (elt1 == elt2);
+    }
+  ASSERT (!gl_oset_iterator_next (&iter1, &elt1));
+  ASSERT (!gl_oset_iterator_next (&iter2, &elt2));
+  gl_oset_iterator_free (&iter1);
+  gl_oset_iterator_free (&iter2);
+}
+
+static void
+check_all (gl_oset_t set1, gl_oset_t set2)
+{
+  gl_btree_oset_check_invariants (set2);
+  check_equals (set1, set2);
+}
+
+static int
+string_compare (const void *elt1, const void *elt2)
+{
+  const char *s1 = elt1;
+  const char *s2 = elt2;
+  return strcmp (s1, s2);
+}
+
+static bool
+is_at_least (const void *elt, const void *threshold)
+{
+  return strcmp ((const char *) elt, (const char *) threshold) >= 0;
+}
+
+/* For the large sets, the elements are small integers, compared as
+   pointers.  */
+#define INT_ELT(i) ((const void *) (uintptr_t) (i))
+
+static bool
+int_is_at_least (const void *elt, const void *threshold)
+{
+  return (uintptr_t) elt >= (uintptr_t) threshold;
+}
+
+static int
+cell_compare (const void *elt1, const void *elt2)
+{
+  int v1 = *(const int *) elt1;
+  int v2 = *(const int *) elt2;
+  return (v1 > v2) - (v1 < v2);
+}
+
+static void
+set_cell (const void *elt, void *data)
+{
+  *(int *) elt = *(int *) data;
+}
+
+#include "test-oset-update.h"
+
+int
+main (int argc, char *argv[])
+{
+  gl_oset_t set1, set2;
+
+  /* Allow the user to provide a non-default random seed on the command line.  */
+  if (argc > 1)
+    srand (atoi (argv[1]));
+
+  {
+    size_t initial_size = RANDOM (20);
+
+    /* Create set1.  */
+    set1 = gl_oset_nx_create_empty (GL_ARRAY_OSET, string_compare, NULL);
+    ASSERT (set1 != NULL);
+
+    /* Create set2.  */
+    set2 = gl_oset_nx_create_empty (GL_BTREE_OSET, string_compare, NULL);
+    ASSERT (set2 != NULL);
+
+    check_all (set1, set2);
+
+    /* Initialize them.  */
+    for (size_t i = 0; i < initial_size; i++)
+      {
+        const char *obj = RANDOM_OBJECT ();
+        ASSERT (gl_oset_nx_add (set1, obj) == gl_oset_nx_add (set2, obj));
+        check_all (set1, set2);
+      }
+
+    for (unsigned int repeat = 0; repeat < 100000; repeat++)
+      {
+        unsigned int operation = RANDOM (4);
+        switch (operation)
+          {
+          case 0:
+            {
+              const char *obj = RANDOM_OBJECT ();
+              ASSERT (gl_oset_search (set1, obj) == gl_oset_search (set2, obj));
+            }
+            break;
+          case 1:
+            {
+              const char *obj = RANDOM_OBJECT ();
+              ASSERT (gl_oset_nx_add (set1, obj) == gl_oset_nx_add (set2, obj));
+            }
+            break;
+          case 2:
+            {
+              const char *obj = RANDOM_OBJECT ();
+              ASSERT (gl_oset_remove (set1, obj) == gl_oset_remove (set2, obj));
+            }
+            break;
+          case 3:
+            {
+              const char *obj = RANDOM_OBJECT ();
+              gl_oset_iterator_t iter1 = gl_oset_iterator_atleast (set1, is_at_least, obj);
+              gl_oset_iterator_t iter2 = gl_oset_iterator_atleast (set2, is_at_least, obj);
+              const void *elt1;
+              const void *elt2;
+              /* Check the first two values that the iterator produces.
+                 Checking them all would make this part of the test dominate the
+                 run time of the test.  */
+              bool havenext1 = gl_oset_iterator_next (&iter1, &elt1);
+              bool havenext2 = gl_oset_iterator_next (&iter2, &elt2);
+              ASSERT (havenext1 == havenext2);
+              if (havenext1)
+                {
+                  ASSERT (elt1 == elt2);
+                  havenext1 = gl_oset_iterator_next (&iter1, &elt1);
+                  havenext2 = gl_oset_iterator_next (&iter2, &elt2);
+                  ASSERT (havenext1 == havenext2);
+                  if (havenext1)
+                    ASSERT (elt1 == elt2);
+                }
+              gl_oset_iterator_free (&iter1);
+              gl_oset_iterator_free (&iter2);
+            }
+            break;
+          }
+        check_all (set1, set2);
+      }
+
+    gl_oset_free (set1);
+    gl_oset_free (set2);
+  }
+
+  /* Test gl_oset_nx_add_sorted_array on sets large enough that the
+     elements get merged in a single pass.  The reference set1 is modified
+     one element at a time.  */
+  {
+    size_t n = 1000;
+    const void **contents =
+      (const void **) malloc (n * sizeof (const void *));
+    ASSERT (contents != NULL);
+
+    set1 = gl_oset_nx_create_empty (GL_ARRAY_OSET, NULL, NULL);
+    ASSERT (set1 != NULL);
+    set2 = gl_oset_nx_create_empty (GL_BTREE_OSET, NULL, NULL);
+    ASSERT (set2 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 200; repeat++)
+      {
+        size_t size = gl_oset_size (set1);
+        size_t count = (RANDOM (2) ? RANDOM (size / 32 + 1) : RANDOM (n + 1));
+        /* Sorted elements, with repetitions, some of which are already in
+           the set.  */
+        uintptr_t value = 1 + RANDOM (4 * n);
+        for (size_t i = 0; i < count; i++)
+          {
+            contents[i] = INT_ELT (value);
+            value += RANDOM (4);
+          }
+        for (size_t i = 0; i < count; i++)
+          ASSERT (gl_oset_nx_add (set1, contents[i]) >= 0);
+        ASSERT (gl_oset_nx_add_sorted_array (set2, count, contents) == 0);
+        /* Remove some elements, so that the size stays bounded.  */
+        for (size_t i = RANDOM (count + 1); i > 0; i--)
+          {
+            const void *obj = INT_ELT (1 + RANDOM (4 * n));
+            ASSERT (gl_oset_remove (set1, obj) == gl_oset_remove (set2, obj));
+          }
+        check_all (set1, set2);
+      }
+
+    gl_oset_free (set1);
+    gl_oset_free (set2);
+    free (contents);
+  }
+
+  test_update (GL_BTREE_OSET);
+
+  /* Test large sets, with several levels of branches.  */
+  {
+    const size_t n = 4000;
+
+    set1 = gl_oset_nx_create_empty (GL_ARRAY_OSET, NULL, NULL);
+    ASSERT (set1 != NULL);
+    set2 = gl_oset_nx_create_empty (GL_BTREE_OSET, NULL, NULL);
+    ASSERT (set2 != NULL);
+
+    for (unsigned int repeat = 0; repeat < 200000; repeat++)
+      {
+        /* Let the size of the sets go up and down.  */
+        unsigned int operation =
+          ((repeat / 50000) % 2 == 0 ? RANDOM (5) : RANDOM (5) + 1);
+        const void *obj = INT_ELT (1 + RANDOM (n));
+        switch (operation)
+          {
+          case 0: case 1:
+            ASSERT (gl_oset_nx_add (set1, obj) == gl_oset_nx_add (set2, obj));
+            break;
+          case 2: case 3:
+            ASSERT (gl_oset_remove (set1, obj) == gl_oset_remove (set2, obj));
+            break;
+          case 4: case 5:
+            {
+              const void *elt1;
+              const void *elt2;
+              bool found1 = gl_oset_search_atleast (set1, int_is_at_least, obj,
+                                                    &elt1);
+              bool found2 = gl_oset_search_atleast (set2, int_is_at_least, obj,
+                                                    &elt2);
+              ASSERT (found1 == found2);
+              if (found1)
+                ASSERT (elt1 == elt2);
+              ASSERT (gl_oset_search (set1, obj) == gl_oset_search (set2, obj));
+            }
+            break;
+          }
+        if ((repeat % 1000) == 0)
+          check_all (set1, set2);
+      }
+    check_all (set1, set2);
+
+    /* Compare entire tails.  */
+    for (size_t threshold = 0; threshold <= n + 1; threshold += 97)
+      {
+        gl_oset_iterator_t iter1 =
+          gl_oset_iterator_atleast (set1, int_is_at_least, INT_ELT (threshold));
+        gl_oset_iterator_t iter2 =
+          gl_oset_iterator_atleast (set2, int_is_at_least, INT_ELT (threshold));
+        const void *elt1;
+        const void *elt2;
+        bool havenext1;
+        do
+          {
+            havenext1 = gl_oset_iterator_next (&iter1, &elt1);
+            ASSERT (gl_oset_iterator_next (&iter2, &elt2) == havenext1);
+            if (havenext1)
+              ASSERT (elt1 == elt2);
+          }
+        while (havenext1);
+        gl_oset_iterator_free (&iter1);
+        gl_oset_iterator_free (&iter2);
+      }
+
+    /* Remove every other element while iterating.  */
+    {
+      gl_oset_iterator_t iter2 = gl_oset_iterator (set2);
+      const void *elt;
+      bool odd = false;
+      while (gl_oset_iterator_next (&iter2, &elt))
+        {
+          if (odd)
+            {
+              ASSERT (gl_oset_remove (set1, elt));
+              ASSERT (gl_oset_remove (set2, elt));
+            }
+          odd = !odd;
+        }
+      gl_oset_iterator_free (&iter2);
+      check_all (set1, set2);
+    }
+
+    gl_oset_free (set1);
+    gl_oset_free (set2);
+  }
+
+  /* Test gl_oset_nx_create.  */
+  {
+    static const size_t sizes[] = { 0, 1, 2, 59, 60, 61, 121, 1800, 1801, 60000 };
+    for (size_t s = 0; s < countof (sizes); s++)
+      {
+        size_t n = sizes[s];
+        const void **contents =
+          (const void **) malloc ((n + 1) * sizeof (const void *));
+        ASSERT (contents != NULL);
+        for (size_t i = 0; i < n; i++)
+          contents[i] = INT_ELT (2 * i + 2);
+
+        set1 = gl_oset_nx_create (GL_ARRAY_OSET, NULL, NULL, n, contents);
+        ASSERT (set1 != NULL);
+        set2 = gl_oset_nx_create (GL_BTREE_OSET, NULL, NULL, n, contents);
+        ASSERT (set2 != NULL);
+        check_all (set1, set2);
+
+        /* The binary tree implementation gives the same result.  */
+        {
+          gl_oset_t set3 =
+            gl_oset_nx_create (GL_AVLTREE_OSET, NULL, NULL, n, contents);
+          ASSERT (set3 != NULL);
+          check_equals (set3, set1);
+          gl_oset_free (set3);
+        }
+
+        /* Insert between the elements, at the ends, and remove.  */
+        for (size_t i = 0; i < n / 2 + 10; i++)
+          {
+            const void *obj = INT_ELT (1 + RANDOM (2 * n + 3));
+            ASSERT (gl_oset_nx_add (set1, obj) == gl_oset_nx_add (set2, obj));
+            obj = INT_ELT (1 + RANDOM (2 * n + 3));
+            ASSERT (gl_oset_remove (set1, obj) == gl_oset_remove (set2, obj));
+          }
+        check_all (set1, set2);
+        while (gl_oset_size (set1) > 0)
+          {
+            const void *elt;
+            ASSERT (gl_oset_search_atleast (set1, int_is_at_least,
+                                            INT_ELT (RANDOM (2 * n + 3)),
+                                            &elt)
+                    || gl_oset_search_atleast (set1, int_is_at_least,
+                                               INT_ELT (0), &elt));
+            ASSERT (gl_oset_remove (set1, elt));
+            ASSERT (gl_oset_remove (set2, elt));
+            if ((gl_oset_size (set1) % 256) == 0)
+              check_all (set1, set2);
+          }
+        check_all (set1, set2);
+
+        gl_oset_free (set1);
+        gl_oset_free (set2);
+        free (contents);
+      }
+  }
+
+  /* Test gl_oset_update on a large set, where the element moves between
+     leaves.  */
+  {
+    const size_t n = 2000;
+    int *cells = (int *) malloc (n * sizeof (int));
+    bool *present = (bool *) malloc (n * sizeof (bool));
+    ASSERT (cells != NULL && present != NULL);
+
+    set2 = gl_oset_nx_create_empty (GL_BTREE_OSET, cell_compare, NULL);
+    ASSERT (set2 != NULL);
+    for (size_t i = 0; i < n; i++)
+      {
+        cells[i] = 2 * i;
+        present[i] = true;
+        ASSERT (gl_oset_nx_add (set2, &cells[i]) == 1);
+      }
+    gl_btree_oset_check_invariants (set2);
+
+    size_t count = n;
+    for (unsigned int repeat = 0; repeat < 10000; repeat++)
+      {
+        size_t i = RANDOM (n);
+        if (present[i])
+          {
+            int new_value = RANDOM (2 * n + 100) - 50;
+            int result = gl_oset_update (set2, &cells[i], set_cell, &new_value);
+            if (result < 0)
+              {
+                present[i] = false;
+                count--;
+                /* A cell with the same value is in the set.  */
+                ASSERT (gl_oset_search (set2, &cells[i]));
+              }
+            else
+              ASSERT (gl_oset_search (set2, &cells[i]));
+            ASSERT (gl_oset_size (set2) == count);
+            if ((repeat % 100) == 0)
+              gl_btree_oset_check_invariants (set2);
+          }
+      }
+    gl_btree_oset_check_invariants (set2);
+    for (size_t i = 0; i < n; i++)
+      if (present[i])
+        ASSERT (gl_oset_search (set2, &cells[i]));
+
+    gl_oset_free (set2);
+    free (present);
+    free (cells);
+  }
+
+  return test_exit_status;
+}
@@ -0,0 +1,253 @@
+/* Test of the concurrent hash table.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+#include "concurrent-hash.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "glthread/thread.h"
+#include "glthread/yield.h"
+#include "simple-atomic.h"
+
+#include "macros.h"
+
+/* Number of simultaneous threads that modify the table, and that only
+   look up entries.  */
+#define MUTATOR_COUNT 4
+#define READER_COUNT 4
+
+/* Number of entries that each mutator inserts and removes in a round.  */
+#define MUTATOR_KEYS 500
+
+/* Number of rounds of each mutator.  */
+#define REPEAT_COUNT 20
+
+/* Number of entries that stay in the table while the threads run.  */
+#define PERMANENT_KEYS 1000
+
+struct item
+{
+  unsigned int key;
+};
+
+/* The number of items allocated, and freed by the data freer.  */
+static unsigned int volatile allocated;
+static unsigned int volatile freed;
+
+static void
+increment (unsigned int volatile *counter)
+{
+  unsigned int old;
+  do
+    old = *counter;
+  while (atomic_compare_and_swap (counter, old, old + 1) != old);
+}
+
+static struct item *
+new_item (unsigned int key)
+{
+  struct item *item = malloc (sizeof *item);
+  ASSERT (item);
+  item->key = key;
+  increment (&allocated);
+  return item;
+}
+
+static size_t
+item_hasher (const void *x, size_t table_size)
+{
+  const struct item *item = x;
+  return item->key % table_size;
+}
+
+static bool
+item_comparator (const void *x, const void *y)
+{
+  const struct item *a = x;
+  const struct item *b = y;
+  return a->key == b->key;
+}
+
+static void
+item_freer (void *x)
+{
+  struct item *item = x;
+  /* Make uses after free more visible.  */
+  item->key = UINT_MAX;
+  free (item);
+  increment (&freed);
+}
+
+static void
+test_single_thread (void)
+{
+  enum { N = 10000 };
+  Chash_table *table = chash_initialize (0, item_hasher, item_comparator,
+                                         item_freer);
+  ASSERT (table);
+  ASSERT (chash_get_n_entries (table) == 0);
+
+  for (unsigned int i = 0; i < N; i++)
+    ASSERT (chash_insert_if_absent (table, new_item (i), NULL) == 1);
+  ASSERT (chash_get_n_entries (table) == N);
+
+  for (unsigned int i = 0; i < N; i++)
+    {
+      struct item key = { i };
+      struct item *found = chash_lookup (table, &key);
+      const void *matched = NULL;
+      ASSERT (found && found->key == i);
+      ASSERT (chash_insert_if_absent (table, &key, &matched) == 0);
+      ASSERT (matched == found);
+    }
+  {
+    struct item key = { N };
+    ASSERT (chash_lookup (table, &key) == NULL);
+    ASSERT (!chash_remove (table, &key));
+  }
+
+  for (unsigned int i = 0; i < N; i += 2)
+    {
+      struct item key = { i };
+      ASSERT (chash_remove (table, &key));
+      ASSERT (!chash_remove (table, &key));
+    }
+  ASSERT (chash_get_n_entries (table) == N / 2);
+  for (unsigned int i = 0; i < N; i++)
+    {
+      struct item key = { i };
+      unsigned int cookie = chash_read_lock (table);
+      struct item *found = chash_lookup (table, &key);
+      ASSERT (i % 2 == 0 ? found == NULL : found && found->key == i);
+      chash_read_unlock (table, cookie);
+    }
+
+  chash_free (table);
+  ASSERT (freed == allocated);
+}
+
+#if USE_ISOC_THREADS || USE_POSIX_THREADS || USE_ISOC_AND_POSIX_THREADS || USE_WINDOWS_THREADS
+
+static Chash_table *shared_table;
+
+static unsigned int volatile mutators_done;
+
+static void *
+mutator_thread (void *arg)
+{
+  unsigned int first = (uintptr_t) arg;
+
+  for (int repeat = REPEAT_COUNT; repeat > 0; repeat--)
+    {
+      for (unsigned int i = first; i < first + MUTATOR_KEYS; i++)
+        ASSERT (chash_insert_if_absent (shared_table, new_item (i), NULL)
+                == 1);
+      gl_thread_yield ();
+      for (unsigned int i = first; i < first + MUTATOR_KEYS; i++)
+        {
+          struct item key = { i };
+          ASSERT (chash_lookup (shared_table, &key) != NULL);
+        }
+      for (unsigned int i = first; i < first + MUTATOR_KEYS; i++)
+        {
+          struct item key = { i };
+          ASSERT (chash_remove (shared_table, &key));
+          ASSERT (chash_lookup (shared_table, &key) == NULL);
+        }
+      gl_thread_yield ();
+    }
+
+  increment (&mutators_done);
+  return NULL;
+}
+
+static void *
+reader_thread (_GL_UNUSED void *arg)
+{
+  while (mutators_done < MUTATOR_COUNT)
+    {
+      for (unsigned int i = 0;
+           i < PERMANENT_KEYS + MUTATOR_COUNT * MUTATOR_KEYS;
+           i++)
+        {
+          struct item key = { i };
+          unsigned int cookie = chash_read_lock (shared_table);
+          struct item *found = chash_lookup (shared_table, &key);
+          /* The permanent entries must always be found, even while the
+             table grows.  The other entries come and go, but must not be
+             freed while we look at them.  */
+          if (i < PERMANENT_KEYS)
+            ASSERT (found != NULL);
+          if (found)
+            ASSERT (found->key == i);
+          chash_read_unlock (shared_table, cookie);
+        }
+      gl_thread_yield ();
+    }
+
+  return NULL;
+}
+
+static void
+test_threads (void)
+{
+  gl_thread_t mutators[MUTATOR_COUNT];
+  gl_thread_t readers[READER_COUNT];
+
+  allocated = freed = 0;
+  shared_table = chash_initialize (0, item_hasher, item_comparator,
+                                   item_freer);
+  ASSERT (shared_table);
+  for (unsigned int i = 0; i < PERMANENT_KEYS; i++)
+    ASSERT (chash_insert_if_absent (shared_table, new_item (i), NULL) == 1);
+
+  for (int i = 0; i < READER_COUNT; i++)
+    readers[i] = gl_thread_create (reader_thread, NULL);
+  for (int i = 0; i < MUTATOR_COUNT; i++)
+    mutators[i] =
+      gl_thread_create (mutator_thread,
+                        (void *) (uintptr_t) (PERMANENT_KEYS
+                                              + i * MUTATOR_KEYS));
+
+  for (int i = 0; i < MUTATOR_COUNT; i++)
+    gl_thread_join (mutators[i], NULL);
+  for (int i = 0; i < READER_COUNT; i++)
+    gl_thread_join (readers[i], NULL);
+
+  ASSERT (chash_get_n_entries (shared_table) == PERMANENT_KEYS);
+  ASSERT (allocated
+          == PERMANENT_KEYS + MUTATOR_COUNT * REPEAT_COUNT * MUTATOR_KEYS);
+  chash_free (shared_table);
+  ASSERT (freed == allocated);
+}
+
+#endif
+
+int
+main ()
+{
+  test_single_thread ();
+
+#if USE_ISOC_THREADS || USE_POSIX_THREADS || USE_ISOC_AND_POSIX_THREADS || USE_WINDOWS_THREADS
+  test_threads ();
+#endif
+
+  return test_exit_status;
+}
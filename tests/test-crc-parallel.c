@@ -0,0 +1,52 @@
+/* Test of computing CRC-32 values using several threads.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "crc.h"
+
+#include <stdlib.h>
+
+#include "macros.h"
+
+/* Large enough for several chunks, and not a multiple of the number of
+   threads.  */
+#define SIZE (9 * 1024 * 1024 + 12345)
+
+int
+main (void)
+{
+  char *buf = malloc (SIZE);
+  ASSERT (buf != NULL);
+  for (size_t i = 0; i < SIZE; i++)
+    buf[i] = (i * 7) ^ (i >> 11);
+
+  static size_t const lengths[] = { 0, 1, 1000, 2 * 1024 * 1024 - 1,
+                                    2 * 1024 * 1024, 5 * 1024 * 1024 + 3,
+                                    SIZE };
+  for (size_t i = 0; i < sizeof lengths / sizeof lengths[0]; i++)
+    {
+      uint32_t expected = crc32 (buf, lengths[i]);
+      for (int nthreads = -1; nthreads <= 8; nthreads++)
+        ASSERT (crc32_parallel (buf, lengths[i], nthreads) == expected);
+      ASSERT (crc32_parallel (buf, lengths[i], 100) == expected);
+    }
+
+  free (buf);
+
+  return test_exit_status;
+}
@@ -139,6 +139,48 @@ main (void)
           }
       }
 
+  /* Test long buffers, which may be processed with wide vectors, against
+     pieces too short for that.  */
+
+  for (size_t i = 0; i < 3; i++)
+    for (size_t len = 0; i + len <= sizeof randomb; len += 61)
+      {
+        uint32_t expected = 0;
+        for (size_t j = 0; j < len; j += 15)
+          expected = crc32_update_no_xor (expected, randomb + i + j,
+                                          len - j < 15 ? len - j : 15);
+        p = crc32_update_no_xor (0, randomb + i, len);
+        if (p != expected)
+          {
+            printf ("long c at %lu length %lu got %lx\n", i, len,
+                    (unsigned long) p);
+            return 1;
+          }
+      }
+
+  /* Test crc32_combine, by splitting the data at various points.  */
+
+  for (size_t i = 0; i <= sizeof randomb; i += 97)
+    {
+      size_t len2 = sizeof randomb - i;
+      uint32_t crc1 = crc32 (randomb, i);
+      uint32_t crc2 = crc32 (randomb + i, len2);
+      p = crc32_combine (crc1, crc2, len2);
+      if (p != crc32 (randomb, sizeof randomb))
+        {
+          printf ("combine at %lu got %lx\n", i, (unsigned long) p);
+          return 1;
+        }
+
+      crc1 = crc32_no_xor (randomb, i);
+      crc2 = crc32_no_xor (randomb + i, len2);
+      p = crc32_combine (crc1, crc2, len2);
+      if (p != crc32_no_xor (randomb, sizeof randomb))
+        {
+          printf ("combine nx at %lu got %lx\n", i, (unsigned long) p);
+          return 1;
+        }
+    }
 
   return 0;
 }
@@ -0,0 +1,100 @@
+/* Test of CRC-32C computation.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "crc32c.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "macros.h"
+
+/* Larger than three interleaved streams of the longest block size.  */
+#define SIZE (100 * 1024 + 123)
+
+/* Bit-at-a-time reference implementation.  */
+static uint32_t
+reference_update_no_xor (uint32_t crc, const char *buf, size_t len)
+{
+  for (size_t i = 0; i < len; i++)
+    {
+      crc ^= (unsigned char) buf[i];
+      for (int k = 0; k < 8; k++)
+        crc = crc & 1 ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+    }
+  return crc;
+}
+
+int
+main (void)
+{
+  char buf[32];
+
+  /* Test vectors from RFC 3720 section B.4.  */
+  memset (buf, 0, sizeof buf);
+  ASSERT (crc32c (buf, sizeof buf) == 0x8A9136AA);
+  memset (buf, 0xFF, sizeof buf);
+  ASSERT (crc32c (buf, sizeof buf) == 0x62A8AB43);
+  for (int i = 0; i < 32; i++)
+    buf[i] = i;
+  ASSERT (crc32c (buf, sizeof buf) == 0x46DD794E);
+  for (int i = 0; i < 32; i++)
+    buf[i] = 31 - i;
+  ASSERT (crc32c (buf, sizeof buf) == 0x113FDB5C);
+
+  /* The check value of the CRC-32C.  */
+  ASSERT (crc32c ("123456789", 9) == 0xE3069283);
+  ASSERT (crc32c ("", 0) == 0);
+  ASSERT (crc32c_update (crc32c ("1234", 4), "56789", 5) == 0xE3069283);
+
+  char *data = malloc (SIZE + 8);
+  ASSERT (data != NULL);
+  for (size_t i = 0; i < SIZE + 8; i++)
+    data[i] = (i * 7) ^ (i >> 11);
+
+  /* All lengths up to a few hundred bytes, at all alignments.  */
+  for (size_t align = 0; align < 8; align++)
+    for (size_t len = 0; len <= 600; len++)
+      ASSERT (crc32c_update_no_xor (42, data + align, len)
+              == reference_update_no_xor (42, data + align, len));
+
+  /* Lengths around the block sizes of the implementations.  */
+  static size_t const lengths[] = { 1023, 1024, 1025, 3 * 256 - 1, 3 * 256,
+                                    3 * 8192 - 1, 3 * 8192, 3 * 8192 + 777,
+                                    SIZE };
+  for (size_t align = 0; align < 8; align += 3)
+    for (size_t i = 0; i < sizeof lengths / sizeof lengths[0]; i++)
+      ASSERT (crc32c_update_no_xor (0xDEADBEEF, data + align, lengths[i])
+              == reference_update_no_xor (0xDEADBEEF, data + align,
+                                          lengths[i]));
+
+  /* crc32c_combine.  */
+  for (size_t i = 0; i <= SIZE; i += 4099)
+    {
+      size_t len2 = SIZE - i;
+      ASSERT (crc32c_combine (crc32c (data, i), crc32c (data + i, len2), len2)
+              == crc32c (data, SIZE));
+      ASSERT (crc32c_combine (crc32c_no_xor (data, i),
+                              crc32c_no_xor (data + i, len2), len2)
+              == crc32c_no_xor (data, SIZE));
+    }
+
+  free (data);
+
+  return test_exit_status;
+}
@@ -0,0 +1,8 @@
+#!/bin/sh
+
+# Test each of the implementations that the CPU supports.
+${CHECKER} ./test-crc32c${EXEEXT} || exit 1
+GLIBC_TUNABLES=glibc.cpu.hwcaps=-PCLMULQDQ \
+  ${CHECKER} ./test-crc32c${EXEEXT} || exit 1
+GLIBC_TUNABLES=glibc.cpu.hwcaps=-PCLMULQDQ,-SSE4_2 \
+  ${CHECKER} ./test-crc32c${EXEEXT} || exit 1
@@ -47,6 +47,26 @@ main (void)
   for (unsigned int i = 0; i < 3000; i++)
     ASSERT (di_set_insert (dis, 9, i) == 0); /* duplicate fails */
 
+  /* A dense range of inode numbers, inserted in decreasing order, which
+     fills pages beyond the size at which they become bitmaps.  */
+  for (unsigned int i = 200000; i > 1000; i--)
+    ASSERT (di_set_insert (dis, 10, i) == 1);
+  for (unsigned int i = 0; i <= 201000; i++)
+    ASSERT (di_set_lookup (dis, 10, i) == (1000 < i && i <= 200000));
+  for (unsigned int i = 1; i <= 201000; i++)
+    ASSERT (di_set_insert (dis, 10, i) == (i <= 1000 || 200000 < i));
+
+  /* A sparse set of inode numbers.  */
+  for (unsigned int i = 1; i < 10000000; i += 997)
+    ASSERT (di_set_insert (dis, 11, i) == 1);
+  for (unsigned int i = 1; i < 10000000; i += 997)
+    {
+      ASSERT (di_set_lookup (dis, 11, i) == 1);
+      ASSERT (di_set_lookup (dis, 11, i + 1) == 0);
+    }
+  ASSERT (di_set_lookup (dis, 10, 1) == 1);
+  ASSERT (di_set_lookup (dis, 9, 5) == 1);
+
   di_set_free (dis);
 
   return test_exit_status;
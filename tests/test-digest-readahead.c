@@ -0,0 +1,119 @@
+/* Test of overlapped reading for message digests.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "digest-readahead.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "macros.h"
+
+#define TESTFILE "test-digest-readahead.data"
+
+/* Larger than the minimum file size, and not a multiple of the buffer
+   size.  */
+#define SIZE (5 * 1024 * 1024 + 12345)
+
+static unsigned char
+pattern (size_t i)
+{
+  return (i * 7) ^ (i >> 11);
+}
+
+struct state
+{
+  size_t pos;
+  size_t calls;
+  size_t fail_after;
+  bool mismatch;
+};
+
+static bool
+check (void const *buffer, size_t len, void *arg)
+{
+  struct state *st = arg;
+  unsigned char const *p = buffer;
+
+  if (st->calls++ == st->fail_after)
+    return false;
+  for (size_t i = 0; i < len; i++)
+    if (p[i] != pattern (st->pos + i))
+      st->mismatch = true;
+  st->pos += len;
+  return true;
+}
+
+int
+main (void)
+{
+  FILE *fp = fopen (TESTFILE, "wb");
+  ASSERT (fp != NULL);
+  for (size_t i = 0; i < SIZE; i++)
+    ASSERT (putc (pattern (i), fp) != EOF);
+  ASSERT (fclose (fp) == 0);
+
+  /* The whole file is passed on, in order.  */
+  {
+    struct state st = { 0, 0, SIZE_MAX, false };
+    fp = fopen (TESTFILE, "rb");
+    ASSERT (fp != NULL);
+    int ret = digest_readahead (fp, check, &st);
+    if (ret == 0)
+      {
+        ASSERT (st.pos == SIZE);
+        ASSERT (!st.mismatch);
+      }
+    else
+      /* No multithreading.  */
+      ASSERT (ret == -1 && st.calls == 0);
+    ASSERT (fclose (fp) == 0);
+
+    /* A failure of the callback stops the reading.  */
+    if (ret == 0)
+      {
+        st = (struct state) { 0, 0, 2, false };
+        fp = fopen (TESTFILE, "rb");
+        ASSERT (fp != NULL);
+        ASSERT (digest_readahead (fp, check, &st) == 1);
+        ASSERT (st.calls == 3);
+        ASSERT (!st.mismatch);
+        ASSERT (fclose (fp) == 0);
+      }
+  }
+
+  /* Short files are left to the caller.  */
+  {
+    struct state st = { 0, 0, SIZE_MAX, false };
+    fp = fopen (TESTFILE, "wb");
+    ASSERT (fp != NULL);
+    ASSERT (fputs ("abc", fp) != EOF);
+    ASSERT (fclose (fp) == 0);
+    fp = fopen (TESTFILE, "rb");
+    ASSERT (fp != NULL);
+    ASSERT (digest_readahead (fp, check, &st) == -1);
+    ASSERT (st.calls == 0);
+    ASSERT (getc (fp) == 'a');
+    ASSERT (fclose (fp) == 0);
+  }
+
+  ASSERT (unlink (TESTFILE) == 0);
+
+  return test_exit_status;
+}
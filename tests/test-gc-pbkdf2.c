@@ -82,13 +82,29 @@ const struct pkcs5 pkcs5[] = {
    "All n-entities must communicate with other n-entities via n-1 "
    "entiteeheehees", "\x12\x34\x56\x78\x78\x56\x34\x12\x00", 16,
    "\x6A\x89\x70\xBF\x68\xC9\x2C\xAE\xA8\x4A\x8D\xF2\x85\x10\x85\x86"},
+  /* From RFC 6070; the two blocks may be computed in parallel.  */
+  {GC_SHA1, 4096, "passwordPASSWORDpassword",
+   "saltSALTsaltSALTsaltSALTsaltSALTsalt", 25,
+   "\x3d\x2e\xec\x4f\xe4\x1c\x84\x9b\x80\xc8\xd8\x36\x62\xc0\xe4\x4a"
+   "\x8b\x29\x1a\x96\x4c\xf2\xf0\x70\x38"},
 #endif
 #if GNULIB_GC_HMAC_SHA256
   {GC_SHA256, 4096, "pencil",
    "\x5b\x6d\x99\x68\x9d\x12\x35\x8e\xec\xa0\x4b\x14\x12\x36\xfa\x81",
    32,
    "\xc4\xa4\x95\x10\x32\x3a\xb4\xf9\x52\xca\xc1\xfa\x99\x44\x19\x39"
-   "\xe7\x8e\xa7\x4d\x6b\xe8\x1d\xdf\x70\x96\xe8\x75\x13\xdc\x61\x5d"}
+   "\xe7\x8e\xa7\x4d\x6b\xe8\x1d\xdf\x70\x96\xe8\x75\x13\xdc\x61\x5d"},
+  /* From RFC 7914.  */
+  {GC_SHA256, 1, "passwd", "salt", 64,
+   "\x55\xac\x04\x6e\x56\xe3\x08\x9f\xec\x16\x91\xc2\x25\x44\xb6\x05"
+   "\xf9\x41\x85\x21\x6d\xde\x04\x65\xe6\x8b\x9d\x57\xc2\x0d\xac\xbc"
+   "\x49\xca\x9c\xcc\xf1\x79\xb6\x45\x99\x16\x64\xb3\x9d\x77\xef\x31"
+   "\x7c\x71\xb8\x45\xb1\xe3\x0b\xd5\x09\x11\x20\x41\xd3\xa1\x97\x83"},
+  {GC_SHA256, 80000, "Password", "NaCl", 64,
+   "\x4d\xdc\xd8\xf6\x0b\x98\xbe\x21\x83\x0c\xee\x5e\xf2\x27\x01\xf9"
+   "\x64\x1a\x44\x18\xd0\x4c\x04\x14\xae\xff\x08\x87\x6b\x34\xab\x56"
+   "\xa1\xd4\x25\xa1\x22\x58\x33\x54\x9a\xdb\x84\x1b\x51\xc9\xb3\x17"
+   "\x6a\x27\x2b\xde\xbb\xa1\xd0\x78\x47\x8f\x62\xb3\x97\xf3\x3c\x8d"}
 #endif
 };
 
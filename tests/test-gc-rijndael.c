@@ -22,6 +22,322 @@
 #include <stdio.h>
 #include <string.h>
 
+static void
+dump (char const *what, char const *expected, char const *computed,
+      size_t len)
+{
+  printf ("%s: expected:\n", what);
+  for (size_t i = 0; i < len; i++)
+    printf ("%02x ", expected[i] & 0xFF);
+  printf ("\ncomputed:\n");
+  for (size_t i = 0; i < len; i++)
+    printf ("%02x ", computed[i] & 0xFF);
+  printf ("\n");
+}
+
+/* Test vectors of AES-GCM, from David A. McGrew and John Viega, "The
+   Galois/Counter Mode of Operation (GCM)".  */
+struct gcm_test
+{
+  Gc_cipher alg;
+  size_t keylen;
+  char const *key;
+  size_t ivlen;
+  char const *iv;
+  size_t aadlen;
+  char const *aad;
+  size_t len;
+  char const *pt;
+  char const *ct;
+  char const *tag;
+};
+
+#define GCM_KEY "\xfe\xff\xe9\x92\x86\x65\x73\x1c" \
+  "\x6d\x6a\x8f\x94\x67\x30\x83\x08"
+#define GCM_PT "\xd9\x31\x32\x25\xf8\x84\x06\xe5\xa5\x59\x09\xc5\xaf\xf5\x26\x9a" \
+  "\x86\xa7\xa9\x53\x15\x34\xf7\xda\x2e\x4c\x30\x3d\x8a\x31\x8a\x72" \
+  "\x1c\x3c\x0c\x95\x95\x68\x09\x53\x2f\xcf\x0e\x24\x49\xa6\xb5\x25" \
+  "\xb1\x6a\xed\xf5\xaa\x0d\xe6\x57\xba\x63\x7b\x39"
+#define GCM_AAD "\xfe\xed\xfa\xce\xde\xad\xbe\xef\xfe\xed\xfa\xce\xde\xad\xbe\xef" \
+  "\xab\xad\xda\xd2"
+
+static struct gcm_test const gcm_tests[] =
+  {
+    /* Test case 2.  */
+    { GC_AES128, 16, "\x00\x00\x00\x00\x00\x00\x00\x00"
+      "\x00\x00\x00\x00\x00\x00\x00\x00",
+      12, "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+      0, "",
+      16, "\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00\x00",
+      "\x03\x88\xda\xce\x60\xb6\xa3\x92\xf3\x28\xc2\xb9\x71\xb2\xfe\x78",
+      "\xab\x6e\x47\xd4\x2c\xec\x13\xbd\xf5\x3a\x67\xb2\x12\x57\xbd\xdf" },
+    /* Test case 4.  */
+    { GC_AES128, 16, GCM_KEY,
+      12, "\xca\xfe\xba\xbe\xfa\xce\xdb\xad\xde\xca\xf8\x88",
+      20, GCM_AAD,
+      60, GCM_PT,
+      "\x42\x83\x1e\xc2\x21\x77\x74\x24\x4b\x72\x21\xb7\x84\xd0\xd4\x9c"
+      "\xe3\xaa\x21\x2f\x2c\x02\xa4\xe0\x35\xc1\x7e\x23\x29\xac\xa1\x2e"
+      "\x21\xd5\x14\xb2\x54\x66\x93\x1c\x7d\x8f\x6a\x5a\xac\x84\xaa\x05"
+      "\x1b\xa3\x0b\x39\x6a\x0a\xac\x97\x3d\x58\xe0\x91",
+      "\x5b\xc9\x4f\xbc\x32\x21\xa5\xdb\x94\xfa\xe9\x5a\xe7\x12\x1a\x47" },
+    /* Test case 6, with a 60-byte IV.  */
+    { GC_AES128, 16, GCM_KEY,
+      60, "\x93\x13\x22\x5d\xf8\x84\x06\xe5\x55\x90\x9c\x5a\xff\x52\x69\xaa"
+      "\x6a\x7a\x95\x38\x53\x4f\x7d\xa1\xe4\xc3\x03\xd2\xa3\x18\xa7\x28"
+      "\xc3\xc0\xc9\x51\x56\x80\x95\x39\xfc\xf0\xe2\x42\x9a\x6b\x52\x54"
+      "\x16\xae\xdb\xf5\xa0\xde\x6a\x57\xa6\x37\xb3\x9b",
+      20, GCM_AAD,
+      60, GCM_PT,
+      "\x8c\xe2\x49\x98\x62\x56\x15\xb6\x03\xa0\x33\xac\xa1\x3f\xb8\x94"
+      "\xbe\x91\x12\xa5\xc3\xa2\x11\xa8\xba\x26\x2a\x3c\xca\x7e\x2c\xa7"
+      "\x01\xe4\xa9\xa4\xfb\xa4\x3c\x90\xcc\xdc\xb2\x81\xd4\x8c\x7c\x6f"
+      "\xd6\x28\x75\xd2\xac\xa4\x17\x03\x4c\x34\xae\xe5",
+      "\x61\x9c\xc5\xae\xff\xfe\x0b\xfa\x46\x2a\xf4\x3c\x16\x99\xd0\x50" },
+    /* Test case 16.  */
+    { GC_AES256, 32, GCM_KEY GCM_KEY,
+      12, "\xca\xfe\xba\xbe\xfa\xce\xdb\xad\xde\xca\xf8\x88",
+      20, GCM_AAD,
+      60, GCM_PT,
+      "\x52\x2d\xc1\xf0\x99\x56\x7d\x07\xf4\x7f\x37\xa3\x2a\x84\x42\x7d"
+      "\x64\x3a\x8c\xdc\xbf\xe5\xc0\xc9\x75\x98\xa2\xbd\x25\x55\xd1\xaa"
+      "\x8c\xb0\x8e\x48\x59\x0d\xbb\x3d\xa7\xb0\x8b\x10\x56\x82\x88\x38"
+      "\xc5\xf6\x1e\x63\x93\xba\x7a\x0a\xbc\xc9\xf6\x62",
+      "\x76\xfc\x6e\xce\x0f\x4e\x17\x68\xcd\xdf\x88\x53\xbb\x2d\x55\x1b" },
+  };
+
+static int
+test_gcm (void)
+{
+  for (size_t t = 0; t < sizeof gcm_tests / sizeof gcm_tests[0]; t++)
+    {
+      struct gcm_test const *test = &gcm_tests[t];
+      char buf[64];
+      char tag[16];
+      gc_cipher_handle ctx;
+
+      for (int decrypt = 0; decrypt <= 1; decrypt++)
+        {
+          if (gc_cipher_open (test->alg, GC_GCM, &ctx) != GC_OK
+              || gc_cipher_setkey (ctx, test->keylen, test->key) != GC_OK
+              || gc_cipher_setiv (ctx, test->ivlen, test->iv) != GC_OK
+              || gc_cipher_authenticate (ctx, test->aadlen, test->aad) != GC_OK)
+            {
+              printf ("GCM test %zu: setup failed\n", t);
+              return 1;
+            }
+          memcpy (buf, decrypt ? test->ct : test->pt, test->len);
+          if ((decrypt
+               ? gc_cipher_decrypt_inline (ctx, test->len, buf)
+               : gc_cipher_encrypt_inline (ctx, test->len, buf)) != GC_OK
+              || gc_cipher_gettag (ctx, 16, tag) != GC_OK)
+            {
+              printf ("GCM test %zu: %s failed\n", t,
+                      decrypt ? "decrypt" : "encrypt");
+              return 1;
+            }
+          if (!memeq (buf, decrypt ? test->pt : test->ct, test->len))
+            {
+              dump ("GCM", decrypt ? test->pt : test->ct, buf, test->len);
+              return 1;
+            }
+          if (!memeq (tag, test->tag, 16))
+            {
+              dump ("GCM tag", test->tag, tag, 16);
+              return 1;
+            }
+          gc_cipher_close (ctx);
+        }
+    }
+
+  return 0;
+}
+
+/* Test vectors of AES-CTR, from NIST SP 800-38A, F.5.1.  */
+static int
+test_ctr (void)
+{
+  char key[] = "\x2b\x7e\x15\x16\x28\xae\xd2\xa6"
+    "\xab\xf7\x15\x88\x09\xcf\x4f\x3c";
+  char iv[] = "\xf0\xf1\xf2\xf3\xf4\xf5\xf6\xf7"
+    "\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff";
+  char pt[] = "\x6b\xc1\xbe\xe2\x2e\x40\x9f\x96\xe9\x3d\x7e\x11\x73\x93\x17\x2a"
+    "\xae\x2d\x8a\x57\x1e\x03\xac\x9c\x9e\xb7\x6f\xac\x45\xaf\x8e\x51"
+    "\x30\xc8\x1c\x46\xa3\x5c\xe4\x11\xe5\xfb\xc1\x19\x1a\x0a\x52\xef"
+    "\xf6\x9f\x24\x45\xdf\x4f\x9b\x17\xad\x2b\x41\x7b\xe6\x6c\x37\x10";
+  char ct[] = "\x87\x4d\x61\x91\xb6\x20\xe3\x26\x1b\xef\x68\x64\x99\x0d\xb6\xce"
+    "\x98\x06\xf6\x6b\x79\x70\xfd\xff\x86\x17\x18\x7b\xb9\xff\xfd\xff"
+    "\x5a\xe4\xdf\x3e\xdb\xd5\xd3\x5e\x5b\x4f\x09\x02\x0d\xb0\x3e\xab"
+    "\x1e\x03\x1d\xda\x2f\xbe\x03\xd1\x79\x21\x70\xa0\xf3\x00\x9c\xee";
+  char buf[64];
+  gc_cipher_handle ctx;
+
+  /* Encrypt in one call, and decrypt in pieces that straddle the
+     blocks.  */
+  if (gc_cipher_open (GC_AES128, GC_CTR, &ctx) != GC_OK
+      || gc_cipher_setkey (ctx, 16, key) != GC_OK
+      || gc_cipher_setiv (ctx, 16, iv) != GC_OK)
+    {
+      printf ("CTR: setup failed\n");
+      return 1;
+    }
+  memcpy (buf, pt, 64);
+  if (gc_cipher_encrypt_inline (ctx, 64, buf) != GC_OK)
+    return 1;
+  if (!memeq (buf, ct, 64))
+    {
+      dump ("CTR", ct, buf, 64);
+      return 1;
+    }
+  if (gc_cipher_setiv (ctx, 16, iv) != GC_OK
+      || gc_cipher_decrypt_inline (ctx, 5, buf) != GC_OK
+      || gc_cipher_decrypt_inline (ctx, 30, buf + 5) != GC_OK
+      || gc_cipher_decrypt_inline (ctx, 29, buf + 35) != GC_OK)
+    return 1;
+  if (!memeq (buf, pt, 64))
+    {
+      dump ("CTR", pt, buf, 64);
+      return 1;
+    }
+  gc_cipher_close (ctx);
+
+  return 0;
+}
+
+/* Check that encrypting a long buffer in one call, which uses the
+   multi-block code, gives the same result as encrypting it in small
+   pieces, and that decryption reverses it.  */
+enum { LONG_SIZE = 4099 };
+
+static int
+crypt_pieces (Gc_cipher_mode mode, bool decrypt, size_t piece,
+              char *data, char tag[16])
+{
+  char key[32];
+  char iv[16];
+  for (int i = 0; i < 32; i++)
+    key[i] = i * 7 + 1;
+  for (int i = 0; i < 16; i++)
+    iv[i] = 0xf0 + i;
+
+  gc_cipher_handle ctx;
+  if (gc_cipher_open (GC_AES256, mode, &ctx) != GC_OK
+      || gc_cipher_setkey (ctx, 32, key) != GC_OK
+      || gc_cipher_setiv (ctx, mode == GC_GCM ? 12 : 16, iv) != GC_OK
+      || (mode == GC_GCM && gc_cipher_authenticate (ctx, 21, key) != GC_OK))
+    return 1;
+
+  for (size_t i = 0; i < LONG_SIZE; i += piece)
+    {
+      size_t n = piece < LONG_SIZE - i ? piece : LONG_SIZE - i;
+      if ((decrypt
+           ? gc_cipher_decrypt_inline (ctx, n, data + i)
+           : gc_cipher_encrypt_inline (ctx, n, data + i)) != GC_OK)
+        return 1;
+    }
+
+  if (mode == GC_GCM && gc_cipher_gettag (ctx, 16, tag) != GC_OK)
+    return 1;
+
+  gc_cipher_close (ctx);
+  return 0;
+}
+
+static int
+test_long (Gc_cipher_mode mode)
+{
+  static char pt[LONG_SIZE];
+  static char whole[LONG_SIZE];
+  static char buf[LONG_SIZE];
+  static size_t const pieces[] = { 1, 15, 16, 17, 100, 128, 1000 };
+  char wholetag[16] = { 0 };
+  char tag[16] = { 0 };
+
+  unsigned int seed = 1;
+  for (size_t i = 0; i < LONG_SIZE; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      pt[i] = seed >> 16;
+    }
+
+  memcpy (whole, pt, LONG_SIZE);
+  if (crypt_pieces (mode, false, LONG_SIZE, whole, wholetag) != 0)
+    {
+      printf ("encrypt of long buffer failed\n");
+      return 1;
+    }
+
+  for (size_t p = 0; p < sizeof pieces / sizeof pieces[0]; p++)
+    {
+      memcpy (buf, pt, LONG_SIZE);
+      if (crypt_pieces (mode, false, pieces[p], buf, tag) != 0)
+        return 1;
+      if (!memeq (buf, whole, LONG_SIZE) || !memeq (tag, wholetag, 16))
+        {
+          printf ("encrypt of long buffer by %zu bytes differs\n", pieces[p]);
+          return 1;
+        }
+      if (crypt_pieces (mode, true, pieces[p], buf, tag) != 0)
+        return 1;
+      if (!memeq (buf, pt, LONG_SIZE) || !memeq (tag, wholetag, 16))
+        {
+          printf ("decrypt of long buffer by %zu bytes differs\n", pieces[p]);
+          return 1;
+        }
+    }
+
+  return 0;
+}
+
+/* Check ECB and CBC on many blocks at once against block by block.  */
+static int
+test_multiblock (Gc_cipher_mode mode)
+{
+  enum { NBLOCKS = 37 };
+  char key[] = "0123456789abcdef";
+  char iv[] = "fedcba9876543210";
+  char pt[16 * NBLOCKS];
+  char whole[16 * NBLOCKS];
+  char buf[16 * NBLOCKS];
+  gc_cipher_handle ctx;
+
+  for (size_t i = 0; i < sizeof pt; i++)
+    pt[i] = i * 31 + 5;
+
+  memcpy (whole, pt, sizeof pt);
+  if (gc_cipher_open (GC_AES128, mode, &ctx) != GC_OK
+      || gc_cipher_setkey (ctx, 16, key) != GC_OK
+      || gc_cipher_setiv (ctx, 16, iv) != GC_OK
+      || gc_cipher_encrypt_inline (ctx, sizeof whole, whole) != GC_OK)
+    return 1;
+  gc_cipher_close (ctx);
+
+  memcpy (buf, pt, sizeof pt);
+  if (gc_cipher_open (GC_AES128, mode, &ctx) != GC_OK
+      || gc_cipher_setkey (ctx, 16, key) != GC_OK
+      || gc_cipher_setiv (ctx, 16, iv) != GC_OK)
+    return 1;
+  for (size_t i = 0; i < NBLOCKS; i++)
+    if (gc_cipher_encrypt_inline (ctx, 16, buf + 16 * i) != GC_OK)
+      return 1;
+  if (!memeq (buf, whole, sizeof buf))
+    {
+      printf ("multi-block encrypt differs\n");
+      return 1;
+    }
+  if (gc_cipher_setiv (ctx, 16, iv) != GC_OK
+      || gc_cipher_decrypt_inline (ctx, sizeof buf, buf) != GC_OK)
+    return 1;
+  if (!memeq (buf, pt, sizeof buf))
+    {
+      printf ("multi-block decrypt differs\n");
+      return 1;
+    }
+  gc_cipher_close (ctx);
+
+  return 0;
+}
+
 int
 main (int argc, char *argv[])
 {
@@ -153,6 +469,11 @@ main (int argc, char *argv[])
     gc_cipher_close (ctx);
   }
 
+  if (test_multiblock (GC_ECB) != 0 || test_multiblock (GC_CBC) != 0
+      || test_ctr () != 0 || test_gcm () != 0
+      || test_long (GC_CTR) != 0 || test_long (GC_GCM) != 0)
+    return 1;
+
   gc_done ();
 
   return 0;
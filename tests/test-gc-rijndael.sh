@@ -0,0 +1,8 @@
+#!/bin/sh
+
+# Test each of the implementations that the CPU supports.
+${CHECKER} ./test-gc-rijndael${EXEEXT} || exit 1
+GLIBC_TUNABLES=glibc.cpu.hwcaps=-PCLMULQDQ \
+  ${CHECKER} ./test-gc-rijndael${EXEEXT} || exit 1
+GLIBC_TUNABLES=glibc.cpu.hwcaps=-AES,-PCLMULQDQ \
+  ${CHECKER} ./test-gc-rijndael${EXEEXT} || exit 1
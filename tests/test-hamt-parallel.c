@@ -0,0 +1,105 @@
+/* Test of walking a hamt in several threads.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+#include "hamt.h"
+#include "macros.h"
+#include "xalloc.h"
+
+typedef struct
+{
+  Hamt_entry entry;
+  int val;
+} Element;
+
+static int
+entry_value (const void *elt)
+{
+  return ((Element *) elt)->val;
+}
+
+static size_t
+hash_element (const void *elt)
+{
+  return entry_value (elt) & ~3; /* We drop the last bits so that we
+                                    can test hash collisions. */
+}
+
+static bool
+compare_element (const void *elt1, const void *elt2)
+{
+  return entry_value (elt1) == entry_value (elt2);
+}
+
+static void
+free_element (Hamt_entry *elt)
+{
+  free (elt);
+}
+
+static Hamt_entry *
+make_element (int n)
+{
+  Element *elt = XMALLOC (Element);
+  elt->val = n;
+  return hamt_element (&elt->entry);
+}
+
+static bool
+mark_processor (Hamt_entry *elt, void *data)
+{
+  bool *marks = data;
+  int val = entry_value (elt);
+  ASSERT (!marks [val]);
+  marks [val] = true;
+  return true;
+}
+
+static bool
+stop_processor (Hamt_entry *elt, void *_GL_UNNAMED (data))
+{
+  return entry_value (elt) != 500;
+}
+
+int
+main (void)
+{
+  Hamt *hamt = hamt_create (hash_element, compare_element, free_element);
+  for (int i = 0; i < 1000; ++i)
+    {
+      Hamt_entry *p = make_element (i);
+      ASSERT (hamt_insert_x (hamt, &p));
+    }
+
+  for (unsigned int thread_count = 1; thread_count <= 64; thread_count *= 4)
+    {
+      bool marks [1000] = { false };
+      ASSERT (hamt_do_while_parallel (hamt, mark_processor, marks,
+                                      thread_count)
+              == 1000);
+      for (int i = 0; i < 1000; ++i)
+        ASSERT (marks [i]);
+
+      ASSERT (hamt_do_while_parallel (hamt, stop_processor, NULL,
+                                      thread_count)
+              < 1000);
+    }
+
+  hamt_free (hamt);
+
+  return test_exit_status;
+}
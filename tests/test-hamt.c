@@ -34,9 +34,13 @@ entry_value (const void *elt)
   return ((Element *) elt)->val;
 }
 
+/* The number of calls of hash_element.  */
+static size_t hash_count;
+
 static size_t
 hash_element (const void *elt)
 {
+  ++hash_count;
   return entry_value (elt) & ~3; /* We drop the last bits so that we
                                     can test hash collisions. */
 }
@@ -342,6 +346,214 @@ test_destructive_update (void)
   hamt_free (hamt);
 }
 
+static bool
+lookup_values (Hamt *hamt, size_t n, int *elts)
+{
+  bool res = true;
+  for (size_t i = 0; i < n; ++i)
+    {
+      Hamt_entry *p = make_element (elts [i]);
+      if (hamt_lookup (hamt, p) == NULL)
+        res = false;
+      free (p);
+    }
+  return res;
+}
+
+static size_t
+transient_insert_values (Hamt_transient *transient, size_t n, int *elts)
+{
+  size_t cnt = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      Hamt_entry *p = make_element (elts [i]);
+      Hamt_entry *q = p;
+      if (hamt_transient_insert (transient, &p))
+        ++cnt;
+      else
+        free_element (q);
+    }
+  return cnt;
+}
+
+static size_t
+transient_remove_values (Hamt_transient *transient, size_t n, int *elts)
+{
+  size_t cnt = 0;
+  for (size_t i = 0; i < n; ++i)
+    {
+      Hamt_entry *p = make_element (elts [i]);
+      if (hamt_transient_remove (transient, p))
+        ++cnt;
+      free (p);
+    }
+  return cnt;
+}
+
+static void
+test_transient (void)
+{
+  Hamt *hamt = test_hamt_create ();
+  ASSERT (insert_values (&hamt, 10, val_array1, false) == 10);
+
+  /* Updates of the transient don't affect the original hamt.  */
+  Hamt_transient *transient = hamt_transient (hamt);
+  ASSERT (transient_insert_values (transient, 10, val_array2) == 5);
+  ASSERT (transient_remove_values (transient, 10, val_array1) == 10);
+  Hamt_entry *p = make_element (32770);
+  ASSERT (hamt_transient_lookup (transient, p) != NULL);
+  ASSERT (hamt_transient_replace (transient, p));
+  ASSERT (hamt_transient_lookup (transient, p) == p);
+  Hamt *hamt1 = hamt_persistent (transient);
+  ASSERT (element_count (hamt1) == 5);
+  ASSERT (find_values (hamt1, 5, val_array2 + 5));
+  ASSERT (element_count (hamt) == 10);
+  ASSERT (find_values (hamt, 10, val_array1));
+  ASSERT (hamt_lookup (hamt, p) != p);
+
+  /* Nor do they affect the hamts taken from the transient earlier.  */
+  int vals [1000];
+  for (int i = 0; i < 1000; ++i)
+    vals [i] = i;
+  transient = hamt_transient (hamt1);
+  ASSERT (transient_insert_values (transient, 500, vals) == 500);
+  Hamt *hamt2 = hamt_persistent (transient);
+  transient = hamt_transient (hamt2);
+  ASSERT (transient_insert_values (transient, 1000, vals) == 500);
+  ASSERT (transient_remove_values (transient, 250, vals) == 250);
+  Hamt *hamt3 = hamt_persistent (transient);
+  ASSERT (element_count (hamt1) == 5);
+  ASSERT (element_count (hamt2) == 505);
+  ASSERT (lookup_values (hamt2, 500, vals));
+  ASSERT (element_count (hamt3) == 755);
+  ASSERT (lookup_values (hamt3, 750, vals + 250));
+  ASSERT (hamt_lookup (hamt3, p) == p);
+
+  /* A hamt made from a transient can be updated.  */
+  ASSERT (remove_values (&hamt3, 1000, vals, false) == 750);
+  ASSERT (element_count (hamt3) == 5);
+  ASSERT (insert_values (&hamt3, 1000, vals, true) == 1000);
+  ASSERT (element_count (hamt3) == 1005);
+
+  hamt_free (hamt);
+  hamt_free (hamt1);
+  hamt_free (hamt2);
+  hamt_free (hamt3);
+}
+
+/* Removing an element must not move a subtrie to a different level.  */
+static void
+test_remove_level (void)
+{
+  /* The hashes of 0 and 32 differ only on the second level.  */
+  int vals [3] = {0, 32, 4};
+
+  Hamt *hamt = test_hamt_create ();
+  ASSERT (insert_values (&hamt, 3, vals, false) == 3);
+  ASSERT (remove_values (&hamt, 1, vals + 2, false) == 1);
+  ASSERT (find_values (hamt, 2, vals));
+  Hamt_entry *p = make_element (32);
+  ASSERT (hamt_lookup (hamt, p) != NULL);
+  hamt_free (hamt);
+
+  hamt = test_hamt_create ();
+  ASSERT (insert_values (&hamt, 3, vals, true) == 3);
+  ASSERT (remove_values (&hamt, 1, vals + 2, true) == 1);
+  ASSERT (find_values (hamt, 2, vals));
+  ASSERT (hamt_lookup (hamt, p) != NULL);
+  hamt_free (hamt);
+
+  free_element (p);
+}
+
+struct diff_context
+{
+  size_t removed;
+  size_t added;
+  size_t replaced;
+  int sum;
+};
+
+static bool
+diff_processor (Hamt_entry *old_elt, Hamt_entry *new_elt, void *data)
+{
+  struct diff_context *ctx = data;
+  if (new_elt == NULL)
+    {
+      ++ctx->removed;
+      ctx->sum -= entry_value (old_elt);
+    }
+  else if (old_elt == NULL)
+    {
+      ++ctx->added;
+      ctx->sum += entry_value (new_elt);
+    }
+  else
+    {
+      ASSERT (old_elt != new_elt);
+      ASSERT (entry_value (old_elt) == entry_value (new_elt));
+      ++ctx->replaced;
+    }
+  return true;
+}
+
+static bool
+false_diff_processor (Hamt_entry *_GL_UNNAMED (old_elt),
+                      Hamt_entry *_GL_UNNAMED (new_elt),
+                      void *_GL_UNNAMED (data))
+{
+  return false;
+}
+
+static void
+test_diff (void)
+{
+  int vals [1000];
+  for (int i = 0; i < 1000; ++i)
+    vals [i] = i;
+
+  Hamt *hamt0 = test_hamt_create ();
+  Hamt *hamt1 = test_hamt_create ();
+  ASSERT (insert_values (&hamt1, 1000, vals, true) == 1000);
+
+  struct diff_context ctx = {0, 0, 0, 0};
+  ASSERT (hamt_diff (hamt1, hamt1, diff_processor, &ctx) == 0);
+  ASSERT (hamt_diff (hamt0, hamt1, diff_processor, &ctx) == 1000);
+  ASSERT (ctx.added == 1000 && ctx.removed == 0 && ctx.replaced == 0);
+  ASSERT (ctx.sum == 999 * 1000 / 2);
+
+  ctx = (struct diff_context) {0, 0, 0, 0};
+  ASSERT (hamt_diff (hamt1, hamt0, diff_processor, &ctx) == 1000);
+  ASSERT (ctx.added == 0 && ctx.removed == 1000 && ctx.replaced == 0);
+
+  /* Update a copy and compare it with the original.  */
+  Hamt *hamt2 = hamt_copy (hamt1);
+  int removed_vals [3] = {5, 500, 998};
+  int added_vals [4] = {1000, 1001, 1002, 4096};
+  int replaced_vals [2] = {7, 770};
+  ASSERT (remove_values (&hamt2, 3, removed_vals, true) == 3);
+  ASSERT (insert_values (&hamt2, 4, added_vals, true) == 4);
+  ASSERT (replace_values (&hamt2, 2, replaced_vals, true) == 2);
+
+  ctx = (struct diff_context) {0, 0, 0, 0};
+  hash_count = 0;
+  ASSERT (hamt_diff (hamt1, hamt2, diff_processor, &ctx) == 9);
+  ASSERT (ctx.removed == 3 && ctx.added == 4 && ctx.replaced == 2);
+  ASSERT (ctx.sum == (1000 + 1001 + 1002 + 4096) - (5 + 500 + 998));
+  /* The shared subtries are skipped.  */
+  ASSERT (hash_count < 100);
+
+  ctx = (struct diff_context) {0, 0, 0, 0};
+  ASSERT (hamt_diff (hamt2, hamt1, diff_processor, &ctx) == 9);
+  ASSERT (ctx.removed == 4 && ctx.added == 3 && ctx.replaced == 2);
+
+  ASSERT (hamt_diff (hamt1, hamt2, false_diff_processor, NULL) == 0);
+
+  hamt_free (hamt0);
+  hamt_free (hamt1);
+  hamt_free (hamt2);
+}
+
 static void
 test_iterator (void)
 {
@@ -374,6 +586,9 @@ main (void)
   test_general ();
   test_functional_update ();
   test_destructive_update ();
+  test_transient ();
+  test_remove_level ();
+  test_diff ();
   test_iterator ();
 
   return test_exit_status;
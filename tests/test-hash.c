@@ -182,10 +182,70 @@ main (int argc, char **argv)
   /* Alternate tuning.  */
   tuning.growth_threshold = 0.89;
 
-  /* Run with default tuning, then with custom tuning settings.  */
-  for (unsigned int k = 0; k < 2; k++)
+  /* Open addressing, with default and custom tuning settings.  */
+  Hash_tuning oa_default_tuning;
+  hash_reset_tuning (&oa_default_tuning);
+  oa_default_tuning.is_open_addressing = true;
+  Hash_tuning oa_tuning = tuning;
+  oa_tuning.is_open_addressing = true;
+
+  /* Cached hash codes, with both representations.  */
+  Hash_tuning cached_tuning = tuning;
+  cached_tuning.is_hash_cached = true;
+  Hash_tuning oa_cached_tuning = oa_default_tuning;
+  oa_cached_tuning.is_hash_cached = true;
+
+  /* Fill an open addressing table, then empty it in a different order, so
+     that tombstones accumulate, and check that lookups still work.  */
+  ht = hash_initialize (1, &oa_default_tuning, hash_pjw,
+                        hash_compare_strings, hash_freer);
+  ASSERT (ht);
+  ASSERT (hash_get_n_buckets (ht) == 7);
+  for (unsigned int round = 0; round < 20; round++)
     {
-      Hash_tuning const *tune = (k == 0 ? NULL : &tuning);
+      for (unsigned int i = 0; i < 1000; i++)
+        {
+          char buf[50];
+          char *p_dup = strdup (uinttostr (i, buf));
+          ASSERT (p_dup);
+          insert_new (ht, p_dup);
+        }
+      ASSERT (hash_get_n_entries (ht) == 1000);
+      ASSERT (hash_get_n_buckets_used (ht) == 1000);
+      ASSERT (hash_table_ok (ht));
+      for (unsigned int i = 0; i < 1000; i++)
+        {
+          char buf[50];
+          char const *p = uinttostr ((i * 7 + round) % 1000, buf);
+          void *v = hash_remove (ht, p);
+          ASSERT (v);
+          ASSERT (streq (v, p));
+          free (v);
+          ASSERT (hash_remove (ht, p) == NULL);
+          if (i % 100 == 0)
+            {
+              char buf2[50];
+              p = uinttostr ((i * 7 + round + 7) % 1000, buf2);
+              ASSERT (hash_lookup (ht, p) != NULL);
+            }
+        }
+      ASSERT (hash_get_n_entries (ht) == 0);
+      ASSERT (hash_get_first (ht) == NULL);
+      ASSERT (hash_table_ok (ht));
+    }
+  hash_free (ht);
+
+  /* Run with default tuning, then with custom tuning settings, first with
+     separate chaining, then with open addressing, then with cached hash
+     codes.  */
+  for (unsigned int k = 0; k < 6; k++)
+    {
+      Hash_tuning const *tune = (k == 0 ? NULL
+                                 : k == 1 ? &tuning
+                                 : k == 2 ? &oa_default_tuning
+                                 : k == 3 ? &oa_tuning
+                                 : k == 4 ? &cached_tuning
+                                 : &oa_cached_tuning);
       /* Now, each entry is malloc'd.  */
       ht = hash_initialize (4651, tune, hash_pjw,
                             hash_compare_strings, hash_freer);
@@ -252,6 +312,26 @@ main (int argc, char **argv)
           ASSERT (hash_table_ok (ht));
         }
 
+      /* Look up all the keys that may be in the table, in batches.  */
+      {
+        enum { N = 10000 };
+        char (*bufs)[50] = malloc (N * sizeof *bufs);
+        void const **keys = malloc (N * sizeof *keys);
+        void **results = malloc (N * sizeof *results);
+        ASSERT (bufs && keys && results);
+        for (unsigned int i = 0; i < N; i++)
+          keys[i] = uinttostr (i, bufs[i]);
+        ASSERT (hash_lookup_many (ht, keys, N, results)
+                == hash_get_n_entries (ht));
+        for (unsigned int i = 0; i < N; i++)
+          ASSERT (results[i] == hash_lookup (ht, keys[i]));
+        ASSERT (hash_lookup_many (ht, keys + 1, 5, results) <= 5);
+        ASSERT (hash_lookup_many (ht, keys, 0, results) == 0);
+        free (bufs);
+        free (keys);
+        free (results);
+      }
+
       hash_free (ht);
     }
 
@@ -21,6 +21,7 @@
 
 #include <stdbit.h>
 #include <stdcountof.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -117,10 +118,35 @@ check_equals (gl_map_t map1, gl_map_t map2)
   free (pairs_of_map1);
 }
 
+static void
+check_search_many (gl_map_t map1, gl_map_t map2)
+{
+  const void *values1[countof (objects)];
+  const void *values2[countof (objects)];
+  bool found2[countof (objects)];
+  size_t count2 = 0;
+
+  ASSERT (gl_map_search_many (map1, (const void *const *) objects,
+                              countof (objects), values1, NULL)
+          == gl_map_size (map1));
+  ASSERT (gl_map_search_many (map2, (const void *const *) objects,
+                              countof (objects), values2, found2)
+          == gl_map_size (map2));
+  for (size_t i = 0; i < countof (objects); i++)
+    {
+      ASSERT (values1[i] == values2[i]);
+      ASSERT (found2[i] == (values2[i] != NULL));
+      ASSERT (values2[i] == gl_map_get (map2, objects[i]));
+      count2 += found2[i];
+    }
+  ASSERT (count2 == gl_map_size (map2));
+}
+
 static void
 check_all (gl_map_t map1, gl_map_t map2)
 {
   check_equals (map1, map2);
+  check_search_many (map1, map2);
 }
 
 int
@@ -188,5 +214,42 @@ main (int argc, char *argv[])
     gl_map_free (map2);
   }
 
+  /* Check a map whose hash table grows many times, while the entries move
+     incrementally from the old table to the new one.  */
+  {
+    enum { N = 20000 };
+    gl_map_t map =
+      gl_map_nx_create_empty (GL_HASH_MAP, NULL, NULL, NULL, NULL);
+    ASSERT (map != NULL);
+
+    for (uintptr_t i = 1; i <= N; i++)
+      {
+        const void *value;
+        ASSERT (gl_map_nx_put (map, (void *) i, (void *) (2 * i)) == 1);
+        if (i % 3 == 0)
+          ASSERT (gl_map_remove (map, (void *) (i / 3)));
+        ASSERT (gl_map_search (map, (void *) i, &value)
+                && value == (void *) (2 * i));
+        ASSERT (gl_map_search (map, (void *) (i / 2 + 1), &value)
+                == (i / 2 + 1 > i / 3));
+      }
+    ASSERT (gl_map_size (map) == N - N / 3);
+
+    size_t count = 0;
+    gl_map_iterator_t iter = gl_map_iterator (map);
+    const void *key;
+    const void *value;
+    while (gl_map_iterator_next (&iter, &key, &value))
+      {
+        ASSERT ((uintptr_t) key > N / 3 && (uintptr_t) key <= N);
+        ASSERT (value == (void *) (2 * (uintptr_t) key));
+        count++;
+      }
+    gl_map_iterator_free (&iter);
+    ASSERT (count == N - N / 3);
+
+    gl_map_free (map);
+  }
+
   return test_exit_status;
 }
@@ -0,0 +1,161 @@
+/* Test of the seeded hash function.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "hashcode-seeded.h"
+
+#include <stdcountof.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hash.h"
+#include "macros.h"
+
+static bool
+string_equals (void const *x1, void const *x2)
+{
+  return streq (x1, x2);
+}
+
+int
+main ()
+{
+  enum { N = 200 };
+  static unsigned char buf[N + 1];
+  static uint64_t codes[N + 1];
+
+  for (size_t i = 0; i <= N; i++)
+    buf[i] = i * 37 + 11;
+
+  /* The hash codes are those of the reference implementation of wyhash,
+     with its default secret.  As the input is read as little-endian
+     words, they differ on big-endian platforms.  */
+  static union { uint32_t word; unsigned char bytes[4]; } const
+    endianness = { 1 };
+  if (endianness.bytes[0] == 1)
+    {
+      /* The test vectors that come with wyhash.  */
+      static struct { char const *s; uint64_t seed; uint64_t code; } const
+        vectors[] =
+        {
+          { "", 0, UINT64_C (0x93228a4de0eec5a2) },
+          { "a", 1, UINT64_C (0xc5bac3db178713c4) },
+          { "abc", 2, UINT64_C (0xa97f2f7b1d9b3314) },
+          { "message digest", 3, UINT64_C (0x786d1f1df3801df4) },
+          { "abcdefghijklmnopqrstuvwxyz", 4, UINT64_C (0xdca5a8138ad37c87) },
+          { "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+            5, UINT64_C (0xb9e734f117cfaf70) },
+          { "1234567890123456789012345678901234567890"
+            "1234567890123456789012345678901234567890",
+            6, UINT64_C (0x6cc5eab49a92d617) }
+        };
+      for (size_t i = 0; i < countof (vectors); i++)
+        ASSERT (hash_mem_seeded (vectors[i].s, strlen (vectors[i].s),
+                                 vectors[i].seed)
+                == vectors[i].code);
+
+      /* The prefixes of BUF whose lengths are at the boundaries between
+         the code paths.  */
+      static struct { size_t n; uint64_t code; } const prefixes[] =
+        {
+          {   0, UINT64_C (0x2ac44db3deb05300) },
+          {   3, UINT64_C (0x7597e5ec80e43816) },
+          {   4, UINT64_C (0x28a022f252d665ff) },
+          {  16, UINT64_C (0xe0e3ac7ee98f856a) },
+          {  17, UINT64_C (0x926ec58c9a13c41f) },
+          {  48, UINT64_C (0x20bd1b1f8ada4c6f) },
+          {  49, UINT64_C (0xce5a8e8392822f8c) },
+          { 100, UINT64_C (0x60d6452d3391c796) }
+        };
+      for (size_t i = 0; i < countof (prefixes); i++)
+        ASSERT (hash_mem_seeded (buf, prefixes[i].n, 42) == prefixes[i].code);
+    }
+
+  /* The hash codes of the prefixes of BUF are different.  They cover all
+     the code paths, for short, medium, and long inputs.  */
+  for (size_t n = 0; n <= N; n++)
+    {
+      codes[n] = hash_mem_seeded (buf, n, 42);
+      for (size_t m = 0; m < n; m++)
+        ASSERT (codes[m] != codes[n]);
+    }
+
+  /* The hash code depends on every byte, and on the seed.  */
+  for (size_t n = 1; n <= N; n++)
+    for (size_t i = 0; i < n; i++)
+      {
+        buf[i] ^= 1;
+        ASSERT (hash_mem_seeded (buf, n, 42) != codes[n]);
+        buf[i] ^= 1;
+      }
+  for (size_t n = 0; n <= N; n++)
+    {
+      ASSERT (hash_mem_seeded (buf, n, 42) == codes[n]);
+      ASSERT (hash_mem_seeded (buf, n, 43) != codes[n]);
+    }
+
+  /* The hash code doesn't depend on the alignment.  */
+  {
+    static unsigned char copy[N + 8];
+    for (size_t offset = 1; offset < 8; offset++)
+      {
+        memcpy (copy + offset, buf, N);
+        for (size_t n = 0; n <= N; n++)
+          ASSERT (hash_mem_seeded (copy + offset, n, 42) == codes[n]);
+      }
+  }
+
+  /* The seed of the process doesn't change.  */
+  uint64_t seed = hash_seed ();
+  ASSERT (hash_seed () == seed);
+  ASSERT (hash_mem64 (buf, N) == hash_mem_seeded (buf, N, seed));
+
+  /* The string functions hash the string without its NUL.  */
+  char const *s = "/usr/share/locale/de/LC_MESSAGES/coreutils.mo";
+  ASSERT (hash_string64 (s) == hash_mem64 (s, strlen (s)));
+  ASSERT (hash_string_hashcode (s) == (size_t) hash_string64 (s));
+  ASSERT (hash_string_hasher (s, 97) == hash_string64 (s) % 97);
+  ASSERT (hash_string64 ("") == hash_mem64 (s, 0));
+
+  /* The adaptors can be used with the 'hash' module.  */
+  {
+    static char const *strings[] =
+      { "", "a", "ab", "abc", "abcd", "/usr", "/usr/bin", "/usr/lib",
+        "/usr/share/locale/de/LC_MESSAGES/coreutils.mo",
+        "/usr/share/locale/fr/LC_MESSAGES/coreutils.mo"
+      };
+    enum { N_STRINGS = countof (strings) };
+    Hash_table *table =
+      hash_initialize (0, NULL, hash_string_hasher, string_equals, NULL);
+    ASSERT (table != NULL);
+    for (size_t i = 0; i < N_STRINGS; i++)
+      ASSERT (hash_insert (table, strings[i]) == strings[i]);
+    for (size_t i = 0; i < N_STRINGS; i++)
+      {
+        char *copy = strdup (strings[i]);
+        ASSERT (copy != NULL);
+        ASSERT (hash_lookup (table, copy) == strings[i]);
+        free (copy);
+      }
+    ASSERT (hash_lookup (table, "/usr/share") == NULL);
+    ASSERT (hash_get_n_entries (table) == N_STRINGS);
+    hash_free (table);
+  }
+
+  return test_exit_status;
+}
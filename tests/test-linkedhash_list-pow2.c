@@ -0,0 +1,27 @@
+/* Test of sequential list data type implementation, with power of 2
+   table sizes.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Compile the implementation a second time, with power of 2 table sizes
+   (GL_ANYHASH_POWER_OF_2), under another name.  The renaming stays in
+   effect, so that the test below exercises this implementation.  */
+#define GL_ANYHASH_POWER_OF_2 1
+#define gl_linkedhash_list_implementation pow2_linkedhash_list_implementation
+#include "gl_linkedhash_list.c"
+
+#include "test-linkedhash_list.c"
@@ -117,10 +117,35 @@ check_equals (gl_map_t map1, gl_map_t map2)
   free (pairs_of_map1);
 }
 
+static void
+check_search_many (gl_map_t map1, gl_map_t map2)
+{
+  const void *values1[countof (objects)];
+  const void *values2[countof (objects)];
+  bool found2[countof (objects)];
+  size_t count2 = 0;
+
+  ASSERT (gl_map_search_many (map1, (const void *const *) objects,
+                              countof (objects), values1, NULL)
+          == gl_map_size (map1));
+  ASSERT (gl_map_search_many (map2, (const void *const *) objects,
+                              countof (objects), values2, found2)
+          == gl_map_size (map2));
+  for (size_t i = 0; i < countof (objects); i++)
+    {
+      ASSERT (values1[i] == values2[i]);
+      ASSERT (found2[i] == (values2[i] != NULL));
+      ASSERT (values2[i] == gl_map_get (map2, objects[i]));
+      count2 += found2[i];
+    }
+  ASSERT (count2 == gl_map_size (map2));
+}
+
 static void
 check_all (gl_map_t map1, gl_map_t map2)
 {
   check_equals (map1, map2);
+  check_search_many (map1, map2);
 }
 
 int
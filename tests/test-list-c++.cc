@@ -20,19 +20,189 @@
 #include "gl_list.hh"
 #include "gl_array_list.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+# include <algorithm>
+# include <memory>
+# include <string>
+# include <vector>
+#endif
+
 #include "macros.h"
 
 static const char A[] = "A";
 static const char C[] = "C";
 static const char D[] = "D";
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+
+static void
+check_equals (const gl_ValueList<int>& list, const std::vector<int>& expected)
+{
+  ASSERT (list.size () == expected.size ());
+  for (size_t i = 0; i < expected.size (); i++)
+    ASSERT (list[i] == expected[i]);
+  ASSERT (std::equal (list.begin (), list.end (), expected.begin ()));
+}
+
+static void
+test_value_list ()
+{
+  {
+    gl_ValueList<std::string> list1;
+    list1.add_last (std::string ("C"));
+    list1.add_first (std::string ("A"));
+    list1.emplace_at (1, 1, 'B');
+    list1.emplace_last ("D");
+    ASSERT (list1.size () == 4);
+    {
+      std::string all;
+      for (const std::string& elt : list1)
+        all += elt;
+      ASSERT (all == "ABCD");
+    }
+    ASSERT (list1.indexof ("C") == 2);
+    ASSERT (list1.indexof ("E") == (size_t)(-1));
+
+    gl_ValueList<std::string> list2 = list1;
+    list1.set_at (0, std::string ("Z"));
+    ASSERT (list1.get_first () == "Z");
+    ASSERT (list2.get_first () == "A");
+
+    gl_ValueList<std::string> list3 = std::move (list2);
+    ASSERT (list2.size () == 0);
+    ASSERT (list3.size () == 4);
+    ASSERT (list3.get_last () == "D");
+
+    /* Adding an element of the list to the list itself.  */
+    for (size_t i = 0; i < 20; i++)
+      list3.add_last (list3[i]);
+    for (size_t i = 0; i < 20; i++)
+      list3.add_at (1, list3[list3.size () - 1]);
+    ASSERT (list3.size () == 44);
+    ASSERT (list3[1] == "D");
+
+    list2 = list3;
+    list3.remove_range (1, 43);
+    ASSERT (list3.size () == 2);
+    ASSERT (list3.get_first () == "A");
+    ASSERT (list3.get_last () == "D");
+    ASSERT (list3.remove ("A"));
+    ASSERT (!list3.remove ("A"));
+    ASSERT (list2.size () == 44);
+    list2.clear ();
+    ASSERT (list2.empty ());
+  }
+
+  /* A type that cannot be copied.  */
+  {
+    gl_ValueList<std::unique_ptr<int> > list1;
+    for (int i = 0; i < 100; i++)
+      list1.emplace_last (new int (i));
+    list1.add_first (std::unique_ptr<int> (new int (-1)));
+    list1.add_at (50, std::unique_ptr<int> (new int (-2)));
+    ASSERT (list1.size () == 102);
+    ASSERT (*list1[0] == -1);
+    ASSERT (*list1[50] == -2);
+    ASSERT (*list1[51] == 49);
+    list1.remove_at (50);
+    for (int i = 0; i < 100; i++)
+      ASSERT (*list1[i + 1] == i);
+    gl_ValueList<std::unique_ptr<int> > list2;
+    list2 = std::move (list1);
+    ASSERT (list2.size () == 101);
+    ASSERT (list1.size () == 0);
+  }
+
+  /* Random operations, checked against a std::vector.  */
+  {
+    gl_ValueList<int> list1;
+    std::vector<int> expected;
+    for (int repeat = 0; repeat < 10000; repeat++)
+      {
+        int data = rand () % 100;
+        switch (rand () % 9)
+          {
+          case 0:
+            list1.add_first (data);
+            expected.insert (expected.begin (), data);
+            break;
+          case 1:
+          case 2:
+            list1.add_last (data);
+            expected.push_back (data);
+            break;
+          case 3:
+            {
+              size_t position = rand () % (expected.size () + 1);
+              list1.add_at (position, data);
+              expected.insert (expected.begin () + position, data);
+            }
+            break;
+          case 4:
+            if (!expected.empty ())
+              {
+                size_t position = rand () % expected.size ();
+                list1.remove_at (position);
+                expected.erase (expected.begin () + position);
+              }
+            break;
+          case 5:
+            {
+              size_t start = rand () % (expected.size () + 1);
+              size_t end = start + rand () % (expected.size () - start + 1);
+              if (end - start > 10)
+                end = start + 10;
+              list1.remove_range (start, end);
+              expected.erase (expected.begin () + start,
+                              expected.begin () + end);
+            }
+            break;
+          case 6:
+            {
+              size_t position = list1.indexof (data);
+              std::vector<int>::iterator it =
+                std::find (expected.begin (), expected.end (), data);
+              if (it == expected.end ())
+                ASSERT (position == (size_t)(-1));
+              else
+                ASSERT (position == (size_t) (it - expected.begin ()));
+            }
+            break;
+          case 7:
+            if (!expected.empty ())
+              {
+                size_t position = rand () % expected.size ();
+                list1.set_at (position, data);
+                expected[position] = data;
+              }
+            break;
+          case 8:
+            std::reverse (list1.begin (), list1.end ());
+            std::reverse (expected.begin (), expected.end ());
+            break;
+          }
+        check_equals (list1, expected);
+      }
+    std::sort (list1.begin (), list1.end ());
+    std::sort (expected.begin (), expected.end ());
+    check_equals (list1, expected);
+  }
+}
+
+#endif
+
 int
 main (int argc, char *argv[])
 {
   gl_List<const char *> list1;
 
+  /* Allow the user to provide a non-default random seed on the command line.  */
+  if (argc > 1)
+    srand (atoi (argv[1]));
+
   list1 = gl_List<const char *> (GL_ARRAY_LIST, NULL, NULL, NULL, true);
   list1.add_last (A);
   list1.add_last (C);
@@ -73,7 +243,23 @@ main (int argc, char *argv[])
   ASSERT (list2.sortedlist_indexof (strcmp, "D") == 1);
 
   list2.free ();
+
+  {
+    const char *more[2] = { A, D };
+    list1.add_all_at (1, 2, more);
+    ASSERT (list1.size () == 6);
+    ASSERT (list1.get_at (1) == A);
+    ASSERT (list1.get_at (2) == D);
+    list1.remove_range (1, 3);
+    ASSERT (list1.size () == 4);
+    ASSERT (list1.get_at (1) == C);
+  }
+
   list1.free ();
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+  test_value_list ();
+#endif
+
   return test_exit_status;
 }
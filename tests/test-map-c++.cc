@@ -20,15 +20,152 @@
 #include "gl_map.hh"
 #include "gl_array_map.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+# include <map>
+# include <memory>
+# include <string>
+#endif
+
 #include "macros.h"
 
 static const int integers[6] = { 0, 1, 2, 3, 4, 5 };
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+
+static void
+check_equals (const gl_ValueMap<int, int>& map,
+              const std::map<int, int>& expected)
+{
+  ASSERT (map.size () == expected.size ());
+  size_t count = 0;
+  for (const std::pair<const int, int>& entry : map)
+    {
+      std::map<int, int>::const_iterator it = expected.find (entry.first);
+      ASSERT (it != expected.end ());
+      ASSERT (entry.second == it->second);
+      count++;
+    }
+  ASSERT (count == expected.size ());
+}
+
+static void
+test_value_map ()
+{
+  {
+    gl_ValueMap<std::string, int> map1;
+    ASSERT (map1.put ("five", 0));
+    ASSERT (map1.put ("one", 1));
+    ASSERT (map1.put (std::string ("two"), 2));
+    ASSERT (map1.emplace ("three", 3));
+    ASSERT (map1.emplace ("four", 4));
+    ASSERT (!map1.put ("five", 5));
+    ASSERT (!map1.emplace ("five", 6));
+    ASSERT (map1.size () == 5);
+    ASSERT (*map1.get ("five") == 5);
+    ASSERT (map1.get ("six") == NULL);
+    ASSERT (map1.search ("one"));
+    ASSERT (!map1.search ("six"));
+    *map1.get ("one") = 10;
+    ASSERT (map1.find ("one")->second == 10);
+    ASSERT (map1.find ("six") == map1.end ());
+    {
+      int sum = 0;
+      for (const std::pair<const std::string, int>& entry : map1)
+        sum += entry.second;
+      ASSERT (sum == 10 + 2 + 3 + 4 + 5);
+    }
+
+    gl_ValueMap<std::string, int> map2 = map1;
+    ASSERT (map1.remove ("two"));
+    ASSERT (!map1.remove ("two"));
+    ASSERT (map1.size () == 4);
+    ASSERT (map2.size () == 5);
+    ASSERT (*map2.get ("two") == 2);
+
+    gl_ValueMap<std::string, int> map3 = std::move (map2);
+    ASSERT (map2.size () == 0);
+    ASSERT (map2.get ("two") == NULL);
+    ASSERT (map3.size () == 5);
+    for (gl_ValueMap<std::string, int>::iterator it = map3.begin ();
+         it != map3.end (); )
+      if (it->second % 2 == 0)
+        it = map3.erase (it);
+      else
+        ++it;
+    ASSERT (map3.size () == 2);
+    ASSERT (*map3.get ("three") == 3);
+    ASSERT (*map3.get ("five") == 5);
+    map3.clear ();
+    ASSERT (map3.empty ());
+  }
+
+  /* A value type that cannot be copied.  */
+  {
+    gl_ValueMap<int, std::unique_ptr<int> > map1;
+    for (int i = 0; i < 100; i++)
+      ASSERT (map1.emplace (i, new int (i)));
+    ASSERT (!map1.put (50, std::unique_ptr<int> (new int (-50))));
+    ASSERT (**map1.get (50) == -50);
+    gl_ValueMap<int, std::unique_ptr<int> > map2;
+    map2 = std::move (map1);
+    ASSERT (map2.size () == 100);
+    ASSERT (map1.size () == 0);
+    ASSERT (**map2.get (99) == 99);
+  }
+
+  /* Random operations, checked against a std::map.  */
+  {
+    gl_ValueMap<int, int> map1;
+    std::map<int, int> expected;
+    for (int repeat = 0; repeat < 100000; repeat++)
+      {
+        int key = rand () % 1000;
+        int value = rand ();
+        switch (rand () % 4)
+          {
+          case 0:
+          case 1:
+            {
+              bool added = (expected.find (key) == expected.end ());
+              expected[key] = value;
+              ASSERT (map1.put (key, value) == added);
+            }
+            break;
+          case 2:
+            ASSERT (map1.remove (key) == (expected.erase (key) > 0));
+            break;
+          case 3:
+            {
+              const int *valuep = map1.get (key);
+              std::map<int, int>::iterator it = expected.find (key);
+              if (it == expected.end ())
+                ASSERT (valuep == NULL);
+              else
+                ASSERT (valuep != NULL && *valuep == it->second);
+            }
+            break;
+          }
+        if (repeat % 1000 == 0)
+          check_equals (map1, expected);
+      }
+    check_equals (map1, expected);
+    gl_ValueMap<int, int> map2 = map1;
+    check_equals (map2, expected);
+  }
+}
+
+#endif
+
 int
 main (int argc, char *argv[])
 {
+  /* Allow the user to provide a non-default random seed on the command line.  */
+  if (argc > 1)
+    srand (atoi (argv[1]));
+
   gl_Map<const char *, const int *> map1;
 
   map1 = gl_Map<const char *, const int *> (GL_ARRAY_MAP, streq, NULL, NULL, NULL);
@@ -64,5 +201,9 @@ main (int argc, char *argv[])
 
   map1.free ();
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+  test_value_map ();
+#endif
+
   return test_exit_status;
 }
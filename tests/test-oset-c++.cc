@@ -20,8 +20,17 @@
 #include "gl_oset.hh"
 #include "gl_array_oset.h"
 
+#include <stdlib.h>
 #include <string.h>
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+# include <algorithm>
+# include <functional>
+# include <memory>
+# include <set>
+# include <string>
+#endif
+
 #include "macros.h"
 
 static int
@@ -43,10 +52,139 @@ is_at_most (const char *str, const char *threshold)
   return strcmp (str, threshold) <= 0;
 }
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+
+static void
+check_equals (const gl_ValueOSet<int>& set, const std::set<int>& expected)
+{
+  ASSERT (set.size () == expected.size ());
+  ASSERT (std::equal (set.begin (), set.end (), expected.begin ()));
+}
+
+struct unique_ptr_less
+{
+  bool operator() (const std::unique_ptr<int>& p1,
+                   const std::unique_ptr<int>& p2) const
+  {
+    return *p1 < *p2;
+  }
+};
+
+static void
+test_value_oset ()
+{
+  {
+    gl_ValueOSet<std::string, std::greater<std::string> > set1;
+    ASSERT (set1.add (std::string ("A")));
+    ASSERT (set1.add (std::string ("C")));
+    ASSERT (set1.emplace ("D"));
+    ASSERT (!set1.add (std::string ("C")));
+    ASSERT (!set1.emplace (1, 'D'));
+    ASSERT (set1.size () == 3);
+    {
+      std::string all;
+      for (const std::string& elt : set1)
+        all += elt;
+      ASSERT (all == "DCA");
+    }
+    ASSERT (set1.search ("C"));
+    ASSERT (!set1.search ("B"));
+    ASSERT (*set1.lower_bound ("B") == "A");
+    ASSERT (*set1.upper_bound ("C") == "A");
+    ASSERT (set1.upper_bound ("A") == set1.end ());
+    ASSERT (*--set1.end () == "A");
+
+    gl_ValueOSet<std::string, std::greater<std::string> > set2 = set1;
+    ASSERT (set1.remove ("D"));
+    ASSERT (!set1.remove ("D"));
+    ASSERT (set1.size () == 2);
+    ASSERT (set2.size () == 3);
+    ASSERT (*set2.begin () == "D");
+
+    gl_ValueOSet<std::string, std::greater<std::string> > set3 =
+      std::move (set2);
+    ASSERT (set2.size () == 0);
+    ASSERT (set3.size () == 3);
+    ASSERT (*set3.erase (set3.find ("C")) == "A");
+    ASSERT (set3.size () == 2);
+    set3.clear ();
+    ASSERT (set3.empty ());
+  }
+
+  /* A type that cannot be copied.  */
+  {
+    gl_ValueOSet<std::unique_ptr<int>, unique_ptr_less> set1;
+    for (int i = 0; i < 100; i++)
+      ASSERT (set1.emplace (new int ((i * 37) % 100)));
+    ASSERT (!set1.add (std::unique_ptr<int> (new int (50))));
+    int i = 0;
+    for (const std::unique_ptr<int>& elt : set1)
+      ASSERT (*elt == i++);
+    gl_ValueOSet<std::unique_ptr<int>, unique_ptr_less> set2;
+    set2 = std::move (set1);
+    ASSERT (set2.size () == 100);
+    ASSERT (set1.size () == 0);
+  }
+
+  /* Random operations, checked against a std::set.  */
+  {
+    gl_ValueOSet<int> set1;
+    std::set<int> expected;
+    for (int repeat = 0; repeat < 100000; repeat++)
+      {
+        int data = rand () % 1000;
+        switch (rand () % 5)
+          {
+          case 0:
+          case 1:
+            ASSERT (set1.add (data) == expected.insert (data).second);
+            break;
+          case 2:
+            ASSERT (set1.remove (data) == (expected.erase (data) > 0));
+            break;
+          case 3:
+            ASSERT (set1.search (data) == (expected.count (data) > 0));
+            break;
+          case 4:
+            {
+              gl_ValueOSet<int>::iterator it = set1.lower_bound (data);
+              std::set<int>::iterator expected_it = expected.lower_bound (data);
+              if (expected_it == expected.end ())
+                ASSERT (it == set1.end ());
+              else
+                {
+                  ASSERT (*it == *expected_it);
+                  if (rand () % 2)
+                    {
+                      it = set1.erase (it);
+                      expected_it = expected.erase (expected_it);
+                      ASSERT (expected_it == expected.end ()
+                              ? it == set1.end ()
+                              : *it == *expected_it);
+                    }
+                }
+            }
+            break;
+          }
+        if (repeat % 1000 == 0)
+          check_equals (set1, expected);
+      }
+    check_equals (set1, expected);
+    gl_ValueOSet<int> set2 = set1;
+    check_equals (set2, expected);
+  }
+}
+
+#endif
+
 int
 main (int argc, char *argv[])
 {
   char A[2] = "A";
+
+  /* Allow the user to provide a non-default random seed on the command line.  */
+  if (argc > 1)
+    srand (atoi (argv[1]));
   gl_OSet<const char *> set1;
 
   set1 = gl_OSet<const char *> (GL_ARRAY_OSET, reverse_strcmp, NULL);
@@ -93,7 +231,17 @@ main (int argc, char *argv[])
     ASSERT (!iter3.next (elt));
   }
 
+  {
+    const char *more[3] = { "E", "D", "B" };
+    set1.add_sorted_array (3, more);
+    ASSERT (set1.size () == 5);
+  }
+
   set1.free ();
 
+#if __cplusplus >= 201103L || (defined _MSC_VER && _MSC_VER >= 1900)
+  test_value_oset ();
+#endif
+
   return test_exit_status;
 }
@@ -0,0 +1,79 @@
+/* Test of sha256_buffers and sha224_buffers.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "sha256.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "macros.h"
+
+/* Number of messages.  Not a multiple of the number of lanes, so that
+   some lanes run idle at the end.  */
+#define N 77
+
+int
+main (void)
+{
+  static char data[N * 150];
+  char const *buffers[N];
+  size_t lens[N];
+  char digests[N][SHA256_DIGEST_SIZE];
+  void *resblocks[N];
+
+#if GL_SHA256_X86_64
+  /* Exercise the SIMD lanes also on CPUs with the SHA extensions, where
+     the messages would otherwise be hashed one by one.  */
+  setenv ("GLIBC_TUNABLES", "glibc.cpu.hwcaps=-SHA", 1);
+#endif
+
+  for (size_t i = 0; i < sizeof data; i++)
+    data[i] = (char) (i * 2654435761U >> 13);
+
+  /* Lengths around the 55/56 and 64 byte padding boundaries, and a few
+     multi-block messages of unequal lengths.  */
+  size_t pos = 0;
+  for (size_t i = 0; i < N; i++)
+    {
+      lens[i] = (i < 70 ? i : 130 + (i - 70) * 7 % 20);
+      buffers[i] = data + pos;
+      resblocks[i] = digests[i];
+      pos += lens[i] + 1;
+    }
+  ASSERT (pos <= sizeof data);
+
+  for (size_t n = 0; n <= N; n += (n < 10 ? 1 : 17))
+    {
+      char expected[SHA256_DIGEST_SIZE];
+
+      memset (digests, 0, sizeof digests);
+      sha256_buffers (buffers, lens, n, resblocks);
+      for (size_t i = 0; i < n; i++)
+        ASSERT (memeq (sha256_buffer (buffers[i], lens[i], expected),
+                       digests[i], SHA256_DIGEST_SIZE));
+
+      memset (digests, 0, sizeof digests);
+      sha224_buffers (buffers, lens, n, resblocks);
+      for (size_t i = 0; i < n; i++)
+        ASSERT (memeq (sha224_buffer (buffers[i], lens[i], expected),
+                       digests[i], SHA224_DIGEST_SIZE));
+    }
+
+  return test_exit_status;
+}
@@ -0,0 +1,73 @@
+/* Test of SHA-256 compression function for x86_64.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+#include "sha256.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if GL_SHA256_X86_64 && !HAVE_OPENSSL_SHA256
+# include "sha256-x86_64.h"
+#endif
+
+#include "macros.h"
+
+#define NBLOCKS 9
+
+int
+main (void)
+{
+#if GL_SHA256_X86_64 && !HAVE_OPENSSL_SHA256
+  /* Make sha256_process_block use the portable code, so that it serves
+     as the reference for the optimized backends.  */
+  setenv ("GLIBC_TUNABLES", "glibc.cpu.hwcaps=-SHA,-AVX2", 1);
+
+  static char data[NBLOCKS * 64];
+  for (size_t i = 0; i < sizeof data; i++)
+    data[i] = (char) (i * 2654435761U >> 13);
+
+  /* Use every block count from 1 to NBLOCKS, so that both the even and
+     the odd cases of the two-block AVX2 loop are exercised.  */
+  for (size_t n = 1; n <= NBLOCKS; n++)
+    {
+      struct sha256_ctx ctx;
+      sha256_init_ctx (&ctx);
+      uint32_t initial[8];
+      memcpy (initial, ctx.state, sizeof initial);
+      sha256_process_block (data, n * 64, &ctx);
+
+      if (__builtin_cpu_supports ("sha") && __builtin_cpu_supports ("sse4.1"))
+        {
+          uint32_t state[8];
+          memcpy (state, initial, sizeof state);
+          sha256_process_block_shani (state, data, n * 64);
+          ASSERT (memeq (state, ctx.state, sizeof state));
+        }
+
+      if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("bmi2"))
+        {
+          uint32_t state[8];
+          memcpy (state, initial, sizeof state);
+          sha256_process_block_avx2 (state, data, n * 64);
+          ASSERT (memeq (state, ctx.state, sizeof state));
+        }
+    }
+#endif
+
+  return test_exit_status;
+}
@@ -0,0 +1,76 @@
+/* Test of the sha3_*_buffers functions.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "sha3.h"
+
+#include <string.h>
+
+#include "macros.h"
+
+/* Number of messages.  Not a multiple of the number of lanes, so that
+   some lanes run idle at the end.  */
+#define N 43
+
+int
+main (void)
+{
+  static char data[N * 400];
+  char const *buffers[N];
+  size_t lens[N];
+  char digests[N][SHA3_512_DIGEST_SIZE];
+  void *resblocks[N];
+
+  for (size_t i = 0; i < sizeof data; i++)
+    data[i] = (char) (i * 2654435761U >> 13);
+
+  /* Lengths around the block sizes 72, 104, 136 and 144, and a few
+     multi-block messages of unequal lengths.  */
+  size_t pos = 0;
+  for (size_t i = 0; i < N; i++)
+    {
+      static size_t const special[] = { 0, 1, 71, 72, 73, 103, 104, 105,
+                                        135, 136, 137, 143, 144, 145 };
+      size_t nspecial = sizeof special / sizeof special[0];
+      lens[i] = (i < nspecial ? special[i] : 150 + (i - nspecial) * 37 % 240);
+      buffers[i] = data + pos;
+      resblocks[i] = digests[i];
+      pos += lens[i] + 1;
+    }
+  ASSERT (pos <= sizeof data);
+
+  for (size_t n = 0; n <= N; n += (n < 10 ? 1 : 11))
+    {
+      char expected[SHA3_512_DIGEST_SIZE];
+
+#define CHECK(SIZE)                                                     \
+      memset (digests, 0, sizeof digests);                              \
+      sha3_##SIZE##_buffers (buffers, lens, n, resblocks);              \
+      for (size_t i = 0; i < n; i++)                                    \
+        ASSERT (memeq (sha3_##SIZE##_buffer (buffers[i], lens[i],       \
+                                             expected),                 \
+                       digests[i], SHA3_##SIZE##_DIGEST_SIZE))
+
+      CHECK (224);
+      CHECK (256);
+      CHECK (384);
+      CHECK (512);
+    }
+
+  return test_exit_status;
+}
@@ -0,0 +1,118 @@
+/* Test of the SHAKE128 and SHAKE256 extendable-output functions.
+   Copyright (C) 2026 Free Software Foundation, Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+#include <config.h>
+
+/* Specification.  */
+#include "sha3.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "macros.h"
+
+/* Return true if the LEN bytes at BUF are written as HEX.  */
+static bool
+hex_equal (char const *buf, size_t len, char const *hex)
+{
+  char tmp[3];
+  for (size_t i = 0; i < len; i++)
+    {
+      sprintf (tmp, "%02x", buf[i] & 0xFFu);
+      if (memcmp (tmp, hex + 2 * i, 2) != 0)
+        return false;
+    }
+  return hex[2 * len] == '\0';
+}
+
+#if !HAVE_OPENSSL_SHA3 || HAVE_EVP_DIGESTSQUEEZE
+/* Return true if squeezing SHAKE output in pieces of varying size gives
+   the same result as a single call.  */
+static bool
+check_pieces (bool (*init_ctx) (struct sha3_ctx *),
+              char const *message, size_t len)
+{
+  char expected[1000];
+  char buf[1000];
+  struct sha3_ctx ctx;
+
+  ASSERT (init_ctx (&ctx));
+  ASSERT (sha3_process_bytes (message, len, &ctx));
+  ASSERT (shake_squeeze (&ctx, expected, sizeof expected) == expected);
+  sha3_free_ctx (&ctx);
+
+  ASSERT (init_ctx (&ctx));
+  ASSERT (sha3_process_bytes (message, len, &ctx));
+  size_t done = 0;
+  for (size_t piece = 0; done < sizeof buf; piece = piece * 2 + 1)
+    {
+      size_t n = piece < sizeof buf - done ? piece : sizeof buf - done;
+      ASSERT (shake_squeeze (&ctx, buf + done, n) == buf + done);
+      done += n;
+    }
+  sha3_free_ctx (&ctx);
+
+  return memcmp (buf, expected, sizeof buf) == 0;
+}
+#endif
+
+int
+main (void)
+{
+  char buf[400];
+  char message[200];
+
+  /* Test vectors from NIST.  */
+  ASSERT (shake128_buffer ("", 0, buf, 32) == buf);
+  ASSERT (hex_equal (buf, 32,
+                     "7f9c2ba4e88f827d616045507605853e"
+                     "d73b8093f6efbc88eb1a6eacfa66ef26"));
+  ASSERT (shake256_buffer ("", 0, buf, 64) == buf);
+  ASSERT (hex_equal (buf, 64,
+                     "46b9dd2b0ba88d13233b3feb743eeb24"
+                     "3fcd52ea62b81b82b50c27646ed5762f"
+                     "d75dc4ddd8c0f200cb05019d67b592f6"
+                     "fc821c49479ab48640292eacb3b7c4be"));
+  ASSERT (shake128_buffer ("abc", 3, buf, 32) == buf);
+  ASSERT (hex_equal (buf, 32,
+                     "5881092dd818bf5cf8a3ddb793fbcba7"
+                     "4097d5c526a6d35f97b83351940f2cc8"));
+  ASSERT (shake256_buffer ("abc", 3, buf, 64) == buf);
+  ASSERT (hex_equal (buf, 64,
+                     "483366601360a8771c6863080cc4114d"
+                     "8db44530f8f1e1ee4f94ea37e78b5739"
+                     "d5a15bef186a5386c75744c0527e1faa"
+                     "9f8726e462a12a4feb06bd8801e751e4"));
+
+  /* Output longer than a block, of input longer than a block.  */
+  memset (message, 'a', sizeof message);
+  ASSERT (shake128_buffer (message, sizeof message, buf, sizeof buf) == buf);
+  ASSERT (hex_equal (buf + sizeof buf - 32, 32,
+                     "eb3fb4efec6eace3d68bc3d0872d89e5"
+                     "e631d0ddff456328c2f1eaea4354fba9"));
+  ASSERT (shake256_buffer (message, sizeof message, buf, sizeof buf) == buf);
+  ASSERT (hex_equal (buf + sizeof buf - 32, 32,
+                     "4d7c8d364f5a6777c97aa862d0725aa7"
+                     "1648945d187c971e161ecfb6483e2234"));
+
+#if !HAVE_OPENSSL_SHA3 || HAVE_EVP_DIGESTSQUEEZE
+  /* Squeezing in pieces.  */
+  ASSERT (check_pieces (shake128_init_ctx, message, sizeof message));
+  ASSERT (check_pieces (shake256_init_ctx, message, 7));
+#endif
+
+  return test_exit_status;
+}